@@ -27,11 +27,17 @@
 #include <libevmasm/PeepholeOptimiser.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/BlockReorderer.h>
+#include <libevmasm/CodeOutliner.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
+
 #include <fstream>
 #include <json/json.h>
 
@@ -54,14 +60,23 @@ AssemblyItem const& Assembly::append(AssemblyItem const& _i)
 
 unsigned Assembly::bytesRequired(unsigned subTagSize) const
 {
-	for (unsigned tagSize = subTagSize; true; ++tagSize)
+	// Only tag, data and sub references depend on the size of an address, so the size of
+	// all other items is computed once and only the references are accounted for per candidate size.
+	size_t fixedSize = 1;
+	for (auto const& i: m_data)
+		fixedSize += i.second.size();
+
+	size_t addressReferences = 0;
+	for (AssemblyItem const& i: m_items)
 	{
-		size_t ret = 1;
-		for (auto const& i: m_data)
-			ret += i.second.size();
+		fixedSize += i.bytesRequired(0);
+		if (i.type() == PushTag || i.type() == PushData || i.type() == PushSub)
+			++addressReferences;
+	}
 
-		for (AssemblyItem const& i: m_items)
-			ret += i.bytesRequired(tagSize);
+	for (unsigned tagSize = subTagSize; true; ++tagSize)
+	{
+		size_t ret = fixedSize + addressReferences * tagSize;
 		if (util::bytesRequired(ret) <= tagSize)
 			return static_cast<unsigned>(ret);
 	}
@@ -70,25 +85,27 @@ unsigned Assembly::bytesRequired(unsigned subTagSize) const
 namespace
 {
 
-string locationFromSources(StringMap const& _sourceCodes, SourceLocation const& _location)
+/// Writes the first line of the source code covered by @a _location to @a _out without copying it.
+void printLocationFromSources(ostream& _out, StringMap const& _sourceCodes, SourceLocation const& _location)
 {
 	if (!_location.hasText() || _sourceCodes.empty())
-		return "";
+		return;
 
 	auto it = _sourceCodes.find(_location.source->name());
 	if (it == _sourceCodes.end())
-		return "";
+		return;
 
 	string const& source = it->second;
-	if (static_cast<size_t>(_location.start) >= source.size())
-		return "";
-
-	string cut = source.substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start));
-	auto newLinePos = cut.find_first_of("\n");
-	if (newLinePos != string::npos)
-		cut = cut.substr(0, newLinePos) + "...";
-
-	return cut;
+	size_t start = static_cast<size_t>(_location.start);
+	if (start >= source.size())
+		return;
+
+	size_t length = min(static_cast<size_t>(_location.end - _location.start), source.size() - start);
+	size_t newLinePos = source.find_first_of('\n', start);
+	if (newLinePos != string::npos && newLinePos < start + length)
+		_out.write(source.data() + start, static_cast<streamsize>(newLinePos - start)) << "...";
+	else
+		_out.write(source.data() + start, static_cast<streamsize>(length));
 }
 
 class Functionalizer
@@ -116,7 +133,7 @@ public:
 		))
 		{
 			flush();
-			m_out << m_prefix << (_item.type() == Tag ? "" : "  ") << expression << endl;
+			m_out << m_prefix << (_item.type() == Tag ? "" : "  ") << expression << '\n';
 			return;
 		}
 		if (_item.arguments() > 0)
@@ -140,7 +157,7 @@ public:
 	void flush()
 	{
 		for (string const& expression: m_pending)
-			m_out << m_prefix << "  " << expression << endl;
+			m_out << m_prefix << "  " << expression << '\n';
 		m_pending.clear();
 	}
 
@@ -150,11 +167,12 @@ public:
 			return;
 		m_out << m_prefix << "    /*";
 		if (m_location.source)
-			m_out << " \"" + m_location.source->name() + "\"";
+			m_out << " \"" << m_location.source->name() << "\"";
 		if (m_location.hasText())
-			m_out << ":" << to_string(m_location.start) + ":" + to_string(m_location.end);
-		m_out << "  " << locationFromSources(m_sourceCodes, m_location);
-		m_out << " */" << endl;
+			m_out << ":" << m_location.start << ":" << m_location.end;
+		m_out << "  ";
+		printLocationFromSources(m_out, m_sourceCodes, m_location);
+		m_out << " */\n";
 	}
 
 private:
@@ -179,21 +197,21 @@ void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap co
 
 	if (!m_data.empty() || !m_subs.empty())
 	{
-		_out << _prefix << "stop" << endl;
+		_out << _prefix << "stop\n";
 		for (auto const& i: m_data)
 			if (u256(i.first) >= m_subs.size())
-				_out << _prefix << "data_" << toHex(u256(i.first)) << " " << toHex(i.second) << endl;
+				_out << _prefix << "data_" << toHex(u256(i.first)) << " " << toHex(i.second) << '\n';
 
 		for (size_t i = 0; i < m_subs.size(); ++i)
 		{
-			_out << endl << _prefix << "sub_" << i << ": assembly {\n";
+			_out << '\n' << _prefix << "sub_" << i << ": assembly {\n";
 			m_subs[i]->assemblyStream(_out, _prefix + "    ", _sourceCodes);
-			_out << _prefix << "}" << endl;
+			_out << _prefix << "}\n";
 		}
 	}
 
 	if (m_auxiliaryData.size() > 0)
-		_out << endl << _prefix << "auxdata: 0x" << toHex(m_auxiliaryData) << endl;
+		_out << '\n' << _prefix << "auxdata: 0x" << toHex(m_auxiliaryData) << '\n';
 }
 
 string Assembly::assemblyString(StringMap const& _sourceCodes) const
@@ -310,8 +328,12 @@ Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices)
 		case Tag:
 			collection.append(
 				createJsonValue("tag", sourceIndex, i.location().start, i.location().end, toString(i.data())));
-			collection.append(
-				createJsonValue("JUMPDEST", sourceIndex, i.location().start, i.location().end));
+			collection.append(createJsonValue(
+				i.isSubroutineEntry() ? "BEGINSUB" : "JUMPDEST",
+				sourceIndex,
+				i.location().start,
+				i.location().end
+			));
 			break;
 		case PushData:
 			collection.append(createJsonValue("PUSH data", sourceIndex, i.location().start, i.location().end, toStringInHex(i.data())));
@@ -392,37 +414,129 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
+	ProfilerScope profilerScope{"EVM assembly optimiser"};
 	optimiseInternal(_settings, {});
 	return *this;
 }
 
+bool Assembly::optimisationIncomplete() const
+{
+	return m_optimisationIncomplete || any_of(m_subs.begin(), m_subs.end(), [](auto const& _sub) {
+		return _sub->optimisationIncomplete();
+	});
+}
+
 map<u256, u256> Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
 )
 {
+	m_optimisationIncomplete = false;
+	// The budget is counted in items processed, so that the result does not depend on the machine.
+	// Sub-assemblies have budgets of their own, since they can be optimised concurrently.
+	optional<size_t> remainingBudget = _settings.workBudget;
+	auto const spendBudget = [&](size_t _units)
+	{
+		if (!remainingBudget)
+			return true;
+		if (_units > *remainingBudget)
+		{
+			remainingBudget = 0;
+			return false;
+		}
+		*remainingBudget -= _units;
+		return true;
+	};
+
 	// Run optimisation for sub-assemblies.
+	OptimiserSettings subSettings = _settings;
+	// Disable creation mode for sub-assemblies.
+	subSettings.isCreation = false;
+	// Sub-assemblies that are already assembled (like the creation code of contracts created
+	// via "new", which are compiled and optimised before the contracts creating them)
+	// are final. Optimising them again would not change the code used for them.
+	// The sub-assemblies to optimise are grouped by object, so that an assembly that occurs
+	// several times is still optimised once per occurrence in the order of the sub ids.
+	vector<vector<size_t>> subIdsByAssembly;
+	map<Assembly const*, size_t> assemblyGroups;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		lock_guard<mutex> subLock(*m_subs[subId]->m_optimiserMutex);
+		if (!m_subs[subId]->m_assembledObject.bytecode.empty())
+			continue;
+		auto [group, inserted] = assemblyGroups.emplace(m_subs[subId].get(), subIdsByAssembly.size());
+		if (inserted)
+			subIdsByAssembly.emplace_back();
+		subIdsByAssembly[group->second].emplace_back(subId);
 	}
 
+	// Optimising a sub-assembly only reads the tags of that sub referenced from this assembly,
+	// so all tag replacements can be computed first and applied in the order of the sub ids.
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	auto optimiseSubs = [&](vector<size_t> const& _subIds, size_t _parallelism)
+	{
+		OptimiserSettings settings = subSettings;
+		settings.parallelism = _parallelism;
+		for (size_t subId: _subIds)
+		{
+			lock_guard<mutex> subLock(*m_subs[subId]->m_optimiserMutex);
+			if (!m_subs[subId]->m_assembledObject.bytecode.empty())
+				continue;
+			subTagReplacements[subId] = m_subs[subId]->optimiseInternal(
+				settings,
+				JumpdestRemover::referencedTags(m_items, subId)
+			);
+		}
+	};
+	if (_settings.parallelism > 1 && subIdsByAssembly.size() > 1)
+	{
+		// Exceptions are rethrown in the order of the sub ids. The remaining threads are
+		// used for the sub-assemblies of the sub-assemblies.
+		vector<exception_ptr> failures(subIdsByAssembly.size());
+		util::ThreadPool pool{min(_settings.parallelism, subIdsByAssembly.size())};
+		size_t threadsPerSub = max<size_t>(1, _settings.parallelism / pool.threadCount());
+		for (size_t i = 0; i < subIdsByAssembly.size(); ++i)
+			pool.post([&, i] {
+				try
+				{
+					optimiseSubs(subIdsByAssembly[i], threadsPerSub);
+				}
+				catch (...)
+				{
+					failures[i] = current_exception();
+				}
+			});
+		pool.wait();
+		for (exception_ptr const& failure: failures)
+			if (failure)
+				rethrow_exception(failure);
+	}
+	else
+		for (vector<size_t> const& subIds: subIdsByAssembly)
+			optimiseSubs(subIds, _settings.parallelism);
+
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		if (!subTagReplacements[subId].empty())
+			BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
+
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
-	for (unsigned count = 1; count > 0;)
+	for (unsigned count = 1, round = 0; count > 0; ++round)
 	{
+		// The first round is always run, so that the jumpdest remover and the peephole
+		// optimiser do their cheap part of the work even without any budget left.
+		if (!spendBudget(m_items.size()) && round > 0)
+		{
+			m_optimisationIncomplete = true;
+			break;
+		}
+		TraceScope roundScope{"Round", to_string(round)};
 		count = 0;
 
 		if (_settings.runJumpdestRemover)
 		{
+			ProfilerScope stepScope{"JumpdestRemover"};
 			JumpdestRemover jumpdestOpt{m_items};
 			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
 				count++;
@@ -430,6 +544,7 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runPeephole)
 		{
+			ProfilerScope stepScope{"PeepholeOptimiser"};
 			PeepholeOptimiser peepOpt{m_items};
 			while (peepOpt.optimise())
 			{
@@ -441,6 +556,7 @@ map<u256, u256> Assembly::optimiseInternal(
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
+			ProfilerScope stepScope{"BlockDeduplicator"};
 			BlockDeduplicator deduplicator{m_items};
 			if (deduplicator.deduplicate())
 			{
@@ -464,27 +580,48 @@ map<u256, u256> Assembly::optimiseInternal(
 			}
 		}
 
+		if (_settings.runBlockReorderer)
+		{
+			ProfilerScope stepScope{"BlockReorderer"};
+			BlockReorderer reorderer{m_items};
+			if (reorderer.optimise())
+				count++;
+		}
+
 		if (_settings.runCSE)
 		{
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			ProfilerScope stepScope{"CommonSubexpressionEliminator"};
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
 
 			auto iter = m_items.begin();
+			unique_ptr<CommonSubexpressionEliminator> eliminator;
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
+				// Code that does not start with a tag can only be reached from the preceding item.
+				// In cross-block mode, the knowledge gathered so far is kept for it if that
+				// item does not alter control flow or is a JUMPI that is not taken.
+				bool keepKnowledge = false;
+				if (_settings.runCSEAcrossBlocks && eliminator && iter->type() != Tag)
+				{
+					AssemblyItem const& breakingItem = *prev(iter);
+					keepKnowledge =
+						breakingItem == AssemblyItem(Instruction::JUMPI) ||
+						!SemanticInformation::altersControlFlow(breakingItem);
+				}
+				if (!keepKnowledge)
+					eliminator = make_unique<CommonSubexpressionEliminator>(KnownState{});
 				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
+				iter = eliminator->feedItems(iter, m_items.end(), usesMSize);
 				bool shouldReplace = false;
 				AssemblyItems optimisedChunk;
 				try
 				{
-					optimisedChunk = eliminator.getOptimizedItems();
+					optimisedChunk = eliminator->getOptimizedItems();
 					shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
 				}
 				catch (StackTooDeepException const&)
@@ -514,13 +651,30 @@ map<u256, u256> Assembly::optimiseInternal(
 		}
 	}
 
+	if (_settings.runOutliner && !spendBudget(m_items.size()))
+		m_optimisationIncomplete = true;
+	else if (_settings.runOutliner)
+	{
+		ProfilerScope stepScope{"CodeOutliner"};
+		CodeOutliner outliner{
+			*this,
+			_settings.isCreation,
+			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
+			_settings.evmVersion
+		};
+		outliner.optimise();
+	}
+
 	if (_settings.runConstantOptimiser)
+	{
+		ProfilerScope stepScope{"ConstantOptimiser"};
 		ConstantOptimisationMethod::optimiseConstants(
 			_settings.isCreation,
 			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
 			*this
 		);
+	}
 
 	return tagReplacements;
 }
@@ -575,7 +729,8 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesRequiredForCode = bytesRequired(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, numeric_limits<size_t>::max());
-	map<size_t, pair<size_t, size_t>> tagRef;
+	/// Code positions where a tag position is inserted, together with the sub id and tag id.
+	vector<pair<size_t, pair<size_t, size_t>>> tagRef;
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
@@ -626,7 +781,7 @@ LinkerObject const& Assembly::assemble() const
 		case PushTag:
 		{
 			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			tagRef.emplace_back(ret.bytecode.size(), i.splitForeignPushTag());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
@@ -706,7 +861,9 @@ LinkerObject const& Assembly::assemble() const
 			assertThrow(ret.bytecode.size() < 0xffffffffL, AssemblyException, "Tag too large.");
 			assertThrow(m_tagPositionsInBytecode[static_cast<size_t>(i.data())] == numeric_limits<size_t>::max(), AssemblyException, "Duplicate tag position.");
 			m_tagPositionsInBytecode[static_cast<size_t>(i.data())] = ret.bytecode.size();
-			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::JUMPDEST));
+			ret.bytecode.push_back(static_cast<uint8_t>(
+				i.isSubroutineEntry() ? Instruction::BEGINSUB : Instruction::JUMPDEST
+			));
 			break;
 		default:
 			assertThrow(false, InvalidOpcode, "Unexpected opcode while assembling.");
@@ -721,6 +878,14 @@ LinkerObject const& Assembly::assemble() const
 				"Some immutables were read from but never assigned, possibly because of optimization."
 			);
 
+	size_t bytesRequiredForTail = 1 + m_auxiliaryData.size();
+	for (auto const& ref: subRef)
+		bytesRequiredForTail += subAssemblyById(ref.first)->assemble().bytecode.size();
+	for (auto const& dataItem: m_data)
+		if (dataRef.count(dataItem.first))
+			bytesRequiredForTail += dataItem.second.size();
+	ret.bytecode.reserve(ret.bytecode.size() + bytesRequiredForTail);
+
 	if (!m_subs.empty() || !m_data.empty() || !m_auxiliaryData.empty())
 		// Append an INVALID here to help tests find miscompilation.
 		ret.bytecode.push_back(static_cast<uint8_t>(Instruction::INVALID));
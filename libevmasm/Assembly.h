@@ -35,6 +35,8 @@
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 namespace solidity::evmasm
 {
@@ -109,17 +111,36 @@ public:
 		bool runJumpdestRemover = false;
 		bool runPeephole = false;
 		bool runDeduplicate = false;
+		/// Moves the targets of unconditional jumps behind the jumps and removes the jumps.
+		bool runBlockReorderer = false;
 		bool runCSE = false;
+		/// Keeps the knowledge of the CSE across blocks that can only be entered from the
+		/// preceding code, i.e. after a JUMPI or an item that breaks the CSE analysis
+		/// without altering control flow. Requires runCSE.
+		bool runCSEAcrossBlocks = false;
+		/// Replaces repeated code at the end of blocks by jumps to a single copy,
+		/// if that pays off for expectedExecutionsPerDeployment.
+		bool runOutliner = false;
 		bool runConstantOptimiser = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Maximum number of threads used to optimise independent sub-assemblies concurrently.
+		/// The result does not depend on the number of threads.
+		size_t parallelism = 1;
+		/// Maximum number of work units spent on the assembly and, separately, on each of its
+		/// sub-assemblies. Each optimisation round and the outliner cost as many units as there are
+		/// items. Once it is exhausted, no further rounds are started and the outliner is skipped.
+		std::optional<size_t> workBudget;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
 	/// is optimised according to the settings in @a _settings.
 	Assembly& optimise(OptimiserSettings const& _settings);
+	/// @returns true if the work budget was exhausted during the last optimisation of this
+	/// assembly or of one of its sub-assemblies.
+	bool optimisationIncomplete() const;
 
 	/// Modify (if @a _enable is set) and return the current assembly such that creation and
 	/// execution gas usage is optimised. @a _isCreation should be true for the top-level assembly.
@@ -192,6 +213,12 @@ protected:
 	mutable LinkerObject m_assembledObject;
 	mutable std::vector<size_t> m_tagPositionsInBytecode;
 
+	/// Serialises the optimisation of this assembly when it is a sub-assembly of several
+	/// assemblies (the creation code of a contract created by others) that are optimised
+	/// concurrently. Shared by copies of the assembly.
+	std::shared_ptr<std::mutex> m_optimiserMutex = std::make_shared<std::mutex>();
+	bool m_optimisationIncomplete = false;
+
 	int m_deposit = 0;
 
 	langutil::SourceLocation m_currentSourceLocation;
@@ -23,9 +23,13 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/StringUtils.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/LEB128.h>
+#include <liblangutil/CharStream.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <charconv>
 #include <fstream>
+#include <string_view>
 
 using namespace std;
 using namespace solidity;
@@ -206,6 +210,8 @@ string AssemblyItem::toAssemblyText(Assembly const& _assembly) const
 	case Tag:
 		assertThrow(data() < 0x10000, AssemblyException, "Declaration of sub-assembly tag.");
 		text = string("tag_") + to_string(static_cast<size_t>(data())) + ":";
+		if (m_subroutineEntry)
+			text += " beginsub";
 		break;
 	case PushData:
 		text = string("data_") + util::toHex(data());
@@ -323,45 +329,104 @@ std::string AssemblyItem::computeSourceMapping(
 	map<string, unsigned> const& _sourceIndicesMap
 )
 {
-	string ret;
+	return compressSourceMapping(computeSourceMappingEntries(_items, _sourceIndicesMap));
+}
 
-	int prevStart = -1;
-	int prevLength = -1;
+SourceMapping AssemblyItem::computeSourceMappingEntries(
+	AssemblyItems const& _items,
+	map<string, unsigned> const& _sourceIndicesMap
+)
+{
+	SourceMapping mapping;
+	mapping.reserve(_items.size());
+	// Consecutive items usually share their source, so the index is only looked up if it changes.
+	CharStream const* prevSource = nullptr;
 	int prevSourceIndex = -1;
-	int prevModifierDepth = -1;
-	char prevJump = 0;
 	for (auto const& item: _items)
 	{
-		if (!ret.empty())
-			ret += ";";
-
 		SourceLocation const& location = item.location();
-		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			location.source && _sourceIndicesMap.count(location.source->name()) ?
-			static_cast<int>(_sourceIndicesMap.at(location.source->name())) :
-			-1;
-		char jump = '-';
+		SourceMappingEntry& entry = mapping.emplace_back();
+		entry.start = location.start;
+		entry.length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
+		if (location.source.get() != prevSource)
+		{
+			prevSource = location.source.get();
+			auto it = prevSource ? _sourceIndicesMap.find(prevSource->name()) : _sourceIndicesMap.end();
+			prevSourceIndex = it != _sourceIndicesMap.end() ? static_cast<int>(it->second) : -1;
+		}
+		entry.sourceIndex = prevSourceIndex;
 		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
-			jump = 'i';
+			entry.jump = 'i';
 		else if (item.getJumpType() == evmasm::AssemblyItem::JumpType::OutOfFunction)
-			jump = 'o';
-		int modifierDepth = static_cast<int>(item.m_modifierDepth);
+			entry.jump = 'o';
+		entry.modifierDepth = static_cast<int>(item.m_modifierDepth);
+	}
+	return mapping;
+}
+
+namespace
+{
+
+void appendNumber(string& _out, int _value)
+{
+	char buffer[16];
+	auto [end, error] = to_chars(begin(buffer), std::end(buffer), _value);
+	assertThrow(error == errc{}, util::Exception, "");
+	_out.append(buffer, end);
+}
+
+/// @returns the parts of @a _value separated by @a _separator, including empty parts.
+vector<string_view> splitView(string_view _value, char _separator)
+{
+	vector<string_view> parts;
+	while (true)
+	{
+		size_t end = _value.find(_separator);
+		parts.emplace_back(_value.substr(0, end));
+		if (end == string_view::npos)
+			return parts;
+		_value.remove_prefix(end + 1);
+	}
+}
+
+optional<int> parseNumber(string_view _value)
+{
+	int value = 0;
+	auto [end, error] = from_chars(_value.data(), _value.data() + _value.size(), value);
+	if (error != errc{} || end != _value.data() + _value.size())
+		return nullopt;
+	return value;
+}
+
+}
+
+string AssemblyItem::compressSourceMapping(SourceMapping const& _mapping)
+{
+	string ret;
+	// Most entries only differ in the start and length.
+	ret.reserve(_mapping.size() * 8);
+
+	// The first entry always contains the jump type and the modifier depth.
+	SourceMappingEntry prev{-1, -1, -1, 0, -1};
+	for (SourceMappingEntry const& entry: _mapping)
+	{
+		if (&entry != &_mapping.front())
+			ret += ';';
 
 		unsigned components = 5;
-		if (modifierDepth == prevModifierDepth)
+		if (entry.modifierDepth == prev.modifierDepth)
 		{
 			components--;
-			if (jump == prevJump)
+			if (entry.jump == prev.jump)
 			{
 				components--;
-				if (sourceIndex == prevSourceIndex)
+				if (entry.sourceIndex == prev.sourceIndex)
 				{
 					components--;
-					if (length == prevLength)
+					if (entry.length == prev.length)
 					{
 						components--;
-						if (location.start == prevStart)
+						if (entry.start == prev.start)
 							components--;
 					}
 				}
@@ -370,39 +435,86 @@ std::string AssemblyItem::computeSourceMapping(
 
 		if (components-- > 0)
 		{
-			if (location.start != prevStart)
-				ret += to_string(location.start);
+			if (entry.start != prev.start)
+				appendNumber(ret, entry.start);
 			if (components-- > 0)
 			{
 				ret += ':';
-				if (length != prevLength)
-					ret += to_string(length);
+				if (entry.length != prev.length)
+					appendNumber(ret, entry.length);
 				if (components-- > 0)
 				{
 					ret += ':';
-					if (sourceIndex != prevSourceIndex)
-						ret += to_string(sourceIndex);
+					if (entry.sourceIndex != prev.sourceIndex)
+						appendNumber(ret, entry.sourceIndex);
 					if (components-- > 0)
 					{
 						ret += ':';
-						if (jump != prevJump)
-							ret += jump;
+						if (entry.jump != prev.jump)
+							ret += entry.jump;
 						if (components-- > 0)
 						{
 							ret += ':';
-							if (modifierDepth != prevModifierDepth)
-								ret += to_string(modifierDepth);
+							if (entry.modifierDepth != prev.modifierDepth)
+								appendNumber(ret, entry.modifierDepth);
 						}
 					}
 				}
 			}
 		}
 
-		prevStart = location.start;
-		prevLength = length;
-		prevSourceIndex = sourceIndex;
-		prevJump = jump;
-		prevModifierDepth = modifierDepth;
+		prev = entry;
+	}
+	return ret;
+}
+
+optional<SourceMapping> AssemblyItem::decompressSourceMapping(string const& _mapping)
+{
+	SourceMapping mapping;
+	if (_mapping.empty())
+		return mapping;
+
+	SourceMappingEntry prev;
+	for (string_view element: splitView(_mapping, ';'))
+	{
+		vector<string_view> fields = splitView(element, ':');
+		if (fields.size() > 5)
+			return nullopt;
+
+		SourceMappingEntry entry = prev;
+		int* numbers[] = {&entry.start, &entry.length, &entry.sourceIndex, nullptr, &entry.modifierDepth};
+		for (size_t i = 0; i < fields.size(); ++i)
+			if (fields[i].empty())
+				continue;
+			else if (!numbers[i])
+			{
+				if (fields[i] != "i" && fields[i] != "o" && fields[i] != "-")
+					return nullopt;
+				entry.jump = fields[i][0];
+			}
+			else if (optional<int> number = parseNumber(fields[i]))
+				*numbers[i] = *number;
+			else
+				return nullopt;
+
+		mapping.emplace_back(entry);
+		prev = entry;
+	}
+	return mapping;
+}
+
+bytes AssemblyItem::encodeSourceMapping(SourceMapping const& _mapping)
+{
+	bytes ret;
+	SourceMappingEntry prev;
+	for (SourceMappingEntry const& entry: _mapping)
+	{
+		util::lebEncodeSigned(ret, int64_t(entry.start) - prev.start);
+		util::lebEncodeSigned(ret, int64_t(entry.length) - prev.length);
+		util::lebEncodeSigned(ret, int64_t(entry.sourceIndex) - prev.sourceIndex);
+		ret.push_back(static_cast<uint8_t>(entry.jump));
+		util::lebEncodeSigned(ret, int64_t(entry.modifierDepth) - prev.modifierDepth);
+		prev = entry;
 	}
 	return ret;
 }
@@ -28,7 +28,9 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
 #include <iostream>
+#include <optional>
 #include <sstream>
+#include <tuple>
 
 namespace solidity::evmasm
 {
@@ -54,6 +56,27 @@ class Assembly;
 class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 
+/// Source location and jump type of a single assembly item, i.e. one element
+/// ``s:l:f:j:m`` of the source mapping.
+struct SourceMappingEntry
+{
+	int start = -1;
+	int length = -1;
+	int sourceIndex = -1;
+	char jump = '-';
+	int modifierDepth = 0;
+
+	bool operator==(SourceMappingEntry const& _other) const
+	{
+		return
+			std::tie(start, length, sourceIndex, jump, modifierDepth) ==
+			std::tie(_other.start, _other.length, _other.sourceIndex, _other.jump, _other.modifierDepth);
+	}
+	bool operator!=(SourceMappingEntry const& _other) const { return !(*this == _other); }
+};
+/// Uncompressed source mapping with one entry per assembly item.
+using SourceMapping = std::vector<SourceMappingEntry>;
+
 class AssemblyItem
 {
 public:
@@ -127,10 +150,27 @@ public:
 	}
 	bool operator!=(Instruction _instr) const { return !operator==(_instr); }
 
+	/// @returns the compressed source mapping of @a _items as a string.
 	static std::string computeSourceMapping(
 		AssemblyItems const& _items,
 		std::map<std::string, unsigned> const& _sourceIndicesMap
 	);
+	/// @returns the uncompressed source mapping of @a _items.
+	static SourceMapping computeSourceMappingEntries(
+		AssemblyItems const& _items,
+		std::map<std::string, unsigned> const& _sourceIndicesMap
+	);
+	/// @returns the string representation of @a _mapping, where fields that are equal to the
+	/// field of the preceding entry are omitted.
+	static std::string compressSourceMapping(SourceMapping const& _mapping);
+	/// Parses the string representation of a source mapping.
+	/// @returns nullopt if @a _mapping is malformed.
+	static std::optional<SourceMapping> decompressSourceMapping(std::string const& _mapping);
+	/// @returns the binary representation of @a _mapping. For each entry, it contains the
+	/// differences of start, length and source index to the preceding entry as signed LEB128,
+	/// followed by the jump type character and the difference of the modifier depth as signed
+	/// LEB128. The first entry is compared to ``-1:-1:-1:-:0``.
+	static bytes encodeSourceMapping(SourceMapping const& _mapping);
 
 	/// @returns an upper bound for the number of bytes required by this item, assuming that
 	/// the value of a jump tag takes @a _addressLength bytes.
@@ -149,6 +189,11 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
+	/// Marks this tag as the entry of a subroutine (EIP-2315), which is assembled to BEGINSUB
+	/// instead of JUMPDEST and can only be reached via JUMPSUB.
+	void markAsSubroutineEntry() { assertThrow(m_type == Tag, util::Exception, ""); m_subroutineEntry = true; }
+	bool isSubroutineEntry() const { return m_subroutineEntry; }
+
 	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
 	u256 const* pushedValue() const { return m_pushedValue.get(); }
 
@@ -164,6 +209,8 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
 	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
+	/// Only valid if m_type == Tag
+	bool m_subroutineEntry = false;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
 	mutable std::shared_ptr<u256> m_pushedValue;
@@ -27,8 +27,12 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
 #include <functional>
-#include <set>
+#include <limits>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -49,46 +53,55 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	using diff_type = BlockIterator::difference_type;
+	BlockIterator end{m_items.end(), m_items.end()};
+	// Iterator over the block starting at the tag at _i, not including the tag itself.
+	auto blockBegin = [&](size_t _i, AssemblyItem& _pushOwnTag)
 	{
-		if (_i == _j)
-			return false;
-
 		// To compare recursive loops, we have to already unify PushTag opcodes of the
 		// block's own tag.
+		_pushOwnTag = m_items.at(_i).pushTag();
+		BlockIterator it{m_items.begin() + diff_type(_i), m_items.end(), &_pushOwnTag, &pushSelf};
+		return ++it;
+	};
+	auto blockHash = [&](size_t _i)
+	{
+		AssemblyItem pushOwnTag{pushSelf};
+		size_t hash = 0;
+		for (BlockIterator it = blockBegin(_i, pushOwnTag); it != end; ++it)
+		{
+			AssemblyItem const& item = *it;
+			boost::hash_combine(hash, static_cast<int>(item.type()));
+			if (item.type() == Operation)
+				boost::hash_combine(hash, static_cast<uint8_t>(item.instruction()));
+			else
+				boost::hash_combine(hash, static_cast<size_t>(item.data() & numeric_limits<size_t>::max()));
+		}
+		return hash;
+	};
+	auto equalBlocks = [&](size_t _i, size_t _j)
+	{
 		AssemblyItem pushFirstTag{pushSelf};
 		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
-
-		using diff_type = BlockIterator::difference_type;
-		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
-		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
-		BlockIterator end{m_items.end(), m_items.end()};
-
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
-
-		return std::lexicographical_compare(first, end, second, end);
+		// Subroutine entries can only be replaced by subroutine entries and vice versa.
+		return
+			m_items.at(_i).isSubroutineEntry() == m_items.at(_j).isSubroutineEntry() &&
+			std::equal(blockBegin(_i, pushFirstTag), end, blockBegin(_j, pushSecondTag), end);
 	};
 
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
+		// Blocks that are not equal to any block before them, by hash of their content.
+		unordered_map<size_t, vector<size_t>> blocksSeen;
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
 			if (m_items.at(i).type() != Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			vector<size_t>& candidates = blocksSeen[blockHash(i)];
+			auto it = find_if(candidates.begin(), candidates.end(), [&](size_t _j) { return equalBlocks(i, _j); });
+			if (it == candidates.end())
+				candidates.push_back(i);
 			else
 				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
 		}
@@ -132,7 +145,11 @@ BlockDeduplicator::BlockIterator& BlockDeduplicator::BlockIterator::operator++()
 {
 	if (it == end)
 		return *this;
-	if (SemanticInformation::altersControlFlow(*it) && *it != AssemblyItem{Instruction::JUMPI})
+	if (
+		SemanticInformation::altersControlFlow(*it) &&
+		*it != AssemblyItem{Instruction::JUMPI} &&
+		*it != AssemblyItem{Instruction::JUMPSUB}
+	)
 		it = end;
 	else
 	{
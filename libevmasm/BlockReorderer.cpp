@@ -0,0 +1,190 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Changes the order of basic blocks such that unconditional jumps can be replaced
+ * by falling through to their target.
+ */
+
+#include <libevmasm/BlockReorderer.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/// @returns the tag pushed by @a _item if it is a tag of the current assembly.
+optional<size_t> localPushedTag(AssemblyItem const& _item)
+{
+	if (_item.type() != PushTag)
+		return nullopt;
+	auto [subId, tag] = _item.splitForeignPushTag();
+	if (subId != numeric_limits<size_t>::max())
+		return nullopt;
+	return tag;
+}
+
+struct Candidate
+{
+	/// Estimated loop nesting depth of the jump.
+	size_t weight;
+	size_t sourceChain;
+	size_t targetChain;
+};
+
+}
+
+bool BlockReorderer::optimise()
+{
+	// Blocks start at tags. The code before the first tag is a block, too.
+	vector<size_t> blockStart;
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (i == 0 || m_items[i].type() == Tag)
+			blockStart.emplace_back(i);
+	if (blockStart.size() < 2)
+		return false;
+	size_t const numBlocks = blockStart.size();
+	auto blockEnd = [&](size_t _block) {
+		return _block + 1 < numBlocks ? blockStart[_block + 1] : m_items.size();
+	};
+
+	map<size_t, size_t> blockOfTag;
+	vector<size_t> blockOfItem(m_items.size());
+	vector<bool> fallsThrough(numBlocks, true);
+	for (size_t block = 0; block < numBlocks; ++block)
+	{
+		if (m_items[blockStart[block]].type() == Tag)
+			blockOfTag[m_items[blockStart[block]].splitForeignPushTag().second] = block;
+		for (size_t i = blockStart[block]; i < blockEnd(block); ++i)
+		{
+			blockOfItem[i] = block;
+			if (
+				m_items[i] == AssemblyItem(Instruction::JUMP) ||
+				SemanticInformation::terminatesControlFlow(m_items[i])
+			)
+				fallsThrough[block] = false;
+		}
+	}
+
+	// Chains of blocks that continue with the next block have to stay together.
+	vector<vector<size_t>> chains;
+	vector<size_t> chainOfBlock(numBlocks);
+	for (size_t block = 0; block < numBlocks; ++block)
+	{
+		if (block == 0 || !fallsThrough[block - 1])
+			chains.emplace_back();
+		chains.back().emplace_back(block);
+		chainOfBlock[block] = chains.size() - 1;
+	}
+	// The first chain is the entry point and the last chain might fall through to the end of the code.
+	size_t const entryChain = 0;
+	optional<size_t> finalChain;
+	if (fallsThrough.back())
+		finalChain = chains.size() - 1;
+
+	// Every backwards jump is assumed to close a loop around the blocks it skips.
+	vector<size_t> loopDepth(numBlocks, 0);
+	for (size_t i = 0; i + 1 < m_items.size(); ++i)
+		if (
+			auto tag = localPushedTag(m_items[i]);
+			tag && blockOfTag.count(*tag) && SemanticInformation::isJumpInstruction(m_items[i + 1])
+		)
+			for (size_t block = blockOfTag.at(*tag); block <= blockOfItem[i]; ++block)
+				++loopDepth[block];
+
+	vector<Candidate> candidates;
+	for (size_t chain = 0; chain < chains.size(); ++chain)
+	{
+		size_t tail = chains[chain].back();
+		size_t end = blockEnd(tail);
+		if (end - blockStart[tail] < 2 || m_items[end - 1] != AssemblyItem(Instruction::JUMP))
+			continue;
+		auto tag = localPushedTag(m_items[end - 2]);
+		if (!tag || !blockOfTag.count(*tag))
+			continue;
+		size_t targetBlock = blockOfTag.at(*tag);
+		size_t targetChain = chainOfBlock[targetBlock];
+		// Execution must not run into the BEGINSUB of a subroutine entry.
+		if (
+			m_items[blockStart[targetBlock]].isSubroutineEntry() ||
+			chains[targetChain].front() != targetBlock ||
+			targetChain == chain ||
+			targetChain == entryChain ||
+			targetChain == finalChain
+		)
+			continue;
+		candidates.emplace_back(Candidate{loopDepth[tail], chain, targetChain});
+	}
+	stable_sort(candidates.begin(), candidates.end(), [](Candidate const& _a, Candidate const& _b) {
+		return _a.weight > _b.weight;
+	});
+
+	vector<size_t> representative(chains.size());
+	iota(representative.begin(), representative.end(), 0);
+	auto find = [&](size_t _chain) {
+		while (representative[_chain] != _chain)
+			_chain = representative[_chain] = representative[representative[_chain]];
+		return _chain;
+	};
+	vector<optional<size_t>> next(chains.size());
+	vector<bool> hasPredecessor(chains.size(), false);
+	bool changed = false;
+	for (Candidate const& candidate: candidates)
+	{
+		if (hasPredecessor[candidate.targetChain] || find(candidate.sourceChain) == find(candidate.targetChain))
+			continue;
+		next[candidate.sourceChain] = candidate.targetChain;
+		hasPredecessor[candidate.targetChain] = true;
+		representative[find(candidate.targetChain)] = find(candidate.sourceChain);
+		changed = true;
+	}
+	if (!changed)
+		return false;
+
+	AssemblyItems reordered;
+	reordered.reserve(m_items.size());
+	auto appendSequence = [&](size_t _chain) {
+		for (optional<size_t> chain = _chain; chain; chain = next[*chain])
+			for (size_t block: chains[*chain])
+			{
+				size_t end = blockEnd(block);
+				// Remove the jump to the chain that now follows.
+				if (block == chains[*chain].back() && next[*chain])
+					end -= 2;
+				reordered.insert(reordered.end(), m_items.begin() + ptrdiff_t(blockStart[block]), m_items.begin() + ptrdiff_t(end));
+			}
+	};
+	for (size_t chain = 0; chain < chains.size(); ++chain)
+		if (!hasPredecessor[chain] && chain != finalChain)
+			appendSequence(chain);
+	if (finalChain)
+		appendSequence(*finalChain);
+
+	m_items = move(reordered);
+	return true;
+}
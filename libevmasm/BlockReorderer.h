@@ -0,0 +1,54 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Changes the order of basic blocks such that unconditional jumps can be replaced
+ * by falling through to their target.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace solidity::evmasm
+{
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+
+/**
+ * Optimiser component that moves the target of a ``PUSH tag JUMP`` sequence directly
+ * behind the jump and removes the jump.
+ *
+ * Blocks that are connected by falling through are kept together. A block can only be moved
+ * behind a single jump, and if there are several candidates, the jump inside the most deeply
+ * nested loop (estimated from backwards jumps) is preferred. The code at the start of the
+ * assembly stays at the start and code that falls through to the end stays at the end.
+ * Modifies the passed vector in place.
+ */
+class BlockReorderer
+{
+public:
+	explicit BlockReorderer(AssemblyItems& _items): m_items(_items) {}
+
+	/// @returns true if something was changed.
+	bool optimise();
+
+private:
+	AssemblyItems& m_items;
+};
+
+}
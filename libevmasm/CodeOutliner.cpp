@@ -0,0 +1,181 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Replaces repeated code sequences that end control flow by jumps to a single copy.
+ */
+
+#include <libevmasm/CodeOutliner.h>
+
+#include <libevmasm/Assembly.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <optional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/// Items at the end of a block up to and including the item that ends control flow.
+struct Tail
+{
+	size_t begin;
+	size_t end;
+};
+
+/// Bytes assumed for a tag, like in the constant optimiser.
+size_t constexpr tagBytes = 3;
+
+}
+
+bool CodeOutliner::optimise()
+{
+	AssemblyItems& items = m_assembly.items();
+
+	// The items of a tail cannot cross a tag. Assignments to immutables are not moved.
+	vector<Tail> tails;
+	size_t begin = 0;
+	bool ended = false;
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		AssemblyItem const& item = items[i];
+		if (item.type() == Tag)
+		{
+			begin = i + 1;
+			ended = false;
+		}
+		else if (ended)
+			continue;
+		else if (item.type() == AssignImmutable)
+			begin = i + 1;
+		else if (item == Instruction::JUMP || SemanticInformation::terminatesControlFlow(item))
+		{
+			tails.emplace_back(Tail{begin, i + 1});
+			ended = true;
+		}
+	}
+
+	// Sorting the tails by their reversed items puts tails with long common suffixes next to each other.
+	vector<size_t> order(tails.size());
+	iota(order.begin(), order.end(), 0);
+	auto reversedRange = [&](Tail const& _tail) {
+		return make_pair(
+			items.rbegin() + static_cast<ptrdiff_t>(items.size() - _tail.end),
+			items.rbegin() + static_cast<ptrdiff_t>(items.size() - _tail.begin)
+		);
+	};
+	stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+		auto [beginA, endA] = reversedRange(tails[_a]);
+		auto [beginB, endB] = reversedRange(tails[_b]);
+		return lexicographical_compare(beginA, endA, beginB, endB);
+	});
+	auto commonSuffixLength = [&](Tail const& _a, Tail const& _b) {
+		size_t length = 0;
+		while (
+			length < _a.end - _a.begin &&
+			length < _b.end - _b.begin &&
+			items[_a.end - 1 - length] == items[_b.end - 1 - length]
+		)
+			++length;
+		return length;
+	};
+
+	bigint const gasPerByte = m_isCreation ? GasCosts::txDataNonZeroGas(m_evmVersion) : GasCosts::createDataGas;
+	// The runs are per opcode, so the costs of the jumps are not multiplied by their number.
+	bigint const jumpRunGas =
+		bigint(m_runs) * (GasMeter::runGas(Instruction::PUSH1) + GasMeter::runGas(Instruction::JUMP) + GasCosts::jumpdestGas);
+	auto gain = [&](size_t _occurrences, Tail const& _tail, size_t _length) -> bigint {
+		size_t sharedBytes = 0;
+		for (size_t i = _tail.end - _length; i < _tail.end; ++i)
+			sharedBytes += items[i].bytesRequired(tagBytes);
+		// All but one occurrence are replaced by "PUSH tag JUMP", the remaining one gets a JUMPDEST.
+		bigint savedBytes =
+			bigint(_occurrences - 1) * (bigint(sharedBytes) - bigint(tagBytes + 2)) - 1;
+		return savedBytes * gasPerByte - jumpRunGas;
+	};
+
+	// Maps the position of a shared sequence to the tag of the copy that is kept
+	// and the position of the other occurrences to their length and the tag.
+	map<size_t, AssemblyItem> newTags;
+	map<size_t, pair<size_t, AssemblyItem>> replacements;
+	for (size_t i = 0; i < order.size();)
+	{
+		size_t length = tails[order[i]].end - tails[order[i]].begin;
+		bigint bestGain = 0;
+		optional<pair<size_t, size_t>> bestGroup;
+		for (size_t j = i + 1; j < order.size(); ++j)
+		{
+			length = min(length, commonSuffixLength(tails[order[j - 1]], tails[order[j]]));
+			if (length == 0)
+				break;
+			bigint groupGain = gain(j - i + 1, tails[order[i]], length);
+			if (groupGain > bestGain)
+			{
+				bestGain = groupGain;
+				bestGroup = make_pair(j, length);
+			}
+		}
+		if (!bestGroup)
+		{
+			++i;
+			continue;
+		}
+
+		auto [last, sharedLength] = *bestGroup;
+		vector<size_t> positions;
+		for (size_t k = i; k <= last; ++k)
+			positions.emplace_back(tails[order[k]].end - sharedLength);
+		sort(positions.begin(), positions.end());
+		AssemblyItem tag = m_assembly.newTag();
+		tag.setLocation(items[positions.front()].location());
+		newTags.emplace(positions.front(), tag);
+		for (size_t k = 1; k < positions.size(); ++k)
+			replacements.emplace(positions[k], make_pair(sharedLength, tag));
+		i = last + 1;
+	}
+	if (newTags.empty())
+		return false;
+
+	AssemblyItems outlined;
+	outlined.reserve(items.size());
+	for (size_t i = 0; i < items.size();)
+		if (auto newTag = newTags.find(i); newTag != newTags.end())
+		{
+			outlined.emplace_back(newTag->second);
+			newTags.erase(newTag);
+		}
+		else if (auto replacement = replacements.find(i); replacement != replacements.end())
+		{
+			auto const& [sharedLength, tag] = replacement->second;
+			outlined.emplace_back(tag.pushTag());
+			outlined.back().setLocation(items[i].location());
+			outlined.emplace_back(Instruction::JUMP, items[i].location());
+			i += sharedLength;
+		}
+		else
+			outlined.emplace_back(items[i++]);
+
+	items = move(outlined);
+	return true;
+}
@@ -0,0 +1,58 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Replaces repeated code sequences that end control flow by jumps to a single copy.
+ */
+#pragma once
+
+#include <liblangutil/EVMVersion.h>
+
+#include <cstddef>
+
+namespace solidity::evmasm
+{
+
+class Assembly;
+
+/**
+ * Optimiser component that shares the code at the end of basic blocks.
+ *
+ * Code sequences that end with a terminating instruction or a jump (e.g. the encoding of a
+ * revert reason or a panic, or the return from a function) do not need a return address,
+ * so all but one of their occurrences can be replaced by a jump to the remaining one,
+ * which gets a new tag. The items before the sequences may differ.
+ * A group of sequences is only shared if the smaller code outweighs the costs of the
+ * additional jumps for the expected number of runs.
+ */
+class CodeOutliner
+{
+public:
+	CodeOutliner(Assembly& _assembly, bool _isCreation, size_t _runs, langutil::EVMVersion _evmVersion):
+		m_assembly(_assembly), m_isCreation(_isCreation), m_runs(_runs), m_evmVersion(_evmVersion) {}
+
+	/// @returns true if something was changed.
+	bool optimise();
+
+private:
+	Assembly& m_assembly;
+	bool m_isCreation;
+	size_t m_runs;
+	langutil::EVMVersion m_evmVersion;
+};
+
+}
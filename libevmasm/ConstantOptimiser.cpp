@@ -24,10 +24,59 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <map>
+#include <mutex>
+#include <optional>
+#include <tuple>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
+namespace
+{
+
+/// Routines found by ComputeMethod, keyed by value and the parameters that influence the search.
+/// Shared between all contracts and compilations in the process, so that e.g. the same
+/// masks and selectors are not decomposed again for every contract.
+class ComputeMethodCache
+{
+public:
+	using Key = tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+
+	static ComputeMethodCache& instance()
+	{
+		static ComputeMethodCache cache;
+		return cache;
+	}
+
+	optional<AssemblyItems> find(Key const& _key)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_routines.find(_key);
+		if (it == m_routines.end())
+			return nullopt;
+		return it->second;
+	}
+
+	void insert(Key _key, AssemblyItems _routine)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		// Bound the memory used by long-running processes.
+		if (m_routines.size() >= maxEntries)
+			m_routines.clear();
+		m_routines.emplace(move(_key), move(_routine));
+	}
+
+private:
+	static size_t constexpr maxEntries = 0x10000;
+
+	mutex m_mutex;
+	map<Key, AssemblyItems> m_routines;
+};
+
+}
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -187,6 +236,24 @@ AssemblyItems const& CodeCopyMethod::copyRoutine()
 	return copyRoutine;
 }
 
+ComputeMethod::ComputeMethod(Params const& _params, u256 const& _value):
+	ConstantOptimisationMethod(_params, _value)
+{
+	ComputeMethodCache::Key key{m_value, m_params.isCreation, m_params.runs, m_params.multiplicity, m_params.evmVersion};
+	if (optional<AssemblyItems> routine = ComputeMethodCache::instance().find(key))
+	{
+		m_routine = move(*routine);
+		return;
+	}
+	m_routine = findRepresentation(m_value);
+	assertThrow(
+		checkRepresentation(m_value, m_routine),
+		OptimizerException,
+		"Invalid constant expression created."
+	);
+	ComputeMethodCache::instance().insert(move(key), m_routine);
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
@@ -131,16 +131,9 @@ protected:
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
-	{
-		m_routine = findRepresentation(m_value);
-		assertThrow(
-			checkRepresentation(m_value, m_routine),
-			OptimizerException,
-			"Invalid constant expression created."
-		);
-	}
+	/// Looks up or finds the routine for @a _value. Routines only depend on the value and
+	/// the parameters, so they are shared across all instances in the process.
+	explicit ComputeMethod(Params const& _params, u256 const& _value);
 
 	bigint gasNeeded() const override { return gasNeeded(m_routine); }
 	AssemblyItems execute(Assembly&) const override
@@ -96,6 +96,9 @@ void ControlFlowGraph::splitBlocks()
 				m_blocks[id].endType = BasicBlock::EndType::JUMP;
 			else if (item == Instruction::JUMPI)
 				m_blocks[id].endType = BasicBlock::EndType::JUMPI;
+			else if (item == Instruction::JUMPSUB)
+				// The subroutine returns to the next item.
+				m_blocks[id].endType = BasicBlock::EndType::HANDOVER;
 			else
 				m_blocks[id].endType = BasicBlock::EndType::STOP;
 			id = BlockId::invalid();
@@ -267,9 +270,11 @@ void ControlFlowGraph::gatherKnowledge()
 		while (pc < block.end && !SemanticInformation::altersControlFlow(m_items.at(pc)))
 			state->feedItem(m_items.at(pc++));
 
+		bool const jumpsIntoSubroutine = block.begin < block.end && m_items.at(block.end - 1) == Instruction::JUMPSUB;
 		if (
 			block.endType == BasicBlock::EndType::JUMP ||
-			block.endType == BasicBlock::EndType::JUMPI
+			block.endType == BasicBlock::EndType::JUMPI ||
+			jumpsIntoSubroutine
 		)
 		{
 			assertThrow(block.begin <= pc && pc == block.end - 1, OptimizerException, "");
@@ -302,7 +307,10 @@ void ControlFlowGraph::gatherKnowledge()
 
 		block.endState = state;
 
-		if (
+		if (jumpsIntoSubroutine)
+			// We do not know what the subroutine did before returning.
+			addWorkQueueItem(item, block.next, emptyState);
+		else if (
 			block.endType == BasicBlock::EndType::HANDOVER ||
 			block.endType == BasicBlock::EndType::JUMPI
 		)
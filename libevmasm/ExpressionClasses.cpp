@@ -27,7 +27,10 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <functional>
+#include <limits>
 #include <tuple>
 #include <utility>
 
@@ -55,6 +58,32 @@ bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression cons
 			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
 }
 
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
+{
+	assertThrow(!!item && !!_other.item, OptimizerException, "");
+	if (item->type() != _other.item->type() || arguments != _other.arguments || sequenceNumber != _other.sequenceNumber)
+		return false;
+	if (item->type() == Operation)
+		return item->instruction() == _other.item->instruction();
+	else
+		return item->data() == _other.item->data();
+}
+
+size_t ExpressionClasses::ExpressionHash::operator()(ExpressionClasses::Expression const& _expression) const
+{
+	assertThrow(!!_expression.item, OptimizerException, "");
+	size_t seed = 0;
+	AssemblyItem const& item = *_expression.item;
+	boost::hash_combine(seed, static_cast<int>(item.type()));
+	if (item.type() == Operation)
+		boost::hash_combine(seed, static_cast<uint8_t>(item.instruction()));
+	else
+		boost::hash_combine(seed, static_cast<size_t>(item.data() & numeric_limits<size_t>::max()));
+	boost::hash_range(seed, _expression.arguments.begin(), _expression.arguments.end());
+	boost::hash_combine(seed, _expression.sequenceNumber);
+	return seed;
+}
+
 ExpressionClasses::Id ExpressionClasses::find(
 	AssemblyItem const& _item,
 	Ids const& _arguments,
@@ -160,8 +189,7 @@ u256 const* ExpressionClasses::knownConstant(Id _c)
 
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
 {
-	m_spareAssemblyItems.push_back(make_shared<AssemblyItem>(_item));
-	return m_spareAssemblyItems.back().get();
+	return &m_spareAssemblyItems.emplace_back(_item);
 }
 
 string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
@@ -183,7 +211,7 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	static Rules const rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
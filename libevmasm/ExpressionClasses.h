@@ -27,10 +27,11 @@
 #include <libsolutil/Common.h>
 #include <libevmasm/AssemblyItem.h>
 
+#include <deque>
 #include <vector>
 #include <map>
 #include <memory>
-#include <set>
+#include <unordered_set>
 
 namespace solidity::langutil
 {
@@ -62,7 +63,18 @@ public:
 		unsigned sequenceNumber = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
 		bool operator<(Expression const& _other) const;
+		/// Equality consistent with operator<, the id is not compared.
+		bool operator==(Expression const& _other) const;
 	};
+	struct ExpressionHash
+	{
+		size_t operator()(Expression const& _expression) const;
+	};
+
+	ExpressionClasses() = default;
+	/// Expressions point to the items stored in this object, so it cannot be copied.
+	ExpressionClasses(ExpressionClasses const&) = delete;
+	ExpressionClasses& operator=(ExpressionClasses const&) = delete;
 
 	/// Retrieves the id of the expression equivalence class resulting from the given item applied to the
 	/// given classes, might also create a new one.
@@ -122,8 +134,9 @@ private:
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
-	std::set<Expression> m_expressions;
-	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
+	std::unordered_set<Expression, ExpressionHash> m_expressions;
+	/// Items copied by storeItem. A deque does not move its elements when growing.
+	std::deque<AssemblyItem> m_spareAssemblyItems;
 };
 
 }
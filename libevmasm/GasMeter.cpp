@@ -56,7 +56,8 @@ GasMeter::GasConsumption GasMeter::estimateMax(AssemblyItem const& _item, bool _
 		gas = runGas(Instruction::PUSH1);
 		break;
 	case Tag:
-		gas = runGas(Instruction::JUMPDEST);
+		// JUMPSUB continues after the BEGINSUB of a subroutine entry.
+		gas = _item.isSubroutineEntry() ? 0 : runGas(Instruction::JUMPDEST);
 		break;
 	case Operation:
 	{
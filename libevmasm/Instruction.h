@@ -101,6 +101,9 @@ enum class Instruction: uint8_t
 	MSIZE,				///< get the size of active memory
 	GAS,				///< get the amount of available gas
 	JUMPDEST,			///< set a potential jump destination
+	BEGINSUB,			///< set a potential jumpsub destination
+	RETURNSUB,			///< return to subroutine jumped from
+	JUMPSUB,			///< alter the program counter to a beginsub
 
 	PUSH1 = 0x60,		///< place 1 byte item on stack
 	PUSH2,				///< place 2 byte item on stack
@@ -386,8 +386,8 @@ KnownState::Id KnownState::applyKeccak256(
 		);
 		arguments.push_back(loadFromMemory(slot, _location));
 	}
-	if (m_knownKeccak256Hashes.count(arguments))
-		return m_knownKeccak256Hashes.at(arguments);
+	if (auto it = m_knownKeccak256Hashes.find(arguments); it != m_knownKeccak256Hashes.end())
+		return it->second;
 	Id v;
 	// If all arguments are known constants, compute the Keccak-256 here
 	if (all_of(arguments.begin(), arguments.end(), [this](Id _a) { return !!m_expressionClasses->knownConstant(_a); }))
@@ -400,7 +400,7 @@ KnownState::Id KnownState::applyKeccak256(
 	}
 	else
 		v = m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
-	return m_knownKeccak256Hashes[arguments] = v;
+	return m_knownKeccak256Hashes[move(arguments)] = v;
 }
 
 set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
@@ -31,6 +31,7 @@
 #include <tuple>
 #include <memory>
 #include <ostream>
+#include <unordered_map>
 
 #if defined(__clang__)
 #pragma clang diagnostic push
@@ -38,6 +39,7 @@
 #endif // defined(__clang__)
 
 #include <boost/bimap.hpp>
+#include <boost/functional/hash.hpp>
 
 #if defined(__clang__)
 #pragma clang diagnostic pop
@@ -173,8 +175,9 @@ private:
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
 	std::map<Id, Id> m_memoryContent;
-	/// Keeps record of all Keccak-256 hashes that are computed.
-	std::map<std::vector<Id>, Id> m_knownKeccak256Hashes;
+	/// Keeps record of all Keccak-256 hashes that are computed. Only used for lookups, so the
+	/// order of the entries does not matter.
+	std::unordered_map<std::vector<Id>, Id, boost::hash<std::vector<Id>>> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
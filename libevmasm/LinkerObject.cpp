@@ -24,6 +24,8 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Keccak256.h>
 
+#include <unordered_map>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -38,25 +40,41 @@ void LinkerObject::append(LinkerObject const& _other)
 
 void LinkerObject::link(map<string, h160> const& _libraryAddresses)
 {
+	if (linkReferences.empty() || _libraryAddresses.empty())
+		return;
+
+	// There are usually many references to few libraries, so each name is only matched once.
+	unordered_map<string, h160 const*> addresses;
 	std::map<size_t, std::string> remainingRefs;
 	for (auto const& linkRef: linkReferences)
-		if (h160 const* address = matchLibrary(linkRef.second, _libraryAddresses))
-			copy(address->data(), address->data() + 20, bytecode.begin() + vector<uint8_t>::difference_type(linkRef.first));
+	{
+		auto address = addresses.find(linkRef.second);
+		if (address == addresses.end())
+			address = addresses.emplace(linkRef.second, matchLibrary(linkRef.second, _libraryAddresses)).first;
+		if (address->second)
+			copy(
+				address->second->data(),
+				address->second->data() + 20,
+				bytecode.begin() + vector<uint8_t>::difference_type(linkRef.first)
+			);
 		else
-			remainingRefs.insert(linkRef);
+			remainingRefs.emplace_hint(remainingRefs.end(), linkRef);
+	}
 	linkReferences.swap(remainingRefs);
 }
 
 string LinkerObject::toHex() const
 {
 	string hex = solidity::util::toHex(bytecode);
+	unordered_map<string, string> placeholders;
 	for (auto const& ref: linkReferences)
 	{
 		size_t pos = ref.first * 2;
-		string hash = libraryPlaceholder(ref.second);
+		auto hash = placeholders.find(ref.second);
+		if (hash == placeholders.end())
+			hash = placeholders.emplace(ref.second, libraryPlaceholder(ref.second)).first;
 		hex[pos] = hex[pos + 1] = hex[pos + 38] = hex[pos + 39] = '_';
-		for (size_t i = 0; i < 36; ++i)
-			hex[pos + 2 + i] = hash.at(i);
+		copy(hash->second.begin(), hash->second.begin() + 36, hex.begin() + static_cast<ptrdiff_t>(pos + 2));
 	}
 	return hex;
 }
@@ -28,8 +28,12 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
-PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
-	m_items(_items), m_evmVersion(_evmVersion)
+PathGasMeter::PathGasMeter(
+	AssemblyItems const& _items,
+	langutil::EVMVersion _evmVersion,
+	unsigned _maxLoopIterations
+):
+	m_items(_items), m_evmVersion(_evmVersion), m_maxLoopIterations(_maxLoopIterations)
 {
 	for (size_t i = 0; i < m_items.size(); ++i)
 		if (m_items[i].type() == Tag)
@@ -90,11 +94,11 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 		AssemblyItem const& item = m_items.at(index);
 		if (item.type() == Tag || item == AssemblyItem(Instruction::JUMPDEST))
 		{
-			// Do not allow any backwards jump. This is quite restrictive but should work for
-			// the simplest things.
-			if (path->visitedJumpdests.count(index))
-				return GasMeter::GasConsumption::infinite();
-			path->visitedJumpdests.insert(index);
+			// Do not allow any backwards jump unless a number of loop iterations is given.
+			// This is quite restrictive but should work for the simplest things.
+			// Paths with more iterations than that are not followed further.
+			if (path->visitedJumpdests[index]++ > m_maxLoopIterations)
+				return m_maxLoopIterations == 0 ? GasMeter::GasConsumption::infinite() : gas;
 		}
 		else if (item == AssemblyItem(Instruction::JUMP))
 		{
@@ -114,6 +118,9 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 			}
 			branchStops = classes.knownNonZero(condition);
 		}
+		else if (item == AssemblyItem(Instruction::JUMPSUB))
+			// Subroutines are not followed.
+			return GasMeter::GasConsumption::infinite();
 		else if (SemanticInformation::altersControlFlow(item))
 			branchStops = true;
 
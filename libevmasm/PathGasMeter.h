@@ -26,6 +26,7 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <map>
 #include <set>
 #include <vector>
 #include <memory>
@@ -41,18 +42,26 @@ struct GasPath
 	std::shared_ptr<KnownState> state;
 	u256 largestMemoryAccess;
 	GasMeter::GasConsumption gas;
-	std::set<size_t> visitedJumpdests;
+	/// Number of times each jumpdest was visited on this path.
+	std::map<size_t, unsigned> visitedJumpdests;
 };
 
 /**
  * Computes an upper bound on the gas usage of a computation starting at a certain position in
  * a list of AssemblyItems in a given state until the computation stops.
  * Can be used to estimate the gas usage of functions on any given input.
+ * Any loop makes the estimate infinite unless a maximum number of loop iterations is given,
+ * in which case the bound only holds for executions that reach no jumpdest more than
+ * @a _maxLoopIterations + 1 times.
  */
 class PathGasMeter
 {
 public:
-	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+	explicit PathGasMeter(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		unsigned _maxLoopIterations = 0
+	);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
@@ -60,10 +69,11 @@ public:
 		AssemblyItems const& _items,
 		langutil::EVMVersion _evmVersion,
 		size_t _startIndex,
-		std::shared_ptr<KnownState> const& _state
+		std::shared_ptr<KnownState> const& _state,
+		unsigned _maxLoopIterations = 0
 	)
 	{
-		return PathGasMeter(_items, _evmVersion).estimateMax(_startIndex, _state);
+		return PathGasMeter(_items, _evmVersion, _maxLoopIterations).estimateMax(_startIndex, _state);
 	}
 
 private:
@@ -81,6 +91,7 @@ private:
 	std::map<u256, size_t> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
+	unsigned m_maxLoopIterations = 0;
 };
 
 }
@@ -96,15 +96,6 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
-{
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		*_out = _item;
-		return true;
-	}
-};
-
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 {
 	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
@@ -345,6 +336,7 @@ struct UnreachableCode
 			return false;
 		if (
 			it[0] != Instruction::JUMP &&
+			it[0] != Instruction::RETURNSUB &&
 			it[0] != Instruction::RETURN &&
 			it[0] != Instruction::STOP &&
 			it[0] != Instruction::INVALID &&
@@ -367,16 +359,17 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+bool applyMethods(OptimiserState&)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
+/// Applies the first method that matches at the current position.
+/// @returns false if none of them matches.
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+bool applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return Method::apply(_state) || applyMethods(_state, _other...);
 }
 
 size_t numberOfPops(AssemblyItems const& _items)
@@ -389,13 +382,42 @@ size_t numberOfPops(AssemblyItems const& _items)
 bool PeepholeOptimiser::optimise()
 {
 	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
+	// Items that are not matched by any method are only copied to the output
+	// once a method matched after them, so that a pass without any match does not copy anything.
+	size_t unmatchedBegin = 0;
+	bool matched = false;
 	while (state.i < m_items.size())
-		applyMethods(
+	{
+		size_t position = state.i;
+		size_t outputSize = m_optimisedItems.size();
+		if (applyMethods(
 			state,
 			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
 			DupSwap(), IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
+			TagConjunctions(), TruthyAnd()
+		))
+		{
+			if (!matched)
+				m_optimisedItems.reserve(m_items.size());
+			matched = true;
+			m_optimisedItems.insert(
+				m_optimisedItems.begin() + static_cast<ptrdiff_t>(outputSize),
+				m_items.begin() + static_cast<ptrdiff_t>(unmatchedBegin),
+				m_items.begin() + static_cast<ptrdiff_t>(position)
+			);
+			unmatchedBegin = state.i;
+		}
+		else
+			++state.i;
+	}
+	if (!matched)
+		return false;
+	m_optimisedItems.insert(
+		m_optimisedItems.end(),
+		m_items.begin() + static_cast<ptrdiff_t>(unmatchedBegin),
+		m_items.end()
+	);
+
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3) < evmasm::bytesRequired(m_items, 3) ||
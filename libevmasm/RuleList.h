@@ -80,7 +80,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : s2u(divWorkaround(u2s(A.d()), u2s(B.d()))); }},
 		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : modWorkaround(A.d(), B.d()); }},
 		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : s2u(modWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::EXP(A, B), [=]{ return Word(boost::multiprecision::powm(bigint(A.d()), bigint(B.d()), bigint(1) << Pattern::WordSize)); }},
+		{Builtins::EXP(A, B), [=]{ return exp256(A.d(), B.d()); }},
 		{Builtins::NOT(A), [=]{ return ~A.d(); }},
 		{Builtins::LT(A, B), [=]() -> Word { return A.d() < B.d() ? 1 : 0; }},
 		{Builtins::GT(A, B), [=]() -> Word { return A.d() > B.d() ? 1 : 0; }},
@@ -97,8 +97,8 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 				0 :
 				(B.d() >> unsigned(8 * (Pattern::WordSize / 8 - 1 - A.d()))) & 0xff;
 		}},
-		{Builtins::ADDMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) + bigint(B.d())) % C.d()); }},
-		{Builtins::MULMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) * bigint(B.d())) % C.d()); }},
+		{Builtins::ADDMOD(A, B, C), [=]{ return addmod256(A.d(), B.d(), C.d()); }},
+		{Builtins::MULMOD(A, B, C), [=]{ return mulmod256(A.d(), B.d(), C.d()); }},
 		{Builtins::SIGNEXTEND(A, B), [=]() -> Word {
 			if (A.d() >= Pattern::WordSize / 8 - 1)
 				return B.d();
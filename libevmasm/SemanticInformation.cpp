@@ -124,6 +124,8 @@ bool SemanticInformation::altersControlFlow(AssemblyItem const& _item)
 	// continue on the next instruction
 	case Instruction::JUMP:
 	case Instruction::JUMPI:
+	case Instruction::JUMPSUB:
+	case Instruction::RETURNSUB:
 	case Instruction::RETURN:
 	case Instruction::SELFDESTRUCT:
 	case Instruction::STOP:
@@ -148,6 +150,7 @@ bool SemanticInformation::terminatesControlFlow(Instruction _instruction)
 	switch (_instruction)
 	{
 	case Instruction::RETURN:
+	case Instruction::RETURNSUB:
 	case Instruction::SELFDESTRUCT:
 	case Instruction::STOP:
 	case Instruction::INVALID:
@@ -46,6 +46,8 @@ class Pattern;
 
 /**
  * Container for all simplification rules.
+ * The rules are immutable after construction, the state of the current match is
+ * stored per thread, so one instance can be shared between threads.
  */
 class Rules: public boost::noncopyable
 {
@@ -59,7 +61,7 @@ public:
 	SimplificationRule<Pattern> const* findFirstMatch(
 		Expression const& _expr,
 		ExpressionClasses const& _classes
-	);
+	) const;
 
 	/// Checks whether the rulelist is non-empty. This is usually enforced
 	/// by the constructor, but we had some issues with static initialization.
@@ -69,9 +71,8 @@ private:
 	void addRules(std::vector<SimplificationRule<Pattern>> const& _rules);
 	void addRule(SimplificationRule<Pattern> const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	static void resetMatchGroups();
 
-	std::map<unsigned, Expression const*> m_matchGroups;
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
 	std::vector<SimplificationRule<Pattern>> m_rules[256];
@@ -106,6 +107,9 @@ public:
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
 	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	/// Sets this pattern to be part of the match group with the identifier @a _group
+	/// of the rule currently matched by this thread in Rules::findFirstMatch.
+	void setMatchGroup(unsigned _group);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
 
@@ -129,6 +133,7 @@ public:
 private:
 	bool matchesBaseItem(AssemblyItem const* _item) const;
 	Expression const& matchGroupValue() const;
+	std::map<unsigned, Expression const*>& matchGroups() const;
 	u256 const& data() const;
 
 	AssemblyItemType m_type;
@@ -137,6 +142,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_type is not Operation
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
+	/// Match groups to use, or nullptr for those of the rule currently matched by this thread.
 	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
 };
 
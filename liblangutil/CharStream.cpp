@@ -53,6 +53,8 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
@@ -64,7 +66,7 @@ char CharStream::advanceAndGet(size_t _chars)
 	m_position += _chars;
 	if (isPastEndOfInput())
 		return 0;
-	return m_source[m_position];
+	return (*m_source)[m_position];
 }
 
 char CharStream::rollback(size_t _amount)
@@ -76,7 +78,7 @@ char CharStream::rollback(size_t _amount)
 
 char CharStream::setPosition(size_t _location)
 {
-	solAssert(_location <= m_source.size(), "Attempting to set position past end of source.");
+	solAssert(_location <= m_source->size(), "Attempting to set position past end of source.");
 	m_position = _location;
 	return get();
 }
@@ -84,19 +86,16 @@ char CharStream::setPosition(size_t _location)
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), size_type(_position));
+	string const& source = *m_source;
+	size_t searchStart = min<size_t>(source.size(), size_t(_position));
 	if (searchStart > 0)
 		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	string line = m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	// The line contains the character at searchStart, unless that is a line break itself.
+	vector<size_t> const& starts = lineStarts();
+	auto next = upper_bound(starts.begin(), starts.end(), searchStart + 1);
+	size_t lineStart = *prev(next);
+	size_t lineEnd = next == starts.end() ? source.size() : *next - 1;
+	string line = source.substr(lineStart, lineEnd - lineStart);
 	if (!line.empty() && line.back() == '\r')
 		line.pop_back();
 	return line;
@@ -104,17 +103,22 @@ string CharStream::lineAtPosition(int _position) const
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	using diff_type = string::difference_type;
-	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	size_t searchPosition = min<size_t>(m_source->size(), size_t(_position));
+	vector<size_t> const& starts = lineStarts();
+	auto lineStart = prev(upper_bound(starts.begin(), starts.end(), searchPosition));
+	return tuple<int, int>(
+		static_cast<int>(lineStart - starts.begin()),
+		static_cast<int>(searchPosition - *lineStart)
+	);
+}
+
+vector<size_t> const& CharStream::lineStarts() const
+{
+	call_once(m_lineIndex->created, [&]() {
+		string const& source = *m_source;
+		m_lineIndex->lineStarts.push_back(0);
+		for (size_t position = source.find('\n'); position != string::npos; position = source.find('\n', position + 1))
+			m_lineIndex->lineStarts.push_back(position + 1);
+	});
+	return m_lineIndex->lineStarts;
 }
@@ -53,9 +53,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -64,19 +67,38 @@ namespace solidity::langutil
  * Bidirectional stream of characters.
  *
  * This CharStream is used by lexical analyzers as the source.
+ * The source text is immutable and can be shared with other CharStreams and with the code
+ * that loaded it, so that it does not have to be copied. Copies of a stream also share the
+ * index of the line starts used to translate positions to lines and columns.
  */
 class CharStream
 {
 public:
-	CharStream() = default;
+	CharStream(): CharStream(std::string{}, std::string{}) {}
 	explicit CharStream(std::string  _source, std::string  name):
-		m_source(std::move(_source)), m_name(std::move(name)) {}
+		CharStream(std::make_shared<std::string const>(std::move(_source)), std::move(name)) {}
+	/// Creates a stream that shares the buffer @a _source, which must not be null.
+	explicit CharStream(std::shared_ptr<std::string const> _source, std::string _name):
+		m_source(std::move(_source)), m_name(std::move(_name)) {}
 
 	size_t position() const { return m_position; }
-	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
+	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source->size(); }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	char get(size_t _charsForward = 0) const { return (*m_source)[m_position + _charsForward]; }
 	char advanceAndGet(size_t _chars = 1);
+	/// Advances past all characters starting at the current position that satisfy @a _predicate.
+	/// This works on the buffer directly and is meant for the inner loops of the scanner.
+	/// @returns the character at the new position or 0 at the end of input.
+	template <typename Predicate>
+	char advanceWhile(Predicate _predicate)
+	{
+		std::string const& source = *m_source;
+		size_t position = m_position;
+		while (position < source.size() && _predicate(source[position]))
+			++position;
+		m_position = position;
+		return position < source.size() ? source[position] : 0;
+	}
 	/// Sets scanner position to @ _amount characters backwards in source text.
 	/// @returns The character of the current location after update is returned.
 	char rollback(size_t _amount);
@@ -87,13 +109,16 @@ public:
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	std::string const& source() const noexcept { return *m_source; }
+	/// @returns the buffer holding the source text, which can be used to create further streams
+	/// or to keep the text alive without copying it.
+	std::shared_ptr<std::string const> const& sharedSource() const noexcept { return m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors and source locations.
+	/// The first call scans the source for line breaks, later calls only perform a binary search.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
@@ -113,9 +138,20 @@ public:
 	}
 
 private:
-	std::string m_source;
+	struct LineIndex
+	{
+		std::once_flag created;
+		/// Offsets of the first characters of all lines, in ascending order.
+		std::vector<size_t> lineStarts;
+	};
+
+	/// @returns the offsets of the starts of all lines, creating the index on the first call.
+	std::vector<size_t> const& lineStarts() const;
+
+	std::shared_ptr<std::string const> m_source;
 	std::string m_name;
 	size_t m_position{0};
+	std::shared_ptr<LineIndex> m_lineIndex = std::make_shared<LineIndex>();
 };
 
 }
@@ -46,6 +46,10 @@ bool EVMVersion::hasOpcode(Instruction _opcode) const
 		return hasChainID();
 	case Instruction::SELFBALANCE:
 		return hasSelfBalance();
+	case Instruction::BEGINSUB:
+	case Instruction::JUMPSUB:
+	case Instruction::RETURNSUB:
+		return hasSubroutines();
 	default:
 		return true;
 	}
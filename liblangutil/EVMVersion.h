@@ -87,6 +87,8 @@ public:
 	bool hasExtCodeHash() const { return *this >= constantinople(); }
 	bool hasChainID() const { return *this >= istanbul(); }
 	bool hasSelfBalance() const { return *this >= istanbul(); }
+	/// Has the BEGINSUB, JUMPSUB and RETURNSUB opcodes (EIP-2315).
+	bool hasSubroutines() const { return *this >= berlin(); }
 
 	bool hasOpcode(evmasm::Instruction _opcode) const;
 
@@ -256,11 +256,28 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 		return _else;
 }
 
+namespace
+{
+
+/// @returns false if @a _c is a line feed, vertical tab, form feed or carriage return or the
+/// first byte of the UTF-8 encoding of NEL, LS or PS.
+bool cannotStartUnicodeLinebreak(char _c)
+{
+	auto const c = static_cast<uint8_t>(_c);
+	return (c < 0x0a || 0x0d < c) && c != 0xc2 && c != 0xe2;
+}
+
+}
+
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
+	// m_char may differ from the character in the source, see skipMultiLineComment().
+	if (isWhiteSpace(m_char))
+	{
 		advance();
+		m_char = m_source->advanceWhile([](char _c) { return isWhiteSpace(_c); });
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -268,8 +285,11 @@ bool Scanner::skipWhitespace()
 bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char) && !isUnicodeLinebreak())
+	if (isWhiteSpace(m_char) && !isUnicodeLinebreak())
+	{
 		advance();
+		m_char = m_source->advanceWhile([](char _c) { return _c == ' ' || _c == '\t'; });
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -294,11 +314,16 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 	};
 
 	size_t endPosition = _stream.position();
-	_stream.setPosition(_startPosition);
 
 	int directionOverrideDepth = 0;
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	// All the sequences start with 0xE2, so only positions holding that byte need to be checked.
+	string const& source = _stream.source();
+	for (
+		size_t currentPos = source.find('\xE2', _startPosition);
+		currentPos < endPosition;
+		currentPos = source.find('\xE2', currentPos + 1)
+	)
 	{
 		_stream.setPosition(currentPos);
 
@@ -323,8 +348,11 @@ Token Scanner::skipSingleLineComment()
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source->position();
 	while (!isUnicodeLinebreak())
-		if (!advance())
+	{
+		m_char = m_source->advanceWhile(cannotStartUnicodeLinebreak);
+		if (isUnicodeLinebreak() || !advance())
 			break;
+	}
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -394,6 +422,14 @@ size_t Scanner::scanSingleLineDocComment()
 			break;
 		addCommentLiteralChar(m_char);
 		advance();
+
+		size_t const runStart = sourcePos();
+		m_char = m_source->advanceWhile(cannotStartUnicodeLinebreak);
+		if (sourcePos() != runStart)
+		{
+			addCommentLiteralCharsFrom(runStart);
+			endPosition = sourcePos() - 1;
+		}
 	}
 	literal.complete();
 	return endPosition;
@@ -402,26 +438,23 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source->position();
-	while (!isSourcePastEndOfInput())
+	size_t const endPosition = source().find("*/", startPosition);
+	if (endPosition == string::npos)
 	{
-		char prevChar = m_char;
-		advance();
+		// Unterminated multi-line comment.
+		m_char = m_source->setPosition(source().size());
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+	// We consume the '/' and insert a whitespace. This way all
+	// multi-line comments are treated as whitespace.
+	m_char = m_source->setPosition(endPosition + 1);
+	ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+		return setError(unicodeDirectionError);
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
-	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -471,6 +504,10 @@ Token Scanner::scanMultiLineDocComment()
 		addCommentLiteralChar(m_char);
 		charsAdded = true;
 		advance();
+
+		size_t const runStart = sourcePos();
+		m_char = m_source->advanceWhile([](char _c) { return _c != '*' && _c != '\n' && _c != '\r'; });
+		addCommentLiteralCharsFrom(runStart);
 	}
 	literal.complete();
 	if (!endFound)
@@ -837,8 +874,25 @@ Token Scanner::scanString(bool const _isUnicode)
 	char const quote = m_char;
 	advance();  // consume quote
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
+	// Characters that need neither escaping nor validation.
+	auto const isPlain = [&](char _c) {
+		if (_c == quote || _c == '\\')
+			return false;
+		else if (_isUnicode)
+			return cannotStartUnicodeLinebreak(_c);
+		else
+			return 0x1f < static_cast<unsigned>(_c) && static_cast<unsigned>(_c) < 0x7f;
+	};
 	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
 	{
+		size_t const runStart = sourcePos();
+		m_char = m_source->advanceWhile(isPlain);
+		if (sourcePos() != runStart)
+		{
+			addLiteralCharsFrom(runStart);
+			continue;
+		}
+
 		char c = m_char;
 		advance();
 		if (c == '\\')
@@ -1021,10 +1075,11 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
+	size_t const startPosition = sourcePos();
+	bool const allowDots = m_kind == ScannerKind::Yul;
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	m_char = m_source->advanceWhile([&](char _c) { return isIdentifierPart(_c) || (_c == '.' && allowDots); });
+	addLiteralCharsFrom(startPosition);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
@@ -208,6 +208,9 @@ private:
 	inline void addLiteralChar(char c) { m_tokens[NextNext].literal.push_back(c); }
 	inline void addCommentLiteralChar(char c) { m_skippedComments[NextNext].literal.push_back(c); }
 	inline void addLiteralCharAndAdvance() { addLiteralChar(m_char); advance(); }
+	/// Appends the source text from @a _start up to the current position to the literal.
+	inline void addLiteralCharsFrom(size_t _start) { m_tokens[NextNext].literal.append(source(), _start, sourcePos() - _start); }
+	inline void addCommentLiteralCharsFrom(size_t _start) { m_skippedComments[NextNext].literal.append(source(), _start, sourcePos() - _start); }
 	void addUnicodeAsUTF8(unsigned codepoint);
 	///@}
 
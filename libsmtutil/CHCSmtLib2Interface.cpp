@@ -18,6 +18,8 @@
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -53,6 +55,8 @@ void CHCSmtLib2Interface::reset()
 	m_accumulatedOutput.clear();
 	m_variables.clear();
 	m_unhandledQueries.clear();
+	m_script.clear();
+	m_scriptedOutputSize = 0;
 	if (m_queryTimeout)
 		write("(set-option :timeout " + to_string(*m_queryTimeout) + ")");
 }
@@ -79,13 +83,10 @@ void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 
 void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& _name)
 {
-	write(
-		"(rule (! " +
-		m_smtlib2->toSExpr(_expr) +
-		" :named " +
-		_name +
-		"))"
-	);
+	string rule = "(rule (! ";
+	m_smtlib2->toSExpr(_expr, rule);
+	rule += " :named " + _name + "))";
+	write(move(rule));
 }
 
 pair<CheckResult, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expression const& _block)
@@ -94,12 +95,19 @@ pair<CheckResult, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expre
 	swap(m_accumulatedOutput, accumulated);
 	for (auto const& var: m_smtlib2->variables())
 		declareVariable(var.first, var.second);
+	// Declarations added now precede everything else in the query,
+	// but only need to precede the rules not yet in the script.
+	string declarations = m_accumulatedOutput;
 	m_accumulatedOutput += accumulated;
 
-	string response = querySolver(
-		m_accumulatedOutput +
-		"\n(query " + _block.name + " :print-certificate true)"
-	);
+	string command = "\n(query " + _block.name + " :print-certificate true)";
+	string query = m_accumulatedOutput + command;
+	size_t const unhandledQueries = m_unhandledQueries.size();
+	string response = querySolver(query);
+	m_script += declarations + accumulated.substr(m_scriptedOutputSize);
+	m_scriptedOutputSize = m_accumulatedOutput.size();
+	if (m_unhandledQueries.size() > unhandledQueries)
+		m_script += "(echo \"0x" + util::keccak256(query).hex() + "\")" + command + "\n";
 
 	CheckResult result;
 	// TODO proper parsing
@@ -152,6 +160,13 @@ void CHCSmtLib2Interface::declareFunction(string const& _name, SortPointer const
 	}
 }
 
+string CHCSmtLib2Interface::unhandledQueriesScript() const
+{
+	if (m_unhandledQueries.empty())
+		return {};
+	return m_script;
+}
+
 void CHCSmtLib2Interface::write(string _data)
 {
 	m_accumulatedOutput += move(_data) + "\n";
@@ -162,11 +177,27 @@ string CHCSmtLib2Interface::querySolver(string const& _input)
 	util::h256 inputHash = util::keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	util::h256 cacheKey;
+	if (m_queryCache)
+	{
+		cacheKey = QueryCache::key("smtlib2", m_queryTimeout, _input);
+		Json::Value entry = m_queryCache->load(cacheKey);
+		if (entry["response"].isString())
+			return entry["response"].asString();
+	}
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
+		{
+			if (m_queryCache && QueryCache::cacheable(result.responseOrErrorMessage, m_queryTimeout))
+			{
+				Json::Value entry(Json::objectValue);
+				entry["response"] = result.responseOrErrorMessage;
+				m_queryCache->store(cacheKey, entry);
+			}
 			return result.responseOrErrorMessage;
+		}
 	}
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
@@ -49,6 +49,9 @@ public:
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
 
 	std::vector<std::string> unhandledQueries() const { return m_unhandledQueries; }
+	/// @returns a single script that poses all unhandled queries one after the other, sharing
+	/// their relations and rules, like SolverInterface::unhandledQueriesScript.
+	std::string unhandledQueriesScript() const;
 
 	SMTLib2Interface* smtlib2Interface() const { return m_smtlib2.get(); }
 
@@ -66,6 +69,12 @@ private:
 	std::string m_accumulatedOutput;
 	std::set<std::string> m_variables;
 
+	/// The accumulated output as of the last query, in the order it was written,
+	/// with the commands of every unhandled query at the point it was asked.
+	std::string m_script;
+	/// Size of the prefix of the accumulated output already contained in the script.
+	size_t m_scriptedOutputSize = 0;
+
 	std::map<util::h256, std::string> const& m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
 
@@ -59,8 +59,13 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// Sets the cache consulted by query() before querying the solver
+	/// and updated with its results. No cache is used if @a _cache is null.
+	virtual void setQueryCache(std::shared_ptr<QueryCache const> _cache) { m_queryCache = std::move(_cache); }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
+	std::shared_ptr<QueryCache const> m_queryCache;
 };
 
 }
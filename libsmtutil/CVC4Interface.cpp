@@ -18,8 +18,13 @@
 
 #include <libsmtutil/CVC4Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonIO.h>
 
+#include <boost/algorithm/string/join.hpp>
+
+#include <cvc4/base/configuration.h>
 #include <cvc4/util/bitvector.h>
 
 using namespace std;
@@ -37,6 +42,9 @@ CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 void CVC4Interface::reset()
 {
 	m_variables.clear();
+	m_declarations.clear();
+	m_assertions = {{}};
+	m_translations.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
 	if (m_queryTimeout)
@@ -48,24 +56,33 @@ void CVC4Interface::reset()
 void CVC4Interface::push()
 {
 	m_solver.push();
+	m_assertions.emplace_back();
 }
 
 void CVC4Interface::pop()
 {
 	m_solver.pop();
+	smtAssert(m_assertions.size() > 1, "");
+	m_assertions.pop_back();
 }
 
 void CVC4Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	// Variables are created anew, so translations referring to the old one are outdated.
+	if (m_variables.count(_name))
+		m_translations.clear();
 	m_variables[_name] = m_context.mkVar(_name.c_str(), cvc4Sort(*_sort));
+	m_declarations.push_back(_name + ": " + m_variables[_name].getType().toString());
 }
 
 void CVC4Interface::addAssertion(Expression const& _expr)
 {
 	try
 	{
-		m_solver.assertFormula(toCVC4Expr(_expr));
+		CVC4::Expr expr = toCVC4Expr(_expr);
+		m_solver.assertFormula(expr);
+		m_assertions.back().push_back(expr.toString());
 	}
 	catch (CVC4::TypeCheckingException const& _e)
 	{
@@ -87,6 +104,24 @@ void CVC4Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	m_interrupted = false;
+	h256 cacheKey;
+	if (m_queryCache)
+	{
+		string query = boost::algorithm::join(m_declarations, "\n");
+		for (auto const& assertions: m_assertions)
+			query += "\n(push)\n" + boost::algorithm::join(assertions, "\n");
+		for (Expression const& e: _expressionsToEvaluate)
+			query += "\n" + toCVC4Expr(e).toString();
+		cacheKey = QueryCache::key(
+			"cvc4-" + CVC4::Configuration::getVersionString(),
+			m_queryTimeout,
+			query
+		);
+		if (auto cached = m_queryCache->loadCheckResult(cacheKey))
+			return *cached;
+	}
+
 	CheckResult result;
 	vector<string> values;
 	try
@@ -118,10 +153,30 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 		values.clear();
 	}
 
+	if (m_queryCache && !m_interrupted)
+		m_queryCache->storeCheckResult(cacheKey, {result, values}, m_queryTimeout);
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	m_interrupted = true;
+	m_solver.interrupt();
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
+{
+	auto const& node = _expr.arguments.shared();
+	if (!node)
+		return translate(_expr);
+	if (auto translation = m_translations.find(node); translation != m_translations.end())
+		return translation->second;
+	CVC4::Expr result = translate(_expr);
+	m_translations.emplace(node, result);
+	return result;
+}
+
+CVC4::Expr CVC4Interface::translate(Expression const& _expr)
 {
 	// Variable
 	if (_expr.arguments.empty() && m_variables.count(_expr.name))
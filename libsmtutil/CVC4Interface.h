@@ -21,6 +21,9 @@
 #include <libsmtutil/SolverInterface.h>
 #include <boost/noncopyable.hpp>
 
+#include <atomic>
+#include <unordered_map>
+
 #if defined(__GLIBC__)
 // The CVC4 headers includes the deprecated system headers <ext/hash_map>
 // and <ext/hash_set>. These headers cause a warning that will break the
@@ -51,15 +54,29 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 private:
+	/// Translates @a _expr, reusing the translations of subexpressions shared with
+	/// previously translated expressions.
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	CVC4::Expr translate(Expression const& _expr);
 	CVC4::Type cvc4Sort(Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<SortPointer> const& _sorts);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+	/// Translations of expressions with arguments, keyed by their shared argument list.
+	std::unordered_map<std::shared_ptr<std::vector<Expression> const>, CVC4::Expr> m_translations;
+
+	/// Textual representations of the declarations and of the assertions
+	/// per push level, used as the key of a query in the QueryCache.
+	std::vector<std::string> m_declarations;
+	std::vector<std::vector<std::string>> m_assertions;
+
+	/// Set by interrupt(), whose results must not be cached.
+	std::atomic<bool> m_interrupted{false};
 
 	// CVC4 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
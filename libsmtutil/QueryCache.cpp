@@ -0,0 +1,401 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/QueryCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+namespace fs = boost::filesystem;
+
+h256 QueryCache::key(string const& _solver, optional<unsigned> _timeout, string const& _query)
+{
+	return keccak256(
+		_solver + "\n" +
+		(_timeout ? to_string(*_timeout) : "") + "\n" +
+		_query
+	);
+}
+
+Json::Value QueryCache::load(h256 const& _key) const
+{
+	fs::path path = entryPath(_key);
+	boost::system::error_code errorCode;
+	if (!fs::is_regular_file(path, errorCode))
+		return Json::nullValue;
+
+	Json::Value entry;
+	try
+	{
+		if (!jsonParseStrict(readFileAsString(path.string()), entry) || !entry.isObject())
+			return Json::nullValue;
+	}
+	catch (Exception const&)
+	{
+		return Json::nullValue;
+	}
+	return entry;
+}
+
+void QueryCache::store(h256 const& _key, Json::Value const& _entry) const
+{
+	boost::system::error_code errorCode;
+	fs::create_directories(m_directory, errorCode);
+	if (errorCode)
+		return;
+
+	fs::path path = entryPath(_key);
+	fs::path temporaryPath = path;
+	temporaryPath += fs::unique_path(".%%%%-%%%%-%%%%.tmp", errorCode);
+	if (errorCode)
+		return;
+	{
+		ofstream outFile(temporaryPath.string(), ios::out | ios::binary | ios::trunc);
+		outFile << jsonCompactPrint(_entry);
+		if (!outFile)
+		{
+			outFile.close();
+			fs::remove(temporaryPath, errorCode);
+			return;
+		}
+	}
+	fs::rename(temporaryPath, path, errorCode);
+	if (errorCode)
+		fs::remove(temporaryPath, errorCode);
+}
+
+optional<pair<CheckResult, vector<string>>> QueryCache::loadCheckResult(h256 const& _key) const
+{
+	Json::Value entry = load(_key);
+	optional<CheckResult> result = resultFromJson(entry["result"]);
+	if (!result || !entry["values"].isArray())
+		return nullopt;
+	vector<string> values;
+	for (auto const& value: entry["values"])
+		if (value.isString())
+			values.emplace_back(value.asString());
+		else
+			return nullopt;
+	return make_pair(*result, move(values));
+}
+
+void QueryCache::storeCheckResult(
+	h256 const& _key,
+	pair<CheckResult, vector<string>> const& _result,
+	optional<unsigned> _timeout
+) const
+{
+	if (!cacheable(_result.first, _timeout))
+		return;
+	Json::Value entry(Json::objectValue);
+	entry["result"] = resultToString(_result.first);
+	entry["values"] = Json::arrayValue;
+	for (auto const& value: _result.second)
+		entry["values"].append(value);
+	store(_key, entry);
+}
+
+optional<pair<CheckResult, CHCSolverInterface::CexGraph>> QueryCache::loadQueryResult(h256 const& _key) const
+{
+	Json::Value entry = load(_key);
+	optional<CheckResult> result = resultFromJson(entry["result"]);
+	Json::Value const& nodes = entry["counterexample"]["nodes"];
+	Json::Value const& edges = entry["counterexample"]["edges"];
+	if (!result || !nodes.isObject() || !edges.isObject())
+		return nullopt;
+
+	CHCSolverInterface::CexGraph graph;
+	try
+	{
+		for (auto const& id: nodes.getMemberNames())
+		{
+			optional<Expression> node = expressionFromJson(nodes[id]);
+			if (!node)
+				return nullopt;
+			graph.nodes.emplace(static_cast<unsigned>(stoul(id)), move(*node));
+		}
+		for (auto const& id: edges.getMemberNames())
+		{
+			if (!edges[id].isArray())
+				return nullopt;
+			auto& successors = graph.edges[static_cast<unsigned>(stoul(id))];
+			for (auto const& successor: edges[id])
+				if (successor.isUInt())
+					successors.push_back(successor.asUInt());
+				else
+					return nullopt;
+		}
+	}
+	catch (exception const&)
+	{
+		// Malformed node ids.
+		return nullopt;
+	}
+	return make_pair(*result, move(graph));
+}
+
+void QueryCache::storeQueryResult(
+	h256 const& _key,
+	pair<CheckResult, CHCSolverInterface::CexGraph> const& _result,
+	optional<unsigned> _timeout
+) const
+{
+	if (!cacheable(_result.first, _timeout))
+		return;
+	Json::Value entry(Json::objectValue);
+	entry["result"] = resultToString(_result.first);
+	Json::Value& counterexample = entry["counterexample"];
+	counterexample["nodes"] = Json::objectValue;
+	for (auto const& [id, node]: _result.second.nodes)
+		counterexample["nodes"][to_string(id)] = expressionToJson(node);
+	counterexample["edges"] = Json::objectValue;
+	for (auto const& [id, successors]: _result.second.edges)
+	{
+		Json::Value& jsonSuccessors = counterexample["edges"][to_string(id)] = Json::arrayValue;
+		for (unsigned successor: successors)
+			jsonSuccessors.append(successor);
+	}
+	store(_key, entry);
+}
+
+optional<string> QueryCache::loadInvariant(h256 const& _key) const
+{
+	Json::Value entry = load(_key);
+	if (!entry["invariant"].isString())
+		return nullopt;
+	return entry["invariant"].asString();
+}
+
+void QueryCache::storeInvariant(h256 const& _key, string const& _script) const
+{
+	Json::Value entry(Json::objectValue);
+	entry["invariant"] = _script;
+	store(_key, entry);
+}
+
+bool QueryCache::cacheable(CheckResult _result, optional<unsigned> _timeout)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
+	case CheckResult::UNSATISFIABLE:
+		return true;
+	case CheckResult::UNKNOWN:
+		return !_timeout;
+	default:
+		return false;
+	}
+}
+
+bool QueryCache::cacheable(string const& _response, optional<unsigned> _timeout)
+{
+	if (boost::starts_with(_response, "sat\n") || boost::starts_with(_response, "unsat\n"))
+		return true;
+	return boost::starts_with(_response, "unknown\n") && !_timeout;
+}
+
+string QueryCache::resultToString(CheckResult _result)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
+		return "sat";
+	case CheckResult::UNSATISFIABLE:
+		return "unsat";
+	case CheckResult::UNKNOWN:
+		return "unknown";
+	case CheckResult::CONFLICTING:
+		return "conflicting";
+	case CheckResult::ERROR:
+		return "error";
+	}
+	smtAssert(false, "");
+}
+
+optional<CheckResult> QueryCache::resultFromJson(Json::Value const& _json)
+{
+	static map<string, CheckResult> const results{
+		{"sat", CheckResult::SATISFIABLE},
+		{"unsat", CheckResult::UNSATISFIABLE},
+		{"unknown", CheckResult::UNKNOWN}
+	};
+	if (_json.isString() && results.count(_json.asString()))
+		return results.at(_json.asString());
+	return nullopt;
+}
+
+Json::Value QueryCache::expressionToJson(Expression const& _expression)
+{
+	Json::Value result(Json::objectValue);
+	result["name"] = _expression.name;
+	result["sort"] = sortToJson(*_expression.sort);
+	result["arguments"] = Json::arrayValue;
+	for (auto const& argument: _expression.arguments)
+		result["arguments"].append(expressionToJson(argument));
+	return result;
+}
+
+optional<Expression> QueryCache::expressionFromJson(Json::Value const& _json)
+{
+	if (!_json.isObject() || !_json["name"].isString() || !_json["arguments"].isArray())
+		return nullopt;
+	SortPointer sort = sortFromJson(_json["sort"]);
+	if (!sort)
+		return nullopt;
+	vector<Expression> arguments;
+	for (auto const& argument: _json["arguments"])
+	{
+		optional<Expression> expression = expressionFromJson(argument);
+		if (!expression)
+			return nullopt;
+		arguments.emplace_back(move(*expression));
+	}
+	return Expression(_json["name"].asString(), move(arguments), move(sort));
+}
+
+Json::Value QueryCache::sortToJson(Sort const& _sort)
+{
+	Json::Value result(Json::objectValue);
+	auto sortsToJson = [](vector<SortPointer> const& _sorts) {
+		Json::Value sorts(Json::arrayValue);
+		for (auto const& sort: _sorts)
+			sorts.append(sortToJson(*sort));
+		return sorts;
+	};
+	switch (_sort.kind)
+	{
+	case Kind::Int:
+		result["kind"] = "int";
+		result["signed"] = dynamic_cast<IntSort const&>(_sort).isSigned;
+		break;
+	case Kind::Bool:
+		result["kind"] = "bool";
+		break;
+	case Kind::BitVector:
+		result["kind"] = "bv";
+		result["size"] = dynamic_cast<BitVectorSort const&>(_sort).size;
+		break;
+	case Kind::Function:
+	{
+		auto const& functionSort = dynamic_cast<FunctionSort const&>(_sort);
+		result["kind"] = "function";
+		result["domain"] = sortsToJson(functionSort.domain);
+		result["codomain"] = sortToJson(*functionSort.codomain);
+		break;
+	}
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+		result["kind"] = "array";
+		result["domain"] = sortToJson(*arraySort.domain);
+		result["range"] = sortToJson(*arraySort.range);
+		break;
+	}
+	case Kind::Sort:
+		result["kind"] = "sort";
+		result["inner"] = sortToJson(*dynamic_cast<SortSort const&>(_sort).inner);
+		break;
+	case Kind::Tuple:
+	{
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		result["kind"] = "tuple";
+		result["name"] = tupleSort.name;
+		result["members"] = Json::arrayValue;
+		for (auto const& member: tupleSort.members)
+			result["members"].append(member);
+		result["components"] = sortsToJson(tupleSort.components);
+		break;
+	}
+	}
+	return result;
+}
+
+SortPointer QueryCache::sortFromJson(Json::Value const& _json)
+{
+	if (!_json.isObject() || !_json["kind"].isString())
+		return nullptr;
+
+	auto sortsFromJson = [](Json::Value const& _sorts) -> optional<vector<SortPointer>> {
+		if (!_sorts.isArray())
+			return nullopt;
+		vector<SortPointer> sorts;
+		for (auto const& sort: _sorts)
+			if (SortPointer component = sortFromJson(sort))
+				sorts.emplace_back(move(component));
+			else
+				return nullopt;
+		return sorts;
+	};
+
+	string kind = _json["kind"].asString();
+	if (kind == "int" && _json["signed"].isBool())
+		return SortProvider::intSort(_json["signed"].asBool());
+	else if (kind == "bool")
+		return SortProvider::boolSort;
+	else if (kind == "bv" && _json["size"].isUInt())
+		return make_shared<BitVectorSort>(_json["size"].asUInt());
+	else if (kind == "function")
+	{
+		auto domain = sortsFromJson(_json["domain"]);
+		SortPointer codomain = sortFromJson(_json["codomain"]);
+		if (domain && codomain)
+			return make_shared<FunctionSort>(move(*domain), move(codomain));
+	}
+	else if (kind == "array")
+	{
+		SortPointer domain = sortFromJson(_json["domain"]);
+		SortPointer range = sortFromJson(_json["range"]);
+		if (domain && range)
+			return make_shared<ArraySort>(move(domain), move(range));
+	}
+	else if (kind == "sort")
+	{
+		if (SortPointer inner = sortFromJson(_json["inner"]))
+			return make_shared<SortSort>(move(inner));
+	}
+	else if (kind == "tuple" && _json["name"].isString() && _json["members"].isArray())
+	{
+		vector<string> members;
+		for (auto const& member: _json["members"])
+			if (member.isString())
+				members.emplace_back(member.asString());
+			else
+				return nullptr;
+		auto components = sortsFromJson(_json["components"]);
+		if (components && components->size() == members.size())
+			return make_shared<TupleSort>(_json["name"].asString(), move(members), move(*components));
+	}
+	return nullptr;
+}
+
+fs::path QueryCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
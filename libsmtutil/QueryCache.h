@@ -0,0 +1,112 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * On-disk cache for the results of solver queries.
+ */
+
+#pragma once
+
+#include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+#include <json/json.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Directory containing one JSON file per solved query, named after the hash of the
+ * query, the solver and the timeout, and one per predicate whose invariant was stored.
+ * Entries are never invalidated, only replaced.
+ *
+ * Like frontend::CompilationCache, the cache is only an optimisation: entries that cannot
+ * be read are treated as missing and failures to write an entry are ignored. Entries are
+ * written to a temporary file first and then renamed, so that concurrent compiler processes
+ * and solver threads can share a directory.
+ */
+class QueryCache
+{
+public:
+	explicit QueryCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the key of the query given by the textual representation @a _query
+	/// when sent to @a _solver with the timeout @a _timeout.
+	static util::h256 key(std::string const& _solver, std::optional<unsigned> _timeout, std::string const& _query);
+
+	/// @returns the entry stored under @a _key or null if there is no valid entry.
+	Json::Value load(util::h256 const& _key) const;
+	/// Stores @a _entry under @a _key.
+	void store(util::h256 const& _key, Json::Value const& _entry) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+	/// @returns the result of SolverInterface::check() stored under @a _key, if any.
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> loadCheckResult(util::h256 const& _key) const;
+	/// Stores @a _result under @a _key if it is worth storing for a query with timeout @a _timeout.
+	void storeCheckResult(
+		util::h256 const& _key,
+		std::pair<CheckResult, std::vector<std::string>> const& _result,
+		std::optional<unsigned> _timeout
+	) const;
+
+	/// @returns the result of CHCSolverInterface::query() stored under @a _key, if any.
+	std::optional<std::pair<CheckResult, CHCSolverInterface::CexGraph>> loadQueryResult(util::h256 const& _key) const;
+	/// Stores @a _result under @a _key if it is worth storing for a query with timeout @a _timeout.
+	void storeQueryResult(
+		util::h256 const& _key,
+		std::pair<CheckResult, CHCSolverInterface::CexGraph> const& _result,
+		std::optional<unsigned> _timeout
+	) const;
+
+	/// @returns the invariant stored under @a _key as an SMT-LIB2 script, if any.
+	std::optional<std::string> loadInvariant(util::h256 const& _key) const;
+	/// Stores the invariant given by the SMT-LIB2 script @a _script under @a _key.
+	void storeInvariant(util::h256 const& _key, std::string const& _script) const;
+
+	/// @returns true if @a _result is worth storing. Errors are never stored and
+	/// unknown results only if they were caused by the deterministic resource
+	/// limit rather than a timeout.
+	static bool cacheable(CheckResult _result, std::optional<unsigned> _timeout);
+	/// Same as above for the raw @a _response of an SMT-LIB2 solver.
+	static bool cacheable(std::string const& _response, std::optional<unsigned> _timeout);
+
+private:
+	static std::string resultToString(CheckResult _result);
+	/// @returns the result represented by @a _json or nullopt if it is malformed.
+	static std::optional<CheckResult> resultFromJson(Json::Value const& _json);
+
+	static Json::Value expressionToJson(Expression const& _expression);
+	/// @returns the expression represented by @a _json or nullopt if it is malformed.
+	static std::optional<Expression> expressionFromJson(Json::Value const& _json);
+	static Json::Value sortToJson(Sort const& _sort);
+	static SortPointer sortFromJson(Json::Value const& _json);
+
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
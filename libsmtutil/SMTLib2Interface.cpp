@@ -18,6 +18,8 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -51,6 +53,8 @@ SMTLib2Interface::SMTLib2Interface(
 
 void SMTLib2Interface::reset()
 {
+	if (!m_script.empty())
+		m_script += "(reset)\n";
 	m_accumulatedOutput.clear();
 	m_accumulatedOutput.emplace_back();
 	m_variables.clear();
@@ -64,12 +68,14 @@ void SMTLib2Interface::reset()
 void SMTLib2Interface::push()
 {
 	m_accumulatedOutput.emplace_back();
+	m_script += "(push 1)\n";
 }
 
 void SMTLib2Interface::pop()
 {
 	smtAssert(!m_accumulatedOutput.empty(), "");
 	m_accumulatedOutput.pop_back();
+	m_script += "(pop 1)\n";
 }
 
 void SMTLib2Interface::declareVariable(string const& _name, SortPointer const& _sort)
@@ -109,15 +115,27 @@ void SMTLib2Interface::declareFunction(string const& _name, SortPointer const& _
 
 void SMTLib2Interface::addAssertion(Expression const& _expr)
 {
-	write("(assert " + toSExpr(_expr) + ")");
+	string assertion = "(assert ";
+	toSExpr(_expr, assertion);
+	assertion += ')';
+	write(move(assertion));
 }
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string command = checkSatAndGetValuesCommand(_expressionsToEvaluate);
+	string query = boost::algorithm::join(m_accumulatedOutput, "\n") + command;
+	size_t const unhandledQueries = m_unhandledQueries.size();
+	string response = querySolver(query);
+	if (m_unhandledQueries.size() > unhandledQueries)
+	{
+		m_script +=
+			"(push 1)\n"
+			"(echo \"0x" + keccak256(query).hex() + "\")\n" +
+			command +
+			"(pop 1)\n";
+		m_scriptSize = m_script.size();
+	}
 
 	CheckResult result;
 	// TODO proper parsing
@@ -137,18 +155,28 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 }
 
 string SMTLib2Interface::toSExpr(Expression const& _expr)
+{
+	string sexpr;
+	toSExpr(_expr, sexpr);
+	return sexpr;
+}
+
+void SMTLib2Interface::toSExpr(Expression const& _expr, string& _output)
 {
 	if (_expr.arguments.empty())
-		return _expr.name;
+	{
+		_output += _expr.name;
+		return;
+	}
 
-	std::string sexpr = "(";
+	_output += '(';
 	if (_expr.name == "int2bv")
 	{
 		size_t size = std::stoul(_expr.arguments[1].name);
 		auto arg = toSExpr(_expr.arguments.front());
 		auto int2bv = "(_ int2bv " + to_string(size) + ")";
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
-		sexpr += string("ite ") +
+		_output += string("ite ") +
 			"(>= " + arg + " 0) " +
 			"(" + int2bv + " " + arg + ") " +
 			"(bvneg (" + int2bv + " (- " + arg + ")))";
@@ -159,21 +187,22 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		smtAssert(intSort, "");
 
 		auto arg = toSExpr(_expr.arguments.front());
-		auto nat = "(bv2nat " + arg + ")";
 
 		if (!intSort->isSigned)
-			return nat;
-
-		auto bvSort = dynamic_pointer_cast<BitVectorSort>(_expr.arguments.front().sort);
-		smtAssert(bvSort, "");
-		auto size = to_string(bvSort->size);
-		auto pos = to_string(bvSort->size - 1);
-
-		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
-		sexpr += string("ite ") +
-			"(= ((_ extract " + pos + " " + pos + ")" + arg + ") #b0) " +
-			nat + " " +
-			"(- (bvneg " + arg + "))";
+			_output += "bv2nat " + arg;
+		else
+		{
+			auto bvSort = dynamic_pointer_cast<BitVectorSort>(_expr.arguments.front().sort);
+			smtAssert(bvSort, "");
+			auto size = to_string(bvSort->size);
+			auto pos = to_string(bvSort->size - 1);
+
+			// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
+			_output += string("ite ") +
+				"(= ((_ extract " + pos + " " + pos + ")" + arg + ") #b0) " +
+				"(bv2nat " + arg + ") " +
+				"(- (bvneg " + arg + "))";
+		}
 	}
 	else if (_expr.name == "const_array")
 	{
@@ -182,8 +211,8 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		smtAssert(sortSort, "");
 		auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		smtAssert(arraySort, "");
-		sexpr += "(as const " + toSmtLibSort(*arraySort) + ") ";
-		sexpr += toSExpr(_expr.arguments.at(1));
+		_output += "(as const " + toSmtLibSort(*arraySort) + ") ";
+		toSExpr(_expr.arguments.at(1), _output);
 	}
 	else if (_expr.name == "tuple_get")
 	{
@@ -191,24 +220,30 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.arguments.at(0).sort);
 		size_t index = std::stoul(_expr.arguments.at(1).name);
 		smtAssert(index < tupleSort->members.size(), "");
-		sexpr += "|" + tupleSort->members.at(index) + "| " + toSExpr(_expr.arguments.at(0));
+		_output += "|" + tupleSort->members.at(index) + "| ";
+		toSExpr(_expr.arguments.at(0), _output);
 	}
 	else if (_expr.name == "tuple_constructor")
 	{
 		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.sort);
 		smtAssert(tupleSort, "");
-		sexpr += "|" + tupleSort->name + "|";
+		_output += "|" + tupleSort->name + "|";
 		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		{
+			_output += ' ';
+			toSExpr(arg, _output);
+		}
 	}
 	else
 	{
-		sexpr += _expr.name;
+		_output += _expr.name;
 		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		{
+			_output += ' ';
+			toSExpr(arg, _output);
+		}
 	}
-	sexpr += ")";
-	return sexpr;
+	_output += ')';
 }
 
 string SMTLib2Interface::toSmtLibSort(Sort const& _sort)
@@ -261,7 +296,14 @@ string SMTLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 void SMTLib2Interface::write(string _data)
 {
 	smtAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.back() += move(_data) + "\n";
+	_data += '\n';
+	m_accumulatedOutput.back() += _data;
+	m_script += _data;
+}
+
+string SMTLib2Interface::unhandledQueriesScript()
+{
+	return m_script.substr(0, m_scriptSize);
 }
 
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
@@ -277,7 +319,9 @@ string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _
 			auto const& e = _expressionsToEvaluate.at(i);
 			smtAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
 			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
-			command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
+			command += "(assert (= |EVALEXPR_" + to_string(i) + "| ";
+			toSExpr(e, command);
+			command += "))\n";
 		}
 		command += "(check-sat)\n";
 		command += "(get-value (";
@@ -310,11 +354,27 @@ string SMTLib2Interface::querySolver(string const& _input)
 	h256 inputHash = keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	h256 cacheKey;
+	if (m_queryCache)
+	{
+		cacheKey = QueryCache::key("smtlib2", m_queryTimeout, _input);
+		Json::Value entry = m_queryCache->load(cacheKey);
+		if (entry["response"].isString())
+			return entry["response"].asString();
+	}
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
+		{
+			if (m_queryCache && QueryCache::cacheable(result.responseOrErrorMessage, m_queryTimeout))
+			{
+				Json::Value entry(Json::objectValue);
+				entry["response"] = result.responseOrErrorMessage;
+				m_queryCache->store(cacheKey, entry);
+			}
 			return result.responseOrErrorMessage;
+		}
 	}
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
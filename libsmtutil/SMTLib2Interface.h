@@ -55,9 +55,13 @@ public:
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
+	std::string unhandledQueriesScript() override;
 
 	// Used by CHCSmtLib2Interface
 	std::string toSExpr(Expression const& _expr);
+	/// Appends the s-expression of @a _expr to @a _output.
+	/// Might declare tuple sorts, so @a _output must not be part of the accumulated output.
+	void toSExpr(Expression const& _expr, std::string& _output);
 	std::string toSmtLibSort(Sort const& _sort);
 	std::string toSmtLibSort(std::vector<SortPointer> const& _sort);
 
@@ -75,6 +79,12 @@ private:
 	std::string querySolver(std::string const& _input);
 
 	std::vector<std::string> m_accumulatedOutput;
+	/// All commands written so far including push, pop and reset, followed by the
+	/// commands of every unhandled query, which is scoped by push and pop and
+	/// preceded by an echo of its hash.
+	std::string m_script;
+	/// Size of the prefix of the script up to the last unhandled query.
+	size_t m_scriptSize = 0;
 	std::map<std::string, SortPointer> m_variables;
 	std::set<std::string> m_userSorts;
 
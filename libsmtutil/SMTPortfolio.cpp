@@ -26,6 +26,10 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <exception>
+#include <mutex>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -41,18 +45,26 @@ SMTPortfolio::SMTPortfolio(
 	SolverInterface(_queryTimeout)
 {
 	m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
+	m_solverNames.emplace_back("smtlib2");
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
+	{
 		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+		m_solverNames.emplace_back("z3");
+	}
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
+	{
 		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+		m_solverNames.emplace_back("cvc4");
+	}
 #endif
 }
 
 void SMTPortfolio::reset()
 {
+	m_declarations.clear();
 	for (auto const& s: m_solvers)
 		s->reset();
 }
@@ -72,6 +84,7 @@ void SMTPortfolio::pop()
 void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	m_declarations.emplace_back(_name, _sort);
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
 }
@@ -111,16 +124,28 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * If racing is enabled, the solvers run concurrently and the first one to answer interrupts
+ * the others, which then usually return UNKNOWN. The rules above are applied to the results
+ * in the order of m_solvers, so if more than one solver answered in time, the first of them
+ * provides the values.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	vector<optional<pair<CheckResult, vector<string>>>> racedResults;
+	if (m_racing && m_solvers.size() > 2)
+		racedResults = race(_expressionsToEvaluate);
+
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	for (size_t i = 0; i < m_solvers.size(); ++i)
 	{
 		CheckResult result;
 		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
+		if (i < racedResults.size() && racedResults[i])
+			tie(result, values) = move(*racedResults[i]);
+		else
+			tie(result, values) = m_solvers[i]->check(_expressionsToEvaluate);
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
@@ -140,6 +165,50 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 	return make_pair(lastResult, finalValues);
 }
 
+vector<optional<pair<CheckResult, vector<string>>>> SMTPortfolio::race(
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	// The SMT-LIB2 interface in position 0 might invoke a callback that is not
+	// thread-safe, so it is left to the caller.
+	vector<optional<pair<CheckResult, vector<string>>>> results(m_solvers.size());
+	vector<exception_ptr> failures(m_solvers.size());
+	mutex answerMutex;
+	bool answered = false;
+
+	vector<thread> threads;
+	for (size_t i = 1; i < m_solvers.size(); ++i)
+		threads.emplace_back([&, i]() {
+			try
+			{
+				results[i] = m_solvers[i]->check(_expressionsToEvaluate);
+			}
+			catch (...)
+			{
+				failures[i] = current_exception();
+				return;
+			}
+			if (solverAnswered(results[i]->first))
+			{
+				lock_guard<mutex> lock(answerMutex);
+				if (!answered)
+				{
+					answered = true;
+					for (size_t j = 1; j < m_solvers.size(); ++j)
+						if (j != i)
+							m_solvers[j]->interrupt();
+				}
+			}
+		});
+	for (thread& t: threads)
+		t.join();
+
+	for (exception_ptr const& failure: failures)
+		if (failure)
+			rethrow_exception(failure);
+	return results;
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
@@ -149,6 +218,19 @@ vector<string> SMTPortfolio::unhandledQueries()
 	return m_solvers.front()->unhandledQueries();
 }
 
+string SMTPortfolio::unhandledQueriesScript()
+{
+	smtAssert(!m_solvers.empty(), "");
+	return m_solvers.front()->unhandledQueriesScript();
+}
+
+void SMTPortfolio::setQueryCache(shared_ptr<QueryCache const> _cache)
+{
+	for (auto const& s: m_solvers)
+		s->setQueryCache(_cache);
+	SolverInterface::setQueryCache(move(_cache));
+}
+
 bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
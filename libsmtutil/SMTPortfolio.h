@@ -25,6 +25,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <map>
+#include <optional>
 #include <vector>
 
 namespace solidity::smtutil
@@ -58,13 +59,36 @@ public:
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
 	std::vector<std::string> unhandledQueries() override;
+	std::string unhandledQueriesScript() override;
 	size_t solvers() override { return m_solvers.size(); }
+
+	/// If @a _racing is true and at least two solvers besides the SMT-LIB2 interface are available,
+	/// check() runs them concurrently and interrupts the others as soon as one of them answers.
+	/// The answer is then no longer compared against the interrupted solvers.
+	void setRacing(bool _racing) { m_racing = _racing; }
+
+	/// Forwards the cache to all solvers, each of which caches its own results.
+	void setQueryCache(std::shared_ptr<QueryCache const> _cache) override;
+
+	/// @returns the names of the solvers, starting with the SMT-LIB2 interface.
+	std::vector<std::string> const& solverNames() const { return m_solverNames; }
+
+	/// @returns all variable declarations since the last reset in the order in which they were made.
+	std::vector<std::pair<std::string, SortPointer>> const& declarations() const { return m_declarations; }
 private:
 	static bool solverAnswered(CheckResult result);
+	/// Runs check() on all solvers but the SMT-LIB2 interface concurrently.
+	/// @returns the results indexed like m_solvers, without a result for the SMT-LIB2 interface.
+	std::vector<std::optional<std::pair<CheckResult, std::vector<std::string>>>> race(
+		std::vector<Expression> const& _expressionsToEvaluate
+	);
 
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	std::vector<std::string> m_solverNames;
 
 	std::vector<Expression> m_assertions;
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
+	bool m_racing = false;
 };
 
 }
@@ -55,10 +55,51 @@ enum class CheckResult
 };
 
 /// C++ representation of an SMTLIB2 expression.
+/// The arguments are shared between copies of an expression, which makes copies cheap
+/// and turns expressions built from other expressions into a DAG. Expressions are
+/// therefore immutable, only assigning a whole expression is allowed.
 class Expression
 {
 	friend class SolverInterface;
 public:
+	/// Immutable list of the arguments of an expression, shared by all its copies.
+	class Arguments
+	{
+	public:
+		using value_type = Expression;
+		using const_iterator = std::vector<Expression>::const_iterator;
+		using iterator = const_iterator;
+
+		Arguments() = default;
+		Arguments(std::vector<Expression> _arguments):
+			m_arguments(_arguments.empty() ? nullptr : std::make_shared<std::vector<Expression> const>(std::move(_arguments)))
+		{}
+
+		operator std::vector<Expression> const&() const { return vector(); }
+
+		bool empty() const { return !m_arguments; }
+		size_t size() const { return vector().size(); }
+		Expression const& at(size_t _index) const { return vector().at(_index); }
+		Expression const& operator[](size_t _index) const { return vector()[_index]; }
+		Expression const& front() const { return vector().front(); }
+		Expression const& back() const { return vector().back(); }
+		const_iterator begin() const { return vector().begin(); }
+		const_iterator end() const { return vector().end(); }
+
+		/// @returns the shared list, which identifies the expression and all its copies,
+		/// or null if there are no arguments.
+		std::shared_ptr<std::vector<Expression> const> const& shared() const { return m_arguments; }
+
+	private:
+		std::vector<Expression> const& vector() const
+		{
+			static std::vector<Expression> const noArguments;
+			return m_arguments ? *m_arguments : noArguments;
+		}
+
+		std::shared_ptr<std::vector<Expression> const> m_arguments;
+	};
+
 	explicit Expression(bool _v): Expression(_v ? "true" : "false", Kind::Bool) {}
 	explicit Expression(std::shared_ptr<SortSort> _sort, std::string _name = ""): Expression(std::move(_name), {}, _sort) {}
 	explicit Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort):
@@ -354,7 +395,7 @@ public:
 	}
 
 	std::string name;
-	std::vector<Expression> arguments;
+	Arguments arguments;
 	SortPointer sort;
 
 private:
@@ -372,6 +413,8 @@ private:
 
 DEV_SIMPLE_EXCEPTION(SolverError);
 
+class QueryCache;
+
 class SolverInterface
 {
 public:
@@ -399,14 +442,29 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a check() running on a different thread to stop as soon as possible,
+	/// in which case it returns UNKNOWN. Does nothing if no check is running
+	/// or the solver does not support interruption.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
+	/// @returns a single SMT-LIB2 script that poses all unhandled queries incrementally,
+	/// sharing the declarations and assertions they have in common. Every query is
+	/// preceded by an `echo` command printing its hash, i.e. the key of its response.
+	/// Empty if there are no unhandled queries.
+	virtual std::string unhandledQueriesScript() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual size_t solvers() { return 1; }
 
+	/// Sets the cache consulted by check() before querying the solver
+	/// and updated with its results. No cache is used if @a _cache is null.
+	virtual void setQueryCache(std::shared_ptr<QueryCache const> _cache) { m_queryCache = std::move(_cache); }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
+	std::shared_ptr<QueryCache const> m_queryCache;
 };
 
 }
@@ -18,6 +18,8 @@
 
 #include <libsmtutil/Z3CHCInterface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonIO.h>
 
 #include <set>
@@ -26,6 +28,19 @@
 using namespace std;
 using namespace solidity;
 using namespace solidity::smtutil;
+using namespace solidity::util;
+
+namespace
+{
+
+/// @returns the name of the constant that stands for the argument @a _index of a relation
+/// in a stored invariant.
+string invariantArgument(unsigned _index)
+{
+	return "arg_" + to_string(_index);
+}
+
+}
 
 Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
 	CHCSolverInterface(_queryTimeout),
@@ -59,12 +74,16 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
+	m_relations.push_back(_expr);
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
+	m_rules.emplace_back(_expr, _name);
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
+	if (!m_seeds.empty() && rule.is_implies())
+		rule = z3::implies(strengthen(rule.arg(0), m_seeds), rule.arg(1));
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
 	else
@@ -77,7 +96,50 @@ void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 	}
 }
 
+unique_ptr<Z3CHCInterface> Z3CHCInterface::clone() const
+{
+	auto copy = make_unique<Z3CHCInterface>(m_queryTimeout);
+	// Rules are universally quantified over all constants declared so far,
+	// so declaring everything first only adds unused bound variables.
+	for (auto const& [name, sort]: m_z3Interface->declarations())
+		copy->declareVariable(name, sort);
+	for (auto const& relation: m_relations)
+		copy->registerRelation(relation);
+	copy->setQueryCache(m_queryCache);
+	copy->setInvariantReuse(m_invariantReuse);
+	// The seeds of this interface are inductive for the same rules.
+	if (!m_seeds.empty())
+		for (auto const& [name, seed]: m_seeds)
+			copy->m_seeds.emplace(name, z3::expr(*copy->m_context, Z3_translate(*m_context, seed, *copy->m_context)));
+	else if (m_invariantReuse)
+		copy->loadInvariants(m_rules);
+	copy->m_invariants = copy->m_seeds;
+	for (auto const& [rule, name]: m_rules)
+		copy->addRule(rule, name);
+	return copy;
+}
+
 pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
+{
+	h256 cacheKey;
+	if (m_queryCache)
+	{
+		cacheKey = QueryCache::key(
+			Z3Interface::solverName() + (m_preProcessing ? "" : "-no-preprocessing"),
+			m_queryTimeout,
+			m_solver.to_string() + "\n" + m_z3Interface->toZ3Expr(_expr).to_string()
+		);
+		if (auto cached = m_queryCache->loadQueryResult(cacheKey))
+			return *cached;
+	}
+
+	pair<CheckResult, CexGraph> result = queryUncached(_expr);
+	if (m_queryCache)
+		m_queryCache->storeQueryResult(cacheKey, result, m_queryTimeout);
+	return result;
+}
+
+pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::queryUncached(Expression const& _expr)
 {
 	CheckResult result;
 	try
@@ -100,7 +162,8 @@ pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression
 		case z3::check_result::unsat:
 		{
 			result = CheckResult::UNSATISFIABLE;
-			// TODO retrieve invariants.
+			if (m_invariantReuse)
+				recordInvariants();
 			break;
 		}
 		case z3::check_result::unknown:
@@ -130,6 +193,7 @@ pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression
 
 void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 {
+	m_preProcessing = _preProcessing;
 	// Spacer options.
 	// These needs to be set in the solver.
 	// https://github.com/Z3Prover/z3/blob/master/src/muz/base/fp_params.pyg
@@ -148,9 +212,186 @@ void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 	p.set("fp.xform.inline_linear", _preProcessing);
 	p.set("fp.xform.inline_eager", _preProcessing);
 
+	// Setting the parameters replaces the ones given before.
+	if (m_queryTimeout)
+		p.set("timeout", *m_queryTimeout);
+
 	m_solver.set(p);
 }
 
+void Z3CHCInterface::setQueryTimeout(unsigned _timeout)
+{
+	m_queryTimeout = _timeout;
+	setSpacerOptions(m_preProcessing);
+}
+
+void Z3CHCInterface::storeInvariants() const
+{
+	if (!m_queryCache)
+		return;
+	auto functions = m_z3Interface->functions();
+	for (auto const& [name, invariant]: m_invariants)
+		try
+		{
+			z3::func_decl const& function = functions.at(name);
+			z3::expr_vector arguments(*m_context);
+			for (unsigned i = 0; i < function.arity(); ++i)
+				arguments.push_back(m_context->constant(invariantArgument(i).c_str(), function.domain(i)));
+			// The script declares the arguments and the datatypes used by the invariant.
+			z3::solver printer(*m_context);
+			printer.add(z3::expr(invariant).substitute(arguments));
+			m_queryCache->storeInvariant(invariantKey(function), printer.to_smt2());
+		}
+		catch (z3::exception const&)
+		{
+		}
+}
+
+void Z3CHCInterface::loadInvariants(vector<pair<Expression, string>> const& _rules)
+{
+	if (!m_queryCache)
+		return;
+
+	auto functions = m_z3Interface->functions();
+	map<string, z3::expr> candidates;
+	for (auto const& relation: m_relations)
+	{
+		z3::func_decl const& function = functions.at(relation.name);
+		optional<string> script = m_queryCache->loadInvariant(invariantKey(function));
+		if (!script)
+			continue;
+		try
+		{
+			z3::expr_vector arguments(*m_context);
+			z3::expr_vector variables(*m_context);
+			for (unsigned i = 0; i < function.arity(); ++i)
+			{
+				arguments.push_back(m_context->constant(invariantArgument(i).c_str(), function.domain(i)));
+				variables.push_back(z3::expr(*m_context, Z3_mk_bound(*m_context, i, function.domain(i))));
+			}
+			z3::expr invariant = z3::mk_and(m_context->parse_string(script->c_str()));
+			candidates.emplace(relation.name, invariant.substitute(arguments, variables));
+		}
+		catch (z3::exception const&)
+		{
+			// The datatypes used by the invariant changed.
+		}
+	}
+	if (candidates.empty())
+		return;
+
+	// The stored invariants were found for a possibly different encoding, so they are only
+	// used if they are inductive: every rule has to preserve the invariant of its head,
+	// assuming the invariants of the relations in its body. Candidates that are not preserved
+	// by a rule are dropped until the remaining ones are inductive. Every derivable fact then
+	// satisfies the invariant of its relation, so strengthening the rules does not change the
+	// answer to any query.
+	vector<z3::expr> rules;
+	for (auto const& rule: _rules)
+		rules.emplace_back(m_z3Interface->toZ3Expr(rule.first));
+	z3::solver solver(*m_context);
+	if (m_queryTimeout)
+	{
+		z3::params p(*m_context);
+		p.set("timeout", *m_queryTimeout);
+		solver.set(p);
+	}
+	for (bool changed = true; changed && !candidates.empty();)
+	{
+		changed = false;
+		for (z3::expr const& rule: rules)
+		{
+			z3::expr head = rule.is_implies() ? rule.arg(1) : rule;
+			optional<z3::expr> invariant = instance(head, candidates);
+			if (!invariant)
+				continue;
+			z3::expr body = rule.is_implies() ? strengthen(rule.arg(0), candidates) : m_context->bool_val(true);
+			bool preserved = false;
+			solver.push();
+			try
+			{
+				solver.add(body && !*invariant);
+				preserved = solver.check() == z3::unsat;
+			}
+			catch (z3::exception const&)
+			{
+			}
+			solver.pop();
+			if (!preserved)
+			{
+				candidates.erase(head.decl().name().str());
+				changed = true;
+			}
+		}
+	}
+	m_seeds = move(candidates);
+}
+
+void Z3CHCInterface::recordInvariants()
+{
+	auto functions = m_z3Interface->functions();
+	try
+	{
+		for (auto const& relation: m_relations)
+		{
+			z3::func_decl function = functions.at(relation.name);
+			z3::expr invariant = m_solver.get_cover_delta(-1, function);
+			if (invariant.is_true())
+				continue;
+			if (auto recorded = m_invariants.find(relation.name); recorded != m_invariants.end())
+				recorded->second = recorded->second && invariant;
+			else
+				m_invariants.emplace(relation.name, invariant);
+		}
+	}
+	catch (z3::exception const&)
+	{
+	}
+}
+
+z3::expr Z3CHCInterface::strengthen(z3::expr const& _expr, map<string, z3::expr> const& _invariants) const
+{
+	z3::expr_vector applications(*m_context);
+	z3::expr_vector strengthened(*m_context);
+	set<unsigned> visited;
+	stack<z3::expr> toVisit;
+	toVisit.push(_expr);
+	while (!toVisit.empty())
+	{
+		z3::expr expr = toVisit.top();
+		toVisit.pop();
+		if (!expr.is_app() || !visited.insert(expr.id()).second)
+			continue;
+		if (optional<z3::expr> invariant = instance(expr, _invariants))
+		{
+			applications.push_back(expr);
+			strengthened.push_back(expr && *invariant);
+		}
+		else
+			for (unsigned i = 0; i < expr.num_args(); ++i)
+				toVisit.push(expr.arg(i));
+	}
+	return z3::expr(_expr).substitute(applications, strengthened);
+}
+
+optional<z3::expr> Z3CHCInterface::instance(z3::expr const& _application, map<string, z3::expr> const& _invariants)
+{
+	if (!_application.is_app() || _application.decl().decl_kind() != Z3_OP_UNINTERPRETED)
+		return nullopt;
+	auto invariant = _invariants.find(_application.decl().name().str());
+	if (invariant == _invariants.end())
+		return nullopt;
+	z3::expr_vector arguments(_application.ctx());
+	for (unsigned i = 0; i < _application.num_args(); ++i)
+		arguments.push_back(_application.arg(i));
+	return z3::expr(invariant->second).substitute(arguments);
+}
+
+h256 Z3CHCInterface::invariantKey(z3::func_decl const& _relation)
+{
+	return QueryCache::key("z3-invariant", nullopt, _relation.to_string());
+}
+
 /**
 Convert a ground refutation into a linear or nonlinear counterexample.
 The counterexample is given as an implication graph of the form
@@ -25,6 +25,11 @@
 #include <libsmtutil/CHCSolverInterface.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -49,7 +54,46 @@ public:
 
 	void setSpacerOptions(bool _preProcessing = true);
 
+	/// Sets the timeout in milliseconds of the following queries.
+	/// Only has an effect if the interface was constructed with a timeout,
+	/// since the resource limit used otherwise is not bounded by it.
+	void setQueryTimeout(unsigned _timeout);
+
+	/// @returns a new interface with its own Z3 context that contains the same
+	/// declarations, relations, rules and query cache as this one and can be queried
+	/// independently, e.g. from a different thread.
+	/// If invariants are reused, the rules of the new interface are strengthened by the
+	/// invariants of this interface or, if it has none, by the stored invariants
+	/// that are still inductive.
+	/// Has to be called from the thread that owns this interface, since the
+	/// construction sets global Z3 parameters.
+	std::unique_ptr<Z3CHCInterface> clone() const;
+
+	/// Sets whether the invariants found by unsatisfiable queries are recorded
+	/// and the invariants in the query cache are used by clones.
+	void setInvariantReuse(bool _reuse) { m_invariantReuse = _reuse; }
+	/// Stores the recorded invariants in the query cache, one entry per relation.
+	void storeInvariants() const;
+
 private:
+	/// Runs the query without consulting the query cache.
+	std::pair<CheckResult, CexGraph> queryUncached(Expression const& _expr);
+
+	/// Loads the invariants stored for the relations, keeps the ones that are
+	/// inductive for @a _rules and uses them to strengthen the rules added afterwards.
+	void loadInvariants(std::vector<std::pair<Expression, std::string>> const& _rules);
+	/// Conjoins the invariants Spacer found for the relations in the last query
+	/// to the recorded ones.
+	void recordInvariants();
+	/// @returns @a _expr where every application of a relation that has an invariant
+	/// in @a _invariants is conjoined with the invariant.
+	z3::expr strengthen(z3::expr const& _expr, std::map<std::string, z3::expr> const& _invariants) const;
+	/// @returns the invariant in @a _invariants of the relation applied in @a _application
+	/// instantiated with its arguments, if any.
+	static std::optional<z3::expr> instance(z3::expr const& _application, std::map<std::string, z3::expr> const& _invariants);
+	/// @returns the cache key of the invariant of @a _relation.
+	static util::h256 invariantKey(z3::func_decl const& _relation);
+
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
 	/// @returns the fact from a proof node.
@@ -67,6 +111,20 @@ private:
 	z3::fixedpoint m_solver;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
+
+	/// Whether Spacer's preprocessing is enabled, which affects the results.
+	bool m_preProcessing = true;
+
+	/// Relations and rules given to the solver, kept to be replayed by clone().
+	std::vector<Expression> m_relations;
+	std::vector<std::pair<Expression, std::string>> m_rules;
+
+	bool m_invariantReuse = false;
+	/// Inductive invariants per relation name that strengthen the rules,
+	/// over the arguments of the relation as bound variables.
+	std::map<std::string, z3::expr> m_seeds;
+	/// Invariants per relation name known from the seeds and the answered queries.
+	std::map<std::string, z3::expr> m_invariants;
 };
 
 }
@@ -18,6 +18,8 @@
 
 #include <libsmtutil/Z3Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 
@@ -55,6 +57,8 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_declarations.clear();
+	m_translations.clear();
 	m_solver.reset();
 }
 
@@ -71,10 +75,16 @@ void Z3Interface::pop()
 void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	m_declarations.emplace_back(_name, _sort);
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
 	else if (m_constants.count(_name))
-		m_constants.at(_name) = m_context.constant(_name.c_str(), z3Sort(*_sort));
+	{
+		z3::expr constant = m_context.constant(_name.c_str(), z3Sort(*_sort));
+		if (!z3::eq(constant, m_constants.at(_name)))
+			m_translations.clear();
+		m_constants.at(_name) = constant;
+	}
 	else
 		m_constants.emplace(_name, m_context.constant(_name.c_str(), z3Sort(*_sort)));
 }
@@ -84,7 +94,12 @@ void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
 	smtAssert(_sort.kind == Kind::Function, "");
 	FunctionSort fSort = dynamic_cast<FunctionSort const&>(_sort);
 	if (m_functions.count(_name))
-		m_functions.at(_name) = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+	{
+		z3::func_decl function = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+		if (!z3::eq(function, m_functions.at(_name)))
+			m_translations.clear();
+		m_functions.at(_name) = function;
+	}
 	else
 		m_functions.emplace(_name, m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain)));
 }
@@ -96,6 +111,18 @@ void Z3Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	m_interrupted = false;
+	h256 cacheKey;
+	if (m_queryCache)
+	{
+		string query = m_solver.to_smt2();
+		for (Expression const& e: _expressionsToEvaluate)
+			query += "\n" + toZ3Expr(e).to_string();
+		cacheKey = QueryCache::key(solverName(), m_queryTimeout, query);
+		if (auto cached = m_queryCache->loadCheckResult(cacheKey))
+			return *cached;
+	}
+
 	CheckResult result;
 	vector<string> values;
 	try
@@ -136,10 +163,35 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 		values.clear();
 	}
 
+	if (m_queryCache && !m_interrupted)
+		m_queryCache->storeCheckResult(cacheKey, {result, values}, m_queryTimeout);
 	return make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	m_interrupted = true;
+	m_context.interrupt();
+}
+
+string Z3Interface::solverName()
+{
+	return string("z3-") + Z3_get_full_version();
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
+{
+	auto const& node = _expr.arguments.shared();
+	if (!node)
+		return translate(_expr);
+	if (auto translation = m_translations.find(node); translation != m_translations.end())
+		return translation->second;
+	z3::expr result = translate(_expr);
+	m_translations.emplace(node, result);
+	return result;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
 		return m_constants.at(_expr.name);
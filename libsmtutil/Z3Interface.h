@@ -22,6 +22,9 @@
 #include <boost/noncopyable.hpp>
 #include <z3++.h>
 
+#include <atomic>
+#include <unordered_map>
+
 namespace solidity::smtutil
 {
 
@@ -41,15 +44,23 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
+	/// Translates @a _expr, reusing the translations of subexpressions shared with
+	/// previously translated expressions.
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
 
 	std::map<std::string, z3::expr> constants() const { return m_constants; }
 	std::map<std::string, z3::func_decl> functions() const { return m_functions; }
+	/// @returns all variable declarations in the order in which they were made.
+	std::vector<std::pair<std::string, SortPointer>> const& declarations() const { return m_declarations; }
 
 	z3::context* context() { return &m_context; }
 
+	/// @returns the name and version of the solver, distinguishing its results in a QueryCache.
+	static std::string solverName();
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
@@ -57,6 +68,8 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	z3::expr translate(Expression const& _expr);
+
 	z3::sort z3Sort(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
 	smtutil::SortPointer fromZ3Sort(z3::sort const& _sort);
@@ -67,6 +80,13 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
+	/// Translations of expressions with arguments, keyed by their shared argument list.
+	/// Invalidated if a variable is redeclared with a different sort.
+	std::unordered_map<std::shared_ptr<std::vector<Expression> const>, z3::expr> m_translations;
+
+	/// Set by interrupt(), whose results must not be cached.
+	std::atomic<bool> m_interrupted{false};
 };
 
 }
@@ -22,6 +22,7 @@
  */
 
 #include <libsolc/libsolc.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libyul/YulString.h>
@@ -30,7 +31,11 @@
 
 #include <cstdlib>
 #include <list>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
 #include <string>
+#include <vector>
 
 #include "license.h"
 
@@ -38,6 +43,7 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::util;
 
+using solidity::frontend::CompilationCache;
 using solidity::frontend::ReadCallback;
 using solidity::frontend::StandardCompiler;
 
@@ -47,6 +53,16 @@ namespace
 // The strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static list<string> solidityAllocations;
+/// Protects solidityAllocations, which are accessed from the threads using the API.
+static mutex solidityAllocationsMutex;
+/// Held during each compilation and reset. The compiler keeps global state (e.g. the types
+/// and the Yul string repository), which is reset at the start of each compilation.
+static mutex compilationMutex;
+
+/// Maximum number of contracts kept in the compilation cache of an instance.
+size_t constexpr instanceCacheCapacity = 256;
+/// Number of bytes of output collected before they are passed to the output callback.
+size_t constexpr outputChunkSize = 64 * 1024;
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -55,6 +71,7 @@ static list<string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 string takeOverAllocation(char const* _data)
 {
+	lock_guard<mutex> lock(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -74,6 +91,30 @@ void truncateCString(string& _data)
 		_data.resize(pos);
 }
 
+/// Converts the contents or error returned by a C callback for a single request into a result.
+ReadCallback::Result takeOverCallbackResult(char* _contents, char* _error)
+{
+	ReadCallback::Result result;
+	result.success = true;
+	if (!_contents && !_error)
+	{
+		result.success = false;
+		result.responseOrErrorMessage = "Callback not supported.";
+	}
+	if (_contents)
+	{
+		result.success = true;
+		result.responseOrErrorMessage = takeOverAllocation(_contents);
+	}
+	if (_error)
+	{
+		result.success = false;
+		result.responseOrErrorMessage = takeOverAllocation(_error);
+	}
+	truncateCString(result.responseOrErrorMessage);
+	return result;
+}
+
 ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, void* _readContext)
 {
 	ReadCallback::Callback readCallback;
@@ -84,38 +125,137 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 			char* contents_c = nullptr;
 			char* error_c = nullptr;
 			_readCallback(_readContext, _kind.data(), _data.data(), &contents_c, &error_c);
-			ReadCallback::Result result;
-			result.success = true;
-			if (!contents_c && !error_c)
-			{
-				result.success = false;
-				result.responseOrErrorMessage = "Callback not supported.";
-			}
-			if (contents_c)
-			{
-				result.success = true;
-				result.responseOrErrorMessage = takeOverAllocation(contents_c);
-			}
-			if (error_c)
-			{
-				result.success = false;
-				result.responseOrErrorMessage = takeOverAllocation(error_c);
-			}
-			truncateCString(result.responseOrErrorMessage);
-			return result;
+			return takeOverCallbackResult(contents_c, error_c);
+		};
+	}
+	return readCallback;
+}
+
+ReadCallback::BatchCallback wrapReadFilesCallback(CStyleReadFilesCallback _readCallback, void* _readContext)
+{
+	ReadCallback::BatchCallback readCallback;
+	if (_readCallback)
+	{
+		readCallback = [=](string const& _kind, vector<string> const& _data)
+		{
+			vector<char const*> data_c;
+			for (string const& data: _data)
+				data_c.push_back(data.data());
+			vector<char*> contents_c(_data.size(), nullptr);
+			vector<char*> errors_c(_data.size(), nullptr);
+			_readCallback(_readContext, _kind.data(), _data.size(), data_c.data(), contents_c.data(), errors_c.data());
+			vector<ReadCallback::Result> results;
+			for (size_t i = 0; i < _data.size(); ++i)
+				results.push_back(takeOverCallbackResult(contents_c[i], errors_c[i]));
+			return results;
 		};
 	}
 	return readCallback;
 }
 
-string compile(string _input, CStyleReadFileCallback _readCallback, void* _readContext)
+char* storeAllocation(string _data)
+{
+	lock_guard<mutex> lock(solidityAllocationsMutex);
+	return solidityAllocations.emplace_back(move(_data)).data();
+}
+
+string compile(
+	string _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	shared_ptr<CompilationCache const> _cache = nullptr
+)
 {
 	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	compiler.setCompilationCache(move(_cache));
+	lock_guard<mutex> lock(compilationMutex);
+	return compiler.compile(move(_input));
+}
+
+/// Stream buffer that passes its contents to a CStyleOutputCallback in chunks.
+class CallbackStreamBuffer: public streambuf
+{
+public:
+	CallbackStreamBuffer(CStyleOutputCallback _callback, void* _context):
+		m_callback(_callback),
+		m_context(_context),
+		m_buffer(outputChunkSize)
+	{
+		setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+	}
+	~CallbackStreamBuffer() override { flush(); }
+
+protected:
+	int_type overflow(int_type _c) override
+	{
+		flush();
+		if (!traits_type::eq_int_type(_c, traits_type::eof()))
+			sputc(traits_type::to_char_type(_c));
+		return traits_type::not_eof(_c);
+	}
+	int sync() override
+	{
+		flush();
+		return 0;
+	}
+
+private:
+	void flush()
+	{
+		if (pptr() != pbase())
+			m_callback(m_context, pbase(), static_cast<size_t>(pptr() - pbase()));
+		setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+	}
+
+	CStyleOutputCallback m_callback;
+	void* m_context;
+	vector<char> m_buffer;
+};
+
+void compileSources(
+	string const& _input,
+	SoliditySource const* _sources,
+	size_t _sourceCount,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleOutputCallback _outputCallback,
+	void* _outputContext
+)
+{
+	StringMap sources;
+	for (size_t i = 0; i < _sourceCount; ++i)
+		sources.emplace(
+			string(_sources[i].name, _sources[i].nameLength),
+			string(_sources[i].content, _sources[i].contentLength)
+		);
+	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	CallbackStreamBuffer buffer(_outputCallback, _outputContext);
+	ostream output(&buffer);
+	lock_guard<mutex> lock(compilationMutex);
+	compiler.compile(_input, move(sources), output);
+	output.flush();
+}
+
+string compileBatched(string _input, CStyleReadFilesCallback _readCallback, void* _readContext)
+{
+	ReadCallback::BatchCallback readFiles = wrapReadFilesCallback(_readCallback, _readContext);
+	// Other requests, e.g. for URLs in the input or SMT queries, are passed one at a time.
+	ReadCallback::Callback readFile;
+	if (readFiles)
+		readFile = [=](string const& _kind, string const& _data) { return readFiles(_kind, {_data}).front(); };
+	StandardCompiler compiler(move(readFile));
+	compiler.setBatchReadCallback(move(readFiles));
+	lock_guard<mutex> lock(compilationMutex);
 	return compiler.compile(move(_input));
 }
 
 }
 
+struct SolidityInstance
+{
+	shared_ptr<CompilationCache const> compilationCache = make_shared<CompilationCache>(instanceCacheCapacity);
+};
+
 extern "C"
 {
 extern char const* solidity_license() noexcept
@@ -131,14 +271,32 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	return storeAllocation(compile(_input, _readCallback, _readContext));
+}
+
+extern char* solidity_compile_batched(char const* _input, CStyleReadFilesCallback _readCallback, void* _readContext) noexcept
+{
+	return storeAllocation(compileBatched(_input, _readCallback, _readContext));
+}
+
+extern void solidity_compile_sources(
+	char const* _input,
+	SoliditySource const* _sources,
+	size_t _sourceCount,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleOutputCallback _outputCallback,
+	void* _outputContext
+) noexcept
+{
+	compileSources(_input, _sources, _sourceCount, _readCallback, _readContext, _outputCallback, _outputContext);
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
-		return solidityAllocations.emplace_back(_size, '\0').data();
+		return storeAllocation(string(_size, '\0'));
 	}
 	catch (...)
 	{
@@ -156,7 +314,36 @@ extern void solidity_reset() noexcept
 {
 	// This is called right before each compilation, but not at the end, so additional memory
 	// can be freed here.
+	lock_guard<mutex> compilationLock(compilationMutex);
 	yul::YulStringRepository::reset();
+	lock_guard<mutex> allocationsLock(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
+
+extern SolidityInstance* solidity_create() noexcept
+{
+	try
+	{
+		return new SolidityInstance();
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+extern char* solidity_compile_with(
+	SolidityInstance* _instance,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) noexcept
+{
+	return storeAllocation(compile(_input, _readCallback, _readContext, _instance->compilationCache));
+}
+
+extern void solidity_destroy(SolidityInstance* _instance) noexcept
+{
+	delete _instance;
+}
 }
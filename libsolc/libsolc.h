@@ -52,6 +52,43 @@ extern "C" {
 /// If the callback is not supported, *o_contents and *o_error must be set to NULL.
 typedef void (*CStyleReadFileCallback)(void* _context, char const* _kind, char const* _data, char** o_contents, char** o_error);
 
+/// Callback used to retrieve several source files or data at once, e.g. concurrently.
+///
+/// @param _context The readContext passed to solidity_compile_batched. Can be NULL.
+/// @param _kind The kind of callback (a string).
+/// @param _count The number of requests.
+/// @param _data An array of @p _count strings with the data for each request.
+/// @param o_contents An array of @p _count pointers, each to be set to the contents of the respective file,
+///                   if found. Allocated via solidity_alloc().
+/// @param o_errors An array of @p _count pointers, each to be set to an error message for the respective
+///                 request, if there is one.
+///
+/// The same rules as for CStyleReadFileCallback apply to each request.
+typedef void (*CStyleReadFilesCallback)(
+	void* _context,
+	char const* _kind,
+	size_t _count,
+	char const* const* _data,
+	char** o_contents,
+	char** o_errors
+);
+
+/// A source file passed to solidity_compile_sources(). The strings need not be zero-terminated.
+typedef struct
+{
+	char const* name;
+	size_t nameLength;
+	char const* content;
+	size_t contentLength;
+} SoliditySource;
+
+/// Callback used to receive the output of solidity_compile_sources() in chunks.
+///
+/// @param _context The outputContext passed to solidity_compile_sources(). Can be NULL.
+/// @param _data The next chunk of the output. It is only valid during the call and not zero-terminated.
+/// @param _length The length of the chunk in bytes.
+typedef void (*CStyleOutputCallback)(void* _context, char const* _data, size_t _length);
+
 /// Returns the complete license document.
 ///
 /// The pointer returned must NOT be freed by the caller.
@@ -90,12 +127,76 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
+/// Same as solidity_compile(), but with a callback that receives several requests at once. All imports
+/// of the sources known at a time that are still missing are requested in one call, which saves round
+/// trips if files are loaded over the network.
+///
+/// @param _input The input JSON to process.
+/// @param _readCallback The optional callback pointer. Can be NULL.
+/// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
+///
+/// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
+char* solidity_compile_batched(char const* _input, CStyleReadFilesCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
+
+/// Same as solidity_compile(), but the sources are passed as buffers instead of as part of the input JSON,
+/// which must not contain "sources", and the output is passed to @p _outputCallback in chunks instead of
+/// being returned. The output of each contract is passed on as soon as it has been generated, so the
+/// complete output is never held in memory.
+///
+/// @param _input The input JSON to process, without "sources".
+/// @param _sources An array of @p _sourceCount sources. They are only accessed during the call.
+/// @param _sourceCount The number of sources.
+/// @param _readCallback The optional callback pointer. Can be NULL.
+/// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
+/// @param _outputCallback The callback receiving the "Standard Output JSON".
+/// @param _outputContext An optional context pointer passed to _outputCallback. Can be NULL.
+void solidity_compile_sources(
+	char const* _input,
+	SoliditySource const* _sources,
+	size_t _sourceCount,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext,
+	CStyleOutputCallback _outputCallback,
+	void* _outputContext
+) SOLC_NOEXCEPT;
+
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
 /// is invalid after calling this!
 void solidity_reset() SOLC_NOEXCEPT;
 
+/// Opaque handle of a compiler instance, see solidity_create().
+typedef struct SolidityInstance SolidityInstance;
+
+/// Creates a compiler instance. Compilations using the same instance share its caches, so that
+/// compiling contracts again with the same sources and settings skips their code generation.
+///
+/// Instances can be used from multiple threads at the same time, also together with solidity_compile().
+/// The compilations themselves are performed one after the other, since the compiler keeps global state.
+///
+/// @returns The new instance, which has to be destroyed using solidity_destroy(), or NULL if it could not be created.
+SolidityInstance* solidity_create() SOLC_NOEXCEPT;
+
+/// Same as solidity_compile(), but uses the caches of @p _instance.
+///
+/// @param _instance The instance created with solidity_create().
+/// @param _input The input JSON to process.
+/// @param _readCallback The optional callback pointer. Can be NULL.
+/// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
+///
+/// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
+char* solidity_compile_with(
+	SolidityInstance* _instance,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) SOLC_NOEXCEPT;
+
+/// Destroys @p _instance and frees its caches. Results returned by solidity_compile_with() remain valid.
+/// The instance must not be in use by another thread.
+void solidity_destroy(SolidityInstance* _instance) SOLC_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,7 +38,7 @@ namespace
 {
 
 /// Check whether (_base ** _exp) fits into 4096 bits.
-bool fitsPrecisionExp(bigint const& _base, bigint const& _exp)
+bool fitsPrecisionExp(bigint const& _base, uint32_t _exp)
 {
 	if (_base == 0)
 		return true;
@@ -53,7 +53,8 @@ bool fitsPrecisionExp(bigint const& _base, bigint const& _exp)
 	if (mostSignificantBaseBit > bitsMax) // _base >= 2 ^ 4096
 		return false;
 
-	bigint bitsNeeded = _exp * (mostSignificantBaseBit + 1);
+	// Cannot overflow, since both factors are less than 2 ** 32.
+	uint64_t bitsNeeded = uint64_t(_exp) * (mostSignificantBaseBit + 1);
 
 	return bitsNeeded <= bitsMax;
 }
@@ -64,11 +65,34 @@ bool fitsPrecisionBase2(bigint const& _mantissa, uint32_t _expBase2)
 	return fitsPrecisionBaseX(_mantissa, 1.0, _expBase2);
 }
 
+/// Evaluates the arithmetic operators on integers without going through rational arithmetic,
+/// which normalises the result using greatest common divisors after every operation.
+/// @returns nullopt if the operator is not handled here or the result is not an integer.
+optional<bigint> evaluateIntegerBinaryOperator(Token _operator, bigint const& _left, bigint const& _right)
+{
+	switch (_operator)
+	{
+	case Token::Add: return _left + _right;
+	case Token::Sub: return _left - _right;
+	case Token::Mul: return _left * _right;
+	case Token::Div:
+		if (_right != 0 && _left % _right == 0)
+			return _left / _right;
+		return nullopt;
+	default:
+		return nullopt;
+	}
+}
+
 }
 
 optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, rational const& _left, rational const& _right)
 {
 	bool fractional = _left.denominator() != 1 || _right.denominator() != 1;
+	if (!fractional)
+		if (optional<bigint> value = evaluateIntegerBinaryOperator(_operator, _left.numerator(), _right.numerator()))
+			return rational(move(*value));
+
 	switch (_operator)
 	{
 	//bit operations will only be enabled for integers and fixed types that resemble integers
@@ -143,6 +167,8 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 			};
 
 			bigint numerator = optimizedPow(_left.numerator(), absExp);
+			if (exp >= 0 && _left.denominator() == 1)
+				return rational(move(numerator));
 			bigint denominator = optimizedPow(_left.denominator(), absExp);
 
 			if (exp >= 0)
@@ -168,7 +194,7 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 			uint32_t exponent = _right.numerator().convert_to<uint32_t>();
 			if (!fitsPrecisionBase2(abs(_left.numerator()), exponent))
 				return nullopt;
-			return _left.numerator() * boost::multiprecision::pow(bigint(2), exponent);
+			return _left.numerator() << exponent;
 		}
 		break;
 	}
@@ -199,9 +225,11 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 					// therefore xor(div(xor(x,all_ones), exp(2, shift_amount)), all_ones) is
 					// -(-x - 1) / 2^shift_amount - 1, which is the same as
 					// (x + 1) / 2^shift_amount - 1.
-					return rational((_left.numerator() + 1) / boost::multiprecision::pow(bigint(2), exponent) - bigint(1), 1);
+					// The division by 2^shift_amount rounds towards zero, which is a right shift of the
+					// (non-negative) magnitude.
+					return rational(-((-(_left.numerator() + 1)) >> exponent) - bigint(1), 1);
 				else
-					return rational(_left.numerator() / boost::multiprecision::pow(bigint(2), exponent), 1);
+					return rational(_left.numerator() >> exponent, 1);
 			}
 		}
 		break;
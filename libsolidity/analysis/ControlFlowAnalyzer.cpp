@@ -20,6 +20,7 @@
 
 #include <liblangutil/SourceLocation.h>
 #include <libsolutil/Algorithms.h>
+#include <boost/dynamic_bitset.hpp>
 #include <boost/range/algorithm/sort.hpp>
 
 using namespace std;
@@ -34,58 +35,107 @@ bool ControlFlowAnalyzer::analyze(ASTNode const& _astRoot)
 
 bool ControlFlowAnalyzer::visit(FunctionDefinition const& _function)
 {
-	if (_function.isImplemented())
+	if (_function.isImplemented() && !_function.body().deferred())
 	{
 		auto const& functionFlow = m_cfg.functionFlow(_function);
-		checkUninitializedAccess(functionFlow.entry, functionFlow.exit, _function.body().statements().empty());
+		checkUninitializedAccess(functionFlow, _function.body().statements().empty());
 		checkUnreachable(functionFlow.entry, functionFlow.exit, functionFlow.revert, functionFlow.transactionReturn);
 	}
 	return false;
 }
 
-void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody) const
+void ControlFlowAnalyzer::checkUninitializedAccess(FunctionFlow const& _flow, bool _emptyBody) const
 {
+	using Bitset = boost::dynamic_bitset<>;
+	auto localIndex = [&](CFGNode const* _node) { return _node->index - _flow.entry->index; };
+
+	// Only accesses to unassigned storage and calldata pointers and unnamed return variables are
+	// reported, so no other variables have to be tracked. The tracked variables and their
+	// accesses are numbered densely, so that the sets of them can be represented as bitsets.
+	auto tracked = [&](VariableDeclaration const& _variable) {
+		return
+			_variable.type()->dataStoredIn(DataLocation::Storage) ||
+			_variable.type()->dataStoredIn(DataLocation::CallData) ||
+			(!_emptyBody && _variable.name().empty());
+	};
+	struct Operation
+	{
+		VariableOccurrence::Kind kind;
+		size_t variable;
+		size_t access;
+	};
+	map<VariableDeclaration const*, size_t> variableIndices;
+	vector<VariableOccurrence const*> accesses;
+	vector<vector<Operation>> operations(_flow.nodeCount);
+	vector<CFGNode const*> nodes(_flow.nodeCount);
+	util::BreadthFirstSearch<CFGNode const*>{{_flow.entry}}.run(
+		[&](CFGNode const* _node, auto&& _addChild) {
+			nodes[localIndex(_node)] = _node;
+			for (VariableOccurrence const& occurrence: _node->variableOccurrences)
+				if (tracked(occurrence.declaration()))
+				{
+					size_t variable = variableIndices.emplace(&occurrence.declaration(), variableIndices.size()).first->second;
+					size_t access = accesses.size();
+					if (
+						occurrence.kind() != VariableOccurrence::Kind::Assignment &&
+						occurrence.kind() != VariableOccurrence::Kind::Declaration
+					)
+						accesses.emplace_back(&occurrence);
+					operations[localIndex(_node)].push_back({occurrence.kind(), variable, access});
+				}
+			for (CFGNode const* exit: _node->exits)
+				_addChild(exit);
+		}
+	);
+	if (accesses.empty())
+		return;
+
 	struct NodeInfo
 	{
-		set<VariableDeclaration const*> unassignedVariablesAtEntry;
-		set<VariableDeclaration const*> unassignedVariablesAtExit;
-		set<VariableOccurrence const*> uninitializedVariableAccesses;
+		Bitset unassignedVariablesAtEntry;
+		Bitset unassignedVariablesAtExit;
+		Bitset uninitializedVariableAccesses;
 		/// Propagate the information from another node to this node.
 		/// To be used to propagate information from a node to its exit nodes.
 		/// Returns true, if new variables were added and thus the current node has
 		/// to be traversed again.
 		bool propagateFrom(NodeInfo const& _entryNode)
 		{
-			size_t previousUnassignedVariablesAtEntry = unassignedVariablesAtEntry.size();
-			size_t previousUninitializedVariableAccessess = uninitializedVariableAccesses.size();
-			unassignedVariablesAtEntry += _entryNode.unassignedVariablesAtExit;
-			uninitializedVariableAccesses += _entryNode.uninitializedVariableAccesses;
-			return
-				unassignedVariablesAtEntry.size() > previousUnassignedVariablesAtEntry ||
-				uninitializedVariableAccesses.size() > previousUninitializedVariableAccessess
-			;
+			if (
+				_entryNode.unassignedVariablesAtExit.is_subset_of(unassignedVariablesAtEntry) &&
+				_entryNode.uninitializedVariableAccesses.is_subset_of(uninitializedVariableAccesses)
+			)
+				return false;
+			unassignedVariablesAtEntry |= _entryNode.unassignedVariablesAtExit;
+			uninitializedVariableAccesses |= _entryNode.uninitializedVariableAccesses;
+			return true;
 		}
 	};
-	map<CFGNode const*, NodeInfo> nodeInfos;
-	set<CFGNode const*> nodesToTraverse;
-	nodesToTraverse.insert(_entry);
+	vector<NodeInfo> nodeInfos(_flow.nodeCount, NodeInfo{
+		Bitset(variableIndices.size()),
+		Bitset(variableIndices.size()),
+		Bitset(accesses.size())
+	});
+	Bitset visited(_flow.nodeCount);
+	set<size_t> nodesToTraverse{localIndex(_flow.entry)};
+	visited.set(localIndex(_flow.entry));
 
 	// Walk all paths starting from the nodes in ``nodesToTraverse`` until ``NodeInfo::propagateFrom``
 	// returns false for all exits, i.e. until all paths have been walked with maximal sets of unassigned
 	// variables and accesses.
 	while (!nodesToTraverse.empty())
 	{
-		CFGNode const* currentNode = *nodesToTraverse.begin();
+		size_t currentNode = *nodesToTraverse.begin();
 		nodesToTraverse.erase(nodesToTraverse.begin());
 
 		auto& nodeInfo = nodeInfos[currentNode];
-		auto unassignedVariables = nodeInfo.unassignedVariablesAtEntry;
-		for (auto const& variableOccurrence: currentNode->variableOccurrences)
+		Bitset unassignedVariables = nodeInfo.unassignedVariablesAtEntry;
+		for (Operation const& operation: operations[currentNode])
 		{
-			switch (variableOccurrence.kind())
+			switch (operation.kind)
 			{
 				case VariableOccurrence::Kind::Assignment:
-					unassignedVariables.erase(&variableOccurrence.declaration());
+					unassignedVariables.reset(operation.variable);
 					break;
 				case VariableOccurrence::Kind::InlineAssembly:
 					// We consider all variables referenced in inline assembly as accessed.
@@ -93,37 +143,40 @@ void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNod
 					// the control flow in the assembly at some point.
 				case VariableOccurrence::Kind::Access:
 				case VariableOccurrence::Kind::Return:
-					if (unassignedVariables.count(&variableOccurrence.declaration()))
+					if (unassignedVariables.test(operation.variable))
 					{
 						// Merely store the unassigned access. We do not generate an error right away, since this
 						// path might still always revert. It is only an error if this is propagated to the exit
 						// node of the function (i.e. there is a path with an uninitialized access).
-						nodeInfo.uninitializedVariableAccesses.insert(&variableOccurrence);
+						nodeInfo.uninitializedVariableAccesses.set(operation.access);
 					}
 					break;
 				case VariableOccurrence::Kind::Declaration:
-					unassignedVariables.insert(&variableOccurrence.declaration());
+					unassignedVariables.set(operation.variable);
 					break;
 			}
 		}
 		nodeInfo.unassignedVariablesAtExit = std::move(unassignedVariables);
 
 		// Propagate changes to all exits and queue them for traversal, if needed.
-		for (auto const& exit: currentNode->exits)
-			if (
-				auto exists = valueOrNullptr(nodeInfos, exit);
-				nodeInfos[exit].propagateFrom(nodeInfo) || !exists
-			)
-				nodesToTraverse.insert(exit);
+		for (CFGNode const* exit: nodes[currentNode]->exits)
+		{
+			size_t exitIndex = localIndex(exit);
+			if (nodeInfos[exitIndex].propagateFrom(nodeInfo) || !visited.test(exitIndex))
+			{
+				visited.set(exitIndex);
+				nodesToTraverse.insert(exitIndex);
+			}
+		}
 	}
 
-	auto const& exitInfo = nodeInfos[_exit];
-	if (!exitInfo.uninitializedVariableAccesses.empty())
+	auto const& exitInfo = nodeInfos[localIndex(_flow.exit)];
+	if (exitInfo.uninitializedVariableAccesses.any())
 	{
-		vector<VariableOccurrence const*> uninitializedAccessesOrdered(
-			exitInfo.uninitializedVariableAccesses.begin(),
-			exitInfo.uninitializedVariableAccesses.end()
-		);
+		vector<VariableOccurrence const*> uninitializedAccessesOrdered;
+		for (size_t access = 0; access < accesses.size(); ++access)
+			if (exitInfo.uninitializedVariableAccesses.test(access))
+				uninitializedAccessesOrdered.push_back(accesses[access]);
 		boost::range::sort(
 			uninitializedAccessesOrdered,
 			[](VariableOccurrence const* lhs, VariableOccurrence const* rhs) -> bool
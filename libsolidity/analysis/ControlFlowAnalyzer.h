@@ -35,8 +35,9 @@ public:
 	bool visit(FunctionDefinition const& _function) override;
 
 private:
-	/// Checks for uninitialized variable accesses in the control flow between @param _entry and @param _exit.
-	void checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody) const;
+	/// Checks for uninitialized variable accesses in the control flow between the entry and the exit
+	/// of @param _flow. Only the variables an error or a warning can be reported for are tracked.
+	void checkUninitializedAccess(FunctionFlow const& _flow, bool _emptyBody) const;
 	/// Checks for unreachable code, i.e. code ending in @param _exit, @param _revert or @param _transactionReturn
 	/// that can not be reached from @param _entry.
 	void checkUnreachable(CFGNode const* _entry, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn) const;
@@ -47,6 +47,7 @@ unique_ptr<FunctionFlow> ControlFlowBuilder::createFunctionFlow(
 	functionFlow->transactionReturn = _nodeContainer.newNode();
 	ControlFlowBuilder builder(_nodeContainer, *functionFlow);
 	builder.appendControlFlow(_function);
+	functionFlow->nodeCount = _nodeContainer.size() - functionFlow->entry->index;
 
 	return functionFlow;
 }
@@ -47,6 +47,7 @@ FunctionFlow const& CFG::functionFlow(FunctionDefinition const& _function) const
 
 CFGNode* CFG::NodeContainer::newNode()
 {
-	m_nodes.emplace_back(std::make_unique<CFGNode>());
-	return m_nodes.back().get();
+	m_nodes.emplace_back();
+	m_nodes.back().index = m_nodes.size() - 1;
+	return &m_nodes.back();
 }
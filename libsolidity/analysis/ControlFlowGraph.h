@@ -24,6 +24,7 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <stack>
@@ -103,6 +104,9 @@ struct CFGNode
 	std::vector<VariableOccurrence> variableOccurrences;
 	// Source location of this control flow block.
 	langutil::SourceLocation location;
+	/// Position of the node in the order of creation. The nodes of a function flow have
+	/// consecutive indices starting at the index of its entry node.
+	size_t index = 0;
 };
 
 /** Describes the control flow of a function. */
@@ -125,6 +129,8 @@ struct FunctionFlow
 	/// This node is empty and does not have any exits, but may have multiple entries
 	/// (e.g. all inline assembly return calls).
 	CFGNode* transactionReturn = nullptr;
+	/// Number of nodes of the function, including the nodes above.
+	size_t nodeCount = 0;
 };
 
 class CFG: private ASTConstVisitor
@@ -142,8 +148,10 @@ public:
 	{
 	public:
 		CFGNode* newNode();
+		size_t size() const { return m_nodes.size(); }
 	private:
-		std::vector<std::unique_ptr<CFGNode>> m_nodes;
+		/// The nodes are stored in chunks of contiguous memory and never move.
+		std::deque<CFGNode> m_nodes;
 	};
 private:
 	langutil::ErrorReporter& m_errorReporter;
@@ -27,6 +27,8 @@
 #include <libsolidity/ast/Types.h>
 #include <libsolutil/StringUtils.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
@@ -40,10 +42,10 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	if (auto it = m_declarations.find(*_name); it != m_declarations.end())
+		declarations += it->second;
+	if (auto it = m_invisibleDeclarations.find(*_name); it != m_invisibleDeclarations.end())
+		declarations += it->second;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -144,17 +146,37 @@ bool DeclarationContainer::registerDeclaration(
 	return registerDeclaration(_declaration, nullptr, nullptr, _invisible, _update);
 }
 
+map<ASTString, vector<Declaration const*>> DeclarationContainer::declarations() const
+{
+	return {m_declarations.begin(), m_declarations.end()};
+}
+
 vector<Declaration const*> DeclarationContainer::resolveName(ASTString const& _name, bool _recursive, bool _alsoInvisible) const
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
-	vector<Declaration const*> result;
-	if (m_declarations.count(_name))
-		result = m_declarations.at(_name);
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
-		result += m_invisibleDeclarations.at(_name);
-	if (result.empty() && _recursive && m_enclosingContainer)
-		result = m_enclosingContainer->resolveName(_name, true, _alsoInvisible);
-	return result;
+	// Walk the chain of enclosing containers iteratively and only copy the declarations
+	// of the container that actually declares the name.
+	for (DeclarationContainer const* container = this; container; container = container->m_enclosingContainer)
+	{
+		auto visible = container->m_declarations.find(_name);
+		auto invisible = _alsoInvisible ?
+			container->m_invisibleDeclarations.find(_name) :
+			container->m_invisibleDeclarations.end();
+		bool hasVisible = visible != container->m_declarations.end() && !visible->second.empty();
+		bool hasInvisible = invisible != container->m_invisibleDeclarations.end() && !invisible->second.empty();
+		if (hasVisible || hasInvisible)
+		{
+			vector<Declaration const*> result;
+			if (hasVisible)
+				result = visible->second;
+			if (hasInvisible)
+				result += invisible->second;
+			return result;
+		}
+		if (!_recursive)
+			break;
+	}
+	return {};
 }
 
 vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) const
@@ -166,17 +188,18 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 
 	vector<ASTString> similar;
 	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
-	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
+	// The containers are hashed, so sort the suggestions to keep error messages deterministic.
+	for (auto const* declarations: {&m_declarations, &m_invisibleDeclarations})
 	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
+		vector<ASTString> similarInContainer;
+		for (auto const& declaration: *declarations)
+		{
+			string const& declarationName = declaration.first;
+			if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+				similarInContainer.push_back(declarationName);
+		}
+		sort(similarInContainer.begin(), similarInContainer.end());
+		similar += similarInContainer;
 	}
 
 	if (m_enclosingContainer)
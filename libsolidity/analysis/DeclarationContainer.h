@@ -28,6 +28,9 @@
 #include <liblangutil/SourceLocation.h>
 #include <boost/noncopyable.hpp>
 
+#include <map>
+#include <unordered_map>
+
 namespace solidity::frontend
 {
 
@@ -61,7 +64,8 @@ public:
 	std::vector<Declaration const*> resolveName(ASTString const& _name, bool _recursive = false, bool _alsoInvisible = false) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
 	DeclarationContainer const* enclosingContainer() const { return m_enclosingContainer; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns all visible declarations of this container (not of the enclosing ones), ordered by name.
+	std::map<ASTString, std::vector<Declaration const*>> declarations() const;
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
@@ -84,8 +88,10 @@ private:
 	ASTNode const* m_enclosingNode;
 	DeclarationContainer const* m_enclosingContainer;
 	std::vector<DeclarationContainer const*> m_innerContainers;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	/// Hashed, since they are only queried by name. Anything that iterates over them and
+	/// can influence the output has to impose an order of its own.
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_declarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
 	/// List of declarations (name and location) to check later for homonymity.
 	std::vector<std::pair<std::string, langutil::SourceLocation const*>> m_homonymCandidates;
 };
@@ -49,6 +49,8 @@ public:
 	void resetCurrentContract() { m_currentContract = nullptr; }
 	MagicVariableDeclaration const* currentThis() const;
 	MagicVariableDeclaration const* currentSuper() const;
+	/// Forgets the "this" and "super" declarations of @a _contract, which is about to be destroyed.
+	void removeContract(ContractDefinition const& _contract);
 
 	/// @returns a vector of all implicit global declarations excluding "this".
 	std::vector<Declaration const*> declarations() const;
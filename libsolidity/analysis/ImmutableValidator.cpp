@@ -27,10 +27,22 @@ using namespace solidity::langutil;
 
 void ImmutableValidator::analyze()
 {
-	m_inConstructionContext = true;
-
 	auto linearizedContracts = m_currentContract.annotation().linearizedBaseContracts | boost::adaptors::reversed;
 
+	// Contracts with bodies that were not parsed are not compiled, and the assignments in
+	// these bodies are unknown.
+	for (ContractDefinition const* contract: linearizedContracts)
+	{
+		for (FunctionDefinition const* function: contract->definedFunctions())
+			if (function->isImplemented() && function->body().deferred())
+				return;
+		for (ModifierDefinition const* modifier: contract->functionModifiers())
+			if (modifier->isImplemented() && modifier->body().deferred())
+				return;
+	}
+
+	m_inConstructionContext = true;
+
 	for (ContractDefinition const* contract: linearizedContracts)
 		for (VariableDeclaration const* stateVar: contract->stateVariables())
 			if (stateVar->value())
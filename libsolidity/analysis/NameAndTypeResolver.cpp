@@ -122,7 +122,11 @@ bool NameAndTypeResolver::performImports(SourceUnit& _sourceUnit, map<string, So
 						))
 							error =  true;
 		}
-	_sourceUnit.annotation().exportedSymbols = m_scopes[&_sourceUnit]->declarations();
+	// Source units kept from a previous compilation already export the same symbols.
+	if (_sourceUnit.annotation().exportedSymbols.set())
+		solAssert(*_sourceUnit.annotation().exportedSymbols == m_scopes[&_sourceUnit]->declarations(), "");
+	else
+		_sourceUnit.annotation().exportedSymbols = m_scopes[&_sourceUnit]->declarations();
 	return !error;
 }
 
@@ -343,55 +347,66 @@ bool NameAndTypeResolver::resolveNamesAndTypesInternal(ASTNode& _node, bool _res
 	}
 }
 
+vector<Declaration const*> const& NameAndTypeResolver::inheritableDeclarations(ContractDefinition const& _base)
+{
+	auto [cached, inserted] = m_inheritableDeclarations.try_emplace(&_base);
+	if (inserted)
+	{
+		auto iterator = m_scopes.find(&_base);
+		solAssert(iterator != end(m_scopes), "");
+		for (auto const& nameAndDeclaration: iterator->second->declarations())
+			for (auto const& declaration: nameAndDeclaration.second)
+				// Import if it was declared in the base, is not the constructor and is visible in derived classes
+				if (declaration->scope() == &_base && declaration->isVisibleInDerivedContracts())
+					cached->second.emplace_back(declaration);
+	}
+	return cached->second;
+}
+
 void NameAndTypeResolver::importInheritedScope(ContractDefinition const& _base)
 {
-	auto iterator = m_scopes.find(&_base);
-	solAssert(iterator != end(m_scopes), "");
-	for (auto const& nameAndDeclaration: iterator->second->declarations())
-		for (auto const& declaration: nameAndDeclaration.second)
-			// Import if it was declared in the base, is not the constructor and is visible in derived classes
-			if (declaration->scope() == &_base && declaration->isVisibleInDerivedContracts())
-				if (!m_currentScope->registerDeclaration(*declaration, false, false))
-				{
-					SourceLocation firstDeclarationLocation;
-					SourceLocation secondDeclarationLocation;
-					Declaration const* conflictingDeclaration = m_currentScope->conflictingDeclaration(*declaration);
-					solAssert(conflictingDeclaration, "");
-
-					// Usual shadowing is not an error
-					if (
-						dynamic_cast<ModifierDefinition const*>(declaration) &&
-						dynamic_cast<ModifierDefinition const*>(conflictingDeclaration)
-					)
-						continue;
-
-					// Public state variable can override functions
-					if (auto varDecl = dynamic_cast<VariableDeclaration const*>(conflictingDeclaration))
-						if (
-							dynamic_cast<FunctionDefinition const*>(declaration) &&
-							varDecl->isStateVariable() &&
-							varDecl->isPublic()
-						)
-							continue;
-
-					if (declaration->location().start < conflictingDeclaration->location().start)
-					{
-						firstDeclarationLocation = declaration->location();
-						secondDeclarationLocation = conflictingDeclaration->location();
-					}
-					else
-					{
-						firstDeclarationLocation = conflictingDeclaration->location();
-						secondDeclarationLocation = declaration->location();
-					}
+	for (Declaration const* declaration: inheritableDeclarations(_base))
+		if (!m_currentScope->registerDeclaration(*declaration, false, false))
+		{
+			SourceLocation firstDeclarationLocation;
+			SourceLocation secondDeclarationLocation;
+			Declaration const* conflictingDeclaration = m_currentScope->conflictingDeclaration(*declaration);
+			solAssert(conflictingDeclaration, "");
+
+			// Usual shadowing is not an error
+			if (
+				dynamic_cast<ModifierDefinition const*>(declaration) &&
+				dynamic_cast<ModifierDefinition const*>(conflictingDeclaration)
+			)
+				continue;
 
-					m_errorReporter.declarationError(
-						9097_error,
-						secondDeclarationLocation,
-						SecondarySourceLocation().append("The previous declaration is here:", firstDeclarationLocation),
-						"Identifier already declared."
-					);
-				}
+			// Public state variable can override functions
+			if (auto varDecl = dynamic_cast<VariableDeclaration const*>(conflictingDeclaration))
+				if (
+					dynamic_cast<FunctionDefinition const*>(declaration) &&
+					varDecl->isStateVariable() &&
+					varDecl->isPublic()
+				)
+					continue;
+
+			if (declaration->location().start < conflictingDeclaration->location().start)
+			{
+				firstDeclarationLocation = declaration->location();
+				secondDeclarationLocation = conflictingDeclaration->location();
+			}
+			else
+			{
+				firstDeclarationLocation = conflictingDeclaration->location();
+				secondDeclarationLocation = declaration->location();
+			}
+
+			m_errorReporter.declarationError(
+				9097_error,
+				secondDeclarationLocation,
+				SecondarySourceLocation().append("The previous declaration is here:", firstDeclarationLocation),
+				"Identifier already declared."
+			);
+		}
 }
 
 void NameAndTypeResolver::linearizeBaseContracts(ContractDefinition& _contract)
@@ -637,7 +652,12 @@ bool DeclarationRegistrationHelper::visitNode(ASTNode& _node)
 	if (auto* variableScope = dynamic_cast<VariableScope*>(&_node))
 		m_currentFunction = variableScope;
 	if (auto* annotation = dynamic_cast<TypeDeclarationAnnotation*>(&_node.annotation()))
-		annotation->canonicalName = currentCanonicalName();
+	{
+		if (annotation->canonicalName.set())
+			solAssert(*annotation->canonicalName == currentCanonicalName(), "");
+		else
+			annotation->canonicalName = currentCanonicalName();
+	}
 
 	return true;
 }
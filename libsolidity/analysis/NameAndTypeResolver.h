@@ -111,6 +111,10 @@ private:
 	/// Imports all members declared directly in the given contract (i.e. does not import inherited members)
 	/// into the current scope if they are not present already.
 	void importInheritedScope(ContractDefinition const& _base);
+	/// @returns the members declared directly in @a _base that are visible in derived contracts,
+	/// ordered by name. The list is computed once per contract and shared by all contracts
+	/// deriving from it.
+	std::vector<Declaration const*> const& inheritableDeclarations(ContractDefinition const& _base);
 
 	/// Computes "C3-Linearization" of base contracts and stores it inside the contract. Reports errors if any
 	void linearizeBaseContracts(ContractDefinition& _contract);
@@ -124,6 +128,8 @@ private:
 	/// not contain code.
 	/// Aliases (for example `import "x" as y;`) create multiple pointers to the same scope.
 	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
+	/// Cache for @a inheritableDeclarations.
+	std::map<ContractDefinition const*, std::vector<Declaration const*>> m_inheritableDeclarations;
 
 	langutil::EVMVersion m_evmVersion;
 	DeclarationContainer* m_currentScope = nullptr;
@@ -37,22 +37,11 @@ using namespace solidity::frontend;
 using namespace solidity::langutil;
 
 using solidity::util::GenericVisitor;
-using solidity::util::contains_if;
 using solidity::util::joinHumanReadable;
 
 namespace
 {
 
-// Helper struct to do a search by name
-struct MatchByName
-{
-	string const& m_name;
-	bool operator()(OverrideProxy const& _item)
-	{
-		return _item.name() == m_name;
-	}
-};
-
 /**
  * Construct the override graph for this signature.
  * Reserve node 0 for the current contract and node
@@ -464,9 +453,16 @@ void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 	OverrideProxyBySignatureMultiSet const& inheritedFuncs = inheritedFunctions(_contract);
 	OverrideProxyBySignatureMultiSet const& inheritedMods = inheritedModifiers(_contract);
 
+	set<string> inheritedFunctionNames;
+	for (OverrideProxy const& function: inheritedFuncs)
+		inheritedFunctionNames.insert(function.name());
+	set<string> inheritedModifierNames;
+	for (OverrideProxy const& modifier: inheritedMods)
+		inheritedModifierNames.insert(modifier.name());
+
 	for (ModifierDefinition const* modifier: _contract.functionModifiers())
 	{
-		if (contains_if(inheritedFuncs, MatchByName{modifier->name()}))
+		if (inheritedFunctionNames.count(modifier->name()))
 			m_errorReporter.typeError(
 				5631_error,
 				modifier->location(),
@@ -481,7 +477,7 @@ void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 		if (function->isConstructor())
 			continue;
 
-		if (contains_if(inheritedMods, MatchByName{function->name()}))
+		if (inheritedModifierNames.count(function->name()))
 			m_errorReporter.typeError(1469_error, function->location(), "Override changes modifier to function.");
 
 		checkOverrideList(OverrideProxy{function}, inheritedFuncs);
@@ -496,7 +492,7 @@ void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 			continue;
 		}
 
-		if (contains_if(inheritedMods, MatchByName{stateVar->name()}))
+		if (inheritedModifierNames.count(stateVar->name()))
 			m_errorReporter.typeError(1456_error, stateVar->location(), "Override changes modifier to public state variable.");
 
 		checkOverrideList(OverrideProxy{stateVar}, inheritedFuncs);
@@ -879,52 +875,57 @@ void OverrideChecker::checkOverrideList(OverrideProxy _item, OverrideProxyBySign
 
 OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheritedFunctions(ContractDefinition const& _contract) const
 {
-	if (!m_inheritedFunctions.count(&_contract))
-	{
-		OverrideProxyBySignatureMultiSet result;
-
+	auto [cached, inserted] = m_inheritedFunctions.try_emplace(&_contract);
+	if (inserted)
 		for (auto const* base: resolveDirectBaseContracts(_contract))
-		{
-			set<OverrideProxy, OverrideProxy::CompareBySignature> functionsInBase;
-			for (FunctionDefinition const* fun: base->definedFunctions())
-				if (!fun->isConstructor())
-					functionsInBase.emplace(OverrideProxy{fun});
-			for (VariableDeclaration const* var: base->stateVariables())
-				if (var->isPublic())
-					functionsInBase.emplace(OverrideProxy{var});
-
-			for (OverrideProxy const& func: inheritedFunctions(*base))
-				functionsInBase.insert(func);
-
-			result += functionsInBase;
-		}
+			cached->second += inheritableFunctions(*base);
 
-		m_inheritedFunctions[&_contract] = result;
-	}
-
-	return m_inheritedFunctions[&_contract];
+	return cached->second;
 }
 
 OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheritedModifiers(ContractDefinition const& _contract) const
 {
-	if (!m_inheritedModifiers.count(&_contract))
-	{
-		OverrideProxyBySignatureMultiSet result;
-
+	auto [cached, inserted] = m_inheritedModifiers.try_emplace(&_contract);
+	if (inserted)
 		for (auto const* base: resolveDirectBaseContracts(_contract))
-		{
-			set<OverrideProxy, OverrideProxy::CompareBySignature> modifiersInBase;
-			for (ModifierDefinition const* mod: base->functionModifiers())
-				modifiersInBase.emplace(OverrideProxy{mod});
+			cached->second += inheritableModifiers(*base);
 
-			for (OverrideProxy const& mod: inheritedModifiers(*base))
-				modifiersInBase.insert(mod);
+	return cached->second;
+}
 
-			result += modifiersInBase;
-		}
+OverrideChecker::OverrideProxyBySignatureSet const& OverrideChecker::inheritableFunctions(ContractDefinition const& _contract) const
+{
+	auto [cached, inserted] = m_inheritableFunctions.try_emplace(&_contract);
+	if (inserted)
+	{
+		OverrideProxyBySignatureSet& functions = cached->second;
+		for (FunctionDefinition const* fun: _contract.definedFunctions())
+			if (!fun->isConstructor())
+				functions.emplace(OverrideProxy{fun});
+		for (VariableDeclaration const* var: _contract.stateVariables())
+			if (var->isPublic())
+				functions.emplace(OverrideProxy{var});
+
+		// Does not replace the functions of the contract itself, since they override the inherited ones.
+		for (OverrideProxy const& func: inheritedFunctions(_contract))
+			functions.insert(func);
+	}
+
+	return cached->second;
+}
+
+OverrideChecker::OverrideProxyBySignatureSet const& OverrideChecker::inheritableModifiers(ContractDefinition const& _contract) const
+{
+	auto [cached, inserted] = m_inheritableModifiers.try_emplace(&_contract);
+	if (inserted)
+	{
+		OverrideProxyBySignatureSet& modifiers = cached->second;
+		for (ModifierDefinition const* mod: _contract.functionModifiers())
+			modifiers.emplace(OverrideProxy{mod});
 
-		m_inheritedModifiers[&_contract] = result;
+		for (OverrideProxy const& mod: inheritedModifiers(_contract))
+			modifiers.insert(mod);
 	}
 
-	return m_inheritedModifiers[&_contract];
+	return cached->second;
 }
@@ -134,6 +134,7 @@ class OverrideChecker
 {
 public:
 	using OverrideProxyBySignatureMultiSet = std::multiset<OverrideProxy, OverrideProxy::CompareBySignature>;
+	using OverrideProxyBySignatureSet = std::set<OverrideProxy, OverrideProxy::CompareBySignature>;
 
 	/// @param _errorReporter provides the error logging functionality.
 	explicit OverrideChecker(langutil::ErrorReporter& _errorReporter):
@@ -153,6 +154,12 @@ public:
 	OverrideProxyBySignatureMultiSet const& inheritedModifiers(ContractDefinition const& _contract) const;
 
 private:
+	/// @returns the functions (including public state variables) that @a _contract passes on
+	/// to contracts deriving from it, i.e. its own ones and the inherited ones it does not override.
+	/// Computed once per contract and shared by all contracts deriving from it.
+	OverrideProxyBySignatureSet const& inheritableFunctions(ContractDefinition const& _contract) const;
+	OverrideProxyBySignatureSet const& inheritableModifiers(ContractDefinition const& _contract) const;
+
 	void checkIllegalOverrides(ContractDefinition const& _contract);
 	/// Performs various checks related to @a _overriding overriding @a _super like
 	/// different return type, invalid visibility change, etc.
@@ -194,6 +201,9 @@ private:
 	/// Cache for inheritedFunctions().
 	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedFunctions;
 	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedModifiers;
+	/// Cache for inheritableFunctions().
+	std::map<ContractDefinition const*, OverrideProxyBySignatureSet> mutable m_inheritableFunctions;
+	std::map<ContractDefinition const*, OverrideProxyBySignatureSet> mutable m_inheritableModifiers;
 };
 
 }
@@ -187,7 +187,7 @@ bool SyntaxChecker::visit(ModifierDefinition const&)
 
 void SyntaxChecker::endVisit(ModifierDefinition const& _modifier)
 {
-	if (_modifier.isImplemented() && !m_placeholderFound)
+	if (_modifier.isImplemented() && !_modifier.body().deferred() && !m_placeholderFound)
 		m_errorReporter.syntaxError(2883_error, _modifier.body().location(), "Modifier body does not contain '_'.");
 	m_placeholderFound = false;
 }
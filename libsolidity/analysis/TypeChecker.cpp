@@ -2302,12 +2302,12 @@ bool TypeChecker::visit(FunctionCall const& _functionCall)
 
 	// Store argument types - and names if given - for overload resolution
 	{
-		FuncCallArguments funcCallArgs;
+		auto funcCallArgs = make_shared<FuncCallArguments>();
 
-		funcCallArgs.names = _functionCall.names();
+		funcCallArgs->names = _functionCall.names();
 
 		for (ASTPointer<Expression const> const& argument: arguments)
-			funcCallArgs.types.push_back(type(*argument));
+			funcCallArgs->types.push_back(type(*argument));
 
 		_functionCall.expression().annotation().arguments = std::move(funcCallArgs);
 	}
@@ -2825,7 +2825,7 @@ bool TypeChecker::visit(MemberAccess const& _memberAccess)
 
 		if (
 			funType->kind() == FunctionType::Kind::ArrayPush &&
-			arguments.value().numArguments() != 0 &&
+			arguments && arguments->numArguments() != 0 &&
 			exprType->containsNestedMapping()
 		)
 			m_errorReporter.typeError(
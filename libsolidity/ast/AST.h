@@ -40,6 +40,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -126,7 +127,8 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	/// Only changed by the parser, see Parser::shiftNodeIDs().
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -137,11 +139,50 @@ protected:
 	}
 
 private:
-	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
+	friend class Parser;
+	template <class Node> friend class Annotated;
+
+	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism),
+	/// unless the node is an Annotated node, which stores its annotation inline.
 	mutable std::unique_ptr<ASTAnnotation> m_annotation;
 	SourceLocation m_location;
 };
 
+/**
+ * AST node of type @a Node that stores its annotation inline instead of allocating it on first use.
+ * The annotation is allocated together with the node, i.e. in the arena of the source unit for
+ * parsed nodes, and is next to the node in memory.
+ * Nodes whose annotation is not specialised are left as they are.
+ */
+template <class Node>
+class Annotated: public Node
+{
+public:
+	using Annotation = std::remove_reference_t<decltype(std::declval<Node const&>().annotation())>;
+
+	template <typename... Args>
+	explicit Annotated(Args&&... _args): Node(std::forward<Args>(_args)...)
+	{
+		this->m_annotation.reset(&m_inlineAnnotation);
+	}
+	~Annotated() override
+	{
+		// The annotation is destroyed as a member.
+		this->m_annotation.release();
+	}
+
+private:
+	Annotation m_inlineAnnotation;
+};
+
+/// @returns Annotated<Node> if @a Node has a specialised annotation and @a Node otherwise.
+template <class Node>
+using AnnotatedNode = std::conditional_t<
+	std::is_same_v<std::remove_reference_t<decltype(std::declval<Node const&>().annotation())>, ASTAnnotation>,
+	Node,
+	Annotated<Node>
+>;
+
 template <class T>
 std::vector<T const*> ASTNode::filteredNodes(std::vector<ASTPointer<ASTNode>> const& _nodes)
 {
@@ -1395,12 +1436,18 @@ public:
 
 	std::vector<ASTPointer<Statement>> const& statements() const { return m_statements; }
 	bool unchecked() const { return m_unchecked; }
+	/// @returns true if this is the body of a function or modifier that was skipped by the
+	/// parser and has not been parsed yet. Such a block has no statements.
+	bool deferred() const { return m_deferred; }
 
 	BlockAnnotation& annotation() const override;
 
 private:
+	friend class Parser;
+
 	std::vector<ASTPointer<Statement>> m_statements;
 	bool m_unchecked;
+	bool m_deferred = false;
 };
 
 /**
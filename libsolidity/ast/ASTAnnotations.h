@@ -78,12 +78,15 @@ struct StructurallyDocumentedAnnotation
 	StructurallyDocumentedAnnotation& operator=(StructurallyDocumentedAnnotation const&) = delete;
 	StructurallyDocumentedAnnotation& operator=(StructurallyDocumentedAnnotation&&) = delete;
 
-	virtual ~StructurallyDocumentedAnnotation() = default;
 
 	/// Mapping docstring tag name -> content.
 	std::multimap<std::string, DocTag> docTags;
 	/// contract that @inheritdoc references if it exists
 	ContractDefinition const* inheritdocReference = nullptr;
+
+protected:
+	/// Not virtual, since the annotation is only destroyed as part of an ASTAnnotation.
+	~StructurallyDocumentedAnnotation() = default;
 };
 
 struct SourceUnitAnnotation: ASTAnnotation
@@ -108,7 +111,6 @@ struct ScopableAnnotation
 	ScopableAnnotation& operator=(ScopableAnnotation const&) = delete;
 	ScopableAnnotation& operator=(ScopableAnnotation&&) = delete;
 
-	virtual ~ScopableAnnotation() = default;
 
 	/// The scope this declaration resides in. Can be nullptr if it is the global scope.
 	/// Filled by the Scoper.
@@ -116,6 +118,10 @@ struct ScopableAnnotation
 	/// Pointer to the contract this declaration resides in. Can be nullptr if the current scope
 	/// is not part of a contract. Filled by the Scoper.
 	ContractDefinition const* contract = nullptr;
+
+protected:
+	/// Not virtual, since the annotation is only destroyed as part of an ASTAnnotation.
+	~ScopableAnnotation() = default;
 };
 
 struct DeclarationAnnotation: ASTAnnotation, ScopableAnnotation
@@ -261,8 +267,9 @@ struct ExpressionAnnotation: ASTAnnotation
 	bool lValueOfOrdinaryAssignment = false;
 
 	/// Types and - if given - names of arguments if the expr. is a function
-	/// that is called, used for overload resolution
-	std::optional<FuncCallArguments> arguments;
+	/// that is called, used for overload resolution. Stored out of line, since only
+	/// the few expressions that are called have arguments.
+	std::shared_ptr<FuncCallArguments const> arguments;
 
 	/// True if the expression consists solely of the name of the function and the function is called immediately
 	/// instead of being stored or processed. The name may be qualified with the name of a contract, library
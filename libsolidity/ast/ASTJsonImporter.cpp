@@ -59,10 +59,9 @@ ASTPointer<T> ASTJsonImporter::nullOrCast(Json::Value const& _json)
 
 map<string, ASTPointer<SourceUnit>> ASTJsonImporter::jsonToSourceUnit(map<string, Json::Value> const& _sourceList)
 {
-	m_sourceList = _sourceList;
 	for (auto const& src: _sourceList)
 		m_sourceLocations.emplace_back(make_shared<string const>(src.first));
-	for (auto const& srcPair: m_sourceList)
+	for (auto const& srcPair: _sourceList)
 	{
 		astAssert(!srcPair.second.isNull(), "");
 		astAssert(member(srcPair.second,"nodeType") == "SourceUnit", "The 'nodeType' of the highest node must be 'SourceUnit'.");
@@ -84,7 +83,7 @@ ASTPointer<T> ASTJsonImporter::createASTNode(Json::Value const& _node, Args&&...
 
 	astAssert(m_usedIDs.insert(id).second, "Found duplicate node ID!");
 
-	auto n = make_shared<T>(
+	auto n = make_shared<AnnotatedNode<T>>(
 		id,
 		createSourceLocation(_node),
 		forward<Args>(_args)...
@@ -911,10 +910,10 @@ ASTPointer<StructuredDocumentation> ASTJsonImporter::createDocumentation(Json::V
 
 // ===== helper functions ==========
 
-Json::Value ASTJsonImporter::member(Json::Value const& _node, string const& _name)
+Json::Value const& ASTJsonImporter::member(Json::Value const& _node, string const& _name)
 {
 	if (!_node.isMember(_name))
-		return Json::nullValue;
+		return Json::Value::nullSingleton();
 	return _node[_name];
 }
 
@@ -932,14 +931,14 @@ ASTPointer<ASTString> ASTJsonImporter::nullOrASTString(Json::Value const& _json,
 
 ASTPointer<ASTString> ASTJsonImporter::memberAsASTString(Json::Value const& _node, string const& _name)
 {
-	Json::Value value = member(_node, _name);
+	Json::Value const& value = member(_node, _name);
 	astAssert(value.isString(), "field " + _name + " must be of type string.");
 	return make_shared<ASTString>(_node[_name].asString());
 }
 
 bool ASTJsonImporter::memberAsBool(Json::Value const& _node, string const& _name)
 {
-	Json::Value value = member(_node, _name);
+	Json::Value const& value = member(_node, _name);
 	astAssert(value.isBool(), "field " + _name + " must be of type boolean.");
 	return _node[_name].asBool();
 }
@@ -983,7 +982,7 @@ Token ASTJsonImporter::literalTokenKind(Json::Value const& _node)
 
 Visibility ASTJsonImporter::visibility(Json::Value const& _node)
 {
-	Json::Value visibility = member(_node, "visibility");
+	Json::Value const& visibility = member(_node, "visibility");
 	astAssert(visibility.isString(), "'visibility' expected to be a string.");
 
 	string const visibilityStr = visibility.asString();
@@ -1004,7 +1003,7 @@ Visibility ASTJsonImporter::visibility(Json::Value const& _node)
 
 VariableDeclaration::Location ASTJsonImporter::location(Json::Value const& _node)
 {
-	Json::Value storageLoc = member(_node, "storageLocation");
+	Json::Value const& storageLoc = member(_node, "storageLocation");
 	astAssert(storageLoc.isString(), "'storageLocation' expected to be a string.");
 
 	string const storageLocStr = storageLoc.asString();
@@ -1023,7 +1022,7 @@ VariableDeclaration::Location ASTJsonImporter::location(Json::Value const& _node
 
 Literal::SubDenomination ASTJsonImporter::subdenomination(Json::Value const& _node)
 {
-	Json::Value subDen = member(_node, "subdenomination");
+	Json::Value const& subDen = member(_node, "subdenomination");
 
 	if (subDen.isNull())
 		return Literal::SubDenomination::None;
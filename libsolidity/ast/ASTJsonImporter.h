@@ -125,8 +125,9 @@ private:
 	///@}
 
 	// =============== general helper functions ===================
-	/// @returns the member of a given JSON object, throws if member does not exist
-	Json::Value member(Json::Value const& _node, std::string const& _name);
+	/// @returns the member of a given JSON object, or a null value if the member does not exist.
+	/// The member is returned by reference, so that subtrees are not copied on every level.
+	Json::Value const& member(Json::Value const& _node, std::string const& _name);
 	/// @returns the appropriate TokenObject used in parsed Strings (pragma directive or operator)
 	Token scanSingleToken(Json::Value const& _node);
 	template<class T>
@@ -149,8 +150,6 @@ private:
 	///@}
 
 	// =========== member variables ===============
-	/// Stores filepath as sourcenames to AST in JSON format
-	std::map<std::string, Json::Value> m_sourceList;
 	/// list of filepaths (used as sourcenames)
 	std::vector<std::shared_ptr<std::string const>> m_sourceLocations;
 	/// filepath to AST
@@ -175,6 +175,22 @@ inline void clearCaches(Container& container)
 }
 
 void TypeProvider::reset()
+{
+	clearTypeCaches();
+
+	instance().m_tupleTypes.clear();
+	instance().m_arrayTypes.clear();
+	instance().m_withLocationTypes.clear();
+	instance().m_rationalNumberTypes.clear();
+	instance().m_elementaryFunctionTypes.clear();
+	instance().m_functionTypes.clear();
+	instance().m_generalTypes.clear();
+	instance().m_stringLiteralTypes.clear();
+	instance().m_ufixedMxN.clear();
+	instance().m_fixedMxN.clear();
+}
+
+void TypeProvider::clearTypeCaches()
 {
 	clearCache(m_boolean);
 	clearCache(m_inaccessibleDynamic);
@@ -191,19 +207,38 @@ void TypeProvider::reset()
 	clearCaches(instance().m_bytesM);
 	clearCaches(instance().m_magics);
 
-	instance().m_generalTypes.clear();
-	instance().m_stringLiteralTypes.clear();
-	instance().m_ufixedMxN.clear();
-	instance().m_fixedMxN.clear();
+	for (auto const& type: instance().m_generalTypes)
+		clearCache(type);
+	for (auto const& literalType: instance().m_stringLiteralTypes)
+		clearCache(literalType.second);
+	for (auto const& fixedPointType: instance().m_ufixedMxN)
+		clearCache(fixedPointType.second);
+	for (auto const& fixedPointType: instance().m_fixedMxN)
+		clearCache(fixedPointType.second);
 }
 
 template <typename T, typename... Args>
 inline T const* TypeProvider::createAndGet(Args&& ... _args)
 {
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
 	instance().m_generalTypes.emplace_back(make_unique<T>(std::forward<Args>(_args)...));
 	return static_cast<T const*>(instance().m_generalTypes.back().get());
 }
 
+template <typename T, typename Key, typename... Args>
+inline T const* TypeProvider::createAndGetCached(
+	unordered_map<Key, Type const*, CacheKeyHash>& _cache,
+	Key _key,
+	Args&& ... _args
+)
+{
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
+	auto it = _cache.find(_key);
+	if (it == _cache.end())
+		it = _cache.emplace(move(_key), createAndGet<T>(std::forward<Args>(_args)...)).first;
+	return static_cast<T const*>(it->second);
+}
+
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
 {
 	solAssert(
@@ -306,6 +341,7 @@ TypePointer TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
 	if (!m_bytesStorage)
 		m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
 	return m_bytesStorage.get();
@@ -313,6 +349,7 @@ ArrayType const* TypeProvider::bytesStorage()
 
 ArrayType const* TypeProvider::bytesMemory()
 {
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
 	if (!m_bytesMemory)
 		m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
 	return m_bytesMemory.get();
@@ -320,6 +357,7 @@ ArrayType const* TypeProvider::bytesMemory()
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
 	if (!m_bytesCalldata)
 		m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false);
 	return m_bytesCalldata.get();
@@ -327,6 +365,7 @@ ArrayType const* TypeProvider::bytesCalldata()
 
 ArrayType const* TypeProvider::stringStorage()
 {
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
 	if (!m_stringStorage)
 		m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
 	return m_stringStorage.get();
@@ -334,6 +373,7 @@ ArrayType const* TypeProvider::stringStorage()
 
 ArrayType const* TypeProvider::stringMemory()
 {
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
 	if (!m_stringMemory)
 		m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
 	return m_stringMemory.get();
@@ -378,6 +418,7 @@ RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 
 StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 {
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
 	auto i = instance().m_stringLiteralTypes.find(literal);
 	if (i != instance().m_stringLiteralTypes.end())
 		return i->second.get();
@@ -387,6 +428,7 @@ StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 
 FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPointType::Modifier _modifier)
 {
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
 	auto& map = _modifier == FixedPointType::Modifier::Unsigned ? instance().m_ufixedMxN : instance().m_fixedMxN;
 
 	auto i = map.find(make_pair(m, n));
@@ -404,7 +446,7 @@ TupleType const* TypeProvider::tuple(vector<Type const*> members)
 	if (members.empty())
 		return &m_emptyTuple;
 
-	return createAndGet<TupleType>(move(members));
+	return createAndGetCached<TupleType>(instance().m_tupleTypes, make_tuple(members), members);
 }
 
 ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer)
@@ -412,8 +454,16 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
+	auto& cache = instance().m_withLocationTypes;
+	auto key = make_tuple(_type, _location, _isPointer);
+	auto it = cache.find(key);
+	if (it == cache.end())
+	{
+		instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
+		it = cache.emplace(move(key), instance().m_generalTypes.back().get()).first;
+	}
+	return static_cast<ReferenceType const*>(it->second);
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
@@ -444,7 +494,9 @@ FunctionType const* TypeProvider::function(
 	StateMutability _stateMutability
 )
 {
-	return createAndGet<FunctionType>(
+	return createAndGetCached<FunctionType>(
+		instance().m_elementaryFunctionTypes,
+		make_tuple(_parameterTypes, _returnParameterTypes, _kind, _arbitraryParameters, _stateMutability),
 		_parameterTypes, _returnParameterTypes,
 		_kind, _arbitraryParameters, _stateMutability
 	);
@@ -465,11 +517,26 @@ FunctionType const* TypeProvider::function(
 	bool _saltSet
 )
 {
-	return createAndGet<FunctionType>(
+	return createAndGetCached<FunctionType>(
+		instance().m_functionTypes,
+		make_tuple(
+			_parameterTypes,
+			_returnParameterTypes,
+			_parameterNames,
+			_returnParameterNames,
+			_kind,
+			_arbitraryParameters,
+			_stateMutability,
+			_declaration,
+			_gasSet,
+			_valueSet,
+			_bound,
+			_saltSet
+		),
 		_parameterTypes,
 		_returnParameterTypes,
-		_parameterNames,
-		_returnParameterNames,
+		move(_parameterNames),
+		move(_returnParameterNames),
 		_kind,
 		_arbitraryParameters,
 		_stateMutability,
@@ -483,7 +550,12 @@ FunctionType const* TypeProvider::function(
 
 RationalNumberType const* TypeProvider::rationalNumber(rational const& _value, Type const* _compatibleBytesType)
 {
-	return createAndGet<RationalNumberType>(_value, _compatibleBytesType);
+	return createAndGetCached<RationalNumberType>(
+		instance().m_rationalNumberTypes,
+		make_tuple(_value, _compatibleBytesType),
+		_value,
+		_compatibleBytesType
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
@@ -502,17 +574,33 @@ ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
 		if (_location == DataLocation::Memory)
 			return bytesMemory();
 	}
-	return createAndGet<ArrayType>(_location, _isString);
+	return createAndGetCached<ArrayType>(
+		instance().m_arrayTypes,
+		make_tuple(_location, _isString, static_cast<Type const*>(nullptr), false, u256(0)),
+		_location,
+		_isString
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType)
 {
-	return createAndGet<ArrayType>(_location, _baseType);
+	return createAndGetCached<ArrayType>(
+		instance().m_arrayTypes,
+		make_tuple(_location, false, _baseType, false, u256(0)),
+		_location,
+		_baseType
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType, u256 const& _length)
 {
-	return createAndGet<ArrayType>(_location, _baseType, _length);
+	return createAndGetCached<ArrayType>(
+		instance().m_arrayTypes,
+		make_tuple(_location, false, _baseType, true, _length),
+		_location,
+		_baseType,
+		_length
+	);
 }
 
 ArraySliceType const* TypeProvider::arraySlice(ArrayType const& _arrayType)
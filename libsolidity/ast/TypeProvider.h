@@ -20,10 +20,16 @@
 
 #include <libsolidity/ast/Types.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <array>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 
 namespace solidity::frontend
@@ -52,6 +58,11 @@ public:
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
 	static void reset();
 
+	/// Clears the member caches of all types provided by this TypeProvider without
+	/// destroying the types themselves, so that pointers to them stay valid.
+	/// Required before AST nodes that might be referenced from these caches are destroyed.
+	static void clearTypeCaches();
+
 	/// @name Factory functions
 	/// Factory functions that convert an AST @ref TypeName to a Type.
 	static Type const* fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability = {});
@@ -210,6 +221,50 @@ private:
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
+	/// Hash function for the keys of the caches of types that are fully determined by the
+	/// arguments they are created from.
+	struct CacheKeyHash
+	{
+		template <typename... Parts>
+		size_t operator()(std::tuple<Parts...> const& _key) const
+		{
+			size_t seed = 0;
+			std::apply([&](auto const&... _parts) { (combine(seed, _parts), ...); }, _key);
+			return seed;
+		}
+
+	private:
+		template <typename T>
+		static void combine(size_t& _seed, T const& _value)
+		{
+			if constexpr (std::is_enum_v<T>)
+				boost::hash_combine(_seed, static_cast<std::underlying_type_t<T>>(_value));
+			else
+				boost::hash_combine(_seed, _value);
+		}
+		static void combine(size_t& _seed, u256 const& _value)
+		{
+			boost::hash_combine(_seed, static_cast<size_t>(_value & std::numeric_limits<size_t>::max()));
+		}
+		static void combine(size_t& _seed, rational const& _value)
+		{
+			boost::hash_combine(_seed, _value < 0);
+			boost::hash_combine(_seed, static_cast<size_t>(abs(_value.numerator()) & std::numeric_limits<size_t>::max()));
+			boost::hash_combine(_seed, static_cast<size_t>(_value.denominator() & std::numeric_limits<size_t>::max()));
+		}
+	};
+	template <typename... KeyParts>
+	using TypeCache = std::unordered_map<std::tuple<KeyParts...>, Type const*, CacheKeyHash>;
+
+	/// @returns the type created from @a _args the first time it is requested with @a _key
+	/// and the same type for all later requests with an equal key.
+	template <typename T, typename Key, typename... Args>
+	static inline T const* createAndGetCached(
+		std::unordered_map<Key, Type const*, CacheKeyHash>& _cache,
+		Key _key,
+		Args&& ... _args
+	);
+
 	static BoolType const m_boolean;
 	static InaccessibleDynamicType const m_inaccessibleDynamic;
 
@@ -230,8 +285,20 @@ private:
 
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
-	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
+	std::unordered_map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+
+	/// Caches of types contained in m_generalTypes.
+	TypeCache<std::vector<Type const*>> m_tupleTypes{};
+	/// Key: location, isString, base type, whether the array has a fixed length, length.
+	TypeCache<DataLocation, bool, Type const*, bool, u256> m_arrayTypes{};
+	TypeCache<ReferenceType const*, DataLocation, bool> m_withLocationTypes{};
+	TypeCache<rational, Type const*> m_rationalNumberTypes{};
+	TypeCache<strings, strings, FunctionType::Kind, bool, StateMutability> m_elementaryFunctionTypes{};
+	TypeCache<
+		TypePointers, TypePointers, strings, strings, FunctionType::Kind, bool, StateMutability,
+		Declaration const*, bool, bool, bool, bool
+	> m_functionTypes{};
 };
 
 }
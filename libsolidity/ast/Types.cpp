@@ -111,6 +111,12 @@ util::Result<TypePointers> transformParametersToExternal(TypePointers const& _pa
 
 }
 
+recursive_mutex& Type::cacheMutex()
+{
+	static recursive_mutex typeCacheMutex;
+	return typeCacheMutex;
+}
+
 void Type::clearCache() const
 {
 	m_members.clear();
@@ -181,6 +187,7 @@ u256 const& MemberList::storageSize() const
 }
 
 StorageOffsets const& MemberList::storageOffsets() const {
+	lock_guard<recursive_mutex> lock(Type::cacheMutex());
 	return m_storageOffsets.init([&]{
 		TypePointers memberTypes;
 		memberTypes.reserve(m_memberTypes.size());
@@ -250,15 +257,20 @@ string Type::escapeIdentifier(string const& _identifier)
 	return ret;
 }
 
-string Type::identifier() const
+string const& Type::identifier() const
 {
-	string ret = escapeIdentifier(richIdentifier());
-	solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
-	solAssert(
-		ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
-		"Identifier contains invalid characters."
-	);
-	return ret;
+	lock_guard<recursive_mutex> lock(cacheMutex());
+	if (!m_identifier)
+	{
+		string ret = escapeIdentifier(richIdentifier());
+		solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
+		solAssert(
+			ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
+			"Identifier contains invalid characters."
+		);
+		m_identifier = move(ret);
+	}
+	return *m_identifier;
 }
 
 TypePointer Type::commonType(Type const* _a, Type const* _b)
@@ -275,6 +287,7 @@ TypePointer Type::commonType(Type const* _a, Type const* _b)
 
 MemberList const& Type::members(ASTNode const* _currentScope) const
 {
+	lock_guard<recursive_mutex> lock(cacheMutex());
 	if (!m_members[_currentScope])
 	{
 		solAssert(
@@ -282,12 +295,30 @@ MemberList const& Type::members(ASTNode const* _currentScope) const
 			dynamic_cast<SourceUnit const*>(_currentScope) ||
 			dynamic_cast<ContractDefinition const*>(_currentScope),
 		"");
-		MemberList::MemberMap members = nativeMembers(_currentScope);
-		if (_currentScope)
-			members += boundFunctions(*this, *_currentScope);
-		m_members[_currentScope] = make_unique<MemberList>(move(members));
+		if (!_currentScope || nativeMembersDependOnScope())
+		{
+			MemberList::MemberMap members = nativeMembers(_currentScope);
+			if (_currentScope)
+				members += boundFunctions(*this, *_currentScope);
+			m_members[_currentScope] = make_shared<MemberList>(move(members));
+		}
+		else
+		{
+			// Compute the native members only once and share them with all scopes
+			// in which no functions are bound to this type.
+			MemberList const& scopeIndependentMembers = members(nullptr);
+			MemberList::MemberMap boundMembers = boundFunctions(*this, *_currentScope);
+			if (boundMembers.empty())
+				m_members[_currentScope] = m_members.at(nullptr);
+			else
+			{
+				MemberList::MemberMap allMembers(scopeIndependentMembers.begin(), scopeIndependentMembers.end());
+				allMembers += move(boundMembers);
+				m_members[_currentScope] = make_shared<MemberList>(move(allMembers));
+			}
+		}
 	}
-	return *m_members[_currentScope];
+	return *m_members.at(_currentScope);
 }
 
 TypePointer Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) const
@@ -329,13 +360,17 @@ MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _sc
 	else
 		solAssert(false, "");
 
+	MemberList::MemberMap members;
+	if (usingForDirectives.empty())
+		return members;
+
 	// Normalise data location of type.
 	DataLocation typeLocation = DataLocation::Storage;
 	if (auto refType = dynamic_cast<ReferenceType const*>(&_type))
 		typeLocation = refType->location();
+	Type const* normalisedType = TypeProvider::withLocationIfReference(typeLocation, &_type, true);
 
 	set<Declaration const*> seenFunctions;
-	MemberList::MemberMap members;
 
 	for (UsingForDirective const* ufd: usingForDirectives)
 	{
@@ -344,7 +379,7 @@ MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _sc
 		// Further down, we check more detailed for each function if `_type` is
 		// convertible to the function parameter type.
 		if (ufd->typeName() &&
-			*TypeProvider::withLocationIfReference(typeLocation, &_type, true) !=
+			*normalisedType !=
 			*TypeProvider::withLocationIfReference(
 				typeLocation,
 				ufd->typeName()->annotation().type,
@@ -1023,7 +1058,25 @@ TypeResult RationalNumberType::binaryOperatorResult(Token _operator, Type const*
 			return nullptr;
 		return thisMobile->binaryOperatorResult(_operator, otherMobile);
 	}
-	else if (optional<rational> value = ConstantEvaluator::evaluateBinaryOperator(_operator, m_value, other.m_value))
+
+	lock_guard<recursive_mutex> lock(cacheMutex());
+	auto key = make_pair(_operator, _other);
+	auto it = m_foldedResults.find(key);
+	if (it == m_foldedResults.end())
+		it = m_foldedResults.emplace(key, foldBinaryOperator(_operator, other)).first;
+	return it->second;
+}
+
+void RationalNumberType::clearCache() const
+{
+	Type::clearCache();
+
+	m_foldedResults.clear();
+}
+
+TypeResult RationalNumberType::foldBinaryOperator(Token _operator, RationalNumberType const& _other) const
+{
+	if (optional<rational> value = ConstantEvaluator::evaluateBinaryOperator(_operator, m_value, _other.m_value))
 	{
 		// verify that numerator and denominator fit into 4096 bit after every operation
 		if (value->numerator() != 0 && max(boost::multiprecision::msb(abs(value->numerator())), boost::multiprecision::msb(abs(value->denominator()))) > 4096)
@@ -1839,6 +1892,7 @@ TypePointer ArrayType::decodingType() const
 
 TypeResult ArrayType::interfaceType(bool _inLibrary) const
 {
+	lock_guard<recursive_mutex> lock(cacheMutex());
 	if (_inLibrary && m_interfaceType_library.has_value())
 		return *m_interfaceType_library;
 
@@ -1995,6 +2049,7 @@ MemberList::MemberMap ContractType::nativeMembers(ASTNode const*) const
 
 FunctionType const* ContractType::newExpressionType() const
 {
+	lock_guard<recursive_mutex> lock(cacheMutex());
 	if (!m_constructorType)
 		m_constructorType = FunctionType::newExpressionType(m_contract);
 	return m_constructorType;
@@ -2223,6 +2278,7 @@ MemberList::MemberMap StructType::nativeMembers(ASTNode const*) const
 
 TypeResult StructType::interfaceType(bool _inLibrary) const
 {
+	lock_guard<recursive_mutex> lock(cacheMutex());
 	if (!_inLibrary)
 	{
 		if (!m_interfaceType.has_value())
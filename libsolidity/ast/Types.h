@@ -37,11 +37,17 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
 #include <utility>
 
+namespace solidity::smtutil
+{
+struct Sort;
+}
+
 namespace solidity::frontend
 {
 
@@ -188,7 +194,8 @@ public:
 	/// only if they have the same identifier.
 	/// The identifier should start with "t_".
 	/// Will not contain any character which would be invalid as an identifier.
-	std::string identifier() const;
+	/// The identifier is computed on the first call and cached.
+	std::string const& identifier() const;
 
 	/// More complex identifier strings use "parentheses", where $_ is interpreted as
 	/// "opening parenthesis", _$ as "closing parenthesis", _$_ as "comma" and any $ that
@@ -289,6 +296,7 @@ public:
 	/// - Each named stack item is typed and contributes the stack slots given by the stack items of its type.
 	std::vector<std::tuple<std::string, TypePointer>> const& stackItems() const
 	{
+		std::lock_guard<std::recursive_mutex> lock(cacheMutex());
 		if (!m_stackItems)
 			m_stackItems = makeStackItems();
 		return *m_stackItems;
@@ -297,6 +305,7 @@ public:
 	// TODO: consider changing the return type to be size_t
 	unsigned sizeOnStack() const
 	{
+		std::lock_guard<std::recursive_mutex> lock(cacheMutex());
 		if (!m_stackSize)
 		{
 			size_t sizeOnStack = 0;
@@ -374,6 +383,14 @@ public:
 	/// Clears all internally cached values (if any).
 	virtual void clearCache() const;
 
+	/// Mutex protecting the lazily computed caches of all types and the type storage of the
+	/// TypeProvider, which can be accessed by several threads during parallel code generation.
+	static std::recursive_mutex& cacheMutex();
+
+	/// @returns the sort of this type in the SMT encoding as computed by smt::smtSort,
+	/// or an empty pointer if it was not computed yet. Has to be accessed while holding cacheMutex().
+	std::shared_ptr<smtutil::Sort>& smtSortCache() const { return m_smtSort; }
+
 private:
 	/// @returns a member list containing all members added to this type by `using for` directives.
 	static MemberList::MemberMap boundFunctions(Type const& _type, ASTNode const& _scope);
@@ -385,6 +402,8 @@ protected:
 	{
 		return MemberList::MemberMap();
 	}
+	/// @returns true if nativeMembers() returns different members for different scopes.
+	virtual bool nativeMembersDependOnScope() const { return false; }
 	/// Generates the stack items to be returned by ``stackItems()``. Defaults
 	/// to exactly one unnamed and untyped stack item referring to a single stack slot.
 	virtual std::vector<std::tuple<std::string, TypePointer>> makeStackItems() const
@@ -393,10 +412,15 @@ protected:
 	}
 
 
-	/// List of member types (parameterised by scape), will be lazy-initialized.
-	mutable std::map<ASTNode const*, std::unique_ptr<MemberList>> m_members;
+	/// List of member types (parameterised by scope), will be lazy-initialized.
+	/// Scopes without bound functions share the list stored for the scope nullptr,
+	/// unless the native members depend on the scope.
+	mutable std::map<ASTNode const*, std::shared_ptr<MemberList const>> m_members;
 	mutable std::optional<std::vector<std::tuple<std::string, TypePointer>>> m_stackItems;
 	mutable std::optional<size_t> m_stackSize;
+	/// Not reset by clearCache(), since it only depends on the type itself.
+	mutable std::optional<std::string> m_identifier;
+	mutable std::shared_ptr<smtutil::Sort> m_smtSort;
 };
 
 /**
@@ -593,13 +617,22 @@ public:
 	/// @returns true if the literal is a valid integer.
 	static std::tuple<bool, rational> isValidLiteral(Literal const& _literal);
 
+	void clearCache() const override;
+
 private:
+	/// @returns the result of applying @a _operator to this and @a _other with arbitrary precision.
+	TypeResult foldBinaryOperator(Token _operator, RationalNumberType const& _other) const;
+
 	rational m_value;
 
 	/// Bytes type to which the rational can be explicitly converted.
 	/// Empty for all rationals that are not directly parsed from hex literals.
 	TypePointer m_compatibleBytesType;
 
+	/// Results of foldBinaryOperator. Since there is one type per value, the other operand
+	/// is identified by its address.
+	mutable std::map<std::pair<Token, Type const*>, TypeResult> m_foldedResults;
+
 	/// @returns true if the literal is a valid rational number.
 	static std::tuple<bool, rational> parseRational(std::string const& _value);
 
@@ -1272,6 +1305,7 @@ public:
 	bool nameable() const override;
 	bool hasSimpleZeroValueInMemory() const override { return false; }
 	MemberList::MemberMap nativeMembers(ASTNode const* _currentScope) const override;
+	bool nativeMembersDependOnScope() const override { return m_kind == Kind::Internal; }
 	TypePointer encodingType() const override;
 	TypeResult interfaceType(bool _inLibrary) const override;
 	TypePointer mobileType() const override;
@@ -1446,6 +1480,7 @@ public:
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
 	std::string toString(bool _short) const override { return "type(" + m_actualType->toString(_short) + ")"; }
 	MemberList::MemberMap nativeMembers(ASTNode const* _currentScope) const override;
+	bool nativeMembersDependOnScope() const override { return m_actualType->category() == Category::Contract; }
 
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 protected:
@@ -1170,6 +1170,16 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 		_type.identifier() +
 		(_fromMemory ? "_fromMemory" : "");
 
+	// Elements of these types are encoded in calldata exactly as they are stored in memory
+	// and there is nothing to validate, so they can be copied in a single step.
+	Type const& baseType = *_type.baseType();
+	bool bulkCopy =
+		!_fromMemory &&
+		(
+			(baseType.category() == Type::Category::Integer && dynamic_cast<IntegerType const&>(baseType).numBits() == 256) ||
+			(baseType.category() == Type::Category::FixedBytes && dynamic_cast<FixedBytesType const&>(baseType).numBytes() == 32)
+		);
+
 	return createFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			// <readableTypeName>
@@ -1179,16 +1189,21 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 				<storeLength>
 				let src := offset
 				<staticBoundsCheck>
-				for { let i := 0 } lt(i, length) { i := add(i, 1) }
-				{
-					let elementPos := <retrieveElementPos>
-					mstore(dst, <decodingFun>(elementPos, end))
-					dst := add(dst, 0x20)
-					src := add(src, <stride>)
-				}
+				<?bulkCopy>
+					calldatacopy(dst, src, mul(length, 0x20))
+				<!bulkCopy>
+					for { let i := 0 } lt(i, length) { i := add(i, 1) }
+					{
+						let elementPos := <retrieveElementPos>
+						mstore(dst, <decodingFun>(elementPos, end))
+						dst := add(dst, 0x20)
+						src := add(src, <stride>)
+					}
+				</bulkCopy>
 			}
 		)");
 		templ("functionName", functionName);
+		templ("bulkCopy", bulkCopy);
 		templ("readableTypeName", _type.toString(true));
 		templ("allocate", m_utils.allocationFunction());
 		templ("allocationSize", m_utils.arrayAllocationSizeFunction(_type));
@@ -1214,7 +1229,8 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 			);
 			templ("retrieveElementPos", "src");
 		}
-		templ("decodingFun", abiDecodingFunction(*_type.baseType(), _fromMemory, false));
+		if (!bulkCopy)
+			templ("decodingFun", abiDecodingFunction(*_type.baseType(), _fromMemory, false));
 		return templ.render();
 	});
 }
@@ -1531,7 +1547,7 @@ string ABIFunctions::arrayStoreLengthForEncodingFunction(ArrayType const& _type,
 
 string ABIFunctions::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	return m_functionCollector.createFunction(_name, _creator);
+	return m_functionCollector.createSharedFunction(_name, _creator);
 }
 
 size_t ABIFunctions::headSize(TypePointers const& _targetTypes)
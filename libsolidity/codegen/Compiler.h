@@ -36,11 +36,20 @@ namespace solidity::frontend {
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<MultiUseYulFunctionCache> _yulFunctionCache = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
-		m_runtimeContext(_evmVersion, _revertStrings),
-		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
-	{ }
+		m_runtimeContext(_evmVersion, _revertStrings, nullptr, _yulFunctionCache),
+		m_context(_evmVersion, _revertStrings, &m_runtimeContext, _yulFunctionCache)
+	{
+		// The creation code can call functions of the runtime code.
+		m_runtimeContext.setUseSubroutines(m_optimiserSettings.useSubroutines);
+		m_context.setUseSubroutines(m_optimiserSettings.useSubroutines);
+	}
 
 	/// Compiles a contract.
 	/// @arg _metadata contains the to be injected metadata CBOR
@@ -61,6 +70,12 @@ public:
 	std::string generatedYulUtilityCode() const { return m_context.generatedYulUtilityCode(); }
 	std::string runtimeGeneratedYulUtilityCode() const { return m_runtimeContext.generatedYulUtilityCode(); }
 
+	/// @returns true if the work budget of the optimiser was exhausted while compiling the contract.
+	bool optimisationIncomplete() const
+	{
+		return m_context.optimisationIncomplete() || m_runtimeContext.optimisationIncomplete();
+	}
+
 	/// @returns the entry label of the given function. Might return an AssemblyItem of type
 	/// UndefinedItem if it does not exist yet.
 	evmasm::AssemblyItem functionEntryLabel(FunctionDefinition const& _function) const;
@@ -116,10 +116,22 @@ size_t CompilerContext::reservedMemory()
 	return reservedMemory;
 }
 
+bool CompilerContext::isSubroutine(Declaration const& _function) const
+{
+	if (!useSubroutines())
+		return false;
+	if (auto function = dynamic_cast<FunctionDefinition const*>(&_function))
+		return !function->isConstructor() && !function->isFallback() && !function->isReceive();
+	return true;
+}
+
 void CompilerContext::startFunction(Declaration const& _function)
 {
 	m_functionCompilationQueue.startFunction(_function);
-	*this << functionEntryLabel(_function);
+	evmasm::AssemblyItem entryLabel = functionEntryLabel(_function);
+	if (isSubroutine(_function))
+		entryLabel.markAsSubroutineEntry();
+	*this << entryLabel;
 }
 
 void CompilerContext::callLowLevelFunction(
@@ -129,6 +141,14 @@ void CompilerContext::callLowLevelFunction(
 	function<void(CompilerContext&)> const& _generator
 )
 {
+	if (useSubroutines())
+	{
+		*this << lowLevelFunctionTag(_name, _inArgs, _outArgs, _generator);
+		appendJumpsub();
+		adjustStackOffset(static_cast<int>(_outArgs) - static_cast<int>(_inArgs));
+		return;
+	}
+
 	evmasm::AssemblyItem retTag = pushNewTag();
 	CompilerUtils(*this).moveIntoStack(_inArgs);
 
@@ -146,6 +166,14 @@ void CompilerContext::callYulFunction(
 )
 {
 	m_externallyUsedYulFunctions.insert(_name);
+	if (useSubroutines())
+	{
+		*this << namedTag(_name).pushTag();
+		appendJumpsub();
+		adjustStackOffset(static_cast<int>(_outArgs) - static_cast<int>(_inArgs));
+		return;
+	}
+
 	auto const retTag = pushNewTag();
 	CompilerUtils(*this).moveIntoStack(_inArgs);
 	appendJumpTo(namedTag(_name), evmasm::AssemblyItem::JumpType::IntoFunction);
@@ -183,11 +211,23 @@ void CompilerContext::appendMissingLowLevelFunctions()
 		tie(name, inArgs, outArgs, generator) = m_lowLevelFunctionGenerationQueue.front();
 		m_lowLevelFunctionGenerationQueue.pop();
 
-		setStackOffset(static_cast<int>(inArgs) + 1);
-		*this << m_lowLevelFunctions.at(name).tag();
-		generator(*this);
-		CompilerUtils(*this).moveToStackTop(outArgs);
-		appendJump(evmasm::AssemblyItem::JumpType::OutOfFunction);
+		evmasm::AssemblyItem entryLabel = m_lowLevelFunctions.at(name).tag();
+		if (useSubroutines())
+		{
+			setStackOffset(static_cast<int>(inArgs));
+			entryLabel.markAsSubroutineEntry();
+			*this << entryLabel;
+			generator(*this);
+			appendReturnsub();
+		}
+		else
+		{
+			setStackOffset(static_cast<int>(inArgs) + 1);
+			*this << entryLabel;
+			generator(*this);
+			CompilerUtils(*this).moveToStackTop(outArgs);
+			appendJump(evmasm::AssemblyItem::JumpType::OutOfFunction);
+		}
 		solAssert(stackHeight() == outArgs, "Invalid stack height in low-level function " + name + ".");
 	}
 }
@@ -332,6 +372,20 @@ CompilerContext& CompilerContext::appendJump(evmasm::AssemblyItem::JumpType _jum
 	return *this << item;
 }
 
+CompilerContext& CompilerContext::appendJumpsub()
+{
+	evmasm::AssemblyItem item(Instruction::JUMPSUB);
+	item.setJumpType(evmasm::AssemblyItem::JumpType::IntoFunction);
+	return *this << item;
+}
+
+CompilerContext& CompilerContext::appendReturnsub()
+{
+	evmasm::AssemblyItem item(Instruction::RETURNSUB);
+	item.setJumpType(evmasm::AssemblyItem::JumpType::OutOfFunction);
+	return *this << item;
+}
+
 CompilerContext& CompilerContext::appendPanic(util::PanicCode _code)
 {
 	Whiskers templ(R"({
@@ -526,7 +580,8 @@ void CompilerContext::appendInlineAssembly(
 		m_evmVersion,
 		identifierAccess,
 		_system,
-		_optimiserSettings.optimizeStackAllocation
+		_optimiserSettings.optimizeStackAllocation,
+		useSubroutines()
 	);
 
 	// Reset the source location to the one of the node (instead of the CODEGEN source location)
@@ -542,14 +597,20 @@ void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _
 
 	bool const isCreation = runtimeContext() != nullptr;
 	yul::GasMeter meter(_dialect, isCreation, _optimiserSettings.expectedExecutionsPerDeployment);
-	yul::OptimiserSuite::run(
+	bool const completed = yul::OptimiserSuite::run(
 		_dialect,
 		&meter,
 		_object,
 		_optimiserSettings.optimizeStackAllocation,
 		_optimiserSettings.yulOptimiserSteps,
-		_externalIdentifiers
+		_externalIdentifiers,
+		1,
+		_optimiserSettings.yulOptimiserGasCosts,
+		_optimiserSettings.reasoningMaxQueries,
+		_optimiserSettings.workBudget
 	);
+	if (!completed)
+		m_yulOptimisationIncomplete = true;
 
 #ifdef SOL_OUTPUT_ASM
 	cout << "After optimizer:" << endl;
@@ -570,14 +631,18 @@ void CompilerContext::updateSourceLocation()
 evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, false, false, false, m_evmVersion, 0, 1, nullopt};
 	asmSettings.isCreation = true;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
+	asmSettings.runBlockReorderer = _settings.runBlockReorderer;
 	asmSettings.runCSE = _settings.runCSE;
+	asmSettings.runCSEAcrossBlocks = _settings.runCSEAcrossBlocks;
+	asmSettings.runOutliner = _settings.runOutliner;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
+	asmSettings.workBudget = _settings.workBudget;
 	asmSettings.evmVersion = m_evmVersion;
 	return asmSettings;
 }
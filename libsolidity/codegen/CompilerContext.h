@@ -61,13 +61,15 @@ public:
 	explicit CompilerContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		CompilerContext* _runtimeContext = nullptr
+		CompilerContext* _runtimeContext = nullptr,
+		std::shared_ptr<MultiUseYulFunctionCache> _yulFunctionCache = nullptr
 	):
 		m_asm(std::make_shared<evmasm::Assembly>()),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_reservedMemory{0},
 		m_runtimeContext(_runtimeContext),
+		m_yulFunctionCollector(std::move(_yulFunctionCache)),
 		m_abiFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector),
 		m_yulUtilFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector)
 	{
@@ -76,6 +78,13 @@ public:
 	}
 
 	langutil::EVMVersion const& evmVersion() const { return m_evmVersion; }
+	void setUseSubroutines(bool _value) { m_useSubroutines = _value; }
+	/// @returns true if internal functions are compiled to subroutines (EIP-2315), which are
+	/// called via JUMPSUB and do not keep their return address on the stack.
+	bool useSubroutines() const { return m_useSubroutines && m_evmVersion.hasSubroutines(); }
+	/// @returns true if @a _function is compiled to a subroutine. Constructors, fallback and
+	/// receive functions are never called internally and are not compiled to subroutines.
+	bool isSubroutine(Declaration const& _function) const;
 
 	void setUseABICoderV2(bool _value) { m_useABICoderV2 = _value; }
 	bool useABICoderV2() const { return m_useABICoderV2; }
@@ -193,6 +202,10 @@ public:
 	evmasm::AssemblyItem appendJumpToNew() { return m_asm->appendJump().tag(); }
 	/// Appends a JUMP to a tag already on the stack
 	CompilerContext& appendJump(evmasm::AssemblyItem::JumpType _jumpType = evmasm::AssemblyItem::JumpType::Ordinary);
+	/// Appends a JUMPSUB to a subroutine whose tag is already on the stack
+	CompilerContext& appendJumpsub();
+	/// Appends a RETURNSUB out of the current subroutine
+	CompilerContext& appendReturnsub();
 	/// Appends code to revert with a Panic(uint256) error.
 	CompilerContext& appendPanic(util::PanicCode _code);
 	/// Appends code to revert with a Panic(uint256) error if the topmost stack element is nonzero.
@@ -279,6 +292,9 @@ public:
 
 	/// Run optimisation step.
 	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// @returns true if the work budget of the optimiser was exhausted for any Yul code
+	/// optimised in this context or for the assembly.
+	bool optimisationIncomplete() const { return m_yulOptimisationIncomplete || m_asm->optimisationIncomplete(); }
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -348,6 +364,8 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	RevertStrings const m_revertStrings;
 	bool m_useABICoderV2 = false;
+	/// Whether subroutines were requested, see useSubroutines().
+	bool m_useSubroutines = false;
 	/// Other already compiled contracts to be used in contract creation calls.
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> m_otherCompilers;
 	/// Storage offsets of state variables
@@ -390,6 +408,8 @@ private:
 	std::queue<std::tuple<std::string, unsigned, unsigned, std::function<void(CompilerContext&)>>> m_lowLevelFunctionGenerationQueue;
 	/// Flag to check that appendYulUtilityFunctions() was called exactly once
 	bool m_appendYulUtilityFunctionsRan = false;
+	/// Flag set by optimizeYul() if the work budget of the Yul optimiser was exhausted.
+	bool m_yulOptimisationIncomplete = false;
 };
 
 }
@@ -29,6 +29,7 @@
 #include <libsolidity/codegen/ArrayUtils.h>
 #include <libsolidity/codegen/LValue.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libevmasm/GasMeter.h>
 #include <libevmasm/Instruction.h>
 #include <libsolutil/Whiskers.h>
 
@@ -1413,6 +1414,40 @@ unsigned CompilerUtils::sizeOnStack(vector<Type const*> const& _variableTypes)
 	return size;
 }
 
+bool CompilerUtils::splitSelector(size_t _cases, size_t _runs)
+{
+	// Code for selecting from n values without split:
+	//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
+	//   push2/3 <notfound> jump
+	// (called SELECT[n])
+	// Code for selecting from n values with split:
+	//   dup1, push4 <pivot>, gt, push2/3<tag_less>, jumpi
+	//     SELECT[n/2]
+	//   tag_less:
+	//     SELECT[n/2]
+	//
+	// This means each split adds 16-18 bytes of additional code (note the additional jump out!)
+	// The average execution cost if we do not split at all are:
+	//   (3 + 3 + 3 + 3 + 10) * n/2 = 24 * n/2 = 12 * n
+	// If we split once:
+	//    (3 + 3 + 3 + 3 + 10) + 24 * n/4 = 24 * (n/4 + 1) = 6 * n + 24;
+	//
+	// We should split if
+	//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
+	// <=> _runs * 6 * (n - 4) > 17 * createDataGas
+	//
+	// Which also means that the execution itself is not profitable
+	// unless we have at least 5 values.
+
+	// Start with some comparisons to avoid overflow, then do the actual comparison.
+	if (_cases <= 4)
+		return false;
+	else if (_runs > (17 * evmasm::GasCosts::createDataGas) / 6)
+		return true;
+	else
+		return _runs * 6 * (_cases - 4) > 17 * evmasm::GasCosts::createDataGas;
+}
+
 void CompilerUtils::computeHashStatic()
 {
 	storeInMemory(0);
@@ -276,6 +276,12 @@ public:
 	static unsigned sizeOnStack(std::vector<T> const& _variables);
 	static unsigned sizeOnStack(std::vector<Type const*> const& _variableTypes);
 
+	/// @returns true if selecting among @a _cases values by comparing them one after the other
+	/// should be split into a binary search, which costs more code but less gas per execution,
+	/// assuming @a _runs executions per deployment. Used by the function dispatch of both
+	/// code generators.
+	static bool splitSelector(size_t _cases, size_t _runs);
+
 	/// Helper function to shift top value on the stack to the left.
 	/// Stack pre: <value> <shift_by_bits>
 	/// Stack post: <shifted_value>
@@ -66,6 +66,33 @@ using solidity::util::errinfo_comment;
 namespace
 {
 
+/**
+ * Collects the properties of the body of a modifier that determine whether the code before
+ * and after its placeholder can be compiled as separate routines.
+ */
+class ModifierBodyInspector: private ASTConstVisitor
+{
+public:
+	explicit ModifierBodyInspector(Block const& _body) { _body.accept(*this); }
+
+	size_t nodes = 0;
+	size_t placeholders = 0;
+	bool hasReturn = false;
+
+private:
+	bool visitNode(ASTNode const&) override { ++nodes; return true; }
+	bool visit(PlaceholderStatement const& _placeholder) override
+	{
+		++placeholders;
+		return visitNode(_placeholder);
+	}
+	bool visit(Return const& _return) override
+	{
+		hasReturn = true;
+		return visitNode(_return);
+	}
+};
+
 /**
  * Simple helper class to ensure that the stack height is the same at certain places in the code.
  */
@@ -322,39 +349,7 @@ void ContractCompiler::appendInternalSelector(
 	size_t _runs
 )
 {
-	// Code for selecting from n functions without split:
-	//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
-	//   push2/3 <notfound> jump
-	// (called SELECT[n])
-	// Code for selecting from n functions with split:
-	//   dup1, push4 <pivot>, gt, push2/3<tag_less>, jumpi
-	//     SELECT[n/2]
-	//   tag_less:
-	//     SELECT[n/2]
-	//
-	// This means each split adds 16-18 bytes of additional code (note the additional jump out!)
-	// The average execution cost if we do not split at all are:
-	//   (3 + 3 + 3 + 3 + 10) * n/2 = 24 * n/2 = 12 * n
-	// If we split once:
-	//    (3 + 3 + 3 + 3 + 10) + 24 * n/4 = 24 * (n/4 + 1) = 6 * n + 24;
-	//
-	// We should split if
-	//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
-	// <=> _runs * 6 * (n - 4) > 17 * createDataGas
-	//
-	// Which also means that the execution itself is not profitable
-	// unless we have at least 5 functions.
-
-	// Start with some comparisons to avoid overflow, then do the actual comparison.
-	bool split = false;
-	if (_ids.size() <= 4)
-		split = false;
-	else if (_runs > (17 * evmasm::GasCosts::createDataGas) / 6)
-		split = true;
-	else
-		split = (_runs * 6 * (_ids.size() - 4) > 17 * evmasm::GasCosts::createDataGas);
-
-	if (split)
+	if (CompilerUtils::splitSelector(_ids.size(), _runs))
 	{
 		size_t pivotIndex = _ids.size() / 2;
 		FixedHash<4> pivot{_ids.at(pivotIndex)};
@@ -520,8 +515,11 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 		if (!functionType->isPayable() && !_contract.isLibrary() && needToAddCallvalueCheck)
 			appendCallValueCheck();
 
+		bool const isSubroutine = m_context.isSubroutine(functionType->declaration());
 		// Return tag is used to jump out of the function.
-		evmasm::AssemblyItem returnTag = m_context.pushNewTag();
+		optional<evmasm::AssemblyItem> returnTag;
+		if (!isSubroutine)
+			returnTag = m_context.pushNewTag();
 		if (!functionType->parameterTypes().empty())
 		{
 			// Parameter for calldataUnpacker
@@ -529,16 +527,24 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 			m_context << Instruction::DUP1 << Instruction::CALLDATASIZE << Instruction::SUB;
 			CompilerUtils(m_context).abiDecode(functionType->parameterTypes());
 		}
-		m_context.appendJumpTo(
-			m_context.functionEntryLabel(functionType->declaration()),
-			evmasm::AssemblyItem::JumpType::IntoFunction
-		);
-		m_context << returnTag;
+		if (isSubroutine)
+		{
+			m_context << m_context.functionEntryLabel(functionType->declaration()).pushTag();
+			m_context.appendJumpsub();
+		}
+		else
+		{
+			m_context.appendJumpTo(
+				m_context.functionEntryLabel(functionType->declaration()),
+				evmasm::AssemblyItem::JumpType::IntoFunction
+			);
+			m_context << *returnTag;
+		}
 		// Return tag and input parameters get consumed.
 		m_context.adjustStackOffset(
 			static_cast<int>(CompilerUtils::sizeOnStack(functionType->returnParameterTypes())) -
 			static_cast<int>(CompilerUtils::sizeOnStack(functionType->parameterTypes())) -
-			1
+			(isSubroutine ? 0 : 1)
 		);
 		// Consumes the return parameters.
 		appendReturnValuePacker(functionType->returnParameterTypes(), _contract.isLibrary());
@@ -603,15 +609,18 @@ bool ContractCompiler::visit(VariableDeclaration const& _variableDeclaration)
 
 bool ContractCompiler::visit(FunctionDefinition const& _function)
 {
+	solAssert(!_function.isImplemented() || !_function.body().deferred(), "Body of function was not parsed.");
 	CompilerContext::LocationSetter locationSetter(m_context, _function);
 
 	m_context.startFunction(_function);
+	bool const isSubroutine = m_context.isSubroutine(_function);
 
 	// stack upon entry: [return address] [arg0] [arg1] ... [argn]
+	// (subroutines do not have a return address on the stack)
 	// reserve additional slots: [retarg0] ... [retargm]
 
 	unsigned parametersSize = CompilerUtils::sizeOnStack(_function.parameters());
-	if (_function.isFallback())
+	if (_function.isFallback() || isSubroutine)
 		m_context.adjustStackOffset(static_cast<int>(parametersSize));
 	else if (!_function.isConstructor())
 		// adding 1 for return address.
@@ -653,7 +662,7 @@ bool ContractCompiler::visit(FunctionDefinition const& _function)
 	unsigned const c_returnValuesSize = CompilerUtils::sizeOnStack(_function.returnParameters());
 
 	vector<int> stackLayout;
-	if (!_function.isConstructor() && !_function.isFallback())
+	if (!_function.isConstructor() && !_function.isFallback() && !isSubroutine)
 		stackLayout.push_back(static_cast<int>(c_returnValuesSize)); // target of return address
 	stackLayout += vector<int>(c_argumentsSize, -1); // discard all arguments
 	for (size_t i = 0; i < c_returnValuesSize; ++i)
@@ -689,7 +698,9 @@ bool ContractCompiler::visit(FunctionDefinition const& _function)
 	if (!_function.isConstructor())
 	{
 		solAssert(m_context.numberOfLocalVariables() == 0, "");
-		if (!_function.isFallback() && !_function.isReceive())
+		if (isSubroutine)
+			m_context.appendReturnsub();
+		else if (!_function.isFallback() && !_function.isReceive())
 			m_context.appendJump(evmasm::AssemblyItem::JumpType::OutOfFunction);
 	}
 
@@ -917,7 +928,8 @@ bool ContractCompiler::visit(InlineAssembly const& _inlineAssembly)
 		m_context.evmVersion(),
 		identifierAccess,
 		false,
-		m_optimiserSettings.optimizeStackAllocation
+		m_optimiserSettings.optimizeStackAllocation,
+		m_context.useSubroutines()
 	);
 	m_context.setStackOffset(static_cast<int>(startStackHeight));
 	return false;
@@ -1366,12 +1378,22 @@ void ContractCompiler::endVisit(Block const& _block)
 
 void ContractCompiler::appendMissingFunctions()
 {
-	while (Declaration const* function = m_context.nextFunctionToCompile())
-	{
-		m_context.setStackOffset(0);
-		function->accept(*this);
-		solAssert(m_context.nextFunctionToCompile() != function, "Compiled the wrong function?");
-	}
+	while (true)
+		if (Declaration const* function = m_context.nextFunctionToCompile())
+		{
+			m_context.setStackOffset(0);
+			function->accept(*this);
+			solAssert(m_context.nextFunctionToCompile() != function, "Compiled the wrong function?");
+		}
+		else if (!m_modifierRoutinesToCompile.empty())
+		{
+			auto [modifier, afterPlaceholder, tag] = m_modifierRoutinesToCompile.back();
+			m_modifierRoutinesToCompile.pop_back();
+			m_context.setStackOffset(0);
+			appendModifierRoutine(*modifier, afterPlaceholder, tag);
+		}
+		else
+			break;
 	m_context.appendMissingLowLevelFunctions();
 	m_context.appendYulUtilityFunctions(m_optimiserSettings);
 }
@@ -1426,7 +1448,30 @@ void ContractCompiler::appendModifierOrFunctionCode()
 			}
 
 			stackSurplus = CompilerUtils::sizeOnStack(modifier.parameters());
-			codeBlock = &modifier.body();
+			ModifierRoutines const* routines =
+				m_optimiserSettings.runModifierOutliner ? &modifierRoutines(modifier) : nullptr;
+			if (routines && (routines->beforePlaceholder || routines->afterPlaceholder))
+			{
+				auto callRoutine = [&](optional<AssemblyItem> const& _routine) {
+					if (!_routine)
+						return;
+					AssemblyItem returnTag = m_context.pushNewTag();
+					m_context.appendJumpTo(*_routine, AssemblyItem::JumpType::IntoFunction);
+					m_context << returnTag;
+					// The routine removes the return address.
+					m_context.adjustStackOffset(-1);
+				};
+				m_context.setArithmetic(Arithmetic::Checked);
+				callRoutine(routines->beforePlaceholder);
+				appendModifierOrFunctionCode();
+				callRoutine(routines->afterPlaceholder);
+
+				CompilerUtils(m_context).popStackSlots(stackSurplus);
+				for (auto var: addedVariables)
+					m_context.removeVariable(*var);
+			}
+			else
+				codeBlock = &modifier.body();
 		}
 	}
 
@@ -1454,6 +1499,125 @@ void ContractCompiler::appendModifierOrFunctionCode()
 	m_context.setModifierDepth(m_modifierDepth);
 }
 
+ContractCompiler::ModifierRoutines const& ContractCompiler::modifierRoutines(ModifierDefinition const& _modifier)
+{
+	if (auto it = m_modifierRoutines.find(&_modifier); it != m_modifierRoutines.end())
+		return it->second;
+	ModifierRoutines& routines = m_modifierRoutines[&_modifier];
+
+	// Only modifiers with a single placeholder at the top level of their body and without
+	// "return" can be split into the code before and after the placeholder. Variables declared
+	// before the placeholder would have to be kept on the stack between the routines.
+	auto const& statements = _modifier.body().statements();
+	auto placeholder = find_if(statements.begin(), statements.end(), [](auto const& _statement) {
+		return dynamic_cast<PlaceholderStatement const*>(_statement.get());
+	});
+	ModifierBodyInspector inspector(_modifier.body());
+	if (
+		placeholder == statements.end() ||
+		inspector.placeholders != 1 ||
+		inspector.hasReturn ||
+		any_of(statements.begin(), placeholder, [](auto const& _statement) {
+			return dynamic_cast<VariableDeclarationStatement const*>(_statement.get());
+		})
+	)
+		return routines;
+	bool const hasCodeBefore = placeholder != statements.begin();
+	bool const hasCodeAfter = next(placeholder) != statements.end();
+	size_t const parts = size_t(hasCodeBefore) + size_t(hasCodeAfter);
+	if (parts == 0)
+		return routines;
+
+	ContractDefinition const& contract = m_context.mostDerivedContract();
+	size_t uses = 0;
+	for (ContractDefinition const* base: contract.annotation().linearizedBaseContracts)
+		for (FunctionDefinition const* function: base->definedFunctions())
+			for (ASTPointer<ModifierInvocation> const& invocation: function->modifiers())
+				if (auto const* modifier = dynamic_cast<ModifierDefinition const*>(
+					invocation->name().annotation().referencedDeclaration
+				))
+					if (
+						*invocation->name().annotation().requiredLookup == VirtualLookup::Virtual ?
+						&modifier->resolveVirtual(contract) == &_modifier :
+						modifier == &_modifier
+					)
+						uses++;
+
+	// Rough estimate of the code size per AST node and of the costs of a call of a routine:
+	// pushing the return tag and the routine tag, two jumps and two jump destinations.
+	size_t constexpr bytesPerNode = 4;
+	size_t constexpr callBytes = 8;
+	size_t constexpr callGas = 24;
+	bigint savedBytes =
+		bigint(uses > 0 ? uses - 1 : 0) * bytesPerNode * inspector.nodes -
+		bigint(uses) * parts * callBytes -
+		2 * parts;
+	if (savedBytes * GasCosts::createDataGas <= bigint(m_optimiserSettings.expectedExecutionsPerDeployment) * parts * callGas)
+		return routines;
+
+	if (hasCodeBefore)
+	{
+		routines.beforePlaceholder = m_context.newTag();
+		m_modifierRoutinesToCompile.emplace_back(&_modifier, false, *routines.beforePlaceholder);
+	}
+	if (hasCodeAfter)
+	{
+		routines.afterPlaceholder = m_context.newTag();
+		m_modifierRoutinesToCompile.emplace_back(&_modifier, true, *routines.afterPlaceholder);
+	}
+	return routines;
+}
+
+void ContractCompiler::appendModifierRoutine(
+	ModifierDefinition const& _modifier,
+	bool _afterPlaceholder,
+	AssemblyItem const& _tag
+)
+{
+	CompilerContext::LocationSetter locationSetter(m_context, _modifier);
+	m_context << _tag;
+
+	// stack upon entry: [arg0] ... [argn] [return address]
+	unsigned parametersSize = CompilerUtils::sizeOnStack(_modifier.parameters());
+	m_context.adjustStackOffset(static_cast<int>(parametersSize) + 1);
+	unsigned offsetToCurrent = parametersSize + 1;
+	for (ASTPointer<VariableDeclaration> const& variable: _modifier.parameters())
+	{
+		m_context.addVariable(*variable, offsetToCurrent);
+		offsetToCurrent -= variable->annotation().type->sizeOnStack();
+	}
+
+	solAssert(m_returnTags.empty(), "");
+	m_breakTags.clear();
+	m_continueTags.clear();
+	m_currentFunction = nullptr;
+	m_modifierDepth = 0;
+	m_scopeStackHeight.clear();
+	m_context.setModifierDepth(0);
+	m_context.setArithmetic(Arithmetic::Checked);
+	bool coderV2Outside = m_context.useABICoderV2();
+	m_context.setUseABICoderV2(*_modifier.body().sourceUnit().annotation().useABICoderV2);
+
+	auto const& statements = _modifier.body().statements();
+	auto placeholder = find_if(statements.begin(), statements.end(), [](auto const& _statement) {
+		return dynamic_cast<PlaceholderStatement const*>(_statement.get());
+	});
+	solAssert(placeholder != statements.end(), "");
+	storeStackHeight(&_modifier.body());
+	if (_afterPlaceholder)
+		for (auto it = next(placeholder); it != statements.end(); ++it)
+			(*it)->accept(*this);
+	else
+		for (auto it = statements.begin(); it != placeholder; ++it)
+			(*it)->accept(*this);
+	popScopedVariables(&_modifier.body());
+
+	m_context.setUseABICoderV2(coderV2Outside);
+	for (ASTPointer<VariableDeclaration> const& variable: _modifier.parameters())
+		m_context.removeVariable(*variable);
+	m_context.appendJump(AssemblyItem::JumpType::OutOfFunction);
+}
+
 void ContractCompiler::appendStackVariableInitialisation(
 	VariableDeclaration const& _variable,
 	bool _provideDefaultValue
@@ -30,6 +30,8 @@
 #include <functional>
 #include <ostream>
 #include <map>
+#include <optional>
+#include <tuple>
 
 namespace solidity::frontend
 {
@@ -130,6 +132,21 @@ private:
 	/// body itself if the last modifier was reached.
 	void appendModifierOrFunctionCode();
 
+	/// Entry tags of the routines for the code of a modifier before and after its placeholder,
+	/// if they are shared by all uses of the modifier instead of being inlined.
+	struct ModifierRoutines
+	{
+		std::optional<evmasm::AssemblyItem> beforePlaceholder;
+		std::optional<evmasm::AssemblyItem> afterPlaceholder;
+	};
+	/// @returns the routines of @a _modifier, deciding on first use whether outlining its
+	/// parts pays off for the number of its uses in the contract and the optimiser runs.
+	ModifierRoutines const& modifierRoutines(ModifierDefinition const& _modifier);
+	/// Appends the routine for the code of @a _modifier before (or after) its placeholder with
+	/// the entry tag @a _tag. The routine expects the modifier arguments and the return
+	/// address on the stack and only leaves the arguments.
+	void appendModifierRoutine(ModifierDefinition const& _modifier, bool _afterPlaceholder, evmasm::AssemblyItem const& _tag);
+
 	/// Creates a stack slot for the given variable and assigns a default value.
 	/// If the default value is complex (needs memory allocation) and @a _provideDefaultValue
 	/// is false, this might be skipped.
@@ -162,6 +179,10 @@ private:
 
 	/// Stores the variables that were declared inside a specific scope, for each modifier depth.
 	std::map<unsigned, std::map<ASTNode const*, unsigned>> m_scopeStackHeight;
+
+	std::map<ModifierDefinition const*, ModifierRoutines> m_modifierRoutines;
+	/// Modifier routines that are referenced but not compiled yet.
+	std::vector<std::tuple<ModifierDefinition const*, bool, evmasm::AssemblyItem>> m_modifierRoutinesToCompile;
 };
 
 }
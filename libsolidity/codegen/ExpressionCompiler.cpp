@@ -88,8 +88,13 @@ void ExpressionCompiler::appendConstStateVariableAccessor(VariableDeclaration co
 	acceptAndConvert(*_varDecl.value(), *_varDecl.annotation().type);
 
 	// append return
-	m_context << dupInstruction(_varDecl.annotation().type->sizeOnStack() + 1);
-	m_context.appendJump(evmasm::AssemblyItem::JumpType::OutOfFunction);
+	if (m_context.isSubroutine(_varDecl))
+		m_context.appendReturnsub();
+	else
+	{
+		m_context << dupInstruction(_varDecl.annotation().type->sizeOnStack() + 1);
+		m_context.appendJump(evmasm::AssemblyItem::JumpType::OutOfFunction);
+	}
 }
 
 void ExpressionCompiler::appendStateVariableAccessor(VariableDeclaration const& _varDecl)
@@ -102,7 +107,9 @@ void ExpressionCompiler::appendStateVariableAccessor(VariableDeclaration const&
 	if (_varDecl.immutable())
 		solAssert(paramTypes.empty(), "");
 
-	m_context.adjustStackOffset(static_cast<int>(1 + CompilerUtils::sizeOnStack(paramTypes)));
+	bool const isSubroutine = m_context.isSubroutine(_varDecl);
+	// Subroutines do not have a return address on the stack.
+	m_context.adjustStackOffset(static_cast<int>((isSubroutine ? 0 : 1) + CompilerUtils::sizeOnStack(paramTypes)));
 
 	if (!_varDecl.immutable())
 	{
@@ -241,8 +248,13 @@ void ExpressionCompiler::appendStateVariableAccessor(VariableDeclaration const&
 			errinfo_sourceLocation(_varDecl.location()) <<
 			errinfo_comment("Stack too deep.")
 		);
-	m_context << dupInstruction(retSizeOnStack + 1);
-	m_context.appendJump(evmasm::AssemblyItem::JumpType::OutOfFunction);
+	if (isSubroutine)
+		m_context.appendReturnsub();
+	else
+	{
+		m_context << dupInstruction(retSizeOnStack + 1);
+		m_context.appendJump(evmasm::AssemblyItem::JumpType::OutOfFunction);
+	}
 }
 
 bool ExpressionCompiler::visit(Conditional const& _condition)
@@ -595,8 +607,12 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 		{
 			// Calling convention: Caller pushes return address and arguments
 			// Callee removes them and pushes return values
+			// Subroutines are called without return address.
 
-			evmasm::AssemblyItem returnLabel = m_context.pushNewTag();
+			bool const useSubroutines = m_context.useSubroutines();
+			optional<evmasm::AssemblyItem> returnLabel;
+			if (!useSubroutines)
+				returnLabel = m_context.pushNewTag();
 			for (unsigned i = 0; i < arguments.size(); ++i)
 				acceptAndConvert(*arguments[i], *function.parameterTypes()[i]);
 
@@ -639,12 +655,17 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 				// Extract the runtime part.
 				m_context << ((u256(1) << 32) - 1) << Instruction::AND;
 
-			m_context.appendJump(evmasm::AssemblyItem::JumpType::IntoFunction);
-			m_context << returnLabel;
+			if (useSubroutines)
+				m_context.appendJumpsub();
+			else
+			{
+				m_context.appendJump(evmasm::AssemblyItem::JumpType::IntoFunction);
+				m_context << *returnLabel;
+			}
 
 			unsigned returnParametersSize = CompilerUtils::sizeOnStack(function.returnParameterTypes());
 			// callee adds return parameters, but removes arguments and return label
-			m_context.adjustStackOffset(static_cast<int>(returnParametersSize - parameterSize) - 1);
+			m_context.adjustStackOffset(static_cast<int>(returnParametersSize - parameterSize) - (useSubroutines ? 0 : 1));
 			break;
 		}
 		case FunctionType::Kind::BareCall:
@@ -44,13 +44,81 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
+	recordDependency(_name, false);
 	if (!m_requestedFunctions.count(_name))
 	{
 		m_requestedFunctions[_name] = "<<STUB<<";
+		m_pendingFunctions.emplace_back();
 		string fun = _creator();
+		m_pendingFunctions.pop_back();
 		solAssert(!fun.empty(), "");
 		solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
 		m_requestedFunctions[_name] = std::move(fun);
 	}
 	return _name;
 }
+
+string MultiUseYulFunctionCollector::createSharedFunction(string const& _name, function<string ()> const& _creator)
+{
+	if (!m_cache)
+		return createFunction(_name, _creator);
+
+	recordDependency(_name, true);
+	if (!m_requestedFunctions.count(_name))
+	{
+		if (auto cached = m_cache->find(_name))
+		{
+			addFromCache(_name, *cached);
+			return _name;
+		}
+
+		m_requestedFunctions[_name] = "<<STUB<<";
+		m_pendingFunctions.emplace_back(PendingFunction{true, {}});
+		string fun = _creator();
+		PendingFunction pending = std::move(m_pendingFunctions.back());
+		m_pendingFunctions.pop_back();
+		solAssert(!fun.empty(), "");
+		solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
+		if (pending.shared)
+			m_cache->store(_name, {fun, std::move(pending.dependencies)});
+		m_requestedFunctions[_name] = std::move(fun);
+	}
+	return _name;
+}
+
+void MultiUseYulFunctionCollector::recordDependency(string const& _name, bool _shared)
+{
+	if (m_pendingFunctions.empty())
+		return;
+	PendingFunction& caller = m_pendingFunctions.back();
+	caller.dependencies.emplace_back(_name);
+	// A function calling a function that is not shared cannot be shared either, because
+	// other collectors could not take the callee from the cache.
+	if (!_shared)
+		caller.shared = false;
+}
+
+void MultiUseYulFunctionCollector::addFromCache(string const& _name, MultiUseYulFunctionCache::Function const& _function)
+{
+	m_requestedFunctions[_name] = _function.code;
+	for (string const& dependency: _function.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+		{
+			auto cached = m_cache->find(dependency);
+			solAssert(cached, "Dependency of cached function not found in cache.");
+			addFromCache(dependency, *cached);
+		}
+}
+
+shared_ptr<MultiUseYulFunctionCache::Function const> MultiUseYulFunctionCache::find(string const& _name) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_functions.find(_name);
+	return it == m_functions.end() ? nullptr : it->second;
+}
+
+void MultiUseYulFunctionCache::store(string const& _name, Function _function)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_functions.try_emplace(_name, make_shared<Function const>(std::move(_function)));
+}
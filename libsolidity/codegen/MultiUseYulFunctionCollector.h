@@ -24,11 +24,42 @@
 
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Yul functions shared between the function collectors of all contracts of a compilation.
+ * Every function is stored together with the names of the functions it calls, so that a
+ * collector taking a function from the cache can also take the functions it depends on.
+ * Thread-safe, since contracts can be compiled concurrently.
+ *
+ * The code of a function is identified by its name alone, so all collectors sharing a cache
+ * have to generate code for the same EVM version and revert string setting.
+ */
+class MultiUseYulFunctionCache
+{
+public:
+	struct Function
+	{
+		std::string code;
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the function of the given name or nullptr if it has not been stored yet.
+	std::shared_ptr<Function const> find(std::string const& _name) const;
+	/// Stores the function unless a function of the same name is already present.
+	void store(std::string const& _name, Function _function);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Function const>> m_functions;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -36,11 +67,21 @@ namespace solidity::frontend
 class MultiUseYulFunctionCollector
 {
 public:
+	explicit MultiUseYulFunctionCollector(std::shared_ptr<MultiUseYulFunctionCache> _cache = nullptr):
+		m_cache(std::move(_cache))
+	{}
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
 
+	/// Same as @a createFunction, but takes the function (and the functions it calls) from the
+	/// shared cache if another collector already created it, and stores it there otherwise.
+	/// Only to be used for functions whose code depends on nothing but their name and the
+	/// settings of the compilation, i.e. not for code specific to a contract.
+	std::string createSharedFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
 	/// @returns concatenation of all generated functions.
 	/// Guarantees that the order of functions in the generated code is deterministic and
 	/// platform-independent.
@@ -52,8 +93,24 @@ public:
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
 private:
+	/// A function whose creator is currently running.
+	struct PendingFunction
+	{
+		bool shared = false;
+		/// Functions requested by the creator so far.
+		std::vector<std::string> dependencies;
+	};
+
+	/// Records @a _name as a dependency of the function currently being created.
+	void recordDependency(std::string const& _name, bool _shared);
+	/// Adds a function from the cache and, recursively, its dependencies.
+	void addFromCache(std::string const& _name, MultiUseYulFunctionCache::Function const& _function);
+
 	/// Map from function name to code for a multi-use function.
 	std::map<std::string, std::string> m_requestedFunctions;
+	std::shared_ptr<MultiUseYulFunctionCache> m_cache;
+	/// Stack of the functions currently being created, innermost last.
+	std::vector<PendingFunction> m_pendingFunctions;
 };
 
 }
@@ -35,10 +35,66 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// @returns the number of bytes needed to store @a _type together with all memory structs and
+/// statically-sized memory arrays nested in it or nullopt if @a _type is neither of the two.
+optional<bigint> nestedMemoryObjectSize(Type const& _type)
+{
+	auto elementSize = [](Type const& _elementType) -> bigint {
+		return 32 + nestedMemoryObjectSize(_elementType).value_or(0);
+	};
+	if (auto const* arrayType = dynamic_cast<ArrayType const*>(&_type))
+	{
+		if (arrayType->isDynamicallySized())
+			return nullopt;
+		return bigint(arrayType->length()) * elementSize(*arrayType->baseType());
+	}
+	else if (auto const* structType = dynamic_cast<StructType const*>(&_type))
+	{
+		bigint size = 0;
+		for (Type const* member: structType->memoryMemberTypes())
+			size += elementSize(*member);
+		return size;
+	}
+	return nullopt;
+}
+
+/// @returns true if @a _type is a memory struct or statically-sized memory array with members
+/// of reference type, i.e. pointers that are not zero if the object is zeroed.
+bool containsMemoryPointers(Type const& _type)
+{
+	if (auto const* arrayType = dynamic_cast<ArrayType const*>(&_type))
+		return !arrayType->isDynamicallySized() && !arrayType->baseType()->isValueType();
+	else if (auto const* structType = dynamic_cast<StructType const*>(&_type))
+		for (Type const* member: structType->memoryMemberTypes())
+			if (!member->isValueType())
+				return true;
+	return false;
+}
+
+/// @returns true if @a _type is a memory struct or statically-sized memory array that contains
+/// further memory structs or statically-sized memory arrays and fits into a single allocation.
+bool allocateNestedMemoryAtOnce(Type const& _type)
+{
+	optional<bigint> size = nestedMemoryObjectSize(_type);
+	if (!size || *size > numeric_limits<uint64_t>::max())
+		return false;
+	if (auto const* arrayType = dynamic_cast<ArrayType const*>(&_type))
+		return nestedMemoryObjectSize(*arrayType->baseType()).has_value();
+	for (Type const* member: dynamic_cast<StructType const&>(_type).memoryMemberTypes())
+		if (nestedMemoryObjectSize(*member))
+			return true;
+	return false;
+}
+
+}
+
 string YulUtilFunctions::combineExternalFunctionIdFunction()
 {
 	string functionName = "combine_external_function_id";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(addr, selector) -> combined {
 				combined := <shl64>(or(<shl32>(addr), and(selector, 0xffffffff)))
@@ -54,7 +110,7 @@ string YulUtilFunctions::combineExternalFunctionIdFunction()
 string YulUtilFunctions::splitExternalFunctionIdFunction()
 {
 	string functionName = "split_external_function_id";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(combined) -> addr, selector {
 				combined := <shr64>(combined)
@@ -72,7 +128,7 @@ string YulUtilFunctions::splitExternalFunctionIdFunction()
 string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata)
 {
 	string functionName = "copy_" + string(_fromCalldata ? "calldata" : "memory") + "_to_memory";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_fromCalldata)
 		{
 			return Whiskers(R"(
@@ -111,7 +167,7 @@ string YulUtilFunctions::copyLiteralToMemoryFunction(string const& _literal)
 {
 	string functionName = "copy_literal_to_memory_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() -> memPtr {
 				memPtr := <arrayAllocationFunction>(<size>)
@@ -130,7 +186,7 @@ string YulUtilFunctions::storeLiteralInMemoryFunction(string const& _literal)
 {
 	string functionName = "store_literal_in_memory_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		size_t words = (_literal.length() + 31) / 32;
 		vector<map<string, string>> wordParams(words);
 		for (size_t i = 0; i < words; ++i)
@@ -160,7 +216,7 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 
 	solAssert(!_assert || !_messageType, "Asserts can't have messages!");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (!_messageType)
 			return Whiskers(R"(
 				function <functionName>(condition) {
@@ -206,7 +262,7 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 string YulUtilFunctions::leftAlignFunction(Type const& _type)
 {
 	string functionName = string("leftAlign_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> aligned {
 				<body>
@@ -268,7 +324,7 @@ string YulUtilFunctions::shiftLeftFunction(size_t _numBits)
 	solAssert(_numBits < 256, "");
 
 	string functionName = "shift_left_" + to_string(_numBits);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> newValue {
@@ -291,7 +347,7 @@ string YulUtilFunctions::shiftLeftFunction(size_t _numBits)
 string YulUtilFunctions::shiftLeftFunctionDynamic()
 {
 	string functionName = "shift_left_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> newValue {
@@ -317,7 +373,7 @@ string YulUtilFunctions::shiftRightFunction(size_t _numBits)
 	// the opcodes SAR and SDIV behave differently with regards to rounding!
 
 	string functionName = "shift_right_" + to_string(_numBits) + "_unsigned";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> newValue {
@@ -340,7 +396,7 @@ string YulUtilFunctions::shiftRightFunction(size_t _numBits)
 string YulUtilFunctions::shiftRightFunctionDynamic()
 {
 	string const functionName = "shift_right_unsigned_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> newValue {
@@ -361,7 +417,7 @@ string YulUtilFunctions::shiftRightFunctionDynamic()
 string YulUtilFunctions::shiftRightSignedFunctionDynamic()
 {
 	string const functionName = "shift_right_signed_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> result {
@@ -391,7 +447,7 @@ string YulUtilFunctions::typedShiftLeftFunction(Type const& _type, Type const& _
 	solAssert(_amountType.category() == Type::Category::Integer, "");
 	solAssert(!dynamic_cast<IntegerType const&>(_amountType).isSigned(), "");
 	string const functionName = "shift_left_" + _type.identifier() + "_" + _amountType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, bits) -> result {
@@ -416,7 +472,7 @@ string YulUtilFunctions::typedShiftRightFunction(Type const& _type, Type const&
 	bool valueSigned = integerType && integerType->isSigned();
 
 	string const functionName = "shift_right_" + _type.identifier() + "_" + _amountType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, bits) -> result {
@@ -439,7 +495,7 @@ string YulUtilFunctions::updateByteSliceFunction(size_t _numBytes, size_t _shift
 	size_t numBits = _numBytes * 8;
 	size_t shiftBits = _shiftBytes * 8;
 	string functionName = "update_byte_slice_" + to_string(_numBytes) + "_shift_" + to_string(_shiftBytes);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, toInsert) -> result {
@@ -461,7 +517,7 @@ string YulUtilFunctions::updateByteSliceFunctionDynamic(size_t _numBytes)
 	solAssert(_numBytes <= 32, "");
 	size_t numBits = _numBytes * 8;
 	string functionName = "update_byte_slice_dynamic" + to_string(_numBytes);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, shiftBytes, toInsert) -> result {
@@ -482,7 +538,7 @@ string YulUtilFunctions::updateByteSliceFunctionDynamic(size_t _numBytes)
 string YulUtilFunctions::maskBytesFunctionDynamic()
 {
 	string functionName = "mask_bytes_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, bytes) -> result {
 				let mask := not(<shr>(mul(8, bytes), not(0)))
@@ -498,7 +554,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunction(size_t _bytes)
 {
 	string functionName = "mask_lower_order_bytes_" + to_string(_bytes);
 	solAssert(_bytes <= 32, "");
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data) -> result {
 				result := and(data, <mask>)
@@ -512,7 +568,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunction(size_t _bytes)
 string YulUtilFunctions::maskLowerOrderBytesFunctionDynamic()
 {
 	string functionName = "mask_lower_order_bytes_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, bytes) -> result {
 				let mask := not(<shl>(mul(8, bytes), not(0)))
@@ -527,7 +583,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunctionDynamic()
 string YulUtilFunctions::roundUpFunction()
 {
 	string functionName = "round_up_to_mul_of_32";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> result {
@@ -545,7 +601,7 @@ string YulUtilFunctions::overflowCheckedIntAddFunction(IntegerType const& _type)
 	// TODO: Consider to add a special case for unsigned 256-bit integers
 	//       and use the following instead:
 	//       sum := add(x, y) if lt(sum, x) { <panic>() }
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> sum {
@@ -576,7 +632,7 @@ string YulUtilFunctions::overflowCheckedIntAddFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntAddFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_add_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> sum {
@@ -592,7 +648,7 @@ string YulUtilFunctions::wrappingIntAddFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntMulFunction(IntegerType const& _type)
 {
 	string functionName = "checked_mul_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			// Multiplication by zero could be treated separately and directly return zero.
 			Whiskers(R"(
@@ -628,7 +684,7 @@ string YulUtilFunctions::overflowCheckedIntMulFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntMulFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_mul_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> product {
@@ -644,7 +700,7 @@ string YulUtilFunctions::wrappingIntMulFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntDivFunction(IntegerType const& _type)
 {
 	string functionName = "checked_div_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -674,7 +730,7 @@ string YulUtilFunctions::overflowCheckedIntDivFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntDivFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_div_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -695,7 +751,7 @@ string YulUtilFunctions::wrappingIntDivFunction(IntegerType const& _type)
 string YulUtilFunctions::intModFunction(IntegerType const& _type)
 {
 	string functionName = "mod_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -716,7 +772,7 @@ string YulUtilFunctions::intModFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntSubFunction(IntegerType const& _type)
 {
 	string functionName = "checked_sub_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> diff {
@@ -746,7 +802,7 @@ string YulUtilFunctions::overflowCheckedIntSubFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntSubFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_sub_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> diff {
@@ -767,7 +823,7 @@ string YulUtilFunctions::overflowCheckedIntExpFunction(
 	solAssert(!_exponentType.isSigned(), "");
 
 	string functionName = "checked_exp_" + _type.identifier() + "_" + _exponentType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent) -> power {
@@ -804,7 +860,7 @@ string YulUtilFunctions::overflowCheckedIntLiteralExpFunction(
 
 	string functionName = "checked_exp_" + _baseType.richIdentifier() + "_" + _exponentType.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]()
+	return m_functionCollector.createSharedFunction(functionName, [&]()
 	{
 		// Converts a bigint number into u256 (negative numbers represented in two's complement form.)
 		// We assume that `_v` fits in 256 bits.
@@ -918,7 +974,7 @@ string YulUtilFunctions::overflowCheckedUnsignedExpFunction()
 	solAssert(pow(bigint(306), 32) >= pow(bigint(2), 256), "");
 
 	string functionName = "checked_exp_unsigned";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent, max) -> power {
@@ -966,7 +1022,7 @@ string YulUtilFunctions::overflowCheckedUnsignedExpFunction()
 string YulUtilFunctions::overflowCheckedSignedExpFunction()
 {
 	string functionName = "checked_exp_signed";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent, min, max) -> power {
@@ -1022,7 +1078,7 @@ string YulUtilFunctions::overflowCheckedExpLoopFunction()
 	// This function does not include the final multiplication.
 
 	string functionName = "checked_exp_helper";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(_power, _base, exponent, max) -> power, base {
@@ -1061,7 +1117,7 @@ string YulUtilFunctions::wrappingIntExpFunction(
 	solAssert(!_exponentType.isSigned(), "");
 
 	string functionName = "wrapping_exp_" + _type.identifier() + "_" + _exponentType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent) -> power {
@@ -1080,7 +1136,7 @@ string YulUtilFunctions::wrappingIntExpFunction(
 string YulUtilFunctions::arrayLengthFunction(ArrayType const& _type)
 {
 	string functionName = "array_length_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(value<?dynamic><?calldata>, len</calldata></dynamic>) -> length {
 				<?dynamic>
@@ -1122,7 +1178,7 @@ string YulUtilFunctions::arrayLengthFunction(ArrayType const& _type)
 string YulUtilFunctions::extractByteArrayLengthFunction()
 {
 	string functionName = "extract_byte_array_length";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(data) -> length {
 				length := div(data, 2)
@@ -1151,7 +1207,7 @@ std::string YulUtilFunctions::resizeArrayFunction(ArrayType const& _type)
 		return resizeDynamicByteArrayFunction(_type);
 
 	string functionName = "resize_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(array, newLen) {
 				if gt(newLen, <maxArrayLength>) {
@@ -1207,7 +1263,7 @@ std::string YulUtilFunctions::resizeArrayFunction(ArrayType const& _type)
 string YulUtilFunctions::resizeDynamicByteArrayFunction(ArrayType const& _type)
 {
 	string functionName = "resize_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, newLen) {
 				if gt(newLen, <maxArrayLength>) {
@@ -1238,7 +1294,7 @@ string YulUtilFunctions::resizeDynamicByteArrayFunction(ArrayType const& _type)
 string YulUtilFunctions::decreaseByteArraySizeFunction(ArrayType const& _type)
 {
 	string functionName = "byte_array_decrease_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, data, oldLen, newLen) {
 				switch lt(newLen, 32)
@@ -1280,7 +1336,7 @@ string YulUtilFunctions::decreaseByteArraySizeFunction(ArrayType const& _type)
 string YulUtilFunctions::increaseByteArraySizeFunction(ArrayType const& _type)
 {
 	string functionName = "byte_array_increase_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, data, oldLen, newLen) {
 				switch lt(oldLen, 32)
@@ -1312,7 +1368,7 @@ string YulUtilFunctions::increaseByteArraySizeFunction(ArrayType const& _type)
 string YulUtilFunctions::byteArrayTransitLongToShortFunction(ArrayType const& _type)
 {
 	string functionName = "transit_byte_array_long_to_short_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, len) {
 				// we need to copy elements from old array to new
@@ -1332,7 +1388,7 @@ string YulUtilFunctions::byteArrayTransitLongToShortFunction(ArrayType const& _t
 string YulUtilFunctions::shortByteArrayEncodeUsedAreaSetLengthFunction()
 {
 	string functionName = "extract_used_part_and_set_length_of_short_byte_array";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, len) -> used {
 				// we want to save only elements that are part of the array after resizing
@@ -1355,7 +1411,7 @@ string YulUtilFunctions::storageArrayPopFunction(ArrayType const& _type)
 		return storageByteArrayPopFunction(_type);
 
 	string functionName = "array_pop_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) {
 				let oldLen := <fetchLength>(array)
@@ -1384,7 +1440,7 @@ string YulUtilFunctions::storageByteArrayPopFunction(ArrayType const& _type)
 	solAssert(_type.isByteArray(), "");
 
 	string functionName = "byte_array_pop_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) {
 				let data := sload(array)
@@ -1435,7 +1491,7 @@ string YulUtilFunctions::storageArrayPushFunction(ArrayType const& _type, Type c
 		_fromType->identifier() +
 		"_to_" +
 		_type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array <values>) {
 				<?isByteArray>
@@ -1499,7 +1555,7 @@ string YulUtilFunctions::storageArrayPushZeroFunction(ArrayType const& _type)
 	solUnimplementedAssert(_type.baseType()->storageBytes() <= 32, "Base type is not yet implemented.");
 
 	string functionName = "array_push_zero_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) -> slot, offset {
 				<?isBytes>
@@ -1528,7 +1584,7 @@ string YulUtilFunctions::storageArrayPushZeroFunction(ArrayType const& _type)
 string YulUtilFunctions::partialClearStorageSlotFunction()
 {
 	string functionName = "partial_clear_storage_slot";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 		function <functionName>(slot, offset) {
 			let mask := <shr>(mul(8, sub(32, offset)), <ones>)
@@ -1549,7 +1605,7 @@ string YulUtilFunctions::clearStorageRangeFunction(Type const& _type)
 
 	string functionName = "clear_storage_range_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(start, end) {
 				for {} lt(start, end) { start := add(start, <increment>) }
@@ -1580,7 +1636,7 @@ string YulUtilFunctions::clearStorageArrayFunction(ArrayType const& _type)
 
 	string functionName = "clear_storage_array_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(slot) {
 				<?dynamic>
@@ -1611,7 +1667,7 @@ string YulUtilFunctions::clearStorageStructFunction(StructType const& _type)
 
 	string functionName = "clear_struct_storage_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		MemberList::MemberMap structMembers = _type.nativeMembers(nullptr);
 		vector<map<string, string>> memberSetValues;
 
@@ -1673,7 +1729,7 @@ string YulUtilFunctions::copyArrayToStorageFunction(ArrayType const& _fromType,
 		return copyValueArrayStorageToStorageFunction(_fromType, _toType);
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return m_functionCollector.createSharedFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(slot, value<?isFromDynamicCalldata>, len</isFromDynamicCalldata>) {
 				<?fromStorage> if eq(slot, value) { leave } </fromStorage>
@@ -1685,6 +1741,7 @@ string YulUtilFunctions::copyArrayToStorageFunction(ArrayType const& _fromType,
 
 				let elementSlot := <dstDataLocation>(slot)
 				let elementOffset := 0
+				<?packValues>let slotValue := 0</packValues>
 
 				for { let i := 0 } lt(i, length) {i := add(i, 1)} {
 					<?fromCalldata>
@@ -1708,13 +1765,22 @@ string YulUtilFunctions::copyArrayToStorageFunction(ArrayType const& _fromType,
 						let <elementValues> := srcPtr
 					</fromStorage>
 
-					<updateStorageValue>(elementSlot, elementOffset, <elementValues>)
+					<?packValues>
+						let <convertedValues> := <convert>(<elementValues>)
+						slotValue := <updateByteSlice>(slotValue, elementOffset, <prepareStore>(<convertedValues>))
+					<!packValues>
+						<updateStorageValue>(elementSlot, elementOffset, <elementValues>)
+					</packValues>
 
 					srcPtr := add(srcPtr, <srcStride>)
 
 					<?multipleItemsPerSlot>
 						elementOffset := add(elementOffset, <storageStride>)
 						if gt(elementOffset, sub(32, <storageStride>)) {
+							<?packValues>
+								sstore(elementSlot, slotValue)
+								slotValue := 0
+							</packValues>
 							elementOffset := 0
 							elementSlot := add(elementSlot, 1)
 						}
@@ -1722,6 +1788,9 @@ string YulUtilFunctions::copyArrayToStorageFunction(ArrayType const& _fromType,
 						elementSlot := add(elementSlot, <storageSize>)
 					</multipleItemsPerSlot>
 				}
+				<?packValues>
+					if elementOffset { sstore(elementSlot, slotValue) }
+				</packValues>
 			}
 		)");
 		if (_fromType.dataStoredIn(DataLocation::Storage))
@@ -1751,7 +1820,22 @@ string YulUtilFunctions::copyArrayToStorageFunction(ArrayType const& _fromType,
 			0,
 			_fromType.baseType()->stackItems().size()
 		));
-		templ("updateStorageValue", updateStorageValueFunction(*_fromType.baseType(), *_toType.baseType()));
+		// Value types that are packed into storage slots are collected into the value of
+		// their slot, which is stored once it is full or the last element was copied.
+		// The elements after the end of the array in the last slot are cleared,
+		// like resizing the array would do.
+		bool packValues = _toType.baseType()->isValueType() && _toType.storageStride() <= 16;
+		templ("packValues", packValues);
+		if (packValues)
+		{
+			Type const& toBaseType = *_toType.baseType();
+			templ("convertedValues", suffixedVariableNameList("convertedValue_", 0, toBaseType.sizeOnStack()));
+			templ("convert", conversionFunction(*_fromType.baseType(), toBaseType));
+			templ("updateByteSlice", updateByteSliceFunctionDynamic(toBaseType.storageBytes()));
+			templ("prepareStore", prepareStoreFunction(toBaseType));
+		}
+		else
+			templ("updateStorageValue", updateStorageValueFunction(*_fromType.baseType(), *_toType.baseType()));
 		templ("srcStride",
 			fromCalldata ?
 			to_string(_fromType.calldataStride()) :
@@ -1778,7 +1862,7 @@ string YulUtilFunctions::copyByteArrayToStorageFunction(ArrayType const& _fromTy
 	solAssert(_toType.isByteArray(), "");
 
 	string functionName = "copy_byte_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return m_functionCollector.createSharedFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(slot, src<?fromCalldata>, len</fromCalldata>) {
 				<?fromStorage> if eq(slot, src) { leave } </fromStorage>
@@ -1870,7 +1954,7 @@ string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const&
 	solAssert(_toType.storageStride() <= 32, "");
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return m_functionCollector.createSharedFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(dst, src) {
 				if eq(dst, src) { leave }
@@ -1989,7 +2073,7 @@ string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const&
 string YulUtilFunctions::arrayConvertLengthToSize(ArrayType const& _type)
 {
 	string functionName = "array_convert_length_to_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Type const& baseType = *_type.baseType();
 
 		switch (_type.location())
@@ -2043,7 +2127,7 @@ string YulUtilFunctions::arrayAllocationSizeFunction(ArrayType const& _type)
 {
 	solAssert(_type.dataStoredIn(DataLocation::Memory), "");
 	string functionName = "array_allocation_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(length) -> size {
 				// Make sure we can allocate memory without overflow
@@ -2071,7 +2155,7 @@ string YulUtilFunctions::arrayAllocationSizeFunction(ArrayType const& _type)
 string YulUtilFunctions::arrayDataAreaFunction(ArrayType const& _type)
 {
 	string functionName = "array_dataslot_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		// No special processing for calldata arrays, because they are stored as
 		// offset of the data area and length on the stack, so the offset already
 		// points to the data area.
@@ -2102,7 +2186,7 @@ string YulUtilFunctions::arrayDataAreaFunction(ArrayType const& _type)
 string YulUtilFunctions::storageArrayIndexAccessFunction(ArrayType const& _type)
 {
 	string functionName = "storage_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, index) -> slot, offset {
 				let arrayLength := <arrayLen>(array)
@@ -2147,7 +2231,7 @@ string YulUtilFunctions::storageArrayIndexAccessFunction(ArrayType const& _type)
 string YulUtilFunctions::memoryArrayIndexAccessFunction(ArrayType const& _type)
 {
 	string functionName = "memory_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(baseRef, index) -> addr {
 				if iszero(lt(index, <arrayLen>(baseRef))) {
@@ -2174,7 +2258,7 @@ string YulUtilFunctions::calldataArrayIndexAccessFunction(ArrayType const& _type
 {
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName = "calldata_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(base_ref<?dynamicallySized>, length</dynamicallySized>, index) -> addr<?dynamicallySizedBase>, len</dynamicallySizedBase> {
 				if iszero(lt(index, <?dynamicallySized>length<!dynamicallySized><arrayLen></dynamicallySized>)) { <panic>() }
@@ -2201,7 +2285,7 @@ string YulUtilFunctions::calldataArrayIndexRangeAccess(ArrayType const& _type)
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	solAssert(_type.isDynamicallySized(), "");
 	string functionName = "calldata_array_index_range_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(offset, length, startIndex, endIndex) -> offsetOut, lengthOut {
 				if gt(startIndex, endIndex) { <revertSliceStartAfterEnd> }
@@ -2223,7 +2307,7 @@ string YulUtilFunctions::accessCalldataTailFunction(Type const& _type)
 	solAssert(_type.isDynamicallyEncoded(), "");
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName = "access_calldata_tail_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(base_ref, ptr_to_tail) -> addr<?dynamicallySized>, length</dynamicallySized> {
 				let rel_offset_of_tail := calldataload(ptr_to_tail)
@@ -2254,7 +2338,7 @@ string YulUtilFunctions::nextArrayElementFunction(ArrayType const& _type)
 	if (_type.dataStoredIn(DataLocation::Storage))
 		solAssert(_type.baseType()->storageBytes() > 16, "");
 	string functionName = "array_nextElement_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(ptr) -> next {
 				next := add(ptr, <advance>)
@@ -2295,7 +2379,7 @@ string YulUtilFunctions::copyArrayFromStorageToMemoryFunction(ArrayType const& _
 
 	string functionName = "copy_array_from_storage_to_memory_" + _from.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_from.baseType()->isValueType())
 		{
 			solAssert(_from.baseType() == _to.baseType(), "");
@@ -2354,7 +2438,7 @@ string YulUtilFunctions::mappingIndexAccessFunction(MappingType const& _mappingT
 	solAssert(_keyType.sizeOnStack() <= 1, "");
 
 	string functionName = "mapping_index_access_" + _mappingType.identifier() + "_of_" + _keyType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_mappingType.keyType()->isDynamicallySized())
 			return Whiskers(R"(
 				function <functionName>(slot <?+key>,</+key> <key>) -> dataSlot {
@@ -2411,7 +2495,7 @@ string YulUtilFunctions::readFromStorageDynamic(Type const& _type, bool _splitFu
 		string(_splitFunctionTypes ? "split_" : "") +
 		_type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot, offset) -> value {
 				if gt(offset, 0) { <panic>() }
@@ -2439,7 +2523,7 @@ string YulUtilFunctions::readFromStorageValueType(Type const& _type, optional<si
 			"_" +
 			_type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		Whiskers templ(R"(
 			function <functionName>(slot<?dynamic>, offset</dynamic>) -> <?split>addr, selector<!split>value</split> {
 				<?split>let</split> value := <extract>(sload(slot)<?dynamic>, offset</dynamic>)
@@ -2500,7 +2584,7 @@ string YulUtilFunctions::readFromStorageReferenceType(Type const& _type)
 		.render();
 	}
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot) -> value {
 				value := <allocStruct>()
@@ -2539,7 +2623,7 @@ string YulUtilFunctions::updateStorageValueFunction(
 		"_to_" +
 		_toType.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		if (_toType.isValueType())
 		{
 			solAssert(_fromType.isImplicitlyConvertibleTo(_toType), "");
@@ -2630,7 +2714,7 @@ string YulUtilFunctions::writeToMemoryFunction(Type const& _type)
 {
 	string const functionName = "write_to_memory_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		solAssert(!dynamic_cast<StringLiteralType const*>(&_type), "");
 		if (auto ref = dynamic_cast<ReferenceType const*>(&_type))
 		{
@@ -2687,7 +2771,7 @@ string YulUtilFunctions::extractFromStorageValueDynamic(Type const& _type)
 	string functionName =
 		"extract_from_storage_value_dynamic" +
 		_type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot_value, offset) -> value {
 				value := <cleanupStorage>(<shr>(mul(offset, 8), slot_value))
@@ -2703,7 +2787,7 @@ string YulUtilFunctions::extractFromStorageValueDynamic(Type const& _type)
 string YulUtilFunctions::extractFromStorageValue(Type const& _type, size_t _offset)
 {
 	string functionName = "extract_from_storage_value_offset_" + to_string(_offset) + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot_value) -> value {
 				value := <cleanupStorage>(<shr>(slot_value))
@@ -2721,7 +2805,7 @@ string YulUtilFunctions::cleanupFromStorageFunction(Type const& _type)
 	solAssert(_type.isValueType(), "");
 
 	string functionName = string("cleanup_from_storage_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		Whiskers templ(R"(
 			function <functionName>(value) -> cleaned {
 				cleaned := <cleaned>
@@ -2758,7 +2842,7 @@ string YulUtilFunctions::cleanupFromStorageFunction(Type const& _type)
 string YulUtilFunctions::prepareStoreFunction(Type const& _type)
 {
 	string functionName = "prepare_store_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		solAssert(_type.isValueType(), "");
 		auto const* funType = dynamic_cast<FunctionType const*>(&_type);
 		if (funType && funType->kind() == FunctionType::Kind::External)
@@ -2794,7 +2878,7 @@ string YulUtilFunctions::prepareStoreFunction(Type const& _type)
 string YulUtilFunctions::allocationFunction()
 {
 	string functionName = "allocate_memory";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(size) -> memPtr {
 				memPtr := <allocateUnbounded>()
@@ -2811,7 +2895,7 @@ string YulUtilFunctions::allocationFunction()
 string YulUtilFunctions::allocateUnboundedFunction()
 {
 	string functionName = "allocate_unbounded";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() -> memPtr {
 				memPtr := mload(<freeMemoryPointer>)
@@ -2826,7 +2910,7 @@ string YulUtilFunctions::allocateUnboundedFunction()
 string YulUtilFunctions::finalizeAllocationFunction()
 {
 	string functionName = "finalize_allocation";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(memPtr, size) {
 				let newFreePtr := add(memPtr, <roundUp>(size))
@@ -2855,7 +2939,7 @@ string YulUtilFunctions::zeroMemoryFunction(Type const& _type)
 	solAssert(_type.hasSimpleZeroValueInMemory(), "");
 
 	string functionName = "zero_memory_chunk_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(dataStart, dataSizeInBytes) {
 				calldatacopy(dataStart, calldatasize(), dataSizeInBytes)
@@ -2871,7 +2955,7 @@ string YulUtilFunctions::zeroComplexMemoryArrayFunction(ArrayType const& _type)
 	solAssert(!_type.baseType()->hasSimpleZeroValueInMemory(), "");
 
 	string functionName = "zero_complex_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		solAssert(_type.memoryStride() == 32, "");
 		return Whiskers(R"(
 			function <functionName>(dataStart, dataSizeInBytes) {
@@ -2890,7 +2974,7 @@ string YulUtilFunctions::zeroComplexMemoryArrayFunction(ArrayType const& _type)
 string YulUtilFunctions::allocateMemoryArrayFunction(ArrayType const& _type)
 {
 	string functionName = "allocate_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 				function <functionName>(length) -> memPtr {
 					let allocSize := <allocSize>(length)
@@ -2911,7 +2995,7 @@ string YulUtilFunctions::allocateMemoryArrayFunction(ArrayType const& _type)
 string YulUtilFunctions::allocateAndInitializeMemoryArrayFunction(ArrayType const& _type)
 {
 	string functionName = "allocate_and_zero_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 				function <functionName>(length) -> memPtr {
 					memPtr := <allocArray>(length)
@@ -2936,7 +3020,7 @@ string YulUtilFunctions::allocateAndInitializeMemoryArrayFunction(ArrayType cons
 string YulUtilFunctions::allocateMemoryStructFunction(StructType const& _type)
 {
 	string functionName = "allocate_memory_struct_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 		function <functionName>() -> memPtr {
 			memPtr := <alloc>(<allocSize>)
@@ -2953,7 +3037,7 @@ string YulUtilFunctions::allocateMemoryStructFunction(StructType const& _type)
 string YulUtilFunctions::allocateAndInitializeMemoryStructFunction(StructType const& _type)
 {
 	string functionName = "allocate_and_zero_memory_struct_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 		function <functionName>() -> memPtr {
 			memPtr := <allocStruct>()
@@ -2983,6 +3067,101 @@ string YulUtilFunctions::allocateAndInitializeMemoryStructFunction(StructType co
 	});
 }
 
+string YulUtilFunctions::allocateAndInitializeNestedMemoryFunction(Type const& _type)
+{
+	solAssert(allocateNestedMemoryAtOnce(_type), "");
+	string functionName = "allocate_and_zero_nested_memory_" + _type.identifier();
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
+		return Whiskers(R"(
+			function <functionName>() -> memPtr {
+				memPtr := <alloc>(<size>)
+				<zeroMemory>(memPtr, <size>)
+				<initializePointers>(memPtr)
+			}
+		)")
+		("functionName", functionName)
+		("alloc", allocationFunction())
+		("size", toCompactHexWithPrefix(u256(*nestedMemoryObjectSize(_type))))
+		("zeroMemory", zeroMemoryFunction(*TypeProvider::uint256()))
+		("initializePointers", initializeNestedMemoryPointersFunction(_type))
+		.render();
+	});
+}
+
+string YulUtilFunctions::initializeNestedMemoryPointersFunction(Type const& _type)
+{
+	solAssert(containsMemoryPointers(_type), "");
+	string functionName = "initialize_nested_memory_pointers_" + _type.identifier();
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
+		// Template parameters for storing the pointer to an element of type @a _elementType.
+		// Nested objects are zeroed, but pointers to nested objects inside them have to be set.
+		auto elementParams = [&](Type const& _elementType) {
+			optional<bigint> nestedSize = nestedMemoryObjectSize(_elementType);
+			map<string, string> params;
+			params["nestedSize"] = nestedSize ? nestedSize->str() : "";
+			params["zeroPointer"] = to_string(CompilerUtils::zeroPointer);
+			params["initialize"] =
+				nestedSize && containsMemoryPointers(_elementType) ?
+				initializeNestedMemoryPointersFunction(
+					*TypeProvider::withLocationIfReference(DataLocation::Memory, &_elementType)
+				) :
+				"";
+			return params;
+		};
+
+		if (auto const* arrayType = dynamic_cast<ArrayType const*>(&_type))
+		{
+			Whiskers templ(R"(
+				function <functionName>(memPtr) {
+					<?+nestedSize>let dataPtr := add(memPtr, <headSize>)</+nestedSize>
+					for { let i := 0 } lt(i, <length>) { i := add(i, 1) } {
+						<?+nestedSize>
+							mstore(add(memPtr, mul(i, 32)), dataPtr)
+							<?+initialize><initialize>(dataPtr)</+initialize>
+							dataPtr := add(dataPtr, <nestedSize>)
+						<!+nestedSize>
+							mstore(add(memPtr, mul(i, 32)), <zeroPointer>)
+						</+nestedSize>
+					}
+				}
+			)");
+			templ("functionName", functionName);
+			templ("length", arrayType->length().str());
+			templ("headSize", (bigint(arrayType->length()) * 32).str());
+			for (auto const& [name, value]: elementParams(*arrayType->baseType()))
+				templ(name, value);
+			return templ.render();
+		}
+
+		Whiskers templ(R"(
+			function <functionName>(memPtr) {
+				<#member>
+				<?+nestedSize>
+					mstore(add(memPtr, <headOffset>), add(memPtr, <dataOffset>))
+					<?+initialize><initialize>(add(memPtr, <dataOffset>))</+initialize>
+				<!+nestedSize>
+					mstore(add(memPtr, <headOffset>), <zeroPointer>)
+				</+nestedSize>
+				</member>
+			}
+		)");
+		templ("functionName", functionName);
+		TypePointers const& members = dynamic_cast<StructType const&>(_type).memoryMemberTypes();
+		bigint dataOffset = bigint(members.size()) * 32;
+		vector<map<string, string>> memberParams;
+		for (size_t i = 0; i < members.size(); ++i)
+			if (!members[i]->isValueType())
+			{
+				map<string, string>& params = memberParams.emplace_back(elementParams(*members[i]));
+				params["headOffset"] = to_string(i * 32);
+				params["dataOffset"] = dataOffset.str();
+				dataOffset += nestedMemoryObjectSize(*members[i]).value_or(0);
+			}
+		templ("member", memberParams);
+		return templ.render();
+	});
+}
+
 string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 {
 	if (_from.category() == Type::Category::Function)
@@ -3002,7 +3181,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			_from.identifier() +
 			"_to_" +
 			_to.identifier();
-		return m_functionCollector.createFunction(functionName, [&]() {
+		return m_functionCollector.createSharedFunction(functionName, [&]() {
 			return Whiskers(R"(
 				function <functionName>(<?external>addr, </external>functionId) -> <?external>outAddr, </external>outFunctionId {
 					<?external>outAddr := addr</external>
@@ -3036,7 +3215,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			_from.identifier() +
 			"_to_" +
 			_to.identifier();
-		return m_functionCollector.createFunction(functionName, [&]() {
+		return m_functionCollector.createSharedFunction(functionName, [&]() {
 			return Whiskers(R"(
 				function <functionName>(offset, length) -> outOffset, outLength {
 					outOffset := offset
@@ -3064,7 +3243,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 		_from.identifier() +
 		"_to_" +
 		_to.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> converted {
 				<body>
@@ -3285,7 +3464,7 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 		"_to_" +
 		_to.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(slot, value) {
 				<?fromStorage> if iszero(eq(slot, value)) { </fromStorage>
@@ -3303,15 +3482,20 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 		MemberList::MemberMap structMembers = _from.nativeMembers(nullptr);
 		MemberList::MemberMap toStructMembers = _to.nativeMembers(nullptr);
 
-		vector<map<string, string>> memberParams(structMembers.size());
-		for (size_t i = 0; i < structMembers.size(); ++i)
-		{
-			Type const& memberType = *structMembers[i].type;
+		bool fromCalldata = _from.location() == DataLocation::CallData;
+		bool fromMemory = _from.location() == DataLocation::Memory;
+		bool fromStorage = _from.location() == DataLocation::Storage;
+
+		// Renders the code that reads member @a _i and writes it to storage, or, if @a _packed
+		// is true, into the variable slotValue that holds the value of its destination slot.
+		auto copyMember = [&](size_t _i, bool _packed) {
+			Type const& memberType = *structMembers[_i].type;
+			Type const& toMemberType = *toStructMembers[_i].type;
 			solAssert(memberType.memoryHeadSize() == 32, "");
-			auto const&[slotDiff, offset] = _to.storageOffsetsOfMember(structMembers[i].name);
+			auto const&[slotDiff, offset] = _to.storageOffsetsOfMember(structMembers[_i].name);
 
 			Whiskers t(R"(
-				let memberSlot := add(slot, <memberStorageSlotDiff>)
+				<?packed><!packed>let memberSlot := add(slot, <memberStorageSlotDiff>)</packed>
 				let memberSrcPtr := add(value, <memberOffset>)
 
 				<?fromCalldata>
@@ -3340,21 +3524,24 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 						</isValueType>
 				</fromStorage>
 
-				<updateStorageValue>(memberSlot, <memberValues>)
+				<?packed>
+					let <toValues> := <convert>(<memberValues>)
+					slotValue := <update>(slotValue, <prepare>(<toValues>))
+				<!packed>
+					<updateStorageValue>(memberSlot, <memberValues>)
+				</packed>
 			)");
-			bool fromCalldata = _from.location() == DataLocation::CallData;
 			t("fromCalldata", fromCalldata);
-			bool fromMemory = _from.location() == DataLocation::Memory;
 			t("fromMemory", fromMemory);
-			bool fromStorage = _from.location() == DataLocation::Storage;
 			t("fromStorage", fromStorage);
+			t("packed", _packed);
 			t("isValueType", memberType.isValueType());
 			t("memberValues", suffixedVariableNameList("memberValue_", 0, memberType.stackItems().size()));
 
 			t("memberStorageSlotDiff", slotDiff.str());
 			if (fromCalldata)
 			{
-				t("memberOffset", to_string(_from.calldataOffsetOfMember(structMembers[i].name)));
+				t("memberOffset", to_string(_from.calldataOffsetOfMember(structMembers[_i].name)));
 				t("dynamicallyEncodedMember", memberType.isDynamicallyEncoded());
 				if (memberType.isDynamicallyEncoded())
 					t("accessCalldataTail", accessCalldataTailFunction(memberType));
@@ -3363,12 +3550,12 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 			}
 			else if (fromMemory)
 			{
-				t("memberOffset", _from.memoryOffsetOfMember(structMembers[i].name).str());
+				t("memberOffset", _from.memoryOffsetOfMember(structMembers[_i].name).str());
 				t("read", readFromMemory(memberType));
 			}
 			else if (fromStorage)
 			{
-				auto[srcSlotOffset, srcOffset] = _from.storageOffsetsOfMember(structMembers[i].name);
+				auto[srcSlotOffset, srcOffset] = _from.storageOffsetsOfMember(structMembers[_i].name);
 				t("memberOffset", formatNumber(srcSlotOffset));
 				if (memberType.isValueType())
 					t("read", readFromStorageValueType(memberType, srcOffset, false));
@@ -3376,12 +3563,60 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 					solAssert(srcOffset == 0, "");
 
 			}
-			t("updateStorageValue", updateStorageValueFunction(
-				memberType,
-				*toStructMembers[i].type,
-				optional<unsigned>{offset}
-			));
-			memberParams[i]["updateMemberCall"] = t.render();
+			if (_packed)
+			{
+				solAssert(memberType.isValueType() && toMemberType.isValueType(), "");
+				t("toValues", suffixedVariableNameList("convertedValue_", 0, toMemberType.sizeOnStack()));
+				t("convert", conversionFunction(memberType, toMemberType));
+				t("update", updateByteSliceFunction(toMemberType.storageBytes(), offset));
+				t("prepare", prepareStoreFunction(toMemberType));
+			}
+			else
+				t("updateStorageValue", updateStorageValueFunction(
+					memberType,
+					toMemberType,
+					optional<unsigned>{offset}
+				));
+			return t.render();
+		};
+
+		vector<map<string, string>> memberParams;
+		for (size_t i = 0; i < structMembers.size();)
+		{
+			// Value type members that are packed into the same storage slot are combined
+			// into a single load and store of the slot.
+			u256 slotDiff = _to.storageOffsetsOfMember(structMembers[i].name).first;
+			size_t groupEnd = i + 1;
+			if (toStructMembers[i].type->isValueType())
+				while (
+					groupEnd < structMembers.size() &&
+					toStructMembers[groupEnd].type->isValueType() &&
+					_to.storageOffsetsOfMember(structMembers[groupEnd].name).first == slotDiff
+				)
+					++groupEnd;
+
+			if (groupEnd - i == 1)
+				memberParams.push_back({{"updateMemberCall", copyMember(i, false)}});
+			else
+			{
+				vector<map<string, string>> packedMembers;
+				for (size_t k = i; k < groupEnd; ++k)
+					packedMembers.push_back({{"copyMember", copyMember(k, true)}});
+				memberParams.push_back({{"updateMemberCall", Whiskers(R"(
+					let memberSlot := add(slot, <memberStorageSlotDiff>)
+					let slotValue := sload(memberSlot)
+					<#packedMember>
+					{
+						<copyMember>
+					}
+					</packedMember>
+					sstore(memberSlot, slotValue)
+				)")
+				("memberStorageSlotDiff", slotDiff.str())
+				("packedMember", move(packedMembers))
+				.render()}});
+			}
+			i = groupEnd;
 		}
 		templ("member", memberParams);
 
@@ -3411,7 +3646,7 @@ string YulUtilFunctions::arrayConversionFunction(ArrayType const& _from, ArrayTy
 		"_to_" +
 		_to.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value<?fromCalldataDynamic>, length</fromCalldataDynamic>) -> converted <?toCalldataDynamic>, outLength</toCalldataDynamic> {
 				<body>
@@ -3474,7 +3709,7 @@ string YulUtilFunctions::arrayConversionFunction(ArrayType const& _from, ArrayTy
 string YulUtilFunctions::cleanupFunction(Type const& _type)
 {
 	string functionName = string("cleanup_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> cleaned {
 				<body>
@@ -3571,7 +3806,7 @@ string YulUtilFunctions::cleanupFunction(Type const& _type)
 string YulUtilFunctions::validatorFunction(Type const& _type, bool _revertOnFailure)
 {
 	string functionName = string("validator_") + (_revertOnFailure ? "revert_" : "assert_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) {
 				if iszero(<condition>) { <failure> }
@@ -3635,7 +3870,7 @@ string YulUtilFunctions::packedHashFunction(
 	size_t sizeOnStack = 0;
 	for (Type const* t: _givenTypes)
 		sizeOnStack += t->sizeOnStack();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(<variables>) -> hash {
 				let pos := <allocateUnbounded>()
@@ -3656,7 +3891,7 @@ string YulUtilFunctions::forwardingRevertFunction()
 {
 	bool forward = m_evmVersion.supportsReturndata();
 	string functionName = "revert_forward_" + to_string(forward);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (forward)
 			return Whiskers(R"(
 				function <functionName>() {
@@ -3684,7 +3919,7 @@ std::string YulUtilFunctions::decrementCheckedFunction(Type const& _type)
 
 	string const functionName = "decrement_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -3707,7 +3942,7 @@ std::string YulUtilFunctions::decrementWrappingFunction(Type const& _type)
 
 	string const functionName = "decrement_wrapping_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(sub(value, 1))
@@ -3726,7 +3961,7 @@ std::string YulUtilFunctions::incrementCheckedFunction(Type const& _type)
 
 	string const functionName = "increment_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -3749,7 +3984,7 @@ std::string YulUtilFunctions::incrementWrappingFunction(Type const& _type)
 
 	string const functionName = "increment_wrapping_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(add(value, 1))
@@ -3768,7 +4003,7 @@ string YulUtilFunctions::negateNumberCheckedFunction(Type const& _type)
 	solAssert(type.isSigned(), "Expected signed type!");
 
 	string const functionName = "negate_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -3791,7 +4026,7 @@ string YulUtilFunctions::negateNumberWrappingFunction(Type const& _type)
 	solAssert(type.isSigned(), "Expected signed type!");
 
 	string const functionName = "negate_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(sub(0, value))
@@ -3809,7 +4044,7 @@ string YulUtilFunctions::zeroValueFunction(Type const& _type, bool _splitFunctio
 
 	string const functionName = "zero_value_for_" + string(_splitFunctionTypes ? "split_" : "") + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		FunctionType const* fType = dynamic_cast<FunctionType const*>(&_type);
 		if (fType && fType->kind() == FunctionType::Kind::External && _splitFunctionTypes)
 			return Whiskers(R"(
@@ -3864,12 +4099,19 @@ string YulUtilFunctions::zeroValueFunction(Type const& _type, bool _splitFunctio
 			{
 				if (_type.isDynamicallySized())
 					templ("zeroValue", to_string(CompilerUtils::zeroPointer));
+				else if (allocateNestedMemoryAtOnce(_type))
+					templ("zeroValue", allocateAndInitializeNestedMemoryFunction(_type) + "()");
 				else
 					templ("zeroValue", allocateAndInitializeMemoryArrayFunction(*arrayType) + "(" + to_string(unsigned(arrayType->length())) + ")");
 
 			}
 			else if (auto const* structType = dynamic_cast<StructType const*>(&_type))
-				templ("zeroValue", allocateAndInitializeMemoryStructFunction(*structType) + "()");
+			{
+				if (allocateNestedMemoryAtOnce(_type))
+					templ("zeroValue", allocateAndInitializeNestedMemoryFunction(_type) + "()");
+				else
+					templ("zeroValue", allocateAndInitializeMemoryStructFunction(*structType) + "()");
+			}
 			else
 				solUnimplementedAssert(false, "");
 		}
@@ -3882,7 +4124,7 @@ string YulUtilFunctions::storageSetToZeroFunction(Type const& _type)
 {
 	string const functionName = "storage_set_to_zero_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_type.isValueType())
 			return Whiskers(R"(
 				function <functionName>(slot, offset) {
@@ -3927,7 +4169,7 @@ string YulUtilFunctions::conversionFunctionSpecial(Type const& _from, Type const
 		_from.identifier() +
 		"_to_" +
 		_to.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (
 			auto fromTuple = dynamic_cast<TupleType const*>(&_from), toTuple = dynamic_cast<TupleType const*>(&_to);
 			fromTuple && toTuple && fromTuple->components().size() == toTuple->components().size()
@@ -4019,7 +4261,7 @@ string YulUtilFunctions::readFromMemoryOrCalldata(Type const& _type, bool _fromC
 	if (_fromCalldata)
 		solAssert(!_type.isDynamicallyEncoded(), "");
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		if (auto refType = dynamic_cast<ReferenceType const*>(&_type))
 		{
 			solAssert(refType->sizeOnStack() == 1, "");
@@ -4117,7 +4359,7 @@ string YulUtilFunctions::revertReasonIfDebug(string const& _message)
 string YulUtilFunctions::panicFunction(util::PanicCode _code)
 {
 	string functionName = "panic_error_" + toCompactHexWithPrefix(uint64_t(_code));
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() {
 				mstore(0, <selector>)
@@ -4137,7 +4379,7 @@ string YulUtilFunctions::returnDataSelectorFunction()
 	string const functionName = "return_data_selector";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> sig {
 				if gt(returndatasize(), 3) {
@@ -4157,7 +4399,7 @@ string YulUtilFunctions::tryDecodeErrorMessageFunction()
 	string const functionName = "try_decode_error_message";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> ret {
 				if lt(returndatasize(), 0x44) { leave }
@@ -4196,7 +4438,7 @@ string YulUtilFunctions::tryDecodePanicDataFunction()
 	string const functionName = "try_decode_panic_data";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> success, data {
 				if gt(returndatasize(), 0x23) {
@@ -4215,7 +4457,7 @@ string YulUtilFunctions::extractReturndataFunction()
 {
 	string const functionName = "extract_returndata";
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> data {
 				<?supportsReturndata>
@@ -4252,7 +4494,7 @@ string YulUtilFunctions::copyConstructorArgumentsToMemoryFunction(
 		"_" +
 		toString(_contract.id());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		string returnParams = suffixedVariableNameList("ret_param_",0, _contract.constructor()->parameters().size());
 		ABIFunctions abiFunctions(m_evmVersion, m_revertStrings, m_functionCollector);
 
@@ -4280,7 +4522,7 @@ string YulUtilFunctions::externalCodeFunction()
 {
 	string functionName = "external_code_at";
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>(addr) -> mpos {
 				let length := extcodesize(addr)
@@ -400,6 +400,19 @@ public:
 	/// signature: () -> memPtr
 	std::string allocateAndInitializeMemoryStructFunction(StructType const& _type);
 
+	/// @returns the name of a function that allocates a memory struct or a statically-sized
+	/// memory array together with all memory structs and statically-sized memory arrays
+	/// nested in it in a single chunk of memory and zeroes it. The nested objects are
+	/// placed after the head of the object that contains them.
+	/// signature: () -> memPtr
+	std::string allocateAndInitializeNestedMemoryFunction(Type const& _type);
+
+	/// @returns the name of a function that stores the pointers to the nested objects
+	/// of a zeroed chunk of memory allocated by allocateAndInitializeNestedMemoryFunction
+	/// and the zero pointer for nested dynamically-sized arrays.
+	/// signature: (memPtr) ->
+	std::string initializeNestedMemoryPointersFunction(Type const& _type);
+
 	/// @returns the name of the function that converts a value of type @a _from
 	/// to a value of type @a _to. The resulting vale is guaranteed to be in range
 	/// (i.e. "clean"). Asserts on failure.
@@ -133,10 +133,7 @@ void IRGenerationContext::initializeInternalDispatch(InternalDispatchMap _intern
 {
 	solAssert(internalDispatchClean(), "");
 
-	for (DispatchSet const& functions: _internalDispatch | boost::adaptors::map_values)
-		for (auto function: functions)
-			enqueueFunctionForCodeGeneration(*function);
-
+	// The functions are only generated once a call through the dispatch of their arity is found.
 	m_internalDispatchMap = move(_internalDispatch);
 }
 
@@ -144,6 +141,7 @@ InternalDispatchMap IRGenerationContext::consumeInternalDispatchMap()
 {
 	InternalDispatchMap internalDispatch = move(m_internalDispatchMap);
 	m_internalDispatchMap.clear();
+	m_calledDispatchArities.clear();
 	return internalDispatch;
 }
 
@@ -159,13 +157,16 @@ void IRGenerationContext::addToInternalDispatch(FunctionDefinition const& _funct
 		solAssert(*m_internalDispatchMap[arity].find(&_function) == &_function, "Different definitions with the same function ID");
 
 	m_internalDispatchMap[arity].insert(&_function);
-	enqueueFunctionForCodeGeneration(_function);
+	if (m_calledDispatchArities.count(arity))
+		enqueueFunctionForCodeGeneration(_function);
 }
 
 
 void IRGenerationContext::internalFunctionCalledThroughDispatch(YulArity const& _arity)
 {
-	m_internalDispatchMap.try_emplace(_arity);
+	if (m_calledDispatchArities.insert(_arity).second)
+		for (FunctionDefinition const* function: m_internalDispatchMap[_arity])
+			enqueueFunctionForCodeGeneration(*function);
 }
 
 YulUtilFunctions IRGenerationContext::utils()
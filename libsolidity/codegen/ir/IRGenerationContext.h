@@ -68,11 +68,13 @@ public:
 	IRGenerationContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<MultiUseYulFunctionCache> _functionCache = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
-		m_optimiserSettings(std::move(_optimiserSettings))
+		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_functions(std::move(_functionCache))
 	{}
 
 	MultiUseYulFunctionCollector& functionCollector() { return m_functions; }
@@ -127,10 +129,14 @@ public:
 	/// Notifies the context that a function call that needs to go through internal dispatch was
 	/// encountered while visiting the AST. This ensures that the corresponding dispatch function
 	/// gets added to the dispatch map even if there are no entries in it (which may happen if
-	/// the code contains a call to an uninitialized function variable).
+	/// the code contains a call to an uninitialized function variable) and queues the functions
+	/// of this arity for code generation.
 	void internalFunctionCalledThroughDispatch(YulArity const& _arity);
+	/// @returns the arities of the calls through internal dispatch encountered so far.
+	std::set<YulArity> const& calledInternalDispatchArities() const { return m_calledDispatchArities; }
 
-	/// Adds a function to the internal dispatch.
+	/// Adds a function to the internal dispatch. The function is only queued for code generation
+	/// if a call through the dispatch of its arity is encountered, since it cannot be reached otherwise.
 	void addToInternalDispatch(FunctionDefinition const& _function);
 
 	/// @returns a new copy of the utility function generator (but using the same function set).
@@ -190,6 +196,9 @@ private:
 	/// the code contains a call via a pointer even though a specific function is never assigned to it.
 	/// It will fail at runtime but the code must still compile.
 	InternalDispatchMap m_internalDispatchMap;
+	/// Arities of the calls through internal dispatch encountered so far. Only the dispatch
+	/// functions of these arities and the functions they call are generated.
+	std::set<YulArity> m_calledDispatchArities;
 
 	std::set<ContractDefinition const*, ASTNode::CompareByID> m_subObjects;
 };
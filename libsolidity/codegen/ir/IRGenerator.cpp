@@ -39,6 +39,7 @@
 
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/range/adaptor/map.hpp>
 
 #include <sstream>
@@ -50,20 +51,25 @@ using namespace solidity::frontend;
 
 pair<string, string> IRGenerator::run(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, string_view const> const& _otherYulSources
+	map<ContractDefinition const*, string_view const> const& _otherYulSources,
+	shared_ptr<yul::AssemblyStack>* _optimizedStack
 )
 {
 	string const ir = yul::reindent(generate(_contract, _otherYulSources));
 
-	yul::AssemblyStack asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	if (!asmStack.parseAndAnalyze("", ir))
+	auto asmStack = make_shared<yul::AssemblyStack>(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+	if (!asmStack->parseAndAnalyze("", ir))
 	{
 		string errorMessage;
-		for (auto const& error: asmStack.errors())
+		for (auto const& error: asmStack->errors())
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
-	asmStack.optimize();
+	asmStack->setParallelism(m_optimiserParallelism);
+	asmStack->optimize();
+	m_optimisationIncomplete = asmStack->optimisationIncomplete();
+	if (_optimizedStack)
+		*_optimizedStack = asmStack;
 
 	string warning =
 		"/*******************************************************\n"
@@ -73,7 +79,7 @@ pair<string, string> IRGenerator::run(
 		" *                !USE AT YOUR OWN RISK!               *\n"
 		" *******************************************************/\n\n";
 
-	return {warning + ir, warning + asmStack.print()};
+	return {warning + ir, warning + asmStack->print()};
 }
 
 string IRGenerator::generate(
@@ -195,29 +201,25 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions()
 		"Otherwise the dispatch may be incomplete."
 	);
 
+	set<YulArity> calledArities = m_context.calledInternalDispatchArities();
 	InternalDispatchMap internalDispatchMap = m_context.consumeInternalDispatchMap();
-	for (YulArity const& arity: internalDispatchMap | boost::adaptors::map_keys)
+	// Functions that are only referenced, e.g. to be stored or compared, but never called
+	// through the dispatch are not generated and do not need a dispatch function.
+	for (YulArity const& arity: calledArities)
 	{
 		string funName = IRNames::internalDispatch(arity);
 		m_context.functionCollector().createFunction(funName, [&]() {
 			Whiskers templ(R"(
 				function <functionName>(fun<?+in>, <in></+in>) <?+out>-> <out></+out> {
-					switch fun
-					<#cases>
-					case <funID>
-					{
-						<?+out> <out> :=</+out> <name>(<in>)
-					}
-					</cases>
-					default { <panic>() }
+					<selector>
 				}
 			)");
 			templ("functionName", funName);
-			templ("panic", m_utils.panicFunction(PanicCode::InvalidInternalFunction));
 			templ("in", suffixedVariableNameList("in_", 0, arity.in));
 			templ("out", suffixedVariableNameList("out_", 0, arity.out));
 
-			vector<map<string, string>> cases;
+			vector<int64_t> functionIDs;
+			vector<pair<string, string>> cases;
 			for (FunctionDefinition const* function: internalDispatchMap.at(arity))
 			{
 				solAssert(function, "");
@@ -230,13 +232,24 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions()
 				solAssert(function->id() != 0, "Unexpected function ID: 0");
 				solAssert(m_context.functionCollector().contains(IRNames::function(*function)), "");
 
-				cases.emplace_back(map<string, string>{
-					{"funID", to_string(function->id())},
-					{"name", IRNames::function(*function)}
-				});
+				functionIDs.emplace_back(function->id());
+				cases.emplace_back(
+					to_string(function->id()),
+					Whiskers("<?+out> <out> :=</+out> <name>(<in>)")
+					("out", suffixedVariableNameList("out_", 0, arity.out))
+					("name", IRNames::function(*function))
+					("in", suffixedVariableNameList("in_", 0, arity.in))
+					.render()
+				);
 			}
 
-			templ("cases", move(cases));
+			// The dispatch set is ordered by function ID, as required by the binary search.
+			solAssert(is_sorted(functionIDs.begin(), functionIDs.end()), "");
+			templ("selector", selectorSwitch(
+				"fun",
+				cases,
+				m_utils.panicFunction(PanicCode::InvalidInternalFunction) + "()"
+			));
 			return templ.render();
 		});
 	}
@@ -250,8 +263,58 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions()
 	return internalDispatchMap;
 }
 
+string IRGenerator::selectorSwitch(
+	string const& _expression,
+	vector<pair<string, string>> const& _cases,
+	string const& _default
+)
+{
+	if (CompilerUtils::splitSelector(_cases.size(), m_optimiserSettings.expectedExecutionsPerDeployment))
+	{
+		size_t pivotIndex = _cases.size() / 2;
+		vector<pair<string, string>> larger{_cases.begin() + static_cast<ptrdiff_t>(pivotIndex), _cases.end()};
+		vector<pair<string, string>> smaller{_cases.begin(), _cases.begin() + static_cast<ptrdiff_t>(pivotIndex)};
+		return boost::trim_copy(Whiskers(R"(
+			switch lt(<expression>, <pivot>)
+			case 0 {
+				<larger>
+			}
+			default {
+				<smaller>
+			}
+		)")
+		("expression", _expression)
+		("pivot", _cases[pivotIndex].first)
+		("larger", selectorSwitch(_expression, larger, _default))
+		("smaller", selectorSwitch(_expression, smaller, _default))
+		.render());
+	}
+
+	Whiskers templ(R"(
+		switch <expression>
+		<#cases>
+		case <value>
+		{
+			<body>
+		}
+		</cases>
+		default {<?+default> <default> </+default>}
+	)");
+	templ("expression", _expression);
+	vector<map<string, string>> cases;
+	for (auto const& [value, body]: _cases)
+		cases.emplace_back(map<string, string>{
+			{"value", value},
+			{"body", boost::trim_copy(body)}
+		});
+	templ("cases", move(cases));
+	templ("default", _default);
+	return boost::trim_copy(templ.render());
+}
+
 string IRGenerator::generateFunction(FunctionDefinition const& _function)
 {
+	solAssert(!_function.isImplemented() || !_function.body().deferred(), "Body of function was not parsed.");
 	string functionName = IRNames::function(_function);
 	return m_context.functionCollector().createFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
@@ -804,34 +867,29 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 		if iszero(lt(calldatasize(), 4))
 		{
 			let selector := <shr224>(calldataload(0))
-			switch selector
-			<#cases>
-			case <functionSelector>
-			{
-				// <functionName>
-				<delegatecallCheck>
-				<callValueCheck>
-				<?+params>let <params> := </+params> <abiDecode>(4, calldatasize())
-				<?+retParams>let <retParams> := </+retParams> <function>(<params>)
-				let memPos := <allocate>(0)
-				let memEnd := <abiEncode>(memPos <?+retParams>,</+retParams> <retParams>)
-				return(memPos, sub(memEnd, memPos))
-			}
-			</cases>
-			default {}
+			<selectorSwitch>
 		}
 		if iszero(calldatasize()) { <receiveEther> }
 		<fallback>
 	)X");
 	t("shr224", m_utils.shiftRightFunction(224));
-	vector<map<string, string>> functions;
+	vector<util::FixedHash<4>> selectors;
+	vector<pair<string, string>> functions;
 	for (auto const& function: _contract.interfaceFunctions())
 	{
-		functions.emplace_back();
-		map<string, string>& templ = functions.back();
-		templ["functionSelector"] = "0x" + function.first.hex();
+		selectors.emplace_back(function.first);
+		Whiskers templ(R"X(
+			// <functionName>
+			<delegatecallCheck>
+			<callValueCheck>
+			<?+params>let <params> := </+params> <abiDecode>(4, calldatasize())
+			<?+retParams>let <retParams> := </+retParams> <function>(<params>)
+			let memPos := <allocate>(0)
+			let memEnd := <abiEncode>(memPos <?+retParams>,</+retParams> <retParams>)
+			return(memPos, sub(memEnd, memPos))
+		)X");
 		FunctionTypePointer const& type = function.second;
-		templ["functionName"] = type->externalSignature();
+		templ("functionName", type->externalSignature());
 		string delegatecallCheck;
 		if (_contract.isLibrary())
 		{
@@ -844,28 +902,32 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 					m_context.revertReasonIfDebug("Non-view function of library called without DELEGATECALL") +
 					" }";
 		}
-		templ["delegatecallCheck"] = delegatecallCheck;
-		templ["callValueCheck"] = (type->isPayable() || _contract.isLibrary()) ? "" : callValueCheck();
+		templ("delegatecallCheck", delegatecallCheck);
+		templ("callValueCheck", (type->isPayable() || _contract.isLibrary()) ? "" : callValueCheck());
 
 		unsigned paramVars = make_shared<TupleType>(type->parameterTypes())->sizeOnStack();
 		unsigned retVars = make_shared<TupleType>(type->returnParameterTypes())->sizeOnStack();
 
 		ABIFunctions abiFunctions(m_evmVersion, m_context.revertStrings(), m_context.functionCollector());
-		templ["abiDecode"] = abiFunctions.tupleDecoder(type->parameterTypes());
-		templ["params"] = suffixedVariableNameList("param_", 0, paramVars);
-		templ["retParams"] = suffixedVariableNameList("ret_", 0, retVars);
+		templ("abiDecode", abiFunctions.tupleDecoder(type->parameterTypes()));
+		templ("params", suffixedVariableNameList("param_", 0, paramVars));
+		templ("retParams", suffixedVariableNameList("ret_", 0, retVars));
 
 		if (FunctionDefinition const* funDef = dynamic_cast<FunctionDefinition const*>(&type->declaration()))
-			templ["function"] = m_context.enqueueFunctionForCodeGeneration(*funDef);
+			templ("function", m_context.enqueueFunctionForCodeGeneration(*funDef));
 		else if (VariableDeclaration const* varDecl = dynamic_cast<VariableDeclaration const*>(&type->declaration()))
-			templ["function"] = generateGetter(*varDecl);
+			templ("function", generateGetter(*varDecl));
 		else
 			solAssert(false, "Unexpected declaration for function!");
 
-		templ["allocate"] = m_utils.allocationFunction();
-		templ["abiEncode"] = abiFunctions.tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes(), _contract.isLibrary());
+		templ("allocate", m_utils.allocationFunction());
+		templ("abiEncode", abiFunctions.tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes(), _contract.isLibrary()));
+
+		functions.emplace_back("0x" + function.first.hex(), templ.render());
 	}
-	t("cases", functions);
+	// The interface functions are ordered by selector, as required by the binary search.
+	solAssert(is_sorted(selectors.begin(), selectors.end()), "");
+	t("selectorSwitch", selectorSwitch("selector", functions, ""));
 	FunctionDefinition const* etherReceiver = _contract.receiveFunction();
 	if (etherReceiver)
 	{
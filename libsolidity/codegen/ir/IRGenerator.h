@@ -28,8 +28,14 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+#include <memory>
 #include <string>
 
+namespace solidity::yul
+{
+class AssemblyStack;
+}
+
 namespace solidity::frontend
 {
 
@@ -41,21 +47,30 @@ public:
 	IRGenerator(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		size_t _optimiserParallelism = 1,
+		std::shared_ptr<MultiUseYulFunctionCache> _functionCache = nullptr
 	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
-		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings)),
+		m_optimiserParallelism(_optimiserParallelism),
+		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings), std::move(_functionCache)),
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
 	/// Generates and returns the IR code, in unoptimized and optimized form
 	/// (or just pretty-printed, depending on the optimizer settings).
+	/// If @a _optimizedStack is not null, it is set to the assembly stack holding the
+	/// optimized code, so that it can be compiled further without parsing it again.
 	std::pair<std::string, std::string> run(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources,
+		std::shared_ptr<yul::AssemblyStack>* _optimizedStack = nullptr
 	);
 
+	/// @returns true if the work budget of the optimiser was exhausted during the last run().
+	bool optimisationIncomplete() const { return m_optimisationIncomplete; }
+
 private:
 	std::string generate(
 		ContractDefinition const& _contract,
@@ -71,6 +86,15 @@ private:
 	/// @return The content of the dispatch for reuse in runtime code. Reuse is necessary because
 	/// pointers to functions can be passed from the creation code in storage variables.
 	InternalDispatchMap generateInternalDispatchFunctions();
+	/// @returns a switch on @a _expression that executes the body of the case in @a _cases,
+	/// pairs of values and bodies sorted by value, that matches, and @a _default otherwise.
+	/// Large sets of cases are split into a binary search if that is cheaper for the
+	/// configured number of runs.
+	std::string selectorSwitch(
+		std::string const& _expression,
+		std::vector<std::pair<std::string, std::string>> const& _cases,
+		std::string const& _default
+	);
 	/// Generates code for and returns the name of the function.
 	std::string generateFunction(FunctionDefinition const& _function);
 	std::string generateModifier(
@@ -114,6 +138,9 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	/// Maximum number of threads used to optimise the generated objects.
+	size_t const m_optimiserParallelism;
+	bool m_optimisationIncomplete = false;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
@@ -1339,7 +1339,7 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 	case FunctionType::Kind::AddMod:
 	case FunctionType::Kind::MulMod:
 	{
-		static map<FunctionType::Kind, string> functions = {
+		static map<FunctionType::Kind, string> const functions = {
 			{FunctionType::Kind::AddMod, "addmod"},
 			{FunctionType::Kind::MulMod, "mulmod"},
 		};
@@ -1357,14 +1357,14 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 		for (size_t i = 0; i < 2; ++i)
 			args += expressionAsType(*arguments[i], *(parameterTypes[i])) + ", ";
 		args += modulus.name();
-		define(_functionCall) << functions[functionType->kind()] << "(" << args << ")\n";
+		define(_functionCall) << functions.at(functionType->kind()) << "(" << args << ")\n";
 		break;
 	}
 	case FunctionType::Kind::GasLeft:
 	case FunctionType::Kind::Selfdestruct:
 	case FunctionType::Kind::BlockHash:
 	{
-		static map<FunctionType::Kind, string> functions = {
+		static map<FunctionType::Kind, string> const functions = {
 			{FunctionType::Kind::GasLeft, "gas"},
 			{FunctionType::Kind::Selfdestruct, "selfdestruct"},
 			{FunctionType::Kind::BlockHash, "blockhash"},
@@ -1374,7 +1374,7 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 		string args;
 		for (size_t i = 0; i < arguments.size(); ++i)
 			args += (args.empty() ? "" : ", ") + expressionAsType(*arguments[i], *(parameterTypes[i]));
-		define(_functionCall) << functions[functionType->kind()] << "(" << args << ")\n";
+		define(_functionCall) << functions.at(functionType->kind()) << "(" << args << ")\n";
 		break;
 	}
 	case FunctionType::Kind::Creation:
@@ -1475,12 +1475,12 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 		solAssert(!functionType->gasSet(), "");
 		solAssert(!functionType->bound(), "");
 
-		static map<FunctionType::Kind, std::tuple<unsigned, size_t>> precompiles = {
+		static map<FunctionType::Kind, std::tuple<unsigned, size_t>> const precompiles = {
 			{FunctionType::Kind::ECRecover, std::make_tuple(1, 0)},
 			{FunctionType::Kind::SHA256, std::make_tuple(2, 0)},
 			{FunctionType::Kind::RIPEMD160, std::make_tuple(3, 12)},
 		};
-		auto [ address, offset ] = precompiles[functionType->kind()];
+		auto [ address, offset ] = precompiles.at(functionType->kind());
 		TypePointers argumentTypes;
 		vector<string> argumentStrings;
 		for (auto const& arg: arguments)
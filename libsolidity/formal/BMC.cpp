@@ -21,8 +21,13 @@
 #include <libsolidity/formal/SymbolicState.h>
 #include <libsolidity/formal/SymbolicTypes.h>
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SMTPortfolio.h>
 
+#include <libsolutil/CommonData.h>
+#include <libsolutil/StringUtils.h>
+#include <libsolutil/ThreadPool.h>
+
 #ifdef HAVE_Z3_DLOPEN
 #include <z3_version.h>
 #endif
@@ -33,6 +38,88 @@ using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// @returns @a _name without the SSA index at its end.
+string withoutIndex(string const& _name)
+{
+	return _name.substr(0, _name.find_last_not_of("0123456789") + 1);
+}
+
+/// Calls @a _visit once for every symbolic variable of @a _context
+/// together with its declaration, if it represents a declared variable.
+template <typename Visitor>
+void forEachSymbolicVariable(smt::EncodingContext const& _context, Visitor _visit)
+{
+	set<smt::SymbolicVariable const*> visited;
+	for (auto const& [declaration, variable]: _context.variables())
+		if (visited.insert(variable.get()).second)
+			_visit(variable, declaration);
+	for (auto const& [expression, variable]: _context.expressions())
+		if (visited.insert(variable.get()).second)
+			_visit(variable, nullptr);
+	for (auto const& [name, variable]: _context.globalSymbols())
+		if (visited.insert(variable.get()).second)
+			_visit(variable, nullptr);
+}
+
+/// Collects the names of the subexpressions of @a _expr,
+/// not descending into the arguments in @a _visited, which is extended.
+void collectNames(
+	smtutil::Expression const& _expr,
+	set<string>& _names,
+	set<vector<smtutil::Expression> const*>& _visited
+)
+{
+	_names.insert(_expr.name);
+	if (!_expr.arguments.empty() && _visited.insert(_expr.arguments.shared().get()).second)
+		for (auto const& argument: _expr.arguments)
+			collectNames(argument, _names, _visited);
+}
+
+/// @returns @a _expr with the leaves named in @a _names and the subexpressions with the
+/// arguments in @a _replaced replaced. Replaced subexpressions are added to @a _replaced,
+/// the unchanged ones are shared with @a _expr.
+smtutil::Expression substitute(
+	smtutil::Expression const& _expr,
+	map<string, smtutil::Expression> const& _names,
+	map<vector<smtutil::Expression> const*, smtutil::Expression>& _replaced
+)
+{
+	if (_expr.arguments.empty())
+	{
+		auto name = _names.find(_expr.name);
+		return name == _names.end() ? _expr : name->second;
+	}
+	auto const* arguments = _expr.arguments.shared().get();
+	if (auto replaced = _replaced.find(arguments); replaced != _replaced.end())
+		return replaced->second;
+
+	vector<smtutil::Expression> newArguments;
+	bool changed = false;
+	for (auto const& argument: _expr.arguments)
+	{
+		newArguments.emplace_back(substitute(argument, _names, _replaced));
+		changed =
+			changed ||
+			newArguments.back().name != argument.name ||
+			newArguments.back().arguments.shared() != argument.arguments.shared();
+	}
+	smtutil::Expression result = changed ? smtutil::Expression(_expr.name, move(newArguments), _expr.sort) : _expr;
+	_replaced.emplace(arguments, result);
+	return result;
+}
+
+/// @returns true if @a _recorded can be replaced by @a _current.
+/// Leaves cannot be told apart from other occurrences of the same name.
+bool replaceable(smtutil::Expression const& _recorded, smtutil::Expression const& _current)
+{
+	return !_recorded.arguments.empty() || (_current.arguments.empty() && _current.name == _recorded.name);
+}
+
+}
+
 BMC::BMC(
 	smt::EncodingContext& _context,
 	ErrorReporter& _errorReporter,
@@ -43,9 +130,16 @@ BMC::BMC(
 ):
 	SMTEncoder(_context),
 	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _enabledSolvers, _settings.timeout)),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_enabledSolvers(_enabledSolvers),
 	m_outerErrorReporter(_errorReporter),
-	m_settings(_settings)
+	m_settings(_settings),
+	m_potentialTargets(_settings.targets)
 {
+	m_interface->setRacing(m_settings.jobs != 1);
+	if (m_settings.cacheDirectory)
+		m_queryCache = make_shared<smtutil::QueryCache>(*m_settings.cacheDirectory);
+	m_interface->setQueryCache(m_queryCache);
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (_enabledSolvers.some())
 		if (!_smtlib2Responses.empty())
@@ -101,6 +195,16 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 	m_errorReporter.clear();
 }
 
+vector<string> BMC::unhandledQueries()
+{
+	return m_interface->unhandledQueries() + m_workerUnhandledQueries;
+}
+
+string BMC::unhandledQueriesScript()
+{
+	return m_interface->unhandledQueriesScript();
+}
+
 bool BMC::shouldInlineFunctionCall(
 	FunctionCall const& _funCall,
 	ContractDefinition const* _scopeContract,
@@ -124,6 +228,11 @@ bool BMC::shouldInlineFunctionCall(
 
 bool BMC::visit(ContractDefinition const& _contract)
 {
+	if (!m_potentialTargets.contract(_contract))
+		return false;
+
+	if (m_statistics)
+		m_statistics->beginContract("BMC", _contract);
 	initContract(_contract);
 
 	SMTEncoder::visit(_contract);
@@ -133,6 +242,10 @@ bool BMC::visit(ContractDefinition const& _contract)
 
 void BMC::endVisit(ContractDefinition const& _contract)
 {
+	if (!m_potentialTargets.contract(_contract))
+		return;
+
+	m_inlinedCalls.clear();
 	if (auto constructor = _contract.constructor())
 		constructor->accept(*this);
 	else
@@ -147,6 +260,8 @@ void BMC::endVisit(ContractDefinition const& _contract)
 	}
 
 	SMTEncoder::endVisit(_contract);
+	if (m_statistics)
+		m_statistics->endContract();
 }
 
 bool BMC::visit(FunctionDefinition const& _function)
@@ -158,6 +273,10 @@ bool BMC::visit(FunctionDefinition const& _function)
 	if (find(hierarchy.begin(), hierarchy.end(), contract) == hierarchy.end())
 		createStateVariables(*contract);
 
+	// Transactions in which no target can arise are not encoded.
+	if (m_callStack.empty() && !_function.isConstructor() && !m_potentialTargets.function(_function, *m_currentContract))
+		return false;
+
 	if (m_callStack.empty())
 	{
 		reset();
@@ -177,6 +296,10 @@ bool BMC::visit(FunctionDefinition const& _function)
 
 void BMC::endVisit(FunctionDefinition const& _function)
 {
+	// The call stack is only empty if the transaction was skipped.
+	if (m_callStack.empty())
+		return;
+
 	if (isRootFunction())
 	{
 		checkVerificationTargets();
@@ -529,19 +652,244 @@ void BMC::inlineFunctionCall(FunctionCall const& _funCall)
 	{
 		initializeFunctionCallParameters(*funDef, symbolicArguments(_funCall, m_currentContract));
 
-		// The reason why we need to pushCallStack here instead of visit(FunctionDefinition)
-		// is that there we don't have `_funCall`.
-		pushCallStack({funDef, &_funCall});
-		pushPathCondition(currentPathConditions());
-		auto oldChecked = std::exchange(m_checked, true);
-		funDef->accept(*this);
-		m_checked = oldChecked;
-		popPathCondition();
+		// The body is only encoded the first time the function is called in a transaction.
+		// Later calls rename the variables of that encoding.
+		auto inlinedCall = m_inlinedCalls.find(funDef);
+		if (inlinedCall == m_inlinedCalls.end())
+		{
+			auto recorded = recordInlinedCall(*funDef, _funCall);
+			m_inlinedCalls.emplace(funDef, move(recorded));
+		}
+		else if (!inlinedCall->second || !instantiateInlinedCall(*inlinedCall->second, *funDef, _funCall))
+			inlineFunctionBody(*funDef, _funCall);
 	}
 
 	createReturnedExpressions(_funCall, m_currentContract);
 }
 
+void BMC::inlineFunctionBody(FunctionDefinition const& _function, FunctionCall const& _funCall)
+{
+	// The reason why we need to pushCallStack here instead of visit(FunctionDefinition)
+	// is that there we don't have `_funCall`.
+	pushCallStack({&_function, &_funCall});
+	pushPathCondition(currentPathConditions());
+	auto oldChecked = std::exchange(m_checked, true);
+	_function.accept(*this);
+	m_checked = oldChecked;
+	popPathCondition();
+}
+
+optional<BMC::InlinedCall> BMC::recordInlinedCall(FunctionDefinition const& _function, FunctionCall const& _funCall)
+{
+	InlinedCall call;
+	call.assertions = m_context.assertions();
+	call.pathCondition = currentPathConditions();
+	call.callStackDepth = m_callStack.size();
+	map<smt::SymbolicVariable const*, pair<unsigned, unsigned>> entryIndices;
+	forEachSymbolicVariable(m_context, [&](auto const& _variable, VariableDeclaration const*) {
+		entryIndices.emplace(_variable.get(), make_pair(_variable->index(), _variable->nextIndex()));
+	});
+	vector<string> const stateNames = state().currentNames();
+	unsigned const uniqueId = m_context.nextUniqueId();
+	size_t const targets = m_verificationTargets.size();
+	size_t const errors = m_errorReporter.errors().size();
+	bool const loopExecutionHappened = exchange(m_loopExecutionHappened, false);
+	bool const externalFunctionCallHappened = exchange(m_externalFunctionCallHappened, false);
+	bool const arrayAssignmentHappened = exchange(m_arrayAssignmentHappened, false);
+
+	inlineFunctionBody(_function, _funCall);
+
+	call.loopExecutionHappened = m_loopExecutionHappened;
+	call.externalFunctionCallHappened = m_externalFunctionCallHappened;
+	call.arrayAssignmentHappened = m_arrayAssignmentHappened;
+	m_loopExecutionHappened = m_loopExecutionHappened || loopExecutionHappened;
+	m_externalFunctionCallHappened = m_externalFunctionCallHappened || externalFunctionCallHappened;
+	m_arrayAssignmentHappened = m_arrayAssignmentHappened || arrayAssignmentHappened;
+	call.errors.assign(m_errorReporter.errors().begin() + static_cast<ptrdiff_t>(errors), m_errorReporter.errors().end());
+
+	// Slack variables and the blockchain state are not renamed.
+	if (m_context.nextUniqueId() != uniqueId || state().currentNames() != stateNames)
+		return nullopt;
+
+	smtutil::Expression const assertions = m_context.assertions();
+	for (
+		smtutil::Expression const* added = &assertions;
+		added->name != call.assertions.name || added->arguments.shared() != call.assertions.arguments.shared();
+		added = &added->arguments.at(1)
+	)
+	{
+		if (added->name != "and" || added->arguments.size() != 2)
+			return nullopt;
+		call.addedAssertions.emplace_back(*added);
+	}
+	reverse(call.addedAssertions.begin(), call.addedAssertions.end());
+
+	set<string> names;
+	set<vector<smtutil::Expression> const*> visited{
+		call.assertions.arguments.shared().get(),
+		call.pathCondition.arguments.shared().get()
+	};
+	for (auto const& assertion: call.addedAssertions)
+		collectNames(assertion, names, visited);
+	for (size_t i = targets; i < m_verificationTargets.size(); ++i)
+	{
+		auto const& target = m_verificationTargets.at(i);
+		for (auto const* expr: {&target.value, &target.constraints, &target.context})
+			collectNames(*expr, names, visited);
+		for (auto const& expr: target.modelExpressions.first)
+			collectNames(expr, names, visited);
+	}
+
+	// Maps the names used by the call to the variable and index they refer to.
+	map<string, pair<size_t, unsigned>> versions;
+	set<string> stems;
+	bool renamable = true;
+	auto addVersion = [&](smt::SymbolicVariable const& _variable, unsigned _index) {
+		string name = _variable.nameAtIndex(_index);
+		if (names.count(name) && !versions.emplace(name, make_pair(call.variables.size(), _index)).second)
+			renamable = false;
+	};
+	forEachSymbolicVariable(m_context, [&](auto const& _variable, VariableDeclaration const* _declaration) {
+		stems.insert(withoutIndex(_variable->currentName()));
+		stems.insert(withoutIndex(_variable->nameAtIndex(0)));
+		auto entry = entryIndices.find(_variable.get());
+		bool changed =
+			entry == entryIndices.end() ||
+			entry->second != make_pair(_variable->index(), _variable->nextIndex());
+		if (dynamic_cast<smt::SymbolicFunctionVariable const*>(_variable.get()))
+		{
+			renamable = renamable && !changed;
+			return;
+		}
+		// Assignments to reference types and state variables also affect other variables.
+		if (changed && _declaration && (_declaration->isStateVariable() || !_declaration->type()->isValueType()))
+			renamable = false;
+
+		InlinedVariable variable{_variable, nullopt, 0, 0, _variable->index()};
+		if (entry != entryIndices.end())
+		{
+			variable.entryIndex = entry->second.first;
+			variable.firstNewIndex = entry->second.second;
+			addVersion(*_variable, *variable.entryIndex);
+		}
+		variable.newIndices = _variable->nextIndex() - variable.firstNewIndex;
+		if (variable.exitIndex != variable.entryIndex && variable.exitIndex < variable.firstNewIndex)
+			renamable = false;
+		for (unsigned i = 0; i < variable.newIndices; ++i)
+			addVersion(*_variable, variable.firstNewIndex + i);
+		if (changed || (variable.entryIndex && names.count(_variable->nameAtIndex(*variable.entryIndex))))
+			call.variables.emplace_back(move(variable));
+	});
+	if (!renamable)
+		return nullopt;
+	// Other versions of the variables cannot be renamed.
+	for (auto const& name: names)
+		if (!versions.count(name) && stems.count(withoutIndex(name)))
+			return nullopt;
+	for (auto const& name: stateNames)
+		if (names.count(name))
+			call.stateNames.emplace_back(name);
+
+	for (size_t i = targets; i < m_verificationTargets.size(); ++i)
+	{
+		auto const& target = m_verificationTargets.at(i);
+		vector<pair<size_t, unsigned>> indices;
+		for (auto const& expr: target.modelExpressions.first)
+			if (auto version = versions.find(expr.name); expr.arguments.empty() && version != versions.end())
+				indices.emplace_back(version->second);
+		call.targets.emplace_back(target, move(indices));
+	}
+	return call;
+}
+
+bool BMC::instantiateInlinedCall(InlinedCall const& _call, FunctionDefinition const& _function, FunctionCall const& _funCall)
+{
+	smtutil::Expression const assertions = m_context.assertions();
+	smtutil::Expression const pathCondition = currentPathConditions();
+	if (!replaceable(_call.assertions, assertions) || !replaceable(_call.pathCondition, pathCondition))
+		return false;
+	vector<string> const stateNames = state().currentNames();
+	for (auto const& name: _call.stateNames)
+		if (!contains(stateNames, name))
+			return false;
+
+	map<vector<smtutil::Expression> const*, smtutil::Expression> replaced;
+	if (!_call.assertions.arguments.empty())
+		replaced.emplace(_call.assertions.arguments.shared().get(), assertions);
+	if (!_call.pathCondition.arguments.empty())
+		replaced.emplace(_call.pathCondition.arguments.shared().get(), pathCondition);
+
+	// The variables keep their current index for the indices read by the call
+	// and get fresh indices for the ones created by the call.
+	map<string, smtutil::Expression> names;
+	vector<unsigned> entryIndices;
+	vector<unsigned> firstNewIndices;
+	for (auto const& variable: _call.variables)
+	{
+		auto& symbolicVariable = *variable.variable;
+		entryIndices.emplace_back(symbolicVariable.index());
+		firstNewIndices.emplace_back(symbolicVariable.nextIndex());
+		if (variable.entryIndex && *variable.entryIndex != entryIndices.back())
+			names.emplace(symbolicVariable.nameAtIndex(*variable.entryIndex), symbolicVariable.currentValue());
+		for (unsigned i = 0; i < variable.newIndices; ++i)
+			names.emplace(
+				symbolicVariable.nameAtIndex(variable.firstNewIndex + i),
+				symbolicVariable.valueAtIndex(firstNewIndices.back() + i)
+			);
+		if (variable.newIndices > 0)
+			symbolicVariable.setIndex(firstNewIndices.back() + variable.newIndices - 1);
+	}
+	auto newIndex = [&](size_t _variable, unsigned _index) {
+		auto const& variable = _call.variables.at(_variable);
+		if (variable.entryIndex && _index == *variable.entryIndex)
+			return entryIndices.at(_variable);
+		return firstNewIndices.at(_variable) + _index - variable.firstNewIndex;
+	};
+
+	for (auto const& added: _call.addedAssertions)
+	{
+		m_context.addAssertion(substitute(added.arguments.at(0), names, replaced));
+		replaced.emplace(added.arguments.shared().get(), m_context.assertions());
+	}
+
+	for (auto const& [recorded, indices]: _call.targets)
+	{
+		// The values in the counterexample are the ones of the variables when the target was created.
+		for (size_t i = 0; i < _call.variables.size(); ++i)
+			if (_call.variables.at(i).newIndices > 0)
+				_call.variables.at(i).variable->setIndex(entryIndices.at(i));
+		for (auto const& [variable, index]: indices)
+			_call.variables.at(variable).variable->setIndex(newIndex(variable, index));
+
+		auto callStack = m_callStack;
+		callStack.emplace_back(&_function, &_funCall);
+		callStack.insert(
+			callStack.end(),
+			recorded.callStack.begin() + static_cast<ptrdiff_t>(_call.callStackDepth + 1),
+			recorded.callStack.end()
+		);
+		m_verificationTargets.emplace_back(BMCVerificationTarget{
+			{
+				recorded.type,
+				substitute(recorded.value, names, replaced),
+				substitute(recorded.constraints, names, replaced)
+			},
+			recorded.expression,
+			move(callStack),
+			modelExpressions(),
+			substitute(recorded.context, names, replaced)
+		});
+	}
+
+	for (size_t i = 0; i < _call.variables.size(); ++i)
+		_call.variables.at(i).variable->setIndex(newIndex(i, _call.variables.at(i).exitIndex));
+	m_errorReporter.append(_call.errors);
+	m_loopExecutionHappened = m_loopExecutionHappened || _call.loopExecutionHappened;
+	m_externalFunctionCallHappened = m_externalFunctionCallHappened || _call.externalFunctionCallHappened;
+	m_arrayAssignmentHappened = m_arrayAssignmentHappened || _call.arrayAssignmentHappened;
+	return true;
+}
+
 void BMC::internalOrExternalFunctionCall(FunctionCall const& _funCall)
 {
 	auto const& funType = dynamic_cast<FunctionType const&>(*_funCall.expression().annotation().type);
@@ -627,6 +975,7 @@ void BMC::reset()
 {
 	m_externalFunctionCallHappened = false;
 	m_loopExecutionHappened = false;
+	m_inlinedCalls.clear();
 }
 
 pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
@@ -665,8 +1014,22 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets()
 {
+	size_t jobs = m_settings.jobs == 0 ? util::ThreadPool::hardwareConcurrency() : m_settings.jobs;
+	// Concurrent checks only pay off if there is a solver besides the SMT-LIB2 interface.
+	if (jobs <= 1 || m_verificationTargets.size() <= 1 || m_interface->solvers() <= 1)
+	{
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target);
+		releaseContext(*m_interface, m_assertedContext);
+		return;
+	}
+
+	m_deferredQueries.emplace();
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target);
+	vector<BMCQuery> queries = move(*m_deferredQueries);
+	m_deferredQueries.reset();
+	checkQueriesConcurrently(queries, jobs);
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -704,6 +1067,7 @@ void BMC::checkConstantCondition(BMCVerificationTarget& _target)
 {
 	checkBooleanNotConstant(
 		*_target.expression,
+		_target.context,
 		_target.constraints,
 		_target.value,
 		_target.callStack
@@ -731,6 +1095,7 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
+		_target.context,
 		_target.constraints && _target.value < smt::minValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
@@ -764,6 +1129,7 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
+		_target.context,
 		_target.constraints && _target.value > smt::maxValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
@@ -787,6 +1153,7 @@ void BMC::checkDivByZero(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
+		_target.context,
 		_target.constraints && (_target.value == 0),
 		_target.callStack,
 		_target.modelExpressions,
@@ -803,6 +1170,7 @@ void BMC::checkBalance(BMCVerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTargetType::Balance, "");
 	checkCondition(
+		_target.context,
 		_target.constraints && _target.value,
 		_target.callStack,
 		_target.modelExpressions,
@@ -825,6 +1193,7 @@ void BMC::checkAssert(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
+		_target.context,
 		_target.constraints && !_target.value,
 		_target.callStack,
 		_target.modelExpressions,
@@ -848,14 +1217,18 @@ void BMC::addVerificationTarget(
 		{
 			_type,
 			_value,
-			currentPathConditions() && m_context.assertions()
+			currentPathConditions()
 		},
 		_expression,
 		m_callStack,
-		modelExpressions()
+		modelExpressions(),
+		m_context.assertions()
 	};
 	if (_type == VerificationTargetType::ConstantCondition)
+	{
 		checkVerificationTarget(target);
+		releaseContext(*m_interface, m_assertedContext);
+	}
 	else
 		m_verificationTargets.emplace_back(move(target));
 }
@@ -863,6 +1236,7 @@ void BMC::addVerificationTarget(
 /// Solving.
 
 void BMC::checkCondition(
+	smtutil::Expression const& _context,
 	smtutil::Expression _condition,
 	vector<SMTEncoder::CallStackEntry> const& _callStack,
 	pair<vector<smtutil::Expression>, vector<string>> const& _modelExpressions,
@@ -874,22 +1248,45 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
-	vector<smtutil::Expression> expressionsToEvaluate;
-	vector<string> expressionNames;
-	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
+	BMCQuery query{
+		_context,
+		move(_condition),
+		_modelExpressions.first,
+		_modelExpressions.second,
+		_callStack,
+		_location,
+		_errorHappens,
+		_errorMightHappen,
+		_description
+	};
 	if (_callStack.size())
 		if (_additionalValue)
 		{
-			expressionsToEvaluate.emplace_back(*_additionalValue);
-			expressionNames.push_back(_additionalValueName);
+			query.expressionsToEvaluate.emplace_back(*_additionalValue);
+			query.expressionNames.push_back(_additionalValueName);
 		}
+
+	if (m_deferredQueries)
+	{
+		m_deferredQueries->emplace_back(move(query));
+		return;
+	}
+
+	auto const start = ModelCheckerStatistics::Clock::now();
+	assertContext(*m_interface, m_assertedContext, query.context);
+	m_interface->push();
+	m_interface->addAssertion(query.condition);
 	smtutil::CheckResult result;
 	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	tie(result, values) = checkSatisfiableAndGenerateModel(query.expressionsToEvaluate);
+	m_interface->pop();
+
+	recordQuery(query.description, query.location, {query.context, query.condition}, result, ModelCheckerStatistics::Clock::now() - start);
+	reportQuery(query, result, values);
+}
 
+void BMC::reportQuery(BMCQuery const& _query, smtutil::CheckResult _result, vector<string> const& _values)
+{
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
 		extraComment +=
@@ -905,30 +1302,30 @@ void BMC::checkCondition(
 	SecondarySourceLocation secondaryLocation{};
 	secondaryLocation.append(extraComment, SourceLocation{});
 
-	switch (result)
+	switch (_result)
 	{
 	case smtutil::CheckResult::SATISFIABLE:
 	{
-		solAssert(!_callStack.empty(), "");
+		solAssert(!_query.callStack.empty(), "");
 		std::ostringstream message;
-		message << "BMC: " << _description << " happens here.";
+		message << "BMC: " << _query.description << " happens here.";
 		std::ostringstream modelMessage;
 		modelMessage << "Counterexample:\n";
-		solAssert(values.size() == expressionNames.size(), "");
+		solAssert(_values.size() == _query.expressionNames.size(), "");
 		map<string, string> sortedModel;
-		for (size_t i = 0; i < values.size(); ++i)
-			if (expressionsToEvaluate.at(i).name != values.at(i))
-				sortedModel[expressionNames.at(i)] = values.at(i);
+		for (size_t i = 0; i < _values.size(); ++i)
+			if (_query.expressionsToEvaluate.at(i).name != _values.at(i))
+				sortedModel[_query.expressionNames.at(i)] = _values.at(i);
 
 		for (auto const& eval: sortedModel)
 			modelMessage << "  " << eval.first << " = " << eval.second << "\n";
 
 		m_errorReporter.warning(
-			_errorHappens,
-			_location,
+			_query.errorHappens,
+			_query.location,
 			message.str(),
 			SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
-			.append(SMTEncoder::callStackMessage(_callStack))
+			.append(SMTEncoder::callStackMessage(_query.callStack))
 			.append(move(secondaryLocation))
 		);
 		break;
@@ -936,21 +1333,101 @@ void BMC::checkCondition(
 	case smtutil::CheckResult::UNSATISFIABLE:
 		break;
 	case smtutil::CheckResult::UNKNOWN:
-		m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
+		m_errorReporter.warning(_query.errorMightHappen, _query.location, "BMC: " + _query.description + " might happen here.", secondaryLocation);
 		break;
 	case smtutil::CheckResult::CONFLICTING:
-		m_errorReporter.warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		m_errorReporter.warning(1584_error, _query.location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smtutil::CheckResult::ERROR:
-		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
+		m_errorReporter.warning(1823_error, _query.location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
+}
 
-	m_interface->pop();
+void BMC::recordQuery(
+	string const& _description,
+	SourceLocation const& _location,
+	vector<smtutil::Expression> const& _query,
+	smtutil::CheckResult _result,
+	ModelCheckerStatistics::Clock::duration _duration
+)
+{
+	if (!m_statistics)
+		return;
+	m_statistics->recordQuery({
+		"BMC",
+		_description,
+		_location,
+		ModelCheckerStatistics::expressionSize(_query),
+		joinHumanReadable(m_interface->solverNames(), ","),
+		_duration,
+		_result
+	});
+}
+
+void BMC::checkQueriesConcurrently(vector<BMCQuery> const& _queries, size_t _jobs)
+{
+	size_t const workerCount = min(_jobs, _queries.size());
+	// Solvers are created here because they set global options of the solver libraries.
+	// The SMT callback is not passed on because it cannot be assumed to be thread-safe.
+	while (m_workers.size() < workerCount)
+	{
+		m_workers.push_back({
+			make_unique<smtutil::SMTPortfolio>(m_smtlib2Responses, ReadCallback::Callback{}, m_enabledSolvers, m_settings.timeout),
+			0,
+			0
+		});
+		m_workers.back().solver->setRacing(true);
+		m_workers.back().solver->setQueryCache(m_queryCache);
+	}
+
+	auto const& declarations = m_interface->declarations();
+	vector<tuple<smtutil::CheckResult, vector<string>, optional<string>>> results(_queries.size());
+	vector<ModelCheckerStatistics::Clock::duration> durations(_queries.size());
+	util::ThreadPool pool{workerCount};
+	for (size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex)
+		pool.post([&, workerIndex]() {
+			BMCWorker& worker = m_workers[workerIndex];
+			for (; worker.declarations < declarations.size(); ++worker.declarations)
+				worker.solver->declareVariable(
+					declarations[worker.declarations].first,
+					declarations[worker.declarations].second
+				);
+			AssertedContext assertedContext;
+			for (size_t i = workerIndex; i < _queries.size(); i += workerCount)
+			{
+				auto const start = ModelCheckerStatistics::Clock::now();
+				assertContext(*worker.solver, assertedContext, _queries[i].context);
+				worker.solver->push();
+				worker.solver->addAssertion(_queries[i].condition);
+				results[i] = checkSatisfiableAndGenerateModel(*worker.solver, _queries[i].expressionsToEvaluate);
+				worker.solver->pop();
+				durations[i] = ModelCheckerStatistics::Clock::now() - start;
+			}
+			releaseContext(*worker.solver, assertedContext);
+		});
+	pool.wait();
+
+	for (BMCWorker& worker: m_workers)
+	{
+		vector<string> unhandled = worker.solver->unhandledQueries();
+		for (; worker.unhandledQueries < unhandled.size(); ++worker.unhandledQueries)
+			m_workerUnhandledQueries.emplace_back(move(unhandled[worker.unhandledQueries]));
+	}
+
+	for (size_t i = 0; i < _queries.size(); ++i)
+	{
+		auto const& [result, values, solverError] = results[i];
+		if (solverError)
+			m_errorReporter.warning(8140_error, *solverError);
+		recordQuery(_queries[i].description, _queries[i].location, {_queries[i].context, _queries[i].condition}, result, durations[i]);
+		reportQuery(_queries[i], result, values);
+	}
 }
 
 void BMC::checkBooleanNotConstant(
 	Expression const& _condition,
+	smtutil::Expression const& _context,
 	smtutil::Expression const& _constraints,
 	smtutil::Expression const& _value,
 	vector<SMTEncoder::CallStackEntry> const& _callStack
@@ -960,15 +1437,20 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
+	auto start = ModelCheckerStatistics::Clock::now();
+	assertContext(*m_interface, m_assertedContext, _context);
 	m_interface->push();
 	m_interface->addAssertion(_constraints && _value);
 	auto positiveResult = checkSatisfiable();
 	m_interface->pop();
+	recordQuery("Condition is always false", _condition.location(), {_context, _constraints && _value}, positiveResult, ModelCheckerStatistics::Clock::now() - start);
 
+	start = ModelCheckerStatistics::Clock::now();
 	m_interface->push();
 	m_interface->addAssertion(_constraints && !_value);
 	auto negatedResult = checkSatisfiable();
 	m_interface->pop();
+	recordQuery("Condition is always true", _condition.location(), {_context, _constraints && !_value}, negatedResult, ModelCheckerStatistics::Clock::now() - start);
 
 	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
 		m_errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
@@ -1009,19 +1491,32 @@ void BMC::checkBooleanNotConstant(
 
 pair<smtutil::CheckResult, vector<string>>
 BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
+{
+	auto [result, values, solverError] = checkSatisfiableAndGenerateModel(*m_interface, _expressionsToEvaluate);
+	if (solverError)
+		m_errorReporter.warning(8140_error, *solverError);
+	return make_pair(result, move(values));
+}
+
+tuple<smtutil::CheckResult, vector<string>, optional<string>>
+BMC::checkSatisfiableAndGenerateModel(
+	smtutil::SolverInterface& _solver,
+	vector<smtutil::Expression> const& _expressionsToEvaluate
+)
 {
 	smtutil::CheckResult result;
 	vector<string> values;
+	optional<string> solverError;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result, values) = _solver.check(_expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
 		string description("BMC: Error querying SMT solver");
 		if (_e.comment())
 			description += ": " + *_e.comment();
-		m_errorReporter.warning(8140_error, description);
+		solverError = move(description);
 		result = smtutil::CheckResult::ERROR;
 	}
 
@@ -1035,7 +1530,7 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 		catch (...) { }
 	}
 
-	return make_pair(result, values);
+	return {result, move(values), move(solverError)};
 }
 
 smtutil::CheckResult BMC::checkSatisfiable()
@@ -1043,6 +1538,47 @@ smtutil::CheckResult BMC::checkSatisfiable()
 	return checkSatisfiableAndGenerateModel({}).first;
 }
 
+void BMC::assertContext(
+	smtutil::SolverInterface& _solver,
+	AssertedContext& _asserted,
+	smtutil::Expression const& _context
+)
+{
+	if (_asserted.pushed && _asserted.conjunction)
+	{
+		vector<smtutil::Expression const*> added;
+		smtutil::Expression const* conjunction = &_context;
+		while (
+			conjunction->arguments.shared() != _asserted.conjunction &&
+			conjunction->name == "and" &&
+			conjunction->arguments.size() == 2
+		)
+		{
+			added.emplace_back(&conjunction->arguments.at(0));
+			conjunction = &conjunction->arguments.at(1);
+		}
+		if (conjunction->arguments.shared() == _asserted.conjunction)
+		{
+			for (auto const* assertion: added)
+				_solver.addAssertion(*assertion);
+			_asserted.conjunction = _context.arguments.shared();
+			return;
+		}
+	}
+
+	releaseContext(_solver, _asserted);
+	_solver.push();
+	_solver.addAssertion(_context);
+	_asserted = {true, _context.arguments.shared()};
+}
+
+void BMC::releaseContext(smtutil::SolverInterface& _solver, AssertedContext& _asserted)
+{
+	if (_asserted.pushed)
+		_solver.pop();
+	_asserted = {};
+}
+
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
 {
 	auto oldVar = _symVar.currentValue();
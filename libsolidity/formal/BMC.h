@@ -31,15 +31,19 @@
 
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/PotentialTargets.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/SMTPortfolio.h>
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <optional>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 using solidity::util::h256;
@@ -71,7 +75,9 @@ public:
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
-	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
+	std::vector<std::string> unhandledQueries();
+	/// @returns a script posing the unhandled queries of the main solver incrementally, if any.
+	std::string unhandledQueriesScript();
 
 	/// @returns true if _funCall should be inlined, otherwise false.
 	/// @param _scopeContract The contract that contains the current function being analyzed.
@@ -114,6 +120,19 @@ private:
 	/// Erases knowledge about state variables if external.
 	void internalOrExternalFunctionCall(FunctionCall const& _funCall);
 
+	/// Encoding of the body of an inlined function, recorded the first time the function
+	/// is inlined in a transaction and reused at its later call sites by renaming
+	/// the versions of the symbolic variables it reads and creates.
+	struct InlinedCall;
+	/// Encodes the body of @a _function called by @a _funCall and records the encoding.
+	/// @returns nullopt if the encoding cannot be reused.
+	std::optional<InlinedCall> recordInlinedCall(FunctionDefinition const& _function, FunctionCall const& _funCall);
+	/// Adds the encoding of @a _call to the current call site @a _funCall.
+	/// @returns false if the encoding does not apply to the call site.
+	bool instantiateInlinedCall(InlinedCall const& _call, FunctionDefinition const& _function, FunctionCall const& _funCall);
+	/// Encodes the body of @a _function called by @a _funCall.
+	void inlineFunctionBody(FunctionDefinition const& _function, FunctionCall const& _funCall);
+
 	/// Creates underflow/overflow verification targets.
 	std::pair<smtutil::Expression, smtutil::Expression> arithmeticOperation(
 		Token _op,
@@ -135,6 +154,9 @@ private:
 		Expression const* expression;
 		std::vector<CallStackEntry> callStack;
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions;
+		/// Assertions of the encoding context, which extend the ones of the targets created before.
+		/// `constraints` only contains the path conditions.
+		smtutil::Expression context;
 	};
 
 	void checkVerificationTargets();
@@ -154,8 +176,23 @@ private:
 
 	/// Solver related.
 	//@{
-	/// Check that a condition can be satisfied.
+	/// Satisfiability query of a verification target together with
+	/// the information needed to report its result.
+	struct BMCQuery
+	{
+		smtutil::Expression context;
+		smtutil::Expression condition;
+		std::vector<smtutil::Expression> expressionsToEvaluate;
+		std::vector<std::string> expressionNames;
+		std::vector<CallStackEntry> callStack;
+		langutil::SourceLocation location;
+		langutil::ErrorId errorHappens;
+		langutil::ErrorId errorMightHappen;
+		std::string description;
+	};
+	/// Check that a condition can be satisfied under the assertions @a _context.
 	void checkCondition(
+		smtutil::Expression const& _context,
 		smtutil::Expression _condition,
 		std::vector<CallStackEntry> const& _callStack,
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> const& _modelExpressions,
@@ -170,22 +207,116 @@ private:
 	/// is a literal constant.
 	void checkBooleanNotConstant(
 		Expression const& _condition,
+		smtutil::Expression const& _context,
 		smtutil::Expression const& _constraints,
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
+	/// Reports the result of @a _query.
+	void reportQuery(BMCQuery const& _query, smtutil::CheckResult _result, std::vector<std::string> const& _values);
+	/// Records a query of the solver for the target @a _description at @a _location
+	/// in the statistics, if they are requested.
+	void recordQuery(
+		std::string const& _description,
+		langutil::SourceLocation const& _location,
+		std::vector<smtutil::Expression> const& _query,
+		smtutil::CheckResult _result,
+		ModelCheckerStatistics::Clock::duration _duration
+	);
+	/// Solves @a _queries on up to @a _jobs worker solvers concurrently and reports
+	/// the results in the order of @a _queries.
+	void checkQueriesConcurrently(std::vector<BMCQuery> const& _queries, size_t _jobs);
 	std::pair<smtutil::CheckResult, std::vector<std::string>>
 	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	/// Like the above, but queries @a _solver and returns the description of a solver
+	/// error instead of reporting it, so that it can run concurrently on different solvers.
+	static std::tuple<smtutil::CheckResult, std::vector<std::string>, std::optional<std::string>>
+	checkSatisfiableAndGenerateModel(
+		smtutil::SolverInterface& _solver,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate
+	);
 
 	smtutil::CheckResult checkSatisfiable();
+
+	/// Assertions of the encoding context asserted on a solver in a level of its own,
+	/// below the levels of the single queries.
+	struct AssertedContext
+	{
+		bool pushed = false;
+		/// Identifies the asserted conjunction through the arguments shared by its copies.
+		std::shared_ptr<std::vector<smtutil::Expression> const> conjunction;
+	};
+	/// Makes @a _solver assert @a _context in the level of @a _asserted.
+	/// The encoding context only adds new assertions in front of the previous ones, so if
+	/// @a _context extends the asserted assertions only the new ones are asserted.
+	/// Otherwise, the level is replaced.
+	static void assertContext(
+		smtutil::SolverInterface& _solver,
+		AssertedContext& _asserted,
+		smtutil::Expression const& _context
+	);
+	/// Pops the level of @a _asserted from @a _solver. Has to be called before further
+	/// variables are declared, since declarations might be part of the current level.
+	static void releaseContext(smtutil::SolverInterface& _solver, AssertedContext& _asserted);
 	//@}
 
-	std::unique_ptr<smtutil::SolverInterface> m_interface;
+	std::unique_ptr<smtutil::SMTPortfolio> m_interface;
+	AssertedContext m_assertedContext;
+
+	/// Solver used to check verification targets concurrently. It is kept for the whole
+	/// analysis and only receives the declarations made since its last use.
+	struct BMCWorker
+	{
+		std::unique_ptr<smtutil::SMTPortfolio> solver;
+		size_t declarations = 0;
+		size_t unhandledQueries = 0;
+	};
+	std::vector<BMCWorker> m_workers;
+	/// Queries collected instead of being solved while checking the targets concurrently.
+	std::optional<std::vector<BMCQuery>> m_deferredQueries;
+	/// SMT-LIB2 queries the workers could not answer.
+	std::vector<std::string> m_workerUnhandledQueries;
+	std::map<h256, std::string> m_smtlib2Responses;
+	smtutil::SMTSolverChoice m_enabledSolvers;
 
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
 	bool m_externalFunctionCallHappened = false;
 
+	/// Symbolic variable used by the encoding of an inlined call.
+	struct InlinedVariable
+	{
+		std::shared_ptr<smt::SymbolicVariable> variable;
+		/// Index read by the call, unless the variable was created by the call.
+		std::optional<unsigned> entryIndex;
+		/// Indices created by the call.
+		unsigned firstNewIndex = 0;
+		unsigned newIndices = 0;
+		/// Index after the call.
+		unsigned exitIndex = 0;
+	};
+	struct InlinedCall
+	{
+		/// Assertions and path condition of the recorded call site.
+		smtutil::Expression assertions{true};
+		smtutil::Expression pathCondition{true};
+		/// Assertions added by the call, extending the previous ones, oldest first.
+		std::vector<smtutil::Expression> addedAssertions;
+		std::vector<InlinedVariable> variables;
+		/// Names of the values of the blockchain state read by the call, which are not renamed.
+		std::vector<std::string> stateNames;
+		size_t callStackDepth = 0;
+		/// Targets created by the call with the indices of `variables` at the time.
+		std::vector<std::pair<BMCVerificationTarget, std::vector<std::pair<size_t, unsigned>>>> targets;
+		langutil::ErrorList errors;
+		bool loopExecutionHappened = false;
+		bool externalFunctionCallHappened = false;
+		bool arrayAssignmentHappened = false;
+	};
+	/// Encodings of the functions inlined in the current transaction,
+	/// or nullopt if the encoding of a function cannot be reused.
+	std::map<FunctionDefinition const*, std::optional<InlinedCall>> m_inlinedCalls;
+
 	/// ErrorReporter that comes from CompilerStack.
 	langutil::ErrorReporter& m_outerErrorReporter;
 
@@ -195,6 +326,12 @@ private:
 	std::map<ASTNode const*, std::set<VerificationTargetType>> m_solvedTargets;
 
 	ModelCheckerSettings const& m_settings;
+
+	/// Determines the contracts and transactions in which no selected target can arise.
+	smt::PotentialTargets m_potentialTargets;
+
+	/// On-disk cache of solver results shared by all solvers, if enabled.
+	std::shared_ptr<smtutil::QueryCache const> m_queryCache;
 };
 
 }
@@ -30,7 +30,9 @@
 #include <libsolidity/ast/TypeProvider.h>
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
+#include <libsmtutil/QueryCache.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/range/adaptor/reversed.hpp>
 
@@ -38,6 +40,8 @@
 #include <z3_version.h>
 #endif
 
+#include <chrono>
+#include <numeric>
 #include <queue>
 
 using namespace std;
@@ -59,8 +63,13 @@ CHC::CHC(
 	SMTEncoder(_context),
 	m_outerErrorReporter(_errorReporter),
 	m_enabledSolvers(_enabledSolvers),
-	m_settings(_settings)
+	m_settings(_settings),
+	m_potentialTargets(_settings.targets),
+	m_remainingQueryTime(_settings.totalTimeout.value_or(0))
 {
+	if (m_settings.cacheDirectory)
+		m_queryCache = make_shared<QueryCache>(*m_settings.cacheDirectory);
+
 	bool usesZ3 = _enabledSolvers.z3;
 #ifdef HAVE_Z3
 	usesZ3 = usesZ3 && Z3Interface::available();
@@ -68,7 +77,10 @@ CHC::CHC(
 	usesZ3 = false;
 #endif
 	if (!usesZ3)
+	{
 		m_interface = make_unique<CHCSmtLib2Interface>(_smtlib2Responses, _smtCallback, m_settings.timeout);
+		m_interface->setQueryCache(m_queryCache);
+	}
 }
 
 void CHC::analyze(SourceUnit const& _source)
@@ -86,9 +98,33 @@ void CHC::analyze(SourceUnit const& _source)
 		for (auto const& source: _source.referencedSourceUnits(true))
 			sources.insert(source);
 		for (auto const* source: sources)
-			defineInterfacesAndSummaries(*source);
+			if (m_encodedSources.count(source))
+				defineVariables(*source);
+			else
+				defineInterfacesAndSummaries(*source);
 		for (auto const* source: sources)
-			source->accept(*this);
+			if (!m_encodedSources.count(source))
+			{
+				source->accept(*this);
+				m_encodedSources[source] = {move(m_queryPlaceholders), move(m_functionTargetIds), move(m_callGraph)};
+				m_queryPlaceholders.clear();
+				m_functionTargetIds.clear();
+				m_callGraph.clear();
+			}
+
+		/// Only the targets of the given source and the ones it references are checked,
+		/// even if the Horn system also contains other source units.
+		for (auto const* source: sources)
+		{
+			SourceEncoding const& encoding = m_encodedSources.at(source);
+			for (auto const& [node, placeholders]: encoding.queryPlaceholders)
+				for (auto const& placeholder: placeholders)
+					m_queryPlaceholders[node].push_back(placeholder);
+			for (auto const& [node, ids]: encoding.functionTargetIds)
+				m_functionTargetIds[node] += ids;
+			for (auto const& [node, called]: encoding.callGraph)
+				m_callGraph[node].insert(called.begin(), called.end());
+		}
 
 		checkVerificationTargets();
 	}
@@ -123,8 +159,22 @@ vector<string> CHC::unhandledQueries() const
 	return {};
 }
 
+string CHC::unhandledQueriesScript() const
+{
+	if (auto smtlib2 = dynamic_cast<CHCSmtLib2Interface const*>(m_interface.get()))
+		return smtlib2->unhandledQueriesScript();
+
+	return {};
+}
+
 bool CHC::visit(ContractDefinition const& _contract)
 {
+	// Libraries are always encoded, since the contracts calling them rely on their summaries.
+	if (!_contract.isLibrary() && !m_potentialTargets.contract(_contract))
+		return false;
+
+	if (m_statistics)
+		m_statistics->beginContract("CHC", _contract);
 	resetContractAnalysis();
 	initContract(_contract);
 	clearIndices(&_contract);
@@ -138,6 +188,9 @@ bool CHC::visit(ContractDefinition const& _contract)
 
 void CHC::endVisit(ContractDefinition const& _contract)
 {
+	if (!_contract.isLibrary() && !m_potentialTargets.contract(_contract))
+		return;
+
 	if (auto constructor = _contract.constructor())
 		constructor->accept(*this);
 
@@ -204,6 +257,8 @@ void CHC::endVisit(ContractDefinition const& _contract)
 	connectBlocks(m_currentBlock, interface(), txConstraints && errorFlag().currentValue() == 0);
 
 	SMTEncoder::endVisit(_contract);
+	if (m_statistics)
+		m_statistics->endContract();
 }
 
 bool CHC::visit(FunctionDefinition const& _function)
@@ -267,7 +322,10 @@ void CHC::endVisit(FunctionDefinition const& _function)
 		auto sum = summary(_function);
 		auto ifacePre = smt::interfacePre(*m_interfaces.at(m_currentContract), *m_currentContract, m_context);
 		auto txConstraints = state().txTypeConstraints() && state().txFunctionConstraints(_function);
-		m_queryPlaceholders[&_function].push_back({txConstraints && sum, errorFlag().currentValue(), ifacePre});
+		/// In modular mode the function is called in any state that respects the types
+		/// of the state variables, so the query does not depend on the other functions.
+		auto queryPre = m_settings.modular ? stateTypeConstraints(*m_currentContract) : ifacePre;
+		m_queryPlaceholders[&_function].push_back({txConstraints && sum, errorFlag().currentValue(), queryPre});
 		connectBlocks(ifacePre, interface(), txConstraints && sum && errorFlag().currentValue() == 0);
 	}
 
@@ -693,7 +751,7 @@ void CHC::externalFunctionCall(FunctionCall const& _funCall)
 	auto error = errorFlag().increaseIndex();
 
 	Predicate const& callPredicate = *createSymbolicBlock(
-		nondetInterfaceSort(*m_currentContract, state()),
+		nondetInterfaceSort(*m_currentContract, m_context),
 		"nondet_call_" + uniquePrefix(),
 		PredicateType::ExternalCallUntrusted,
 		&_funCall
@@ -830,26 +888,27 @@ void CHC::resetSourceAnalysis()
 {
 	m_safeTargets.clear();
 	m_unsafeTargets.clear();
-	m_functionTargetIds.clear();
-	m_verificationTargets.clear();
 	m_queryPlaceholders.clear();
+	m_functionTargetIds.clear();
 	m_callGraph.clear();
-	m_summaries.clear();
-	m_interfaces.clear();
-	m_nondetInterfaces.clear();
-	m_constructorSummaries.clear();
-	m_contractInitializers.clear();
-	Predicate::reset();
-	ArraySlicePredicate::reset();
-	m_blockCounter = 0;
 
 	bool usesZ3 = false;
 #ifdef HAVE_Z3
 	usesZ3 = m_enabledSolvers.z3 && Z3Interface::available();
 	if (usesZ3)
 	{
-		/// z3::fixedpoint does not have a reset mechanism, so we need to create another.
-		m_interface.reset(new Z3CHCInterface(m_settings.timeout));
+		/// The system built so far can only be extended if the sort of the state,
+		/// which depends on the abi.* calls of the analysed sources, did not change.
+		if (!m_encodedABISort || !(*m_encodedABISort == *state().abiSort()))
+		{
+			/// z3::fixedpoint does not have a reset mechanism, so we need to create another.
+			auto z3Interface = make_unique<Z3CHCInterface>(m_settings.timeout);
+			z3Interface->setQueryCache(m_queryCache);
+			z3Interface->setInvariantReuse(m_settings.reuseInvariants && m_queryCache);
+			m_interface = move(z3Interface);
+			resetEncoding();
+			m_encodedABISort = state().abiSort();
+		}
 		auto z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
 		solAssert(z3Interface, "");
 		m_context.setSolver(z3Interface->z3Interface());
@@ -860,12 +919,29 @@ void CHC::resetSourceAnalysis()
 		auto smtlib2Interface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
 		smtlib2Interface->reset();
 		solAssert(smtlib2Interface, "");
+		resetEncoding();
 		m_context.setSolver(smtlib2Interface->smtlib2Interface());
 	}
 
 	m_context.clear();
-	m_context.resetUniqueId();
 	m_context.setAssertionAccumulation(false);
+	m_context.setVariableSlicing(m_settings.slicing);
+}
+
+void CHC::resetEncoding()
+{
+	m_encodedSources.clear();
+	m_verificationTargets.clear();
+	m_summaries.clear();
+	m_interfaces.clear();
+	m_nondetInterfaces.clear();
+	m_constructorSummaries.clear();
+	m_contractInitializers.clear();
+	Predicate::reset();
+	ArraySlicePredicate::reset();
+	m_blockCounter = 0;
+	m_ruleNodes = 0;
+	m_context.resetUniqueId();
 }
 
 void CHC::resetContractAnalysis()
@@ -924,7 +1000,7 @@ set<unsigned> CHC::transactionVerificationTargetsIds(ASTNode const* _txRoot)
 
 SortPointer CHC::sort(FunctionDefinition const& _function)
 {
-	return functionBodySort(_function, m_currentContract, state());
+	return functionBodySort(_function, m_currentContract, m_context);
 }
 
 SortPointer CHC::sort(ASTNode const* _node)
@@ -933,7 +1009,7 @@ SortPointer CHC::sort(ASTNode const* _node)
 		return sort(*funDef);
 
 	solAssert(m_currentFunction, "");
-	return functionBodySort(*m_currentFunction, m_currentContract, state());
+	return functionBodySort(*m_currentFunction, m_currentContract, m_context);
 }
 
 Predicate const* CHC::createSymbolicBlock(SortPointer _sort, string const& _name, PredicateType _predType, ASTNode const* _node, ContractDefinition const* _contractContext)
@@ -943,14 +1019,35 @@ Predicate const* CHC::createSymbolicBlock(SortPointer _sort, string const& _name
 	return block;
 }
 
+void CHC::defineVariables(SourceUnit const& _source)
+{
+	for (auto const& node: _source.nodes())
+		if (auto const* contract = dynamic_cast<ContractDefinition const*>(node.get()))
+		{
+			for (auto const* var: stateVariablesIncludingInheritedAndPrivate(*contract))
+				if (!m_context.knownVariable(*var))
+					createVariable(*var);
+
+			for (auto const* function: contractFunctionsWithoutVirtual(*contract))
+			{
+				for (auto var: function->parameters())
+					createVariable(*var);
+				for (auto var: function->returnParameters())
+					createVariable(*var);
+				for (auto const* var: localVariablesIncludingModifiers(*function, contract))
+					createVariable(*var);
+			}
+		}
+}
+
 void CHC::defineInterfacesAndSummaries(SourceUnit const& _source)
 {
 	for (auto const& node: _source.nodes())
 		if (auto const* contract = dynamic_cast<ContractDefinition const*>(node.get()))
 		{
 			string suffix = contract->name() + "_" + to_string(contract->id());
-			m_interfaces[contract] = createSymbolicBlock(interfaceSort(*contract, state()), "interface_" + suffix, PredicateType::Interface, contract);
-			m_nondetInterfaces[contract] = createSymbolicBlock(nondetInterfaceSort(*contract, state()), "nondet_interface_" + suffix, PredicateType::NondetInterface, contract);
+			m_interfaces[contract] = createSymbolicBlock(interfaceSort(*contract, m_context), "interface_" + suffix, PredicateType::Interface, contract);
+			m_nondetInterfaces[contract] = createSymbolicBlock(nondetInterfaceSort(*contract, m_context), "nondet_interface_" + suffix, PredicateType::NondetInterface, contract);
 			m_constructorSummaries[contract] = createConstructorBlock(*contract, "summary_constructor");
 			m_contractInitializers[contract] = createConstructorBlock(*contract, "contract_initializer");
 
@@ -1092,7 +1189,7 @@ Predicate const* CHC::createBlock(ASTNode const* _node, PredicateType _predType,
 Predicate const* CHC::createSummaryBlock(FunctionDefinition const& _function, ContractDefinition const& _contract, PredicateType _type)
 {
 	return createSymbolicBlock(
-		functionSort(_function, &_contract, state()),
+		functionSort(_function, &_contract, m_context),
 		"summary_" + uniquePrefix() + "_" + predicateName(&_function, &_contract),
 		_type,
 		&_function,
@@ -1103,7 +1200,7 @@ Predicate const* CHC::createSummaryBlock(FunctionDefinition const& _function, Co
 Predicate const* CHC::createConstructorBlock(ContractDefinition const& _contract, string const& _prefix)
 {
 	return createSymbolicBlock(
-		constructorSort(_contract, state()),
+		constructorSort(_contract, m_context),
 		_prefix + "_" + contractSuffix(_contract) + "_" + uniquePrefix(),
 		PredicateType::ConstructorSummary,
 		&_contract,
@@ -1141,6 +1238,14 @@ smtutil::Expression CHC::initialConstraints(ContractDefinition const& _contract,
 	return conj;
 }
 
+smtutil::Expression CHC::stateTypeConstraints(ContractDefinition const& _contract)
+{
+	smtutil::Expression conj = smt::symbolicUnknownConstraints(state().thisAddress(0), TypeProvider::address());
+	for (auto var: stateVariablesIncludingInheritedAndPrivate(_contract))
+		conj = conj && smt::symbolicUnknownConstraints(m_context.variable(*var)->valueAtIndex(0), var->type());
+	return conj;
+}
+
 vector<smtutil::Expression> CHC::initialStateVariables()
 {
 	return stateVariablesAtIndex(0);
@@ -1155,7 +1260,7 @@ vector<smtutil::Expression> CHC::stateVariablesAtIndex(unsigned _index)
 vector<smtutil::Expression> CHC::stateVariablesAtIndex(unsigned _index, ContractDefinition const& _contract)
 {
 	return applyMap(
-		SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract),
+		m_context.predicateStateVariables(_contract),
 		[&](auto _var) { return valueAtIndex(*_var, _index); }
 	);
 }
@@ -1168,7 +1273,7 @@ vector<smtutil::Expression> CHC::currentStateVariables()
 
 vector<smtutil::Expression> CHC::currentStateVariables(ContractDefinition const& _contract)
 {
-	return applyMap(SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract), [this](auto _var) { return currentValue(*_var); });
+	return applyMap(m_context.predicateStateVariables(_contract), [this](auto _var) { return currentValue(*_var); });
 }
 
 string CHC::predicateName(ASTNode const* _node, ContractDefinition const* _contract)
@@ -1288,38 +1393,58 @@ smtutil::Expression CHC::predicate(FunctionCall const& _funCall)
 
 void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 {
+	if (m_statistics)
+		m_ruleNodes += ModelCheckerStatistics::expressionSize({_rule});
 	m_interface->addRule(_rule, _ruleName);
 }
 
 pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
+{
+	auto result = query(*m_interface, _query, m_settings.chcCounterexamples);
+	reportSolverFailure(result.first, _location);
+	return result;
+}
+
+pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(
+	CHCSolverInterface& _solver,
+	smtutil::Expression const& _query,
+	bool _counterexample
+)
 {
 	CheckResult result;
 	CHCSolverInterface::CexGraph cex;
-	tie(result, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
+	tie(result, cex) = _solver.query(_query);
+	bool const cexComplete = any_of(cex.nodes.begin(), cex.nodes.end(), [&](auto const& _node) {
+		return _node.second.name == _query.name;
+	});
+	if (result == CheckResult::SATISFIABLE && _counterexample && !cexComplete)
 	{
 #ifdef HAVE_Z3
 		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
 		// We now disable those optimizations and check whether we can still solve the problem.
-		auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(&_solver);
 		solAssert(spacer, "");
 		spacer->setSpacerOptions(false);
 
 		CheckResult resultNoOpt;
 		CHCSolverInterface::CexGraph cexNoOpt;
-		tie(resultNoOpt, cexNoOpt) = m_interface->query(_query);
+		tie(resultNoOpt, cexNoOpt) = _solver.query(_query);
 
 		if (resultNoOpt == CheckResult::SATISFIABLE)
 			cex = move(cexNoOpt);
 
 		spacer->setSpacerOptions(true);
 #endif
-		break;
 	}
+	return {result, cex};
+}
+
+void CHC::reportSolverFailure(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
 	case CheckResult::UNSATISFIABLE:
-		break;
 	case CheckResult::UNKNOWN:
 		break;
 	case CheckResult::CONFLICTING:
@@ -1329,7 +1454,6 @@ pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression c
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
 		break;
 	}
-	return {result, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -1392,6 +1516,18 @@ void CHC::checkVerificationTargets()
 			}
 	}
 
+	size_t jobs = m_settings.jobs == 0 ? util::ThreadPool::hardwareConcurrency() : m_settings.jobs;
+	// Only Z3 provides independent solver instances that can be queried concurrently
+	// and allows changing the timeout between queries.
+	// Stored invariants are only used by the solver instances created for these checks.
+	bool parallel = false;
+#ifdef HAVE_Z3
+	parallel =
+		((jobs > 1 && verificationTargets.size() > 1) || m_settings.totalTimeout || (m_settings.reuseInvariants && m_queryCache)) &&
+		dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+#endif
+	vector<CHCTargetReport> targetReports;
+
 	set<unsigned> checkedErrorIds;
 	for (auto const& target: verificationTargets)
 	{
@@ -1439,9 +1575,14 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		if (parallel)
+			targetReports.push_back({target, errorReporterId, errorType, errorType + " happens here.", errorType + " might happen here."});
+		else
+			checkAndReportTarget(target, errorReporterId, errorType, errorType + " happens here.", errorType + " might happen here.");
 		checkedErrorIds.insert(target.errorId);
 	}
+	if (parallel)
+		checkAndReportTargets(targetReports, jobs);
 
 	// There can be targets in internal functions that are not reachable from the external interface.
 	// These are safe by definition and are not even checked by the CHC engine, but this information
@@ -1466,6 +1607,7 @@ void CHC::checkVerificationTargets()
 void CHC::checkAndReportTarget(
 	CHCVerificationTarget const& _target,
 	ErrorId _errorReporterId,
+	string const& _description,
 	string _satMsg,
 	string _unknownMsg
 )
@@ -1475,15 +1617,158 @@ void CHC::checkAndReportTarget(
 
 	createErrorBlock();
 	connectBlocks(_target.value, error(), _target.constraints);
+	auto const start = ModelCheckerStatistics::Clock::now();
+	auto const& [result, model] = query(error(), _target.errorNode->location());
+	recordQuery(_target, _description, result, ModelCheckerStatistics::Clock::now() - start);
+	reportTarget(_target, _errorReporterId, _satMsg, _unknownMsg, result, model, error().name);
+}
+
+void CHC::checkAndReportTargets(vector<CHCTargetReport> const& _targets, size_t _jobs)
+{
+#ifdef HAVE_Z3
+	// All queries are added to the main solver before it is cloned,
+	// so that every clone can answer any of them.
+	vector<smtutil::Expression> errorPredicates;
+	for (auto const& report: _targets)
+	{
+		createErrorBlock();
+		connectBlocks(report.target.value, error(), report.target.constraints);
+		errorPredicates.push_back(error());
+	}
+
+	auto* z3Interface = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+	solAssert(z3Interface, "");
+	size_t const solverCount = max<size_t>(min(_jobs, _targets.size()), 1);
+	bool const reuseInvariants = m_settings.reuseInvariants && m_queryCache;
+	vector<unique_ptr<Z3CHCInterface>> clones;
+	vector<Z3CHCInterface*> solvers{z3Interface};
+	if (solverCount > 1 || reuseInvariants)
+	{
+		// Further clones copy the validated invariants of the first one.
+		solvers.clear();
+		for (size_t i = 0; i < solverCount; ++i)
+			solvers.emplace_back(clones.emplace_back((i == 0 ? z3Interface : solvers.front())->clone()).get());
+	}
+
+	using Clock = chrono::steady_clock;
+	optional<Clock::time_point> deadline;
+	unsigned queryTimeout = 0;
+	vector<pair<CheckResult, CHCSolverInterface::CexGraph>> results(_targets.size(), {CheckResult::UNKNOWN, {}});
+	// Targets checked in several rounds accumulate the time of all their queries.
+	vector<Clock::duration> durations(_targets.size(), Clock::duration::zero());
+	auto checkTarget = [&](Z3CHCInterface& _solver, size_t _index) {
+		if (deadline)
+		{
+			auto remaining = chrono::duration_cast<chrono::milliseconds>(*deadline - Clock::now()).count();
+			if (remaining <= 0)
+				return;
+			_solver.setQueryTimeout(static_cast<unsigned>(min<decltype(remaining)>(queryTimeout, remaining)));
+		}
+		auto const start = Clock::now();
+		results[_index] = query(_solver, errorPredicates[_index], m_settings.chcCounterexamples);
+		durations[_index] += Clock::now() - start;
+	};
+	auto checkTargets = [&](vector<size_t> const& _indices) {
+		if (solvers.size() == 1)
+		{
+			for (size_t index: _indices)
+				checkTarget(*solvers.front(), index);
+			return;
+		}
+		util::ThreadPool pool{solvers.size()};
+		for (size_t solverIndex = 0; solverIndex < solvers.size(); ++solverIndex)
+			pool.post([&, solverIndex]() {
+				for (size_t i = solverIndex; i < _indices.size(); i += solvers.size())
+					checkTarget(*solvers[solverIndex], _indices[i]);
+			});
+		pool.wait();
+	};
+
+	vector<size_t> unresolved(_targets.size());
+	iota(unresolved.begin(), unresolved.end(), 0);
+	if (!m_settings.totalTimeout)
+		checkTargets(unresolved);
+	else
+	{
+		// The timeout per query is at least the total timeout if it was not given.
+		solAssert(m_settings.timeout, "");
+		unsigned const maxQueryTimeout = *m_settings.timeout == 0 ? *m_settings.totalTimeout : *m_settings.timeout;
+		auto const start = Clock::now();
+		deadline = start + chrono::milliseconds(m_remainingQueryTime);
+		queryTimeout = min(initialQueryTimeout, maxQueryTimeout);
+		while (!unresolved.empty() && Clock::now() < *deadline)
+		{
+			checkTargets(unresolved);
+			// Targets are resolved if their query was answered or another query
+			// for the same node and type showed a violation.
+			set<pair<ASTNode const*, VerificationTargetType>> violated;
+			for (size_t i = 0; i < _targets.size(); ++i)
+				if (results[i].first == CheckResult::SATISFIABLE)
+					violated.emplace(_targets[i].target.errorNode, _targets[i].target.type);
+			vector<size_t> stillUnresolved;
+			for (size_t index: unresolved)
+				if (
+					results[index].first == CheckResult::UNKNOWN &&
+					!violated.count({_targets[index].target.errorNode, _targets[index].target.type})
+				)
+					stillUnresolved.push_back(index);
+			unresolved = move(stillUnresolved);
+
+			if (queryTimeout == maxQueryTimeout)
+				break;
+			queryTimeout = queryTimeout > maxQueryTimeout / 2 ? maxQueryTimeout : 2 * queryTimeout;
+		}
+		auto elapsed = static_cast<unsigned>(chrono::duration_cast<chrono::milliseconds>(Clock::now() - start).count());
+		m_remainingQueryTime -= min(elapsed, m_remainingQueryTime);
+	}
+	if (reuseInvariants)
+		for (auto const* solver: solvers)
+			solver->storeInvariants();
+
+	// Report in the original order and skip targets already shown to be unsafe,
+	// which makes the output identical to the sequential check.
+	for (size_t i = 0; i < _targets.size(); ++i)
+	{
+		auto const& report = _targets[i];
+		recordQuery(report.target, report.description, results[i].first, durations[i]);
+		if (m_unsafeTargets.count(report.target.errorNode) && m_unsafeTargets.at(report.target.errorNode).count(report.target.type))
+			continue;
+		reportSolverFailure(results[i].first, report.target.errorNode->location());
+		reportTarget(
+			report.target,
+			report.errorReporterId,
+			report.satMsg,
+			report.unknownMsg,
+			results[i].first,
+			results[i].second,
+			errorPredicates[i].name
+		);
+	}
+#else
+	solAssert(false, "Concurrent CHC queries require Z3.");
+	(void)_targets;
+	(void)_jobs;
+#endif
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	ErrorId _errorReporterId,
+	string const& _satMsg,
+	string const& _unknownMsg,
+	CheckResult _result,
+	CHCSolverInterface::CexGraph const& _cex,
+	string const& _errorPredicate
+)
+{
 	auto const& location = _target.errorNode->location();
-	auto const& [result, model] = query(error(), location);
-	if (result == CheckResult::UNSATISFIABLE)
+	if (_result == CheckResult::UNSATISFIABLE)
 		m_safeTargets[_target.errorNode].insert(_target.type);
-	else if (result == CheckResult::SATISFIABLE)
+	else if (_result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
 		m_unsafeTargets[_target.errorNode].insert(_target.type);
-		auto cex = generateCounterexample(model, error().name);
+		auto cex = generateCounterexample(_cex, _errorPredicate);
 		if (cex)
 			m_errorReporter.warning(
 				_errorReporterId,
@@ -1505,6 +1790,26 @@ void CHC::checkAndReportTarget(
 		);
 }
 
+void CHC::recordQuery(
+	CHCVerificationTarget const& _target,
+	string const& _description,
+	CheckResult _result,
+	ModelCheckerStatistics::Clock::duration _duration
+)
+{
+	if (!m_statistics)
+		return;
+	m_statistics->recordQuery({
+		"CHC",
+		_description,
+		_target.errorNode->location(),
+		m_ruleNodes,
+		dynamic_cast<CHCSmtLib2Interface const*>(m_interface.get()) ? "smtlib2" : "z3",
+		_duration,
+		_result
+	});
+}
+
 /**
 The counterexample DAG has the following properties:
 1) The root node represents the reachable error predicate.
@@ -1547,8 +1852,10 @@ optional<string> CHC::generateCounterexample(CHCSolverInterface::CexGraph const&
 	auto nodeArgs = [&](auto _node) { return _graph.nodes.at(_node).arguments; };
 
 	bool first = true;
+	optional<unsigned> firstTransaction;
 	for (auto summaryId: callGraph.at(*rootId))
 	{
+		firstTransaction = summaryId;
 		CHCSolverInterface::CexNode const& summaryNode = _graph.nodes.at(summaryId);
 		Predicate const* summaryPredicate = Predicate::predicate(summaryNode.name);
 		auto const& summaryArgs = summaryNode.arguments;
@@ -1614,6 +1921,17 @@ optional<string> CHC::generateCounterexample(CHCSolverInterface::CexGraph const&
 		path.emplace_back(boost::algorithm::join(calls, "\n"));
 	}
 
+	/// In modular mode the trace starts with a function called in an arbitrary state.
+	if (m_settings.modular && firstTransaction)
+		if (Predicate const* firstPredicate = nodePred(*firstTransaction); firstPredicate->isFunctionSummary())
+		{
+			auto stateVars = firstPredicate->stateVariables();
+			solAssert(stateVars.has_value(), "");
+			auto modelMsg = formatVariableModel(*stateVars, firstPredicate->summaryPreStateValues(nodeArgs(*firstTransaction)), ", ");
+			if (!modelMsg.empty())
+				path.emplace_back("State: " + modelMsg);
+		}
+
 	return localState + "\nTransaction trace:\n" + boost::algorithm::join(boost::adaptors::reverse(path), "\n");
 }
 
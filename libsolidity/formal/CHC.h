@@ -32,6 +32,7 @@
 #pragma once
 
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/PotentialTargets.h>
 #include <libsolidity/formal/Predicate.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
@@ -69,6 +70,8 @@ public:
 	/// @returns a list of inputs to the Horn solver that were not part of the argument to
 	/// the constructor.
 	std::vector<std::string> unhandledQueries() const;
+	/// @returns a script posing all unhandled queries incrementally, if any.
+	std::string unhandledQueriesScript() const;
 
 private:
 	/// Visitor functions.
@@ -109,7 +112,11 @@ private:
 
 	/// Helpers.
 	//@{
+	/// Prepares the analysis of a source unit, keeping the encoding of
+	/// the source units analysed before if it can be extended.
 	void resetSourceAnalysis();
+	/// Discards the Horn system and all predicates.
+	void resetEncoding();
 	void resetContractAnalysis();
 	void eraseKnowledge();
 	void clearIndices(ContractDefinition const* _contract, FunctionDefinition const* _function = nullptr) override;
@@ -128,8 +135,12 @@ private:
 	/// @returns a new block of given _sort and _name.
 	Predicate const* createSymbolicBlock(smtutil::SortPointer _sort, std::string const& _name, PredicateType _predType, ASTNode const* _node = nullptr, ContractDefinition const* _contractContext = nullptr);
 
-	/// Creates summary predicates for all functions of all contracts
-	/// in a given _source.
+	/// Creates the variables of all contracts in a given _source
+	/// whose predicates were already created.
+	void defineVariables(SourceUnit const& _source);
+
+	/// Creates the variables and summary predicates for all functions
+	/// of all contracts in a given _source.
 	void defineInterfacesAndSummaries(SourceUnit const& _source);
 
 	/// Creates a CHC system that, for a given contract,
@@ -167,6 +178,9 @@ private:
 
 	/// @returns The initial constraints that set up the beginning of a function.
 	smtutil::Expression initialConstraints(ContractDefinition const& _contract, FunctionDefinition const* _function = nullptr);
+	/// @returns the constraints the types of the state variables of _contract put
+	/// on their values at the beginning of the current transaction.
+	smtutil::Expression stateTypeConstraints(ContractDefinition const& _contract);
 
 	/// @returns the symbolic values of the state variables at the beginning
 	/// of the current transaction.
@@ -199,6 +213,18 @@ private:
 	/// @returns <true, empty> if query is unsatisfiable (safe).
 	/// @returns <false, model> otherwise.
 	std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Runs @a _query on @a _solver without reporting anything.
+	/// If the query is satisfiable and @a _counterexample is true, but the counterexample
+	/// does not contain the queried predicate, the query is run again without Spacer's
+	/// preprocessing to obtain a complete counterexample.
+	/// Only touches @a _solver and can therefore run concurrently on different solvers.
+	static std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph> query(
+		smtutil::CHCSolverInterface& _solver,
+		smtutil::Expression const& _query,
+		bool _counterexample
+	);
+	/// Reports a warning if @a _result signals that the solvers failed.
+	void reportSolverFailure(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -209,9 +235,37 @@ private:
 	void checkAndReportTarget(
 		CHCVerificationTarget const& _target,
 		langutil::ErrorId _errorReporterId,
+		std::string const& _description,
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	// Forward declaration. Definition is below.
+	struct CHCTargetReport;
+	/// Checks @a _targets using up to @a _jobs clones of the Z3 Horn solver concurrently
+	/// and reports the results in the same order and form as checkAndReportTarget.
+	/// If a total timeout is given, the targets are checked in rounds with doubling
+	/// timeouts, starting at initialQueryTimeout, until all of them are resolved or
+	/// the remaining time is used up.
+	void checkAndReportTargets(std::vector<CHCTargetReport> const& _targets, size_t _jobs);
+	/// Records the result of the query for @a _target whose error predicate is called
+	/// @a _errorPredicate and reports violations.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg,
+		smtutil::CheckResult _result,
+		smtutil::CHCSolverInterface::CexGraph const& _cex,
+		std::string const& _errorPredicate
+	);
+	/// Records the query for @a _target, whose type is described by @a _description,
+	/// in the statistics, if they are requested.
+	void recordQuery(
+		CHCVerificationTarget const& _target,
+		std::string const& _description,
+		smtutil::CheckResult _result,
+		ModelCheckerStatistics::Clock::duration _duration
+	);
 
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
 
@@ -299,6 +353,16 @@ private:
 		ASTNode const* const errorNode;
 	};
 
+	/// Verification target together with the messages used to report its result.
+	struct CHCTargetReport
+	{
+		CHCVerificationTarget target;
+		langutil::ErrorId errorReporterId;
+		std::string description;
+		std::string satMsg;
+		std::string unknownMsg;
+	};
+
 	/// Query placeholder stores information necessary to create the final query edge in the CHC system.
 	/// It is combined with the unique error id (and error type) to create a complete Verification Target.
 	struct CHCQueryPlaceholder
@@ -332,12 +396,32 @@ private:
 
 	std::map<ASTNode const*, std::set<ASTNode const*, smt::EncodingContext::IdCompare>, smt::EncodingContext::IdCompare> m_callGraph;
 
+	/// Query placeholders, targets and calls collected while encoding a source unit.
+	struct SourceEncoding
+	{
+		std::map<ASTNode const*, std::vector<CHCQueryPlaceholder>, smt::EncodingContext::IdCompare> queryPlaceholders;
+		std::map<ASTNode const*, std::vector<unsigned>, smt::EncodingContext::IdCompare> functionTargetIds;
+		std::map<ASTNode const*, std::set<ASTNode const*, smt::EncodingContext::IdCompare>, smt::EncodingContext::IdCompare> callGraph;
+	};
+	/// Source units whose contracts are part of the current Horn system.
+	/// Sources are analysed in import order, so that base contracts and libraries
+	/// shared by several source units are only encoded once and later source units
+	/// just add the rules of their own contracts.
+	/// This is only done with the integrated z3, since the queries sent through
+	/// the SMT callback have to stay the same.
+	std::map<SourceUnit const*, SourceEncoding, smt::EncodingContext::IdCompare> m_encodedSources;
+	/// Sort of the abi.* functions the encoded source units were built with.
+	smtutil::SortPointer m_encodedABISort;
+
 	/// The current block.
 	smtutil::Expression m_currentBlock = smtutil::Expression(true);
 
 	/// Counter to generate unique block names.
 	unsigned m_blockCounter = 0;
 
+	/// Number of nodes of the rules added to the Horn system, counted if statistics are requested.
+	size_t m_ruleNodes = 0;
+
 	/// Whether a function call was seen in the current scope.
 	bool m_unknownFunctionCallSeen = false;
 
@@ -370,6 +454,17 @@ private:
 	smtutil::SMTSolverChoice m_enabledSolvers;
 
 	ModelCheckerSettings const& m_settings;
+
+	/// On-disk cache of solver results, if enabled.
+	std::shared_ptr<smtutil::QueryCache const> m_queryCache;
+
+	/// Determines the contracts in which no selected target can arise.
+	smt::PotentialTargets m_potentialTargets;
+
+	/// Timeout in milliseconds of the first round of queries if a total timeout is given.
+	static unsigned const initialQueryTimeout = 100;
+	/// Time in milliseconds left of the total timeout, shared by all analyzed source units.
+	unsigned m_remainingQueryTime = 0;
 };
 
 }
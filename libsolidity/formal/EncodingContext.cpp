@@ -18,7 +18,9 @@
 
 #include <libsolidity/formal/EncodingContext.h>
 
+#include <libsolidity/formal/SMTEncoder.h>
 #include <libsolidity/formal/SymbolicTypes.h>
+#include <libsolidity/formal/VariableUsage.h>
 
 using namespace std;
 using namespace solidity;
@@ -219,3 +221,41 @@ void EncodingContext::addAssertion(smtutil::Expression const& _expr)
 	else
 		m_assertions.back() = _expr && move(m_assertions.back());
 }
+
+/// Predicate arguments.
+
+vector<frontend::VariableDeclaration const*> EncodingContext::predicateStateVariables(frontend::ContractDefinition const& _contract)
+{
+	auto variables = frontend::SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract);
+	if (!m_variableSlicing)
+		return variables;
+
+	auto influencing = m_contractVariables.find(&_contract);
+	if (influencing == m_contractVariables.end())
+		influencing = m_contractVariables.emplace(&_contract, InfluencingVariables{}.contractVariables(_contract)).first;
+	vector<frontend::VariableDeclaration const*> sliced;
+	for (auto const* variable: variables)
+		if (influencing->second.count(variable))
+			sliced.push_back(variable);
+	return sliced;
+}
+
+vector<frontend::VariableDeclaration const*> EncodingContext::predicateLocalVariables(
+	frontend::FunctionDefinition const& _function,
+	frontend::ContractDefinition const* _contract
+)
+{
+	auto variables = frontend::SMTEncoder::localVariablesIncludingModifiers(_function, _contract);
+	if (!m_variableSlicing)
+		return variables;
+
+	auto key = make_pair(&_function, _contract);
+	auto influencing = m_functionVariables.find(key);
+	if (influencing == m_functionVariables.end())
+		influencing = m_functionVariables.emplace(key, InfluencingVariables{}.functionVariables(_function, _contract)).first;
+	vector<frontend::VariableDeclaration const*> sliced;
+	for (auto const* variable: variables)
+		if (influencing->second.count(variable))
+			sliced.push_back(variable);
+	return sliced;
+}
@@ -24,6 +24,8 @@
 #include <libsmtutil/SolverInterface.h>
 
 #include <map>
+#include <set>
+#include <vector>
 
 namespace solidity::frontend::smt
 {
@@ -44,6 +46,8 @@ public:
 	void resetUniqueId();
 	/// Returns the current fresh slack id and increments it.
 	unsigned newUniqueId();
+	/// Returns the fresh slack id that is handed out next.
+	unsigned nextUniqueId() const { return m_nextUniqueId; }
 	/// Clears the entire context, erasing everything.
 	/// To be used before a model checking engine starts.
 	void clear();
@@ -152,6 +156,21 @@ public:
 
 	SymbolicState& state() { return m_state; }
 
+	/// Predicate arguments.
+	//@{
+	/// Sets whether the predicates of the CHC engine only range over the variables
+	/// that can influence the verification targets.
+	void setVariableSlicing(bool _slicing) { m_variableSlicing = _slicing; }
+	/// @returns the state variables of @a _contract and its bases that are arguments of its predicates.
+	std::vector<frontend::VariableDeclaration const*> predicateStateVariables(frontend::ContractDefinition const& _contract);
+	/// @returns the local variables of @a _function, including the ones of its modifiers,
+	/// that are arguments of the predicates of its blocks.
+	std::vector<frontend::VariableDeclaration const*> predicateLocalVariables(
+		frontend::FunctionDefinition const& _function,
+		frontend::ContractDefinition const* _contract
+	);
+	//@}
+
 private:
 	/// Symbolic expressions.
 	//{@
@@ -183,6 +202,16 @@ private:
 
 	/// Central source of unique ids.
 	unsigned m_nextUniqueId = 0;
+
+	/// Whether the predicates only range over the variables that influence the verification targets.
+	bool m_variableSlicing = false;
+	/// The variables influencing each contract and each function in the context of a contract.
+	/// They only depend on the AST and are therefore kept when the context is cleared.
+	std::map<frontend::ContractDefinition const*, std::set<frontend::VariableDeclaration const*>> m_contractVariables;
+	std::map<
+		std::pair<frontend::FunctionDefinition const*, frontend::ContractDefinition const*>,
+		std::set<frontend::VariableDeclaration const*>
+	> m_functionVariables;
 };
 
 }
@@ -27,6 +27,22 @@ using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+ModelCheckerSettings normalizedSettings(ModelCheckerSettings _settings)
+{
+	if (_settings.totalTimeout == 0u)
+		_settings.totalTimeout.reset();
+	// Without a timeout per query, the queries would be bounded by the
+	// deterministic resource limit, which cannot be raised between queries.
+	if (_settings.totalTimeout && !_settings.timeout)
+		_settings.timeout = _settings.totalTimeout;
+	return _settings;
+}
+
+}
+
 ModelChecker::ModelChecker(
 	ErrorReporter& _errorReporter,
 	map<h256, string> const& _smtlib2Responses,
@@ -34,11 +50,16 @@ ModelChecker::ModelChecker(
 	ReadCallback::Callback const& _smtCallback,
 	smtutil::SMTSolverChoice _enabledSolvers
 ):
-	m_settings(_settings),
+	m_settings(normalizedSettings(move(_settings))),
 	m_context(),
 	m_bmc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings),
 	m_chc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings)
 {
+	if (m_settings.showStats)
+	{
+		m_bmc.setStatistics(&m_statistics);
+		m_chc.setStatistics(&m_statistics);
+	}
 }
 
 void ModelChecker::analyze(SourceUnit const& _source)
@@ -62,6 +83,15 @@ vector<string> ModelChecker::unhandledQueries()
 	return m_bmc.unhandledQueries() + m_chc.unhandledQueries();
 }
 
+vector<string> ModelChecker::unhandledQueriesScripts()
+{
+	vector<string> scripts;
+	for (string script: {m_bmc.unhandledQueriesScript(), m_chc.unhandledQueriesScript()})
+		if (!script.empty())
+			scripts.emplace_back(move(script));
+	return scripts;
+}
+
 solidity::smtutil::SMTSolverChoice ModelChecker::availableSolvers()
 {
 	smtutil::SMTSolverChoice available = smtutil::SMTSolverChoice::None();
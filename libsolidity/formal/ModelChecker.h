@@ -27,6 +27,7 @@
 #include <libsolidity/formal/CHC.h>
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
@@ -61,6 +62,12 @@ public:
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
 	std::vector<std::string> unhandledQueries();
+	/// @returns one SMT-LIB2 script per engine that poses its unhandled queries
+	/// incrementally, each preceded by an echo of its hash.
+	std::vector<std::string> unhandledQueriesScripts();
+
+	/// @returns the statistics collected so far, which are empty unless requested in the settings.
+	ModelCheckerStatistics const& statistics() const { return m_statistics; }
 
 	/// @returns SMT solvers that are available via the C++ API.
 	static smtutil::SMTSolverChoice availableSolvers();
@@ -71,6 +78,8 @@ private:
 	/// Stores the context of the encoding.
 	smt::EncodingContext m_context;
 
+	ModelCheckerStatistics m_statistics;
+
 	/// Bounded Model Checker engine.
 	BMC m_bmc;
 
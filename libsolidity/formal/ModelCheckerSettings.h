@@ -22,6 +22,7 @@
 
 #include <optional>
 #include <set>
+#include <string>
 
 namespace solidity::frontend
 {
@@ -72,6 +73,29 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::All();
 	ModelCheckerTargets targets = ModelCheckerTargets::All();
 	std::optional<unsigned> timeout;
+	/// Number of verification targets checked in parallel, 0 meaning one per hardware thread.
+	unsigned jobs = 1;
+	/// Directory of the on-disk cache of solver results, if any.
+	std::optional<std::string> cacheDirectory;
+	/// Whether CHC checks every public function in isolation, starting from an arbitrary
+	/// state instead of the states reachable through the transactions of the contract.
+	bool modular = false;
+	/// Whether CHC queries violated targets a second time without Spacer's preprocessing
+	/// to report a counterexample, which the first answer usually does not contain.
+	bool chcCounterexamples = true;
+	/// Whether the CHC predicates only range over the state and local variables that can
+	/// influence the verification targets, leaving out the ones that are only written to.
+	bool slicing = false;
+	/// Whether CHC stores the invariants Z3 found for its predicates in the cache directory
+	/// and starts later checks from the stored invariants that are still inductive.
+	bool reuseInvariants = false;
+	/// Overall limit in milliseconds on the time CHC spends checking verification targets, if any.
+	/// If given, CHC first checks all targets with a short timeout and then checks the ones left
+	/// unresolved again with doubling timeouts, up to `timeout`, until the limit is reached.
+	std::optional<unsigned> totalTimeout;
+	/// Whether statistics on the queries of the verification targets and the encoding
+	/// of the contracts are collected.
+	bool showStats = false;
 };
 
 }
@@ -0,0 +1,195 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/ModelCheckerStatistics.h>
+
+#include <libsolidity/ast/AST.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <set>
+#include <sstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace
+{
+
+double toMilliseconds(ModelCheckerStatistics::Clock::duration _duration)
+{
+	return chrono::duration<double, milli>(_duration).count();
+}
+
+string resultName(smtutil::CheckResult _result)
+{
+	switch (_result)
+	{
+	case smtutil::CheckResult::SATISFIABLE: return "sat";
+	case smtutil::CheckResult::UNSATISFIABLE: return "unsat";
+	case smtutil::CheckResult::UNKNOWN: return "unknown";
+	case smtutil::CheckResult::CONFLICTING: return "conflicting";
+	case smtutil::CheckResult::ERROR: return "error";
+	}
+	solAssert(false, "");
+}
+
+string locationName(SourceLocation const& _location)
+{
+	if (!_location.hasText())
+		return "-";
+	auto [line, column] = _location.source->translatePositionToLineColumn(_location.start);
+	return _location.source->name() + ":" + to_string(line + 1) + ":" + to_string(column + 1);
+}
+
+}
+
+void ModelCheckerStatistics::beginContract(string _engine, ContractDefinition const& _contract)
+{
+	solAssert(!m_contractStart, "");
+	m_contracts.push_back({move(_engine), _contract.name()});
+	m_contractStart = Clock::now();
+}
+
+void ModelCheckerStatistics::endContract()
+{
+	solAssert(m_contractStart && !m_contracts.empty(), "");
+	Contract& contract = m_contracts.back();
+	contract.encodingDuration = Clock::now() - *m_contractStart - contract.queryDuration;
+	m_contractStart.reset();
+}
+
+void ModelCheckerStatistics::recordQuery(Query _query)
+{
+	if (m_contractStart)
+		m_contracts.back().queryDuration += _query.duration;
+	m_queries.emplace_back(move(_query));
+}
+
+Json::Value ModelCheckerStatistics::toJson() const
+{
+	Json::Value queries(Json::arrayValue);
+	for (Query const& query: m_queries)
+	{
+		Json::Value entry(Json::objectValue);
+		entry["engine"] = query.engine;
+		entry["target"] = query.target;
+		if (query.location.hasText())
+		{
+			entry["sourceLocation"] = Json::objectValue;
+			entry["sourceLocation"]["file"] = query.location.source->name();
+			entry["sourceLocation"]["start"] = query.location.start;
+			entry["sourceLocation"]["end"] = query.location.end;
+		}
+		entry["size"] = Json::UInt64(query.size);
+		entry["solver"] = query.solver;
+		entry["wallTimeMs"] = toMilliseconds(query.duration);
+		entry["result"] = resultName(query.result);
+		queries.append(move(entry));
+	}
+
+	Json::Value contracts(Json::arrayValue);
+	for (Contract const& contract: m_contracts)
+	{
+		Json::Value entry(Json::objectValue);
+		entry["engine"] = contract.engine;
+		entry["contract"] = contract.name;
+		entry["encodingTimeMs"] = toMilliseconds(contract.encodingDuration);
+		entry["queryTimeMs"] = toMilliseconds(contract.queryDuration);
+		contracts.append(move(entry));
+	}
+
+	Json::Value result(Json::objectValue);
+	result["queries"] = move(queries);
+	result["contracts"] = move(contracts);
+	return result;
+}
+
+string ModelCheckerStatistics::toString() const
+{
+	vector<size_t> order(m_queries.size());
+	iota(order.begin(), order.end(), 0);
+	stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+		return m_queries[_a].duration > m_queries[_b].duration;
+	});
+
+	size_t constexpr locationWidth = 32;
+	size_t constexpr targetWidth = 40;
+	auto shorten = [](string _text, size_t _width) {
+		if (_text.size() >= _width)
+			_text = _text.substr(0, _width - 4) + "...";
+		return _text;
+	};
+
+	ostringstream out;
+	out << left << setw(8) << "Engine" <<
+		setw(locationWidth) << "Location" <<
+		setw(targetWidth) << "Target" << right <<
+		setw(10) << "Size" << "  " << left <<
+		setw(18) << "Solver" << right <<
+		setw(14) << "Wall time" << "  " << left <<
+		"Result" << endl;
+	for (size_t index: order)
+	{
+		Query const& query = m_queries[index];
+		out << left << setw(8) << query.engine <<
+			setw(locationWidth) << shorten(locationName(query.location), locationWidth) <<
+			setw(targetWidth) << shorten(query.target, targetWidth) << right <<
+			setw(10) << query.size << "  " << left <<
+			setw(18) << query.solver << right <<
+			setw(11) << fixed << setprecision(3) << toMilliseconds(query.duration) << " ms" << "  " << left <<
+			resultName(query.result) << endl;
+	}
+
+	out << endl << left << setw(8) << "Engine" <<
+		setw(locationWidth) << "Contract" << right <<
+		setw(14) << "Encoding" <<
+		setw(14) << "Queries" << endl;
+	for (Contract const& contract: m_contracts)
+		out << left << setw(8) << contract.engine <<
+			setw(locationWidth) << shorten(contract.name, locationWidth) << right <<
+			setw(11) << fixed << setprecision(3) << toMilliseconds(contract.encodingDuration) << " ms" <<
+			setw(11) << fixed << setprecision(3) << toMilliseconds(contract.queryDuration) << " ms" << endl;
+	return out.str();
+}
+
+size_t ModelCheckerStatistics::expressionSize(vector<smtutil::Expression> const& _expressions)
+{
+	set<void const*> visited;
+	vector<smtutil::Expression const*> toVisit;
+	for (auto const& expression: _expressions)
+		toVisit.push_back(&expression);
+	size_t size = 0;
+	while (!toVisit.empty())
+	{
+		smtutil::Expression const* expression = toVisit.back();
+		toVisit.pop_back();
+		if (!expression->arguments.empty() && !visited.insert(expression->arguments.shared().get()).second)
+			continue;
+		++size;
+		for (auto const& argument: expression->arguments)
+			toVisit.push_back(&argument);
+	}
+	return size;
+}
@@ -0,0 +1,103 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <liblangutil/SourceLocation.h>
+#include <libsmtutil/SolverInterface.h>
+
+#include <json/json.h>
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+class ContractDefinition;
+
+/**
+ * Statistics on the performance of the model checking engines, which are collected if
+ * `ModelCheckerSettings::showStats` is set.
+ *
+ * Every solver query made for a verification target is recorded with the engine,
+ * the size of the query, the solvers that were asked, the wall-clock time and the answer.
+ * For every contract, the time the engine spent on its encoding is recorded, which is the
+ * time spent on the contract minus the time of the queries made in between.
+ */
+class ModelCheckerStatistics
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Query
+	{
+		std::string engine;
+		/// Description of the verification target, e.g. "Assertion violation".
+		std::string target;
+		langutil::SourceLocation location;
+		/// Number of distinct nodes of the expressions given to the solver.
+		size_t size = 0;
+		/// The solvers that were asked, separated by commas.
+		std::string solver;
+		Clock::duration duration = Clock::duration::zero();
+		smtutil::CheckResult result = smtutil::CheckResult::UNKNOWN;
+	};
+
+	struct Contract
+	{
+		std::string engine;
+		std::string name;
+		Clock::duration encodingDuration = Clock::duration::zero();
+		Clock::duration queryDuration = Clock::duration::zero();
+	};
+
+	/// Starts measuring the encoding of @a _contract by @a _engine.
+	/// Contracts cannot be nested.
+	void beginContract(std::string _engine, ContractDefinition const& _contract);
+	/// Stops measuring the contract started last.
+	void endContract();
+
+	/// Records a query. Its duration is not counted as encoding time of the current contract.
+	void recordQuery(Query _query);
+
+	std::vector<Query> const& queries() const { return m_queries; }
+	std::vector<Contract> const& contracts() const { return m_contracts; }
+	bool empty() const { return m_queries.empty() && m_contracts.empty(); }
+
+	/// @returns an object with the keys "queries" and "contracts". The queries are objects with the
+	/// keys "engine", "target", "sourceLocation", "size", "solver", "wallTimeMs" and "result",
+	/// the contracts objects with the keys "engine", "contract", "encodingTimeMs" and "queryTimeMs".
+	Json::Value toJson() const;
+	/// @returns human-readable tables of the queries, ordered by decreasing wall-clock time,
+	/// and of the contracts.
+	std::string toString() const;
+
+	/// @returns the number of nodes of @a _expressions, counting shared subexpressions once.
+	static size_t expressionSize(std::vector<smtutil::Expression> const& _expressions);
+
+private:
+	std::vector<Query> m_queries;
+	std::vector<Contract> m_contracts;
+	/// Start of the contract that is measured currently, if any.
+	std::optional<Clock::time_point> m_contractStart;
+};
+
+}
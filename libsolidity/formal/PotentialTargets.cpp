@@ -0,0 +1,238 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/PotentialTargets.h>
+
+#include <libsolidity/ast/AST.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::frontend;
+using namespace solidity::frontend::smt;
+
+bool PotentialTargets::contract(ContractDefinition const& _contract)
+{
+	if (!m_contracts.count(&_contract))
+	{
+		vector<ASTNode const*> roots;
+		for (auto const* base: _contract.annotation().linearizedBaseContracts)
+			roots.emplace_back(base);
+		m_contracts[&_contract] = reachesTarget(move(roots), _contract);
+	}
+	return m_contracts.at(&_contract);
+}
+
+bool PotentialTargets::function(FunctionDefinition const& _function, ContractDefinition const& _contract)
+{
+	auto key = make_pair(&_function, &_contract);
+	if (!m_functions.count(key))
+		m_functions[key] = reachesTarget({&_function}, _contract);
+	return m_functions.at(key);
+}
+
+bool PotentialTargets::reachesTarget(vector<ASTNode const*> _roots, ContractDefinition const& _contract)
+{
+	auto const& hierarchy = _contract.annotation().linearizedBaseContracts;
+	set<ASTNode const*> visited;
+	while (!_roots.empty())
+	{
+		ASTNode const* node = _roots.back();
+		_roots.pop_back();
+		if (!visited.insert(node).second)
+			continue;
+
+		Scan const& nodeScan = scan(*node);
+		if (nodeScan.targets)
+			return true;
+		for (auto const* callable: nodeScan.references)
+		{
+			auto const* scope = dynamic_cast<ContractDefinition const*>(callable->scope());
+			if (!scope || !contains(hierarchy, scope))
+			{
+				_roots.emplace_back(callable);
+				continue;
+			}
+			for (auto const* base: hierarchy)
+			{
+				for (auto const* function: base->definedFunctions())
+					if (function->name() == callable->name())
+						_roots.emplace_back(function);
+				for (auto const* modifier: base->functionModifiers())
+					if (modifier->name() == callable->name())
+						_roots.emplace_back(modifier);
+			}
+		}
+	}
+	return false;
+}
+
+PotentialTargets::Scan const& PotentialTargets::scan(ASTNode const& _node)
+{
+	auto [nodeScan, inserted] = m_scans.try_emplace(&_node);
+	if (inserted)
+	{
+		m_scan = {};
+		m_checked = true;
+		_node.accept(*this);
+		nodeScan->second = move(m_scan);
+	}
+	return nodeScan->second;
+}
+
+bool PotentialTargets::visit(IfStatement const&)
+{
+	found(VerificationTargetType::ConstantCondition);
+	return !m_scan.targets;
+}
+
+bool PotentialTargets::visit(WhileStatement const&)
+{
+	found(VerificationTargetType::ConstantCondition);
+	return !m_scan.targets;
+}
+
+bool PotentialTargets::visit(ForStatement const& _node)
+{
+	if (_node.condition())
+		found(VerificationTargetType::ConstantCondition);
+	return !m_scan.targets;
+}
+
+bool PotentialTargets::visit(Conditional const&)
+{
+	found(VerificationTargetType::ConstantCondition);
+	return !m_scan.targets;
+}
+
+bool PotentialTargets::visit(Block const& _node)
+{
+	if (_node.unchecked())
+		m_checked = false;
+	return !m_scan.targets;
+}
+
+void PotentialTargets::endVisit(Block const& _node)
+{
+	if (_node.unchecked())
+		m_checked = true;
+}
+
+void PotentialTargets::endVisit(UnaryOperation const& _node)
+{
+	switch (_node.getOperator())
+	{
+	case Token::Inc:
+		arithmetic(Token::Add, _node.annotation().type);
+		break;
+	case Token::Dec:
+	case Token::Sub:
+		arithmetic(Token::Sub, _node.annotation().type);
+		break;
+	default:
+		break;
+	}
+}
+
+void PotentialTargets::endVisit(BinaryOperation const& _node)
+{
+	if (TokenTraits::isArithmeticOp(_node.getOperator()))
+		arithmetic(_node.getOperator(), _node.annotation().type);
+}
+
+void PotentialTargets::endVisit(Assignment const& _node)
+{
+	Token op = _node.assignmentOperator();
+	if (op != Token::Assign && TokenTraits::isArithmeticOp(TokenTraits::AssignmentToBinaryOp(op)))
+		arithmetic(TokenTraits::AssignmentToBinaryOp(op), _node.annotation().type);
+}
+
+void PotentialTargets::endVisit(FunctionCall const& _node)
+{
+	if (*_node.annotation().kind != FunctionCallKind::FunctionCall)
+		return;
+	auto const* functionType = dynamic_cast<FunctionType const*>(_node.expression().annotation().type);
+	if (!functionType)
+		return;
+	switch (functionType->kind())
+	{
+	case FunctionType::Kind::Assert:
+		found(VerificationTargetType::Assert);
+		break;
+	case FunctionType::Kind::Require:
+		found(VerificationTargetType::ConstantCondition);
+		break;
+	case FunctionType::Kind::Send:
+	case FunctionType::Kind::Transfer:
+		found(VerificationTargetType::Balance);
+		break;
+	case FunctionType::Kind::ArrayPop:
+		found(VerificationTargetType::PopEmptyArray);
+		break;
+	case FunctionType::Kind::AddMod:
+	case FunctionType::Kind::MulMod:
+		found(VerificationTargetType::DivByZero);
+		break;
+	default:
+		break;
+	}
+}
+
+void PotentialTargets::endVisit(Identifier const& _node)
+{
+	reference(_node.annotation().referencedDeclaration);
+}
+
+void PotentialTargets::endVisit(IdentifierPath const& _node)
+{
+	reference(_node.annotation().referencedDeclaration);
+}
+
+void PotentialTargets::endVisit(MemberAccess const& _node)
+{
+	reference(_node.annotation().referencedDeclaration);
+}
+
+void PotentialTargets::found(VerificationTargetType _type)
+{
+	if (m_targets.has(_type))
+		m_scan.targets = true;
+}
+
+void PotentialTargets::arithmetic(Token _operator, Type const* _type)
+{
+	// Operations on literals are evaluated by the type checker.
+	if (!_type || _type->category() == Type::Category::RationalNumber)
+		return;
+	// Unchecked does not disable division by zero checks.
+	if (_operator == Token::Div || _operator == Token::Mod)
+		found(VerificationTargetType::DivByZero);
+	if (m_checked && _operator != Token::Mod)
+		for (auto type: {VerificationTargetType::Underflow, VerificationTargetType::Overflow, VerificationTargetType::UnderOverflow})
+			found(type);
+}
+
+void PotentialTargets::reference(Declaration const* _declaration)
+{
+	if (auto const* function = dynamic_cast<FunctionDefinition const*>(_declaration))
+		m_scan.references.emplace_back(function);
+	else if (auto const* modifier = dynamic_cast<ModifierDefinition const*>(_declaration))
+		m_scan.references.emplace_back(modifier);
+}
@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/formal/ModelCheckerSettings.h>
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace solidity::frontend::smt
+{
+
+/**
+ * Cheap pass over the AST that determines whether the encoding of a contract or a function
+ * can give rise to any of the selected verification targets, so that the engines can skip
+ * encoding the ones that cannot.
+ * The answer is conservative: the constructs that lead to a target are looked for
+ * syntactically, e.g. every `if` statement counts as a constant condition and every checked
+ * addition as a possible overflow, in the given code and in all functions and modifiers it
+ * refers to.
+ */
+class PotentialTargets: private ASTConstVisitor
+{
+public:
+	explicit PotentialTargets(ModelCheckerTargets _targets): m_targets(std::move(_targets)) {}
+
+	/// @returns true if a target can arise in @a _contract, its base contracts
+	/// and the library functions they refer to.
+	bool contract(ContractDefinition const& _contract);
+	/// @returns true if a target can arise when @a _function is called as a
+	/// transaction of @a _contract, including the modifiers and functions it refers to.
+	bool function(FunctionDefinition const& _function, ContractDefinition const& _contract);
+
+private:
+	/// Targets and references found in the code of a node, not following the references.
+	struct Scan
+	{
+		bool targets = false;
+		std::vector<CallableDeclaration const*> references;
+	};
+
+	/// @returns true if a target can arise in one of @a _roots or the
+	/// functions and modifiers they refer to.
+	/// References to functions and modifiers of the inheritance hierarchy of @a _contract
+	/// include all of them with the same name, since calls can be virtual.
+	bool reachesTarget(std::vector<ASTNode const*> _roots, ContractDefinition const& _contract);
+	Scan const& scan(ASTNode const& _node);
+
+	bool visitNode(ASTNode const&) override { return !m_scan.targets; }
+	bool visit(IfStatement const& _node) override;
+	bool visit(WhileStatement const& _node) override;
+	bool visit(ForStatement const& _node) override;
+	bool visit(Conditional const& _node) override;
+	bool visit(Block const& _node) override;
+	void endVisit(Block const& _node) override;
+	void endVisit(UnaryOperation const& _node) override;
+	void endVisit(BinaryOperation const& _node) override;
+	void endVisit(Assignment const& _node) override;
+	void endVisit(FunctionCall const& _node) override;
+	void endVisit(Identifier const& _node) override;
+	void endVisit(IdentifierPath const& _node) override;
+	void endVisit(MemberAccess const& _node) override;
+
+	/// Records a target of type @a _type if it is selected.
+	void found(VerificationTargetType _type);
+	/// Records the targets of the arithmetic operation @a _operator on values of type @a _type.
+	void arithmetic(Token _operator, Type const* _type);
+	void reference(Declaration const* _declaration);
+
+	ModelCheckerTargets m_targets;
+	std::map<ASTNode const*, Scan> m_scans;
+	std::map<ContractDefinition const*, bool> m_contracts;
+	std::map<std::pair<FunctionDefinition const*, ContractDefinition const*>, bool> m_functions;
+
+	Scan m_scan;
+	bool m_checked = true;
+};
+
+}
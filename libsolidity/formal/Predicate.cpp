@@ -47,11 +47,14 @@ Predicate const* Predicate::create(
 	smt::SymbolicFunctionVariable predicate{_sort, move(_name), _context};
 	string functorName = predicate.currentName();
 	solAssert(!m_predicates.count(functorName), "");
-	return &m_predicates.emplace(
+	Predicate& created = m_predicates.emplace(
 		std::piecewise_construct,
 		std::forward_as_tuple(functorName),
 		std::forward_as_tuple(move(predicate), _type, _node, _contractContext)
 	).first->second;
+	if (_contractContext)
+		created.m_stateVariables = _context.predicateStateVariables(*_contractContext);
+	return &created;
 }
 
 Predicate::Predicate(
@@ -133,10 +136,7 @@ FunctionCall const* Predicate::programFunctionCall() const
 
 optional<vector<VariableDeclaration const*>> Predicate::stateVariables() const
 {
-	if (m_contractContext)
-		return SMTEncoder::stateVariablesIncludingInheritedAndPrivate(*m_contractContext);
-
-	return nullopt;
+	return m_stateVariables;
 }
 
 bool Predicate::isSummary() const
@@ -262,6 +262,23 @@ vector<optional<string>> Predicate::summaryStateValues(vector<smtutil::Expressio
 	return formatExpressions(stateArgs, stateTypes);
 }
 
+vector<optional<string>> Predicate::summaryPreStateValues(vector<smtutil::Expression> const& _args) const
+{
+	/// The signature of a function summary predicate is: summary(error, this, abiFunctions, cryptoFunctions, txData, preBlockchainState, preStateVars, preInputVars, postBlockchainState, postStateVars, postInputVars, outputVars).
+	/// Here we are interested in preStateVars.
+	solAssert(programFunction(), "");
+	auto stateVars = stateVariables();
+	solAssert(stateVars.has_value(), "");
+
+	auto stateFirst = _args.begin() + 6;
+	auto stateLast = stateFirst + static_cast<int>(stateVars->size());
+	solAssert(stateLast >= _args.begin() && stateLast <= _args.end(), "");
+
+	vector<smtutil::Expression> stateArgs(stateFirst, stateLast);
+	auto stateTypes = applyMap(*stateVars, [&](auto const& _var) { return _var->type(); });
+	return formatExpressions(stateArgs, stateTypes);
+}
+
 vector<optional<string>> Predicate::summaryPostInputValues(vector<smtutil::Expression> const& _args) const
 {
 	/// The signature of a function summary predicate is: summary(error, this, abiFunctions, cryptoFunctions, txData, preBlockchainState, preStateVars, preInputVars, postBlockchainState, postStateVars, postInputVars, outputVars).
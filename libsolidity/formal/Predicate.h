@@ -135,6 +135,10 @@ public:
 	/// where this summary was reached.
 	std::vector<std::optional<std::string>> summaryStateValues(std::vector<smtutil::Expression> const& _args) const;
 
+	/// @returns the values of the state variables from _args at the beginning
+	/// of the function of this summary.
+	std::vector<std::optional<std::string>> summaryPreStateValues(std::vector<smtutil::Expression> const& _args) const;
+
 	/// @returns the values of the function input variables from _args at the point
 	/// where this summary was reached.
 	std::vector<std::optional<std::string>> summaryPostInputValues(std::vector<smtutil::Expression> const& _args) const;
@@ -174,6 +178,9 @@ private:
 	/// function nodes.
 	ContractDefinition const* m_contractContext = nullptr;
 
+	/// The state variables of m_contractContext that are arguments of this predicate.
+	std::optional<std::vector<VariableDeclaration const*>> m_stateVariables;
+
 	/// Maps the name of the predicate to the actual Predicate.
 	/// Used in counterexample generation.
 	static std::map<std::string, Predicate> m_predicates;
@@ -125,7 +125,7 @@ vector<smtutil::Expression> initialStateVariables(ContractDefinition const& _con
 vector<smtutil::Expression> stateVariablesAtIndex(unsigned _index, ContractDefinition const& _contract, EncodingContext& _context)
 {
 	return applyMap(
-		SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract),
+		_context.predicateStateVariables(_contract),
 		[&](auto _var) { return _context.variable(*_var)->valueAtIndex(_index); }
 	);
 }
@@ -133,7 +133,7 @@ vector<smtutil::Expression> stateVariablesAtIndex(unsigned _index, ContractDefin
 vector<smtutil::Expression> currentStateVariables(ContractDefinition const& _contract, EncodingContext& _context)
 {
 	return applyMap(
-		SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract),
+		_context.predicateStateVariables(_contract),
 		[&](auto _var) { return _context.variable(*_var)->currentValue(); }
 	);
 }
@@ -141,7 +141,7 @@ vector<smtutil::Expression> currentStateVariables(ContractDefinition const& _con
 vector<smtutil::Expression> newStateVariables(ContractDefinition const& _contract, EncodingContext& _context)
 {
 	return applyMap(
-		SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract),
+		_context.predicateStateVariables(_contract),
 		[&](auto _var) { return _context.variable(*_var)->increaseIndex(); }
 	);
 }
@@ -187,7 +187,7 @@ vector<smtutil::Expression> currentBlockVariables(FunctionDefinition const& _fun
 {
 	return currentFunctionVariablesForDefinition(_function, _contract, _context) +
 		applyMap(
-			SMTEncoder::localVariablesIncludingModifiers(_function, _contract),
+			_context.predicateLocalVariables(_function, _contract),
 			[&](auto _var) { return _context.variable(*_var)->currentValue(); }
 		);
 }
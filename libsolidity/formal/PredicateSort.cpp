@@ -28,20 +28,22 @@ using namespace solidity::smtutil;
 namespace solidity::frontend::smt
 {
 
-SortPointer interfaceSort(ContractDefinition const& _contract, SymbolicState& _state)
+SortPointer interfaceSort(ContractDefinition const& _contract, EncodingContext& _context)
 {
+	auto& state = _context.state();
 	return make_shared<FunctionSort>(
-		vector<SortPointer>{_state.thisAddressSort(), _state.abiSort(), _state.cryptoSort(), _state.stateSort()} + stateSorts(_contract),
+		vector<SortPointer>{state.thisAddressSort(), state.abiSort(), state.cryptoSort(), state.stateSort()} + stateSorts(_contract, _context),
 		SortProvider::boolSort
 	);
 }
 
-SortPointer nondetInterfaceSort(ContractDefinition const& _contract, SymbolicState& _state)
+SortPointer nondetInterfaceSort(ContractDefinition const& _contract, EncodingContext& _context)
 {
-	auto varSorts = stateSorts(_contract);
-	vector<SortPointer> stateSort{_state.stateSort()};
+	auto& state = _context.state();
+	auto varSorts = stateSorts(_contract, _context);
+	vector<SortPointer> stateSort{state.stateSort()};
 	return make_shared<FunctionSort>(
-		vector<SortPointer>{_state.errorFlagSort(), _state.thisAddressSort(), _state.abiSort(), _state.cryptoSort()} +
+		vector<SortPointer>{state.errorFlagSort(), state.thisAddressSort(), state.abiSort(), state.cryptoSort()} +
 			stateSort +
 			varSorts +
 			stateSort +
@@ -50,30 +52,32 @@ SortPointer nondetInterfaceSort(ContractDefinition const& _contract, SymbolicSta
 	);
 }
 
-SortPointer constructorSort(ContractDefinition const& _contract, SymbolicState& _state)
+SortPointer constructorSort(ContractDefinition const& _contract, EncodingContext& _context)
 {
 	if (auto const* constructor = _contract.constructor())
-		return functionSort(*constructor, &_contract, _state);
+		return functionSort(*constructor, &_contract, _context);
 
-	auto varSorts = stateSorts(_contract);
-	vector<SortPointer> stateSort{_state.stateSort()};
+	auto& state = _context.state();
+	auto varSorts = stateSorts(_contract, _context);
+	vector<SortPointer> stateSort{state.stateSort()};
 	return make_shared<FunctionSort>(
-		vector<SortPointer>{_state.errorFlagSort(), _state.thisAddressSort(), _state.abiSort(), _state.cryptoSort(), _state.txSort(), _state.stateSort(), _state.stateSort()} + varSorts + varSorts,
+		vector<SortPointer>{state.errorFlagSort(), state.thisAddressSort(), state.abiSort(), state.cryptoSort(), state.txSort(), state.stateSort(), state.stateSort()} + varSorts + varSorts,
 		SortProvider::boolSort
 	);
 }
 
-SortPointer functionSort(FunctionDefinition const& _function, ContractDefinition const* _contract, SymbolicState& _state)
+SortPointer functionSort(FunctionDefinition const& _function, ContractDefinition const* _contract, EncodingContext& _context)
 {
+	auto& state = _context.state();
 	auto smtSort = [](auto _var) { return smt::smtSortAbstractFunction(*_var->type()); };
-	auto varSorts = _contract ? stateSorts(*_contract) : vector<SortPointer>{};
+	auto varSorts = _contract ? stateSorts(*_contract, _context) : vector<SortPointer>{};
 	auto inputSorts = applyMap(_function.parameters(), smtSort);
 	auto outputSorts = applyMap(_function.returnParameters(), smtSort);
 	return make_shared<FunctionSort>(
-		vector<SortPointer>{_state.errorFlagSort(), _state.thisAddressSort(), _state.abiSort(), _state.cryptoSort(), _state.txSort(), _state.stateSort()} +
+		vector<SortPointer>{state.errorFlagSort(), state.thisAddressSort(), state.abiSort(), state.cryptoSort(), state.txSort(), state.stateSort()} +
 			varSorts +
 			inputSorts +
-			vector<SortPointer>{_state.stateSort()} +
+			vector<SortPointer>{state.stateSort()} +
 			varSorts +
 			inputSorts +
 			outputSorts,
@@ -81,14 +85,14 @@ SortPointer functionSort(FunctionDefinition const& _function, ContractDefinition
 	);
 }
 
-SortPointer functionBodySort(FunctionDefinition const& _function, ContractDefinition const* _contract, SymbolicState& _state)
+SortPointer functionBodySort(FunctionDefinition const& _function, ContractDefinition const* _contract, EncodingContext& _context)
 {
-	auto fSort = dynamic_pointer_cast<FunctionSort>(functionSort(_function, _contract, _state));
+	auto fSort = dynamic_pointer_cast<FunctionSort>(functionSort(_function, _contract, _context));
 	solAssert(fSort, "");
 
 	auto smtSort = [](auto _var) { return smt::smtSortAbstractFunction(*_var->type()); };
 	return make_shared<FunctionSort>(
-		fSort->domain + applyMap(SMTEncoder::localVariablesIncludingModifiers(_function, _contract), smtSort),
+		fSort->domain + applyMap(_context.predicateLocalVariables(_function, _contract), smtSort),
 		SortProvider::boolSort
 	);
 }
@@ -103,10 +107,10 @@ SortPointer arity0FunctionSort()
 
 /// Helpers
 
-vector<SortPointer> stateSorts(ContractDefinition const& _contract)
+vector<SortPointer> stateSorts(ContractDefinition const& _contract, EncodingContext& _context)
 {
 	return applyMap(
-		SMTEncoder::stateVariablesIncludingInheritedAndPrivate(_contract),
+		_context.predicateStateVariables(_contract),
 		[](auto _var) { return smt::smtSortAbstractFunction(*_var->type()); }
 	);
 }
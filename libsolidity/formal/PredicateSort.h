@@ -20,7 +20,7 @@
 
 #include <libsolidity/formal/Predicate.h>
 
-#include <libsolidity/formal/SymbolicState.h>
+#include <libsolidity/formal/EncodingContext.h>
 
 #include <libsmtutil/Sorts.h>
 
@@ -52,28 +52,32 @@ namespace solidity::frontend::smt
  * 5. Function body
  * Use for any predicate within a function. Signature:
  * function_body(error, this, abiFunctions, cryptoFunctions, txData, blockchainState, stateVariables, inputVariables, blockchainState', stateVariables', inputVariables', outputVariables', localVariables).
+ *
+ * If variable slicing is enabled in the encoding context, stateVariables and localVariables
+ * only contain the variables that can influence the verification targets.
  */
 
 /// @returns the interface predicate sort for _contract.
-smtutil::SortPointer interfaceSort(ContractDefinition const& _contract, SymbolicState& _state);
+smtutil::SortPointer interfaceSort(ContractDefinition const& _contract, EncodingContext& _context);
 
 /// @returns the nondeterminisc interface predicate sort for _contract.
-smtutil::SortPointer nondetInterfaceSort(ContractDefinition const& _contract, SymbolicState& _state);
+smtutil::SortPointer nondetInterfaceSort(ContractDefinition const& _contract, EncodingContext& _context);
 
 /// @returns the constructor entry/summary predicate sort for _contract.
-smtutil::SortPointer constructorSort(ContractDefinition const& _contract, SymbolicState& _state);
+smtutil::SortPointer constructorSort(ContractDefinition const& _contract, EncodingContext& _context);
 
 /// @returns the function entry/summary predicate sort for _function contained in _contract.
-smtutil::SortPointer functionSort(FunctionDefinition const& _function, ContractDefinition const* _contract, SymbolicState& _state);
+smtutil::SortPointer functionSort(FunctionDefinition const& _function, ContractDefinition const* _contract, EncodingContext& _context);
 
 /// @returns the function body predicate sort for _function contained in _contract.
-smtutil::SortPointer functionBodySort(FunctionDefinition const& _function, ContractDefinition const* _contract, SymbolicState& _state);
+smtutil::SortPointer functionBodySort(FunctionDefinition const& _function, ContractDefinition const* _contract, EncodingContext& _context);
 
 /// @returns the sort of a predicate without parameters.
 smtutil::SortPointer arity0FunctionSort();
 
 /// Helpers
 
-std::vector<smtutil::SortPointer> stateSorts(ContractDefinition const& _contract) ;
+/// @returns the sorts of the state variables of _contract that are predicate arguments.
+std::vector<smtutil::SortPointer> stateSorts(ContractDefinition const& _contract, EncodingContext& _context);
 
 }
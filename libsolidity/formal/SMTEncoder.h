@@ -26,6 +26,7 @@
 
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 #include <libsolidity/formal/SymbolicVariables.h>
 #include <libsolidity/formal/VariableUsage.h>
 
@@ -56,6 +57,9 @@ public:
 	/// @returns true if engine should proceed with analysis.
 	bool analyze(SourceUnit const& _sources);
 
+	/// Sets the collector of statistics on the queries and the encoding, if any.
+	void setStatistics(ModelCheckerStatistics* _statistics) { m_statistics = _statistics; }
+
 	/// @returns the leftmost identifier in a multi-d IndexAccess.
 	static Expression const* leftmostBase(IndexAccess const& _indexAccess);
 
@@ -425,6 +429,9 @@ protected:
 	/// Stores the context of the encoding.
 	smt::EncodingContext& m_context;
 
+	/// Collector of statistics, if they are requested.
+	ModelCheckerStatistics* m_statistics = nullptr;
+
 	smt::SymbolicState& state();
 };
 
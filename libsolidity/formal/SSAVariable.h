@@ -38,6 +38,8 @@ public:
 	/// This function returns the current index of this SSA variable.
 	unsigned index() const { return m_currentIndex; }
 	unsigned& index() { return m_currentIndex; }
+	/// This function returns the index that is assigned by the next increase.
+	unsigned nextIndex() const { return m_nextFreeIndex; }
 
 	unsigned operator++()
 	{
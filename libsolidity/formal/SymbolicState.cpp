@@ -84,6 +84,20 @@ void SymbolicState::reset()
 	m_abi->reset();
 }
 
+vector<string> SymbolicState::currentNames() const
+{
+	vector<string> names{
+		m_error.currentName(),
+		m_thisAddress.currentName(),
+		m_state.currentName(),
+		m_tx.currentName(),
+		m_crypto.currentName()
+	};
+	if (m_abi)
+		names.emplace_back(m_abi->currentName());
+	return names;
+}
+
 smtutil::Expression SymbolicState::balances() const
 {
 	return m_state.member("balances");
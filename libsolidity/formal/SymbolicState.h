@@ -40,6 +40,7 @@ public:
 	smtutil::Expression value(unsigned _idx) const { return m_tuple->valueAtIndex(_idx); }
 	smtutil::SortPointer const& sort() const { return m_tuple->sort(); }
 	unsigned index() const { return m_tuple->index(); }
+	std::string currentName() const { return m_tuple->currentName(); }
 	void newVar() { m_tuple->increaseIndex(); }
 	void reset() { m_tuple->resetIndex(); }
 
@@ -86,6 +87,9 @@ public:
 
 	void reset();
 
+	/// @returns the names of the current values of the error flag, `this` and the blockchain variables.
+	std::vector<std::string> currentNames() const;
+
 	/// Error flag.
 	//@{
 	SymbolicIntVariable& errorFlag() { return m_error; }
@@ -33,7 +33,10 @@ using namespace solidity::smtutil;
 namespace solidity::frontend::smt
 {
 
-SortPointer smtSort(frontend::Type const& _type)
+namespace
+{
+
+SortPointer computeSmtSort(frontend::Type const& _type)
 {
 	switch (smtKind(_type))
 	{
@@ -166,6 +169,18 @@ SortPointer smtSort(frontend::Type const& _type)
 	}
 }
 
+}
+
+SortPointer smtSort(frontend::Type const& _type)
+{
+	// Types are unique, so the sort is stored in the type and shared by all variables of the type.
+	lock_guard<recursive_mutex> lock(frontend::Type::cacheMutex());
+	SortPointer& sort = _type.smtSortCache();
+	if (!sort)
+		sort = computeSmtSort(_type);
+	return sort;
+}
+
 vector<SortPointer> smtSort(vector<frontend::TypePointer> const& _types)
 {
 	vector<SortPointer> sorts;
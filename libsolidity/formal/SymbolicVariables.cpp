@@ -180,6 +180,11 @@ smtutil::Expression SymbolicFunctionVariable::valueAtIndex(unsigned _index) cons
 	return m_abstract.valueAtIndex(_index);
 }
 
+string SymbolicFunctionVariable::nameAtIndex(unsigned _index) const
+{
+	return m_abstract.nameAtIndex(_index);
+}
+
 smtutil::Expression SymbolicFunctionVariable::functionValueAtIndex(unsigned _index) const
 {
 	return SymbolicVariable::valueAtIndex(_index);
@@ -332,6 +337,11 @@ smtutil::Expression SymbolicArrayVariable::valueAtIndex(unsigned _index) const
 	return m_pair.valueAtIndex(_index);
 }
 
+string SymbolicArrayVariable::nameAtIndex(unsigned _index) const
+{
+	return m_pair.nameAtIndex(_index);
+}
+
 smtutil::Expression SymbolicArrayVariable::elements() const
 {
 	return m_pair.component(0);
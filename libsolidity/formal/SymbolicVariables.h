@@ -69,6 +69,7 @@ public:
 
 	unsigned index() const { return m_ssa->index(); }
 	unsigned& index() { return m_ssa->index(); }
+	unsigned nextIndex() const { return m_ssa->nextIndex(); }
 
 	smtutil::SortPointer const& sort() const { return m_sort; }
 	frontend::TypePointer const& type() const { return m_type; }
@@ -169,6 +170,7 @@ public:
 	smtutil::Expression currentFunctionValue() const;
 
 	smtutil::Expression valueAtIndex(unsigned _index) const override;
+	std::string nameAtIndex(unsigned _index) const override;
 
 	// Explicit request the function declaration.
 	smtutil::Expression functionValueAtIndex(unsigned _index) const;
@@ -257,6 +259,7 @@ public:
 
 	smtutil::Expression currentValue(frontend::TypePointer const& _targetType = TypePointer{}) const override;
 	smtutil::Expression valueAtIndex(unsigned _index) const override;
+	std::string nameAtIndex(unsigned _index) const override;
 	smtutil::Expression resetIndex() override { SymbolicVariable::resetIndex(); return m_pair.resetIndex(); }
 	smtutil::Expression setIndex(unsigned _index) override { SymbolicVariable::setIndex(_index); return m_pair.setIndex(_index); }
 	smtutil::Expression increaseIndex() override { SymbolicVariable::increaseIndex(); return m_pair.increaseIndex(); }
@@ -107,3 +107,97 @@ void VariableUsage::checkIdentifier(Identifier const& _identifier)
 			m_touchedVariables.insert(varDecl);
 	}
 }
+
+set<VariableDeclaration const*> InfluencingVariables::contractVariables(ContractDefinition const& _contract)
+{
+	for (auto const* base: _contract.annotation().linearizedBaseContracts)
+		base->accept(*this);
+	return influencingVariables();
+}
+
+set<VariableDeclaration const*> InfluencingVariables::functionVariables(FunctionDefinition const& _function, ContractDefinition const* _contract)
+{
+	_function.accept(*this);
+	for (auto const& invocation: _function.modifiers())
+		if (invocation)
+			if (auto const* modifier = SMTEncoder::resolveModifierInvocation(*invocation, _contract))
+				modifier->accept(*this);
+	return influencingVariables();
+}
+
+bool InfluencingVariables::visit(Assignment const& _assignment)
+{
+	if (_assignment.assignmentOperator() != Token::Assign)
+		return true;
+
+	markWritten(_assignment.leftHandSide());
+
+	auto stateVariable = [](Expression const& _expression) -> VariableDeclaration const* {
+		if (auto const* identifier = dynamic_cast<Identifier const*>(&_expression))
+			if (auto const* variable = dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration))
+				if (variable->isStateVariable())
+					return variable;
+		return nullptr;
+	};
+	if (auto const* target = stateVariable(_assignment.leftHandSide()))
+		if (stateVariable(_assignment.rightHandSide()))
+			m_copiedIdentifiers[dynamic_cast<Identifier const*>(&_assignment.rightHandSide())] = target;
+	return true;
+}
+
+void InfluencingVariables::endVisit(Identifier const& _identifier)
+{
+	auto const* variable = dynamic_cast<VariableDeclaration const*>(_identifier.annotation().referencedDeclaration);
+	if (!variable || m_writtenIdentifiers.count(&_identifier))
+		return;
+	if (auto copy = m_copiedIdentifiers.find(&_identifier); copy != m_copiedIdentifiers.end())
+		m_copiedFrom[copy->second].insert(variable);
+	else
+		m_readVariables.insert(variable);
+}
+
+void InfluencingVariables::endVisit(MemberAccess const& _memberAccess)
+{
+	// State variables accessed through a contract name or a public getter.
+	if (auto const* variable = dynamic_cast<VariableDeclaration const*>(_memberAccess.annotation().referencedDeclaration))
+		m_readVariables.insert(variable);
+}
+
+void InfluencingVariables::endVisit(InlineAssembly const& _inlineAssembly)
+{
+	for (auto const& reference: _inlineAssembly.annotation().externalReferences)
+		if (auto const* variable = dynamic_cast<VariableDeclaration const*>(reference.second.declaration))
+			m_readVariables.insert(variable);
+}
+
+void InfluencingVariables::markWritten(Expression const& _expression)
+{
+	if (auto const* tuple = dynamic_cast<TupleExpression const*>(&_expression))
+	{
+		for (auto const& component: tuple->components())
+			if (component)
+				markWritten(*component);
+	}
+	else if (auto const* indexAccess = dynamic_cast<IndexAccess const*>(&_expression))
+		markWritten(indexAccess->baseExpression());
+	else if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_expression))
+		markWritten(memberAccess->expression());
+	else if (auto const* identifier = dynamic_cast<Identifier const*>(&_expression))
+		m_writtenIdentifiers.insert(identifier);
+}
+
+set<VariableDeclaration const*> InfluencingVariables::influencingVariables()
+{
+	set<VariableDeclaration const*> variables = m_readVariables;
+	vector<VariableDeclaration const*> toVisit(variables.begin(), variables.end());
+	while (!toVisit.empty())
+	{
+		auto const* variable = toVisit.back();
+		toVisit.pop_back();
+		if (m_copiedFrom.count(variable))
+			for (auto const* source: m_copiedFrom.at(variable))
+				if (variables.insert(source).second)
+					toVisit.push_back(source);
+	}
+	return variables;
+}
@@ -20,6 +20,7 @@
 
 #include <libsolidity/ast/ASTVisitor.h>
 
+#include <map>
 #include <vector>
 #include <set>
 
@@ -62,4 +63,45 @@ private:
 	std::function<bool(FunctionCall const&, ContractDefinition const*, ContractDefinition const*)> m_inlineFunctionCalls = [](FunctionCall const&, ContractDefinition const*, ContractDefinition const*) { return false; };
 };
 
+/**
+ * This class computes the variables that can influence the verification targets and the
+ * control flow (their cone of influence), which are the variables whose values are read.
+ * Writing to a variable, or to an element or a member of it, with an ordinary assignment
+ * does not read it. A state variable that is only read to be assigned to other state
+ * variables only influences anything if one of them does.
+ */
+class InfluencingVariables: private ASTConstVisitor
+{
+public:
+	/// @returns the variables that influence the code of @a _contract and its bases,
+	/// including the state variable initializers and the base constructor arguments.
+	std::set<VariableDeclaration const*> contractVariables(ContractDefinition const& _contract);
+	/// @returns the variables that influence @a _function and the modifiers it
+	/// invokes in the context of @a _contract.
+	/// Since a state variable read there could be assigned to another state variable
+	/// that is read elsewhere, this is only accurate for local variables.
+	std::set<VariableDeclaration const*> functionVariables(FunctionDefinition const& _function, ContractDefinition const* _contract);
+
+private:
+	bool visit(Assignment const& _assignment) override;
+	void endVisit(Identifier const& _identifier) override;
+	void endVisit(MemberAccess const& _memberAccess) override;
+	void endVisit(InlineAssembly const& _inlineAssembly) override;
+
+	/// Records the identifiers of the variables written to by @a _expression,
+	/// the left hand side of an ordinary assignment.
+	void markWritten(Expression const& _expression);
+
+	/// @returns the variables read, including the ones copied into read state variables.
+	std::set<VariableDeclaration const*> influencingVariables();
+
+	std::set<VariableDeclaration const*> m_readVariables;
+	/// Identifiers that are only written to.
+	std::set<Identifier const*> m_writtenIdentifiers;
+	/// Identifiers of state variables that are assigned to other state variables.
+	std::map<Identifier const*, VariableDeclaration const*> m_copiedIdentifiers;
+	/// Maps state variables to the state variables that are assigned to them.
+	std::map<VariableDeclaration const*, std::set<VariableDeclaration const*>> m_copiedFrom;
+};
+
 }
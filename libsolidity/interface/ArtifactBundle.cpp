@@ -0,0 +1,187 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/ArtifactBundle.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/JSON.h>
+
+#include <cstring>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+size_t constexpr headerSize = 16;
+size_t constexpr indexEntrySize = 32;
+
+void appendUint(bytes& _data, uint64_t _value, size_t _size)
+{
+	for (size_t i = 0; i < _size; ++i)
+		_data.push_back(static_cast<uint8_t>(_value >> (8 * i)));
+}
+
+void writeUint64(bytes& _data, size_t _offset, uint64_t _value)
+{
+	for (size_t i = 0; i < 8; ++i)
+		_data[_offset + i] = static_cast<uint8_t>(_value >> (8 * i));
+}
+
+void align(bytes& _data)
+{
+	_data.resize((_data.size() + 7) / 8 * 8, 0);
+}
+
+Json::Value linkReferences(evmasm::LinkerObject const& _object)
+{
+	Json::Value references(Json::objectValue);
+	for (auto const& [offset, library]: _object.linkReferences)
+		references[to_string(offset)] = library;
+	return references;
+}
+
+}
+
+ArtifactBundle ArtifactBundle::fromCompilerStack(CompilerStack const& _compiler)
+{
+	ArtifactBundle bundle;
+	for (string const& contract: _compiler.contractNames())
+	{
+		string const prefix = contract + "#";
+		evmasm::LinkerObject const& object = _compiler.object(contract);
+		evmasm::LinkerObject const& runtimeObject = _compiler.runtimeObject(contract);
+		bundle.add(prefix + "bin", object.bytecode);
+		bundle.add(prefix + "bin-runtime", runtimeObject.bytecode);
+		if (!object.linkReferences.empty())
+			bundle.add(prefix + "link-references", util::jsonCompactPrint(linkReferences(object)));
+		if (!runtimeObject.linkReferences.empty())
+			bundle.add(prefix + "link-references-runtime", util::jsonCompactPrint(linkReferences(runtimeObject)));
+		bundle.add(prefix + "abi", util::jsonCompactPrint(_compiler.contractABI(contract)));
+		if (string const* sourceMapping = _compiler.sourceMapping(contract))
+			bundle.add(prefix + "srcmap", *sourceMapping);
+		if (string const* sourceMapping = _compiler.runtimeSourceMapping(contract))
+			bundle.add(prefix + "srcmap-runtime", *sourceMapping);
+		bundle.add(prefix + "metadata", _compiler.metadata(contract));
+	}
+	return bundle;
+}
+
+void ArtifactBundle::add(string const& _name, bytes _data)
+{
+	m_entries[_name] = move(_data);
+}
+
+void ArtifactBundle::add(string const& _name, string const& _data)
+{
+	add(_name, bytes(_data.begin(), _data.end()));
+}
+
+bytes ArtifactBundle::serialise() const
+{
+	bytes result(Magic, Magic + 8);
+	appendUint(result, Version, 4);
+	appendUint(result, m_entries.size(), 4);
+	size_t const indexOffset = result.size();
+	result.resize(indexOffset + m_entries.size() * indexEntrySize, 0);
+	align(result);
+
+	size_t entryOffset = indexOffset;
+	for (auto const& [name, data]: m_entries)
+	{
+		writeUint64(result, entryOffset, result.size());
+		writeUint64(result, entryOffset + 8, name.size());
+		result += bytes(name.begin(), name.end());
+		align(result);
+		writeUint64(result, entryOffset + 16, result.size());
+		writeUint64(result, entryOffset + 24, data.size());
+		result += data;
+		align(result);
+		entryOffset += indexEntrySize;
+	}
+	return result;
+}
+
+ArtifactBundleReader::ArtifactBundleReader(uint8_t const* _data, size_t _size):
+	m_data(_data),
+	m_size(_size)
+{
+	if (m_size < headerSize || memcmp(m_data, ArtifactBundle::Magic, 8) != 0)
+		BOOST_THROW_EXCEPTION(InvalidArtifactBundle() << util::errinfo_comment("Not an artifact bundle."));
+	uint64_t header = readUint64(8);
+	if (static_cast<uint32_t>(header) != ArtifactBundle::Version)
+		BOOST_THROW_EXCEPTION(InvalidArtifactBundle() << util::errinfo_comment("Unsupported artifact bundle version."));
+	m_count = static_cast<size_t>(header >> 32);
+	if (m_count > (m_size - headerSize) / indexEntrySize)
+		BOOST_THROW_EXCEPTION(InvalidArtifactBundle() << util::errinfo_comment("Truncated artifact bundle index."));
+	for (size_t i = 0; i < m_count; ++i)
+	{
+		slice(headerSize + i * indexEntrySize);
+		slice(headerSize + i * indexEntrySize + 16);
+	}
+}
+
+string_view ArtifactBundleReader::name(size_t _index) const
+{
+	return slice(headerSize + _index * indexEntrySize);
+}
+
+string_view ArtifactBundleReader::data(size_t _index) const
+{
+	return slice(headerSize + _index * indexEntrySize + 16);
+}
+
+optional<string_view> ArtifactBundleReader::find(string_view _name) const
+{
+	size_t lower = 0;
+	size_t upper = m_count;
+	while (lower < upper)
+	{
+		size_t middle = lower + (upper - lower) / 2;
+		string_view middleName = name(middle);
+		if (middleName == _name)
+			return data(middle);
+		else if (middleName < _name)
+			lower = middle + 1;
+		else
+			upper = middle;
+	}
+	return nullopt;
+}
+
+uint64_t ArtifactBundleReader::readUint64(size_t _offset) const
+{
+	uint64_t value = 0;
+	for (size_t i = 0; i < 8; ++i)
+		value |= uint64_t(m_data[_offset + i]) << (8 * i);
+	return value;
+}
+
+string_view ArtifactBundleReader::slice(size_t _entryOffset) const
+{
+	uint64_t offset = readUint64(_entryOffset);
+	uint64_t length = readUint64(_entryOffset + 8);
+	if (offset > m_size || length > m_size - offset)
+		BOOST_THROW_EXCEPTION(InvalidArtifactBundle() << util::errinfo_comment("Artifact bundle entry out of range."));
+	return string_view(reinterpret_cast<char const*>(m_data + offset), static_cast<size_t>(length));
+}
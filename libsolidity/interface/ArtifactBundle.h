@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Single indexed binary file containing the artifacts of many contracts.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+#include <libsolutil/Exceptions.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+class CompilerStack;
+
+DEV_SIMPLE_EXCEPTION(InvalidArtifactBundle);
+
+/**
+ * Writer of artifact bundles, which store named binary blobs in a single file that can be
+ * memory-mapped and read selectively, without parsing the parts that are not needed.
+ *
+ * Format (all integers are unsigned and little-endian):
+ *   magic "SOLCBNDL" (8 bytes), version (4 bytes, currently 1), number of entries n (4 bytes)
+ *   n index entries of 32 bytes each, sorted by name:
+ *     offset and length of the name, offset and length of the data (8 bytes each)
+ *   names and data, each starting at a multiple of 8 bytes from the start of the file
+ * Offsets are relative to the start of the file.
+ */
+class ArtifactBundle
+{
+public:
+	static constexpr char Magic[] = "SOLCBNDL";
+	static constexpr uint32_t Version = 1;
+
+	/// @returns a bundle with the artifacts of all compiled contracts of @a _compiler, named
+	/// "<fully qualified contract name>#<artifact>". The artifacts are "bin" and "bin-runtime"
+	/// (raw bytecode, with zeros in place of unlinked library addresses), "link-references" and
+	/// "link-references-runtime" (JSON object from offsets to library names, only for unlinked
+	/// bytecode), "abi", "srcmap", "srcmap-runtime" and "metadata".
+	static ArtifactBundle fromCompilerStack(CompilerStack const& _compiler);
+
+	/// Adds an entry called @a _name, replacing any previous entry of that name.
+	void add(std::string const& _name, bytes _data);
+	void add(std::string const& _name, std::string const& _data);
+
+	bytes serialise() const;
+
+private:
+	std::map<std::string, bytes> m_entries;
+};
+
+/**
+ * Reader of artifact bundles that accesses the entries in place, e.g. in a memory-mapped file.
+ * The memory has to outlive the reader and the views returned by it.
+ */
+class ArtifactBundleReader
+{
+public:
+	/// Checks the header and the index of the bundle in the @a _size bytes at @a _data.
+	/// @throws InvalidArtifactBundle if the data is not a valid bundle.
+	ArtifactBundleReader(uint8_t const* _data, size_t _size);
+
+	size_t size() const { return m_count; }
+	/// @returns the name of the entry at @a _index in the sorted index.
+	std::string_view name(size_t _index) const;
+	/// @returns the data of the entry at @a _index in the sorted index.
+	std::string_view data(size_t _index) const;
+	/// @returns the data of the entry called @a _name, found by a binary search of the index.
+	std::optional<std::string_view> find(std::string_view _name) const;
+
+private:
+	uint64_t readUint64(size_t _offset) const;
+	std::string_view slice(size_t _entryOffset) const;
+
+	uint8_t const* m_data = nullptr;
+	size_t m_size = 0;
+	size_t m_count = 0;
+};
+
+}
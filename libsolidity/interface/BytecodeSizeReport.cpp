@@ -0,0 +1,300 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/BytecodeSizeReport.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+#include <libyul/ObjectParser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTWalker.h>
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <tuple>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+/// Source range of a function, with the name it is reported under.
+struct Range
+{
+	int start;
+	int end;
+	string name;
+};
+
+/// @returns the name of the range among @a _ranges that is the shortest one containing
+/// the source range of @a _entry, or @a _default if there is none.
+string innermost(vector<Range> const& _ranges, evmasm::SourceMappingEntry const& _entry, string const& _default)
+{
+	Range const* result = nullptr;
+	for (Range const& range: _ranges)
+		if (
+			range.start <= _entry.start &&
+			_entry.start + max(_entry.length, 0) <= range.end &&
+			(!result || range.end - range.start < result->end - result->start)
+		)
+			result = &range;
+	return result ? result->name : _default;
+}
+
+/// Collects the source ranges of the functions, modifiers and contracts of Solidity sources
+/// and the names of the constructs Yul functions are generated for by their AST ID.
+class CallableCollector: private ASTConstVisitor
+{
+public:
+	explicit CallableCollector(SourceUnit const& _sourceUnit) { _sourceUnit.accept(*this); }
+
+	vector<Range> ranges;
+	map<int64_t, string> namesByID;
+
+private:
+	bool visit(ContractDefinition const& _contract) override
+	{
+		string name = "contract " + _contract.name();
+		ranges.push_back({_contract.location().start, _contract.location().end, name});
+		namesByID[_contract.id()] = name;
+		return true;
+	}
+	bool visit(FunctionDefinition const& _function) override
+	{
+		string name = _function.name();
+		if (_function.isConstructor())
+			name = "constructor";
+		else if (_function.isFallback())
+			name = "fallback";
+		else if (_function.isReceive())
+			name = "receive";
+		name = qualified(_function, name);
+		ranges.push_back({_function.location().start, _function.location().end, name});
+		namesByID[_function.id()] = name;
+		return true;
+	}
+	bool visit(ModifierDefinition const& _modifier) override
+	{
+		ranges.push_back({
+			_modifier.location().start,
+			_modifier.location().end,
+			"modifier " + qualified(_modifier, _modifier.name())
+		});
+		return true;
+	}
+	bool visit(ModifierInvocation const& _invocation) override
+	{
+		Declaration const* modifier = _invocation.name().annotation().referencedDeclaration;
+		if (dynamic_cast<ModifierDefinition const*>(modifier))
+			namesByID[_invocation.id()] = "modifier " + qualified(*modifier, modifier->name());
+		return true;
+	}
+	bool visit(VariableDeclaration const& _variable) override
+	{
+		if (_variable.isStateVariable())
+		{
+			string name = qualified(_variable, _variable.name());
+			ranges.push_back({_variable.location().start, _variable.location().end, name});
+			namesByID[_variable.id()] = name;
+		}
+		return true;
+	}
+
+	static string qualified(Declaration const& _declaration, string const& _name)
+	{
+		if (auto const* contract = dynamic_cast<ContractDefinition const*>(_declaration.scope()))
+			return contract->name() + "." + _name;
+		return _name;
+	}
+};
+
+/// Collects the source ranges of the functions of Yul code.
+class YulFunctionCollector: public yul::ASTWalker
+{
+public:
+	using yul::ASTWalker::operator();
+	void operator()(yul::FunctionDefinition const& _function) override
+	{
+		ranges.push_back({_function.location.start, _function.location.end, _function.name.str()});
+		yul::ASTWalker::operator()(_function);
+	}
+	void collect(yul::Object const& _object)
+	{
+		if (_object.code)
+			(*this)(*_object.code);
+		for (auto const& subNode: _object.subObjects)
+			if (auto const* subObject = dynamic_cast<yul::Object const*>(subNode.get()))
+				collect(*subObject);
+	}
+
+	vector<Range> ranges;
+};
+
+/// @returns the number of bytes of @a _code per name @a _attribute returns for the source
+/// mapping entry of the instructions.
+map<string, size_t> attribute(
+	bytes const& _code,
+	evmasm::SourceMapping const& _sourceMapping,
+	function<string(evmasm::SourceMappingEntry const&)> const& _attribute
+)
+{
+	map<string, size_t> sizes;
+	// Instructions mostly share their source location with their predecessor.
+	optional<tuple<int, int, int>> lastLocation;
+	string lastName;
+	size_t pc = 0;
+	for (evmasm::SourceMappingEntry const& entry: _sourceMapping)
+	{
+		if (pc >= _code.size())
+			break;
+		uint8_t op = _code[pc];
+		// PUSH1 to PUSH32 are followed by their data.
+		size_t size = min(1 + (op >= 0x60 && op <= 0x7f ? size_t(op - 0x5f) : 0), _code.size() - pc);
+		tuple<int, int, int> location{entry.sourceIndex, entry.start, entry.length};
+		if (location != lastLocation)
+		{
+			lastLocation = location;
+			lastName = entry.sourceIndex < 0 || entry.start < 0 ? "<generated>" : _attribute(entry);
+		}
+		sizes[lastName] += size;
+		pc += size;
+	}
+	if (pc < _code.size())
+		sizes["<data>"] += _code.size() - pc;
+	return sizes;
+}
+
+}
+
+BytecodeSizeReport BytecodeSizeReport::fromSolidity(
+	bytes const& _code,
+	evmasm::SourceMapping const& _sourceMapping,
+	vector<SourceUnit const*> const& _sourceUnits
+)
+{
+	vector<vector<Range>> ranges;
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+		ranges.emplace_back(sourceUnit ? CallableCollector(*sourceUnit).ranges : vector<Range>{});
+
+	BytecodeSizeReport report;
+	report.m_sizes = attribute(_code, _sourceMapping, [&](evmasm::SourceMappingEntry const& _entry) {
+		if (static_cast<size_t>(_entry.sourceIndex) >= ranges.size())
+			return string("<generated>");
+		return innermost(ranges[static_cast<size_t>(_entry.sourceIndex)], _entry, "<generated>");
+	});
+	return report;
+}
+
+BytecodeSizeReport BytecodeSizeReport::fromYul(
+	bytes const& _code,
+	evmasm::SourceMapping const& _sourceMapping,
+	langutil::CharStream const& _yulSource,
+	vector<SourceUnit const*> const& _sourceUnits
+)
+{
+	map<int64_t, string> namesByID;
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+		if (sourceUnit)
+			namesByID.merge(CallableCollector(*sourceUnit).namesByID);
+
+	langutil::ErrorList errors;
+	langutil::ErrorReporter errorReporter(errors);
+	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_yulSource.source(), _yulSource.name()));
+	shared_ptr<yul::Object> object = yul::ObjectParser(
+		errorReporter,
+		yul::EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion{})
+	).parse(scanner, false);
+	YulFunctionCollector collector;
+	if (object)
+		collector.collect(*object);
+
+	for (Range& range: collector.ranges)
+		for (string prefix: {"fun_", "getter_fun_", "modifier_", "constructor_"})
+			if (range.name.rfind(prefix, 0) == 0)
+			{
+				// The AST ID is the last number in the name, followed by "_inner" for the
+				// inner functions of functions with modifiers.
+				string name = range.name;
+				if (name.size() > 6 && name.compare(name.size() - 6, 6, "_inner") == 0)
+					name.resize(name.size() - 6);
+				size_t separator = name.rfind('_');
+				string id = name.substr(separator + 1);
+				if (
+					!id.empty() &&
+					all_of(id.begin(), id.end(), [](char _c) { return isdigit(_c); }) &&
+					namesByID.count(stoll(id))
+				)
+					range.name += " (" + namesByID.at(stoll(id)) + ")";
+				break;
+			}
+
+	BytecodeSizeReport report;
+	report.m_sizes = attribute(_code, _sourceMapping, [&](evmasm::SourceMappingEntry const& _entry) {
+		return innermost(collector.ranges, _entry, "<main>");
+	});
+	return report;
+}
+
+size_t BytecodeSizeReport::totalSize() const
+{
+	size_t total = 0;
+	for (auto const& entry: m_sizes)
+		total += entry.second;
+	return total;
+}
+
+vector<pair<string, size_t>> BytecodeSizeReport::sizes() const
+{
+	vector<pair<string, size_t>> sizes(m_sizes.begin(), m_sizes.end());
+	stable_sort(sizes.begin(), sizes.end(), [](auto const& _a, auto const& _b) {
+		return _a.second > _b.second;
+	});
+	return sizes;
+}
+
+Json::Value BytecodeSizeReport::toJson() const
+{
+	Json::Value result(Json::objectValue);
+	for (auto const& [name, size]: m_sizes)
+		result[name] = Json::UInt64(size);
+	return result;
+}
+
+string BytecodeSizeReport::toString() const
+{
+	size_t total = totalSize();
+	ostringstream out;
+	out << right << setw(8) << "Bytes" << setw(8) << "Share" << "  " << "Function" << endl;
+	for (auto const& [name, size]: sizes())
+		out << right << setw(8) << size <<
+			setw(7) << fixed << setprecision(1) << (total ? 100.0 * double(size) / double(total) : 0.0) << "%" <<
+			"  " << name << endl;
+	out << right << setw(8) << total << setw(8) << "" << "  " << "total" << endl;
+	return out.str();
+}
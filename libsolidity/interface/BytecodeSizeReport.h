@@ -0,0 +1,88 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Attribution of the bytes of deployed code to the functions they were generated for.
+ */
+
+#pragma once
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <liblangutil/CharStream.h>
+
+#include <libsolutil/Common.h>
+
+#include <json/json.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+class SourceUnit;
+
+/**
+ * Number of bytes of deployed code per Solidity function and modifier or, for code generated
+ * via the IR, per Yul function.
+ *
+ * Every instruction is attributed via its source location to the innermost function
+ * containing it, so that code inlined by the optimizer counts for the function it was
+ * inlined from. Instructions without a source location are listed as "<generated>",
+ * the bytes following the code, like the metadata and the code of created contracts,
+ * as "<data>".
+ */
+class BytecodeSizeReport
+{
+public:
+	/// Attributes @a _code to the functions and modifiers of @a _sourceUnits, which are indexed
+	/// by the source indices of @a _sourceMapping. Code outside of functions and modifiers,
+	/// like the dispatcher, is attributed to the contract.
+	static BytecodeSizeReport fromSolidity(
+		bytes const& _code,
+		evmasm::SourceMapping const& _sourceMapping,
+		std::vector<SourceUnit const*> const& _sourceUnits
+	);
+	/// Attributes @a _code to the functions of the Yul code @a _yulSource, which is source 0
+	/// of @a _sourceMapping. Code outside of functions is listed as "<main>". The names of Yul
+	/// functions generated for Solidity functions, modifiers, getters and constructors are
+	/// followed by the name of the Solidity construct, looked up in @a _sourceUnits.
+	static BytecodeSizeReport fromYul(
+		bytes const& _code,
+		evmasm::SourceMapping const& _sourceMapping,
+		langutil::CharStream const& _yulSource,
+		std::vector<SourceUnit const*> const& _sourceUnits
+	);
+
+	size_t totalSize() const;
+	/// @returns the number of bytes per function, sorted by decreasing size.
+	std::vector<std::pair<std::string, size_t>> sizes() const;
+
+	/// @returns an object with the number of bytes per function.
+	Json::Value toJson() const;
+	/// @returns a table of the number of bytes and the share of the code per function,
+	/// sorted by decreasing size.
+	std::string toString() const;
+
+private:
+	std::map<std::string, size_t> m_sizes;
+};
+
+}
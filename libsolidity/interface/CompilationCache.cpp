@@ -0,0 +1,170 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+Json::Value CompilationCache::load(h256 const& _key) const
+{
+	if (m_directory.empty())
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto entry = m_entries.find(_key);
+		return entry != m_entries.end() ? entry->second : Json::nullValue;
+	}
+
+	fs::path path = entryPath(_key);
+	boost::system::error_code errorCode;
+	if (!fs::is_regular_file(path, errorCode))
+		return Json::nullValue;
+
+	Json::Value entry;
+	try
+	{
+		if (!jsonParseStrict(readFileAsString(path.string()), entry) || !entry.isObject())
+			return Json::nullValue;
+	}
+	catch (Exception const&)
+	{
+		return Json::nullValue;
+	}
+	return entry;
+}
+
+void CompilationCache::store(h256 const& _key, Json::Value const& _entry) const
+{
+	if (m_directory.empty())
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (!m_entries.count(_key))
+			m_storageOrder.push_back(_key);
+		m_entries[_key] = _entry;
+		while (m_entries.size() > m_capacity)
+		{
+			m_entries.erase(m_storageOrder.front());
+			m_storageOrder.pop_front();
+		}
+		return;
+	}
+
+	boost::system::error_code errorCode;
+	fs::create_directories(m_directory, errorCode);
+	if (errorCode)
+		return;
+
+	fs::path path = entryPath(_key);
+	fs::path temporaryPath = path;
+	temporaryPath += fs::unique_path(".%%%%-%%%%-%%%%.tmp", errorCode);
+	if (errorCode)
+		return;
+	{
+		ofstream outFile(temporaryPath.string(), ios::out | ios::binary | ios::trunc);
+		outFile << jsonCompactPrint(_entry);
+		if (!outFile)
+		{
+			outFile.close();
+			fs::remove(temporaryPath, errorCode);
+			return;
+		}
+	}
+	fs::rename(temporaryPath, path, errorCode);
+	if (errorCode)
+		fs::remove(temporaryPath, errorCode);
+}
+
+Json::Value CompilationCache::linkerObjectToJson(evmasm::LinkerObject const& _object)
+{
+	Json::Value result(Json::objectValue);
+	result["bytecode"] = toHex(_object.bytecode);
+	result["linkReferences"] = Json::objectValue;
+	for (auto const& [offset, library]: _object.linkReferences)
+		result["linkReferences"][to_string(offset)] = library;
+	result["immutableReferences"] = Json::objectValue;
+	for (auto const& [hash, reference]: _object.immutableReferences)
+	{
+		Json::Value& immutable = result["immutableReferences"][hash.str()];
+		immutable["name"] = reference.first;
+		immutable["offsets"] = Json::arrayValue;
+		for (size_t offset: reference.second)
+			immutable["offsets"].append(Json::UInt64(offset));
+	}
+	return result;
+}
+
+optional<evmasm::LinkerObject> CompilationCache::linkerObjectFromJson(Json::Value const& _json)
+{
+	if (
+		!_json.isObject() ||
+		!_json["bytecode"].isString() ||
+		!_json["linkReferences"].isObject() ||
+		!_json["immutableReferences"].isObject()
+	)
+		return nullopt;
+
+	evmasm::LinkerObject object;
+	try
+	{
+		object.bytecode = fromHex(_json["bytecode"].asString(), WhenError::Throw);
+		for (auto const& offset: _json["linkReferences"].getMemberNames())
+		{
+			if (!_json["linkReferences"][offset].isString())
+				return nullopt;
+			object.linkReferences[stoul(offset)] = _json["linkReferences"][offset].asString();
+		}
+		for (auto const& hash: _json["immutableReferences"].getMemberNames())
+		{
+			Json::Value const& immutable = _json["immutableReferences"][hash];
+			if (!immutable["name"].isString() || !immutable["offsets"].isArray())
+				return nullopt;
+			auto& reference = object.immutableReferences[u256(hash)];
+			reference.first = immutable["name"].asString();
+			for (auto const& offset: immutable["offsets"])
+			{
+				if (!offset.isUInt64())
+					return nullopt;
+				reference.second.push_back(static_cast<size_t>(offset.asUInt64()));
+			}
+		}
+	}
+	catch (exception const&)
+	{
+		// Malformed numbers or hex strings.
+		return nullopt;
+	}
+	return object;
+}
+
+fs::path CompilationCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * On-disk or in-memory cache for the results of code generation of individual contracts.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+#include <json/json.h>
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/**
+ * Directory containing one JSON file per cache entry, named after the key of the entry.
+ * The key is supposed to be a hash of everything the entry depends on, so entries are
+ * never invalidated, only replaced. The directory is created on first store.
+ *
+ * The cache is only an optimisation: entries that cannot be read are treated as missing
+ * and failures to write an entry are ignored. Entries are written to a temporary file
+ * first and then renamed, so that concurrent compiler processes can share a directory.
+ *
+ * Without a directory, the entries are kept in memory, which allows compiler stacks within
+ * one process, e.g. in tests, to reuse each other's results. Only the most recently stored
+ * entries are kept, to bound the memory use.
+ */
+class CompilationCache
+{
+public:
+	explicit CompilationCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+	/// Creates an in-memory cache holding at most @a _capacity entries.
+	explicit CompilationCache(size_t _capacity): m_capacity(_capacity) {}
+
+	/// @returns the entry stored under @a _key or null if there is no valid entry.
+	Json::Value load(util::h256 const& _key) const;
+	/// Stores @a _entry under @a _key.
+	void store(util::h256 const& _key, Json::Value const& _entry) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+	static Json::Value linkerObjectToJson(evmasm::LinkerObject const& _object);
+	/// @returns the linker object represented by @a _json or nullopt if it is malformed.
+	static std::optional<evmasm::LinkerObject> linkerObjectFromJson(Json::Value const& _json);
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+
+	size_t m_capacity = 0;
+	/// Entries of the in-memory cache and their keys in the order in which they were stored.
+	mutable std::map<util::h256, Json::Value> m_entries;
+	mutable std::deque<util::h256> m_storageOrder;
+	mutable std::mutex m_mutex;
+};
+
+}
@@ -47,6 +47,7 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
@@ -70,10 +71,15 @@
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <json/json.h>
 
 #include <boost/algorithm/string/replace.hpp>
+
+#include <future>
+#include <mutex>
 #include <utility>
 
 using namespace std;
@@ -86,6 +92,29 @@ using solidity::util::toHex;
 
 static int g_compilerStackCounts = 0;
 
+namespace
+{
+
+/// Error reporter of the code generation task running on the current thread during
+/// parallel code generation.
+thread_local ErrorReporter* t_codeGenerationErrorReporter = nullptr;
+
+/// @returns the contracts created by @a _contract, directly or indirectly.
+set<ContractDefinition const*> transitiveContractDependencies(ContractDefinition const& _contract)
+{
+	set<ContractDefinition const*> dependencies;
+	function<void(ContractDefinition const&)> addDependencies = [&](ContractDefinition const& _dependent)
+	{
+		for (auto const* dependency: _dependent.annotation().contractDependencies)
+			if (dependencies.insert(dependency).second)
+				addDependencies(*dependency);
+	};
+	addDependencies(_contract);
+	return dependencies;
+}
+
+}
+
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_enabledSMTSolvers{smtutil::SMTSolverChoice::All()},
@@ -139,6 +168,48 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set parallelism before compiling."));
+	m_parallelism = _parallelism == 0 ? util::ThreadPool::hardwareConcurrency() : _parallelism;
+}
+
+void CompilerStack::setLazyAnalysis(bool _lazyAnalysis)
+{
+	if (m_stackState >= AnalysisPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set lazy analysis before analysis."));
+	m_lazyAnalysis = _lazyAnalysis;
+}
+
+void CompilerStack::setDeferredParsing(bool _deferredParsing)
+{
+	if (m_stackState >= ParsedAndImported)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set deferred parsing before parsing."));
+	m_deferredParsing = _deferredParsing;
+}
+
+void CompilerStack::setLowMemory(bool _lowMemory)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set low memory mode before compiling."));
+	m_lowMemory = _lowMemory;
+}
+
+void CompilerStack::setBatchReadCallback(ReadCallback::BatchCallback _readFiles)
+{
+	if (m_stackState >= ParsedAndImported)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set the batch read callback before parsing."));
+	m_readFiles = move(_readFiles);
+}
+
+void CompilerStack::setCompilationCache(shared_ptr<CompilationCache const> _cache)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set the compilation cache before compiling."));
+	m_compilationCache = move(_cache);
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -146,6 +217,29 @@ void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 	m_evmVersion = _version;
 }
 
+void CompilerStack::setBackendSettings(BackendSettings _settings)
+{
+	if (m_stackState < AnalysisPerformed || m_hasError)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set backend settings after successful analysis."));
+	if (_settings.evmVersion < m_analysisEVMVersion)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment(
+			"The EVM version of the backend settings must not be older than the one used for the analysis."
+		));
+	m_evmVersion = _settings.evmVersion;
+	m_optimiserSettings = std::move(_settings.optimiserSettings);
+	m_viaIR = _settings.viaIR;
+
+	m_contracts.clear();
+	storeContractDefinitions();
+	m_pendingCodeGeneration.clear();
+	m_finishedCodeGeneration.clear();
+	m_releasedContracts.clear();
+	m_yulFunctionCache.reset();
+	m_errorReporter.clear();
+	m_errorReporter.append(m_analysisErrors);
+	m_stackState = AnalysisPerformed;
+}
+
 void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -217,16 +311,24 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
+	m_unhandledSMTLib2Scripts.clear();
+	m_modelCheckerStatistics = {};
 	if (!_keepSettings)
 	{
 		m_remappings.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_parallelism = 1;
+		m_lazyAnalysis = false;
+		m_deferredParsing = false;
+		m_lowMemory = false;
+		m_compilationCache.reset();
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_enabledSMTSolvers = smtutil::SMTSolverChoice::All();
 		m_generateIR = false;
 		m_generateEwasm = false;
+		m_generateSizeReport = false;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
@@ -235,7 +337,14 @@ void CompilerStack::reset(bool _keepSettings)
 	}
 	m_globalContext.reset();
 	m_sourceOrder.clear();
+	m_unchangedSources.clear();
+	m_lastNodeID = 0;
+	m_analysisErrors.clear();
 	m_contracts.clear();
+	m_pendingCodeGeneration.clear();
+	m_finishedCodeGeneration.clear();
+	m_releasedContracts.clear();
+	m_yulFunctionCache.reset();
 	m_errorReporter.clear();
 	TypeProvider::reset();
 }
@@ -246,48 +355,148 @@ void CompilerStack::setSources(StringMap _sources)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
 	m_stackState = SourcesSet;
 }
 
+void CompilerStack::updateSources(StringMap _sources)
+{
+	if (m_stackState < AnalysisPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call updateSources only after analysis was performed."));
+	if (m_importedSources)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot update sources imported from ASTs."));
+
+	StringMap readSources;
+	for (auto const& [path, source]: m_sources)
+		if (!_sources.count(path) && m_readFile)
+		{
+			ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), path);
+			if (result.success)
+				readSources[path] = result.responseOrErrorMessage;
+		}
+
+	// A source is kept if neither its content nor the content of any source it imports
+	// (directly or indirectly) changed. Sources that are only reachable through the file
+	// reader are kept if they are imported by another kept source.
+	set<string> unchangedContent;
+	if (!m_hasError)
+		for (auto const& [path, source]: m_sources)
+		{
+			string const* newContent = nullptr;
+			if (_sources.count(path))
+				newContent = &_sources.at(path);
+			else if (readSources.count(path))
+				newContent = &readSources.at(path);
+			// The bodies needed by the changed sources might not have been parsed.
+			if (newContent && source.ast && *newContent == source.scanner->source() && source.deferredBodies.empty())
+				unchangedContent.insert(path);
+		}
+
+	set<string> unchangedSources;
+	for (auto const& [path, content]: _sources)
+	{
+		if (!unchangedContent.count(path))
+			continue;
+		set<SourceUnit const*> referencedUnits = m_sources.at(path).ast->referencedSourceUnits(true);
+		if (all_of(referencedUnits.begin(), referencedUnits.end(), [&](SourceUnit const* _unit) {
+			return unchangedContent.count(*_unit->annotation().path);
+		}))
+		{
+			unchangedSources.insert(path);
+			for (SourceUnit const* unit: referencedUnits)
+				unchangedSources.insert(*unit->annotation().path);
+		}
+	}
+
+	m_lastNodeID = 0;
+	for (auto it = m_sources.begin(); it != m_sources.end();)
+		if (unchangedSources.count(it->first))
+		{
+			m_lastNodeID = max(m_lastNodeID, it->second.ast->id());
+			++it;
+		}
+		else
+		{
+			if (it->second.ast && m_globalContext)
+				for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(it->second.ast->nodes()))
+					m_globalContext->removeContract(*contract);
+			it = m_sources.erase(it);
+		}
+
+	m_unchangedSources = move(unchangedSources);
+	ErrorList unchangedErrors;
+	for (auto const& error: m_analysisErrors)
+		if (isInUnchangedSource(*error))
+			unchangedErrors.push_back(error);
+	swap(m_analysisErrors, unchangedErrors);
+
+	for (auto& [path, content]: _sources)
+		if (!m_unchangedSources.count(path))
+			m_sources[path].scanner = make_shared<Scanner>(CharStream(move(content), path));
+
+	m_stackState = SourcesSet;
+	m_hasError = false;
+	m_sourceOrder.clear();
+	m_contracts.clear();
+	m_unhandledSMTLib2Queries.clear();
+	m_unhandledSMTLib2Scripts.clear();
+	m_modelCheckerStatistics = {};
+	m_errorReporter.clear();
+	// Types can cache members that refer to the released AST nodes.
+	TypeProvider::clearTypeCaches();
+}
+
 bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
 	m_errorReporter.clear();
+	util::ProfilerScope profilerScope{"Parsing"};
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
-
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+	m_errorReporter.append(m_analysisErrors);
 
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
-		sourcesToParse.push_back(s.first);
+		if (!m_unchangedSources.count(s.first))
+			sourcesToParse.push_back(s.first);
 
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	// Error recovery depends on the number of errors reported so far, so it is only
+	// supported by sequential parsing.
+	if (m_parallelism > 1 && !m_parserErrorRecovery)
+		parseInParallel(move(sourcesToParse));
+	else
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = parser.parse(source.scanner);
-		if (!source.ast)
-			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+		Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+		parser.continueNodeIDsAfter(m_lastNodeID);
+		size_t firstWithoutImports = 0;
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
-			source.ast->annotation().path = path;
-			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast, path))
-				{
-					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
-					sourcesToParse.push_back(newPath);
-				}
+			string const path = sourcesToParse[i];
+			Source& source = m_sources[path];
+			source.scanner->reset();
+			parser.setDeferFunctionBodies(deferBodies(path));
+			storeParsedSource(path, parser.parse(source.scanner));
+			source.deferredBodies = parser.takeDeferredBodies();
+			// With a batch read callback, the imports are loaded once all queued sources are parsed.
+			if (!m_readFiles || i + 1 == sourcesToParse.size())
+			{
+				vector<string> parsedSources(
+					sourcesToParse.begin() + static_cast<ptrdiff_t>(firstWithoutImports),
+					sourcesToParse.begin() + static_cast<ptrdiff_t>(i + 1)
+				);
+				for (string& newPath: loadMissingSources(parsedSources))
+					sourcesToParse.push_back(move(newPath));
+				firstWithoutImports = i + 1;
+			}
 		}
 	}
 
+	if (m_deferredParsing)
+		parseDeferredBodies();
+
 	if (m_stopAfter <= Parsed)
 		m_stackState = Parsed;
 	else
@@ -300,19 +509,214 @@ bool CompilerStack::parse()
 	return !m_hasError;
 }
 
-void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
+void CompilerStack::storeParsedSource(string const& _path, shared_ptr<SourceUnit> _ast)
+{
+	Source& source = m_sources[_path];
+	source.ast = move(_ast);
+	if (!source.ast)
+		solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+	else
+		source.ast->annotation().path = _path;
+}
+
+void CompilerStack::parseInParallel(vector<string> _sourcesToParse)
+{
+	struct Task
+	{
+		Task(CompilerStack const& _stack, shared_ptr<Scanner> _scanner):
+			parser(errorReporter, _stack.m_evmVersion, _stack.m_parserErrorRecovery),
+			scanner(move(_scanner))
+		{}
+
+		ErrorList errors;
+		ErrorReporter errorReporter{errors};
+		Parser parser;
+		shared_ptr<Scanner> scanner;
+		ASTPointer<SourceUnit> ast;
+		exception_ptr failure;
+		promise<void> finished;
+	};
+
+	// The tasks are only accessed by the worker running them until they are finished.
+	// Everything else, including loading imports, happens on this thread in the order of
+	// sequential parsing.
+	vector<unique_ptr<Task>> tasks;
+	util::ThreadPool pool{m_parallelism};
+	auto postTask = [&](string const& _path)
+	{
+		tasks.emplace_back(make_unique<Task>(*this, m_sources.at(_path).scanner));
+		Task* task = tasks.back().get();
+		task->parser.enableNodeIDShifting();
+		task->parser.setDeferFunctionBodies(deferBodies(_path));
+		pool.post([task]() {
+			try
+			{
+				task->scanner->reset();
+				task->ast = task->parser.parse(task->scanner);
+			}
+			catch (...)
+			{
+				task->failure = current_exception();
+			}
+			task->finished.set_value();
+		});
+	};
+
+	for (string const& path: _sourcesToParse)
+		postTask(path);
+
+	int64_t lastNodeID = m_lastNodeID;
+	size_t firstWithoutImports = 0;
+	for (size_t i = 0; i < _sourcesToParse.size(); ++i)
+	{
+		Task& task = *tasks[i];
+		task.finished.get_future().wait();
+		m_errorReporter.append(task.errors);
+		if (task.failure)
+			rethrow_exception(task.failure);
+
+		// Every parser numbers its nodes starting from one.
+		task.parser.shiftNodeIDs(lastNodeID);
+		lastNodeID += task.parser.lastNodeID();
+
+		storeParsedSource(_sourcesToParse[i], move(task.ast));
+		m_sources[_sourcesToParse[i]].deferredBodies = task.parser.takeDeferredBodies();
+		// With a batch read callback, the imports are loaded once all queued sources are parsed.
+		if (!m_readFiles || i + 1 == _sourcesToParse.size())
+		{
+			vector<string> parsedSources(
+				_sourcesToParse.begin() + static_cast<ptrdiff_t>(firstWithoutImports),
+				_sourcesToParse.begin() + static_cast<ptrdiff_t>(i + 1)
+			);
+			for (string& newPath: loadMissingSources(parsedSources))
+			{
+				postTask(newPath);
+				_sourcesToParse.push_back(move(newPath));
+			}
+			firstWithoutImports = i + 1;
+		}
+	}
+}
+
+bool CompilerStack::deferBodies(string const& _path) const
+{
+	return m_deferredParsing && !isRequestedSource(_path);
+}
+
+void CompilerStack::parseDeferredBodies()
+{
+	struct DeferredCallable
+	{
+		CallableDeclaration const* declaration = nullptr;
+		/// Contract defining the callable, unless it is a library or the callable is free.
+		ContractDefinition const* contract = nullptr;
+		shared_ptr<Block> body;
+		shared_ptr<Scanner> scanner;
+		bool modifier = false;
+	};
+
+	// Before the analysis, references are only known by name. Parsing every body of a
+	// referenced name over-approximates the code that is used.
+	vector<DeferredCallable> callables;
+	vector<ContractDefinition const*> contracts;
+	vector<ASTNode const*> toVisit;
+	int64_t lastNodeID = m_lastNodeID;
+	for (auto const& [path, source]: m_sources)
+	{
+		if (!source.ast)
+			continue;
+		lastNodeID = max(lastNodeID, source.ast->id());
+		if (source.deferredBodies.empty())
+		{
+			toVisit.push_back(source.ast.get());
+			continue;
+		}
+
+		map<Block const*, shared_ptr<Block>> bodies;
+		for (shared_ptr<Block> const& body: source.deferredBodies)
+			if (body->deferred())
+				bodies[body.get()] = body;
+		auto addCallable = [&](CallableDeclaration const& _callable, Block const* _body, ContractDefinition const* _contract) {
+			if (_body && bodies.count(_body))
+				callables.push_back({
+					&_callable,
+					_contract && !_contract->isLibrary() ? _contract : nullptr,
+					bodies.at(_body),
+					source.scanner,
+					dynamic_cast<ModifierDefinition const*>(&_callable) != nullptr
+				});
+		};
+		for (ASTPointer<ASTNode> const& node: source.ast->nodes())
+			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+			{
+				contracts.push_back(contract);
+				for (FunctionDefinition const* function: contract->definedFunctions())
+					addCallable(*function, function->isImplemented() ? &function->body() : nullptr, contract);
+				for (ModifierDefinition const* modifier: contract->functionModifiers())
+					addCallable(*modifier, modifier->isImplemented() ? &modifier->body() : nullptr, contract);
+			}
+			else
+			{
+				if (auto function = dynamic_cast<FunctionDefinition const*>(node.get()))
+					addCallable(*function, function->isImplemented() ? &function->body() : nullptr, nullptr);
+				toVisit.push_back(node.get());
+			}
+	}
+	if (callables.empty())
+		return;
+
+	set<ASTString> names;
+	SimpleASTVisitor nameCollector{[&](ASTNode const& _node) {
+		if (auto identifier = dynamic_cast<Identifier const*>(&_node))
+			names.insert(identifier->name());
+		else if (auto path = dynamic_cast<IdentifierPath const*>(&_node))
+			names.insert(path->path().begin(), path->path().end());
+		else if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+			names.insert(memberAccess->memberName());
+		return true;
+	}, [](ASTNode const&) {}};
+
+	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+	parser.continueNodeIDsAfter(lastNodeID);
+	set<ContractDefinition const*> usedContracts;
+	while (!toVisit.empty())
+	{
+		for (ASTNode const* node: toVisit)
+			node->accept(nameCollector);
+		toVisit.clear();
+
+		for (ContractDefinition const* contract: contracts)
+			if (!usedContracts.count(contract) && names.count(contract->name()))
+			{
+				usedContracts.insert(contract);
+				toVisit.push_back(contract);
+			}
+
+		vector<DeferredCallable> unusedCallables;
+		for (DeferredCallable& callable: callables)
+			if (names.count(callable.declaration->name()) || usedContracts.count(callable.contract))
+			{
+				parser.parseDeferredBody(callable.scanner, *callable.body, callable.modifier);
+				toVisit.push_back(callable.body.get());
+			}
+			else
+				unusedCallables.push_back(move(callable));
+		swap(callables, unusedCallables);
+	}
+}
+
+void CompilerStack::importASTs(map<string, Json::Value> _sources)
 {
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call importASTs only before the SourcesSet state."));
-	m_sourceJsons = _sources;
+	m_sourceJsons = std::move(_sources);
 	map<string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(m_evmVersion).jsonToSourceUnit(m_sourceJsons);
 	for (auto& src: reconstructedSources)
 	{
 		string const& path = src.first;
 		Source source;
 		source.ast = src.second;
-		string srcString = util::jsonCompactPrint(m_sourceJsons[src.first]);
-		ASTPointer<Scanner> scanner = make_shared<Scanner>(langutil::CharStream(srcString, src.first));
+		ASTPointer<Scanner> scanner = make_shared<Scanner>(langutil::CharStream(util::jsonCompactPrint(m_sourceJsons[src.first]), src.first));
 		source.scanner = scanner;
 		m_sources[path] = source;
 	}
@@ -322,13 +726,98 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 	storeContractDefinitions();
 }
 
+bool CompilerStack::checkSources(
+	vector<Source const*> const& _sources,
+	function<bool(SourceUnit const&, ErrorReporter&)> const& _check
+)
+{
+	if (m_parallelism <= 1 || _sources.size() <= 1)
+	{
+		bool success = true;
+		for (Source const* source: _sources)
+			if (source->ast && !_check(*source->ast, m_errorReporter))
+				success = false;
+		return success;
+	}
+
+	// Annotations are created on first access, which must not happen concurrently.
+	SimpleASTVisitor annotationInitializer{[](ASTNode const& _node) { _node.annotation(); return true; }, [](ASTNode const&) {}};
+	for (Source const* source: m_sourceOrder)
+		if (source->ast)
+			source->ast->accept(annotationInitializer);
+
+	struct Result
+	{
+		ErrorList errors;
+		bool success = true;
+		exception_ptr failure;
+	};
+	vector<Result> results(_sources.size());
+	{
+		util::ThreadPool pool{min(m_parallelism, _sources.size())};
+		for (size_t i = 0; i < _sources.size(); ++i)
+			if (SourceUnit const* ast = _sources[i]->ast.get())
+				pool.post([&, ast, i]() {
+					try
+					{
+						ErrorReporter errorReporter(results[i].errors);
+						results[i].success = _check(*ast, errorReporter);
+					}
+					catch (...)
+					{
+						results[i].failure = current_exception();
+					}
+				});
+		pool.wait();
+	}
+
+	// Report the errors as if the sources had been checked one after the other,
+	// i.e. drop everything after the first failure.
+	bool success = true;
+	for (Result& result: results)
+	{
+		m_errorReporter.append(result.errors);
+		if (result.failure)
+			rethrow_exception(result.failure);
+		if (!result.success)
+			success = false;
+	}
+	return success;
+}
+
 bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
+	util::ProfilerScope profilerScope{"Analysis"};
+	m_analysisEVMVersion = m_evmVersion;
 	resolveImports();
 
+	// Sources kept by updateSources() are not analysed again, only their declarations have
+	// to be registered with the new name resolver. Errors located in these sources are
+	// dropped, since their errors from the previous analysis are already reported.
+	set<Source const*> unchangedSources;
+	for (string const& path: m_unchangedSources)
+		unchangedSources.insert(&m_sources.at(path));
+	vector<Source const*> sourcesToAnalyze;
 	for (Source const* source: m_sourceOrder)
+		if (!unchangedSources.count(source))
+			sourcesToAnalyze.push_back(source);
+	size_t const previousErrorCount = m_errorReporter.errors().size();
+	ScopeGuard errorFilter{[&]() {
+		if (!m_unchangedSources.empty())
+		{
+			ErrorList errors(m_errorReporter.errors().begin(), m_errorReporter.errors().begin() + static_cast<ptrdiff_t>(previousErrorCount));
+			for (size_t i = previousErrorCount; i < m_errorReporter.errors().size(); ++i)
+				if (!isInUnchangedSource(*m_errorReporter.errors()[i]))
+					errors.push_back(m_errorReporter.errors()[i]);
+			m_errorReporter.clear();
+			m_errorReporter.append(errors);
+		}
+		m_analysisErrors = m_errorReporter.errors();
+	}};
+
+	for (Source const* source: sourcesToAnalyze)
 		if (source->ast)
 			Scoper::assignScopes(*source->ast);
 
@@ -336,74 +825,111 @@ bool CompilerStack::analyze()
 
 	try
 	{
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		{
+			util::ProfilerScope stepScope{"SyntaxChecker"};
+			SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+			for (Source const* source: sourcesToAnalyze)
+				if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+		}
 
-		DocStringTagParser DocStringTagParser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !DocStringTagParser.parseDocStrings(*source->ast))
-				noErrors = false;
+		{
+			util::ProfilerScope stepScope{"DocStringTagParser"};
+			DocStringTagParser DocStringTagParser(m_errorReporter);
+			for (Source const* source: sourcesToAnalyze)
+				if (source->ast && !DocStringTagParser.parseDocStrings(*source->ast))
+					noErrors = false;
+		}
 
-		m_globalContext = make_shared<GlobalContext>();
+		// The global context is kept by updateSources(), since the annotations of the
+		// unchanged sources refer to its declarations.
+		if (!m_globalContext)
+			m_globalContext = make_shared<GlobalContext>();
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.registerDeclarations(*source->ast))
-				return false;
+		{
+			util::ProfilerScope stepScope{"NameAndTypeResolver"};
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.registerDeclarations(*source->ast))
+					return false;
 
-		map<string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
+			map<string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
 
-		resolver.warnHomonymDeclarations();
+			resolver.warnHomonymDeclarations();
 
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
-				return false;
+			for (Source const* source: sourcesToAnalyze)
+				if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
+					return false;
+		}
 
-		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !declarationTypeChecker.check(*source->ast))
-				return false;
+		{
+			util::ProfilerScope stepScope{"DeclarationTypeChecker"};
+			DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+			for (Source const* source: sourcesToAnalyze)
+				if (source->ast && !declarationTypeChecker.check(*source->ast))
+					return false;
+		}
 
-		// Next, we check inheritance, overrides, function collisions and other things at
-		// contract or function level.
-		// This also calculates whether a contract is abstract, which is needed by the
-		// type checker.
-		ContractLevelChecker contractLevelChecker(m_errorReporter);
+		{
+			// Next, we check inheritance, overrides, function collisions and other things at
+			// contract or function level.
+			// This also calculates whether a contract is abstract, which is needed by the
+			// type checker.
+			util::ProfilerScope stepScope{"ContractLevelChecker"};
+			ContractLevelChecker contractLevelChecker(m_errorReporter);
+
+			for (Source const* source: sourcesToAnalyze)
+				if (auto sourceAst = source->ast)
+					noErrors = contractLevelChecker.check(*sourceAst);
+		}
 
-		for (Source const* source: m_sourceOrder)
-			if (auto sourceAst = source->ast)
-				noErrors = contractLevelChecker.check(*sourceAst);
+		{
+			// Requires ContractLevelChecker
+			util::ProfilerScope stepScope{"DocStringAnalyser"};
+			DocStringAnalyser docStringAnalyser(m_errorReporter);
+			for (Source const* source: sourcesToAnalyze)
+				if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
+					noErrors = false;
+		}
 
-		// Requires ContractLevelChecker
-		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
-				noErrors = false;
+		{
+			// New we run full type checks that go down to the expression level. This
+			// cannot be done earlier, because we need cross-contract types and information
+			// about whether a contract is abstract for the `new` expression.
+			// This populates the `type` annotation for all expressions.
+			//
+			// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
+			// which is only done one step later.
+			util::ProfilerScope stepScope{"TypeChecker"};
+			TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+			for (Source const* source: sourcesToAnalyze)
+				if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
+					noErrors = false;
+		}
 
-		// New we run full type checks that go down to the expression level. This
-		// cannot be done earlier, because we need cross-contract types and information
-		// about whether a contract is abstract for the `new` expression.
-		// This populates the `type` annotation for all expressions.
-		//
-		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
-		// which is only done one step later.
-		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
-				noErrors = false;
+		// With lazy analysis, the checks that do not produce annotations only run on the
+		// sources needed by the requested contracts.
+		vector<Source const*> sourcesToCheck = sourcesToAnalyze;
+		if (noErrors && m_lazyAnalysis && !m_requestedContractNames.empty())
+		{
+			set<SourceUnit const*> neededUnits = sourcesUsedByRequestedContracts();
+			sourcesToCheck.clear();
+			for (Source const* source: sourcesToAnalyze)
+				if (neededUnits.count(source->ast.get()))
+					sourcesToCheck.push_back(source);
+		}
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			util::ProfilerScope stepScope{"PostTypeChecker"};
 			PostTypeChecker postTypeChecker(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyze)
 				if (source->ast && !postTypeChecker.check(*source->ast))
 					noErrors = false;
 			if (!postTypeChecker.finalize())
@@ -413,44 +939,47 @@ bool CompilerStack::analyze()
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
-			for (Source const* source: m_sourceOrder)
+		{
+			util::ProfilerScope stepScope{"ImmutableValidator"};
+			for (Source const* source: sourcesToCheck)
 				if (source->ast)
 					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 							ImmutableValidator(m_errorReporter, *contract).analyze();
+		}
 
 		if (noErrors)
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			util::ProfilerScope stepScope{"ControlFlowAnalyzer"};
 			CFG cfg(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToCheck)
 				if (source->ast && !cfg.constructFlow(*source->ast))
 					noErrors = false;
 
-			if (noErrors)
-			{
-				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
-				for (Source const* source: m_sourceOrder)
-					if (source->ast && !controlFlowAnalyzer.analyze(*source->ast))
-						noErrors = false;
-			}
+			if (noErrors && !checkSources(sourcesToCheck, [&](SourceUnit const& _source, ErrorReporter& _errorReporter) {
+				return ControlFlowAnalyzer(cfg, _errorReporter).analyze(_source);
+			}))
+				noErrors = false;
 		}
 
 		if (noErrors)
 		{
 			// Checks for common mistakes. Only generates warnings.
-			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !staticAnalyzer.analyze(*source->ast))
-					noErrors = false;
+			util::ProfilerScope stepScope{"StaticAnalyzer"};
+			if (!checkSources(sourcesToCheck, [](SourceUnit const& _source, ErrorReporter& _errorReporter) {
+				return StaticAnalyzer(_errorReporter).analyze(_source);
+			}))
+				noErrors = false;
 		}
 
 		if (noErrors)
 		{
 			// Check for state mutability in every function.
+			util::ProfilerScope stepScope{"ViewPureChecker"};
 			vector<ASTPointer<ASTNode>> ast;
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToCheck)
 				if (source->ast)
 					ast.push_back(source->ast);
 
@@ -458,13 +987,21 @@ bool CompilerStack::analyze()
 				noErrors = false;
 		}
 
-		if (noErrors)
+		// Setting up the model checker creates the SMT solvers and loads Z3 if it is
+		// linked dynamically, so it is only done if a source enables the SMTChecker.
+		bool usesSMTChecker = any_of(sourcesToAnalyze.begin(), sourcesToAnalyze.end(), [](Source const* _source) {
+			return _source->ast && _source->ast->annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker);
+		});
+		if (noErrors && usesSMTChecker)
 		{
+			util::ProfilerScope stepScope{"ModelChecker"};
 			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_enabledSMTSolvers);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyze)
 				if (source->ast)
 					modelChecker.analyze(*source->ast);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
+			m_unhandledSMTLib2Scripts += modelChecker.unhandledQueriesScripts();
+			m_modelCheckerStatistics = modelChecker.statistics();
 		}
 	}
 	catch (FatalError const&)
@@ -481,6 +1018,65 @@ bool CompilerStack::analyze()
 	return !m_hasError;
 }
 
+namespace
+{
+
+/// @returns the top-level node (e.g. a contract or a free function) that contains @a _declaration
+/// or nullptr if it is not part of a source unit, like the built-in declarations.
+ASTNode const* topLevelNode(Declaration const& _declaration)
+{
+	Scopable const* scopable = &_declaration;
+	while (scopable && scopable->scope() && !dynamic_cast<SourceUnit const*>(scopable->scope()))
+		scopable = dynamic_cast<Scopable const*>(scopable->scope());
+	if (!scopable || !scopable->scope())
+		return nullptr;
+	return dynamic_cast<ASTNode const*>(scopable);
+}
+
+}
+
+set<SourceUnit const*> CompilerStack::sourcesUsedByRequestedContracts() const
+{
+	vector<ASTNode const*> toVisit;
+	for (Source const* source: m_sourceOrder)
+		if (source->ast)
+			for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+				if (isRequestedContract(*contract))
+					toVisit.push_back(contract);
+
+	auto addReferencedNode = [&](Declaration const* _declaration) {
+		if (_declaration)
+			if (ASTNode const* node = topLevelNode(*_declaration))
+				toVisit.push_back(node);
+	};
+	SimpleASTVisitor referenceCollector{[&](ASTNode const& _node) {
+		if (auto identifier = dynamic_cast<Identifier const*>(&_node))
+			addReferencedNode(identifier->annotation().referencedDeclaration);
+		else if (auto path = dynamic_cast<IdentifierPath const*>(&_node))
+			addReferencedNode(path->annotation().referencedDeclaration);
+		else if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+			addReferencedNode(memberAccess->annotation().referencedDeclaration);
+		return true;
+	}, [](ASTNode const&) {}};
+
+	set<ASTNode const*> visited;
+	set<SourceUnit const*> sourceUnits;
+	while (!toVisit.empty())
+	{
+		ASTNode const* node = toVisit.back();
+		toVisit.pop_back();
+		if (!visited.insert(node).second)
+			continue;
+		sourceUnits.insert(&dynamic_cast<Scopable const&>(*node).sourceUnit());
+		// The dependencies include the base contracts and the contracts created using "new".
+		if (auto contract = dynamic_cast<ContractDefinition const*>(node))
+			for (ContractDefinition const* dependency: contract->annotation().contractDependencies)
+				toVisit.push_back(dependency);
+		node->accept(referenceCollector);
+	}
+	return sourceUnits;
+}
+
 bool CompilerStack::parseAndAnalyze(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
@@ -501,16 +1097,17 @@ bool CompilerStack::isRequestedSource(string const& _sourceName) const
 		m_requestedContractNames.count(_sourceName);
 }
 
-bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) const
+namespace
 {
-	/// In case nothing was specified in outputSelection.
-	if (m_requestedContractNames.empty())
-		return true;
 
+/// @returns true if @a _contract is listed in @a _contractNames, which maps source names
+/// to contract names and uses empty names as wildcards.
+bool containsContract(map<string, set<string>> const& _contractNames, ContractDefinition const& _contract)
+{
 	for (auto const& key: vector<string>{"", _contract.sourceUnitName()})
 	{
-		auto const& it = m_requestedContractNames.find(key);
-		if (it != m_requestedContractNames.end())
+		auto const& it = _contractNames.find(key);
+		if (it != _contractNames.end())
 			if (it->second.count(_contract.name()) || it->second.count(""))
 				return true;
 	}
@@ -518,6 +1115,25 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 	return false;
 }
 
+}
+
+bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) const
+{
+	/// In case nothing was specified in outputSelection.
+	if (m_requestedContractNames.empty())
+		return true;
+
+	return containsContract(m_requestedContractNames, _contract);
+}
+
+bool CompilerStack::isCodeGenerationRequested(ContractDefinition const& _contract) const
+{
+	if (!isRequestedContract(_contract))
+		return false;
+
+	return m_codeGenerationContractNames.empty() || containsContract(m_codeGenerationContractNames, _contract);
+}
+
 bool CompilerStack::compile(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
@@ -531,59 +1147,83 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
-	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	util::ProfilerScope profilerScope{"Code generation"};
 
+	// Only compile contracts individually which have been requested.
+	vector<ContractDefinition const*> contracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				if (isRequestedContract(*contract))
-				{
-					try
-					{
-						if (m_viaIR || m_generateIR || m_generateEwasm)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-						if (m_generateEwasm)
-							generateEwasm(*contract);
-					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
-					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								"Unimplemented feature error" +
-								((comment && !comment->empty()) ? ": " + *comment : string{}) +
-								" in " +
-								_unimplementedError.lineInfo()
-							);
-							return false;
-						}
-						else
-							throw;
-					}
-				}
+				if (isCodeGenerationRequested(*contract))
+					contracts.push_back(contract);
+
+	bool const useCompilationCache = m_compilationCache && !m_importedSources;
+	if (useCompilationCache)
+		contracts = restoreFromCompilationCache(contracts);
+
+	// Function names contain AST IDs, so the cache must not outlive the compilation.
+	m_yulFunctionCache = make_shared<MultiUseYulFunctionCache>();
+
+	bool const parallel = m_parallelism > 1 && !contracts.empty();
+	if (m_lowMemory)
+		prepareLowMemoryRelease(contracts, parallel);
+
+	exception_ptr failure;
+	if (parallel)
+		failure = generateCodeInParallel(contracts);
+	else
+	{
+		map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+		for (ContractDefinition const* contract: contracts)
+			try
+			{
+				generateCode(*contract, true, otherCompilers);
+			}
+			catch (...)
+			{
+				failure = current_exception();
+				break;
+			}
+	}
+
+	if (failure)
+		try
+		{
+			rethrow_exception(failure);
+		}
+		catch (Error const& _error)
+		{
+			if (_error.type() != Error::Type::CodeGenerationError)
+				throw;
+			m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+			return false;
+		}
+		catch (UnimplementedFeatureError const& _unimplementedError)
+		{
+			if (
+				SourceLocation const* sourceLocation =
+				boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+			)
+			{
+				string const* comment = _unimplementedError.comment();
+				m_errorReporter.error(
+					1834_error,
+					Error::Type::CodeGenerationError,
+					*sourceLocation,
+					"Unimplemented feature error" +
+					((comment && !comment->empty()) ? ": " + *comment : string{}) +
+					" in " +
+					_unimplementedError.lineInfo()
+				);
+				return false;
+			}
+			else
+				throw;
+		}
+
 	m_stackState = CompilationSuccessful;
+	if (useCompilationCache)
+		storeInCompilationCache(contracts);
 	this->link();
 	return true;
 }
@@ -644,7 +1284,12 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	Contract const& c = contract(_contractName);
+	return generatedSources(contract(_contractName), _runtime);
+}
+
+Json::Value CompilerStack::generatedSources(Contract const& _contract, bool _runtime) const
+{
+	Contract const& c = _contract;
 	util::LazyInit<Json::Value const> const& sources =
 		_runtime ?
 		c.runtimeGeneratedSources :
@@ -689,8 +1334,8 @@ string const* CompilerStack::sourceMapping(string const& _contractName) const
 	Contract const& c = contract(_contractName);
 	if (!c.sourceMapping)
 	{
-		if (auto items = assemblyItems(_contractName))
-			c.sourceMapping.emplace(evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices()));
+		if (auto entries = sourceMappingEntries(_contractName))
+			c.sourceMapping.emplace(evmasm::AssemblyItem::compressSourceMapping(*entries));
 	}
 	return c.sourceMapping ? &*c.sourceMapping : nullptr;
 }
@@ -703,14 +1348,31 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 	Contract const& c = contract(_contractName);
 	if (!c.runtimeSourceMapping)
 	{
-		if (auto items = runtimeAssemblyItems(_contractName))
-			c.runtimeSourceMapping.emplace(
-				evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices())
-			);
+		if (auto entries = sourceMappingEntries(_contractName, true))
+			c.runtimeSourceMapping.emplace(evmasm::AssemblyItem::compressSourceMapping(*entries));
 	}
 	return c.runtimeSourceMapping ? &*c.runtimeSourceMapping : nullptr;
 }
 
+evmasm::SourceMapping const* CompilerStack::sourceMappingEntries(string const& _contractName, bool _runtime) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& c = contract(_contractName);
+	auto& entries = _runtime ? c.runtimeSourceMappingEntries : c.sourceMappingEntries;
+	if (!entries)
+	{
+		if (auto items = _runtime ? runtimeAssemblyItems(_contractName) : assemblyItems(_contractName))
+			entries.emplace(evmasm::AssemblyItem::computeSourceMappingEntries(*items, sourceIndices()));
+		// Contracts loaded from the compilation cache only have the compressed mapping.
+		else if (auto const& mapping = _runtime ? c.runtimeSourceMapping : c.sourceMapping)
+			if (auto decompressed = evmasm::AssemblyItem::decompressSourceMapping(*mapping))
+				entries.emplace(move(*decompressed));
+	}
+	return entries ? &*entries : nullptr;
+}
+
 std::string const CompilerStack::filesystemFriendlyName(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -784,7 +1446,7 @@ evmasm::LinkerObject const& CompilerStack::runtimeObject(string const& _contract
 }
 
 /// TODO: cache this string
-string CompilerStack::assemblyString(string const& _contractName, StringMap _sourceCodes) const
+string CompilerStack::assemblyString(string const& _contractName, StringMap const& _sourceCodes) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
@@ -796,6 +1458,16 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap _sou
 		return string();
 }
 
+void CompilerStack::assemblyStream(ostream& _out, string const& _contractName, StringMap const& _sourceCodes) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& currentContract = contract(_contractName);
+	if (currentContract.evmAssembly)
+		currentContract.evmAssembly->assemblyStream(_out, "", _sourceCodes);
+}
+
 /// TODO: cache the JSON
 Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 {
@@ -828,6 +1500,14 @@ map<string, unsigned> CompilerStack::sourceIndices() const
 	return indices;
 }
 
+vector<SourceUnit const*> CompilerStack::sourceUnitsByIndex() const
+{
+	vector<SourceUnit const*> sourceUnits;
+	for (auto const& s: m_sources)
+		sourceUnits.push_back(s.second.ast.get());
+	return sourceUnits;
+}
+
 Json::Value const& CompilerStack::contractABI(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -937,6 +1617,77 @@ string const& CompilerStack::metadata(Contract const& _contract) const
 	return _contract.metadata.init([&]{ return createMetadata(_contract); });
 }
 
+void CompilerStack::computeArtifacts(map<string, set<ContractArtifact>> const& _artifacts) const
+{
+	if (m_stackState < AnalysisPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
+
+	vector<pair<Contract const*, ContractArtifact>> tasks;
+	for (auto const& [contractName, artifacts]: _artifacts)
+	{
+		Contract const& currentContract = contract(contractName);
+		for (ContractArtifact artifact: artifacts)
+			if (
+				m_stackState == CompilationSuccessful ||
+				(artifact != ContractArtifact::GeneratedSources && artifact != ContractArtifact::RuntimeGeneratedSources)
+			)
+				tasks.emplace_back(&currentContract, artifact);
+	}
+	// Without parallelism, the outputs are computed on access.
+	if (m_parallelism < 2 || tasks.size() < 2)
+		return;
+
+	// Some caches in the AST and in the compiler stack are filled lazily on first access.
+	// Fill the ones that are shared between contracts before going parallel, so that they
+	// are not computed more than once.
+	bool metadataRequested = false;
+	for (auto const& [currentContract, artifact]: tasks)
+		if (artifact == ContractArtifact::ABI || artifact == ContractArtifact::Metadata)
+		{
+			metadataRequested = metadataRequested || artifact == ContractArtifact::Metadata;
+			for (ContractDefinition const* base: currentContract->contract->annotation().linearizedBaseContracts)
+			{
+				base->interfaceFunctionList(false);
+				base->interfaceFunctionList(true);
+				base->interfaceEvents();
+			}
+		}
+	if (metadataRequested)
+		for (auto const& s: m_sources)
+			if (s.second.scanner)
+			{
+				s.second.keccak256();
+				if (!m_metadataLiteralSources)
+				{
+					s.second.swarmHash();
+					s.second.ipfsUrl();
+				}
+			}
+
+	util::ThreadPool pool{min(m_parallelism, tasks.size())};
+	for (auto const& [currentContract, artifact]: tasks)
+		pool.post([this, currentContract = currentContract, artifact = artifact]() {
+			try
+			{
+				switch (artifact)
+				{
+				case ContractArtifact::ABI: contractABI(*currentContract); break;
+				case ContractArtifact::StorageLayout: storageLayout(*currentContract); break;
+				case ContractArtifact::UserDocumentation: natspecUser(*currentContract); break;
+				case ContractArtifact::DevDocumentation: natspecDev(*currentContract); break;
+				case ContractArtifact::Metadata: metadata(*currentContract); break;
+				case ContractArtifact::GeneratedSources: generatedSources(*currentContract, false); break;
+				case ContractArtifact::RuntimeGeneratedSources: generatedSources(*currentContract, true); break;
+				}
+			}
+			catch (...)
+			{
+				// The exception is thrown again when the output is accessed.
+			}
+		});
+	pool.wait();
+}
+
 Scanner const& CompilerStack::scanner(string const& _sourceName) const
 {
 	if (m_stackState < SourcesSet)
@@ -1018,48 +1769,97 @@ string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
+vector<string> CompilerStack::loadMissingSources(vector<string> const& _paths)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
-	StringMap newSources;
-	try
+	if (m_stopAfter < ParsedAndImported)
+		return {};
+
+	struct MissingImport
+	{
+		ImportDirective const* directive;
+		/// Index of the importing source in @a _paths.
+		size_t importingSource;
+		/// Index of the path of the import in @a requestedPaths.
+		size_t request;
+	};
+	vector<MissingImport> missingImports;
+	vector<string> requestedPaths;
+	map<string, size_t> requestIndices;
+	for (size_t i = 0; i < _paths.size(); ++i)
 	{
-		for (auto const& node: _ast.nodes())
+		SourceUnit const* ast = m_sources.at(_paths[i]).ast.get();
+		if (!ast)
+			continue;
+		for (auto const& node: ast->nodes())
 			if (ImportDirective const* import = dynamic_cast<ImportDirective*>(node.get()))
 			{
 				solAssert(!import->path().empty(), "Import path cannot be empty.");
 
-				string importPath = util::absolutePath(import->path(), _sourcePath);
+				string importPath = util::absolutePath(import->path(), _paths[i]);
 				// The current value of `path` is the absolute path as seen from this source file.
 				// We first have to apply remappings before we can store the actual absolute path
 				// as seen globally.
-				importPath = applyRemapping(importPath, _sourcePath);
+				importPath = applyRemapping(importPath, _paths[i]);
 				import->annotation().absolutePath = importPath;
-				if (m_sources.count(importPath) || newSources.count(importPath))
+				if (m_sources.count(importPath))
 					continue;
+				auto [it, inserted] = requestIndices.emplace(importPath, requestedPaths.size());
+				if (inserted)
+					requestedPaths.push_back(importPath);
+				missingImports.push_back({import, i, it->second});
+			}
+	}
 
-				ReadCallback::Result result{false, string("File not supplied initially.")};
-				if (m_readFile)
-					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
-
-				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
-				else
-				{
-					m_errorReporter.parserError(
-						6275_error,
-						import->location(),
-						string("Source \"" + importPath + "\" not found: " + result.responseOrErrorMessage)
-					);
-					continue;
-				}
+	string const kind = ReadCallback::kindString(ReadCallback::Kind::ReadFile);
+	vector<ReadCallback::Result> results;
+	if (m_readFiles && !requestedPaths.empty())
+	{
+		results = m_readFiles(kind, requestedPaths);
+		results.resize(requestedPaths.size(), ReadCallback::Result{false, "No result returned by the callback."});
+	}
+	else
+		for (string const& path: requestedPaths)
+			if (m_readFile)
+				results.push_back(m_readFile(kind, path));
+			else
+				results.push_back({false, "File not supplied initially."});
+
+	// The sources loaded for each of @a _paths are stored in the order of their paths.
+	vector<StringMap> newSources(_paths.size());
+	vector<bool> stored(requestedPaths.size(), false);
+	try
+	{
+		for (MissingImport const& missingImport: missingImports)
+		{
+			ReadCallback::Result& result = results[missingImport.request];
+			string const& path = requestedPaths[missingImport.request];
+			if (!result.success)
+				m_errorReporter.parserError(
+					6275_error,
+					missingImport.directive->location(),
+					string("Source \"" + path + "\" not found: " + result.responseOrErrorMessage)
+				);
+			else if (!stored[missingImport.request])
+			{
+				newSources[missingImport.importingSource][path] = move(result.responseOrErrorMessage);
+				stored[missingImport.request] = true;
 			}
+		}
 	}
 	catch (FatalError const&)
 	{
 		solAssert(m_errorReporter.hasErrors(), "");
 	}
-	return newSources;
+
+	vector<string> newPaths;
+	for (StringMap& sources: newSources)
+		for (auto& [newPath, newContents]: sources)
+		{
+			m_sources[newPath].scanner = make_shared<Scanner>(CharStream(move(newContents), newPath));
+			newPaths.push_back(newPath);
+		}
+	return newPaths;
 }
 
 string CompilerStack::applyRemapping(string const& _path, string const& _context)
@@ -1136,6 +1936,12 @@ void CompilerStack::resolveImports()
 	swap(m_sourceOrder, sourceOrder);
 }
 
+bool CompilerStack::isInUnchangedSource(Error const& _error) const
+{
+	SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_error);
+	return location && location->source && m_unchangedSources.count(location->source->name());
+}
+
 void CompilerStack::storeContractDefinitions()
 {
 	for (auto const& pair: m_sources)
@@ -1165,6 +1971,217 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 }
 }
 
+void CompilerStack::generateCode(
+	ContractDefinition const& _contract,
+	bool _requested,
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+)
+{
+	util::ProfilerScope contractScope{_contract.fullyQualifiedName()};
+	if (m_viaIR || m_generateIR || m_generateEwasm)
+		generateIR(_contract);
+	if (m_generateEvmBytecode)
+	{
+		if (!m_viaIR)
+			compileContract(_contract, _otherCompilers);
+		else if (_requested)
+			generateEVMFromIR(_contract);
+	}
+	if (m_generateEwasm && _requested)
+		generateEwasm(_contract);
+	if (m_lowMemory)
+		finishCodeGeneration(_contract, _otherCompilers);
+}
+
+void CompilerStack::prepareLowMemoryRelease(vector<ContractDefinition const*> const& _contracts, bool _separateDependencies)
+{
+	m_pendingCodeGeneration.clear();
+	m_finishedCodeGeneration.clear();
+	m_releasedContracts.clear();
+
+	set<ContractDefinition const*> const generated(_contracts.begin(), _contracts.end());
+	set<ContractDefinition const*> visited;
+	function<void(ContractDefinition const&)> addContract = [&](ContractDefinition const& _contract)
+	{
+		if (!visited.insert(&_contract).second)
+			return;
+		if (_separateDependencies || generated.count(&_contract))
+			m_pendingCodeGeneration[&_contract]++;
+		for (auto const* dependency: transitiveContractDependencies(_contract))
+			m_pendingCodeGeneration[dependency]++;
+		for (auto const* dependency: _contract.annotation().contractDependencies)
+			addContract(*dependency);
+	};
+	for (ContractDefinition const* contract: _contracts)
+		addContract(*contract);
+}
+
+void CompilerStack::finishCodeGeneration(
+	ContractDefinition const& _contract,
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+)
+{
+	lock_guard<mutex> lock(m_lowMemoryMutex);
+
+	auto release = [&](ContractDefinition const& _released)
+	{
+		Contract& compiledContract = m_contracts.at(_released.fullyQualifiedName());
+		// Keep the source mappings, which are often requested together with the bytecode.
+		if (compiledContract.evmAssembly && !compiledContract.sourceMappingEntries)
+			compiledContract.sourceMappingEntries.emplace(
+				evmasm::AssemblyItem::computeSourceMappingEntries(compiledContract.evmAssembly->items(), sourceIndices())
+			);
+		if (compiledContract.evmRuntimeAssembly && !compiledContract.runtimeSourceMappingEntries)
+			compiledContract.runtimeSourceMappingEntries.emplace(
+				evmasm::AssemblyItem::computeSourceMappingEntries(compiledContract.evmRuntimeAssembly->items(), sourceIndices())
+			);
+		// The compilation cache stores the generated sources and the IR.
+		if (m_compilationCache)
+		{
+			generatedSources(compiledContract, false);
+			generatedSources(compiledContract, true);
+		}
+		else if (!m_generateIR && !m_generateEwasm)
+		{
+			compiledContract.yulIR = string{};
+			compiledContract.yulIROptimized = string{};
+		}
+		compiledContract.compiler.reset();
+		compiledContract.evmAssembly.reset();
+		compiledContract.evmRuntimeAssembly.reset();
+		_otherCompilers.erase(&_released);
+		m_releasedContracts.insert(&_released);
+	};
+	auto finishStep = [&](ContractDefinition const& _finished)
+	{
+		solAssert(m_pendingCodeGeneration.at(&_finished) > 0, "");
+		if (--m_pendingCodeGeneration.at(&_finished) == 0)
+			release(_finished);
+	};
+	// Dependencies generated as part of the code generation for @a _contract are finished, too.
+	function<void(ContractDefinition const&)> finish = [&](ContractDefinition const& _finished)
+	{
+		if (!m_finishedCodeGeneration.insert(&_finished).second)
+			return;
+		for (auto const* dependency: _finished.annotation().contractDependencies)
+			finish(*dependency);
+		for (auto const* dependency: transitiveContractDependencies(_finished))
+			finishStep(*dependency);
+	};
+	finish(_contract);
+	finishStep(_contract);
+}
+
+exception_ptr CompilerStack::generateCodeInParallel(vector<ContractDefinition const*> const& _contracts)
+{
+	struct Task
+	{
+		ContractDefinition const* contract = nullptr;
+		bool requested = false;
+		/// Number of dependencies that have not been compiled yet.
+		size_t pendingDependencies = 0;
+		/// Indices of the tasks that depend on this one.
+		vector<size_t> dependents;
+		ErrorList warnings;
+		exception_ptr failure;
+	};
+
+	// Tasks are created in the order in which sequential compilation would finish them,
+	// i.e. every contract comes after the contracts it depends on.
+	vector<Task> tasks;
+	map<ContractDefinition const*, size_t> taskIndices;
+	function<size_t(ContractDefinition const&)> addTask = [&](ContractDefinition const& _contract)
+	{
+		if (taskIndices.count(&_contract))
+			return taskIndices.at(&_contract);
+		vector<size_t> dependencies;
+		// Cyclic dependencies are rejected by the type checker.
+		for (auto const* dependency: _contract.annotation().contractDependencies)
+			dependencies.push_back(addTask(*dependency));
+		size_t index = tasks.size();
+		tasks.emplace_back();
+		tasks.back().contract = &_contract;
+		tasks.back().pendingDependencies = dependencies.size();
+		for (size_t dependency: dependencies)
+			tasks[dependency].dependents.push_back(index);
+		taskIndices[&_contract] = index;
+		return index;
+	};
+	for (ContractDefinition const* contract: _contracts)
+		tasks[addTask(*contract)].requested = true;
+
+	// Some caches in the AST and in the compiler stack are filled lazily on first access.
+	// Fill the ones that are shared between contracts before going parallel.
+	SimpleASTVisitor annotationInitializer{[](ASTNode const& _node) { _node.annotation(); return true; }, [](ASTNode const&) {}};
+	for (Source const* source: m_sourceOrder)
+		source->ast->accept(annotationInitializer);
+	for (Task const& task: tasks)
+	{
+		task.contract->interfaceFunctionList(false);
+		task.contract->interfaceFunctionList(true);
+		task.contract->interfaceEvents();
+		if (m_generateEvmBytecode && !m_viaIR && m_metadataHash != MetadataHash::None && task.contract->canBeDeployed())
+			metadata(m_contracts.at(task.contract->fullyQualifiedName()));
+	}
+
+	mutex tasksMutex;
+	map<ContractDefinition const*, shared_ptr<Compiler const>> compilers;
+	util::ThreadPool pool{min(m_parallelism, tasks.size())};
+	function<void(size_t)> runTask = [&](size_t _index)
+	{
+		Task& task = tasks[_index];
+		map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+		{
+			lock_guard<mutex> lock(tasksMutex);
+			otherCompilers = compilers;
+		}
+
+		ErrorReporter errorReporter{task.warnings};
+		t_codeGenerationErrorReporter = &errorReporter;
+		try
+		{
+			generateCode(*task.contract, task.requested, otherCompilers);
+		}
+		catch (...)
+		{
+			task.failure = current_exception();
+		}
+		t_codeGenerationErrorReporter = nullptr;
+
+		lock_guard<mutex> lock(tasksMutex);
+		// Contracts depending on a failed contract are not compiled at all.
+		if (task.failure)
+			return;
+		compilers.insert(otherCompilers.begin(), otherCompilers.end());
+		if (m_lowMemory)
+		{
+			lock_guard<mutex> releaseLock(m_lowMemoryMutex);
+			for (ContractDefinition const* released: m_releasedContracts)
+				compilers.erase(released);
+		}
+		for (size_t dependent: task.dependents)
+			if (--tasks[dependent].pendingDependencies == 0)
+				pool.post([&, dependent] { runTask(dependent); });
+	};
+	for (size_t index = 0; index < tasks.size(); ++index)
+		if (tasks[index].pendingDependencies == 0)
+			pool.post([&, index] { runTask(index); });
+	pool.wait();
+
+	for (Task const& task: tasks)
+	{
+		m_errorReporter.append(task.warnings);
+		if (task.failure)
+			return task.failure;
+	}
+	return nullptr;
+}
+
+ErrorReporter& CompilerStack::codeGenerationErrorReporter()
+{
+	return t_codeGenerationErrorReporter ? *t_codeGenerationErrorReporter : m_errorReporter;
+}
+
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
 	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
@@ -1184,8 +2201,9 @@ void CompilerStack::compileContract(
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	util::ProfilerScope profilerScope{"Legacy code generation", _contract.fullyQualifiedName()};
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings, m_yulFunctionCache);
 	compiledContract.compiler = compiler;
 
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract);
@@ -1199,9 +2217,12 @@ void CompilerStack::compileContract(
 	{
 		solAssert(false, "Optimizer exception during compilation");
 	}
+	if (compiler->optimisationIncomplete())
+		reportIncompleteOptimisation(_contract);
 
 	compiledContract.evmAssembly = compiler->assemblyPtr();
 	solAssert(compiledContract.evmAssembly, "");
+	util::ProfilerScope assemblerScope{"Assembling", _contract.fullyQualifiedName()};
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
@@ -1225,21 +2246,7 @@ void CompilerStack::compileContract(
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
 
-	// Throw a warning if EIP-170 limits are exceeded:
-	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
-	//   contract creation fails with an out of gas error.
-	if (
-		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
-	)
-		m_errorReporter.warning(
-			5574_error,
-			_contract.location(),
-			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
-			"This contract may not be deployable on mainnet. "
-			"Consider enabling the optimizer (with a low \"runs\" value!), "
-			"turning off revert strings, or using libraries."
-		);
+	checkCodeSize(_contract);
 
 	_otherCompilers[compiledContract.contract] = compiler;
 }
@@ -1254,13 +2261,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (!compiledContract.yulIR.empty())
 		return;
 
-	if (!*_contract.sourceUnit().annotation().useABICoderV2)
-		m_errorReporter.warning(
-			2066_error,
-			_contract.location(),
-			"Contract requests the ABI coder v1, which is incompatible with the IR. "
-			"Using ABI coder v2 instead."
-		);
+	checkABICoderForIR(_contract);
 
 	string dependenciesSource;
 	for (auto const* dependency: _contract.annotation().contractDependencies)
@@ -1269,12 +2270,28 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (!_contract.canBeDeployed())
 		return;
 
+	// Only the dependencies are accessed, since other contracts might be compiled concurrently.
+	// Contracts created by inherited functions are dependencies of the base contract only.
 	map<ContractDefinition const*, string_view const> otherYulSources;
-	for (auto const& pair: m_contracts)
-		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
-
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract, otherYulSources);
+	function<void(ContractDefinition const&)> addDependencies = [&](ContractDefinition const& _dependent)
+	{
+		for (auto const* dependency: _dependent.annotation().contractDependencies)
+			if (otherYulSources.emplace(dependency, m_contracts.at(dependency->fullyQualifiedName()).yulIR).second)
+				addDependencies(*dependency);
+	};
+	addDependencies(_contract);
+
+	util::ProfilerScope profilerScope{"IR generation", _contract.fullyQualifiedName()};
+	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings, m_parallelism, m_yulFunctionCache);
+	// Keep the parsed code only for contracts whose bytecode will be generated from it.
+	bool const keepStack = m_viaIR && m_generateEvmBytecode && isCodeGenerationRequested(_contract);
+	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(
+		_contract,
+		otherYulSources,
+		keepStack ? &compiledContract.yulIRStack : nullptr
+	);
+	if (generator.optimisationIncomplete())
+		reportIncompleteOptimisation(_contract);
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1291,10 +2308,21 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	util::ProfilerScope profilerScope{"EVM code generation from IR", _contract.fullyQualifiedName()};
+
+	// Continue with the code that was already parsed and optimized during IR generation
+	// and only re-parse the optimized Yul IR if it was not kept.
+	shared_ptr<yul::AssemblyStack> stackPtr = std::move(compiledContract.yulIRStack);
+	if (!stackPtr)
+	{
+		stackPtr = make_shared<yul::AssemblyStack>(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+		stackPtr->setParallelism(m_parallelism);
+		stackPtr->parseAndAnalyze("", compiledContract.yulIROptimized);
+	}
+	yul::AssemblyStack& stack = *stackPtr;
 	stack.optimize();
+	if (stack.optimisationIncomplete())
+		reportIncompleteOptimisation(_contract);
 
 	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
 
@@ -1302,27 +2330,27 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	// TODO: use stack.assemble here!
 	yul::MachineAssemblyObject init;
 	yul::MachineAssemblyObject runtime;
-	std::tie(init, runtime) = stack.assembleAndGuessRuntime();
+	// The evmasm assembly is not optimised on this path, so unless the optimizer is enabled,
+	// skip building it and emit the bytecode directly, which is faster for large contracts.
+	if (m_optimiserSettings.runYulOptimiser)
+		std::tie(init, runtime) = stack.assembleAndGuessRuntime();
+	else
+		std::tie(init, runtime) = stack.assembleDirectlyAndGuessRuntime();
 	compiledContract.object = std::move(*init.bytecode);
 	compiledContract.runtimeObject = std::move(*runtime.bytecode);
+	// The source mapping refers to the Yul code, which is only available while the stack is kept.
+	if (m_generateSizeReport && runtime.sourceMappings && stack.scanner().charStream())
+		if (auto sourceMapping = evmasm::AssemblyItem::decompressSourceMapping(*runtime.sourceMappings))
+			compiledContract.sizeReport.emplace(BytecodeSizeReport::fromYul(
+				compiledContract.runtimeObject.bytecode,
+				*sourceMapping,
+				*stack.scanner().charStream(),
+				sourceUnitsByIndex()
+			));
 	// TODO: refactor assemblyItems, runtimeAssemblyItems, generatedSources,
 	//       assemblyString, assemblyJSON, and functionEntryPoints to work with this code path
 
-	// Throw a warning if EIP-170 limits are exceeded:
-	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
-	//   contract creation fails with an out of gas error.
-	if (
-		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
-	)
-		m_errorReporter.warning(
-			9609_error,
-			_contract.location(),
-			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
-			"This contract may not be deployable on mainnet. "
-			"Consider enabling the optimizer (with a low \"runs\" value!), "
-			"turning off revert strings, or using libraries."
-		);
+	checkCodeSize(_contract);
 }
 
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
@@ -1339,8 +2367,11 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 	if (!compiledContract.ewasm.empty())
 		return;
 
+	util::ProfilerScope profilerScope{"Ewasm code generation", _contract.fullyQualifiedName()};
+
 	// Re-parse the Yul IR in EVM dialect
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+	stack.setParallelism(m_parallelism);
 	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
 
 	stack.optimize();
@@ -1355,6 +2386,186 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 	compiledContract.ewasmObject = std::move(*result.bytecode);
 }
 
+h256 CompilerStack::compilationCacheKey(ContractDefinition const& _contract) const
+{
+	Json::Value input{Json::objectValue};
+	// The metadata only contains the version without platform and build type.
+	input["compiler"] = VersionString;
+	// Determines the version in the CBOR metadata appended to the bytecode.
+	input["release"] = m_release;
+	input["metadata"] = metadata(m_contracts.at(_contract.fullyQualifiedName()));
+	input["outputs"]["evmBytecode"] = m_generateEvmBytecode;
+	input["outputs"]["ir"] = m_generateIR;
+	input["outputs"]["ewasm"] = m_generateEwasm;
+	// The AST IDs determine the names of Yul functions and the source indices occur in source mappings.
+	input["sourceUnitIDs"][*_contract.sourceUnit().annotation().path] = _contract.sourceUnit().id();
+	for (SourceUnit const* sourceUnit: _contract.sourceUnit().referencedSourceUnits(true))
+		input["sourceUnitIDs"][*sourceUnit->annotation().path] = sourceUnit->id();
+	for (auto const& [sourceName, index]: sourceIndices())
+		input["sourceIndices"][sourceName] = index;
+	return util::keccak256(util::jsonCompactPrint(input));
+}
+
+vector<ContractDefinition const*> CompilerStack::restoreFromCompilationCache(
+	vector<ContractDefinition const*> const& _contracts
+)
+{
+	solAssert(m_compilationCache, "");
+	util::ProfilerScope profilerScope{"Compilation cache lookup"};
+
+	map<ContractDefinition const*, Json::Value> entries;
+	for (ContractDefinition const* contract: _contracts)
+		if (contract->canBeDeployed())
+		{
+			Json::Value entry = m_compilationCache->load(compilationCacheKey(*contract));
+			if (!entry.isNull())
+				entries[contract] = move(entry);
+		}
+
+	// The legacy code generator needs the assembly of all contracts created by a contract
+	// it compiles, so restoring those from the cache is pointless.
+	if (m_generateEvmBytecode && !m_viaIR)
+	{
+		function<void(ContractDefinition const&)> dropDependencies = [&](ContractDefinition const& _dependent)
+		{
+			for (auto const* dependency: _dependent.annotation().contractDependencies)
+				if (entries.erase(dependency))
+					dropDependencies(*dependency);
+		};
+		for (ContractDefinition const* contract: _contracts)
+			if (!entries.count(contract))
+				dropDependencies(*contract);
+	}
+
+	vector<ContractDefinition const*> remainingContracts;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		auto entry = entries.find(contract);
+		if (entry == entries.end())
+		{
+			remainingContracts.push_back(contract);
+			continue;
+		}
+
+		Json::Value const& data = entry->second;
+		optional<evmasm::LinkerObject> object = CompilationCache::linkerObjectFromJson(data["object"]);
+		optional<evmasm::LinkerObject> runtimeObject = CompilationCache::linkerObjectFromJson(data["runtimeObject"]);
+		optional<evmasm::LinkerObject> ewasmObject = CompilationCache::linkerObjectFromJson(data["ewasmObject"]);
+		if (
+			!object || !runtimeObject || !ewasmObject ||
+			!data["yulIR"].isString() ||
+			!data["yulIROptimized"].isString() ||
+			!data["ewasm"].isString() ||
+			!data["generatedSources"].isArray() ||
+			!data["runtimeGeneratedSources"].isArray()
+		)
+		{
+			remainingContracts.push_back(contract);
+			continue;
+		}
+
+		Contract& compiledContract = m_contracts.at(contract->fullyQualifiedName());
+		compiledContract.object = move(*object);
+		compiledContract.runtimeObject = move(*runtimeObject);
+		compiledContract.ewasmObject = move(*ewasmObject);
+		compiledContract.yulIR = data["yulIR"].asString();
+		compiledContract.yulIROptimized = data["yulIROptimized"].asString();
+		compiledContract.ewasm = data["ewasm"].asString();
+		if (data["sourceMap"].isString())
+			compiledContract.sourceMapping.emplace(data["sourceMap"].asString());
+		if (data["runtimeSourceMap"].isString())
+			compiledContract.runtimeSourceMapping.emplace(data["runtimeSourceMap"].asString());
+		compiledContract.generatedSources.init([&]{ return data["generatedSources"]; });
+		compiledContract.runtimeGeneratedSources.init([&]{ return data["runtimeGeneratedSources"]; });
+
+		if (m_viaIR || m_generateIR || m_generateEwasm)
+			checkABICoderForIR(*contract);
+		if (m_generateEvmBytecode)
+			checkCodeSize(*contract);
+		if (data["optimisationIncomplete"].asBool())
+			reportIncompleteOptimisation(*contract);
+	}
+	return remainingContracts;
+}
+
+void CompilerStack::storeInCompilationCache(vector<ContractDefinition const*> const& _contracts)
+{
+	solAssert(m_compilationCache, "");
+	solAssert(m_stackState == CompilationSuccessful, "");
+	util::ProfilerScope profilerScope{"Compilation cache update"};
+
+	for (ContractDefinition const* contract: _contracts)
+	{
+		if (!contract->canBeDeployed())
+			continue;
+
+		string const name = contract->fullyQualifiedName();
+		Contract const& compiledContract = m_contracts.at(name);
+		Json::Value entry{Json::objectValue};
+		entry["object"] = CompilationCache::linkerObjectToJson(compiledContract.object);
+		entry["runtimeObject"] = CompilationCache::linkerObjectToJson(compiledContract.runtimeObject);
+		entry["ewasmObject"] = CompilationCache::linkerObjectToJson(compiledContract.ewasmObject);
+		entry["yulIR"] = compiledContract.yulIR;
+		entry["yulIROptimized"] = compiledContract.yulIROptimized;
+		entry["ewasm"] = compiledContract.ewasm;
+		if (string const* map = sourceMapping(name))
+			entry["sourceMap"] = *map;
+		if (string const* map = runtimeSourceMapping(name))
+			entry["runtimeSourceMap"] = *map;
+		entry["generatedSources"] = generatedSources(name, false);
+		entry["runtimeGeneratedSources"] = generatedSources(name, true);
+		// Re-emitted on a cache hit so that the warning does not depend on the state of the cache.
+		if (compiledContract.optimisationIncomplete)
+			entry["optimisationIncomplete"] = true;
+		m_compilationCache->store(compilationCacheKey(*contract), entry);
+	}
+}
+
+void CompilerStack::checkCodeSize(ContractDefinition const& _contract)
+{
+	// Throw a warning if EIP-170 limits are exceeded:
+	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
+	//   contract creation fails with an out of gas error.
+	if (
+		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
+		m_contracts.at(_contract.fullyQualifiedName()).runtimeObject.bytecode.size() > 0x6000
+	)
+		codeGenerationErrorReporter().warning(
+			m_viaIR ? 9609_error : 5574_error,
+			_contract.location(),
+			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
+			"This contract may not be deployable on mainnet. "
+			"Consider enabling the optimizer (with a low \"runs\" value!), "
+			"turning off revert strings, or using libraries."
+		);
+}
+
+void CompilerStack::checkABICoderForIR(ContractDefinition const& _contract)
+{
+	if (!*_contract.sourceUnit().annotation().useABICoderV2)
+		codeGenerationErrorReporter().warning(
+			2066_error,
+			_contract.location(),
+			"Contract requests the ABI coder v1, which is incompatible with the IR. "
+			"Using ABI coder v2 instead."
+		);
+}
+
+void CompilerStack::reportIncompleteOptimisation(ContractDefinition const& _contract)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	if (compiledContract.optimisationIncomplete)
+		return;
+	compiledContract.optimisationIncomplete = true;
+	codeGenerationErrorReporter().warning(
+		6429_error,
+		_contract.location(),
+		"The work budget of the optimizer was exhausted while compiling this contract. "
+		"The remaining expensive optimization steps were skipped, so the code is likely "
+		"larger and more expensive to run than with a larger budget."
+	);
+}
+
 CompilerStack::Contract const& CompilerStack::contract(string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1448,7 +2659,19 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		details["jumpdestRemover"] = m_optimiserSettings.runJumpdestRemover;
 		details["peephole"] = m_optimiserSettings.runPeephole;
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
+		// Only provided if enabled, so that the metadata of existing settings does not change.
+		if (m_optimiserSettings.runBlockReorderer)
+			details["blockReorderer"] = true;
 		details["cse"] = m_optimiserSettings.runCSE;
+		// Only provided if enabled, so that the metadata of existing settings does not change.
+		if (m_optimiserSettings.runCSEAcrossBlocks)
+			details["cseAcrossBlocks"] = true;
+		if (m_optimiserSettings.runOutliner)
+			details["outliner"] = true;
+		if (m_optimiserSettings.runModifierOutliner)
+			details["modifierOutliner"] = true;
+		if (m_optimiserSettings.useSubroutines)
+			details["subroutines"] = true;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
@@ -1456,7 +2679,19 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
+			if (!m_optimiserSettings.yulOptimiserAlternativeSteps.empty())
+			{
+				details["yulDetails"]["alternativeOptimizerSteps"] = Json::arrayValue;
+				for (string const& sequence: m_optimiserSettings.yulOptimiserAlternativeSteps)
+					details["yulDetails"]["alternativeOptimizerSteps"].append(sequence);
+			}
+			if (m_optimiserSettings.yulOptimiserGasCosts)
+				details["yulDetails"]["gasCosts"] = true;
+			if (m_optimiserSettings.reasoningMaxQueries)
+				details["yulDetails"]["reasoningMaxQueries"] = Json::UInt64(*m_optimiserSettings.reasoningMaxQueries);
 		}
+		if (m_optimiserSettings.workBudget)
+			details["workBudget"] = Json::UInt64(*m_optimiserSettings.workBudget);
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
 	}
@@ -1583,14 +2818,13 @@ bytes CompilerStack::createCBORMetadata(Contract const& _contract) const
 		_contract.contract->sourceUnit().annotation().experimentalFeatures
 	);
 
-	string meta = metadata(_contract);
-
 	MetadataCBOREncoder encoder;
 
+	// The metadata, and with it the documentation, is only generated here if its hash is embedded.
 	if (m_metadataHash == MetadataHash::IPFS)
-		encoder.pushBytes("ipfs", util::ipfsHash(meta));
+		encoder.pushBytes("ipfs", util::ipfsHash(metadata(_contract)));
 	else if (m_metadataHash == MetadataHash::Bzzr1)
-		encoder.pushBytes("bzzr1", util::bzzr1Hash(meta).asBytes());
+		encoder.pushBytes("bzzr1", util::bzzr1Hash(metadata(_contract)).asBytes());
 	else
 		solAssert(m_metadataHash == MetadataHash::None, "Invalid metadata hash");
 
@@ -1616,6 +2850,22 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 }
 
+BytecodeSizeReport const* CompilerStack::sizeReport(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& c = contract(_contractName);
+	if (!c.sizeReport && !m_viaIR && !c.runtimeObject.bytecode.empty())
+		if (evmasm::SourceMapping const* sourceMapping = sourceMappingEntries(_contractName, true))
+			c.sizeReport.emplace(BytecodeSizeReport::fromSolidity(
+				c.runtimeObject.bytecode,
+				*sourceMapping,
+				sourceUnitsByIndex()
+			));
+	return c.sizeReport ? &*c.sizeReport : nullptr;
+}
+
 Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -24,12 +24,14 @@
 
 #pragma once
 
+#include <libsolidity/interface/BytecodeSizeReport.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/interface/DebugSettings.h>
 
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
 
 #include <libsmtutil/SolverInterface.h>
 
@@ -37,6 +39,7 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <libevmasm/AssemblyItem.h>
 #include <libevmasm/LinkerObject.h>
 
 #include <libsolutil/Common.h>
@@ -46,8 +49,11 @@
 #include <boost/noncopyable.hpp>
 #include <json/json.h>
 
+#include <exception>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
@@ -62,8 +68,11 @@ class Scanner;
 namespace solidity::evmasm
 {
 class Assembly;
-class AssemblyItem;
-using AssemblyItems = std::vector<AssemblyItem>;
+}
+
+namespace solidity::yul
+{
+class AssemblyStack;
 }
 
 namespace solidity::frontend
@@ -71,13 +80,16 @@ namespace solidity::frontend
 
 // forward declarations
 class ASTNode;
+class Block;
 class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
+class CompilationCache;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class MultiUseYulFunctionCache;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -104,6 +116,18 @@ public:
 		None
 	};
 
+	/// Outputs of a contract that are computed on first access and can be computed in advance
+	/// for several contracts at once, see computeArtifacts().
+	enum class ContractArtifact {
+		ABI,
+		StorageLayout,
+		UserDocumentation,
+		DevDocumentation,
+		Metadata,
+		GeneratedSources,
+		RuntimeGeneratedSources
+	};
+
 	struct Remapping
 	{
 		std::string context;
@@ -111,6 +135,15 @@ public:
 		std::string target;
 	};
 
+	/// Settings of the code generation that may differ between compilations of the same
+	/// analysed sources, see setBackendSettings().
+	struct BackendSettings
+	{
+		langutil::EVMVersion evmVersion;
+		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
+		bool viaIR = false;
+	};
+
 	/// Creates a new compiler stack.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
@@ -166,11 +199,56 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used to generate the code of independent contracts
+	/// concurrently and to compute their outputs in computeArtifacts(). Zero selects the number
+	/// of hardware threads. If set to one (the default), contracts are compiled sequentially.
+	void setParallelism(size_t _parallelism);
+
+	/// Sets whether the checks that only report errors and warnings (immutable validation,
+	/// control flow analysis, static analysis and the view/pure checks) are restricted to the
+	/// sources that define the requested contracts and the contracts, functions and types they
+	/// use, transitively. Other sources, e.g. unused parts of imported libraries, are still type
+	/// checked, since later stages rely on the annotations. Must be set before analysis.
+	void setLazyAnalysis(bool _lazyAnalysis);
+
+	/// Sets whether the bodies of functions and modifiers in sources that do not define any
+	/// requested contract are only parsed if a declaration of the same name or the contract
+	/// defining them is referenced by the parsed code, transitively. Unparsed bodies are neither
+	/// analysed nor compiled and syntax errors in them are not reported. Only has an effect if
+	/// the requested contracts are restricted. Must be set before parsing.
+	void setDeferredParsing(bool _deferredParsing);
+
+	/// Sets whether the legacy code generator, the EVM assemblies and the IR of a contract are
+	/// released during compilation, once the code of the contract and of all contracts creating
+	/// it has been generated. The bytecode, the source mappings and the metadata are kept, while
+	/// the assembly, the gas estimates, the generated sources and the IR (unless it is requested)
+	/// of the contract are not available anymore. The ASTs are kept, since the ABI, the
+	/// documentation and the storage layout are generated from them.
+	/// Must be set before compiling.
+	void setLowMemory(bool _lowMemory);
+
+	/// Sets a callback that is used instead of the read callback to load imported files. Once the
+	/// sources known so far are parsed, all their missing imports are requested in a single call.
+	void setBatchReadCallback(ReadCallback::BatchCallback _readFiles);
+
+	/// Sets the cache in which the code generated for individual contracts is looked up before
+	/// and stored after compiling them. Assembly, gas estimates and function entry points are
+	/// not available for contracts restored from the cache. No cache is used by default.
+	void setCompilationCache(std::shared_ptr<CompilationCache const> _cache);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
 	void setEVMVersion(langutil::EVMVersion _version = langutil::EVMVersion{});
 
+	/// Replaces the EVM version, the optimiser settings and whether to compile via the IR by
+	/// @a _settings after a successful analysis and discards the generated code together with
+	/// the errors and warnings reported while generating it, so that the next call to compile()
+	/// generates the code of the analysed sources again. The EVM version must not be older than
+	/// the one used for the analysis, since the analysis only rejects the features that are not
+	/// available in that version.
+	void setBackendSettings(BackendSettings _settings);
+
 	/// Set model checker settings.
 	void setModelCheckerSettings(ModelCheckerSettings _settings);
 	/// Set which SMT solvers should be enabled.
@@ -185,6 +263,15 @@ public:
 		m_requestedContractNames = _contractNames;
 	}
 
+	/// Restricts code generation to the given contract names by source, which use the same format
+	/// as in setRequestedContractNames(). Contracts that are not selected here are still analysed
+	/// if they are requested, but only compiled if a selected contract depends on them.
+	/// If empty, code is generated for all requested contracts.
+	void setCodeGenerationContractNames(std::map<std::string, std::set<std::string>> const& _contractNames = std::map<std::string, std::set<std::string>>{})
+	{
+		m_codeGenerationContractNames = _contractNames;
+	}
+
 	/// Enable EVM Bytecode generation. This is enabled by default.
 	void enableEvmBytecodeGeneration(bool _enable = true) { m_generateEvmBytecode = _enable; }
 
@@ -194,6 +281,10 @@ public:
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Enable the attribution of the deployed code to functions, see @a sizeReport.
+	/// Has to be enabled before compilation to get a report for code generated via the IR.
+	void enableSizeReport(bool _enable = true) { m_generateSizeReport = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -206,6 +297,15 @@ public:
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
+	/// Replaces the sources by @a _sources after analysis was performed, keeping all settings.
+	/// If the previous analysis was successful, the ASTs and annotations of all sources whose
+	/// content did not change and whose imports did not change transitively are kept, and the
+	/// next calls to parse() and analyze() only process the other sources. Warnings of the kept
+	/// sources are reported again. Sources that are not part of @a _sources but were loaded
+	/// using the file reader are read again.
+	/// Pointers to AST nodes of changed sources are invalidated.
+	void updateSources(StringMap _sources);
+
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
 	void addSMTLib2Response(util::h256 const& _hash, std::string const& _response);
@@ -216,7 +316,7 @@ public:
 
 	/// Imports given SourceUnits so they can be analyzed. Leads to the same internal state as parse().
 	/// Will throw errors if the import fails
-	void importASTs(std::map<std::string, Json::Value> const& _sources);
+	void importASTs(std::map<std::string, Json::Value> _sources);
 
 	/// Performs the analysis steps (imports, scopesetting, syntaxCheck, referenceResolving,
 	///  typechecking, staticAnalysis) on previously parsed sources.
@@ -252,6 +352,11 @@ public:
 	/// @returns a list of unhandled queries to the SMT solver (has to be supplied in a second run
 	/// by calling @a addSMTLib2Response).
 	std::vector<std::string> const& unhandledSMTLib2Queries() const { return m_unhandledSMTLib2Queries; }
+	/// @returns scripts that pose the unhandled queries incrementally, one per engine.
+	/// Every query is preceded by an `echo` of its hash, which is the key of its response.
+	std::vector<std::string> const& unhandledSMTLib2Scripts() const { return m_unhandledSMTLib2Scripts; }
+	/// @returns the statistics of the model checker, which are only collected if requested in its settings.
+	ModelCheckerStatistics const& modelCheckerStatistics() const { return m_modelCheckerStatistics; }
 
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
@@ -298,10 +403,20 @@ public:
 	/// if the contract does not (yet) have bytecode.
 	std::string const* runtimeSourceMapping(std::string const& _contractName) const;
 
+	/// @returns the uncompressed mapping between the creation or runtime bytecode and sourcecode,
+	/// from which the strings above are rendered, or a nullptr if the contract does not (yet) have bytecode.
+	evmasm::SourceMapping const* sourceMappingEntries(std::string const& _contractName, bool _runtime = false) const;
+
 	/// @return a verbose text representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
-	std::string assemblyString(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	std::string assemblyString(std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
+
+	/// Writes the verbose text representation of the assembly to @a _out without
+	/// building the whole text in memory first.
+	/// @arg _sourceCodes is the map of input files to source code strings
+	/// Prerequisite: Successful compilation.
+	void assemblyStream(std::ostream& _out, std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
 
 	/// @returns a JSON representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
@@ -333,9 +448,21 @@ public:
 	/// @returns the cbor-encoded metadata.
 	bytes cborMetadata(std::string const& _contractName) const;
 
+	/// Computes the given outputs of the given contracts, keyed by their fully qualified names,
+	/// concurrently using up to the configured parallelism. The results are stored and returned
+	/// by the accessors above, so that the order in which they are retrieved does not change.
+	/// Outputs whose computation fails are left to be computed, and to fail, on access.
+	/// The generated sources are only computed after successful compilation.
+	/// Prerequisite: Successful call to parse or compile.
+	void computeArtifacts(std::map<std::string, std::set<ContractArtifact>> const& _artifacts) const;
+
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
 	Json::Value gasEstimates(std::string const& _contractName) const;
 
+	/// @returns the number of bytes of the deployed code per function or nullptr if the
+	/// contract is not deployable or the report was not enabled for code generated via the IR.
+	BytecodeSizeReport const* sizeReport(std::string const& _contractName) const;
+
 	/// Overwrites the release/prerelease flag. Should only be used for testing.
 	void overwriteReleaseFlag(bool release) { m_release = release; }
 private:
@@ -344,6 +471,8 @@ private:
 	{
 		std::shared_ptr<langutil::Scanner> scanner;
 		std::shared_ptr<SourceUnit> ast;
+		/// Bodies of functions and modifiers skipped by the parser, see setDeferredParsing().
+		std::vector<std::shared_ptr<Block>> deferredBodies;
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -364,6 +493,8 @@ private:
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
 		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		/// Parsed and optimized IR, kept until EVM code is generated from it.
+		std::shared_ptr<yul::AssemblyStack> yulIRStack;
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -375,24 +506,119 @@ private:
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		mutable std::optional<evmasm::SourceMapping const> sourceMappingEntries;
+		mutable std::optional<evmasm::SourceMapping const> runtimeSourceMappingEntries;
+		mutable std::optional<BytecodeSizeReport const> sizeReport;
+		/// Set once the work budget of the optimiser was reported as exhausted for the contract.
+		bool optimisationIncomplete = false;
 	};
 
-	/// Loads the missing sources from @a _ast (named @a _path) using the callback
-	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
-	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+	/// @returns the source units in the order of their source indices.
+	std::vector<SourceUnit const*> sourceUnitsByIndex() const;
+
+	/// @returns the generated sources of @a _contract, which are computed on first access.
+	Json::Value generatedSources(Contract const& _contract, bool _runtime) const;
+
+	/// Loads the sources imported by the parsed sources @a _paths that are still missing, using
+	/// a single call of @a m_readFiles if set and @a m_readFile for each file otherwise, and stores
+	/// the absolute paths of all imports in the AST annotations.
+	/// @returns the paths of the newly loaded sources.
+	std::vector<std::string> loadMissingSources(std::vector<std::string> const& _paths);
+	/// Stores @a _ast as the AST of the source @a _path.
+	void storeParsedSource(std::string const& _path, std::shared_ptr<SourceUnit> _ast);
+	/// Runs @a _check on the ASTs of @a _sources. With parallelism enabled, the sources are checked
+	/// concurrently, each with its own error reporter, and the errors are reported in the order
+	/// of @a _sources afterwards. @a _check must only modify the source it is given.
+	/// @returns false if @a _check returned false for any of the sources.
+	bool checkSources(
+		std::vector<Source const*> const& _sources,
+		std::function<bool(SourceUnit const&, langutil::ErrorReporter&)> const& _check
+	);
+	/// Parses @a _sourcesToParse and the sources they import using m_parallelism threads.
+	/// Node IDs, errors and loaded imports are the same as with sequential parsing.
+	void parseInParallel(std::vector<std::string> _sourcesToParse);
+	/// @returns true if the bodies of functions in the source @a _path are skipped by the parser.
+	bool deferBodies(std::string const& _path) const;
+	/// Parses the deferred bodies of functions and modifiers that are referenced by name from
+	/// parsed code, either directly or through the contract defining them.
+	void parseDeferredBodies();
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
 	/// Store the contract definitions in m_contracts.
 	void storeContractDefinitions();
 
+	/// @returns true if @a _error is located in one of the sources kept by updateSources().
+	bool isInUnchangedSource(langutil::Error const& _error) const;
+
 	/// @returns true if the source is requested to be compiled.
 	bool isRequestedSource(std::string const& _sourceName) const;
 
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
+	/// @returns the source units that define the requested contracts or any contract, function,
+	/// type or variable referenced by them, transitively. Requires the type checker to have run.
+	std::set<SourceUnit const*> sourcesUsedByRequestedContracts() const;
+
+	/// @returns true if code is to be generated for the contract.
+	bool isCodeGenerationRequested(ContractDefinition const& _contract) const;
+
+	/// Runs all code generation steps selected by the settings for a single contract
+	/// and the contracts it depends on.
+	/// @param _requested if false, only generates the artifacts needed to compile the contracts
+	///                   depending on @a _contract.
+	void generateCode(
+		ContractDefinition const& _contract,
+		bool _requested,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+	);
+
+	/// Prepares the release of intermediate representations in low-memory mode for the code
+	/// generation of @a _contracts and the contracts they depend on.
+	/// @param _separateDependencies whether generateCode() is called for the dependencies that are
+	///                              not part of @a _contracts, too.
+	void prepareLowMemoryRelease(std::vector<ContractDefinition const*> const& _contracts, bool _separateDependencies);
+	/// Called in low-memory mode after generateCode() for @a _contract. Releases the intermediate
+	/// representations of @a _contract and the contracts it depends on once they are not needed
+	/// for code generation anymore and removes their compilers from @a _otherCompilers.
+	void finishCodeGeneration(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+	);
+
+	/// Generates the code of @a _contracts and of all contracts they depend on, using up to
+	/// m_parallelism threads. A contract is only compiled after all its dependencies.
+	/// Warnings are reported in dependency order, independent of the scheduling.
+	/// @returns the exception of the first contract that failed to compile in sequential
+	/// compilation order or nullptr if all contracts were compiled successfully.
+	std::exception_ptr generateCodeInParallel(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// @returns the error reporter to be used for warnings during code generation. This is
+	/// local to the current contract during parallel code generation.
+	langutil::ErrorReporter& codeGenerationErrorReporter();
+
+	/// @returns the key of the code generated for @a _contract in the compilation cache.
+	/// It covers the metadata (i.e. the compiler version, the settings and the hashes of all
+	/// sources the contract depends on), the requested kinds of output, the AST IDs and the
+	/// source indices.
+	util::h256 compilationCacheKey(ContractDefinition const& _contract) const;
+	/// Restores the code of those of @a _contracts that are found in the compilation cache.
+	/// @returns the contracts that still have to be compiled.
+	std::vector<ContractDefinition const*> restoreFromCompilationCache(
+		std::vector<ContractDefinition const*> const& _contracts
+	);
+	/// Stores the code generated for @a _contracts in the compilation cache.
+	void storeInCompilationCache(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Warns if the runtime code of @a _contract exceeds the limit introduced in Spurious Dragon.
+	void checkCodeSize(ContractDefinition const& _contract);
+	/// Warns if @a _contract requests the ABI coder v1 but is compiled to the IR.
+	void checkABICoderForIR(ContractDefinition const& _contract);
+	/// Warns once per contract that the optimiser skipped steps for @a _contract
+	/// because its work budget was exhausted.
+	void reportIncompleteOptimisation(ContractDefinition const& _contract);
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -463,17 +689,34 @@ private:
 	) const;
 
 	ReadCallback::Callback m_readFile;
+	ReadCallback::BatchCallback m_readFiles;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	size_t m_parallelism = 1;
+	bool m_lazyAnalysis = false;
+	bool m_deferredParsing = false;
+	bool m_lowMemory = false;
+	/// Number of code generation steps (of the contract itself and of the contracts depending on it)
+	/// that have to finish before the intermediate representations of a contract are released.
+	std::map<ContractDefinition const*, size_t> m_pendingCodeGeneration;
+	/// Contracts whose code and whose dependencies' code has been generated.
+	std::set<ContractDefinition const*> m_finishedCodeGeneration;
+	std::set<ContractDefinition const*> m_releasedContracts;
+	std::mutex m_lowMemoryMutex;
+	std::shared_ptr<CompilationCache const> m_compilationCache;
 	langutil::EVMVersion m_evmVersion;
+	/// EVM version of the last analysis, which setBackendSettings() must not go below.
+	langutil::EVMVersion m_analysisEVMVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
 	smtutil::SMTSolverChoice m_enabledSMTSolvers;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
+	std::map<std::string, std::set<std::string>> m_codeGenerationContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
 	bool m_generateEwasm = false;
+	bool m_generateSizeReport = false;
 	std::map<std::string, util::h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
@@ -482,10 +725,20 @@ private:
 	// if imported, store AST-JSONS for each filename
 	std::map<std::string, Json::Value> m_sourceJsons;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
+	std::vector<std::string> m_unhandledSMTLib2Scripts;
+	ModelCheckerStatistics m_modelCheckerStatistics;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
+	/// Sources kept by updateSources() that are not parsed and analysed again.
+	std::set<std::string> m_unchangedSources;
+	/// Largest AST ID used by the sources kept by updateSources().
+	int64_t m_lastNodeID = 0;
+	/// Errors and warnings reported up to the end of the last analysis.
+	langutil::ErrorList m_analysisErrors;
 	std::map<std::string const, Contract> m_contracts;
+	/// Yul utility functions generated for one contract, reused by all others of the same compilation.
+	std::shared_ptr<MultiUseYulFunctionCache> m_yulFunctionCache;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
 	bool m_metadataLiteralSources = false;
@@ -78,7 +78,7 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 		);
 	}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state);
+	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state, m_maxLoopIterations);
 }
 
 GasEstimator::GasConsumption GasEstimator::functionalEstimation(
@@ -94,13 +94,16 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 		return GasConsumption::infinite();
 
 	// Store an invalid return value on the stack, so that the path estimator breaks upon reaching
-	// the return jump.
-	AssemblyItem invalidTag(PushTag, u256(-0x10));
-	state->feedItem(invalidTag, true);
-	if (parametersSize > 0)
-		state->feedItem(swapInstruction(parametersSize));
+	// the return jump. Subroutines do not have a return value on the stack and stop at RETURNSUB.
+	if (!_items.at(_offset).isSubroutineEntry())
+	{
+		AssemblyItem invalidTag(PushTag, u256(-0x10));
+		state->feedItem(invalidTag, true);
+		if (parametersSize > 0)
+			state->feedItem(swapInstruction(parametersSize));
+	}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state, m_maxLoopIterations);
 }
 
 set<ASTNode const*> GasEstimator::finestNodesAtLocation(
@@ -46,7 +46,11 @@ public:
 	using ASTGasConsumptionSelfAccumulated =
 		std::map<ASTNode const*, std::array<GasConsumption, 2>>;
 
-	explicit GasEstimator(langutil::EVMVersion _evmVersion): m_evmVersion(_evmVersion) {}
+	/// @param _maxLoopIterations number of loop iterations to assume for functions with loops,
+	/// whose estimate is infinite otherwise. The estimate is then only an upper bound for
+	/// executions that stay below this number.
+	explicit GasEstimator(langutil::EVMVersion _evmVersion, unsigned _maxLoopIterations = 0):
+		m_evmVersion(_evmVersion), m_maxLoopIterations(_maxLoopIterations) {}
 
 	/// @returns the estimated gas consumption by the (public or external) function with the
 	/// given signature. If no signature is given, estimates the maximum gas usage.
@@ -68,6 +72,7 @@ private:
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
 	langutil::EVMVersion m_evmVersion;
+	unsigned m_maxLoopIterations = 0;
 };
 
 }
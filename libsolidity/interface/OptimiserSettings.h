@@ -24,7 +24,9 @@
 #pragma once
 
 #include <cstddef>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -45,7 +47,7 @@ struct OptimiserSettings
 			"xarulrul"                 // Prune a bit more in SSA
 			"xarrcL"                   // Turn into SSA again and simplify
 			"gvif"                     // Run full inliner
-			"CTUcarrLsTOtfDncarrIulc"  // SSA plus simplify
+			"CTUcarrLsTFOtfDncarrIAulc" // SSA plus simplify
 		"]"
 		"jmuljuljul VcTOcul jmul";     // Make source short and pretty
 
@@ -90,11 +92,20 @@ struct OptimiserSettings
 			runJumpdestRemover == _other.runJumpdestRemover &&
 			runPeephole == _other.runPeephole &&
 			runDeduplicate == _other.runDeduplicate &&
+			runBlockReorderer == _other.runBlockReorderer &&
 			runCSE == _other.runCSE &&
+			runCSEAcrossBlocks == _other.runCSEAcrossBlocks &&
+			runOutliner == _other.runOutliner &&
+			runModifierOutliner == _other.runModifierOutliner &&
+			useSubroutines == _other.useSubroutines &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
+			yulOptimiserAlternativeSteps == _other.yulOptimiserAlternativeSteps &&
+			yulOptimiserGasCosts == _other.yulOptimiserGasCosts &&
+			reasoningMaxQueries == _other.reasoningMaxQueries &&
+			workBudget == _other.workBudget &&
 			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
 	}
 
@@ -107,8 +118,23 @@ struct OptimiserSettings
 	bool runPeephole = false;
 	/// Assembly block deduplicator
 	bool runDeduplicate = false;
+	/// Move the targets of unconditional jumps behind the jumps so that the jumps can be removed.
+	bool runBlockReorderer = false;
 	/// Common subexpression eliminator based on assembly items.
 	bool runCSE = false;
+	/// Keep the knowledge of the common subexpression eliminator for code that can only be
+	/// reached from the preceding code, e.g. after a conditional jump. Requires runCSE.
+	bool runCSEAcrossBlocks = false;
+	/// Replace repeated code at the end of blocks (e.g. reverts) by jumps to a single copy,
+	/// if the smaller code outweighs the costs of the jumps.
+	bool runOutliner = false;
+	/// Compile the code before and after the placeholder of modifiers used by many functions
+	/// into routines shared by these functions in the legacy code generator.
+	bool runModifierOutliner = false;
+	/// Compile internal functions and Yul functions to subroutines (EIP-2315) that are called via
+	/// JUMPSUB and do not keep their return address on the stack. Only has an effect for EVM
+	/// versions that support subroutines.
+	bool useSubroutines = false;
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
@@ -121,6 +147,20 @@ struct OptimiserSettings
 	/// them just by setting this to an empty string. Set @a runYulOptimiser to false if you want
 	/// no optimisations.
 	std::string yulOptimiserSteps = DefaultYulOptimiserSteps;
+	/// Further sequences of optimisation steps. If any are given, each Yul object is optimised
+	/// with @a yulOptimiserSteps and with each of these sequences on separate copies, in parallel
+	/// if possible, and the result with the lowest estimated costs is kept.
+	std::vector<std::string> yulOptimiserAlternativeSteps;
+	/// Let the Yul optimiser decide whether to duplicate expressions based on their gas costs
+	/// (weighted by @a expectedExecutionsPerDeployment) instead of a rough code size estimate.
+	bool yulOptimiserGasCosts = false;
+	/// Maximum number of solver queries the ReasoningBasedSimplifier makes per Yul object.
+	/// Queries answered from its cache are not counted.
+	std::optional<size_t> reasoningMaxQueries;
+	/// Maximum number of work units the Yul optimiser spends on each Yul object and the
+	/// opcode-based optimiser spends on each assembly. A step or round costs as many units as
+	/// the code it processes is large. Once it is exhausted, the remaining expensive steps are skipped.
+	std::optional<size_t> workBudget;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
@@ -23,6 +23,7 @@
 #include <boost/noncopyable.hpp>
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -58,6 +59,9 @@ public:
 
 	/// File reading or generic query callback.
 	using Callback = std::function<Result(std::string const&, std::string const&)>;
+	/// Callback that performs several file reads or queries of the same kind at once, e.g.
+	/// concurrently. Returns one result per query, in the order of the queries.
+	using BatchCallback = std::function<std::vector<Result>(std::string const&, std::vector<std::string> const&)>;
 };
 
 }
@@ -23,6 +23,7 @@
 
 #include <libsolidity/interface/StandardCompiler.h>
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/Exceptions.h>
@@ -33,11 +34,14 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
+#include <functional>
 #include <optional>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -172,13 +176,16 @@ bool hashMatchesContent(string const& _hash, string const& _content)
 bool isArtifactRequested(Json::Value const& _outputSelection, string const& _artifact, bool _wildcardMatchesExperimental)
 {
 	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast"};
+	// Outputs that are only produced if they are selected by their full name.
+	static set<string> explicitOnly{"evm.bytecode.sourceMapBinary", "evm.deployedBytecode.sourceMapBinary"};
 	for (auto const& selectedArtifactJson: _outputSelection)
 	{
 		string const& selectedArtifact = selectedArtifactJson.asString();
-		if (
-			_artifact == selectedArtifact ||
-			boost::algorithm::starts_with(_artifact, selectedArtifact + ".")
-		)
+		if (_artifact == selectedArtifact)
+			return true;
+		else if (explicitOnly.count(_artifact))
+			continue;
+		else if (boost::algorithm::starts_with(_artifact, selectedArtifact + "."))
 			return true;
 		else if (selectedArtifact == "*")
 		{
@@ -240,18 +247,16 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _fil
 vector<string> evmObjectComponents(string const& _objectKind)
 {
 	solAssert(_objectKind == "bytecode" || _objectKind == "deployedBytecode", "");
-	vector<string> components{"", ".object", ".opcodes", ".sourceMap", ".generatedSources", ".linkReferences"};
+	vector<string> components{"", ".object", ".opcodes", ".sourceMap", ".sourceMapBinary", ".generatedSources", ".linkReferences"};
 	if (_objectKind == "deployedBytecode")
 		components.push_back(".immutableReferences");
 	return util::applyMap(components, [&](auto const& _s) { return "evm." + _objectKind + _s; });
 }
 
 /// @returns true if any binary was requested, i.e. we actually have to perform compilation.
-bool isBinaryRequested(Json::Value const& _outputSelection)
+/// @returns true if any of the outputs selected for a contract (@a _requests) requires code generation.
+bool requiresBinaries(Json::Value const& _requests)
 {
-	if (!_outputSelection.isObject())
-		return false;
-
 	// This does not include "evm.methodIdentifiers" on purpose!
 	static vector<string> const outputsThatRequireBinaries = vector<string>{
 		"*",
@@ -260,14 +265,43 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
 	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
 
+	for (auto const& output: outputsThatRequireBinaries)
+		if (isArtifactRequested(_requests, output, false))
+			return true;
+	return false;
+}
+
+bool isBinaryRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
 	for (auto const& fileRequests: _outputSelection)
 		for (auto const& requests: fileRequests)
-			for (auto const& output: outputsThatRequireBinaries)
-				if (isArtifactRequested(requests, output, false))
-					return true;
+			if (requiresBinaries(requests))
+				return true;
 	return false;
 }
 
+/// @returns the contract names by source for which outputs requiring code generation are selected,
+/// in the format used by requestedContractNames().
+map<string, set<string>> codeGenerationContractNames(Json::Value const& _outputSelection)
+{
+	map<string, set<string>> contracts;
+	if (!_outputSelection.isObject())
+		return contracts;
+	for (auto const& sourceName: _outputSelection.getMemberNames())
+	{
+		Json::Value const& fileRequests = _outputSelection[sourceName];
+		if (!fileRequests.isObject())
+			continue;
+		for (auto const& contractName: fileRequests.getMemberNames())
+			if (requiresBinaries(fileRequests[contractName]))
+				contracts[(sourceName == "*") ? "" : sourceName].insert((contractName == "*") ? "" : contractName);
+	}
+	return contracts;
+}
+
 /// @returns true if EVM bytecode was requested, i.e. we have to run the old code generator.
 bool isEvmBytecodeRequested(Json::Value const& _outputSelection)
 {
@@ -322,6 +356,37 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if any output was requested that is generated from the EVM assembly,
+/// which is not available for contracts restored from the compilation cache.
+bool isAssemblyRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	static vector<string> const outputsThatRequireAssembly{"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"};
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& output: outputsThatRequireAssembly)
+				if (isArtifactRequested(requests, output, false))
+					return true;
+	return false;
+}
+
+/// @returns true if the Yul sources generated by the legacy code generator were requested.
+bool isGeneratedSourcesRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (char const* output: {"evm.bytecode.generatedSources", "evm.deployedBytecode.generatedSources"})
+				if (isArtifactRequested(requests, output, false))
+					return true;
+	return false;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret(Json::objectValue);
@@ -375,6 +440,7 @@ Json::Value formatImmutableReferences(map<u256, pair<string, vector<size_t>>> co
 Json::Value collectEVMObject(
 	evmasm::LinkerObject const& _object,
 	string const* _sourceMap,
+	evmasm::SourceMapping const* _sourceMapEntries,
 	Json::Value _generatedSources,
 	bool _runtimeObject,
 	function<bool(string)> const& _artifactRequested
@@ -387,6 +453,14 @@ Json::Value collectEVMObject(
 		output["opcodes"] = evmasm::disassemble(_object.bytecode);
 	if (_artifactRequested("sourceMap"))
 		output["sourceMap"] = _sourceMap ? *_sourceMap : "";
+	if (_artifactRequested("sourceMapBinary"))
+	{
+		optional<evmasm::SourceMapping> decompressed;
+		if (!_sourceMapEntries && _sourceMap)
+			if ((decompressed = evmasm::AssemblyItem::decompressSourceMapping(*_sourceMap)))
+				_sourceMapEntries = &*decompressed;
+		output["sourceMapBinary"] = _sourceMapEntries ? util::toHex(evmasm::AssemblyItem::encodeSourceMapping(*_sourceMapEntries)) : "";
+	}
 	if (_artifactRequested("linkReferences"))
 		output["linkReferences"] = formatLinkReferences(_object.linkReferences);
 	if (_runtimeObject && _artifactRequested("immutableReferences"))
@@ -428,13 +502,25 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "cache", "debug", "deferredParsing", "evmVersion", "lazyAnalysis", "libraries", "lowMemory", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "targets", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
+std::optional<Json::Value> checkCacheKeys(Json::Value const& _input)
+{
+	static set<string> keys{"directory"};
+	return checkKeys(_input, keys, "settings.cache");
+}
+
+std::optional<Json::Value> checkTargetKeys(Json::Value const& _input)
+{
+	static set<string> keys{"evmVersion", "optimizer", "viaIR"};
+	return checkKeys(_input, keys, "settings.targets");
+}
+
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"engine", "targets", "timeout"};
+	static set<string> keys{"cache", "chcCounterexamples", "engine", "jobs", "modular", "reuseInvariants", "showStats", "slicing", "targets", "timeout", "totalTimeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -446,7 +532,7 @@ std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "blockReorderer", "cse", "cseAcrossBlocks", "outliner", "modifierOutliner", "subroutines", "constantOptimizer", "yul", "yulDetails", "workBudget"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -586,8 +672,18 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "deduplicate", settings.runDeduplicate))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "blockReorderer", settings.runBlockReorderer))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "cse", settings.runCSE))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "cseAcrossBlocks", settings.runCSEAcrossBlocks))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "outliner", settings.runOutliner))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "modifierOutliner", settings.runModifierOutliner))
+			return *error;
+		if (auto error = checkOptimizerDetail(details, "subroutines", settings.useSubroutines))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
@@ -598,20 +694,246 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "alternativeOptimizerSteps", "gasCosts", "reasoningMaxQueries"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps))
 				return *error;
+			if (details["yulDetails"].isMember("alternativeOptimizerSteps"))
+			{
+				Json::Value const& sequences = details["yulDetails"]["alternativeOptimizerSteps"];
+				if (!sequences.isArray())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.alternativeOptimizerSteps\" must be an array of strings.");
+				for (Json::Value const& sequence: sequences)
+				{
+					if (!sequence.isString())
+						return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.alternativeOptimizerSteps\" must be an array of strings.");
+					try
+					{
+						yul::OptimiserSuite::validateSequence(sequence.asString());
+					}
+					catch (yul::OptimizerException const& _exception)
+					{
+						return formatFatalError(
+							"JSONError",
+							"Invalid optimizer step sequence in \"settings.optimizer.details.yulDetails.alternativeOptimizerSteps\": " +
+							string(_exception.what())
+						);
+					}
+					settings.yulOptimiserAlternativeSteps.push_back(sequence.asString());
+				}
+			}
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "gasCosts", settings.yulOptimiserGasCosts))
+				return *error;
+			if (details["yulDetails"].isMember("reasoningMaxQueries"))
+			{
+				if (!details["yulDetails"]["reasoningMaxQueries"].isUInt())
+					return formatFatalError("JSONError", "\"settings.optimizer.details.yulDetails.reasoningMaxQueries\" must be an unsigned integer.");
+				settings.reasoningMaxQueries = details["yulDetails"]["reasoningMaxQueries"].asUInt();
+			}
+		}
+		if (details.isMember("workBudget"))
+		{
+			if (!details["workBudget"].isUInt())
+				return formatFatalError("JSONError", "\"settings.optimizer.details.workBudget\" must be an unsigned integer.");
+			settings.workBudget = details["workBudget"].asUInt();
 		}
 	}
 	return { std::move(settings) };
 }
 
+/// Appends the errors and warnings in @a _errorList to @a _errors.
+void appendErrors(ErrorList const& _errorList, Json::Value& _errors)
+{
+	for (auto const& error: _errorList)
+	{
+		Error const& err = dynamic_cast<Error const&>(*error);
+
+		_errors.append(formatErrorWithException(
+			*error,
+			err.type() == Error::Type::Warning,
+			err.typeName(),
+			"general",
+			"",
+			err.errorId()
+		));
+	}
 }
 
-std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
+/// Runs @a _compile and appends an error describing the exception to @a _errors if it throws.
+void runCatchingExceptions(function<void()> const& _compile, Json::Value& _errors)
+{
+	try
+	{
+		_compile();
+	}
+	/// This is only thrown in a very few locations.
+	catch (Error const& _error)
+	{
+		_errors.append(formatErrorWithException(
+			_error,
+			false,
+			_error.typeName(),
+			"general",
+			"Uncaught error: "
+		));
+	}
+	/// This should not be leaked from compile().
+	catch (FatalError const& _exception)
+	{
+		_errors.append(formatError(
+			false,
+			"FatalError",
+			"general",
+			"Uncaught fatal error: " + boost::diagnostic_information(_exception)
+		));
+	}
+	catch (CompilerError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_exception,
+			false,
+			"CompilerError",
+			"general",
+			"Compiler error (" + _exception.lineInfo() + ")"
+		));
+	}
+	catch (InternalCompilerError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_exception,
+			false,
+			"InternalCompilerError",
+			"general",
+			"Internal compiler error (" + _exception.lineInfo() + ")"
+		));
+	}
+	catch (UnimplementedFeatureError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_exception,
+			false,
+			"UnimplementedFeatureError",
+			"general",
+			"Unimplemented feature (" + _exception.lineInfo() + ")"
+		));
+	}
+	catch (yul::YulException const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_exception,
+			false,
+			"YulException",
+			"general",
+			"Yul exception"
+		));
+	}
+	catch (smtutil::SMTLogicError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_exception,
+			false,
+			"SMTLogicException",
+			"general",
+			"SMT logic exception"
+		));
+	}
+	catch (util::Exception const& _exception)
+	{
+		_errors.append(formatError(
+			false,
+			"Exception",
+			"general",
+			"Exception during compilation: " + boost::diagnostic_information(_exception)
+		));
+	}
+	catch (std::exception const& _e)
+	{
+		_errors.append(formatError(
+			false,
+			"Exception",
+			"general",
+			"Unknown exception during compilation" + (_e.what() ? ": " + string(_e.what()) : ".")
+		));
+	}
+	catch (...)
+	{
+		_errors.append(formatError(
+			false,
+			"Exception",
+			"general",
+			"Unknown exception during compilation."
+		));
+	}
+}
+
+/// Writes the members of @a _output preceding "contracts" and then the output of each
+/// contract to @a _writer as soon as it has been generated by @a _contractOutput.
+/// The written members are removed from @a _output. Nothing is written if there are no
+/// contract outputs.
+void streamContracts(
+	util::CompactJsonObjectWriter& _writer,
+	Json::Value& _output,
+	map<string, map<string, string>> const& _contractsByFile,
+	function<Json::Value(string const&, string const&, string const&)> const& _contractOutput
+)
+{
+	optional<util::CompactJsonObjectWriter> contractsWriter;
+	optional<util::CompactJsonObjectWriter> fileWriter;
+	auto closeWriters = [&]() {
+		if (fileWriter)
+			fileWriter->close();
+		if (contractsWriter)
+			contractsWriter->close();
+	};
+
+	try
+	{
+		for (auto const& [file, contracts]: _contractsByFile)
+		{
+			fileWriter.reset();
+			for (auto const& [name, contractName]: contracts)
+			{
+				Json::Value contractData = _contractOutput(file, name, contractName);
+				if (contractData.empty())
+					continue;
+
+				if (!contractsWriter)
+				{
+					for (string const& key: _output.getMemberNames())
+						if (key < "contracts")
+						{
+							_writer.writeMember(key, _output[key]);
+							_output.removeMember(key);
+						}
+					contractsWriter.emplace(_writer.writeObjectMember("contracts"));
+				}
+				if (!fileWriter)
+					fileWriter.emplace(contractsWriter->writeObjectMember(file));
+				fileWriter->writeMember(name, contractData);
+			}
+			if (fileWriter)
+				fileWriter->close();
+		}
+		fileWriter.reset();
+	}
+	catch (...)
+	{
+		// Keep the output well-formed so that the error can still be reported after the
+		// contracts written so far.
+		closeWriters();
+		throw;
+	}
+	closeWriters();
+}
+
+}
+
+std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(
+	Json::Value const& _input,
+	StringMap* _sources
+)
 {
 	InputsAndSettings ret;
 
@@ -628,11 +950,17 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	if (!sources.isObject() && !sources.isNull())
 		return formatFatalError("JSONError", "\"sources\" is not a JSON object.");
 
-	if (sources.empty())
+	if (_sources && !sources.isNull())
+		return formatFatalError("JSONError", "\"sources\" must not be given if the sources are passed separately.");
+
+	if (_sources ? _sources->empty() : sources.empty())
 		return formatFatalError("JSONError", "No input sources specified.");
 
 	ret.errors = Json::arrayValue;
 
+	if (_sources)
+		ret.sources = std::move(*_sources);
+
 	for (auto const& sourceName: sources.getMemberNames())
 	{
 		string hash;
@@ -654,7 +982,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -770,6 +1098,46 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt())
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be an unsigned integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
+	if (settings.isMember("lazyAnalysis"))
+	{
+		if (!settings["lazyAnalysis"].isBool())
+			return formatFatalError("JSONError", "\"settings.lazyAnalysis\" must be a Boolean.");
+		ret.lazyAnalysis = settings["lazyAnalysis"].asBool();
+	}
+
+	if (settings.isMember("deferredParsing"))
+	{
+		if (!settings["deferredParsing"].isBool())
+			return formatFatalError("JSONError", "\"settings.deferredParsing\" must be a Boolean.");
+		ret.deferredParsing = settings["deferredParsing"].asBool();
+	}
+
+	if (settings.isMember("lowMemory"))
+	{
+		if (!settings["lowMemory"].isBool())
+			return formatFatalError("JSONError", "\"settings.lowMemory\" must be a Boolean.");
+		ret.lowMemory = settings["lowMemory"].asBool();
+	}
+
+	if (settings.isMember("cache"))
+	{
+		Json::Value const& cacheSettings = settings["cache"];
+		if (!cacheSettings.isObject())
+			return formatFatalError("JSONError", "\"settings.cache\" must be an object.");
+		if (auto result = checkCacheKeys(cacheSettings))
+			return *result;
+		if (!cacheSettings["directory"].isString() || cacheSettings["directory"].asString().empty())
+			return formatFatalError("JSONError", "\"settings.cache.directory\" must be a non-empty string.");
+		ret.cacheDirectory = cacheSettings["directory"].asString();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -782,7 +1150,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 	if (settings.isMember("debug"))
 	{
-		if (auto result = checkKeys(settings["debug"], {"revertStrings"}, "settings.debug"))
+		if (auto result = checkKeys(settings["debug"], {"revertStrings", "timing"}, "settings.debug"))
 			return *result;
 
 		if (settings["debug"].isMember("revertStrings"))
@@ -799,6 +1167,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 				);
 			ret.revertStrings = *revertStrings;
 		}
+
+		if (settings["debug"].isMember("timing"))
+		{
+			if (!settings["debug"]["timing"].isBool())
+				return formatFatalError("JSONError", "settings.debug.timing must be a Boolean.");
+			ret.timing = settings["debug"]["timing"].asBool();
+		}
 	}
 
 	if (settings.isMember("remappings") && !settings["remappings"].isArray())
@@ -823,6 +1198,50 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 			ret.optimiserSettings = std::get<OptimiserSettings>(std::move(optimiserSettings));
 	}
 
+	if (settings.isMember("targets"))
+	{
+		if (!settings["targets"].isArray())
+			return formatFatalError("JSONError", "\"settings.targets\" must be an array of objects.");
+		for (auto const& target: settings["targets"])
+		{
+			if (!target.isObject())
+				return formatFatalError("JSONError", "\"settings.targets\" must be an array of objects.");
+			if (auto result = checkTargetKeys(target))
+				return *result;
+
+			CompilerStack::BackendSettings backendSettings{ret.evmVersion, ret.optimiserSettings, ret.viaIR};
+			if (target.isMember("evmVersion"))
+			{
+				if (!target["evmVersion"].isString())
+					return formatFatalError("JSONError", "The \"evmVersion\" of a target must be a string.");
+				std::optional<langutil::EVMVersion> version = langutil::EVMVersion::fromString(target["evmVersion"].asString());
+				if (!version)
+					return formatFatalError("JSONError", "Invalid EVM version requested for a target.");
+				if (*version < ret.evmVersion)
+					return formatFatalError(
+						"JSONError",
+						"The EVM version of a target must not be older than \"settings.evmVersion\", "
+						"which is used for the analysis."
+					);
+				backendSettings.evmVersion = *version;
+			}
+			if (target.isMember("optimizer"))
+			{
+				auto optimiserSettings = parseOptimizerSettings(target["optimizer"]);
+				if (std::holds_alternative<Json::Value>(optimiserSettings))
+					return std::get<Json::Value>(std::move(optimiserSettings)); // was an error
+				backendSettings.optimiserSettings = std::get<OptimiserSettings>(std::move(optimiserSettings));
+			}
+			if (target.isMember("viaIR"))
+			{
+				if (!target["viaIR"].isBool())
+					return formatFatalError("JSONError", "The \"viaIR\" setting of a target must be a Boolean.");
+				backendSettings.viaIR = target["viaIR"].asBool();
+			}
+			ret.targets.emplace_back(std::move(backendSettings));
+		}
+	}
+
 	Json::Value jsonLibraries = settings.get("libraries", Json::Value(Json::objectValue));
 	if (!jsonLibraries.isObject())
 		return formatFatalError("JSONError", "\"libraries\" is not a JSON object.");
@@ -925,18 +1344,100 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("totalTimeout"))
+	{
+		if (!modelCheckerSettings["totalTimeout"].isUInt())
+			return formatFatalError("JSONError", "settings.modelChecker.totalTimeout must be an unsigned integer.");
+		ret.modelCheckerSettings.totalTimeout = modelCheckerSettings["totalTimeout"].asUInt();
+	}
+
+	if (modelCheckerSettings.isMember("jobs"))
+	{
+		if (!modelCheckerSettings["jobs"].isUInt())
+			return formatFatalError("JSONError", "settings.modelChecker.jobs must be an unsigned integer.");
+		ret.modelCheckerSettings.jobs = modelCheckerSettings["jobs"].asUInt();
+	}
+
+	if (modelCheckerSettings.isMember("cache"))
+	{
+		if (!modelCheckerSettings["cache"].isString() || modelCheckerSettings["cache"].asString().empty())
+			return formatFatalError("JSONError", "settings.modelChecker.cache must be a non-empty string.");
+		ret.modelCheckerSettings.cacheDirectory = modelCheckerSettings["cache"].asString();
+	}
+
+	if (modelCheckerSettings.isMember("modular"))
+	{
+		if (!modelCheckerSettings["modular"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.modular must be a Boolean.");
+		ret.modelCheckerSettings.modular = modelCheckerSettings["modular"].asBool();
+	}
+
+	if (modelCheckerSettings.isMember("chcCounterexamples"))
+	{
+		if (!modelCheckerSettings["chcCounterexamples"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.chcCounterexamples must be a Boolean.");
+		ret.modelCheckerSettings.chcCounterexamples = modelCheckerSettings["chcCounterexamples"].asBool();
+	}
+
+	if (modelCheckerSettings.isMember("slicing"))
+	{
+		if (!modelCheckerSettings["slicing"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.slicing must be a Boolean.");
+		ret.modelCheckerSettings.slicing = modelCheckerSettings["slicing"].asBool();
+	}
+
+	if (modelCheckerSettings.isMember("reuseInvariants"))
+	{
+		if (!modelCheckerSettings["reuseInvariants"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.reuseInvariants must be a Boolean.");
+		ret.modelCheckerSettings.reuseInvariants = modelCheckerSettings["reuseInvariants"].asBool();
+	}
+
+	if (modelCheckerSettings.isMember("showStats"))
+	{
+		if (!modelCheckerSettings["showStats"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.showStats must be a Boolean.");
+		ret.modelCheckerSettings.showStats = modelCheckerSettings["showStats"].asBool();
+	}
+
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(
+	StandardCompiler::InputsAndSettings _inputsAndSettings,
+	util::CompactJsonObjectWriter* _writer
+)
 {
 	CompilerStack compilerStack(m_readFile);
+	compilerStack.setBatchReadCallback(m_readFiles);
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
+	// The input sources are only needed again for the assembly output.
+	StringMap sourceList;
+	if (isAssemblyRequested(_inputsAndSettings.outputSelection))
+		sourceList = _inputsAndSettings.sources;
+	compilerStack.setSources(std::move(_inputsAndSettings.sources));
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.setLazyAnalysis(_inputsAndSettings.lazyAnalysis);
+	compilerStack.setDeferredParsing(_inputsAndSettings.deferredParsing);
+	// The outputs generated from the assembly need the intermediate representations that are
+	// released in low-memory mode.
+	compilerStack.setLowMemory(
+		_inputsAndSettings.lowMemory &&
+		!isAssemblyRequested(_inputsAndSettings.outputSelection) &&
+		!isGeneratedSourcesRequested(_inputsAndSettings.outputSelection)
+	);
+	// Contracts restored from the cache do not have an assembly, so it is only used if no output
+	// generated from the assembly was requested.
+	if (!isAssemblyRequested(_inputsAndSettings.outputSelection))
+	{
+		if (_inputsAndSettings.cacheDirectory)
+			compilerStack.setCompilationCache(make_shared<CompilationCache>(*_inputsAndSettings.cacheDirectory));
+		else if (m_compilationCache)
+			compilerStack.setCompilationCache(m_compilationCache);
+	}
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(_inputsAndSettings.remappings);
@@ -946,6 +1447,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
 	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+	compilerStack.setCodeGenerationContractNames(codeGenerationContractNames(_inputsAndSettings.outputSelection));
 	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
@@ -956,128 +1458,16 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
 
-	try
-	{
+	runCatchingExceptions([&]() {
 		if (binariesRequested)
 			compilerStack.compile();
 		else
 			compilerStack.parseAndAnalyze(_inputsAndSettings.stopAfter);
-
-		for (auto const& error: compilerStack.errors())
-		{
-			Error const& err = dynamic_cast<Error const&>(*error);
-
-			errors.append(formatErrorWithException(
-				*error,
-				err.type() == Error::Type::Warning,
-				err.typeName(),
-				"general",
-				"",
-				err.errorId()
-			));
-		}
-	}
-	/// This is only thrown in a very few locations.
-	catch (Error const& _error)
-	{
-		errors.append(formatErrorWithException(
-			_error,
-			false,
-			_error.typeName(),
-			"general",
-			"Uncaught error: "
-		));
-	}
-	/// This should not be leaked from compile().
-	catch (FatalError const& _exception)
-	{
-		errors.append(formatError(
-			false,
-			"FatalError",
-			"general",
-			"Uncaught fatal error: " + boost::diagnostic_information(_exception)
-		));
-	}
-	catch (CompilerError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			_exception,
-			false,
-			"CompilerError",
-			"general",
-			"Compiler error (" + _exception.lineInfo() + ")"
-		));
-	}
-	catch (InternalCompilerError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			_exception,
-			false,
-			"InternalCompilerError",
-			"general",
-			"Internal compiler error (" + _exception.lineInfo() + ")"
-		));
-	}
-	catch (UnimplementedFeatureError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			_exception,
-			false,
-			"UnimplementedFeatureError",
-			"general",
-			"Unimplemented feature (" + _exception.lineInfo() + ")"
-		));
-	}
-	catch (yul::YulException const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			_exception,
-			false,
-			"YulException",
-			"general",
-			"Yul exception"
-		));
-	}
-	catch (smtutil::SMTLogicError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			_exception,
-			false,
-			"SMTLogicException",
-			"general",
-			"SMT logic exception"
-		));
-	}
-	catch (util::Exception const& _exception)
-	{
-		errors.append(formatError(
-			false,
-			"Exception",
-			"general",
-			"Exception during compilation: " + boost::diagnostic_information(_exception)
-		));
-	}
-	catch (std::exception const& _e)
-	{
-		errors.append(formatError(
-			false,
-			"Exception",
-			"general",
-			"Unknown exception during compilation" + (_e.what() ? ": " + string(_e.what()) : ".")
-		));
-	}
-	catch (...)
-	{
-		errors.append(formatError(
-			false,
-			"Exception",
-			"general",
-			"Unknown exception during compilation."
-		));
-	}
+		appendErrors(compilerStack.errors(), errors);
+	}, errors);
 
 	bool analysisPerformed = compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
-	bool const compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+	bool compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
 
 	if (compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
 		analysisPerformed = false;
@@ -1097,6 +1487,10 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+	for (string const& script: compilerStack.unhandledSMTLib2Scripts())
+		output["auxiliaryInputRequested"]["smtlib2scripts"].append(script);
+	if (_inputsAndSettings.modelCheckerSettings.showStats)
+		output["modelCheckerStatistics"] = compilerStack.modelCheckerStatistics().toJson();
 
 	bool const wildcardMatchesExperimental = false;
 
@@ -1112,66 +1506,60 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			output["sources"][sourceName] = sourceResult;
 		}
 
-	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
-	{
-		size_t colon = contractName.rfind(':');
-		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
-
+	auto contractOutput = [&](string const& _file, string const& _name, string const& _contractName) {
 		// ABI, storage layout, documentation and metadata
 		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "abi", wildcardMatchesExperimental))
+			contractData["abi"] = compilerStack.contractABI(_contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "storageLayout", false))
+			contractData["storageLayout"] = compilerStack.storageLayout(_contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "metadata", wildcardMatchesExperimental))
+			contractData["metadata"] = compilerStack.metadata(_contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "userdoc", wildcardMatchesExperimental))
+			contractData["userdoc"] = compilerStack.natspecUser(_contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "devdoc", wildcardMatchesExperimental))
+			contractData["devdoc"] = compilerStack.natspecDev(_contractName);
 
 		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "ir", wildcardMatchesExperimental))
+			contractData["ir"] = compilerStack.yulIR(_contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "irOptimized", wildcardMatchesExperimental))
+			contractData["irOptimized"] = compilerStack.yulIROptimized(_contractName);
 
 		// Ewasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "ewasm.wast", wildcardMatchesExperimental))
+			contractData["ewasm"]["wast"] = compilerStack.ewasm(_contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "ewasm.wasm", wildcardMatchesExperimental))
+			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(_contractName).toHex();
 
 		// EVM
 		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.assembly", wildcardMatchesExperimental))
+			evmData["assembly"] = compilerStack.assemblyString(_contractName, sourceList);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.legacyAssembly", wildcardMatchesExperimental))
+			evmData["legacyAssembly"] = compilerStack.assemblyJSON(_contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(_contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, _file, _name, "evm.gasEstimates", wildcardMatchesExperimental))
+			evmData["gasEstimates"] = compilerStack.gasEstimates(_contractName);
 
 		if (compilationSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
-			file,
-			name,
+			_file,
+			_name,
 			evmObjectComponents("bytecode"),
 			wildcardMatchesExperimental
 		))
 			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
+				compilerStack.object(_contractName),
+				compilerStack.sourceMapping(_contractName),
+				compilerStack.sourceMappingEntries(_contractName),
+				compilerStack.generatedSources(_contractName),
 				false,
 				[&](string const& _element) { return isArtifactRequested(
 					_inputsAndSettings.outputSelection,
-					file,
-					name,
+					_file,
+					_name,
 					"evm.bytecode." + _element,
 					wildcardMatchesExperimental
 				); }
@@ -1179,20 +1567,21 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 		if (compilationSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
-			file,
-			name,
+			_file,
+			_name,
 			evmObjectComponents("deployedBytecode"),
 			wildcardMatchesExperimental
 		))
 			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
+				compilerStack.runtimeObject(_contractName),
+				compilerStack.runtimeSourceMapping(_contractName),
+				compilerStack.sourceMappingEntries(_contractName, true),
+				compilerStack.generatedSources(_contractName, true),
 				true,
 				[&](string const& _element) { return isArtifactRequested(
 					_inputsAndSettings.outputSelection,
-					file,
-					name,
+					_file,
+					_name,
 					"evm.deployedBytecode." + _element,
 					wildcardMatchesExperimental
 				); }
@@ -1201,15 +1590,96 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		if (!evmData.empty())
 			contractData["evm"] = evmData;
 
-		if (!contractData.empty())
+		return contractData;
+	};
+
+	// Group the contracts by source file, in the order in which they appear in the output.
+	map<string, map<string, string>> contractsByFile;
+	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
+	{
+		size_t colon = contractName.rfind(':');
+		solAssert(colon != string::npos, "");
+		contractsByFile[contractName.substr(0, colon)][contractName.substr(colon + 1)] = contractName;
+	}
+
+	// Compute the outputs the compiler stack stores for all contracts concurrently. They are
+	// then collected in the same order as without parallelism.
+	map<string, set<CompilerStack::ContractArtifact>> artifacts;
+	for (auto const& [file, contracts]: contractsByFile)
+		for (auto const& [name, contractName]: contracts)
+		{
+			auto requested = [&](auto const& _artifact, bool _wildcard) {
+				return isArtifactRequested(_inputsAndSettings.outputSelection, file, name, _artifact, _wildcard);
+			};
+			using Artifact = CompilerStack::ContractArtifact;
+			set<Artifact>& contractArtifacts = artifacts[contractName];
+			if (requested("abi", wildcardMatchesExperimental))
+				contractArtifacts.insert(Artifact::ABI);
+			if (requested("storageLayout", false))
+				contractArtifacts.insert(Artifact::StorageLayout);
+			if (requested("metadata", wildcardMatchesExperimental))
+				contractArtifacts.insert(Artifact::Metadata);
+			if (requested("userdoc", wildcardMatchesExperimental))
+				contractArtifacts.insert(Artifact::UserDocumentation);
+			if (requested("devdoc", wildcardMatchesExperimental))
+				contractArtifacts.insert(Artifact::DevDocumentation);
+			if (compilationSuccess && requested(evmObjectComponents("bytecode"), wildcardMatchesExperimental))
+				contractArtifacts.insert(Artifact::GeneratedSources);
+			if (compilationSuccess && requested(evmObjectComponents("deployedBytecode"), wildcardMatchesExperimental))
+				contractArtifacts.insert(Artifact::RuntimeGeneratedSources);
+		}
+	if (!artifacts.empty())
+		compilerStack.computeArtifacts(artifacts);
+
+	auto collectContracts = [&]() {
+		Json::Value contractsOutput = Json::objectValue;
+		for (auto const& [file, contracts]: contractsByFile)
+			for (auto const& [name, contractName]: contracts)
+			{
+				Json::Value contractData = contractOutput(file, name, contractName);
+				if (!contractData.empty())
+				{
+					if (!contractsOutput.isMember(file))
+						contractsOutput[file] = Json::objectValue;
+					contractsOutput[file][name] = std::move(contractData);
+				}
+			}
+		return contractsOutput;
+	};
+
+	if (_writer)
+		streamContracts(*_writer, output, contractsByFile, contractOutput);
+	else if (Json::Value contractsOutput = collectContracts(); !contractsOutput.empty())
+		output["contracts"] = std::move(contractsOutput);
+
+	// The targets reuse the analysis, but discard the code generated before, so they are
+	// compiled once the output of the previous compilation has been collected.
+	if (compilationSuccess && !_inputsAndSettings.targets.empty())
+	{
+		output["targets"] = Json::arrayValue;
+		for (CompilerStack::BackendSettings& target: _inputsAndSettings.targets)
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			Json::Value targetOutput = Json::objectValue;
+			Json::Value targetErrors = Json::arrayValue;
+			runCatchingExceptions([&]() {
+				compilerStack.setBackendSettings(std::move(target));
+				// Only the errors and warnings of the code generation are reported per target.
+				size_t const analysisErrorCount = compilerStack.errors().size();
+				compilerStack.compile();
+				appendErrors(
+					ErrorList(compilerStack.errors().begin() + static_cast<ptrdiff_t>(analysisErrorCount), compilerStack.errors().end()),
+					targetErrors
+				);
+			}, targetErrors);
+			compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+			if (targetErrors.size() > 0)
+				targetOutput["errors"] = std::move(targetErrors);
+			if (compilationSuccess)
+				if (Json::Value contractsOutput = collectContracts(); !contractsOutput.empty())
+					targetOutput["contracts"] = std::move(contractsOutput);
+			output["targets"].append(std::move(targetOutput));
 		}
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
 	return output;
 }
@@ -1233,6 +1703,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		AssemblyStack::Language::StrictAssembly,
 		_inputsAndSettings.optimiserSettings
 	);
+	stack.setParallelism(_inputsAndSettings.parallelism);
 	string const& sourceName = _inputsAndSettings.sources.begin()->first;
 	string const& sourceContents = _inputsAndSettings.sources.begin()->second;
 
@@ -1295,6 +1766,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 					collectEVMObject(
 						*o.bytecode,
 						o.sourceMappings.get(),
+						nullptr,
 						Json::arrayValue,
 						false,
 						[&](string const& _element) { return isArtifactRequested(
@@ -1317,21 +1789,46 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compile(_input, nullptr, nullptr);
+}
+
+Json::Value StandardCompiler::compile(
+	Json::Value const& _input,
+	StringMap* _sources,
+	util::CompactJsonObjectWriter* _writer
+) noexcept
 {
 	YulStringRepository::reset();
 
 	try
 	{
-		auto parsed = parseInput(_input);
+		auto parsed = parseInput(_input, _sources);
 		if (std::holds_alternative<Json::Value>(parsed))
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
+		bool const timing = settings.timing;
+
+		util::Profiler& profiler = util::Profiler::instance();
+		bool const profilerEnabled = profiler.enabled();
+		ScopeGuard restoreProfiler{[&]{ profiler.setEnabled(profilerEnabled); }};
+		if (timing)
+		{
+			profiler.reset();
+			profiler.setEnabled(true);
+		}
+
+		Json::Value output;
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			output = compileSolidity(std::move(settings), _writer);
 		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
+			output = compileYul(std::move(settings));
 		else
 			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+
+		if (timing)
+			output["timing"] = profiler.toJson();
+		return output;
 	}
 	catch (Json::LogicError const& _exception)
 	{
@@ -1352,29 +1849,60 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 }
 
 string StandardCompiler::compile(string const& _input) noexcept
+{
+	ostringstream output;
+	compile(_input, output);
+	return output.str();
+}
+
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
+{
+	compileToStream(_input, nullptr, _output);
+}
+
+void StandardCompiler::compile(string const& _input, StringMap _sources, ostream& _output) noexcept
+{
+	compileToStream(_input, &_sources, _output);
+}
+
+void StandardCompiler::compileToStream(string const& _input, StringMap* _sources, ostream& _output) noexcept
 {
 	Json::Value input;
 	string errors;
 	try
 	{
 		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonCompactPrint(formatFatalError("JSONError", errors));
+		{
+			_output << util::jsonCompactPrint(formatFatalError("JSONError", errors));
+			return;
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
 	}
 
+	util::CompactJsonObjectWriter writer(_output);
 	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
+	Json::Value output = compile(input, _sources, &writer);
 	// cout << "Output: " << output.toStyledString() << endl;
 
 	try
 	{
-		return util::jsonCompactPrint(output);
+		if (writer.empty())
+			_output << util::jsonCompactPrint(output);
+		else
+		{
+			// Only members following "contracts" are left.
+			for (string const& key: output.getMemberNames())
+				writer.writeMember(key, output[key]);
+			writer.close();
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		if (writer.empty())
+			_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
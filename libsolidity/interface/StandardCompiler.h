@@ -25,10 +25,16 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <iosfwd>
 #include <optional>
 #include <utility>
 #include <variant>
 
+namespace solidity::util
+{
+class CompactJsonObjectWriter;
+}
+
 namespace solidity::frontend
 {
 
@@ -53,6 +59,24 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above but writes the serialized output to @a _output. The output of each contract
+	/// is serialized as soon as it has been generated and then freed, so the complete output is
+	/// never held in memory. The result is identical to the one of the function above unless
+	/// generating the output of a contract fails. The error is then reported in ``errors`` while
+	/// the outputs of the contracts written before it are kept.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
+	/// Same as above, but with the contents of the sources given in @a _sources, keyed by their
+	/// names, instead of in the ``sources`` member of @a _input, which must not be present.
+	/// This avoids copying the sources into and out of a JSON value.
+	void compile(std::string const& _input, StringMap _sources, std::ostream& _output) noexcept;
+
+	/// Sets a callback that loads several imported files at once, see CompilerStack::setBatchReadCallback.
+	/// The read callback passed to the constructor is still used for everything else.
+	void setBatchReadCallback(ReadCallback::BatchCallback _readFiles) { m_readFiles = std::move(_readFiles); }
+
+	/// Sets the cache for the results of code generation that is used if the input does not
+	/// specify a cache directory. It can be shared between compilations.
+	void setCompilationCache(std::shared_ptr<CompilationCache const> _cache) { m_compilationCache = std::move(_cache); }
 
 private:
 	struct InputsAndSettings
@@ -66,6 +90,7 @@ private:
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		RevertStrings revertStrings = RevertStrings::Default;
+		bool timing = false;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
 		std::map<std::string, util::h160> libraries;
 		bool metadataLiteralSources = false;
@@ -73,16 +98,30 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		/// Further backend settings to compile the analysed sources with.
+		std::vector<CompilerStack::BackendSettings> targets;
+		size_t parallelism = 1;
+		bool lazyAnalysis = false;
+		bool deferredParsing = false;
+		bool lowMemory = false;
+		std::optional<std::string> cacheDirectory;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
-	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
+	/// If @a _sources is given, it is used instead of the ``sources`` member of @a _input.
+	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input, StringMap* _sources);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs the compilation. If @a _writer is given, the top-level members up to and including
+	/// ``contracts`` may be written to it instead of being included in the returned value.
+	Json::Value compile(Json::Value const& _input, StringMap* _sources, util::CompactJsonObjectWriter* _writer) noexcept;
+	void compileToStream(std::string const& _input, StringMap* _sources, std::ostream& _output) noexcept;
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, util::CompactJsonObjectWriter* _writer = nullptr);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	ReadCallback::BatchCallback m_readFiles;
+	std::shared_ptr<CompilationCache const> m_compilationCache;
 };
 
 }
@@ -66,7 +66,7 @@ public:
 		solAssert(m_location.source, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.createNode<NodeType>(m_location, std::forward<Args>(_args)...);
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -83,6 +83,7 @@ ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 	{
 		m_recursionDepth = 0;
 		m_scanner = _scanner;
+		m_arena = make_shared<util::Arena>();
 		ASTNodeFactory nodeFactory(*this);
 
 		vector<ASTPointer<ASTNode>> nodes;
@@ -136,6 +137,71 @@ ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 	}
 }
 
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	for (ASTPointer<ASTNode> const& node: m_recordedNodes)
+		node->m_id = static_cast<size_t>(node->id() + _offset);
+	m_recordedNodes.clear();
+	m_recordNodes = false;
+}
+
+vector<ASTPointer<Block>> Parser::takeDeferredBodies()
+{
+	vector<ASTPointer<Block>> bodies;
+	swap(bodies, m_deferredBodies);
+	return bodies;
+}
+
+bool Parser::parseDeferredBody(shared_ptr<Scanner> const& _scanner, Block& _body, bool _modifier)
+{
+	solAssert(_body.deferred(), "");
+	solAssert(!m_insideModifier, "");
+	ScopeGuard resetModifierFlag([this]() { m_insideModifier = false; });
+	m_insideModifier = _modifier;
+	try
+	{
+		m_recursionDepth = 0;
+		m_scanner = _scanner;
+		m_scanner->setPosition(static_cast<size_t>(_body.location().start));
+		// The nodes are released together with the source unit, so they cannot share an arena
+		// with the nodes of other bodies.
+		m_arena = make_shared<util::Arena>();
+		ASTPointer<Block> block = parseBlock();
+		solAssert(block->location() == _body.location(), "");
+		_body.m_statements = block->statements();
+		_body.m_deferred = false;
+		return true;
+	}
+	catch (FatalError const&)
+	{
+		if (m_errorReporter.errors().empty())
+			throw; // Something is weird here, rather throw again.
+		return false;
+	}
+}
+
+ASTPointer<Block> Parser::skipBlock()
+{
+	ASTNodeFactory nodeFactory(*this);
+	expectToken(Token::LBrace, false);
+	for (size_t depth = 1; depth > 0;)
+	{
+		m_scanner->next();
+		if (m_scanner->currentToken() == Token::LBrace)
+			++depth;
+		else if (m_scanner->currentToken() == Token::RBrace)
+			--depth;
+		else if (m_scanner->currentToken() == Token::EOS)
+			expectToken(Token::RBrace);
+	}
+	nodeFactory.markEndPosition();
+	m_scanner->next();
+	ASTPointer<Block> block = nodeFactory.createNode<Block>(nullptr, false, vector<ASTPointer<Statement>>{});
+	block->m_deferred = true;
+	m_deferredBodies.push_back(block);
+	return block;
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, vector<Token> const& _tokens, vector<string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -616,7 +682,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinition(bool _freeFunction)
 		m_scanner->next();
 	else
 	{
-		block = parseBlock();
+		block = m_deferFunctionBodies ? skipBlock() : parseBlock();
 		nodeFactory.setEndPositionFromNode(block);
 	}
 	return nodeFactory.createNode<FunctionDefinition>(
@@ -869,7 +935,7 @@ ASTPointer<ModifierDefinition> Parser::parseModifierDefinition()
 	nodeFactory.markEndPosition();
 	if (m_scanner->currentToken() != Token::Semicolon)
 	{
-		block = parseBlock();
+		block = m_deferFunctionBodies ? skipBlock() : parseBlock();
 		nodeFactory.setEndPositionFromNode(block);
 	}
 	else
@@ -1247,7 +1313,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = block->location.end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	return createNode<InlineAssembly>(location, _docString, dialect, block);
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -2191,7 +2257,10 @@ ASTPointer<ASTString> Parser::expectIdentifierToken()
 
 ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = make_shared<ASTString>(m_scanner->currentLiteral());
+	ASTPointer<ASTString> identifier = allocate_shared<ASTString>(
+		util::ArenaAllocator<ASTString>(m_arena),
+		m_scanner->currentLiteral()
+	);
 	m_scanner->next();
 	return identifier;
 }
@@ -27,6 +27,8 @@
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/Arena.h>
+
 namespace solidity::langutil
 {
 class Scanner;
@@ -49,6 +51,32 @@ public:
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
+	/// Makes sure all nodes created from now on have IDs larger than @a _id, so that they
+	/// do not clash with the IDs of source units parsed by a different parser.
+	void continueNodeIDsAfter(int64_t _id) { m_currentNodeID = std::max(m_currentNodeID, _id); }
+
+	/// @returns the largest node ID assigned so far.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+	/// Makes the parser keep track of the nodes created from now on, which is required by
+	/// shiftNodeIDs().
+	void enableNodeIDShifting() { m_recordNodes = true; }
+	/// Adds @a _offset to the IDs of all nodes created since enableNodeIDShifting() was called and
+	/// stops keeping track of them. This allows numbering source units that were parsed
+	/// concurrently by separate parsers as if they had been parsed in sequence by a single one.
+	void shiftNodeIDs(int64_t _offset);
+
+	/// Sets whether the bodies of functions and modifiers are skipped by only matching their
+	/// braces. Skipped bodies are represented by empty blocks marked as deferred, which can be
+	/// parsed later using parseDeferredBody().
+	void setDeferFunctionBodies(bool _defer) { m_deferFunctionBodies = _defer; }
+	/// @returns the bodies skipped since the last call.
+	std::vector<ASTPointer<Block>> takeDeferredBodies();
+	/// Parses the statements of the deferred body @a _body, which has to be a block skipped
+	/// while parsing the source of @a _scanner. @a _modifier has to be true for the bodies of
+	/// modifiers, which can contain placeholder statements.
+	/// @returns false if a fatal error occurred, in which case the block stays empty.
+	bool parseDeferredBody(std::shared_ptr<langutil::Scanner> const& _scanner, Block& _body, bool _modifier);
+
 private:
 	class ASTNodeFactory;
 
@@ -183,6 +211,21 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Creates a node with the next ID and its annotation in the arena of the current source unit
+	/// and keeps track of it if enableNodeIDShifting() was called.
+	template <class NodeType, typename... Args>
+	ASTPointer<NodeType> createNode(langutil::SourceLocation const& _location, Args&&... _args)
+	{
+		ASTPointer<NodeType> node = std::allocate_shared<AnnotatedNode<NodeType>>(
+			util::ArenaAllocator<AnnotatedNode<NodeType>>(m_arena),
+			nextID(),
+			_location,
+			std::forward<Args>(_args)...
+		);
+		if (m_recordNodes)
+			m_recordedNodes.emplace_back(node);
+		return node;
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -206,11 +249,21 @@ private:
 	/// Creates an empty ParameterList at the current location (used if parameters can be omitted).
 	ASTPointer<ParameterList> createEmptyParameterList();
 
+	/// Skips a block by matching braces and @returns an empty deferred block for it.
+	ASTPointer<Block> skipBlock();
+
 	/// Flag that signifies whether '_' is parsed as a PlaceholderStatement or a regular identifier.
 	bool m_insideModifier = false;
+	bool m_deferFunctionBodies = false;
+	std::vector<ASTPointer<Block>> m_deferredBodies;
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	bool m_recordNodes = false;
+	std::vector<ASTPointer<ASTNode>> m_recordedNodes;
+	/// Memory for the nodes of the source unit being parsed. It is kept alive by the nodes
+	/// and released together with the last of them.
+	std::shared_ptr<util::Arena> m_arena;
 };
 
 }
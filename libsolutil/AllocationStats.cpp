@@ -0,0 +1,152 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/AllocationStats.h>
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(SOLC_ALLOCATION_STATS)
+#include <cstdlib>
+#include <new>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+// The counters are trivially constructible, so that they are initialised before the first
+// allocation of the process and of each thread.
+thread_local size_t t_allocations = 0;
+thread_local size_t t_allocatedBytes = 0;
+thread_local size_t t_peakLiveBytes = 0;
+atomic<size_t> s_liveBytes{0};
+
+}
+
+#if defined(SOLC_ALLOCATION_STATS)
+
+namespace
+{
+
+size_t usableSize(void* _pointer)
+{
+#if defined(__APPLE__)
+	return malloc_size(_pointer);
+#elif defined(_WIN32)
+	return _msize(_pointer);
+#else
+	return malloc_usable_size(_pointer);
+#endif
+}
+
+void* countedAllocate(size_t _size) noexcept
+{
+	void* pointer = malloc(_size == 0 ? 1 : _size);
+	if (pointer)
+	{
+		size_t size = usableSize(pointer);
+		++t_allocations;
+		t_allocatedBytes += size;
+		t_peakLiveBytes = max(t_peakLiveBytes, s_liveBytes.fetch_add(size, memory_order_relaxed) + size);
+	}
+	return pointer;
+}
+
+void countedFree(void* _pointer) noexcept
+{
+	if (!_pointer)
+		return;
+	s_liveBytes.fetch_sub(usableSize(_pointer), memory_order_relaxed);
+	free(_pointer);
+}
+
+void* countedAllocateOrThrow(size_t _size)
+{
+	while (true)
+	{
+		if (void* pointer = countedAllocate(_size))
+			return pointer;
+		new_handler handler = get_new_handler();
+		if (!handler)
+			throw bad_alloc();
+		handler();
+	}
+}
+
+}
+
+// Over-aligned allocations use the default operators and are not counted.
+void* operator new(size_t _size) { return countedAllocateOrThrow(_size); }
+void* operator new[](size_t _size) { return countedAllocateOrThrow(_size); }
+void* operator new(size_t _size, nothrow_t const&) noexcept { return countedAllocate(_size); }
+void* operator new[](size_t _size, nothrow_t const&) noexcept { return countedAllocate(_size); }
+void operator delete(void* _pointer) noexcept { countedFree(_pointer); }
+void operator delete[](void* _pointer) noexcept { countedFree(_pointer); }
+void operator delete(void* _pointer, size_t) noexcept { countedFree(_pointer); }
+void operator delete[](void* _pointer, size_t) noexcept { countedFree(_pointer); }
+void operator delete(void* _pointer, nothrow_t const&) noexcept { countedFree(_pointer); }
+void operator delete[](void* _pointer, nothrow_t const&) noexcept { countedFree(_pointer); }
+
+#endif
+
+bool AllocationStats::available()
+{
+#if defined(SOLC_ALLOCATION_STATS)
+	return true;
+#else
+	return false;
+#endif
+}
+
+size_t AllocationStats::threadAllocations()
+{
+	return t_allocations;
+}
+
+size_t AllocationStats::threadAllocatedBytes()
+{
+	return t_allocatedBytes;
+}
+
+size_t AllocationStats::liveBytes()
+{
+	return s_liveBytes.load(memory_order_relaxed);
+}
+
+size_t AllocationStats::beginPeak()
+{
+	size_t enclosingPeak = t_peakLiveBytes;
+	t_peakLiveBytes = liveBytes();
+	return enclosingPeak;
+}
+
+size_t AllocationStats::endPeak(size_t _enclosingPeak)
+{
+	size_t peak = t_peakLiveBytes;
+	t_peakLiveBytes = max(_enclosingPeak, peak);
+	return peak;
+}
@@ -0,0 +1,61 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Counters of the heap allocations made through the global operator new.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace solidity::util
+{
+
+/**
+ * Counters of the heap allocations made through the global operator new, which is only
+ * replaced by a counting version if the compiler is built with SOLC_ALLOCATION_STATS.
+ * Otherwise all counters are zero.
+ *
+ * The number and size of the allocations are counted per thread, while the live bytes are
+ * counted for the whole process. Sizes are the usable sizes of the allocated blocks, which
+ * may be larger than the requested sizes.
+ */
+class AllocationStats
+{
+public:
+	/// @returns true if the global operator new is instrumented.
+	static bool available();
+
+	/// @returns the number of allocations made by the current thread so far.
+	static size_t threadAllocations();
+	/// @returns the number of bytes allocated by the current thread so far.
+	static size_t threadAllocatedBytes();
+	/// @returns the number of bytes currently allocated by the process.
+	static size_t liveBytes();
+
+	/// Starts measuring the peak of the live bytes of the process seen by the allocations of
+	/// the current thread, for example for a nested phase.
+	/// @returns the peak of the enclosing measurement, to be passed to @a endPeak.
+	static size_t beginPeak();
+	/// Ends the measurement started by the matching call of @a beginPeak, which returned
+	/// @a _enclosingPeak, and resumes the enclosing one.
+	/// @returns the peak of the live bytes during the measurement.
+	static size_t endPeak(size_t _enclosingPeak);
+};
+
+}
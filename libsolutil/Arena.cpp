@@ -0,0 +1,41 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Arena.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+void* Arena::allocateChunk(size_t _size)
+{
+	// Large requests get a chunk of their own, so that the rest of the current chunk can still be used.
+	bool const separate = _size > m_chunkSize / 4;
+	size_t const chunkSize = separate ? _size : m_chunkSize;
+	// Memory returned by new is suitably aligned for any fundamental type and is left uninitialised.
+	unique_ptr<byte[]> chunk(new byte[chunkSize]);
+	byte* result = chunk.get();
+	m_chunks.emplace_back(move(chunk));
+	m_allocatedBytes += chunkSize;
+	if (!separate)
+	{
+		m_next = result + _size;
+		m_remaining = chunkSize - _size;
+	}
+	return result;
+}
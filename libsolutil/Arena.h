@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Monotonic memory arena and an allocator using it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Memory arena that hands out memory from large chunks and only releases it all at once
+ * when it is destroyed. Allocation is not thread-safe.
+ */
+class Arena
+{
+public:
+	explicit Arena(size_t _chunkSize = 64 * 1024): m_chunkSize(_chunkSize) {}
+
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+
+	/// @returns uninitialised memory of @a _size bytes aligned to @a _alignment, which has to be
+	/// a power of two not larger than alignof(std::max_align_t).
+	void* allocate(size_t _size, size_t _alignment)
+	{
+		size_t const padding = (_alignment - reinterpret_cast<uintptr_t>(m_next) % _alignment) % _alignment;
+		if (padding + _size > m_remaining)
+			return allocateChunk(_size);
+		void* result = m_next + padding;
+		m_next += padding + _size;
+		m_remaining -= padding + _size;
+		return result;
+	}
+
+	/// @returns the total size of the chunks allocated so far.
+	size_t allocatedBytes() const { return m_allocatedBytes; }
+
+private:
+	void* allocateChunk(size_t _size);
+
+	size_t m_chunkSize;
+	std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+	std::byte* m_next = nullptr;
+	size_t m_remaining = 0;
+	size_t m_allocatedBytes = 0;
+};
+
+/**
+ * Allocator that takes its memory from an Arena and never frees it. Every copy of the
+ * allocator keeps the arena alive, so it can be used with std::allocate_shared: the memory
+ * is released once the last object allocated from the arena is gone.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <typename U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(_count * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) {}
+
+	std::shared_ptr<Arena> const& arena() const { return m_arena; }
+
+	template <typename U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <typename U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return !(*this == _other); }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+};
+
+}
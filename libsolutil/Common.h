@@ -65,6 +65,7 @@ using bytesConstRef = util::vector_ref<uint8_t const>;
 using bigint = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<>>;
 using u256 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<256, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
 using s256 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<256, 256, boost::multiprecision::signed_magnitude, boost::multiprecision::unchecked, void>>;
+using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 512, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
 using u160 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<160, 160, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
 
 // Map types.
@@ -76,9 +77,8 @@ using strings = std::vector<std::string>;
 /// Interprets @a _u as a two's complement signed number and returns the resulting s256.
 inline s256 u2s(u256 _u)
 {
-	static bigint const c_end = bigint(1) << 256;
 	if (boost::multiprecision::bit_test(_u, 255))
-		return s256(-(c_end - _u));
+		return -s256(~_u + 1);
 	else
 		return s256(_u);
 }
@@ -86,11 +86,10 @@ inline s256 u2s(u256 _u)
 /// @returns the two's complement signed representation of the signed number _u.
 inline u256 s2u(s256 _u)
 {
-	static bigint const c_end = bigint(1) << 256;
 	if (_u >= 0)
 		return u256(_u);
 	else
-		return u256(c_end + _u);
+		return ~u256(-_u) + 1;
 }
 
 inline u256 exp256(u256 _base, u256 _exponent)
@@ -107,6 +106,28 @@ inline u256 exp256(u256 _base, u256 _exponent)
 	return result;
 }
 
+/// @returns (_a + _b) % _modulus without truncating the sum to 256 bits,
+/// or zero if _modulus is zero (like the ADDMOD instruction).
+inline u256 addmod256(u256 const& _a, u256 const& _b, u256 const& _modulus)
+{
+	if (_modulus == 0)
+		return 0;
+	u256 a = _a % _modulus;
+	u256 b = _b % _modulus;
+	// a + b < 2 * _modulus, so at most one subtraction is needed, which is done before
+	// the addition to avoid an overflow.
+	return a >= _modulus - b ? a - (_modulus - b) : a + b;
+}
+
+/// @returns (_a * _b) % _modulus without truncating the product to 256 bits,
+/// or zero if _modulus is zero (like the MULMOD instruction).
+inline u256 mulmod256(u256 const& _a, u256 const& _b, u256 const& _modulus)
+{
+	if (_modulus == 0)
+		return 0;
+	return u256((u512(_a) * u512(_b)) % u512(_modulus));
+}
+
 /// Checks whether _mantissa * (X ** _exp) fits into 4096 bits,
 /// where X is given indirectly via _log2OfBase = log2(X).
 bool fitsPrecisionBaseX(bigint const& _mantissa, double _log2OfBase, uint32_t _exp);
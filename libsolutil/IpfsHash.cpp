@@ -46,9 +46,68 @@ bytes encodeByteArray(bytes const& _data)
 	return bytes{0x0a} + varintEncoding(_data.size()) + _data;
 }
 
+/// Streaming SHA-256 that passes all full blocks of the input directly to the
+/// compression function of picosha2 and only buffers a partial block.
+class SHA256
+{
+public:
+	SHA256()
+	{
+		copy(begin(picosha2::detail::initial_message_digest), end(picosha2::detail::initial_message_digest), m_state);
+	}
+
+	SHA256& operator<<(bytesConstRef _data)
+	{
+		uint8_t const* data = _data.data();
+		size_t size = _data.size();
+		m_length += size;
+		if (m_bufferSize > 0)
+		{
+			size_t count = min(size, 64 - m_bufferSize);
+			copy(data, data + count, m_buffer + m_bufferSize);
+			m_bufferSize += count;
+			data += count;
+			size -= count;
+			if (m_bufferSize < 64)
+				return *this;
+			picosha2::detail::hash256_block(m_state, m_buffer, m_buffer + 64);
+			m_bufferSize = 0;
+		}
+		for (; size >= 64; data += 64, size -= 64)
+			picosha2::detail::hash256_block(m_state, data, data + 64);
+		copy(data, data + size, m_buffer);
+		m_bufferSize = size;
+		return *this;
+	}
+	SHA256& operator<<(bytes const& _data) { return *this << bytesConstRef(&_data); }
+
+	bytes digest()
+	{
+		uint64_t bitLength = uint64_t(m_length) * 8;
+		uint8_t padding[72] = {0x80};
+		size_t paddingSize = (m_bufferSize < 56 ? 56 : 120) - m_bufferSize;
+		for (size_t i = 0; i < 8; ++i)
+			padding[paddingSize + i] = uint8_t(bitLength >> (56 - 8 * i));
+		*this << bytesConstRef(padding, paddingSize + 8);
+		assertThrow(m_bufferSize == 0, Exception, "");
+
+		bytes result;
+		for (picosha2::word_t word: m_state)
+			for (size_t i = 0; i < 4; ++i)
+				result.emplace_back(uint8_t(word >> (24 - 8 * i)));
+		return result;
+	}
+
+private:
+	picosha2::word_t m_state[8];
+	uint8_t m_buffer[64];
+	size_t m_bufferSize = 0;
+	size_t m_length = 0;
+};
+
 bytes encodeHash(bytes const& _data)
 {
-	return bytes{0x12, 0x20} + picosha2::hash256(_data);
+	return bytes{0x12, 0x20} + (SHA256() << _data).digest();
 }
 
 bytes encodeLinkData(bytes const& _data)
@@ -153,7 +212,7 @@ bytes groupChunksBottomUp(Chunks _currentLevel)
 }
 }
 
-bytes solidity::util::ipfsHash(string _data)
+bytes solidity::util::ipfsHash(string const& _data)
 {
 	size_t const maxChunkSize = 1024 * 256;
 	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
@@ -163,41 +222,39 @@ bytes solidity::util::ipfsHash(string _data)
 
 	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
+		bytesConstRef chunkBytes = bytesConstRef(_data).cropped(
+			chunkIndex * maxChunkSize,
+			min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize)
 		);
 
 		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
 
-		bytes protobufEncodedData;
 		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
+		bytes protobufPrefix{0x08, 0x02};
 		if (!chunkBytes.empty())
-		{
 			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
-		}
+			protobufPrefix += bytes{0x12} + lengthAsVarint;
 		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
+		bytes protobufSuffix = bytes{0x18} + lengthAsVarint;
+		size_t protobufSize = protobufPrefix.size() + chunkBytes.size() + protobufSuffix.size();
 
 		// PBDag:
 		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
+		// The chunk is hashed in place instead of building the block data.
+		bytes blockPrefix = bytes{0x0a} + varintEncoding(protobufSize);
 
 		// Multihash: sha2-256, 256 bits
 		allChunks.emplace_back(
-			encodeHash(blockData),
+			bytes{0x12, 0x20} + (SHA256() << blockPrefix << protobufPrefix << chunkBytes << protobufSuffix).digest(),
 			chunkBytes.size(),
-			blockData.size()
+			blockPrefix.size() + protobufSize
 		);
 	}
 
 	return groupChunksBottomUp(std::move(allChunks));
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(string const& _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
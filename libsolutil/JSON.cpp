@@ -26,9 +26,14 @@
 
 #include <boost/algorithm/string/replace.hpp>
 
+#include <cstring>
 #include <sstream>
 #include <map>
 #include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <variant>
+#include <vector>
 
 using namespace std;
 
@@ -105,6 +110,263 @@ void removeNullMembersHelper(Json::Value& _json)
 		}
 }
 
+/// Format of jsonBinaryPrint(): the header followed by the number of strings, the strings
+/// (each as its length followed by its bytes) and the root value. Each value starts with
+/// a BinaryJsonTag. Integers and lengths are LEB128-encoded, signed integers are zigzag-encoded
+/// first, reals are stored as the eight bytes of their IEEE 754 representation.
+/// Strings and object keys are stored as indices into the string table.
+string const binaryJsonHeader{"SJB\x01", 4};
+
+enum class BinaryJsonTag: uint8_t
+{
+	Null,
+	False,
+	True,
+	Int,
+	UInt,
+	Real,
+	String,
+	Array,
+	Object
+};
+
+class BinaryJsonWriter
+{
+public:
+	string write(Json::Value const& _input)
+	{
+		collectStrings(_input);
+		m_output = binaryJsonHeader;
+		writeNumber(m_strings.size());
+		for (string const* str: m_strings)
+		{
+			writeNumber(str->size());
+			m_output += *str;
+		}
+		writeValue(_input);
+		return std::move(m_output);
+	}
+
+private:
+	void collectStrings(Json::Value const& _value)
+	{
+		if (_value.isString())
+			addString(_value.asString());
+		else if (_value.isObject())
+			for (auto it = _value.begin(); it != _value.end(); ++it)
+			{
+				addString(it.name());
+				collectStrings(*it);
+			}
+		else if (_value.isArray())
+			for (Json::Value const& element: _value)
+				collectStrings(element);
+	}
+
+	void addString(string const& _string)
+	{
+		auto [it, inserted] = m_stringIndices.emplace(_string, m_strings.size());
+		if (inserted)
+			m_strings.emplace_back(&it->first);
+	}
+
+	void writeValue(Json::Value const& _value)
+	{
+		switch (_value.type())
+		{
+		case Json::nullValue:
+			writeTag(BinaryJsonTag::Null);
+			break;
+		case Json::booleanValue:
+			writeTag(_value.asBool() ? BinaryJsonTag::True : BinaryJsonTag::False);
+			break;
+		case Json::intValue:
+		{
+			writeTag(BinaryJsonTag::Int);
+			int64_t value = _value.asInt64();
+			writeNumber((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+			break;
+		}
+		case Json::uintValue:
+			writeTag(BinaryJsonTag::UInt);
+			writeNumber(_value.asUInt64());
+			break;
+		case Json::realValue:
+		{
+			writeTag(BinaryJsonTag::Real);
+			double value = _value.asDouble();
+			uint64_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			for (size_t i = 0; i < sizeof(bits); ++i)
+				m_output += static_cast<char>((bits >> (8 * i)) & 0xff);
+			break;
+		}
+		case Json::stringValue:
+			writeTag(BinaryJsonTag::String);
+			writeNumber(m_stringIndices.at(_value.asString()));
+			break;
+		case Json::arrayValue:
+			writeTag(BinaryJsonTag::Array);
+			writeNumber(_value.size());
+			for (Json::Value const& element: _value)
+				writeValue(element);
+			break;
+		case Json::objectValue:
+			writeTag(BinaryJsonTag::Object);
+			writeNumber(_value.size());
+			for (auto it = _value.begin(); it != _value.end(); ++it)
+			{
+				writeNumber(m_stringIndices.at(it.name()));
+				writeValue(*it);
+			}
+			break;
+		}
+	}
+
+	void writeTag(BinaryJsonTag _tag) { m_output += static_cast<char>(_tag); }
+
+	void writeNumber(uint64_t _number)
+	{
+		while (_number > 0x7f)
+		{
+			m_output += static_cast<char>(0x80 | (_number & 0x7f));
+			_number >>= 7;
+		}
+		m_output += static_cast<char>(_number);
+	}
+
+	unordered_map<string, uint64_t> m_stringIndices;
+	vector<string const*> m_strings;
+	string m_output;
+};
+
+class BinaryJsonReader
+{
+public:
+	explicit BinaryJsonReader(string const& _input): m_input(_input) {}
+
+	/// @returns the decoded value or an error message.
+	variant<Json::Value, string> read()
+	{
+		try
+		{
+			if (m_input.compare(0, binaryJsonHeader.size(), binaryJsonHeader) != 0)
+				return string("Invalid header.");
+			m_position = binaryJsonHeader.size();
+			uint64_t stringCount = readNumber();
+			// Each string needs at least one byte.
+			if (stringCount > m_input.size() - m_position)
+				return string("Invalid number of strings.");
+			m_strings.reserve(static_cast<size_t>(stringCount));
+			for (uint64_t i = 0; i < stringCount; ++i)
+			{
+				uint64_t length = readNumber();
+				if (length > m_input.size() - m_position)
+					return string("Unexpected end of input.");
+				m_strings.emplace_back(m_input.substr(m_position, static_cast<size_t>(length)));
+				m_position += static_cast<size_t>(length);
+			}
+			Json::Value value = readValue();
+			if (m_position != m_input.size())
+				return string("Trailing data after the value.");
+			return value;
+		}
+		catch (InvalidInput const& _error)
+		{
+			return string(_error.what());
+		}
+	}
+
+private:
+	struct InvalidInput: runtime_error
+	{
+		using runtime_error::runtime_error;
+	};
+
+	Json::Value readValue()
+	{
+		switch (static_cast<BinaryJsonTag>(readByte()))
+		{
+		case BinaryJsonTag::Null:
+			return Json::nullValue;
+		case BinaryJsonTag::False:
+			return false;
+		case BinaryJsonTag::True:
+			return true;
+		case BinaryJsonTag::Int:
+		{
+			uint64_t number = readNumber();
+			return Json::Value(static_cast<Json::Int64>((number >> 1) ^ (~(number & 1) + 1)));
+		}
+		case BinaryJsonTag::UInt:
+			return Json::Value(static_cast<Json::UInt64>(readNumber()));
+		case BinaryJsonTag::Real:
+		{
+			uint64_t bits = 0;
+			for (size_t i = 0; i < sizeof(bits); ++i)
+				bits |= uint64_t(readByte()) << (8 * i);
+			double value;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+		case BinaryJsonTag::String:
+			return Json::Value(readString());
+		case BinaryJsonTag::Array:
+		{
+			Json::Value array(Json::arrayValue);
+			uint64_t size = readNumber();
+			for (uint64_t i = 0; i < size; ++i)
+				array.append(readValue());
+			return array;
+		}
+		case BinaryJsonTag::Object:
+		{
+			Json::Value object(Json::objectValue);
+			uint64_t size = readNumber();
+			for (uint64_t i = 0; i < size; ++i)
+			{
+				string const& key = readString();
+				object[key] = readValue();
+			}
+			return object;
+		}
+		}
+		throw InvalidInput("Invalid value tag.");
+	}
+
+	string const& readString()
+	{
+		uint64_t index = readNumber();
+		if (index >= m_strings.size())
+			throw InvalidInput("Invalid string index.");
+		return m_strings[static_cast<size_t>(index)];
+	}
+
+	uint8_t readByte()
+	{
+		if (m_position >= m_input.size())
+			throw InvalidInput("Unexpected end of input.");
+		return static_cast<uint8_t>(m_input[m_position++]);
+	}
+
+	uint64_t readNumber()
+	{
+		uint64_t number = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7)
+		{
+			uint8_t byte = readByte();
+			number |= uint64_t(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return number;
+		}
+		throw InvalidInput("Invalid number encoding.");
+	}
+
+	string const& m_input;
+	size_t m_position = 0;
+	vector<string> m_strings;
+};
+
 } // end anonymous namespace
 
 Json::Value removeNullMembers(Json::Value _json)
@@ -129,10 +391,51 @@ string jsonCompactPrint(Json::Value const& _input)
 	return print(_input, writerBuilder);
 }
 
+void CompactJsonObjectWriter::writeMember(string const& _key, Json::Value const& _value)
+{
+	writeKey(_key);
+	m_out << jsonCompactPrint(_value);
+}
+
+CompactJsonObjectWriter CompactJsonObjectWriter::writeObjectMember(string const& _key)
+{
+	writeKey(_key);
+	return CompactJsonObjectWriter(m_out);
+}
+
+void CompactJsonObjectWriter::writeKey(string const& _key)
+{
+	m_out << (m_empty ? "{" : ",") << jsonCompactPrint(Json::Value(_key)) << ":";
+	m_empty = false;
+}
+
+void CompactJsonObjectWriter::close()
+{
+	m_out << (m_empty ? "{}" : "}");
+}
+
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
 {
 	static StrictModeCharReaderBuilder readerBuilder;
 	return parse(readerBuilder, _input, _json, _errs);
 }
 
+string jsonBinaryPrint(Json::Value const& _input)
+{
+	return BinaryJsonWriter{}.write(_input);
+}
+
+bool jsonParseBinary(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
+{
+	auto result = BinaryJsonReader{_input}.read();
+	if (string const* error = get_if<string>(&result))
+	{
+		if (_errs)
+			*_errs = *error;
+		return false;
+	}
+	_json = std::move(get<Json::Value>(result));
+	return true;
+}
+
 } // namespace solidity::util
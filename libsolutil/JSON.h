@@ -25,6 +25,7 @@
 
 #include <json/json.h>
 
+#include <ostream>
 #include <string>
 
 namespace solidity::util {
@@ -38,6 +39,35 @@ std::string jsonPrettyPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) without indentation
 std::string jsonCompactPrint(Json::Value const& _input);
 
+/**
+ * Writes a JSON object to a stream one member at a time, in the same format as jsonCompactPrint().
+ * This allows serialising large objects without building them in memory first.
+ *
+ * Members must be written in ascending order of their keys, which is the order used by jsoncpp,
+ * so that the result is identical to serialising the complete object.
+ */
+class CompactJsonObjectWriter
+{
+public:
+	explicit CompactJsonObjectWriter(std::ostream& _out): m_out(_out) {}
+
+	void writeMember(std::string const& _key, Json::Value const& _value);
+	/// Writes the key of a member whose value is an object and @returns a writer for that object.
+	/// The nested writer has to be closed before further members are written to this one.
+	CompactJsonObjectWriter writeObjectMember(std::string const& _key);
+	/// Ends the object. No members may be written afterwards.
+	void close();
+
+	/// @returns true if nothing has been written yet.
+	bool empty() const { return m_empty; }
+
+private:
+	void writeKey(std::string const& _key);
+
+	std::ostream& m_out;
+	bool m_empty = true;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
@@ -45,4 +75,17 @@ std::string jsonCompactPrint(Json::Value const& _input);
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseStrict(std::string const& _input, Json::Value& _json, std::string* _errs = nullptr);
 
+/// Serialise the JSON value (@a _input) in a compact binary format.
+/// All keys and strings are stored once in a string table and referenced by index, integers
+/// are LEB128-encoded. Decoding the result with jsonParseBinary() yields a value that is
+/// identical to @a _input, including the distinction between signed and unsigned integers.
+std::string jsonBinaryPrint(Json::Value const& _input);
+
+/// Parse a JSON value (@a _input) serialised by jsonBinaryPrint() and writes it to (@a _json)
+/// \param _input binary input string
+/// \param _json [out] resulting JSON value
+/// \param _errs [out] error message
+/// \return \c true if the input was successfully parsed, \c false if it is malformed.
+bool jsonParseBinary(std::string const& _input, Json::Value& _json, std::string* _errs = nullptr);
+
 }
@@ -23,9 +23,8 @@
 #include <libsolutil/Keccak256.h>
 
 #include <cstdint>
-#include <cstdio>
-#include <cstdlib>
 #include <cstring>
+#include <map>
 
 using namespace std;
 
@@ -35,153 +34,229 @@ namespace solidity::util
 namespace
 {
 
-/** libkeccak-tiny
- *
- * A single-file implementation of SHA-3 and SHAKE.
+/*
+ * The Keccak-f[1600] permutation and the sponge construction, originally based on
+ * libkeccak-tiny by David Leon Gil (CC0).
  *
- * Implementor: David Leon Gil
- * License: CC0, attribution kindly requested. Blame taken too,
- * but not liability.
+ * The permutation operates on @a Lanes independent states at once: every operation on a
+ * 64 bit word is applied to all states in a loop. With Lanes > 1 these loops are plain
+ * data-parallel code that the compiler vectorises for the target architecture, with
+ * Lanes == 1 they disappear.
  */
 
-/******** The Keccak-f[1600] permutation ********/
-
-/*** Constants. ***/
-static uint8_t const rho[24] = \
-	{ 1,  3,   6, 10, 15, 21,
-	28, 36, 45, 55,  2, 14,
-	27, 41, 56,  8, 25, 43,
-	62, 18, 39, 61, 20, 44};
-static uint8_t const pi[24] = \
-	{10,  7, 11, 17, 18, 3,
-	5, 16,  8, 21, 24, 4,
-	15, 23, 19, 13, 12, 2,
-	20, 14, 22,  9, 6,  1};
-static uint64_t const RC[24] = \
-	{1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+size_t constexpr rate = 200 - (256 / 4);
+size_t constexpr batchLanes = 4;
+
+uint64_t constexpr RC[24] = {
+	1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
 	0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
 	0x8aULL, 0x88ULL, 0x80008009ULL, 0x8000000aULL,
 	0x8000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
 	0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
-	0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
-
-/*** Helper macros to unroll the permutation. ***/
-#define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
-#define REPEAT6(e) e e e e e e
-#define REPEAT24(e) REPEAT6(e e e e)
-#define REPEAT5(e) e e e e e
-#define FOR5(type, v, s, e) \
-	v = 0;            \
-	REPEAT5(e; v = static_cast<type>(v + s);)
-
-/*** Keccak-f[1600] ***/
-static inline void keccakf(void* state) {
-	auto* a = static_cast<uint64_t*>(state);
-	uint64_t b[5] = {0};
-
-	for (int i = 0; i < 24; i++)
+	0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL
+};
+
+/// One 64 bit lane of @a Lanes states.
+template <size_t Lanes>
+struct Word
+{
+	uint64_t v[Lanes];
+
+	Word operator^(Word const& _other) const
 	{
-		uint8_t x, y;
-		// Theta
-		FOR5(uint8_t, x, 1,
-			b[x] = 0;
-			FOR5(uint8_t, y, 5,
-				b[x] ^= a[x + y]; ))
-		FOR5(uint8_t, x, 1,
-			FOR5(uint8_t, y, 5,
-				a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
-		// Rho and pi
-		uint64_t t = a[1];
-		x = 0;
-		REPEAT24(b[0] = a[pi[x]];
-				a[pi[x]] = rol(t, rho[x]);
-				t = b[0];
-				x++; )
-		// Chi
-		FOR5(uint8_t,
-			y,
-			5,
-			FOR5(uint8_t, x, 1,
-				b[x] = a[y + x];)
-			FOR5(uint8_t, x, 1,
-				a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
-		// Iota
-		a[0] ^= RC[i];
+		Word result;
+		for (size_t l = 0; l < Lanes; ++l)
+			result.v[l] = v[l] ^ _other.v[l];
+		return result;
+	}
+	/// @returns ~*this & _other.
+	Word andNot(Word const& _other) const
+	{
+		Word result;
+		for (size_t l = 0; l < Lanes; ++l)
+			result.v[l] = ~v[l] & _other.v[l];
+		return result;
 	}
+	template <unsigned Shift>
+	Word rol() const
+	{
+		static_assert(0 < Shift && Shift < 64, "");
+		Word result;
+		for (size_t l = 0; l < Lanes; ++l)
+			result.v[l] = (v[l] << Shift) | (v[l] >> (64 - Shift));
+		return result;
+	}
+};
+
+template <size_t Lanes>
+using State = Word<Lanes>[25];
+
+/// Rotates @a _carry by @a Shift, stores it in @a _lane and carries on with the previous
+/// value of @a _lane.
+template <unsigned Shift, size_t Lanes>
+inline void rhoPi(Word<Lanes>& _lane, Word<Lanes>& _carry)
+{
+	Word<Lanes> next = _lane;
+	_lane = _carry.template rol<Shift>();
+	_carry = next;
 }
 
-/******** The FIPS202-defined functions. ********/
+/// Keccak-f[1600], written such that all lane indices and rotation offsets are constants.
+template <size_t Lanes>
+void keccakf(State<Lanes>& _a)
+{
+	using W = Word<Lanes>;
+	for (uint64_t roundConstant: RC)
+	{
+		// Theta
+		W c0 = _a[0] ^ _a[5] ^ _a[10] ^ _a[15] ^ _a[20];
+		W c1 = _a[1] ^ _a[6] ^ _a[11] ^ _a[16] ^ _a[21];
+		W c2 = _a[2] ^ _a[7] ^ _a[12] ^ _a[17] ^ _a[22];
+		W c3 = _a[3] ^ _a[8] ^ _a[13] ^ _a[18] ^ _a[23];
+		W c4 = _a[4] ^ _a[9] ^ _a[14] ^ _a[19] ^ _a[24];
+		W d0 = c4 ^ c1.template rol<1>();
+		W d1 = c0 ^ c2.template rol<1>();
+		W d2 = c1 ^ c3.template rol<1>();
+		W d3 = c2 ^ c4.template rol<1>();
+		W d4 = c3 ^ c0.template rol<1>();
 
-/*** Some helper macros. ***/
+		for (size_t y = 0; y < 25; y += 5)
+		{
+			_a[y] = _a[y] ^ d0;
+			_a[y + 1] = _a[y + 1] ^ d1;
+			_a[y + 2] = _a[y + 2] ^ d2;
+			_a[y + 3] = _a[y + 3] ^ d3;
+			_a[y + 4] = _a[y + 4] ^ d4;
+		}
 
-#define _(S) do { S } while (0)
-#define FOR(i, ST, L, S) \
-	_(for (size_t i = 0; i < L; i += ST) { S; })
-#define mkapply_ds(NAME, S)                                          \
-	static inline void NAME(uint8_t* dst,                              \
-							uint8_t const* src,                        \
-							size_t len) {                              \
-		FOR(i, 1, len, S);                                               \
-	}
-#define mkapply_sd(NAME, S)                                          \
-	static inline void NAME(uint8_t const* src,                        \
-							uint8_t* dst,                              \
-							size_t len) {                              \
-		FOR(i, 1, len, S);                                               \
+		// Rho and pi, following the cycle of pi through all lanes but lane 0.
+		W t = _a[1];
+		rhoPi<1>(_a[10], t);
+		rhoPi<3>(_a[7], t);
+		rhoPi<6>(_a[11], t);
+		rhoPi<10>(_a[17], t);
+		rhoPi<15>(_a[18], t);
+		rhoPi<21>(_a[3], t);
+		rhoPi<28>(_a[5], t);
+		rhoPi<36>(_a[16], t);
+		rhoPi<45>(_a[8], t);
+		rhoPi<55>(_a[21], t);
+		rhoPi<2>(_a[24], t);
+		rhoPi<14>(_a[4], t);
+		rhoPi<27>(_a[15], t);
+		rhoPi<41>(_a[23], t);
+		rhoPi<56>(_a[19], t);
+		rhoPi<8>(_a[13], t);
+		rhoPi<25>(_a[12], t);
+		rhoPi<43>(_a[2], t);
+		rhoPi<62>(_a[20], t);
+		rhoPi<18>(_a[14], t);
+		rhoPi<39>(_a[22], t);
+		rhoPi<61>(_a[9], t);
+		rhoPi<20>(_a[6], t);
+		rhoPi<44>(_a[1], t);
+
+		// Chi
+		for (size_t y = 0; y < 25; y += 5)
+		{
+			W b0 = _a[y], b1 = _a[y + 1], b2 = _a[y + 2], b3 = _a[y + 3], b4 = _a[y + 4];
+			_a[y] = b0 ^ b1.andNot(b2);
+			_a[y + 1] = b1 ^ b2.andNot(b3);
+			_a[y + 2] = b2 ^ b3.andNot(b4);
+			_a[y + 3] = b3 ^ b4.andNot(b0);
+			_a[y + 4] = b4 ^ b0.andNot(b1);
+		}
+
+		// Iota
+		for (size_t l = 0; l < Lanes; ++l)
+			_a[0].v[l] ^= roundConstant;
 	}
+}
 
-mkapply_ds(xorin, dst[i] ^= src[i])  // xorin
-mkapply_sd(setout, dst[i] = src[i])  // setout
+inline uint64_t loadLittleEndian(uint8_t const* _data)
+{
+	uint64_t result = 0;
+	for (size_t i = 0; i < 8; ++i)
+		result |= uint64_t(_data[i]) << (8 * i);
+	return result;
+}
 
-#define P keccakf
-#define Plen 200
+/// Number of blocks absorbed for an input of @a _size bytes, including the padding.
+inline size_t blockCount(size_t _size)
+{
+	return _size / rate + 1;
+}
 
-// Fold P*F over the full blocks of an input.
-#define foldP(I, L, F) \
-	while (L >= rate) {  \
-		F(a, I, rate);     \
-		P(a);              \
-		I += rate;         \
-		L -= rate;         \
-	}
+/// Xors the block number @a _block of the padded input @a _input into lane @a _lane of @a _a.
+template <size_t Lanes>
+void absorb(State<Lanes>& _a, size_t _lane, bytesConstRef _input, size_t _block)
+{
+	uint8_t const* data = _input.data() + _block * rate;
+	size_t size = min(_input.size() - _block * rate, rate);
+	for (size_t i = 0; i < size / 8; ++i)
+		_a[i].v[_lane] ^= loadLittleEndian(data + 8 * i);
+	if (size == rate)
+		return;
+	// Last block: Keccak uses 0x01 as the domain separator in the padding (SHA3 uses 0x06).
+	for (size_t i = size & ~size_t(7); i < size; ++i)
+		_a[i / 8].v[_lane] ^= uint64_t(data[i]) << (8 * (i % 8));
+	_a[size / 8].v[_lane] ^= uint64_t(0x01) << (8 * (size % 8));
+	_a[rate / 8 - 1].v[_lane] ^= uint64_t(0x80) << 56;
+}
+
+template <size_t Lanes>
+void squeeze(State<Lanes> const& _a, size_t _lane, h256& _output)
+{
+	for (unsigned i = 0; i < h256::size; ++i)
+		_output[i] = uint8_t(_a[i / 8].v[_lane] >> (8 * (i % 8)));
+}
 
-/** The sponge-based hash construction. **/
-inline void hash(
-	uint8_t* out,
-	size_t outlen,
-	uint8_t const* in,
-	size_t inlen,
-	size_t rate,
-	uint8_t delim
-)
+/// Hashes the inputs given by @a _indices, which all consist of @a _blocks blocks, Lanes at a time.
+template <size_t Lanes>
+void hashLanes(vector<bytesConstRef> const& _inputs, size_t const* _indices, size_t _blocks, vector<h256>& _outputs)
 {
-	uint8_t a[Plen] = {0};
-	// Absorb input.
-	foldP(in, inlen, xorin);
-	// Xor in the DS and pad frame.
-	a[inlen] ^= delim;
-	a[rate - 1] ^= 0x80;
-	// Xor in the last block.
-	xorin(a, in, inlen);
-	// Apply P
-	P(a);
-	// Squeeze output.
-	foldP(out, outlen, setout);
-	setout(a, out, outlen);
-	memset(a, 0, 200);
+	State<Lanes> a{};
+	for (size_t block = 0; block < _blocks; ++block)
+	{
+		for (size_t l = 0; l < Lanes; ++l)
+			absorb<Lanes>(a, l, _inputs[_indices[l]], block);
+		keccakf<Lanes>(a);
+	}
+	for (size_t l = 0; l < Lanes; ++l)
+		squeeze<Lanes>(a, l, _outputs[_indices[l]]);
 }
 
 }
 
 h256 keccak256(bytesConstRef _input)
 {
+	State<1> a{};
+	for (size_t block = 0; block < blockCount(_input.size()); ++block)
+	{
+		absorb<1>(a, 0, _input, block);
+		keccakf<1>(a);
+	}
 	h256 output;
-	// Parameters used:
-	// The 0x01 is the specific padding for keccak (sha3 uses 0x06) and
-	// the way the round size (or window or whatever it was) is calculated.
-	// 200 - (256 / 4) is the "rate"
-	hash(output.data(), output.size, _input.data(), _input.size(), 200 - (256 / 4), 0x01);
+	squeeze<1>(a, 0, output);
 	return output;
 }
 
+vector<h256> keccak256Batch(vector<bytesConstRef> const& _inputs)
+{
+	vector<h256> outputs(_inputs.size());
+	// Only inputs that need the same number of permutations can share them.
+	map<size_t, vector<size_t>> indicesByBlockCount;
+	for (size_t i = 0; i < _inputs.size(); ++i)
+		indicesByBlockCount[blockCount(_inputs[i].size())].push_back(i);
+	for (auto const& [blocks, indices]: indicesByBlockCount)
+	{
+		size_t i = 0;
+		for (; i + batchLanes <= indices.size(); i += batchLanes)
+			hashLanes<batchLanes>(_inputs, indices.data() + i, blocks, outputs);
+		for (; i < indices.size(); ++i)
+			hashLanes<1>(_inputs, indices.data() + i, blocks, outputs);
+	}
+	return outputs;
+}
+
 }
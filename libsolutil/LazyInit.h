@@ -21,7 +21,9 @@
 #include <libsolutil/Assertions.h>
 #include <libsolutil/Exceptions.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -35,6 +37,10 @@ DEV_SIMPLE_EXCEPTION(BadLazyInitAccess);
  * A value that is initialized at some point after construction of the LazyInit. The stored value can only be accessed
  * while calling "init", which initializes the stored value (if it has not already been initialized).
  *
+ * "init" may be called concurrently from several threads. The initialization function is called without holding
+ * a lock, so that it may initialize other LazyInit objects, and may therefore run more than once if several threads
+ * find the value uninitialized. Only the first result is stored and all callers get a reference to it.
+ *
  * @tparam T the type of the stored value; may not be a function, reference, array, or void type; may be const-qualified.
  */
 template<typename T>
@@ -53,16 +59,22 @@ public:
 	LazyInit& operator=(LazyInit const&) = delete;
 
 	// Move constructor must be overridden to ensure that moved-from object is left empty.
-	constexpr LazyInit(LazyInit&& _other) noexcept:
-		m_value(std::move(_other.m_value))
+	// Moving is not thread-safe.
+	LazyInit(LazyInit&& _other) noexcept:
+		m_value(std::move(_other.m_value)),
+		m_initialized(_other.m_initialized.load(std::memory_order_relaxed))
 	{
 		_other.m_value.reset();
+		_other.m_initialized.store(false, std::memory_order_relaxed);
 	}
 
 	LazyInit& operator=(LazyInit&& _other) noexcept
 	{
 		this->m_value.swap(_other.m_value);
+		this->m_initialized.store(_other.m_initialized.load(std::memory_order_relaxed), std::memory_order_relaxed);
 		_other.m_value.reset();
+		_other.m_initialized.store(false, std::memory_order_relaxed);
+		return *this;
 	}
 
 	template<typename F>
@@ -85,11 +97,21 @@ private:
 	template<typename F>
 	void doInit(F&& _fun) const
 	{
+		if (m_initialized.load(std::memory_order_acquire))
+			return;
+		auto value = std::forward<F>(_fun)();
+		std::lock_guard<std::mutex> lock(m_mutex);
 		if (!m_value.has_value())
-			m_value.emplace(std::forward<F>(_fun)());
+		{
+			m_value.emplace(std::move(value));
+			m_initialized.store(true, std::memory_order_release);
+		}
 	}
 
 	mutable std::optional<value_type> m_value;
+	/// Set once m_value holds the result, so that initialized values can be accessed without locking.
+	mutable std::atomic<bool> m_initialized = false;
+	mutable std::mutex m_mutex;
 };
 
 }
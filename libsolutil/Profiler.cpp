@@ -0,0 +1,281 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Profiler.h>
+
+#include <libsolutil/AllocationStats.h>
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <iomanip>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Innermost scope that is currently active on this thread.
+thread_local Profiler::Node* t_currentNode = nullptr;
+/// Number of this thread in the trace events, assigned when it records its first event.
+thread_local optional<size_t> t_traceThread;
+
+double toMilliseconds(Profiler::Clock::duration _duration)
+{
+	return chrono::duration<double, milli>(_duration).count();
+}
+
+double toMicroseconds(Profiler::Clock::duration _duration)
+{
+	return chrono::duration<double, micro>(_duration).count();
+}
+
+}
+
+Profiler& Profiler::instance()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+void Profiler::setTracingEnabled(bool _enabled)
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (_enabled && !m_tracingEnabled)
+		m_traceStart = Clock::now();
+	m_tracingEnabled = _enabled;
+}
+
+void Profiler::reset()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_root.children.clear();
+	m_traceEvents.clear();
+	m_traceStart = Clock::now();
+}
+
+Json::Value Profiler::toJson() const
+{
+	function<Json::Value(Node const&)> nodeToJson = [&](Node const& _node)
+	{
+		Json::Value result(Json::objectValue);
+		result["name"] = _node.name;
+		result["invocations"] = Json::UInt64(_node.invocations);
+		result["wallTimeMs"] = toMilliseconds(_node.duration);
+		result["peakMemoryKiB"] = Json::UInt64(_node.peakMemoryKiB);
+		if (AllocationStats::available())
+		{
+			result["allocations"] = Json::UInt64(_node.allocations);
+			result["allocatedBytes"] = Json::UInt64(_node.allocatedBytes);
+			result["peakLiveBytes"] = Json::UInt64(_node.peakLiveBytes);
+		}
+		if (!_node.children.empty())
+		{
+			result["children"] = Json::arrayValue;
+			for (auto const& child: _node.children)
+				result["children"].append(nodeToJson(*child));
+		}
+		return result;
+	};
+
+	lock_guard<mutex> lock(m_mutex);
+	Json::Value phases(Json::arrayValue);
+	for (auto const& child: m_root.children)
+		phases.append(nodeToJson(*child));
+	return phases;
+}
+
+string Profiler::toString() const
+{
+	size_t constexpr nameWidth = 56;
+	bool const allocations = AllocationStats::available();
+	ostringstream out;
+	out << left << setw(nameWidth) << "Phase" << right <<
+		setw(14) << "Wall time" <<
+		setw(10) << "Calls" <<
+		setw(16) << "Peak RSS";
+	if (allocations)
+		out << setw(12) << "Allocs" << setw(16) << "Alloc size" << setw(16) << "Peak heap";
+	out << endl;
+
+	function<void(Node const&, size_t)> printNode = [&](Node const& _node, size_t _depth)
+	{
+		string name = string(2 * _depth, ' ') + _node.name;
+		if (name.size() >= nameWidth)
+			name = name.substr(0, nameWidth - 4) + "...";
+		out << left << setw(nameWidth) << name << right <<
+			setw(11) << fixed << setprecision(3) << toMilliseconds(_node.duration) << " ms" <<
+			setw(10) << _node.invocations <<
+			setw(12) << _node.peakMemoryKiB << " KiB";
+		if (allocations)
+			out <<
+				setw(12) << _node.allocations <<
+				setw(12) << _node.allocatedBytes / 1024 << " KiB" <<
+				setw(12) << _node.peakLiveBytes / 1024 << " KiB";
+		out << endl;
+		for (auto const& child: _node.children)
+			printNode(*child, _depth + 1);
+	};
+
+	lock_guard<mutex> lock(m_mutex);
+	for (auto const& child: m_root.children)
+		printNode(*child, 0);
+	return out.str();
+}
+
+Json::Value Profiler::traceToJson() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	Json::Value events(Json::arrayValue);
+	for (TraceEvent const& event: m_traceEvents)
+	{
+		Json::Value traceEvent(Json::objectValue);
+		traceEvent["name"] = event.name;
+		traceEvent["cat"] = "solc";
+		traceEvent["ph"] = "X";
+		traceEvent["pid"] = 1;
+		traceEvent["tid"] = Json::UInt64(event.thread);
+		traceEvent["ts"] = toMicroseconds(event.start - m_traceStart);
+		traceEvent["dur"] = toMicroseconds(event.duration);
+		if (!event.detail.empty())
+			traceEvent["args"]["detail"] = event.detail;
+		events.append(move(traceEvent));
+	}
+	Json::Value trace(Json::objectValue);
+	trace["traceEvents"] = move(events);
+	trace["displayTimeUnit"] = "ms";
+	return trace;
+}
+
+size_t Profiler::peakMemoryKiB()
+{
+#if defined(_WIN32)
+	return 0;
+#else
+	struct rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0 || usage.ru_maxrss < 0)
+		return 0;
+#if defined(__APPLE__)
+	// macOS reports the value in bytes instead of kilobytes.
+	return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+	return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+Profiler::Node& Profiler::enter(Node* _parent, string const& _name)
+{
+	lock_guard<mutex> lock(m_mutex);
+	Node& parent = _parent ? *_parent : m_root;
+	for (auto const& child: parent.children)
+		if (child->name == _name)
+			return *child;
+	parent.children.emplace_back(make_unique<Node>());
+	parent.children.back()->name = _name;
+	return *parent.children.back();
+}
+
+void Profiler::leave(
+	Node& _node,
+	Clock::duration _duration,
+	size_t _allocations,
+	size_t _allocatedBytes,
+	size_t _peakLiveBytes
+)
+{
+	size_t peakMemory = peakMemoryKiB();
+	lock_guard<mutex> lock(m_mutex);
+	++_node.invocations;
+	_node.duration += _duration;
+	_node.peakMemoryKiB = peakMemory;
+	_node.allocations += _allocations;
+	_node.allocatedBytes += _allocatedBytes;
+	_node.peakLiveBytes = max(_node.peakLiveBytes, _peakLiveBytes);
+}
+
+void Profiler::addTraceEvent(string _name, string _detail, Clock::time_point _start)
+{
+	Clock::time_point end = Clock::now();
+	lock_guard<mutex> lock(m_mutex);
+	if (!t_traceThread)
+		t_traceThread = ++m_traceThreads;
+	m_traceEvents.push_back({move(_name), move(_detail), *t_traceThread, _start, end - _start});
+}
+
+ProfilerScope::ProfilerScope(string const& _name, string _detail)
+{
+	Profiler& profiler = Profiler::instance();
+	m_tracing = profiler.tracingEnabled();
+	if (m_tracing)
+	{
+		m_name = _name;
+		m_detail = move(_detail);
+	}
+	if (profiler.enabled())
+	{
+		m_parent = t_currentNode;
+		m_node = &profiler.enter(m_parent, _name);
+		t_currentNode = m_node;
+		m_startAllocations = AllocationStats::threadAllocations();
+		m_startAllocatedBytes = AllocationStats::threadAllocatedBytes();
+		m_enclosingPeakLiveBytes = AllocationStats::beginPeak();
+	}
+	if (m_node || m_tracing)
+		m_start = Profiler::Clock::now();
+}
+
+ProfilerScope::~ProfilerScope()
+{
+	if (m_node)
+	{
+		Profiler::instance().leave(
+			*m_node,
+			Profiler::Clock::now() - m_start,
+			AllocationStats::threadAllocations() - m_startAllocations,
+			AllocationStats::threadAllocatedBytes() - m_startAllocatedBytes,
+			AllocationStats::endPeak(m_enclosingPeakLiveBytes)
+		);
+		t_currentNode = m_parent;
+	}
+	if (m_tracing)
+		Profiler::instance().addTraceEvent(move(m_name), move(m_detail), m_start);
+}
+
+TraceScope::TraceScope(string _name, string _detail)
+{
+	m_tracing = Profiler::instance().tracingEnabled();
+	if (!m_tracing)
+		return;
+	m_name = move(_name);
+	m_detail = move(_detail);
+	m_start = Profiler::Clock::now();
+}
+
+TraceScope::~TraceScope()
+{
+	if (m_tracing)
+		Profiler::instance().addTraceEvent(move(m_name), move(m_detail), m_start);
+}
@@ -0,0 +1,183 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collection of hierarchical wall-clock timings and peak memory usage of compiler phases
+ * and of a timeline of the phases in the Chrome trace event format.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Process-wide collector of wall-clock timings and peak memory usage of compiler phases.
+ *
+ * Phases are measured using ProfilerScope. A scope that is entered while another scope is
+ * active on the same thread is recorded as a child of that scope. Scopes with the same name
+ * and the same parent are aggregated into a single node.
+ *
+ * If tracing is enabled, every invocation of a scope and of a TraceScope is also recorded
+ * as an event with its start time, duration and thread, which can be exported in the Chrome
+ * trace event format and viewed in chrome://tracing or Perfetto.
+ *
+ * If the compiler is built with SOLC_ALLOCATION_STATS, the heap allocations made by the
+ * thread of a scope during the scope, including those of nested scopes, and the peak of the
+ * live heap bytes during the scope are recorded as well (see AllocationStats).
+ *
+ * Collection is disabled by default, in which case entering and leaving a scope only costs
+ * a single atomic load.
+ */
+class Profiler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Node
+	{
+		std::string name;
+		size_t invocations = 0;
+		Clock::duration duration = Clock::duration::zero();
+		/// Peak resident set size of the process at the end of the last invocation, in KiB.
+		size_t peakMemoryKiB = 0;
+		/// Number and bytes of the heap allocations of all invocations.
+		size_t allocations = 0;
+		size_t allocatedBytes = 0;
+		/// Maximum of the live heap bytes of the process during any invocation.
+		size_t peakLiveBytes = 0;
+		/// Child phases in the order in which they were first entered.
+		std::vector<std::unique_ptr<Node>> children;
+	};
+
+	static Profiler& instance();
+
+	void setEnabled(bool _enabled) { m_enabled = _enabled; }
+	bool enabled() const { return m_enabled; }
+
+	/// Enables the recording of trace events. The timestamps of the events are relative to
+	/// the time tracing was enabled.
+	void setTracingEnabled(bool _enabled);
+	bool tracingEnabled() const { return m_tracingEnabled; }
+
+	/// Discards all measurements and trace events. Must not be called while a scope is active.
+	void reset();
+
+	/// @returns the top-level phases as a JSON array of objects with the keys
+	/// "name", "invocations", "wallTimeMs", "peakMemoryKiB", (if allocations are counted)
+	/// "allocations", "allocatedBytes" and "peakLiveBytes", and (if non-empty) "children".
+	Json::Value toJson() const;
+	/// @returns a human-readable, indented table of all measured phases.
+	std::string toString() const;
+	/// @returns the recorded trace events as a JSON object in the Chrome trace event format.
+	Json::Value traceToJson() const;
+
+	/// @returns the peak resident set size of the current process in KiB or zero if unavailable.
+	static size_t peakMemoryKiB();
+
+private:
+	friend class ProfilerScope;
+	friend class TraceScope;
+
+	struct TraceEvent
+	{
+		std::string name;
+		std::string detail;
+		size_t thread;
+		Clock::time_point start;
+		Clock::duration duration;
+	};
+
+	Profiler() = default;
+
+	/// Finds or creates the child node @a _name of @a _parent (or the root if null).
+	Node& enter(Node* _parent, std::string const& _name);
+	void leave(
+		Node& _node,
+		Clock::duration _duration,
+		size_t _allocations,
+		size_t _allocatedBytes,
+		size_t _peakLiveBytes
+	);
+	void addTraceEvent(std::string _name, std::string _detail, Clock::time_point _start);
+
+	std::atomic<bool> m_enabled{false};
+	std::atomic<bool> m_tracingEnabled{false};
+	mutable std::mutex m_mutex;
+	Node m_root;
+	Clock::time_point m_traceStart;
+	std::vector<TraceEvent> m_traceEvents;
+	/// Number of threads that recorded trace events so far, used to number them.
+	size_t m_traceThreads = 0;
+};
+
+/**
+ * RAII helper that measures the time between its construction and destruction
+ * as an invocation of the phase @a _name if the profiler is enabled and records it
+ * as a trace event with the label @a _detail if tracing is enabled.
+ */
+class ProfilerScope
+{
+public:
+	explicit ProfilerScope(std::string const& _name, std::string _detail = {});
+	~ProfilerScope();
+
+	ProfilerScope(ProfilerScope const&) = delete;
+	ProfilerScope& operator=(ProfilerScope const&) = delete;
+
+private:
+	Profiler::Node* m_node = nullptr;
+	Profiler::Node* m_parent = nullptr;
+	Profiler::Clock::time_point m_start;
+	size_t m_startAllocations = 0;
+	size_t m_startAllocatedBytes = 0;
+	size_t m_enclosingPeakLiveBytes = 0;
+	bool m_tracing = false;
+	std::string m_name;
+	std::string m_detail;
+};
+
+/**
+ * RAII helper that only records a trace event, for spans like optimiser rounds or
+ * retries that are too fine-grained or too numerous for the aggregated timings.
+ */
+class TraceScope
+{
+public:
+	explicit TraceScope(std::string _name, std::string _detail = {});
+	~TraceScope();
+
+	TraceScope(TraceScope const&) = delete;
+	TraceScope& operator=(TraceScope const&) = delete;
+
+private:
+	bool m_tracing = false;
+	std::string m_name;
+	std::string m_detail;
+	Profiler::Clock::time_point m_start;
+};
+
+}
@@ -63,16 +63,23 @@ h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
 	return swarmHashSimple(ref, _length);
 }
 
-h256 bmtHash(bytesConstRef _data)
+/// Computes the binary merkle tree hash of @a _data, whose size has to be 64 times
+/// a power of two, in place: Each level of the tree is hashed in one batch and its
+/// hashes overwrite the front of @a _data.
+h256 bmtHash(bytes& _data)
 {
-	if (_data.size() <= 64)
-		return keccak256(_data);
-
-	size_t midPoint = _data.size() / 2;
-	return keccak256(
-		bmtHash(_data.cropped(0, midPoint)).asBytes() +
-		bmtHash(_data.cropped(midPoint)).asBytes()
-	);
+	size_t size = _data.size();
+	while (size > 64)
+	{
+		vector<bytesConstRef> segments;
+		for (size_t i = 0; i < size; i += 64)
+			segments.emplace_back(bytesConstRef(&_data).cropped(i, 64));
+		vector<h256> hashes = keccak256Batch(segments);
+		for (size_t i = 0; i < hashes.size(); ++i)
+			copy(hashes[i].data(), hashes[i].data() + 32, _data.begin() + static_cast<ptrdiff_t>(32 * i));
+		size /= 2;
+	}
+	return keccak256(bytesConstRef(&_data).cropped(0, size));
 }
 
 h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
@@ -98,7 +105,7 @@ h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
 	}
 
 	dataToHash.resize(0x1000, 0);
-	return keccak256(toLittleEndian(_data.size()) + bmtHash(&dataToHash).asBytes());
+	return keccak256(toLittleEndian(_data.size()) + bmtHash(dataToHash).asBytes());
 }
 
 
@@ -110,9 +117,9 @@ h256 solidity::util::bzzr0Hash(string const& _input)
 }
 
 
-h256 solidity::util::bzzr1Hash(bytes const& _input)
+h256 solidity::util::bzzr1Hash(bytesConstRef _input)
 {
 	if (_input.empty())
 		return h256{};
-	return chunkHash(&_input);
+	return chunkHash(_input);
 }
@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+ThreadPool::ThreadPool(size_t _threadCount)
+{
+	_threadCount = max<size_t>(_threadCount, 1);
+	m_workers.reserve(_threadCount);
+	for (size_t i = 0; i < _threadCount; ++i)
+		m_workers.emplace_back([this] { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_allTasksFinished.wait(lock, [&] { return m_unfinishedTasks == 0; });
+		m_stopping = true;
+	}
+	m_taskAvailable.notify_all();
+	for (thread& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::post(function<void()> _task)
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_tasks.emplace_back(move(_task));
+		++m_unfinishedTasks;
+	}
+	m_taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	exception_ptr exception;
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_allTasksFinished.wait(lock, [&] { return m_unfinishedTasks == 0; });
+		swap(exception, m_exception);
+	}
+	if (exception)
+		rethrow_exception(exception);
+}
+
+size_t ThreadPool::hardwareConcurrency()
+{
+	return max<size_t>(thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		function<void()> task;
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_taskAvailable.wait(lock, [&] { return m_stopping || !m_tasks.empty(); });
+			if (m_tasks.empty())
+				return;
+			task = move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+
+		exception_ptr exception;
+		try
+		{
+			task();
+		}
+		catch (...)
+		{
+			exception = current_exception();
+		}
+		// Release the resources held by the task before it is reported as finished.
+		task = nullptr;
+
+		bool finished = false;
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (exception && !m_exception)
+				m_exception = exception;
+			finished = (--m_unfinishedTasks == 0);
+		}
+		if (finished)
+			m_allTasksFinished.notify_all();
+	}
+}
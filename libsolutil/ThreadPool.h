@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Simple fixed-size pool of worker threads.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Fixed-size pool of worker threads that execute posted tasks in the order in which they were posted.
+ *
+ * Tasks may post further tasks to the pool. The first exception thrown by any task is
+ * captured and rethrown by wait(); the remaining tasks are still executed.
+ */
+class ThreadPool
+{
+public:
+	/// Starts @a _threadCount worker threads (at least one).
+	explicit ThreadPool(size_t _threadCount);
+	/// Waits for all pending tasks and stops the worker threads.
+	/// Exceptions thrown by tasks and not yet collected via wait() are discarded.
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// Schedules @a _task for execution on one of the worker threads.
+	void post(std::function<void()> _task);
+
+	/// Blocks until all posted tasks, including those posted by tasks while waiting, have finished.
+	/// Rethrows the first exception thrown by a task since the last call to wait().
+	void wait();
+
+	size_t threadCount() const { return m_workers.size(); }
+
+	/// @returns the number of concurrent threads supported by the hardware, or one if unknown.
+	static size_t hardwareConcurrency();
+
+private:
+	void work();
+
+	std::mutex m_mutex;
+	std::condition_variable m_taskAvailable;
+	std::condition_variable m_allTasksFinished;
+	std::deque<std::function<void()>> m_tasks;
+	/// Number of tasks that were posted but have not finished yet.
+	size_t m_unfinishedTasks = 0;
+	bool m_stopping = false;
+	std::exception_ptr m_exception;
+	std::vector<std::thread> m_workers;
+};
+
+}
@@ -26,11 +26,272 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <memory>
+#include <mutex>
+#include <optional>
 
 using namespace std;
 using namespace solidity::util;
 
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/**
+ * Parsed form of a template (or of the body of a list or condition inside a template).
+ */
+struct ParsedTemplate
+{
+	struct Element
+	{
+		enum class Kind { Text, Tag, List, Condition };
+		Kind kind = Kind::Text;
+		/// The text for Text elements, otherwise the name of the parameter, including
+		/// the leading "+" for conditions on string parameters.
+		string value;
+		/// The body of a list or the parts of a condition for the true and false case.
+		shared_ptr<ParsedTemplate const> body;
+		shared_ptr<ParsedTemplate const> elseBody;
+	};
+
+	/// The text this was parsed from, used in error messages.
+	string source;
+	vector<Element> elements;
+};
+
+/// @returns the length of the parameter name starting at @a _pos.
+size_t parameterLength(string const& _text, size_t _pos)
+{
+	size_t end = _pos;
+	while (end < _text.size() && isParameterCharacter(_text[end]))
+		++end;
+	return end - _pos;
+}
+
+/// Parses @a _text, matching tags in the same way as the regular expression
+///   <(name)>|<#(name)>(.*?)</\2>|<\?(\+?name)>(.*?)(<!\4>(.*?))?</\4>
+/// applied left to right, where "name" is a non-empty sequence of parameter characters.
+/// Text that does not form a complete tag is kept literally.
+shared_ptr<ParsedTemplate const> parseTemplate(string _text)
+{
+	auto result = make_shared<ParsedTemplate>();
+	string text;
+	auto flushText = [&]() {
+		if (!text.empty())
+			result->elements.push_back({ParsedTemplate::Element::Kind::Text, std::move(text), nullptr, nullptr});
+		text.clear();
+	};
+
+	size_t pos = 0;
+	while (pos < _text.size())
+	{
+		size_t next = _text.find('<', pos);
+		if (next == string::npos)
+		{
+			text.append(_text, pos, string::npos);
+			break;
+		}
+		text.append(_text, pos, next - pos);
+		pos = next;
+
+		char marker = pos + 1 < _text.size() ? _text[pos + 1] : '\0';
+		size_t nameStart = pos + 1;
+		if (marker == '#')
+			nameStart = pos + 2;
+		else if (marker == '?')
+			nameStart = pos + (pos + 2 < _text.size() && _text[pos + 2] == '+' ? 3 : 2);
+		size_t nameLength = parameterLength(_text, nameStart);
+		size_t openEnd = nameStart + nameLength;
+		if (nameLength == 0 || openEnd >= _text.size() || _text[openEnd] != '>')
+		{
+			text += '<';
+			++pos;
+			continue;
+		}
+		// Includes the "+" of conditions on string parameters.
+		string name = _text.substr(marker == '?' ? pos + 2 : nameStart, openEnd - (marker == '?' ? pos + 2 : nameStart));
+		size_t bodyStart = openEnd + 1;
+
+		if (marker != '#' && marker != '?')
+		{
+			flushText();
+			result->elements.push_back({ParsedTemplate::Element::Kind::Tag, std::move(name), nullptr, nullptr});
+			pos = bodyStart;
+			continue;
+		}
+
+		string closeTag = "</" + name + ">";
+		size_t close = _text.find(closeTag, bodyStart);
+		if (close == string::npos)
+		{
+			text += '<';
+			++pos;
+			continue;
+		}
+
+		flushText();
+		ParsedTemplate::Element element;
+		element.value = name;
+		if (marker == '#')
+		{
+			element.kind = ParsedTemplate::Element::Kind::List;
+			element.body = parseTemplate(_text.substr(bodyStart, close - bodyStart));
+		}
+		else
+		{
+			element.kind = ParsedTemplate::Element::Kind::Condition;
+			string elseTag = "<!" + name + ">";
+			size_t elsePos = _text.find(elseTag, bodyStart);
+			if (elsePos != string::npos && elsePos < close)
+			{
+				element.body = parseTemplate(_text.substr(bodyStart, elsePos - bodyStart));
+				size_t elseStart = elsePos + elseTag.size();
+				element.elseBody = parseTemplate(_text.substr(elseStart, close - elseStart));
+			}
+			else
+				element.body = parseTemplate(_text.substr(bodyStart, close - bodyStart));
+		}
+		result->elements.emplace_back(std::move(element));
+		pos = close + closeTag.size();
+	}
+	flushText();
+	result->source = std::move(_text);
+	return result;
+}
+
+/// @returns the parsed form of @a _template, parsing it only on first use.
+shared_ptr<ParsedTemplate const> cachedParsedTemplate(string const& _template)
+{
+	static mutex cacheMutex;
+	static map<string, shared_ptr<ParsedTemplate const>> cache;
+
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto it = cache.find(_template); it != cache.end())
+			return it->second;
+	}
+	auto parsed = parseTemplate(_template);
+	lock_guard<mutex> lock(cacheMutex);
+	return cache.emplace(_template, std::move(parsed)).first->second;
+}
+
+/// Renders parsed templates into a single output buffer.
+class TemplateRenderer
+{
+public:
+	TemplateRenderer(
+		Whiskers::StringMap const& _parameters,
+		map<string, bool> const& _conditions,
+		Whiskers::StringListMap const& _listParameters,
+		string& _output
+	):
+		m_parameters(_parameters),
+		m_conditions(_conditions),
+		m_listParameters(_listParameters),
+		m_output(_output)
+	{}
+
+	/// Renders @a _template. Inside lists, @a _listElement holds the parameters of the
+	/// current list element, which are looked up before the regular parameters.
+	void render(ParsedTemplate const& _template, Whiskers::StringMap const* _listElement = nullptr)
+	{
+		for (ParsedTemplate::Element const& element: _template.elements)
+			switch (element.kind)
+			{
+			case ParsedTemplate::Element::Kind::Text:
+				m_output += element.value;
+				break;
+			case ParsedTemplate::Element::Kind::Tag:
+			{
+				string const* value = lookup(element.value, _listElement);
+				assertThrow(
+					value,
+					WhiskersError,
+					"Value for tag " + element.value + " not provided.\n" +
+					"Template:\n" +
+					_template.source
+				);
+				m_output += *value;
+				break;
+			}
+			case ParsedTemplate::Element::Kind::List:
+			{
+				// Lists cannot be nested.
+				auto list = m_listParameters.find(element.value);
+				assertThrow(
+					!_listElement && list != m_listParameters.end(),
+					WhiskersError, "List parameter " + element.value + " not set."
+				);
+				for (Whiskers::StringMap const& listElement: list->second)
+				{
+					for (auto const& parameter: listElement)
+						assertThrow(
+							!m_parameters.count(parameter.first),
+							WhiskersError,
+							"Parameter collision"
+						);
+					render(*element.body, &listElement);
+				}
+				break;
+			}
+			case ParsedTemplate::Element::Kind::Condition:
+			{
+				bool conditionValue = false;
+				if (element.value[0] == '+')
+				{
+					string tag = element.value.substr(1);
+					string const* value = lookup(tag, _listElement);
+					assertThrow(
+						value,
+						WhiskersError, "Tag " + tag + " used as condition but was not set."
+					);
+					conditionValue = !value->empty();
+				}
+				else
+				{
+					auto condition = m_conditions.find(element.value);
+					assertThrow(
+						condition != m_conditions.end(),
+						WhiskersError, "Condition parameter " + element.value + " not set."
+					);
+					conditionValue = condition->second;
+				}
+				if (conditionValue)
+					render(*element.body, _listElement);
+				else if (element.elseBody)
+					render(*element.elseBody, _listElement);
+				break;
+			}
+			}
+	}
+
+private:
+	string const* lookup(string const& _name, Whiskers::StringMap const* _listElement) const
+	{
+		if (_listElement)
+			if (auto it = _listElement->find(_name); it != _listElement->end())
+				return &it->second;
+		if (auto it = m_parameters.find(_name); it != m_parameters.end())
+			return &it->second;
+		return nullptr;
+	}
+
+	Whiskers::StringMap const& m_parameters;
+	map<string, bool> const& m_conditions;
+	Whiskers::StringListMap const& m_listParameters;
+	string& m_output;
+};
+
+}
+
 Whiskers::Whiskers(string _template):
 	m_template(move(_template))
 {
@@ -71,14 +332,16 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	string result;
+	result.reserve(m_template.size());
+	TemplateRenderer{m_parameters, m_conditions, m_listParameters, result}.render(*cachedParsedTemplate(m_template));
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -115,116 +378,3 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 		);
 	}
 }
-
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
-{
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
-
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
-{
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				string tag = conditionName.substr(1);
-				assertThrow(
-					_parameters.count(tag),
-					WhiskersError, "Tag " + tag + " used as condition but was not set."
-				);
-				conditionValue = !_parameters.at(tag).empty();
-			}
-			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
-}
-
@@ -26,8 +26,8 @@
 
 #include <libsolutil/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <string>
 #include <vector>
 
 namespace solidity::util
@@ -66,6 +66,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *  - List parameter: <#list>...</list>
  *    The part between the tags is repeated as often as values are provided
  *    in the mapping. Each list element can have its own parameter -> value mapping.
+ *
+ * Templates are parsed once per distinct template string and the parsed form is cached
+ * for the lifetime of the process, so they should not be built from dynamic data.
  */
 class Whiskers
 {
@@ -100,18 +103,6 @@ private:
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
 	std::string m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
@@ -60,10 +60,10 @@ T AsmJsonImporter::createAsmNode(Json::Value const& _node)
 	return r;
 }
 
-Json::Value AsmJsonImporter::member(Json::Value const& _node, string const& _name)
+Json::Value const& AsmJsonImporter::member(Json::Value const& _node, string const& _name)
 {
 	if (!_node.isMember(_name))
-		return Json::nullValue;
+		return Json::Value::nullSingleton();
 	return _node[_name];
 }
 
@@ -77,7 +77,7 @@ TypedName AsmJsonImporter::createTypedName(Json::Value const& _node)
 
 Statement AsmJsonImporter::createStatement(Json::Value const& _node)
 {
-	Json::Value jsonNodeType = member(_node, "nodeType");
+	Json::Value const& jsonNodeType = member(_node, "nodeType");
 	yulAssert(jsonNodeType.isString(), "Expected \"nodeType\" to be of type string!");
 	string nodeType = jsonNodeType.asString();
 
@@ -112,7 +112,7 @@ Statement AsmJsonImporter::createStatement(Json::Value const& _node)
 
 Expression AsmJsonImporter::createExpression(Json::Value const& _node)
 {
-	Json::Value jsonNodeType = member(_node, "nodeType");
+	Json::Value const& jsonNodeType = member(_node, "nodeType");
 	yulAssert(jsonNodeType.isString(), "Expected \"nodeType\" to be of type string!");
 	string nodeType = jsonNodeType.asString();
 
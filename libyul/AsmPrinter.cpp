@@ -28,12 +28,8 @@
 
 #include <libsolutil/CommonData.h>
 
-#include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string/replace.hpp>
-#include <boost/range/adaptor/transformed.hpp>
-
-#include <memory>
-#include <functional>
+#include <optional>
+#include <type_traits>
 
 using namespace std;
 using namespace solidity;
@@ -42,188 +38,349 @@ using namespace solidity::yul;
 
 //@TODO source locations
 
-string AsmPrinter::operator()(Literal const& _literal) const
+/**
+ * Writes the textual form of AST nodes into a single buffer. Line breaks are followed
+ * by the indentation of the innermost enclosing block.
+ *
+ * Whether a node is printed on a single line depends on the length of its parts. To decide this,
+ * the parts are formatted into a separate buffer with a length limit, where formatting stops
+ * as soon as the limit is exceeded or a line break would be written. Because of that, the
+ * decisions only take time proportional to the limits and not to the size of the parts.
+ */
+class AsmPrinter::Formatter
+{
+public:
+	Formatter(AsmPrinter const& _printer, string& _out, size_t _indentation, optional<size_t> _limit = nullopt):
+		m_printer(_printer),
+		m_out(_out),
+		m_indentation(_indentation),
+		m_limit(_limit)
+	{}
+
+	void operator()(Literal const& _literal);
+	void operator()(Identifier const& _identifier);
+	void operator()(ExpressionStatement const& _statement);
+	void operator()(Assignment const& _assignment);
+	void operator()(VariableDeclaration const& _variableDeclaration);
+	void operator()(FunctionDefinition const& _functionDefinition);
+	void operator()(FunctionCall const& _functionCall);
+	void operator()(If const& _if);
+	void operator()(Switch const& _switch);
+	void operator()(ForLoop const& _forLoop);
+	void operator()(Break const&) { write("break"); }
+	void operator()(Continue const&) { write("continue"); }
+	void operator()(Leave const&) { write("leave"); }
+	void operator()(Block const& _block);
+
+private:
+	/// Blocks consisting of a single statement shorter than this are printed on one line.
+	static size_t constexpr maxInlineStatementLength = 29;
+	/// The three parts of a for loop header are printed on one line if their total length is below this.
+	static size_t constexpr maxForLoopHeaderLength = 59;
+
+	/// @returns the length of @a _node if it is printed on a single line of at most @a _limit characters
+	/// and nullopt otherwise.
+	template <typename Node>
+	optional<size_t> lineLength(Node const& _node, size_t _limit) const
+	{
+		string line;
+		Formatter formatter{m_printer, line, 0, _limit};
+		formatter.visit(_node);
+		if (formatter.m_exceeded)
+			return nullopt;
+		return line.size();
+	}
+	bool fitsOnLine(Block const& _block) const
+	{
+		return
+			_block.statements.empty() ||
+			(_block.statements.size() == 1 && lineLength(_block.statements.front(), maxInlineStatementLength));
+	}
+
+	/// Formats @a _node unless the limit is already exceeded.
+	template <typename Node>
+	void visit(Node const& _node)
+	{
+		if (m_exceeded)
+			return;
+		if constexpr (std::is_same_v<Node, Expression> || std::is_same_v<Node, Statement>)
+			std::visit(*this, _node);
+		else
+			(*this)(_node);
+	}
+
+	void write(string const& _text)
+	{
+		if (m_exceeded)
+			return;
+		m_out += _text;
+		if (m_limit && m_out.size() > *m_limit)
+			m_exceeded = true;
+	}
+	void newLine()
+	{
+		if (m_limit)
+			m_exceeded = true;
+		else
+		{
+			m_out += '\n';
+			m_out.append(m_indentation, ' ');
+		}
+	}
+	void writeTypedName(TypedName const& _variable);
+	void writeTypedNames(vector<TypedName> const& _variables);
+	void writeTypeName(YulString _type, bool _isBoolLiteral = false);
+
+	AsmPrinter const& m_printer;
+	string& m_out;
+	size_t m_indentation = 0;
+	/// Maximum length of the output when formatting a single line.
+	optional<size_t> m_limit;
+	/// Set if the output exceeds the limit or contains a line break when formatting a single line.
+	bool m_exceeded = false;
+};
+
+void AsmPrinter::Formatter::operator()(Literal const& _literal)
 {
 	switch (_literal.kind)
 	{
 	case LiteralKind::Number:
 		yulAssert(isValidDecimal(_literal.value.str()) || isValidHex(_literal.value.str()), "Invalid number literal");
-		return _literal.value.str() + appendTypeName(_literal.type);
+		write(_literal.value.str());
+		writeTypeName(_literal.type);
+		return;
 	case LiteralKind::Boolean:
 		yulAssert(_literal.value == "true"_yulstring || _literal.value == "false"_yulstring, "Invalid bool literal.");
-		return ((_literal.value == "true"_yulstring) ? "true" : "false") + appendTypeName(_literal.type, true);
+		write((_literal.value == "true"_yulstring) ? "true" : "false");
+		writeTypeName(_literal.type, true);
+		return;
 	case LiteralKind::String:
 		break;
 	}
 
-	return escapeAndQuoteString(_literal.value.str()) + appendTypeName(_literal.type);
+	write(escapeAndQuoteString(_literal.value.str()));
+	writeTypeName(_literal.type);
 }
 
-string AsmPrinter::operator()(Identifier const& _identifier) const
+void AsmPrinter::Formatter::operator()(Identifier const& _identifier)
 {
 	yulAssert(!_identifier.name.empty(), "Invalid identifier.");
-	return _identifier.name.str();
+	write(_identifier.name.str());
 }
 
-string AsmPrinter::operator()(ExpressionStatement const& _statement) const
+void AsmPrinter::Formatter::operator()(ExpressionStatement const& _statement)
 {
-	return std::visit(*this, _statement.expression);
+	visit(_statement.expression);
 }
 
-string AsmPrinter::operator()(Assignment const& _assignment) const
+void AsmPrinter::Formatter::operator()(Assignment const& _assignment)
 {
 	yulAssert(_assignment.variableNames.size() >= 1, "");
-	string variables = (*this)(_assignment.variableNames.front());
-	for (size_t i = 1; i < _assignment.variableNames.size(); ++i)
-		variables += ", " + (*this)(_assignment.variableNames[i]);
-	return variables + " := " + std::visit(*this, *_assignment.value);
+	for (size_t i = 0; i < _assignment.variableNames.size() && !m_exceeded; ++i)
+	{
+		if (i > 0)
+			write(", ");
+		visit(_assignment.variableNames[i]);
+	}
+	write(" := ");
+	visit(*_assignment.value);
 }
 
-string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration) const
+void AsmPrinter::Formatter::operator()(VariableDeclaration const& _variableDeclaration)
 {
-	string out = "let ";
-	out += boost::algorithm::join(
-		_variableDeclaration.variables | boost::adaptors::transformed(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
+	write("let ");
+	writeTypedNames(_variableDeclaration.variables);
 	if (_variableDeclaration.value)
 	{
-		out += " := ";
-		out += std::visit(*this, *_variableDeclaration.value);
+		write(" := ");
+		visit(*_variableDeclaration.value);
 	}
-	return out;
 }
 
-string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition) const
+void AsmPrinter::Formatter::operator()(FunctionDefinition const& _functionDefinition)
 {
 	yulAssert(!_functionDefinition.name.empty(), "Invalid function name.");
-	string out = "function " + _functionDefinition.name.str() + "(";
-	out += boost::algorithm::join(
-		_functionDefinition.parameters | boost::adaptors::transformed(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
-	out += ")";
+	write("function " + _functionDefinition.name.str() + "(");
+	writeTypedNames(_functionDefinition.parameters);
+	write(")");
 	if (!_functionDefinition.returnVariables.empty())
 	{
-		out += " -> ";
-		out += boost::algorithm::join(
-			_functionDefinition.returnVariables | boost::adaptors::transformed(
-				[this](TypedName argument) { return formatTypedName(argument); }
-			),
-			", "
-		);
+		write(" -> ");
+		writeTypedNames(_functionDefinition.returnVariables);
 	}
-
-	return out + "\n" + (*this)(_functionDefinition.body);
+	newLine();
+	visit(_functionDefinition.body);
 }
 
-string AsmPrinter::operator()(FunctionCall const& _functionCall) const
+void AsmPrinter::Formatter::operator()(FunctionCall const& _functionCall)
 {
-	return
-		(*this)(_functionCall.functionName) + "(" +
-		boost::algorithm::join(
-			_functionCall.arguments | boost::adaptors::transformed([&](auto&& _node) { return std::visit(*this, _node); }),
-			", " ) +
-		")";
+	visit(_functionCall.functionName);
+	write("(");
+	for (size_t i = 0; i < _functionCall.arguments.size() && !m_exceeded; ++i)
+	{
+		if (i > 0)
+			write(", ");
+		visit(_functionCall.arguments[i]);
+	}
+	write(")");
 }
 
-string AsmPrinter::operator()(If const& _if) const
+void AsmPrinter::Formatter::operator()(If const& _if)
 {
 	yulAssert(_if.condition, "Invalid if condition.");
-	string body = (*this)(_if.body);
-	char delim = '\n';
-	if (body.find('\n') == string::npos)
-		delim = ' ';
-	return "if " + std::visit(*this, *_if.condition) + delim + (*this)(_if.body);
+	write("if ");
+	visit(*_if.condition);
+	// When formatting a single line, a body that does not fit exceeds the limit anyway.
+	if (m_limit || fitsOnLine(_if.body))
+		write(" ");
+	else
+		newLine();
+	visit(_if.body);
 }
 
-string AsmPrinter::operator()(Switch const& _switch) const
+void AsmPrinter::Formatter::operator()(Switch const& _switch)
 {
 	yulAssert(_switch.expression, "Invalid expression pointer.");
-	string out = "switch " + std::visit(*this, *_switch.expression);
+	write("switch ");
+	visit(*_switch.expression);
 	for (auto const& _case: _switch.cases)
 	{
+		if (m_exceeded)
+			break;
+		newLine();
 		if (!_case.value)
-			out += "\ndefault ";
+			write("default ");
 		else
-			out += "\ncase " + (*this)(*_case.value) + " ";
-		out += (*this)(_case.body);
+		{
+			write("case ");
+			visit(*_case.value);
+			write(" ");
+		}
+		visit(_case.body);
 	}
-	return out;
 }
 
-string AsmPrinter::operator()(ForLoop const& _forLoop) const
+void AsmPrinter::Formatter::operator()(ForLoop const& _forLoop)
 {
 	yulAssert(_forLoop.condition, "Invalid for loop condition.");
-	string pre = (*this)(_forLoop.pre);
-	string condition = std::visit(*this, *_forLoop.condition);
-	string post = (*this)(_forLoop.post);
-	char delim = '\n';
-	if (
-		pre.size() + condition.size() + post.size() < 60 &&
-		pre.find('\n') == string::npos &&
-		post.find('\n') == string::npos
-	)
-		delim = ' ';
-	return
-		("for " + move(pre) + delim + move(condition) + delim + move(post) + "\n") +
-		(*this)(_forLoop.body);
-}
-
-string AsmPrinter::operator()(Break const&) const
-{
-	return "break";
-}
-
-string AsmPrinter::operator()(Continue const&) const
-{
-	return "continue";
-}
+	if (m_limit)
+	{
+		// The body of a for loop always starts on a new line.
+		m_exceeded = true;
+		return;
+	}
+	optional<size_t> preLength = lineLength(_forLoop.pre, maxForLoopHeaderLength);
+	optional<size_t> conditionLength = lineLength(*_forLoop.condition, maxForLoopHeaderLength);
+	optional<size_t> postLength = lineLength(_forLoop.post, maxForLoopHeaderLength);
+	bool singleLine =
+		preLength && conditionLength && postLength &&
+		*preLength + *conditionLength + *postLength <= maxForLoopHeaderLength;
 
-string AsmPrinter::operator()(Leave const&) const
-{
-	return "leave";
+	write("for ");
+	visit(_forLoop.pre);
+	singleLine ? write(" ") : newLine();
+	visit(*_forLoop.condition);
+	singleLine ? write(" ") : newLine();
+	visit(_forLoop.post);
+	newLine();
+	visit(_forLoop.body);
 }
 
-string AsmPrinter::operator()(Block const& _block) const
+void AsmPrinter::Formatter::operator()(Block const& _block)
 {
 	if (_block.statements.empty())
-		return "{ }";
-	string body = boost::algorithm::join(
-		_block.statements | boost::adaptors::transformed([&](auto&& _node) { return std::visit(*this, _node); }),
-		"\n"
-	);
-	if (body.size() < 30 && body.find('\n') == string::npos)
-		return "{ " + body + " }";
+		write("{ }");
+	else if (m_limit)
+	{
+		// When formatting a single line, only check that the statement is short enough.
+		if (_block.statements.size() > 1)
+		{
+			m_exceeded = true;
+			return;
+		}
+		write("{ ");
+		size_t const start = m_out.size();
+		visit(_block.statements.front());
+		if (m_out.size() - start > maxInlineStatementLength)
+			m_exceeded = true;
+		write(" }");
+	}
+	else if (fitsOnLine(_block))
+	{
+		write("{ ");
+		visit(_block.statements.front());
+		write(" }");
+	}
 	else
 	{
-		boost::replace_all(body, "\n", "\n    ");
-		return "{\n    " + body + "\n}";
+		write("{");
+		m_indentation += 4;
+		for (auto const& statement: _block.statements)
+		{
+			newLine();
+			visit(statement);
+		}
+		m_indentation -= 4;
+		newLine();
+		write("}");
 	}
 }
 
-string AsmPrinter::formatTypedName(TypedName _variable) const
+void AsmPrinter::Formatter::writeTypedName(TypedName const& _variable)
 {
 	yulAssert(!_variable.name.empty(), "Invalid variable name.");
-	return _variable.name.str() + appendTypeName(_variable.type);
+	write(_variable.name.str());
+	writeTypeName(_variable.type);
 }
 
-string AsmPrinter::appendTypeName(YulString _type, bool _isBoolLiteral) const
+void AsmPrinter::Formatter::writeTypedNames(vector<TypedName> const& _variables)
 {
-	if (m_dialect && !_type.empty())
+	for (size_t i = 0; i < _variables.size() && !m_exceeded; ++i)
 	{
-		if (!_isBoolLiteral && _type == m_dialect->defaultType)
+		if (i > 0)
+			write(", ");
+		writeTypedName(_variables[i]);
+	}
+}
+
+void AsmPrinter::Formatter::writeTypeName(YulString _type, bool _isBoolLiteral)
+{
+	if (Dialect const* dialect = m_printer.m_dialect; dialect && !_type.empty())
+	{
+		if (!_isBoolLiteral && _type == dialect->defaultType)
 			_type = {};
-		else if (_isBoolLiteral && _type == m_dialect->boolType && !m_dialect->defaultType.empty())
+		else if (_isBoolLiteral && _type == dialect->boolType && !dialect->defaultType.empty())
 			// Special case: If we have a bool type but empty default type, do not remove the type.
 			_type = {};
 	}
-	if (_type.empty())
-		return {};
-	else
-		return ":" + _type.str();
+	if (!_type.empty())
+		write(":" + _type.str());
+}
+
+template <typename Node>
+string AsmPrinter::format(Node const& _node) const
+{
+	string out;
+	Formatter{*this, out, 0}(_node);
+	return out;
+}
+
+string AsmPrinter::operator()(Literal const& _literal) const { return format(_literal); }
+string AsmPrinter::operator()(Identifier const& _identifier) const { return format(_identifier); }
+string AsmPrinter::operator()(ExpressionStatement const& _statement) const { return format(_statement); }
+string AsmPrinter::operator()(Assignment const& _assignment) const { return format(_assignment); }
+string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration) const { return format(_variableDeclaration); }
+string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition) const { return format(_functionDefinition); }
+string AsmPrinter::operator()(FunctionCall const& _functionCall) const { return format(_functionCall); }
+string AsmPrinter::operator()(If const& _if) const { return format(_if); }
+string AsmPrinter::operator()(Switch const& _switch) const { return format(_switch); }
+string AsmPrinter::operator()(ForLoop const& _forLoop) const { return format(_forLoop); }
+string AsmPrinter::operator()(Break const& _break) const { return format(_break); }
+string AsmPrinter::operator()(Continue const& _continue) const { return format(_continue); }
+string AsmPrinter::operator()(Leave const& _leave) const { return format(_leave); }
+string AsmPrinter::operator()(Block const& _block) const { return format(_block); }
+
+void AsmPrinter::appendTo(string& _out, Block const& _block, size_t _indentation) const
+{
+	Formatter{*this, _out, _indentation}(_block);
 }
@@ -27,6 +27,8 @@
 
 #include <libyul/YulString.h>
 
+#include <string>
+
 namespace solidity::yul
 {
 struct Dialect;
@@ -35,6 +37,8 @@ struct Dialect;
  * Converts a parsed Yul AST into readable string representation.
  * Ignores source locations.
  * If a dialect is provided, the dialect's default type is omitted.
+ * The output is written into a single buffer, so the time needed is linear in its size
+ * even for deeply nested code.
  */
 class AsmPrinter
 {
@@ -57,9 +61,15 @@ public:
 	std::string operator()(Leave const& _continue) const;
 	std::string operator()(Block const& _block) const;
 
+	/// Appends the textual representation of @a _block to @a _out.
+	/// All lines but the first are indented by @a _indentation spaces.
+	void appendTo(std::string& _out, Block const& _block, size_t _indentation = 0) const;
+
 private:
-	std::string formatTypedName(TypedName _variable) const;
-	std::string appendTypeName(YulString _type, bool _isBoolLiteral = false) const;
+	class Formatter;
+
+	template <typename Node>
+	std::string format(Node const& _node) const;
 
 	Dialect const* m_dialect = nullptr;
 };
@@ -25,6 +25,7 @@
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AST.h>
 #include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/backends/evm/AsmCodeGen.h>
@@ -36,6 +37,7 @@
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/wasm/WasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/ObjectParser.h>
 #include <libyul/optimiser/Suite.h>
@@ -43,13 +45,113 @@
 #include <libsolidity/interface/OptimiserSettings.h>
 
 #include <libevmasm/Assembly.h>
+#include <libevmasm/GasMeter.h>
 #include <liblangutil/Scanner.h>
 
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// Appends @a _object and all its sub-objects to @a _objects, together with whether
+/// they are creation objects. Sub-objects come before the objects containing them.
+void collectObjects(Object& _object, bool _isCreation, vector<pair<Object*, bool>>& _objects)
+{
+	for (auto& subNode: _object.subObjects)
+		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+			collectObjects(*subObject, false, _objects);
+	_objects.emplace_back(&_object, _isCreation);
+}
+
+/// @returns the costs of executing @a _instruction once, only counting the fixed part of the costs
+/// of instructions whose costs depend on their arguments or the state.
+unsigned instructionCosts(evmasm::Instruction _instruction, langutil::EVMVersion _evmVersion)
+{
+	switch (_instruction)
+	{
+	case evmasm::Instruction::JUMPDEST:
+		return evmasm::GasCosts::jumpdestGas;
+	case evmasm::Instruction::EXP:
+		return evmasm::GasCosts::expGas;
+	case evmasm::Instruction::KECCAK256:
+		return evmasm::GasCosts::keccak256Gas;
+	case evmasm::Instruction::SLOAD:
+		return evmasm::GasCosts::sloadGas(_evmVersion);
+	case evmasm::Instruction::SSTORE:
+		return evmasm::GasCosts::sstoreResetGas;
+	case evmasm::Instruction::LOG0:
+	case evmasm::Instruction::LOG1:
+	case evmasm::Instruction::LOG2:
+	case evmasm::Instruction::LOG3:
+	case evmasm::Instruction::LOG4:
+		return evmasm::GasCosts::logGas + evmasm::GasCosts::logTopicGas * getLogNumber(_instruction);
+	case evmasm::Instruction::CREATE:
+	case evmasm::Instruction::CREATE2:
+		return evmasm::GasCosts::createGas;
+	case evmasm::Instruction::CALL:
+	case evmasm::Instruction::CALLCODE:
+	case evmasm::Instruction::DELEGATECALL:
+	case evmasm::Instruction::STATICCALL:
+		return evmasm::GasCosts::callGas(_evmVersion);
+	case evmasm::Instruction::SELFDESTRUCT:
+		return evmasm::GasCosts::selfdestructGas(_evmVersion);
+	default:
+		return evmasm::GasMeter::runGas(_instruction);
+	}
+}
+
+/// @returns the estimated costs of deploying and running the code of @a _object, combined as by
+/// the GasMeter: the run gas of all instructions, each as if executed @a _runs times, plus the gas
+/// for the bytecode. The sub-objects are replaced by empty data, since the costs are only compared
+/// between versions of the same object. @returns nullopt if the code cannot be compiled.
+optional<bigint> estimatedCosts(
+	Object const& _object,
+	EVMDialect const& _dialect,
+	bool _isCreation,
+	bool _optimizeStackAllocation,
+	size_t _runs,
+	bool _useSubroutines
+)
+{
+	Object object = _object;
+	for (auto& subNode: object.subObjects)
+		subNode = make_shared<Data>(subNode->name, bytes{});
+
+	evmasm::Assembly assembly;
+	EthAssemblyAdapter adapter(assembly);
+	try
+	{
+		EVMObjectCompiler::compile(object, adapter, _dialect, false, _optimizeStackAllocation, _runs, _useSubroutines);
+	}
+	catch (yul::StackTooDeepError const&)
+	{
+		return nullopt;
+	}
+
+	bigint runGas = 0;
+	for (evmasm::AssemblyItem const& item: assembly.items())
+		if (item.type() == evmasm::Operation)
+			runGas += instructionCosts(item.instruction(), _dialect.evmVersion());
+		else if (item.type() == evmasm::Tag)
+		{
+			// JUMPSUB continues after the BEGINSUB of a subroutine entry.
+			if (!item.isSubroutineEntry())
+				runGas += instructionCosts(evmasm::Instruction::JUMPDEST, _dialect.evmVersion());
+		}
+		else
+			runGas += instructionCosts(evmasm::Instruction::PUSH1, _dialect.evmVersion());
+	bytes const bytecode = assembly.assemble().bytecode;
+	return runGas * _runs + evmasm::GasMeter::dataGas(bytecode, _isCreation, _dialect.evmVersion());
+}
+
+}
+
 namespace
 {
 Dialect const& languageToDialect(AssemblyStack::Language _language, EVMVersion _version)
@@ -91,6 +193,11 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	return analyzeParsed();
 }
 
+void AssemblyStack::setParallelism(size_t _parallelism)
+{
+	m_parallelism = _parallelism == 0 ? util::ThreadPool::hardwareConcurrency() : _parallelism;
+}
+
 void AssemblyStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -100,8 +207,44 @@ void AssemblyStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
-	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
+
+	vector<pair<Object*, bool>> objects;
+	collectObjects(*m_parserResult, true, objects);
+	m_optimisationIncomplete = false;
+	if (m_parallelism > 1 && objects.size() > 1)
+	{
+		// Optimising an object only reads the names of its sub-objects, so all objects
+		// can be optimised concurrently. Exceptions are rethrown in sequential order.
+		// The remaining threads are used to optimise the functions inside the objects.
+		vector<exception_ptr> failures(objects.size());
+		vector<uint8_t> completed(objects.size(), true);
+		util::ThreadPool pool{min(m_parallelism, objects.size())};
+		size_t threadsPerObject = max<size_t>(1, m_parallelism / pool.threadCount());
+		for (size_t i = 0; i < objects.size(); ++i)
+			pool.post([&, i] {
+				try
+				{
+					completed[i] = optimize(*objects[i].first, objects[i].second, threadsPerObject);
+				}
+				catch (...)
+				{
+					failures[i] = current_exception();
+				}
+			});
+		pool.wait();
+		for (exception_ptr const& failure: failures)
+			if (failure)
+				rethrow_exception(failure);
+		m_optimisationIncomplete = find(completed.begin(), completed.end(), false) != completed.end();
+	}
+	else
+		for (auto const& [object, isCreation]: objects)
+			if (!optimize(*object, isCreation, m_parallelism))
+				m_optimisationIncomplete = true;
+
+	// The optimiser suite already re-analyses every object it transforms and asserts
+	// that the result is valid, so there is no need to analyse the whole tree again.
+	m_analysisSuccessful = true;
 }
 
 void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
@@ -165,27 +308,107 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _o
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize);
+	util::ProfilerScope profilerScope{"Yul code generation"};
+	EVMObjectCompiler::compile(
+		*m_parserResult,
+		_assembly,
+		*dialect,
+		_evm15,
+		_optimize,
+		m_optimiserSettings.expectedExecutionsPerDeployment,
+		m_optimiserSettings.useSubroutines && m_evmVersion.hasSubroutines()
+	);
 }
 
-void AssemblyStack::optimize(Object& _object, bool _isCreation)
+bool AssemblyStack::optimize(Object& _object, bool _isCreation, size_t _parallelism)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
-	for (auto& subNode: _object.subObjects)
-		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject, false);
+	util::TraceScope traceScope{"Yul object", _object.name.str()};
 
+	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect);
+	// The costs of the candidates are estimated from their bytecode, so the
+	// alternative sequences are only used when compiling to EVM.
+	if (m_optimiserSettings.yulOptimiserAlternativeSteps.empty() || !evmDialect)
+		return runOptimiserSuite(_object, _isCreation, m_optimiserSettings.yulOptimiserSteps, _parallelism);
+
+	vector<string> sequences{m_optimiserSettings.yulOptimiserSteps};
+	sequences += m_optimiserSettings.yulOptimiserAlternativeSteps;
+	vector<Object> candidates;
+	for (size_t i = 0; i < sequences.size(); ++i)
+	{
+		Object& candidate = candidates.emplace_back(_object);
+		candidate.code = make_shared<Block>(std::get<Block>(ASTCopier{}(*_object.code)));
+		candidate.analysisInfo = make_shared<AsmAnalysisInfo>(AsmAnalyzer::analyzeStrictAssertCorrect(dialect, candidate));
+	}
+
+	// Every candidate is optimised and measured on its own, so they can be processed concurrently.
+	// The result does not depend on the order, since ties are resolved by the order of the sequences.
+	vector<optional<bigint>> costs(candidates.size());
+	vector<uint8_t> completed(candidates.size(), true);
+	vector<exception_ptr> failures(candidates.size());
+	auto processCandidate = [&](size_t _index, size_t _threads) {
+		try
+		{
+			completed[_index] = runOptimiserSuite(candidates[_index], _isCreation, sequences[_index], _threads);
+			costs[_index] = estimatedCosts(
+				candidates[_index],
+				*evmDialect,
+				_isCreation,
+				m_optimiserSettings.optimizeStackAllocation,
+				m_optimiserSettings.expectedExecutionsPerDeployment,
+				m_optimiserSettings.useSubroutines && m_evmVersion.hasSubroutines()
+			);
+		}
+		catch (...)
+		{
+			failures[_index] = current_exception();
+		}
+	};
+	if (_parallelism > 1)
+	{
+		util::ThreadPool pool{min(_parallelism, candidates.size())};
+		size_t threadsPerCandidate = max<size_t>(1, _parallelism / pool.threadCount());
+		for (size_t i = 0; i < candidates.size(); ++i)
+			pool.post([&, i] { processCandidate(i, threadsPerCandidate); });
+		pool.wait();
+	}
+	else
+		for (size_t i = 0; i < candidates.size(); ++i)
+			processCandidate(i, 1);
+	for (exception_ptr const& failure: failures)
+		if (failure)
+			rethrow_exception(failure);
+
+	// Candidates that cannot be compiled are only chosen if none can, in which case the
+	// result of the main sequence is kept, so that code generation reports the error.
+	size_t best = 0;
+	for (size_t i = 1; i < candidates.size(); ++i)
+		if (costs[i] && (!costs[best] || *costs[i] < *costs[best]))
+			best = i;
+	_object.code = candidates[best].code;
+	_object.analysisInfo = candidates[best].analysisInfo;
+	return completed[best];
+}
+
+bool AssemblyStack::runOptimiserSuite(Object& _object, bool _isCreation, string const& _sequence, size_t _parallelism)
+{
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
-	OptimiserSuite::run(
+	return OptimiserSuite::run(
 		dialect,
 		meter.get(),
 		_object,
 		m_optimiserSettings.optimizeStackAllocation,
-		m_optimiserSettings.yulOptimiserSteps
+		_sequence,
+		{},
+		_parallelism,
+		m_optimiserSettings.yulOptimiserGasCosts,
+		m_optimiserSettings.reasoningMaxQueries,
+		m_optimiserSettings.workBudget
 	);
 }
 
@@ -266,11 +489,44 @@ pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleAndGue
 
 }
 
+pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleDirectlyAndGuessRuntime() const
+{
+	yulAssert(m_analysisSuccessful, "");
+	yulAssert(m_parserResult, "");
+	yulAssert(m_parserResult->code, "");
+	yulAssert(m_parserResult->analysisInfo, "");
+
+	EVMAssembly assembly;
+	compileEVM(assembly, false, m_optimiserSettings.optimizeStackAllocation);
+
+	MachineAssemblyObject creationObject;
+	creationObject.bytecode = make_shared<evmasm::LinkerObject>(assembly.finalize());
+	yulAssert(creationObject.bytecode->immutableReferences.empty(), "Leftover immutables.");
+	creationObject.sourceMappings = make_unique<string>(
+		evmasm::AssemblyItem::compressSourceMapping(assembly.sourceMapping())
+	);
+
+	MachineAssemblyObject runtimeObject;
+	// Heuristic: If there is a single sub-assembly, this is likely the runtime object.
+	if (assembly.numSubAssemblies() == 1)
+	{
+		EVMAssembly& runtimeAssembly = assembly.firstSubAssembly();
+		runtimeObject.bytecode = make_shared<evmasm::LinkerObject>(runtimeAssembly.finalize());
+		runtimeObject.sourceMappings = make_unique<string>(
+			evmasm::AssemblyItem::compressSourceMapping(runtimeAssembly.sourceMapping())
+		);
+	}
+	return {std::move(creationObject), std::move(runtimeObject)};
+}
+
 string AssemblyStack::print() const
 {
 	yulAssert(m_parserResult, "");
 	yulAssert(m_parserResult->code, "");
-	return m_parserResult->toString(&languageToDialect(m_language, m_evmVersion)) + "\n";
+	string out;
+	m_parserResult->print(out, &languageToDialect(m_language, m_evmVersion));
+	out += "\n";
+	return out;
 }
 
 shared_ptr<Object> AssemblyStack::parserResult() const
@@ -79,9 +79,16 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Sets the maximum number of threads used to optimise the objects, sub-objects and functions concurrently.
+	/// Zero selects the number of hardware threads. The result does not depend on this setting.
+	void setParallelism(size_t _parallelism);
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
+	/// @returns true if the work budget of the optimiser was exhausted for any object
+	/// during the last call to optimize().
+	bool optimisationIncomplete() const { return m_optimisationIncomplete; }
 
 	/// Translate the source to a different language / dialect.
 	void translate(Language _targetLanguage);
@@ -95,6 +102,12 @@ public:
 	/// Only available for EVM.
 	std::pair<MachineAssemblyObject, MachineAssemblyObject> assembleAndGuessRuntime() const;
 
+	/// Same as @a assembleAndGuessRuntime, but emits the bytecode directly instead of
+	/// building an evmasm::Assembly first. Only the bytecode and the source mappings of the
+	/// returned objects are set.
+	/// Only available for EVM.
+	std::pair<MachineAssemblyObject, MachineAssemblyObject> assembleDirectlyAndGuessRuntime() const;
+
 	/// @returns the errors generated during parsing, analysis (and potentially assembly).
 	langutil::ErrorList const& errors() const { return m_errors; }
 
@@ -110,15 +123,23 @@ private:
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _evm15, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimises the code of @a _object, but not the code of its sub-objects, using up to
+	/// @a _parallelism threads for independent functions or alternative step sequences.
+	/// @returns false if the work budget of the optimiser was exhausted.
+	bool optimize(yul::Object& _object, bool _isCreation, size_t _parallelism);
+	/// Runs the optimiser suite with the step sequence @a _sequence on @a _object.
+	/// @returns false if the work budget of the optimiser was exhausted.
+	bool runOptimiserSuite(yul::Object& _object, bool _isCreation, std::string const& _sequence, size_t _parallelism);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
+	size_t m_parallelism = 1;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
 
 	bool m_analysisSuccessful = false;
+	bool m_optimisationIncomplete = false;
 	std::shared_ptr<yul::Object> m_parserResult;
 	langutil::ErrorList m_errors;
 	langutil::ErrorReporter m_errorReporter;
@@ -22,10 +22,13 @@
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AST.h>
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
+#include <libyul/optimiser/ASTCopier.h>
+
 #include <liblangutil/EVMVersion.h>
 
 using namespace std;
@@ -33,38 +36,89 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+namespace
+{
+
+/// @returns a copy of the grouped code @a _code that contains the outermost block only if
+/// @a _functionNames contains the empty name and the bodies of the functions in @a _functionNames.
+/// All other functions are kept with an empty body, so that calls to them can still be compiled.
+Block codeOfFunctions(Block const& _code, set<YulString> const& _functionNames)
+{
+	yulAssert(
+		!_code.statements.empty() && holds_alternative<Block>(_code.statements.front()),
+		"Need to run the function grouper before checking single functions."
+	);
+	Block result{_code.location, {}};
+	result.statements.reserve(_code.statements.size());
+	if (_functionNames.count({}))
+		result.statements.emplace_back(ASTCopier{}.translate(_code.statements.front()));
+	else
+		result.statements.emplace_back(Block{});
+	for (size_t i = 1; i < _code.statements.size(); ++i)
+	{
+		auto const& function = std::get<FunctionDefinition>(_code.statements[i]);
+		if (_functionNames.count(function.name))
+			result.statements.emplace_back(ASTCopier{}.translate(_code.statements[i]));
+		else
+			result.statements.emplace_back(FunctionDefinition{
+				function.location,
+				function.name,
+				function.parameters,
+				function.returnVariables,
+				Block{function.body.location, {}}
+			});
+	}
+	return result;
+}
+
+}
+
 CompilabilityChecker::CompilabilityChecker(
 	Dialect const& _dialect,
 	Object const& _object,
-	bool _optimizeStackAllocation
+	bool _optimizeStackAllocation,
+	optional<set<YulString>> const& _functionsToCheck
 )
 {
 	if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect))
 	{
 		NoOutputEVMDialect noOutputDialect(*evmDialect);
 
+		Object const* object = &_object;
+		Object reducedObject;
+		if (_functionsToCheck)
+		{
+			reducedObject = _object;
+			reducedObject.code = make_shared<Block>(codeOfFunctions(*_object.code, *_functionsToCheck));
+			reducedObject.analysisInfo.reset();
+			object = &reducedObject;
+		}
+
 		yul::AsmAnalysisInfo analysisInfo =
-			yul::AsmAnalyzer::analyzeStrictAssertCorrect(noOutputDialect, _object);
+			yul::AsmAnalyzer::analyzeStrictAssertCorrect(noOutputDialect, *object);
 
 		BuiltinContext builtinContext;
-		builtinContext.currentObject = &_object;
-		if (!_object.name.empty())
-			builtinContext.subIDs[_object.name] = 1;
-		for (auto const& subNode: _object.subObjects)
+		builtinContext.currentObject = object;
+		if (!object->name.empty())
+			builtinContext.subIDs[object->name] = 1;
+		for (auto const& subNode: object->subObjects)
 			builtinContext.subIDs[subNode->name] = 1;
 		NoOutputAssembly assembly;
 		CodeTransform transform(
 			assembly,
 			analysisInfo,
-			*_object.code,
+			*object->code,
 			noOutputDialect,
 			builtinContext,
 			_optimizeStackAllocation
 		);
-		transform(*_object.code);
+		transform(*object->code);
 
 		for (StackTooDeepError const& error: transform.stackErrors())
 		{
+			// Functions outside of the checked ones can still fail due to their signature.
+			if (_functionsToCheck && !_functionsToCheck->count(error.functionName))
+				continue;
 			unreachableVariables[error.functionName].emplace(error.variable);
 			int& deficit = stackDeficit[error.functionName];
 			deficit = std::max(error.depth, deficit);
@@ -27,6 +27,8 @@
 
 #include <map>
 #include <memory>
+#include <optional>
+#include <set>
 
 namespace solidity::yul
 {
@@ -41,10 +43,20 @@ namespace solidity::yul
  * functions are not nested. Otherwise, it might miss reporting some functions.
  *
  * Only checks the code of the object itself, does not descend into sub-objects.
+ *
+ * If @a _functionsToCheck is provided, only the functions with these names are checked
+ * and the outermost block only if it contains the empty name. This requires the code
+ * to be grouped by the FunctionGrouper. Since the functions are compiled independently,
+ * the result for these functions is the same as the one of a check of the whole object.
  */
 struct CompilabilityChecker
 {
-	CompilabilityChecker(Dialect const& _dialect, Object const& _object, bool _optimizeStackAllocation);
+	CompilabilityChecker(
+		Dialect const& _dialect,
+		Object const& _object,
+		bool _optimizeStackAllocation,
+		std::optional<std::set<YulString>> const& _functionsToCheck = std::nullopt
+	);
 	std::map<YulString, std::set<YulString>> unreachableVariables;
 	std::map<YulString, int> stackDeficit;
 };
@@ -41,7 +41,10 @@ struct AsmAnalysisInfo;
 struct ObjectNode
 {
 	virtual ~ObjectNode() = default;
-	virtual std::string toString(Dialect const* _dialect) const = 0;
+	/// Appends the (parseable) string representation to @a _out. All lines but the first
+	/// are indented by @a _indentation spaces. Omits the default type of @a _dialect if it is set.
+	virtual void print(std::string& _out, Dialect const* _dialect, size_t _indentation = 0) const = 0;
+	std::string toString(Dialect const* _dialect) const;
 	std::string toString() { return toString(nullptr); }
 
 	/// Name of the object.
@@ -51,13 +54,16 @@ struct ObjectNode
 
 /**
  * Named data in Yul objects.
+ * The payload is immutable and shared, so that copies of objects and data nodes
+ * with the same content do not duplicate it.
  */
 struct Data: ObjectNode
 {
-	Data(YulString _name, bytes _data): data(std::move(_data)) { name = _name; }
-	std::string toString(Dialect const* _dialect) const override;
+	Data(YulString _name, bytes _data): Data(_name, std::make_shared<bytes const>(std::move(_data))) {}
+	Data(YulString _name, std::shared_ptr<bytes const> _data): data(std::move(_data)) { name = _name; }
+	void print(std::string& _out, Dialect const* _dialect, size_t _indentation = 0) const override;
 
-	bytes data;
+	std::shared_ptr<bytes const> data;
 };
 
 /**
@@ -66,8 +72,7 @@ struct Data: ObjectNode
 struct Object: ObjectNode
 {
 public:
-	/// @returns a (parseable) string representation. Includes types if @a _yul is set.
-	std::string toString(Dialect const* _dialect) const override;
+	void print(std::string& _out, Dialect const* _dialect, size_t _indentation = 0) const override;
 
 	/// @returns the set of names of data objects accessible from within the code of
 	/// this object, including the name of object itself
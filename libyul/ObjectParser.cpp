@@ -27,6 +27,8 @@
 
 #include <liblangutil/Token.h>
 
+#include <libsolutil/Keccak256.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -126,7 +128,11 @@ void ObjectParser::parseData(Object& _containingObject)
 		expectToken(Token::HexStringLiteral, false);
 	else
 		expectToken(Token::StringLiteral, false);
-	addNamedSubObject(_containingObject, name, make_shared<Data>(name, asBytes(currentLiteral())));
+	// Identical payloads, e.g. the same bytecode embedded into several objects, share one buffer.
+	shared_ptr<bytes const>& buffer = m_dataBuffers[util::keccak256(currentLiteral())];
+	if (!buffer)
+		buffer = make_shared<bytes const>(asBytes(currentLiteral()));
+	addNamedSubObject(_containingObject, name, make_shared<Data>(name, buffer));
 	advance();
 }
 
@@ -29,7 +29,9 @@
 #include <liblangutil/ParserBase.h>
 
 #include <libsolutil/Common.h>
+#include <libsolutil/FixedHash.h>
 
+#include <map>
 #include <memory>
 
 namespace solidity::langutil
@@ -66,6 +68,8 @@ private:
 	void addNamedSubObject(Object& _container, YulString _name, std::shared_ptr<ObjectNode> _subObject);
 
 	Dialect const& m_dialect;
+	/// Payloads of the data sections parsed so far, indexed by the hash of their literal.
+	std::map<util::h256, std::shared_ptr<bytes const>> m_dataBuffers;
 };
 
 }
@@ -21,10 +21,15 @@
 
 #pragma once
 
+#include <libyul/Exceptions.h>
+
 #include <boost/noncopyable.hpp>
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -36,6 +41,11 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// The repository is split into shards selected by the string hash, each with its own lock,
+/// so that strings can be added concurrently from different threads. Strings are stored
+/// in blocks that are never moved or freed before reset(), so looking up the string of
+/// a handle does not need any lock.
 class YulStringRepository
 {
 public:
@@ -56,17 +66,23 @@ public:
 		if (_string.empty())
 			return { 0, emptyHash() };
 		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
+		size_t shardIndex = static_cast<size_t>(h % shardCount);
+		Shard& shard = m_shards[shardIndex];
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		auto range = shard.hashToIndex.equal_range(h);
 		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
+			if (shard.at(it->second) == _string)
+				return Handle{it->second * shardCount + shardIndex, h};
+		size_t index = shard.append(_string);
+		shard.hashToIndex.emplace(h, index);
 
-		return Handle{id, h};
+		return Handle{index * shardCount + shardIndex, h};
+	}
+	std::string const& idToString(size_t _id) const
+	{
+		return m_shards[_id % shardCount].at(_id / shardCount);
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -82,14 +98,37 @@ public:
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references and
+	/// the repository must not be used concurrently.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
 	static void reset()
 	{
 		for (auto const& cb: resetCallbacks())
 			cb();
-		instance() = YulStringRepository{};
+		instance().clear();
+	}
+	/// Clear the repository, but only if it holds more than @a _maxSize strings.
+	/// Long-running processes that handle many unrelated inputs, like fuzzers, can call this
+	/// instead of reset() to keep the objects registered via ResetCallback (dialects, polyfills)
+	/// alive between inputs while still bounding the memory used by the repository.
+	/// The same restrictions as for reset() apply.
+	static void resetIfLargerThan(size_t _maxSize)
+	{
+		if (instance().size() > _maxSize)
+			reset();
+	}
+	/// @returns the number of strings in the repository, including the empty string.
+	size_t size()
+	{
+		size_t result = 0;
+		for (Shard& shard: m_shards)
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			result += shard.size;
+		}
+		// Every shard reserves index zero, but only the one of the first shard is used.
+		return result - (shardCount - 1);
 	}
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
@@ -97,25 +136,83 @@ public:
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
+			std::lock_guard<std::mutex> lock(resetCallbacksMutex());
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
 		}
 	};
 
 private:
-	YulStringRepository() = default;
+	static size_t constexpr shardCount = 16;
+	static size_t constexpr blockSize = 1024;
+	static size_t constexpr maxBlocksPerShard = 1024;
+
+	/// Part of the repository that contains the strings whose hash is congruent to its
+	/// index modulo shardCount. The string with index i is stored at position
+	/// i % blockSize of block i / blockSize. Index zero is reserved for the empty string.
+	struct Shard
+	{
+		Shard() = default;
+		Shard(Shard const&) = delete;
+		Shard& operator=(Shard const&) = delete;
+		~Shard() { clear(); }
+
+		std::string const& at(size_t _index) const
+		{
+			return blocks[_index / blockSize].load(std::memory_order_acquire)[_index % blockSize];
+		}
+		/// Stores @a _string at a new index and returns the index. The caller has to hold the lock.
+		size_t append(std::string const& _string)
+		{
+			size_t index = size++;
+			size_t blockIndex = index / blockSize;
+			yulAssert(blockIndex < maxBlocksPerShard, "Too many distinct identifiers.");
+			std::string* block = blocks[blockIndex].load(std::memory_order_relaxed);
+			if (!block)
+			{
+				block = new std::string[blockSize];
+				blocks[blockIndex].store(block, std::memory_order_release);
+			}
+			block[index % blockSize] = _string;
+			return index;
+		}
+		void clear()
+		{
+			for (auto& block: blocks)
+				delete[] block.exchange(nullptr);
+			hashToIndex.clear();
+			size = 1;
+		}
+
+		std::mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToIndex;
+		size_t size = 1;
+		std::array<std::atomic<std::string*>, maxBlocksPerShard> blocks{};
+	};
+
+	YulStringRepository() { clear(); }
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+
+	void clear()
+	{
+		for (Shard& shard: m_shards)
+			shard.clear();
+		// The empty string has ID zero, which refers to the reserved index of the first shard.
+		m_shards[0].blocks[0].store(new std::string[blockSize], std::memory_order_release);
+	}
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
 		static std::vector<std::function<void()>> callbacks;
 		return callbacks;
 	}
+	static std::mutex& resetCallbacksMutex()
+	{
+		static std::mutex callbacksMutex;
+		return callbacksMutex;
+	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, shardCount> m_shards;
 };
 
 /// Wrapper around handles into the YulString repository.
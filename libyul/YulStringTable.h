@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Hash table for lookups of YulStrings in fixed sets, like the builtins of a dialect.
+ */
+
+#pragma once
+
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Open addressing hash table from YulStrings to pointers to values owned elsewhere.
+ * The slot of a name is derived from the hash stored in its YulString and slots are compared
+ * by string ID, so a lookup does not touch the string itself. At most a quarter of the slots
+ * is used, which keeps the number of slots probed per lookup close to one.
+ * Without a value type, the table is a set of the names inserted with null values.
+ */
+template <typename Value = void>
+class YulStringTable
+{
+public:
+	/// Adds an entry from @a _name, which must not be empty, to @a _value or replaces the value
+	/// of the existing entry.
+	void insert(YulString _name, Value const* _value)
+	{
+		yulAssert(!_name.empty(), "");
+		if (4 * (m_size + 1) > m_slots.size())
+			rehash(m_slots.empty() ? 16 : 2 * m_slots.size());
+		Slot& slot = m_slots[slotIndex(_name)];
+		if (slot.name.empty())
+			++m_size;
+		slot = {_name, _value};
+	}
+
+	/// @returns the value of the entry for @a _name or nullptr if there is none.
+	Value const* find(YulString _name) const
+	{
+		if (m_slots.empty())
+			return nullptr;
+		Slot const& slot = m_slots[slotIndex(_name)];
+		return slot.name == _name ? slot.value : nullptr;
+	}
+
+	bool contains(YulString _name) const
+	{
+		return !_name.empty() && !m_slots.empty() && m_slots[slotIndex(_name)].name == _name;
+	}
+
+	size_t size() const { return m_size; }
+
+	void clear()
+	{
+		m_slots.clear();
+		m_size = 0;
+	}
+
+private:
+	struct Slot
+	{
+		YulString name;
+		Value const* value = nullptr;
+	};
+
+	/// @returns the index of the slot containing @a _name or of the empty slot where it would
+	/// be inserted.
+	size_t slotIndex(YulString _name) const
+	{
+		size_t const mask = m_slots.size() - 1;
+		// Fibonacci hashing spreads the bits of the string hash over the index.
+		size_t index = static_cast<size_t>((_name.hash() * 0x9E3779B97F4A7C15u) >> 32) & mask;
+		while (!m_slots[index].name.empty() && m_slots[index].name != _name)
+			index = (index + 1) & mask;
+		return index;
+	}
+
+	void rehash(size_t _slotCount)
+	{
+		std::vector<Slot> slots(_slotCount);
+		swap(slots, m_slots);
+		for (Slot const& slot: slots)
+			if (!slot.name.empty())
+				m_slots[slotIndex(slot.name)] = slot;
+	}
+
+	std::vector<Slot> m_slots;
+	size_t m_size = 0;
+};
+
+}
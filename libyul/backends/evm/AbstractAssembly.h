@@ -87,7 +87,7 @@ public:
 	virtual void appendJumpTo(LabelID _labelId, int _stackDiffAfter = 0, JumpType _jumpType = JumpType::Ordinary) = 0;
 	/// Append a jump-to-if-immediate operation.
 	virtual void appendJumpToIf(LabelID _labelId, JumpType _jumpType = JumpType::Ordinary) = 0;
-	/// Start a subroutine identified by @a _labelId that takes @a _arguments
+	/// Start a subroutine (EIP-615 or EIP-2315) identified by @a _labelId that takes @a _arguments
 	/// stack slots as arguments.
 	virtual void appendBeginsub(LabelID _labelId, int _arguments) = 0;
 	/// Call a subroutine identified by @a _labelId, taking @a _arguments from the
@@ -117,22 +117,25 @@ void EthAssemblyAdapter::appendJumpToIf(LabelID _labelId, JumpType _jumpType)
 	appendJumpInstruction(evmasm::Instruction::JUMPI, _jumpType);
 }
 
-void EthAssemblyAdapter::appendBeginsub(LabelID, int)
+void EthAssemblyAdapter::appendBeginsub(LabelID _labelId, int _arguments)
 {
-	// TODO we could emulate that, though
-	yulAssert(false, "BEGINSUB not implemented for EVM 1.0");
+	evmasm::AssemblyItem entry(evmasm::Tag, _labelId);
+	entry.markAsSubroutineEntry();
+	m_assembly.append(std::move(entry));
+	m_assembly.adjustDeposit(_arguments);
 }
 
-void EthAssemblyAdapter::appendJumpsub(LabelID, int, int)
+void EthAssemblyAdapter::appendJumpsub(LabelID _labelId, int _arguments, int _returns)
 {
-	// TODO we could emulate that, though
-	yulAssert(false, "JUMPSUB not implemented for EVM 1.0");
+	appendLabelReference(_labelId);
+	appendJumpInstruction(evmasm::Instruction::JUMPSUB, JumpType::IntoFunction);
+	m_assembly.adjustDeposit(_returns - _arguments);
 }
 
-void EthAssemblyAdapter::appendReturnsub(int, int)
+void EthAssemblyAdapter::appendReturnsub(int _returns, int _stackDiffAfter)
 {
-	// TODO we could emulate that, though
-	yulAssert(false, "RETURNSUB not implemented for EVM 1.0");
+	appendJumpInstruction(evmasm::Instruction::RETURNSUB, JumpType::OutOfFunction);
+	m_assembly.adjustDeposit(_stackDiffAfter - _returns);
 }
 
 void EthAssemblyAdapter::appendAssemblySize()
@@ -203,7 +206,13 @@ EthAssemblyAdapter::LabelID EthAssemblyAdapter::assemblyTagToIdentifier(evmasm::
 
 void EthAssemblyAdapter::appendJumpInstruction(evmasm::Instruction _instruction, JumpType _jumpType)
 {
-	yulAssert(_instruction == evmasm::Instruction::JUMP || _instruction == evmasm::Instruction::JUMPI, "");
+	yulAssert(
+		_instruction == evmasm::Instruction::JUMP ||
+		_instruction == evmasm::Instruction::JUMPI ||
+		_instruction == evmasm::Instruction::JUMPSUB ||
+		_instruction == evmasm::Instruction::RETURNSUB,
+		""
+	);
 	evmasm::AssemblyItem jump(_instruction);
 	switch (_jumpType)
 	{
@@ -227,7 +236,8 @@ void CodeGenerator::assemble(
 	langutil::EVMVersion _evmVersion,
 	ExternalIdentifierAccess const& _identifierAccess,
 	bool _useNamedLabelsForFunctions,
-	bool _optimizeStackAllocation
+	bool _optimizeStackAllocation,
+	bool _useSubroutines
 )
 {
 	EthAssemblyAdapter assemblyAdapter(_assembly);
@@ -241,7 +251,9 @@ void CodeGenerator::assemble(
 		_optimizeStackAllocation,
 		false,
 		_identifierAccess,
-		_useNamedLabelsForFunctions
+		_useNamedLabelsForFunctions,
+		nullopt,
+		_useSubroutines
 	);
 	transform(_parsedData);
 	if (!transform.stackErrors().empty())
@@ -80,6 +80,7 @@ class CodeGenerator
 {
 public:
 	/// Performs code generation and appends generated to _assembly.
+	/// @param _useSubroutines if true, functions are compiled to subroutines (EIP-2315).
 	static void assemble(
 		Block const& _parsedData,
 		AsmAnalysisInfo& _analysisInfo,
@@ -87,7 +88,8 @@ public:
 		langutil::EVMVersion _evmVersion,
 		ExternalIdentifierAccess const& _identifierAccess = ExternalIdentifierAccess(),
 		bool _useNamedLabelsForFunctions = false,
-		bool _optimizeStackAllocation = false
+		bool _optimizeStackAllocation = false,
+		bool _useSubroutines = false
 	);
 };
 
@@ -24,6 +24,11 @@
 
 #include <libevmasm/Instruction.h>
 
+#include <libsolutil/Keccak256.h>
+
+#include <algorithm>
+#include <set>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -35,17 +40,33 @@ namespace
 /// Size of labels in bytes. Four-byte labels are required by some EVM1.5 instructions.
 size_t constexpr labelReferenceSize = 4;
 
-size_t constexpr assemblySizeReferenceSize = 4;
+/// Size of data offset and program size references in bytes before they are shrunk.
+size_t constexpr dataReferenceSize = 4;
+
+void updateReference(bytes& _bytecode, size_t _pos, size_t _size, u256 const& _value)
+{
+	yulAssert(_bytecode.size() >= _size && _pos <= _bytecode.size() - _size, "");
+	yulAssert(_value < (u256(1) << (8 * _size)), "");
+	for (size_t i = 0; i < _size; i++)
+		_bytecode[_pos + i] = uint8_t((_value >> (8 * (_size - i - 1))) & 0xff);
+}
 }
 
 
-void EVMAssembly::setSourceLocation(SourceLocation const&)
+void EVMAssembly::setSourceLocation(SourceLocation const& _location)
 {
-	// Ignored for now;
+	m_currentSourceLocation = _location;
 }
 
 void EVMAssembly::appendInstruction(evmasm::Instruction _instr)
 {
+	yulAssert(!m_linkerObject, "Assembly already finalized.");
+	SourceLocation const& location = m_currentSourceLocation;
+	m_sourceMapping.push_back({
+		location.start,
+		location.start != -1 && location.end != -1 ? location.end - location.start : -1,
+		location.source ? 0 : -1
+	});
 	m_bytecode.push_back(uint8_t(_instr));
 	m_stackHeight += instructionInfo(_instr).ret - instructionInfo(_instr).args;
 }
@@ -87,9 +108,11 @@ AbstractAssembly::LabelID EVMAssembly::namedLabel(string const& _name)
 	return m_namedLabels[_name];
 }
 
-void EVMAssembly::appendLinkerSymbol(string const&)
+void EVMAssembly::appendLinkerSymbol(string const& _name)
 {
-	yulAssert(false, "Linker symbols not yet implemented.");
+	appendInstruction(evmasm::Instruction::PUSH20);
+	m_linkReferences[m_bytecode.size()] = _name;
+	m_bytecode += bytes(20);
 }
 
 void EVMAssembly::appendJump(int _stackDiffAfter, JumpType)
@@ -131,51 +154,154 @@ void EVMAssembly::appendJumpToIf(LabelID _labelId, JumpType)
 
 void EVMAssembly::appendBeginsub(LabelID _labelId, int _arguments)
 {
-	yulAssert(m_evm15, "BEGINSUB used for EVM 1.0");
 	yulAssert(_arguments >= 0, "");
 	setLabelToCurrentPosition(_labelId);
-	m_bytecode.push_back(uint8_t(evmasm::Instruction::EIP615_BEGINSUB));
+	if (m_evm15)
+		m_bytecode.push_back(uint8_t(evmasm::Instruction::EIP615_BEGINSUB));
+	else
+		appendInstruction(evmasm::Instruction::BEGINSUB);
 	m_stackHeight += _arguments;
 }
 
 void EVMAssembly::appendJumpsub(LabelID _labelId, int _arguments, int _returns)
 {
-	yulAssert(m_evm15, "JUMPSUB used for EVM 1.0");
 	yulAssert(_arguments >= 0 && _returns >= 0, "");
-	m_bytecode.push_back(uint8_t(evmasm::Instruction::EIP615_JUMPSUB));
-	appendLabelReferenceInternal(_labelId);
+	if (m_evm15)
+	{
+		m_bytecode.push_back(uint8_t(evmasm::Instruction::EIP615_JUMPSUB));
+		appendLabelReferenceInternal(_labelId);
+	}
+	else
+	{
+		appendLabelReference(_labelId);
+		appendInstruction(evmasm::Instruction::JUMPSUB);
+	}
 	m_stackHeight += _returns - _arguments;
 }
 
 void EVMAssembly::appendReturnsub(int _returns, int _stackDiffAfter)
 {
-	yulAssert(m_evm15, "RETURNSUB used for EVM 1.0");
 	yulAssert(_returns >= 0, "");
-	m_bytecode.push_back(uint8_t(evmasm::Instruction::EIP615_RETURNSUB));
+	if (m_evm15)
+		m_bytecode.push_back(uint8_t(evmasm::Instruction::EIP615_RETURNSUB));
+	else
+		appendInstruction(evmasm::Instruction::RETURNSUB);
 	m_stackHeight += _stackDiffAfter - _returns;
 }
 
-evmasm::LinkerObject EVMAssembly::finalize()
+evmasm::LinkerObject const& EVMAssembly::finalize()
 {
 	yulAssert(!m_invalid, "Attempted to finalize invalid assembly object.");
-	size_t bytecodeSize = m_bytecode.size();
-	for (auto const& ref: m_assemblySizePositions)
-		updateReference(ref, assemblySizeReferenceSize, u256(bytecodeSize));
+	if (m_linkerObject)
+		return *m_linkerObject;
+
+	// Sub-assemblies and data whose offset is referenced are appended after the code,
+	// sub-assemblies first.
+	set<vector<SubID>> referencedPaths;
+	for (auto const& ref: m_dataOffsetReferences)
+		referencedPaths.insert(ref.second);
+	vector<vector<SubID>> tailPaths(referencedPaths.begin(), referencedPaths.end());
+	stable_partition(tailPaths.begin(), tailPaths.end(), [&](auto const& _path) {
+		return _path.size() > 1 || !m_data.count(_path.front());
+	});
+	size_t tailSize = tailPaths.empty() ? 0 : 1;
+	for (auto const& path: tailPaths)
+		tailSize += subObject(path).bytecode.size();
+
+	// Shrink the references to the smallest size that can hold all label positions
+	// and all offsets into the code including the tail, respectively.
+	size_t labelSize = labelReferenceSize;
+	size_t dataSize = dataReferenceSize;
+	if (!m_evm15)
+	{
+		size_t numDataReferences = m_dataOffsetReferences.size() + m_assemblySizePositions.size();
+		auto codeSize = [&](size_t _labelSize, size_t _dataSize) {
+			return
+				m_bytecode.size() -
+				m_labelReferences.size() * (labelReferenceSize - _labelSize) -
+				numDataReferences * (dataReferenceSize - _dataSize);
+		};
+		labelSize = 1;
+		while (bytesRequired(codeSize(labelSize, dataReferenceSize)) > labelSize)
+			labelSize++;
+		dataSize = 1;
+		while (bytesRequired(codeSize(labelSize, dataSize) + tailSize) > dataSize)
+			dataSize++;
+		yulAssert(labelSize <= labelReferenceSize && dataSize <= dataReferenceSize, "Code too large.");
+	}
 
+	// Start positions of all references together with their reserved and final size.
+	map<size_t, pair<size_t, size_t>> references;
 	for (auto const& ref: m_labelReferences)
+		references[ref.first] = {labelReferenceSize, labelSize};
+	for (auto const& ref: m_dataOffsetReferences)
+		references[ref.first] = {dataReferenceSize, dataSize};
+	for (size_t pos: m_assemblySizePositions)
+		references[pos] = {dataReferenceSize, dataSize};
+
+	evmasm::LinkerObject& obj = m_linkerObject.emplace();
+	obj.bytecode.reserve(m_bytecode.size() + tailSize);
+	// Maps the start of each reference to the number of bytes removed up to its end.
+	map<size_t, size_t> removedBytes;
+	size_t removed = 0;
+	size_t copied = 0;
+	for (auto const& [pos, sizes]: references)
 	{
-		size_t referencePos = ref.first;
-		yulAssert(m_labelPositions.count(ref.second), "");
-		size_t labelPos = m_labelPositions.at(ref.second);
+		auto const& [reservedSize, size] = sizes;
+		obj.bytecode.insert(obj.bytecode.end(), m_bytecode.begin() + ptrdiff_t(copied), m_bytecode.begin() + ptrdiff_t(pos));
+		if (size != reservedSize)
+			obj.bytecode.back() = uint8_t(evmasm::pushInstruction(static_cast<unsigned>(size)));
+		obj.bytecode.resize(obj.bytecode.size() + size);
+		copied = pos + reservedSize;
+		removed += reservedSize - size;
+		removedBytes[pos] = removed;
+	}
+	obj.bytecode.insert(obj.bytecode.end(), m_bytecode.begin() + ptrdiff_t(copied), m_bytecode.end());
+	auto newPosition = [&](size_t _pos) {
+		auto it = removedBytes.lower_bound(_pos);
+		return it == removedBytes.begin() ? _pos : _pos - prev(it)->second;
+	};
+
+	for (auto const& [referencePos, labelId]: m_labelReferences)
+	{
+		yulAssert(m_labelPositions.count(labelId), "");
+		size_t labelPos = m_labelPositions.at(labelId);
 		yulAssert(labelPos != numeric_limits<size_t>::max(), "Undefined but allocated label used.");
-		updateReference(referencePos, labelReferenceSize, u256(labelPos));
+		updateReference(obj.bytecode, newPosition(referencePos), labelSize, u256(newPosition(labelPos)));
+	}
+	for (auto const& [pos, name]: m_linkReferences)
+		obj.linkReferences[newPosition(pos)] = name;
+	for (auto const& [hash, immutable]: m_immutableReferences)
+	{
+		auto& [name, positions] = obj.immutableReferences[hash];
+		name = immutable.first;
+		for (size_t pos: immutable.second)
+			positions.emplace_back(newPosition(pos));
+	}
+
+	map<vector<SubID>, size_t> tailOffsets;
+	if (!tailPaths.empty())
+		// Append an INVALID here to help tests find miscompilation.
+		obj.bytecode.push_back(uint8_t(evmasm::Instruction::INVALID));
+	for (auto const& path: tailPaths)
+	{
+		tailOffsets[path] = obj.bytecode.size();
+		obj.append(subObject(path));
 	}
+	for (auto const& [pos, path]: m_dataOffsetReferences)
+		updateReference(obj.bytecode, newPosition(pos), dataSize, u256(tailOffsets.at(path)));
+	for (size_t pos: m_assemblySizePositions)
+		updateReference(obj.bytecode, newPosition(pos), dataSize, u256(obj.bytecode.size()));
 
-	evmasm::LinkerObject obj;
-	obj.bytecode = m_bytecode;
 	return obj;
 }
 
+EVMAssembly& EVMAssembly::firstSubAssembly()
+{
+	yulAssert(!m_subAssemblies.empty(), "No sub-assembly.");
+	return *m_subAssemblies.begin()->second;
+}
+
 void EVMAssembly::setLabelToCurrentPosition(LabelID _labelId)
 {
 	yulAssert(m_labelPositions.count(_labelId), "Label not found.");
@@ -191,46 +317,94 @@ void EVMAssembly::appendLabelReferenceInternal(LabelID _labelId)
 
 void EVMAssembly::appendAssemblySize()
 {
-	appendInstruction(evmasm::pushInstruction(assemblySizeReferenceSize));
+	appendInstruction(evmasm::pushInstruction(dataReferenceSize));
 	m_assemblySizePositions.push_back(m_bytecode.size());
-	m_bytecode += bytes(assemblySizeReferenceSize);
+	m_bytecode += bytes(dataReferenceSize);
 }
 
 pair<shared_ptr<AbstractAssembly>, AbstractAssembly::SubID> EVMAssembly::createSubAssembly()
 {
-	yulAssert(false, "Sub assemblies not implemented.");
-	return {};
+	yulAssert(!m_evm15, "Sub assemblies not implemented for EVM1.5.");
+	auto assembly = make_shared<EVMAssembly>(m_evm15);
+	SubID id = m_nextSubId++;
+	m_subAssemblies[id] = assembly;
+	return {assembly, id};
 }
 
-void EVMAssembly::appendDataOffset(vector<AbstractAssembly::SubID> const&)
+void EVMAssembly::appendDataOffset(vector<AbstractAssembly::SubID> const& _subPath)
 {
-	yulAssert(false, "Data not implemented.");
+	yulAssert(!_subPath.empty(), "");
+	appendInstruction(evmasm::pushInstruction(dataReferenceSize));
+	m_dataOffsetReferences[m_bytecode.size()] = _subPath;
+	m_bytecode += bytes(dataReferenceSize);
 }
 
-void EVMAssembly::appendDataSize(vector<AbstractAssembly::SubID> const&)
+void EVMAssembly::appendDataSize(vector<AbstractAssembly::SubID> const& _subPath)
 {
-	yulAssert(false, "Data not implemented.");
+	appendConstant(u256(subObject(_subPath).bytecode.size()));
 }
 
-AbstractAssembly::SubID EVMAssembly::appendData(bytes const&)
+AbstractAssembly::SubID EVMAssembly::appendData(bytes const& _data)
 {
-	yulAssert(false, "Data not implemented.");
+	SubID id = m_nextSubId++;
+	m_data[id].bytecode = _data;
+	return id;
 }
 
-void EVMAssembly::appendImmutable(std::string const&)
+void EVMAssembly::appendImmutable(std::string const& _identifier)
 {
-	yulAssert(false, "loadimmutable not implemented.");
+	appendInstruction(evmasm::Instruction::PUSH32);
+	auto& [name, positions] = m_immutableReferences[u256(keccak256(_identifier))];
+	name = _identifier;
+	positions.emplace_back(m_bytecode.size());
+	m_bytecode += bytes(32);
 }
 
-void EVMAssembly::appendImmutableAssignment(std::string const&)
+void EVMAssembly::appendImmutableAssignment(std::string const& _identifier)
 {
-	yulAssert(false, "setimmutable not implemented.");
+	// Writes the value to all places where the sub-assembly reads the immutable,
+	// relative to the offset on the stack. Assumes the sub-assemblies are finalized.
+	u256 hash{keccak256(_identifier)};
+	vector<size_t> offsets;
+	bool referencesFound = false;
+	for (auto const& subAssembly: m_subAssemblies)
+	{
+		auto const& references = subAssembly.second->finalize().immutableReferences;
+		if (references.empty())
+			continue;
+		yulAssert(!referencesFound, "More than one sub-assembly references immutables.");
+		referencesFound = true;
+		if (references.count(hash))
+			offsets = references.at(hash).second;
+	}
+	if (offsets.empty())
+	{
+		appendInstruction(evmasm::Instruction::POP);
+		appendInstruction(evmasm::Instruction::POP);
+		return;
+	}
+	for (size_t i = 0; i < offsets.size(); ++i)
+	{
+		if (i != offsets.size() - 1)
+		{
+			appendInstruction(evmasm::Instruction::DUP2);
+			appendInstruction(evmasm::Instruction::DUP2);
+		}
+		appendConstant(u256(offsets[i]));
+		appendInstruction(evmasm::Instruction::ADD);
+		appendInstruction(evmasm::Instruction::MSTORE);
+	}
 }
 
-void EVMAssembly::updateReference(size_t pos, size_t size, u256 value)
+evmasm::LinkerObject const& EVMAssembly::subObject(vector<SubID> const& _subPath)
 {
-	yulAssert(m_bytecode.size() >= size && pos <= m_bytecode.size() - size, "");
-	yulAssert(value < (u256(1) << (8 * size)), "");
-	for (size_t i = 0; i < size; i++)
-		m_bytecode[pos + i] = uint8_t((value >> (8 * (size - i - 1))) & 0xff);
+	yulAssert(!_subPath.empty(), "");
+	SubID id = _subPath.front();
+	if (_subPath.size() == 1 && m_data.count(id))
+		return m_data.at(id);
+	yulAssert(m_subAssemblies.count(id), "Sub assembly not found.");
+	EVMAssembly& subAssembly = *m_subAssemblies.at(id);
+	if (_subPath.size() == 1)
+		return subAssembly.finalize();
+	return subAssembly.subObject(vector<SubID>(_subPath.begin() + 1, _subPath.end()));
 }
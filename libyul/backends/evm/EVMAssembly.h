@@ -23,18 +23,28 @@
 
 #include <libyul/backends/evm/AbstractAssembly.h>
 
+#include <libevmasm/AssemblyItem.h>
 #include <libevmasm/LinkerObject.h>
 
-#include <map>
+#include <liblangutil/SourceLocation.h>
 
-namespace solidity::langutil
-{
-struct SourceLocation;
-}
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace solidity::yul
 {
 
+/**
+ * Assembly that directly emits bytecode instead of going through an evmasm::Assembly.
+ *
+ * Label, data offset and program size references are emitted with a fixed size and
+ * shrunk to the smallest size that fits the final code in a single pass when the
+ * object is finalized. Sub-assemblies and data are appended after the code,
+ * separated by an INVALID instruction. Since no evmasm optimisation can be applied,
+ * this is only meant for code that is not optimised further.
+ */
 class EVMAssembly: public AbstractAssembly
 {
 public:
@@ -90,14 +100,26 @@ public:
 	void markAsInvalid() override { m_invalid = true; }
 
 	/// Resolves references inside the bytecode and returns the linker object.
-	evmasm::LinkerObject finalize();
+	/// The result is cached, no code can be appended afterwards.
+	evmasm::LinkerObject const& finalize();
+
+	/// @returns the number of sub-assemblies.
+	size_t numSubAssemblies() const { return m_subAssemblies.size(); }
+	/// @returns the sub-assembly created first.
+	EVMAssembly& firstSubAssembly();
+	/// @returns the source location of every instruction of the code in EVM 1.0 mode,
+	/// using the source index 0 for all locations that refer to a source.
+	evmasm::SourceMapping const& sourceMapping() const { return m_sourceMapping; }
 
 private:
 	void setLabelToCurrentPosition(AbstractAssembly::LabelID _labelId);
 	void appendLabelReferenceInternal(AbstractAssembly::LabelID _labelId);
-	void updateReference(size_t pos, size_t size, u256 value);
+	/// @returns the finalized sub-assembly or data at @a _subPath.
+	evmasm::LinkerObject const& subObject(std::vector<SubID> const& _subPath);
 
 	bool m_evm15 = false; ///< if true, switch to evm1.5 mode
+	langutil::SourceLocation m_currentSourceLocation;
+	evmasm::SourceMapping m_sourceMapping;
 	LabelID m_nextLabelId = 0;
 	int m_stackHeight = 0;
 	bytes m_bytecode;
@@ -105,6 +127,14 @@ private:
 	std::map<LabelID, size_t> m_labelPositions;
 	std::map<size_t, LabelID> m_labelReferences;
 	std::vector<size_t> m_assemblySizePositions;
+	/// Positions of data offset references and the path to the referenced sub-assembly or data.
+	std::map<size_t, std::vector<SubID>> m_dataOffsetReferences;
+	std::map<size_t, std::string> m_linkReferences;
+	std::map<u256, std::pair<std::string, std::vector<size_t>>> m_immutableReferences;
+	SubID m_nextSubId = 0;
+	std::map<SubID, std::shared_ptr<EVMAssembly>> m_subAssemblies;
+	std::map<SubID, evmasm::LinkerObject> m_data;
+	std::optional<evmasm::LinkerObject> m_linkerObject;
 	bool m_invalid = false;
 };
 
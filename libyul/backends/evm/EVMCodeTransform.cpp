@@ -26,6 +26,8 @@
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 
+#include <libevmasm/GasMeter.h>
+
 #include <liblangutil/Exceptions.h>
 
 #include <boost/range/adaptor/reversed.hpp>
@@ -38,6 +40,69 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+namespace
+{
+
+/// @returns true if selecting among @a _cases case values of a switch is cheaper when first
+/// comparing with the value @a _pivot, which splits them in half, given @a _runs executions.
+bool splitCases(size_t _cases, u256 const& _pivot, size_t _runs)
+{
+	// Code for selecting from n values without split:
+	//   n times: push <value_i>, dup2, eq, push <tag_i>, jumpi
+	//   push <nomatch> jump
+	// Code for selecting from n values with split:
+	//   push <pivot>, dup2, lt, push <tag_less>, jumpi
+	//     SELECT[n/2]
+	//   tag_less:
+	//     SELECT[n/2]
+	//
+	// Each split adds 12 bytes plus the bytes of the pivot (note the additional jump out).
+	// The average execution costs are 22 * n/2 = 11 * n without split and
+	// 22 + 22 * n/4 = 5.5 * n + 22 with a split.
+	//
+	// We should split if
+	//     _runs * 11 * n > _runs * (5.5 * n + 22) + (12 + pivot bytes) * createDataGas
+	// <=> _runs * 5.5 * (n - 4) > (12 + pivot bytes) * createDataGas
+	if (_cases <= 4)
+		return false;
+	bigint savedGas = bigint(_runs) * 11 * (_cases - 4);
+	bigint addedCost = bigint(2) * (12 + max(1u, bytesRequired(_pivot))) * evmasm::GasCosts::createDataGas;
+	return savedGas > addedCost;
+}
+
+/// @returns the call of the statement @a _statement if it is the last statement of the function
+/// @a _function and returns exactly the values of the function, i.e. if it is an expression
+/// statement in a function without return variables or an assignment to all return variables
+/// in their order.
+FunctionCall const* tailCall(FunctionDefinition const& _function, Statement const& _statement, EVMDialect const& _dialect)
+{
+	FunctionCall const* call = nullptr;
+	if (auto const* expressionStatement = get_if<ExpressionStatement>(&_statement))
+	{
+		if (_function.returnVariables.empty())
+			call = get_if<FunctionCall>(&expressionStatement->expression);
+	}
+	else if (auto const* assignment = get_if<Assignment>(&_statement))
+		if (
+			assignment->variableNames.size() == _function.returnVariables.size() &&
+			equal(
+				assignment->variableNames.begin(),
+				assignment->variableNames.end(),
+				_function.returnVariables.begin(),
+				[](Identifier const& _variable, TypedName const& _returnVariable) {
+					return _variable.name == _returnVariable.name;
+				}
+			)
+		)
+			call = get_if<FunctionCall>(assignment->value.get());
+
+	if (call && !_dialect.builtin(call->functionName.name))
+		return call;
+	return nullptr;
+}
+
+}
+
 void VariableReferenceCounter::operator()(Identifier const& _identifier)
 {
 	increaseRefIfFound(_identifier.name);
@@ -104,6 +169,8 @@ CodeTransform::CodeTransform(
 	bool _evm15,
 	ExternalIdentifierAccess _identifierAccess,
 	bool _useNamedLabelsForFunctions,
+	optional<size_t> _expectedExecutionsPerDeployment,
+	bool _useSubroutines,
 	shared_ptr<Context> _context
 ):
 	m_assembly(_assembly),
@@ -112,10 +179,13 @@ CodeTransform::CodeTransform(
 	m_builtinContext(_builtinContext),
 	m_allowStackOpt(_allowStackOpt),
 	m_evm15(_evm15),
+	m_useSubroutines(_evm15 || _useSubroutines),
 	m_useNamedLabelsForFunctions(_useNamedLabelsForFunctions),
+	m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment),
 	m_identifierAccess(std::move(_identifierAccess)),
 	m_context(std::move(_context))
 {
+	yulAssert(!_useSubroutines || _evm15 || m_dialect.evmVersion().hasSubroutines(), "Subroutines are not supported by this EVM version.");
 	if (!m_context)
 	{
 		// initialize
@@ -147,16 +217,33 @@ void CodeTransform::freeUnusedVariables(bool _popUnusedSlotsAtStackTop)
 	if (!m_allowStackOpt)
 		return;
 
-	for (auto const& identifier: m_scope->identifiers)
-		if (holds_alternative<Scope::Variable>(identifier.second))
-		{
-			Scope::Variable const& var = std::get<Scope::Variable>(identifier.second);
-			if (m_variablesScheduledForDeletion.count(&var))
-				deleteVariable(var);
-		}
-
+	auto deleteScheduledVariables = [&](Scope const& _scope)
+	{
+		for (auto const& identifier: _scope.identifiers)
+			if (holds_alternative<Scope::Variable>(identifier.second))
+			{
+				Scope::Variable const& var = std::get<Scope::Variable>(identifier.second);
+				if (m_variablesScheduledForDeletion.count(&var))
+					deleteVariable(var);
+			}
+	};
+	deleteScheduledVariables(*m_scope);
+	// At statement level of a function body, also free the slots of function parameters
+	// that are not used anymore. Return variables are never scheduled for deletion.
+	if (m_scope->superScope && m_scope->superScope->functionScope)
+		deleteScheduledVariables(*m_scope->superScope);
+
+	// Parameter slots lie below the stack height at the function exit and can only be
+	// re-used, not popped, since the function exit expects a fixed stack layout.
+	int const minStackHeight =
+		m_context->functionExitPoints.empty() ?
+		0 :
+		m_context->functionExitPoints.top().targetStackHeight;
 	if (_popUnusedSlotsAtStackTop)
-		while (m_unusedStackSlots.count(m_assembly.stackHeight() - 1))
+		while (
+			m_assembly.stackHeight() > minStackHeight &&
+			m_unusedStackSlots.count(m_assembly.stackHeight() - 1)
+		)
 		{
 			yulAssert(m_unusedStackSlots.erase(m_assembly.stackHeight() - 1), "");
 			m_assembly.appendInstruction(evmasm::Instruction::POP);
@@ -214,12 +301,17 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 			else
 				m_variablesScheduledForDeletion.insert(&var);
 		}
-		else if (m_unusedStackSlots.empty())
-			atTopOfStack = false;
 		else
 		{
-			auto slot = static_cast<size_t>(*m_unusedStackSlots.begin());
-			m_unusedStackSlots.erase(m_unusedStackSlots.begin());
+			// Only consider unused slots that can be reached by a swap.
+			auto slotIt = m_unusedStackSlots.lower_bound(m_assembly.stackHeight() - 17);
+			if (slotIt == m_unusedStackSlots.end())
+			{
+				atTopOfStack = false;
+				continue;
+			}
+			auto slot = static_cast<size_t>(*slotIt);
+			m_unusedStackSlots.erase(slotIt);
 			m_context->variableStackHeights[&var] = slot;
 			if (size_t heightDiff = variableHeightDiff(var, varName, true))
 				m_assembly.appendInstruction(evmasm::swapInstruction(static_cast<unsigned>(heightDiff - 1)));
@@ -268,13 +360,6 @@ void CodeTransform::operator()(FunctionCall const& _call)
 	else
 	{
 		m_assembly.setSourceLocation(_call.location);
-		EVMAssembly::LabelID returnLabel(numeric_limits<EVMAssembly::LabelID>::max()); // only used for evm 1.0
-		if (!m_evm15)
-		{
-			returnLabel = m_assembly.newLabelId();
-			m_assembly.appendLabelReference(returnLabel);
-		}
-
 		Scope::Function* function = nullptr;
 		yulAssert(m_scope->lookup(_call.functionName.name, GenericVisitor{
 			[](Scope::Variable&) { yulAssert(false, "Expected function name."); },
@@ -282,10 +367,39 @@ void CodeTransform::operator()(FunctionCall const& _call)
 		}), "Function name not found.");
 		yulAssert(function, "");
 		yulAssert(function->arguments.size() == _call.arguments.size(), "");
+
+		// The return label of the current function is at height zero.
+		int const heightBefore = m_assembly.stackHeight();
+		bool const isTailCall =
+			&_call == m_tailCall &&
+			static_cast<size_t>(heightBefore) + function->arguments.size() <= 17;
+
+		EVMAssembly::LabelID returnLabel(numeric_limits<EVMAssembly::LabelID>::max()); // only used without subroutines
+		if (!m_useSubroutines && !isTailCall)
+		{
+			returnLabel = m_assembly.newLabelId();
+			m_assembly.appendLabelReference(returnLabel);
+		}
+
 		for (auto const& arg: _call.arguments | boost::adaptors::reversed)
 			visitExpression(arg);
 		m_assembly.setSourceLocation(_call.location);
-		if (m_evm15)
+		if (isTailCall)
+		{
+			// The stack layout here is:
+			// <return label> <arguments and variables of the current function...> <arguments...>
+			// But we would like it to be:
+			// <return label> <arguments...>
+			vector<int> stackLayout{0};
+			stackLayout += vector<int>(static_cast<size_t>(heightBefore - 1), -1);
+			for (size_t i = 0; i < function->arguments.size(); ++i)
+				stackLayout.push_back(static_cast<int>(i + 1));
+			appendStackLayoutShuffle(std::move(stackLayout));
+			m_assembly.appendJumpTo(functionEntryID(_call.functionName.name, *function));
+			// The code after the call is unreachable, but has to see the stack as after a regular call.
+			m_assembly.setStackHeight(heightBefore + static_cast<int>(function->returns.size()));
+		}
+		else if (m_useSubroutines)
 			m_assembly.appendJumpsub(
 				functionEntryID(_call.functionName.name, *function),
 				static_cast<int>(function->arguments.size()),
@@ -361,23 +475,51 @@ void CodeTransform::operator()(Switch const& _switch)
 	int expressionHeight = m_assembly.stackHeight();
 	map<Case const*, AbstractAssembly::LabelID> caseBodies;
 	AbstractAssembly::LabelID end = m_assembly.newLabelId();
+
+	vector<pair<u256, Case const*>> sortedCases;
+	Case const* defaultCase = nullptr;
 	for (Case const& c: _switch.cases)
-	{
 		if (c.value)
-		{
-			(*this)(*c.value);
-			m_assembly.setSourceLocation(c.location);
-			AbstractAssembly::LabelID bodyLabel = m_assembly.newLabelId();
-			caseBodies[&c] = bodyLabel;
-			yulAssert(m_assembly.stackHeight() == expressionHeight + 1, "");
-			m_assembly.appendInstruction(evmasm::dupInstruction(2));
-			m_assembly.appendInstruction(evmasm::Instruction::EQ);
-			m_assembly.appendJumpToIf(bodyLabel);
-		}
+			sortedCases.emplace_back(valueOfLiteral(*c.value), &c);
 		else
-			// default case
-			(*this)(c.body);
+			defaultCase = &c;
+	sort(sortedCases.begin(), sortedCases.end());
+
+	if (
+		m_expectedExecutionsPerDeployment &&
+		!sortedCases.empty() &&
+		splitCases(sortedCases.size(), sortedCases[sortedCases.size() / 2].first, *m_expectedExecutionsPerDeployment)
+	)
+	{
+		for (Case const& c: _switch.cases)
+			if (c.value)
+				caseBodies[&c] = m_assembly.newLabelId();
+		AbstractAssembly::LabelID noMatch = m_assembly.newLabelId();
+		appendCaseSearch(sortedCases, caseBodies, noMatch, _switch.location);
+		m_assembly.setSourceLocation(_switch.location);
+		m_assembly.appendLabel(noMatch);
+		yulAssert(m_assembly.stackHeight() == expressionHeight, "");
+		if (defaultCase)
+			(*this)(defaultCase->body);
 	}
+	else
+		for (Case const& c: _switch.cases)
+		{
+			if (c.value)
+			{
+				(*this)(*c.value);
+				m_assembly.setSourceLocation(c.location);
+				AbstractAssembly::LabelID bodyLabel = m_assembly.newLabelId();
+				caseBodies[&c] = bodyLabel;
+				yulAssert(m_assembly.stackHeight() == expressionHeight + 1, "");
+				m_assembly.appendInstruction(evmasm::dupInstruction(2));
+				m_assembly.appendInstruction(evmasm::Instruction::EQ);
+				m_assembly.appendJumpToIf(bodyLabel);
+			}
+			else
+				// default case
+				(*this)(c.body);
+		}
 	m_assembly.setSourceLocation(_switch.location);
 	m_assembly.appendJumpTo(end);
 
@@ -400,13 +542,61 @@ void CodeTransform::operator()(Switch const& _switch)
 	m_assembly.appendInstruction(evmasm::Instruction::POP);
 }
 
+void CodeTransform::appendCaseSearch(
+	vector<pair<u256, Case const*>> const& _cases,
+	map<Case const*, AbstractAssembly::LabelID> const& _caseBodies,
+	AbstractAssembly::LabelID _noMatch,
+	langutil::SourceLocation const& _location
+)
+{
+	size_t pivotIndex = _cases.size() / 2;
+	if (splitCases(_cases.size(), _cases[pivotIndex].first, *m_expectedExecutionsPerDeployment))
+	{
+		(*this)(*_cases[pivotIndex].second->value);
+		m_assembly.setSourceLocation(_location);
+		m_assembly.appendInstruction(evmasm::dupInstruction(2));
+		m_assembly.appendInstruction(evmasm::Instruction::LT);
+		AbstractAssembly::LabelID lessLabel = m_assembly.newLabelId();
+		m_assembly.appendJumpToIf(lessLabel);
+		// Here, we have value >= pivot
+		appendCaseSearch(
+			{_cases.begin() + static_cast<ptrdiff_t>(pivotIndex), _cases.end()},
+			_caseBodies,
+			_noMatch,
+			_location
+		);
+		m_assembly.setSourceLocation(_location);
+		m_assembly.appendLabel(lessLabel);
+		// Here, we have value < pivot
+		appendCaseSearch(
+			{_cases.begin(), _cases.begin() + static_cast<ptrdiff_t>(pivotIndex)},
+			_caseBodies,
+			_noMatch,
+			_location
+		);
+	}
+	else
+	{
+		for (auto const& [value, c]: _cases)
+		{
+			(*this)(*c->value);
+			m_assembly.setSourceLocation(c->location);
+			m_assembly.appendInstruction(evmasm::dupInstruction(2));
+			m_assembly.appendInstruction(evmasm::Instruction::EQ);
+			m_assembly.appendJumpToIf(_caseBodies.at(c));
+		}
+		m_assembly.setSourceLocation(_location);
+		m_assembly.appendJumpTo(_noMatch);
+	}
+}
+
 void CodeTransform::operator()(FunctionDefinition const& _function)
 {
 	yulAssert(m_scope, "");
 	yulAssert(m_scope->identifiers.count(_function.name), "");
 	Scope::Function& function = std::get<Scope::Function>(m_scope->identifiers.at(_function.name));
 
-	size_t height = m_evm15 ? 0 : 1;
+	size_t height = m_useSubroutines ? 0 : 1;
 	yulAssert(m_info.scopes.at(&_function.body), "");
 	Scope* varScope = m_info.scopes.at(m_info.virtualBlocks.at(&_function).get()).get();
 	yulAssert(varScope, "");
@@ -419,7 +609,7 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 	m_assembly.setSourceLocation(_function.location);
 	int const stackHeightBefore = m_assembly.stackHeight();
 
-	if (m_evm15)
+	if (m_useSubroutines)
 		m_assembly.appendBeginsub(functionEntryID(_function.name, function), static_cast<int>(_function.parameters.size()));
 	else
 		m_assembly.appendLabel(functionEntryID(_function.name, function));
@@ -447,8 +637,21 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 		m_evm15,
 		m_identifierAccess,
 		m_useNamedLabelsForFunctions,
+		m_expectedExecutionsPerDeployment,
+		m_useSubroutines,
 		m_context
 	);
+	if (m_allowStackOpt)
+		for (auto const& v: _function.parameters)
+		{
+			auto& var = std::get<Scope::Variable>(varScope->identifiers.at(v.name));
+			if (unreferenced(var))
+				subTransform.m_variablesScheduledForDeletion.insert(&var);
+		}
+	// Tail calls are only used together with the optimizer, which removes the unreachable
+	// code after them. They cannot jump into a subroutine.
+	if (!m_useSubroutines && m_allowStackOpt && !_function.body.statements.empty())
+		subTransform.m_tailCall = tailCall(_function, _function.body.statements.back(), m_dialect);
 	subTransform(_function.body);
 	if (!subTransform.m_stackErrors.empty())
 	{
@@ -474,7 +677,7 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 		// This vector holds the desired target positions of all stack slots and is
 		// modified parallel to the actual stack.
 		vector<int> stackLayout;
-		if (!m_evm15)
+		if (!m_useSubroutines)
 			stackLayout.push_back(static_cast<int>(_function.returnVariables.size())); // Move return label to the top
 		stackLayout += vector<int>(_function.parameters.size(), -1); // discard all arguments
 
@@ -496,23 +699,9 @@ void CodeTransform::operator()(FunctionDefinition const& _function)
 			stackError(std::move(error), m_assembly.stackHeight() - static_cast<int>(_function.parameters.size()));
 		}
 		else
-		{
-			while (!stackLayout.empty() && stackLayout.back() != static_cast<int>(stackLayout.size() - 1))
-				if (stackLayout.back() < 0)
-				{
-					m_assembly.appendInstruction(evmasm::Instruction::POP);
-					stackLayout.pop_back();
-				}
-				else
-				{
-					m_assembly.appendInstruction(evmasm::swapInstruction(static_cast<unsigned>(stackLayout.size()) - static_cast<unsigned>(stackLayout.back()) - 1u));
-					swap(stackLayout[static_cast<size_t>(stackLayout.back())], stackLayout.back());
-				}
-			for (size_t i = 0; i < stackLayout.size(); ++i)
-				yulAssert(i == static_cast<size_t>(stackLayout[i]), "Error reshuffling stack.");
-		}
+			appendStackLayoutShuffle(std::move(stackLayout));
 	}
-	if (m_evm15)
+	if (m_useSubroutines)
 		m_assembly.appendReturnsub(static_cast<int>(_function.returnVariables.size()), stackHeightBefore);
 	else
 		m_assembly.appendJump(
@@ -561,6 +750,23 @@ void CodeTransform::operator()(ForLoop const& _forLoop)
 	m_scope = originalScope;
 }
 
+void CodeTransform::appendStackLayoutShuffle(vector<int> _stackLayout)
+{
+	while (!_stackLayout.empty() && _stackLayout.back() != static_cast<int>(_stackLayout.size() - 1))
+		if (_stackLayout.back() < 0)
+		{
+			m_assembly.appendInstruction(evmasm::Instruction::POP);
+			_stackLayout.pop_back();
+		}
+		else
+		{
+			m_assembly.appendInstruction(evmasm::swapInstruction(static_cast<unsigned>(_stackLayout.size()) - static_cast<unsigned>(_stackLayout.back()) - 1u));
+			swap(_stackLayout[static_cast<size_t>(_stackLayout.back())], _stackLayout.back());
+		}
+	for (size_t i = 0; i < _stackLayout.size(); ++i)
+		yulAssert(i == static_cast<size_t>(_stackLayout[i]), "Error reshuffling stack.");
+}
+
 int CodeTransform::appendPopUntil(int _targetDepth)
 {
 	int const stackDiffAfter = m_assembly.stackHeight() - _targetDepth;
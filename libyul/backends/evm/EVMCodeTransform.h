@@ -121,6 +121,10 @@ public:
 	/// given assembly.
 	/// Throws StackTooDeepError if a variable is not accessible or if a function has too
 	/// many parameters.
+	/// @param _expectedExecutionsPerDeployment if set, large switches are lowered to a binary
+	/// search over their case values if this pays off for the given number of executions.
+	/// @param _useSubroutines if true, functions are compiled to subroutines (EIP-2315), which
+	/// requires an EVM version that supports them.
 	CodeTransform(
 		AbstractAssembly& _assembly,
 		AsmAnalysisInfo& _analysisInfo,
@@ -130,7 +134,9 @@ public:
 		bool _allowStackOpt = false,
 		bool _evm15 = false,
 		ExternalIdentifierAccess const& _identifierAccess = ExternalIdentifierAccess(),
-		bool _useNamedLabelsForFunctions = false
+		bool _useNamedLabelsForFunctions = false,
+		std::optional<size_t> _expectedExecutionsPerDeployment = std::nullopt,
+		bool _useSubroutines = false
 	): CodeTransform(
 		_assembly,
 		_analysisInfo,
@@ -141,6 +147,8 @@ public:
 		_evm15,
 		_identifierAccess,
 		_useNamedLabelsForFunctions,
+		_expectedExecutionsPerDeployment,
+		_useSubroutines,
 		nullptr
 	)
 	{
@@ -161,6 +169,8 @@ protected:
 		bool _evm15,
 		ExternalIdentifierAccess _identifierAccess,
 		bool _useNamedLabelsForFunctions,
+		std::optional<size_t> _expectedExecutionsPerDeployment,
+		bool _useSubroutines,
 		std::shared_ptr<Context> _context
 	);
 
@@ -168,7 +178,9 @@ protected:
 	bool unreferenced(Scope::Variable const& _var) const;
 	/// Marks slots of variables that are not used anymore
 	/// and were defined in the current scope for reuse.
-	/// Also POPs unused topmost stack slots,
+	/// At statement level of a function body, this includes
+	/// the function parameters.
+	/// Also POPs unused topmost stack slots above the function's parameters,
 	/// unless @a _popUnusedSlotsAtStackTop is set to false.
 	void freeUnusedVariables(bool _popUnusedSlotsAtStackTop = true);
 	/// Marks the stack slot of @a _var to be reused.
@@ -198,6 +210,17 @@ private:
 
 	void visitStatements(std::vector<Statement> const& _statements);
 
+	/// Appends code that jumps to the body in @a _caseBodies of the case among @a _cases, which
+	/// are sorted by their values, whose value equals the value on top of the stack, or to
+	/// @a _noMatch if there is none. Splits the cases at their median value as long as this
+	/// pays off.
+	void appendCaseSearch(
+		std::vector<std::pair<u256, Case const*>> const& _cases,
+		std::map<Case const*, AbstractAssembly::LabelID> const& _caseBodies,
+		AbstractAssembly::LabelID _noMatch,
+		langutil::SourceLocation const& _location
+	);
+
 	/// Pops all variables declared in the block and checks that the stack height is equal
 	/// to @a _blockStartStackHeight.
 	void finalizeBlock(Block const& _block, int _blockStartStackHeight);
@@ -218,6 +241,11 @@ private:
 	/// and corrects the stack height to the target stack height.
 	void stackError(StackTooDeepError _error, int _targetStackSize);
 
+	/// Appends SWAP and POP instructions that move the stack slot at each position to the
+	/// position given by @a _stackLayout, or remove it if the target position is negative.
+	/// The target positions have to be a permutation of 0 to n - 1 for some n.
+	void appendStackLayoutShuffle(std::vector<int> _stackLayout);
+
 	/// Ensures stack height is down to @p _targetDepth by appending POP instructions to the output assembly.
 	/// Returns the number of POP statements that have been appended.
 	int appendPopUntil(int _targetDepth);
@@ -229,7 +257,10 @@ private:
 	BuiltinContext& m_builtinContext;
 	bool const m_allowStackOpt = true;
 	bool const m_evm15 = false;
+	/// Whether functions are compiled to subroutines, which do not keep their return label on the stack.
+	bool const m_useSubroutines = false;
 	bool const m_useNamedLabelsForFunctions = false;
+	std::optional<size_t> const m_expectedExecutionsPerDeployment;
 	ExternalIdentifierAccess m_identifierAccess;
 	std::shared_ptr<Context> m_context;
 
@@ -240,6 +271,10 @@ private:
 	std::set<int> m_unusedStackSlots;
 
 	std::vector<StackTooDeepError> m_stackErrors;
+	/// Call of the last statement of the current function, which jumps directly to the called
+	/// function after removing the arguments and variables of the current function, so that
+	/// the called function returns to the caller of the current function.
+	FunctionCall const* m_tailCall = nullptr;
 };
 
 }
@@ -35,6 +35,8 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -286,29 +288,36 @@ map<YulString, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _evmVe
 EVMDialect::EVMDialect(langutil::EVMVersion _evmVersion, bool _objectAccess):
 	m_objectAccess(_objectAccess),
 	m_evmVersion(_evmVersion),
-	m_functions(createBuiltins(_evmVersion, _objectAccess)),
-	m_reserved(createReservedIdentifiers())
+	m_functions(createBuiltins(_evmVersion, _objectAccess))
 {
+	for (YulString name: createReservedIdentifiers())
+		m_reserved.insert(name, nullptr);
+	indexBuiltins();
 }
 
 BuiltinFunctionForEVM const* EVMDialect::builtin(YulString _name) const
 {
-	auto it = m_functions.find(_name);
-	if (it != m_functions.end())
-		return &it->second;
-	else
-		return nullptr;
+	return m_builtins.find(_name);
 }
 
 bool EVMDialect::reservedIdentifier(YulString _name) const
 {
-	return m_reserved.count(_name) != 0;
+	return m_reserved.contains(_name);
+}
+
+void EVMDialect::indexBuiltins()
+{
+	m_builtins.clear();
+	for (auto const& [name, function]: m_functions)
+		m_builtins.insert(name, &function);
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(_version, false);
 	return *dialects[_version];
@@ -318,6 +327,8 @@ EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(_version, true);
 	return *dialects[_version];
@@ -417,6 +428,7 @@ EVMDialectTyped::EVMDialectTyped(langutil::EVMVersion _evmVersion, bool _objectA
 	}));
 	m_functions["u256_to_bool"_yulstring].parameters = {"u256"_yulstring};
 	m_functions["u256_to_bool"_yulstring].returns = {"bool"_yulstring};
+	indexBuiltins();
 }
 
 BuiltinFunctionForEVM const* EVMDialectTyped::discardFunction(YulString _type) const
@@ -445,6 +457,8 @@ EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialectTyped const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialectTyped>(_version, true);
 	return *dialects[_version];
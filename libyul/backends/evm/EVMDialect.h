@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/Dialect.h>
+#include <libyul/YulStringTable.h>
 
 #include <libyul/backends/evm/AbstractAssembly.h>
 #include <libyul/ASTForward.h>
@@ -92,10 +93,14 @@ struct EVMDialect: public Dialect
 	static SideEffects sideEffectsOfInstruction(evmasm::Instruction _instruction);
 
 protected:
+	/// Creates the table used by builtin(). Has to be called after m_functions changed.
+	void indexBuiltins();
+
 	bool const m_objectAccess;
 	langutil::EVMVersion const m_evmVersion;
 	std::map<YulString, BuiltinFunctionForEVM> m_functions;
-	std::set<YulString> m_reserved;
+	YulStringTable<BuiltinFunctionForEVM> m_builtins;
+	YulStringTable<> m_reserved;
 };
 
 /**
@@ -47,6 +47,13 @@ size_t GasMeter::instructionCosts(evmasm::Instruction _instruction) const
 	return combineCosts(GasMeterVisitor::instructionCosts(_instruction, m_dialect, m_isCreation));
 }
 
+size_t GasMeter::costs(size_t _runGas, size_t _codeSize) const
+{
+	// The data costs of any instruction are those of a single byte.
+	size_t byteCosts = GasMeterVisitor::instructionCosts(evmasm::Instruction::POP, m_dialect, m_isCreation).second;
+	return combineCosts({_runGas, _codeSize * byteCosts});
+}
+
 size_t GasMeter::combineCosts(std::pair<size_t, size_t> _costs) const
 {
 	return _costs.first * m_runs + _costs.second;
@@ -51,6 +51,9 @@ public:
 	/// @returns the combined costs of deploying and running the instruction, not including
 	/// the costs for its arguments.
 	size_t instructionCosts(evmasm::Instruction _instruction) const;
+	/// @returns the combined costs of deploying @a _codeSize bytes of code and spending
+	/// @a _runGas gas each time the code is run.
+	size_t costs(size_t _runGas, size_t _codeSize) const;
 
 private:
 	size_t combineCosts(std::pair<size_t, size_t> _costs) const;
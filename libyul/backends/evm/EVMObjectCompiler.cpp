@@ -31,9 +31,17 @@
 using namespace solidity::yul;
 using namespace std;
 
-void EVMObjectCompiler::compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize)
+void EVMObjectCompiler::compile(
+	Object& _object,
+	AbstractAssembly& _assembly,
+	EVMDialect const& _dialect,
+	bool _evm15,
+	bool _optimize,
+	optional<size_t> _expectedExecutionsPerDeployment,
+	bool _useSubroutines
+)
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _evm15);
+	EVMObjectCompiler compiler(_assembly, _dialect, _evm15, _expectedExecutionsPerDeployment, _useSubroutines);
 	compiler.run(_object, _optimize);
 }
 
@@ -48,19 +56,39 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly();
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, m_evm15, _optimize);
+			compile(
+				*subObject,
+				*subAssemblyAndID.first,
+				m_dialect,
+				m_evm15,
+				_optimize,
+				m_expectedExecutionsPerDeployment,
+				m_useSubroutines
+			);
 		}
 		else
 		{
 			Data const& data = dynamic_cast<Data const&>(*subNode);
-			context.subIDs[data.name] = m_assembly.appendData(data.data);
+			context.subIDs[data.name] = m_assembly.appendData(*data.data);
 		}
 
 	yulAssert(_object.analysisInfo, "No analysis info.");
 	yulAssert(_object.code, "No code.");
 	// We do not catch and re-throw the stack too deep exception here because it is a YulException,
 	// which should be native to this part of the code.
-	CodeTransform transform{m_assembly, *_object.analysisInfo, *_object.code, m_dialect, context, _optimize, m_evm15};
+	CodeTransform transform{
+		m_assembly,
+		*_object.analysisInfo,
+		*_object.code,
+		m_dialect,
+		context,
+		_optimize,
+		m_evm15,
+		ExternalIdentifierAccess(),
+		false,
+		m_expectedExecutionsPerDeployment,
+		m_useSubroutines
+	};
 	transform(*_object.code);
 	if (!transform.stackErrors().empty())
 		BOOST_THROW_EXCEPTION(transform.stackErrors().front());
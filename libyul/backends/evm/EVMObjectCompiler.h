@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <optional>
+
 namespace solidity::yul
 {
 struct Object;
@@ -30,10 +32,31 @@ struct EVMDialect;
 class EVMObjectCompiler
 {
 public:
-	static void compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize);
+	/// @param _expectedExecutionsPerDeployment if set, large switches are lowered to a binary
+	/// search if this pays off for the given number of executions.
+	/// @param _useSubroutines if true, functions are compiled to subroutines (EIP-2315).
+	static void compile(
+		Object& _object,
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _evm15,
+		bool _optimize,
+		std::optional<size_t> _expectedExecutionsPerDeployment = std::nullopt,
+		bool _useSubroutines = false
+	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15):
-		m_assembly(_assembly), m_dialect(_dialect), m_evm15(_evm15)
+	EVMObjectCompiler(
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _evm15,
+		std::optional<size_t> _expectedExecutionsPerDeployment,
+		bool _useSubroutines
+	):
+		m_assembly(_assembly),
+		m_dialect(_dialect),
+		m_evm15(_evm15),
+		m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment),
+		m_useSubroutines(_useSubroutines)
 	{}
 
 	void run(Object& _object, bool _optimize);
@@ -41,6 +64,8 @@ private:
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
 	bool m_evm15 = false;
+	std::optional<size_t> m_expectedExecutionsPerDeployment;
+	bool m_useSubroutines = false;
 };
 
 }
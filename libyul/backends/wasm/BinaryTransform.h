@@ -33,41 +33,49 @@ namespace solidity::yul::wasm
 
 /**
  * Web assembly to binary transform.
+ *
+ * Everything is appended to a single output buffer. Sizes that prefix sections and
+ * function bodies are inserted in front of them once they are complete.
  */
 class BinaryTransform
 {
 public:
 	static bytes run(Module const& _module);
 
-	bytes operator()(wasm::Literal const& _literal);
-	bytes operator()(wasm::StringLiteral const& _literal);
-	bytes operator()(wasm::LocalVariable const& _identifier);
-	bytes operator()(wasm::GlobalVariable const& _identifier);
-	bytes operator()(wasm::BuiltinCall const& _builinCall);
-	bytes operator()(wasm::FunctionCall const& _functionCall);
-	bytes operator()(wasm::LocalAssignment const& _assignment);
-	bytes operator()(wasm::GlobalAssignment const& _assignment);
-	bytes operator()(wasm::If const& _if);
-	bytes operator()(wasm::Loop const& _loop);
-	bytes operator()(wasm::Branch const& _branch);
-	bytes operator()(wasm::BranchIf const& _branchIf);
-	bytes operator()(wasm::Return const& _return);
-	bytes operator()(wasm::Block const& _block);
-	bytes operator()(wasm::FunctionDefinition const& _function);
+	void operator()(wasm::Literal const& _literal);
+	void operator()(wasm::StringLiteral const& _literal);
+	void operator()(wasm::LocalVariable const& _identifier);
+	void operator()(wasm::GlobalVariable const& _identifier);
+	void operator()(wasm::BuiltinCall const& _builinCall);
+	void operator()(wasm::FunctionCall const& _functionCall);
+	void operator()(wasm::LocalAssignment const& _assignment);
+	void operator()(wasm::GlobalAssignment const& _assignment);
+	void operator()(wasm::If const& _if);
+	void operator()(wasm::Loop const& _loop);
+	void operator()(wasm::Branch const& _branch);
+	void operator()(wasm::BranchIf const& _branchIf);
+	void operator()(wasm::Return const& _return);
+	void operator()(wasm::Block const& _block);
+	void operator()(wasm::FunctionDefinition const& _function);
 
 private:
 	BinaryTransform(
+		bytes& _output,
 		std::map<std::string, size_t> _globalIDs,
 		std::map<std::string, size_t> _functionIDs,
 		std::map<std::string, size_t> _functionTypes,
 		std::map<std::string, std::pair<size_t, size_t>> _subModulePosAndSize
 	):
+		m_output(_output),
 		m_globalIDs(std::move(_globalIDs)),
 		m_functionIDs(std::move(_functionIDs)),
 		m_functionTypes(std::move(_functionTypes)),
 		m_subModulePosAndSize(std::move(_subModulePosAndSize))
 	{}
 
+	/// Appends the binary of @a _module to @a _output.
+	static void run(bytes& _output, Module const& _module);
+
 	using Type = std::pair<std::vector<std::uint8_t>, std::vector<std::uint8_t>>;
 	static Type typeOf(wasm::FunctionImport const& _import);
 	static Type typeOf(wasm::FunctionDefinition const& _funDef);
@@ -87,28 +95,30 @@ private:
 		std::map<Type, std::vector<std::string>> const& _typeToFunctionMap
 	);
 
-	static bytes typeSection(std::map<Type, std::vector<std::string>> const& _typeToFunctionMap);
-	static bytes importSection(
+	static void typeSection(bytes& _output, std::map<Type, std::vector<std::string>> const& _typeToFunctionMap);
+	static void importSection(
+		bytes& _output,
 		std::vector<wasm::FunctionImport> const& _imports,
 		std::map<std::string, size_t> const& _functionTypes
 	);
-	static bytes functionSection(
+	static void functionSection(
+		bytes& _output,
 		std::vector<wasm::FunctionDefinition> const& _functions,
 		std::map<std::string, size_t> const& _functionTypes
 	);
-	static bytes memorySection();
-	static bytes globalSection(std::vector<wasm::GlobalVariableDeclaration> const& _globals);
-	static bytes exportSection(std::map<std::string, size_t> const& _functionIDs);
-	static bytes customSection(std::string const& _name, bytes _data);
-	bytes codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
+	static void memorySection(bytes& _output);
+	static void globalSection(bytes& _output, std::vector<wasm::GlobalVariableDeclaration> const& _globals);
+	static void exportSection(bytes& _output, std::map<std::string, size_t> const& _functionIDs);
+	void codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
 
-	bytes visit(std::vector<wasm::Expression> const& _expressions);
-	bytes visitReversed(std::vector<wasm::Expression> const& _expressions);
+	void visit(std::vector<wasm::Expression> const& _expressions);
+	void visitReversed(std::vector<wasm::Expression> const& _expressions);
 
-	bytes encodeLabelIdx(std::string const& _label) const;
+	void encodeLabelIdx(std::string const& _label);
 
-	static bytes encodeName(std::string const& _name);
+	static void encodeName(bytes& _output, std::string const& _name);
 
+	bytes& m_output;
 	std::map<std::string, size_t> const m_globalIDs;
 	std::map<std::string, size_t> const m_functionIDs;
 	std::map<std::string, size_t> const m_functionTypes;
@@ -121,4 +131,3 @@ private:
 };
 
 }
-
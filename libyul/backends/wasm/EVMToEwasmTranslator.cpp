@@ -31,6 +31,8 @@
 #include <libyul/optimiser/NameDisplacer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
 
 #include <libyul/AsmParser.h>
 #include <libyul/AsmAnalysis.h>
@@ -54,16 +56,77 @@
 #include <ewasmPolyfills/Logical.h>
 #include <ewasmPolyfills/Memory.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// The parsed polyfill together with the names of its functions and the
+/// polyfill functions called by each of them.
+struct Polyfill
+{
+	shared_ptr<Block> code;
+	set<YulString> functions;
+	map<YulString, set<YulString>> calls;
+};
+
+Polyfill parsePolyfill()
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(
+		"{" +
+			string(solidity::yul::wasm::polyfill::Arithmetic) +
+			string(solidity::yul::wasm::polyfill::Bitwise) +
+			string(solidity::yul::wasm::polyfill::Comparison) +
+			string(solidity::yul::wasm::polyfill::Conversion) +
+			string(solidity::yul::wasm::polyfill::Interface) +
+			string(solidity::yul::wasm::polyfill::Keccak) +
+			string(solidity::yul::wasm::polyfill::Logical) +
+			string(solidity::yul::wasm::polyfill::Memory) +
+		"}", ""))};
+	Polyfill polyfill;
+	polyfill.code = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
+	if (!errors.empty())
+	{
+		string message;
+		for (auto const& err: errors)
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+		yulAssert(false, message);
+	}
+
+	for (auto const& statement: polyfill.code->statements)
+		polyfill.functions.insert(std::get<FunctionDefinition>(statement).name);
+	for (auto const& [function, callees]: CallGraphGenerator::callGraph(*polyfill.code).functionCalls)
+		for (YulString callee: callees)
+			if (polyfill.functions.count(callee))
+				polyfill.calls[function].insert(callee);
+	return polyfill;
+}
+
+/// @returns the polyfill, which is only parsed once.
+Polyfill const& getPolyfill()
+{
+	static unique_ptr<Polyfill> cachedPolyfill;
+	static YulStringRepository::ResetCallback callback{[&] { cachedPolyfill.reset(); }};
+	static mutex polyfillMutex;
+	lock_guard<mutex> lock(polyfillMutex);
+	if (!cachedPolyfill)
+		cachedPolyfill = make_unique<Polyfill>(parsePolyfill());
+	return *cachedPolyfill;
+}
+
+}
+
 Object EVMToEwasmTranslator::run(Object const& _object)
 {
-	if (!m_polyfill)
-		parsePolyfill();
+	Polyfill const& polyfill = getPolyfill();
 
 	Block ast = std::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
@@ -77,9 +140,26 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	ExpressionSplitter::run(context, ast);
 	WordSizeTransform::run(m_dialect, WasmDialect::instance(), ast, nameDispenser);
 
-	NameDisplacer{nameDispenser, m_polyfillFunctions}(ast);
-	for (auto const& st: m_polyfill->statements)
-		ast.statements.emplace_back(ASTCopier{}.translate(st));
+	NameDisplacer{nameDispenser, polyfill.functions}(ast);
+
+	// Only add the polyfill functions that are called, directly or through other polyfill functions.
+	set<YulString> usedFunctions;
+	vector<YulString> toVisit;
+	for (auto const& reference: ReferencesCounter::countReferences(ast))
+		if (polyfill.functions.count(reference.first))
+			toVisit.emplace_back(reference.first);
+	while (!toVisit.empty())
+	{
+		YulString function = toVisit.back();
+		toVisit.pop_back();
+		if (!usedFunctions.insert(function).second)
+			continue;
+		if (polyfill.calls.count(function))
+			toVisit += polyfill.calls.at(function);
+	}
+	for (auto const& st: polyfill.code->statements)
+		if (usedFunctions.count(std::get<FunctionDefinition>(st).name))
+			ast.statements.emplace_back(ASTCopier{}.translate(st));
 
 	Object ret;
 	ret.name = _object.name;
@@ -106,37 +186,9 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 		if (Object const* subObject = dynamic_cast<Object const*>(subObjectNode.get()))
 			ret.subObjects.push_back(make_shared<Object>(run(*subObject)));
 		else
-			ret.subObjects.push_back(make_shared<Data>(dynamic_cast<Data const&>(*subObjectNode)));
+			// Data is not translated, so the node can be shared with the original object.
+			ret.subObjects.push_back(subObjectNode);
 	ret.subIndexByName = _object.subIndexByName;
 
 	return ret;
 }
-
-void EVMToEwasmTranslator::parsePolyfill()
-{
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(
-		"{" +
-			string(solidity::yul::wasm::polyfill::Arithmetic) +
-			string(solidity::yul::wasm::polyfill::Bitwise) +
-			string(solidity::yul::wasm::polyfill::Comparison) +
-			string(solidity::yul::wasm::polyfill::Conversion) +
-			string(solidity::yul::wasm::polyfill::Interface) +
-			string(solidity::yul::wasm::polyfill::Keccak) +
-			string(solidity::yul::wasm::polyfill::Logical) +
-			string(solidity::yul::wasm::polyfill::Memory) +
-		"}", ""))};
-	m_polyfill = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
-	if (!errors.empty())
-	{
-		string message;
-		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
-		yulAssert(false, message);
-	}
-
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
-}
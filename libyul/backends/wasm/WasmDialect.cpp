@@ -24,6 +24,8 @@
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity::yul;
 
@@ -140,11 +142,7 @@ WasmDialect::WasmDialect()
 
 BuiltinFunction const* WasmDialect::builtin(YulString _name) const
 {
-	auto it = m_functions.find(_name);
-	if (it != m_functions.end())
-		return &it->second;
-	else
-		return nullptr;
+	return m_builtins.find(_name);
 }
 
 BuiltinFunction const* WasmDialect::discardFunction(YulString _type) const
@@ -167,6 +165,8 @@ WasmDialect const& WasmDialect::instance()
 {
 	static std::unique_ptr<WasmDialect> dialect;
 	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static mutex dialectMutex;
+	lock_guard<mutex> lock(dialectMutex);
 	if (!dialect)
 		dialect = make_unique<WasmDialect>();
 	return *dialect;
@@ -231,6 +231,7 @@ void WasmDialect::addExternals()
 	{
 		YulString name{ext.module + "." + ext.name};
 		BuiltinFunction& f = m_functions[name];
+		m_builtins.insert(name, &f);
 		f.name = name;
 		for (string const& p: ext.parameters)
 			f.parameters.emplace_back(YulString(p));
@@ -269,6 +270,7 @@ void WasmDialect::addFunction(
 {
 	YulString name{move(_name)};
 	BuiltinFunction& f = m_functions[name];
+	m_builtins.insert(name, &f);
 	f.name = name;
 	f.parameters = std::move(_params);
 	yulAssert(_returns.size() <= 1, "The Wasm 1.0 specification only allows up to 1 return value.");
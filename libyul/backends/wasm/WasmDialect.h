@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/Dialect.h>
+#include <libyul/YulStringTable.h>
 
 #include <map>
 
@@ -66,6 +67,7 @@ private:
 	);
 
 	std::map<YulString, BuiltinFunction> m_functions;
+	YulStringTable<BuiltinFunction> m_builtins;
 };
 
 }
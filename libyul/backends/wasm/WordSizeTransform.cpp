@@ -25,6 +25,7 @@
 #include <libsolutil/CommonData.h>
 
 #include <array>
+#include <limits>
 #include <map>
 #include <variant>
 
@@ -33,6 +34,103 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+namespace
+{
+
+/**
+ * Determines the variables whose value always fits into 64 bits.
+ *
+ * Every value assigned to such a variable is either a number literal below 2**64,
+ * the result of ``datasize`` or ``dataoffset`` or the value of another such variable.
+ * Function parameters and return variables are never narrow.
+ *
+ * Prerequisite: Disambiguator, ExpressionSplitter
+ */
+class NarrowVariableFinder: public ASTWalker
+{
+public:
+	static set<YulString> run(Dialect const& _dialect, Block const& _ast)
+	{
+		NarrowVariableFinder finder{_dialect};
+		finder(_ast);
+
+		set<YulString> narrow;
+		for (YulString variable: finder.m_candidates)
+			if (!finder.m_wide.count(variable))
+				narrow.insert(variable);
+
+		// Variables that are assigned the value of a variable that is not narrow are not narrow either.
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+			for (auto const& [variable, sources]: finder.m_sources)
+				if (narrow.count(variable))
+					for (YulString source: sources)
+						if (!narrow.count(source))
+						{
+							narrow.erase(variable);
+							changed = true;
+							break;
+						}
+		}
+		return narrow;
+	}
+
+	using ASTWalker::operator();
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (auto const& variable: _varDecl.variables)
+			m_candidates.insert(variable.name);
+		if (_varDecl.value)
+			for (auto const& variable: _varDecl.variables)
+				assign(variable.name, *_varDecl.value);
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		for (auto const& variable: _assignment.variableNames)
+			assign(variable.name, *_assignment.value);
+		ASTWalker::operator()(_assignment);
+	}
+
+private:
+	explicit NarrowVariableFinder(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	void assign(YulString _variable, Expression const& _value)
+	{
+		if (auto const* literal = get_if<Literal>(&_value))
+		{
+			if (valueOfLiteral(*literal) > numeric_limits<uint64_t>::max())
+				m_wide.insert(_variable);
+		}
+		else if (auto const* identifier = get_if<Identifier>(&_value))
+			m_sources[_variable].insert(identifier->name);
+		else if (auto const* functionCall = get_if<FunctionCall>(&_value))
+		{
+			BuiltinFunction const* builtin = m_dialect.builtin(functionCall->functionName.name);
+			if (!builtin || (builtin->name != "datasize"_yulstring && builtin->name != "dataoffset"_yulstring))
+				m_wide.insert(_variable);
+		}
+		else
+			m_wide.insert(_variable);
+	}
+
+	Dialect const& m_dialect;
+	/// Variables declared by variable declarations.
+	set<YulString> m_candidates;
+	/// Variables that are assigned a value that might not fit into 64 bits.
+	set<YulString> m_wide;
+	/// Variables that are assigned the values of other variables.
+	map<YulString, set<YulString>> m_sources;
+};
+
+u256 segmentOfLiteral(Literal const& _literal, size_t _depth)
+{
+	return (valueOfLiteral(_literal) >> (256 - 64 * (_depth + 1))) & std::numeric_limits<uint64_t>::max();
+}
+
+}
+
 void WordSizeTransform::operator()(FunctionDefinition& _fd)
 {
 	rewriteVarDeclList(_fd.parameters);
@@ -115,16 +213,17 @@ void WordSizeTransform::operator()(Block& _block)
 							auto newLhs = generateU64IdentifierNames(varDecl.variables[0].name);
 							vector<Statement> ret;
 							for (size_t i = 0; i < 3; i++)
-								ret.emplace_back(VariableDeclaration{
-									varDecl.location,
-									{TypedName{varDecl.location, newLhs[i], m_targetDialect.defaultType}},
-									make_unique<Expression>(Literal{
-										locationOf(*varDecl.value),
-										LiteralKind::Number,
-										"0"_yulstring,
-										m_targetDialect.defaultType
-									})
-								});
+								if (!newLhs[i].empty())
+									ret.emplace_back(VariableDeclaration{
+										varDecl.location,
+										{TypedName{varDecl.location, newLhs[i], m_targetDialect.defaultType}},
+										make_unique<Expression>(Literal{
+											locationOf(*varDecl.value),
+											LiteralKind::Number,
+											"0"_yulstring,
+											m_targetDialect.defaultType
+										})
+									});
 							ret.emplace_back(VariableDeclaration{
 								varDecl.location,
 								{TypedName{varDecl.location, newLhs[3], m_targetDialect.defaultType}},
@@ -146,12 +245,13 @@ void WordSizeTransform::operator()(Block& _block)
 					auto newLhs = generateU64IdentifierNames(varDecl.variables[0].name);
 					vector<Statement> ret;
 					for (size_t i = 0; i < 4; i++)
-						ret.emplace_back(VariableDeclaration{
-								varDecl.location,
-								{TypedName{varDecl.location, newLhs[i], m_targetDialect.defaultType}},
-								std::move(newRhs[i])
-							}
-						);
+						if (!newLhs[i].empty())
+							ret.emplace_back(VariableDeclaration{
+									varDecl.location,
+									{TypedName{varDecl.location, newLhs[i], m_targetDialect.defaultType}},
+									std::move(newRhs[i])
+								}
+							);
 					return {std::move(ret)};
 				}
 				else
@@ -176,16 +276,17 @@ void WordSizeTransform::operator()(Block& _block)
 							auto newLhs = generateU64IdentifierNames(assignment.variableNames[0].name);
 							vector<Statement> ret;
 							for (size_t i = 0; i < 3; i++)
-								ret.emplace_back(Assignment{
-									assignment.location,
-									{Identifier{assignment.location, newLhs[i]}},
-									make_unique<Expression>(Literal{
-										locationOf(*assignment.value),
-										LiteralKind::Number,
-										"0"_yulstring,
-										m_targetDialect.defaultType
-									})
-								});
+								if (!newLhs[i].empty())
+									ret.emplace_back(Assignment{
+										assignment.location,
+										{Identifier{assignment.location, newLhs[i]}},
+										make_unique<Expression>(Literal{
+											locationOf(*assignment.value),
+											LiteralKind::Number,
+											"0"_yulstring,
+											m_targetDialect.defaultType
+										})
+									});
 							ret.emplace_back(Assignment{
 								assignment.location,
 								{Identifier{assignment.location, newLhs[3]}},
@@ -204,15 +305,16 @@ void WordSizeTransform::operator()(Block& _block)
 				{
 					yulAssert(assignment.variableNames.size() == 1, "");
 					auto newRhs = expandValue(*assignment.value);
-					YulString lhsName = assignment.variableNames[0].name;
+					auto const& newLhs = m_variableMapping.at(assignment.variableNames[0].name);
 					vector<Statement> ret;
 					for (size_t i = 0; i < 4; i++)
-						ret.emplace_back(Assignment{
-								assignment.location,
-								{Identifier{assignment.location, m_variableMapping.at(lhsName)[i]}},
-								std::move(newRhs[i])
-							}
-						);
+						if (!newLhs[i].empty())
+							ret.emplace_back(Assignment{
+									assignment.location,
+									{Identifier{assignment.location, newLhs[i]}},
+									std::move(newRhs[i])
+								}
+							);
 					return {std::move(ret)};
 				}
 				else
@@ -236,17 +338,24 @@ void WordSizeTransform::run(
 {
 	// Free the name `or_bool`.
 	NameDisplacer{_nameDispenser, {"or_bool"_yulstring}}(_ast);
-	WordSizeTransform{_inputDialect, _targetDialect, _nameDispenser}(_ast);
+	WordSizeTransform{
+		_inputDialect,
+		_targetDialect,
+		_nameDispenser,
+		NarrowVariableFinder::run(_inputDialect, _ast)
+	}(_ast);
 }
 
 WordSizeTransform::WordSizeTransform(
 	Dialect const& _inputDialect,
 	Dialect const& _targetDialect,
-	NameDispenser& _nameDispenser
+	NameDispenser& _nameDispenser,
+	set<YulString> _narrowVariables
 ):
 	m_inputDialect(_inputDialect),
 	m_targetDialect(_targetDialect),
-	m_nameDispenser(_nameDispenser)
+	m_nameDispenser(_nameDispenser),
+	m_narrowVariables(std::move(_narrowVariables))
 {
 }
 
@@ -258,7 +367,8 @@ void WordSizeTransform::rewriteVarDeclList(TypedNameList& _nameList)
 		{
 			TypedNameList ret;
 			for (auto newName: generateU64IdentifierNames(_n.name))
-				ret.emplace_back(TypedName{_n.location, newName, m_targetDialect.defaultType});
+				if (!newName.empty())
+					ret.emplace_back(TypedName{_n.location, newName, m_targetDialect.defaultType});
 			return ret;
 		}
 	);
@@ -270,6 +380,7 @@ void WordSizeTransform::rewriteIdentifierList(vector<Identifier>& _ids)
 		_ids,
 		[&](Identifier const& _id) -> std::optional<vector<Identifier>>
 		{
+			yulAssert(!m_narrowVariables.count(_id.name), "");
 			vector<Identifier> ret;
 			for (auto newId: m_variableMapping.at(_id.name))
 				ret.push_back(Identifier{_id.location, newId});
@@ -292,15 +403,40 @@ vector<Statement> WordSizeTransform::handleSwitchInternal(
 		return std::move(_cases.front().body.statements);
 	}
 
+	// The current 64 bit segment is known to be zero, so only the cases with a zero segment can match.
+	if (_splitExpressions.at(_depth).empty())
+	{
+		vector<Case> matchingCases;
+		for (Case& c: _cases)
+		{
+			yulAssert(c.value, "Default case still present.");
+			if (segmentOfLiteral(*c.value, _depth) == 0)
+				matchingCases.emplace_back(std::move(c));
+		}
+		if (!matchingCases.empty())
+			return handleSwitchInternal(
+				_location,
+				_splitExpressions,
+				std::move(matchingCases),
+				_runDefaultFlag,
+				_depth + 1
+			);
+		else if (!_runDefaultFlag.empty())
+			return make_vector<Statement>(Assignment{
+				_location,
+				{{_location, _runDefaultFlag}},
+				make_unique<Expression>(Literal{_location, LiteralKind::Boolean, "true"_yulstring, m_targetDialect.boolType})
+			});
+		else
+			return {};
+	}
+
 	// Extract current 64 bit segment and group by it.
 	map<u256, vector<Case>> cases;
 	for (Case& c: _cases)
 	{
 		yulAssert(c.value, "Default case still present.");
-		cases[
-			(valueOfLiteral(*c.value) >> (256 - 64 * (_depth + 1)))	&
-			std::numeric_limits<uint64_t>::max()
-		].emplace_back(std::move(c));
+		cases[segmentOfLiteral(*c.value, _depth)].emplace_back(std::move(c));
 	}
 
 	Switch ret{
@@ -361,9 +497,16 @@ std::vector<Statement> WordSizeTransform::handleSwitch(Switch& _switch)
 			{}
 		});
 	}
+	// Segments that are known to be zero are represented by the empty string.
 	vector<YulString> splitExpressions;
 	for (auto const& expr: expandValue(*_switch.expression))
-		splitExpressions.emplace_back(std::get<Identifier>(*expr).name);
+		if (auto const* identifier = get_if<Identifier>(expr.get()))
+			splitExpressions.emplace_back(identifier->name);
+		else
+		{
+			yulAssert(valueOfLiteral(std::get<Literal>(*expr)) == 0, "");
+			splitExpressions.emplace_back();
+		}
 
 	ret += handleSwitchInternal(
 		_switch.location,
@@ -385,7 +528,7 @@ std::vector<Statement> WordSizeTransform::handleSwitch(Switch& _switch)
 array<YulString, 4> WordSizeTransform::generateU64IdentifierNames(YulString const& _s)
 {
 	yulAssert(m_variableMapping.find(_s) == m_variableMapping.end(), "");
-	for (size_t i = 0; i < 4; i++)
+	for (size_t i = m_narrowVariables.count(_s) ? 3 : 0; i < 4; i++)
 		m_variableMapping[_s][i] = m_nameDispenser.newName(YulString{_s.str() + "_" + to_string(i)});
 	return m_variableMapping[_s];
 }
@@ -397,7 +540,15 @@ array<unique_ptr<Expression>, 4> WordSizeTransform::expandValue(Expression const
 	{
 		auto const& id = std::get<Identifier>(_e);
 		for (size_t i = 0; i < 4; i++)
-			ret[i] = make_unique<Expression>(Identifier{id.location, m_variableMapping.at(id.name)[i]});
+			if (YulString name = m_variableMapping.at(id.name)[i]; !name.empty())
+				ret[i] = make_unique<Expression>(Identifier{id.location, name});
+			else
+				ret[i] = make_unique<Expression>(Literal{
+					id.location,
+					LiteralKind::Number,
+					"0"_yulstring,
+					m_targetDialect.defaultType
+				});
 	}
 	else if (holds_alternative<Literal>(_e))
 	{
@@ -27,6 +27,7 @@
 #include <liblangutil/SourceLocation.h>
 
 #include <array>
+#include <set>
 #include <vector>
 
 namespace solidity::yul
@@ -56,6 +57,12 @@ namespace solidity::yul
  * takes four u64 parameters and is supposed to return the logical disjunction
  * of them as a i32 value. If this name is already used somewhere, it is renamed.
  *
+ * Variables that are only ever assigned values known to fit into 64 bits
+ * (small number literals, ``datasize``, ``dataoffset`` or other such variables)
+ * are represented by a single u64 variable for the least significant word.
+ * Wherever the full value is needed, the three most significant words are
+ * replaced by the literal zero.
+ *
  * Prerequisite: Disambiguator, ForLoopConditionIntoBody, ExpressionSplitter
  */
 class WordSizeTransform: public ASTModifier
@@ -79,7 +86,8 @@ private:
 	explicit WordSizeTransform(
 		Dialect const& _inputDialect,
 		Dialect const& _targetDialect,
-		NameDispenser& _nameDispenser
+		NameDispenser& _nameDispenser,
+		std::set<YulString> _narrowVariables
 	);
 
 	void rewriteVarDeclList(std::vector<TypedName>&);
@@ -101,7 +109,10 @@ private:
 	Dialect const& m_inputDialect;
 	Dialect const& m_targetDialect;
 	NameDispenser& m_nameDispenser;
-	/// maps original u256 variable's name to corresponding u64 variables' names
+	/// Variables whose value always fits into 64 bits.
+	std::set<YulString> const m_narrowVariables;
+	/// maps original u256 variable's name to corresponding u64 variables' names,
+	/// the names of the most significant words of narrow variables are empty.
 	std::map<YulString, std::array<YulString, 4>> m_variableMapping;
 };
 
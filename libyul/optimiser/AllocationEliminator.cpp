@@ -0,0 +1,463 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that removes the update of the free memory pointer for allocations
+ * that do not escape.
+ */
+
+#include <libyul/optimiser/AllocationEliminator.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/FunctionCallFinder.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <optional>
+#include <variant>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// @returns the instruction called by @a _call or nullopt if it is not a call to a builtin
+/// that corresponds to an instruction.
+optional<Instruction> instructionOf(EVMDialect const& _dialect, FunctionCall const& _call)
+{
+	if (BuiltinFunctionForEVM const* builtin = _dialect.builtin(_call.functionName.name))
+		return builtin->instruction;
+	return nullopt;
+}
+
+/// @returns true if @a _instruction accesses the memory starting at its first argument
+/// and does not store its other arguments, apart from the value stored by ``mstore``
+/// and ``mstore8``.
+bool accessesMemoryAtFirstArgument(Instruction _instruction)
+{
+	switch (_instruction)
+	{
+	case Instruction::MLOAD:
+	case Instruction::MSTORE:
+	case Instruction::MSTORE8:
+	case Instruction::KECCAK256:
+	case Instruction::CALLDATACOPY:
+	case Instruction::CODECOPY:
+	case Instruction::RETURNDATACOPY:
+	case Instruction::RETURN:
+	case Instruction::REVERT:
+		return true;
+	default:
+		return isLogInstruction(_instruction);
+	}
+}
+
+/// @returns true if @a _expression is the literal 64, directly or through SSA variables.
+bool isFreeMemoryPointer(Expression const& _expression, map<YulString, Expression const*> const& _ssaValues)
+{
+	Expression const* expression = &_expression;
+	while (Identifier const* identifier = get_if<Identifier>(expression))
+		if (Expression const* const* value = util::valueOrNullptr(_ssaValues, identifier->name))
+			expression = *value;
+		else
+			return false;
+	Literal const* literal = get_if<Literal>(expression);
+	return literal && literal->kind == LiteralKind::Number && valueOfLiteral(*literal) == 64;
+}
+
+/// @returns the call of the expression statement @a _statement or nullptr.
+FunctionCall const* calledIn(Statement const& _statement)
+{
+	if (ExpressionStatement const* expressionStatement = get_if<ExpressionStatement>(&_statement))
+		return get_if<FunctionCall>(&expressionStatement->expression);
+	return nullptr;
+}
+
+/// @returns true if @a _statement is ``mstore(64, x)``.
+bool isFreeMemoryPointerUpdate(
+	EVMDialect const& _dialect,
+	map<YulString, Expression const*> const& _ssaValues,
+	Statement const& _statement
+)
+{
+	FunctionCall const* call = calledIn(_statement);
+	return
+		call &&
+		instructionOf(_dialect, *call) == Instruction::MSTORE &&
+		isFreeMemoryPointer(call->arguments.front(), _ssaValues);
+}
+
+/// @returns ``pop(x)`` for the update ``mstore(64, x)`` in @a _update.
+Statement discardNewFreeMemoryPointer(Dialect const& _dialect, Statement& _update)
+{
+	FunctionCall& call = std::get<FunctionCall>(std::get<ExpressionStatement>(_update).expression);
+	langutil::SourceLocation location = call.location;
+	return ExpressionStatement{location, FunctionCall{
+		location,
+		Identifier{location, _dialect.discardFunction({})->name},
+		util::make_vector<Expression>(move(call.arguments.at(1)))
+	}};
+}
+
+/// @returns true if @a _block unconditionally calls a terminating builtin or one of
+/// the functions @a _terminatingFunctions.
+bool terminates(Dialect const& _dialect, set<YulString> const& _terminatingFunctions, Block const& _block)
+{
+	TerminationFinder terminationFinder{_dialect};
+	for (Statement const& statement: _block.statements)
+	{
+		TerminationFinder::ControlFlow controlFlow = terminationFinder.controlFlowKind(statement);
+		if (controlFlow == TerminationFinder::ControlFlow::Terminate)
+			return true;
+		else if (controlFlow != TerminationFinder::ControlFlow::FlowOut)
+			return false;
+		else if (FunctionCall const* call = calledIn(statement))
+			if (_terminatingFunctions.count(call->functionName.name))
+				return true;
+	}
+	return false;
+}
+
+set<YulString> terminatingFunctions(Dialect const& _dialect, Block const& _ast)
+{
+	set<YulString> functions;
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (Statement const& statement: _ast.statements)
+			if (FunctionDefinition const* function = get_if<FunctionDefinition>(&statement))
+				if (!functions.count(function->name) && terminates(_dialect, functions, function->body))
+				{
+					functions.insert(function->name);
+					changed = true;
+				}
+	}
+	return functions;
+}
+
+/// @returns true if @a _function has no return variables, its last statement is ``mstore(64, x)``
+/// and its other statements do not write to memory, storage or other state unless they are
+/// conditional blocks that always terminate.
+bool updatesFreeMemoryPointerOnly(
+	EVMDialect const& _dialect,
+	map<YulString, Expression const*> const& _ssaValues,
+	map<YulString, SideEffects> const& _functionSideEffects,
+	set<YulString> const& _terminatingFunctions,
+	FunctionDefinition const& _function
+)
+{
+	vector<Statement> const& statements = _function.body.statements;
+	if (
+		!_function.returnVariables.empty() ||
+		statements.empty() ||
+		!isFreeMemoryPointerUpdate(_dialect, _ssaValues, statements.back())
+	)
+		return false;
+	for (size_t i = 0; i + 1 < statements.size(); ++i)
+	{
+		SideEffectsCollector sideEffects{_dialect, &_functionSideEffects};
+		If const* ifStatement = get_if<If>(&statements[i]);
+		if (ifStatement && terminates(_dialect, _terminatingFunctions, ifStatement->body))
+			sideEffects.visit(*ifStatement->condition);
+		else
+			sideEffects.visit(statements[i]);
+		if (
+			sideEffects.sideEffects().memory == SideEffects::Write ||
+			sideEffects.sideEffects().storage == SideEffects::Write ||
+			sideEffects.sideEffects().otherState == SideEffects::Write
+		)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * Checks whether the memory allocated by ``let p := mload(64)`` escapes or is accessed
+ * other than through ``p`` and the variables computed from it before their last use.
+ */
+class EscapeChecker
+{
+public:
+	EscapeChecker(
+		EVMDialect const& _dialect,
+		set<YulString> const& _ssaVariables,
+		map<YulString, SideEffects> const& _functionSideEffects
+	):
+		m_dialect(_dialect),
+		m_ssaVariables(_ssaVariables),
+		m_functionSideEffects(_functionSideEffects)
+	{}
+
+	/// @returns true if the update of the free memory pointer @a _statements[_update] can be
+	/// removed for the allocation of @a _pointer declared at @a _statements[_allocation].
+	bool updateRemovable(
+		YulString _pointer,
+		vector<Statement> const& _statements,
+		size_t _allocation,
+		size_t _update
+	)
+	{
+		m_aliases = {_pointer};
+		m_escapes = false;
+		size_t lastUse = _update;
+		optional<size_t> firstOtherMemoryAccess;
+		for (size_t i = _allocation + 1; i < _statements.size(); ++i)
+		{
+			m_referencesAlias = false;
+			m_otherMemoryAccess = false;
+			if (i == _update)
+				// The update itself cannot store the pointer.
+				for (Expression const& argument: calledIn(_statements[i])->arguments)
+					visit(argument);
+			else
+				visit(_statements[i]);
+			if (m_escapes)
+				return false;
+			if (m_referencesAlias)
+				lastUse = i;
+			if (m_otherMemoryAccess && !firstOtherMemoryAccess)
+				firstOtherMemoryAccess = i;
+		}
+		return !firstOtherMemoryAccess || *firstOtherMemoryAccess > lastUse;
+	}
+
+private:
+	/// @returns true if the value of @a _expression might point into the allocated memory.
+	bool visit(Expression const& _expression)
+	{
+		if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		{
+			if (!m_aliases.count(identifier->name))
+				return false;
+			m_referencesAlias = true;
+			return true;
+		}
+		else if (holds_alternative<Literal>(_expression))
+			return false;
+
+		FunctionCall const& call = std::get<FunctionCall>(_expression);
+		vector<bool> aliasArguments;
+		for (Expression const& argument: call.arguments)
+			aliasArguments.emplace_back(visit(argument));
+		bool anyAliasArgument = util::contains(aliasArguments, true);
+
+		if (BuiltinFunctionForEVM const* builtin = m_dialect.builtin(call.functionName.name))
+		{
+			if (builtin->instruction && accessesMemoryAtFirstArgument(*builtin->instruction))
+			{
+				if (!aliasArguments.front())
+					m_otherMemoryAccess = true;
+				if (
+					(*builtin->instruction == Instruction::MSTORE || *builtin->instruction == Instruction::MSTORE8) &&
+					aliasArguments.at(1)
+				)
+					m_escapes = true;
+				return false;
+			}
+			SideEffects const& sideEffects = builtin->sideEffects;
+			if (
+				sideEffects.memory == SideEffects::None &&
+				sideEffects.storage == SideEffects::None &&
+				sideEffects.otherState == SideEffects::None
+			)
+				return anyAliasArgument;
+			if (sideEffects.memory != SideEffects::None)
+				m_otherMemoryAccess = true;
+		}
+		else
+		{
+			SideEffects const* sideEffects = util::valueOrNullptr(m_functionSideEffects, call.functionName.name);
+			if (!sideEffects || sideEffects->memory != SideEffects::None)
+				m_otherMemoryAccess = true;
+		}
+		if (anyAliasArgument)
+			m_escapes = true;
+		return false;
+	}
+
+	void visit(Statement const& _statement)
+	{
+		std::visit(util::GenericVisitor{
+			[&](ExpressionStatement const& _expressionStatement) { visit(_expressionStatement.expression); },
+			[&](VariableDeclaration const& _varDecl) {
+				if (_varDecl.value && visit(*_varDecl.value))
+				{
+					if (_varDecl.variables.size() == 1 && m_ssaVariables.count(_varDecl.variables.front().name))
+						m_aliases.insert(_varDecl.variables.front().name);
+					else
+						m_escapes = true;
+				}
+			},
+			[&](Assignment const& _assignment) {
+				if (visit(*_assignment.value))
+					m_escapes = true;
+			},
+			[&](If const& _if) {
+				visit(*_if.condition);
+				visit(_if.body);
+			},
+			[&](Switch const& _switch) {
+				visit(*_switch.expression);
+				for (Case const& switchCase: _switch.cases)
+					visit(switchCase.body);
+			},
+			[&](ForLoop const& _forLoop) {
+				visit(_forLoop.pre);
+				visit(*_forLoop.condition);
+				visit(_forLoop.body);
+				visit(_forLoop.post);
+			},
+			[&](Block const& _block) { visit(_block); },
+			[&](auto const&) {}
+		}, _statement);
+	}
+
+	void visit(Block const& _block)
+	{
+		for (Statement const& statement: _block.statements)
+			visit(statement);
+	}
+
+	EVMDialect const& m_dialect;
+	set<YulString> const& m_ssaVariables;
+	map<YulString, SideEffects> const& m_functionSideEffects;
+	/// The allocated pointer and the SSA variables whose values might point into the allocated memory.
+	set<YulString> m_aliases;
+	bool m_escapes = false;
+	bool m_referencesAlias = false;
+	bool m_otherMemoryAccess = false;
+};
+
+}
+
+void AllocationEliminator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
+	if (
+		!dialect ||
+		!dialect->providesObjectAccess() ||
+		!dialect->discardFunction({}) ||
+		FunctionCallFinder::run(_ast, "memoryguard"_yulstring).empty() ||
+		MSizeFinder::containsMSize(*dialect, _ast)
+	)
+		return;
+
+	SSAValueTracker ssaValueTracker;
+	ssaValueTracker(_ast);
+	map<YulString, Expression const*> const& ssaValues = ssaValueTracker.values();
+	set<YulString> ssaVariables;
+	for (auto const& [name, value]: ssaValues)
+		ssaVariables.insert(name);
+	map<YulString, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(*dialect, CallGraphGenerator::callGraph(_ast));
+	set<YulString> terminating = terminatingFunctions(*dialect, _ast);
+	map<YulString, FunctionDefinition const*> updateFunctions;
+	for (Statement const& statement: _ast.statements)
+		if (FunctionDefinition const* function = get_if<FunctionDefinition>(&statement))
+			if (updatesFreeMemoryPointerOnly(*dialect, ssaValues, functionSideEffects, terminating, *function))
+				updateFunctions[function->name] = function;
+
+	auto isUpdate = [&](Statement const& _statement) {
+		FunctionCall const* call = calledIn(_statement);
+		return call && (
+			isFreeMemoryPointerUpdate(*dialect, ssaValues, _statement) ||
+			updateFunctions.count(call->functionName.name)
+		);
+	};
+
+	EscapeChecker escapeChecker{*dialect, ssaVariables, functionSideEffects};
+	// Copies of the functions in updateFunctions without their last statement.
+	map<YulString, YulString> functionCopies;
+	vector<Statement> newFunctions;
+	for (Statement& statement: _ast.statements)
+	{
+		FunctionDefinition* function = get_if<FunctionDefinition>(&statement);
+		if (!function)
+			continue;
+		vector<Statement>& statements = function->body.statements;
+		for (size_t allocation = 0; allocation < statements.size(); ++allocation)
+		{
+			VariableDeclaration const* varDecl = get_if<VariableDeclaration>(&statements[allocation]);
+			if (
+				!varDecl ||
+				varDecl->variables.size() != 1 ||
+				!ssaVariables.count(varDecl->variables.front().name) ||
+				!holds_alternative<FunctionCall>(*varDecl->value) ||
+				instructionOf(*dialect, std::get<FunctionCall>(*varDecl->value)) != Instruction::MLOAD ||
+				!isFreeMemoryPointer(std::get<FunctionCall>(*varDecl->value).arguments.front(), ssaValues)
+			)
+				continue;
+
+			size_t update = allocation + 1;
+			while (update < statements.size() && !isUpdate(statements[update]))
+				++update;
+			if (
+				update == statements.size() ||
+				!escapeChecker.updateRemovable(varDecl->variables.front().name, statements, allocation, update)
+			)
+				continue;
+
+			FunctionCall& call = std::get<FunctionCall>(std::get<ExpressionStatement>(statements[update]).expression);
+			if (updateFunctions.count(call.functionName.name))
+			{
+				YulString original = call.functionName.name;
+				if (!functionCopies.count(original))
+				{
+					FunctionDefinition const& originalFunction = *updateFunctions.at(original);
+					map<YulString, YulString> variableReplacements;
+					TypedNameList parameters;
+					for (TypedName const& parameter: originalFunction.parameters)
+					{
+						parameters.emplace_back(TypedName{
+							parameter.location,
+							_context.dispenser.newName(parameter.name),
+							parameter.type
+						});
+						variableReplacements[parameter.name] = parameters.back().name;
+					}
+					Block body = std::get<Block>(BodyCopier{_context.dispenser, move(variableReplacements)}(originalFunction.body));
+					body.statements.back() = discardNewFreeMemoryPointer(*dialect, body.statements.back());
+					functionCopies[original] = _context.dispenser.newName(original);
+					newFunctions.emplace_back(FunctionDefinition{
+						originalFunction.location,
+						functionCopies[original],
+						move(parameters),
+						{},
+						move(body)
+					});
+				}
+				call.functionName.name = functionCopies[original];
+			}
+			else
+				statements[update] = discardNewFreeMemoryPointer(*dialect, statements[update]);
+		}
+	}
+	_ast.statements += move(newFunctions);
+}
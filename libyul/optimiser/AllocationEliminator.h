@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libyul/optimiser/OptimiserStep.h>
+
+namespace solidity::yul
+{
+
+/**
+ * AllocationEliminator: Optimiser step that removes the update of the free memory pointer
+ * for memory that is allocated inside a function and not used after its last reference
+ * in the function, so that later allocations can reuse it.
+ *
+ * An allocation is a variable declaration ``let p := mload(64)`` at the top level of a
+ * function body that is followed, also at the top level, by an update of the free memory
+ * pointer. An update is either ``mstore(64, x)`` or a call to a function without return
+ * variables whose last statement is ``mstore(64, x)`` and whose other statements do not write
+ * to memory, storage or other state, apart from conditional blocks that always terminate
+ * (like the overflow check in ``finalize_allocation``).
+ *
+ * The update is removed if the allocated memory does not escape:
+ *  - ``p`` and the variables computed from it are only used as arguments of builtins without
+ *    side effects, of the update and of memory accesses that do not store them, i.e. they are
+ *    never stored, passed to other functions or assigned to variables that are not SSA variables.
+ *  - From the declaration of ``p`` until the last use of these variables, memory is only accessed
+ *    through them and the other functions that are called do not access memory.
+ *
+ * ``mstore(64, x)`` is replaced by ``pop(x)`` and calls to a function like the one above
+ * are replaced by calls to a copy of the function without its last statement.
+ *
+ * This relies on the memory beyond the free memory pointer not being used otherwise. Because of
+ * that, the step only runs on code that contains ``memoryguard``, like the StackLimitEvader,
+ * and that does not use ``msize``.
+ *
+ * Prerequisite: Disambiguator, FunctionHoister.
+ */
+struct AllocationEliminator
+{
+	static constexpr char const* name{"AllocationEliminator"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+};
+
+}
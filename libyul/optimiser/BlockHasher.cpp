@@ -16,7 +16,7 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 /**
- * Optimiser component that calculates hash values for block prefixes.
+ * Optimiser components that calculate hash values for block prefixes and expressions.
  */
 
 #include <libyul/optimiser/BlockHasher.h>
@@ -26,6 +26,8 @@
 
 #include <libsolutil/CommonData.h>
 
+#include <limits>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -45,14 +47,62 @@ static constexpr uint64_t compileTimeLiteralHash(char const (&_literal)[N])
 }
 }
 
+uint64_t ExpressionHasher::run(Expression const& _expression)
+{
+	ExpressionHasher expressionHasher;
+	expressionHasher.visit(_expression);
+	return expressionHasher.m_hash;
+}
+
+void ExpressionHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	hash8(static_cast<uint8_t>(_literal.kind));
+	hash64(_literal.type.hash());
+	if (_literal.kind == LiteralKind::Number)
+	{
+		// Number literals are compared by value, so "0x10" and "16" have to have the same hash.
+		u256 value = valueOfNumberLiteral(_literal);
+		for (size_t i = 0; i < 4; ++i)
+		{
+			hash64(static_cast<uint64_t>(value & u256(numeric_limits<uint64_t>::max())));
+			value >>= 64;
+		}
+	}
+	else
+		hash64(_literal.value.hash());
+}
+
+void ExpressionHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hash64(_identifier.name.hash());
+}
+
+void ExpressionHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hash64(_funCall.functionName.name.hash());
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
 std::map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
 {
 	std::map<Block const*, uint64_t> result;
-	BlockHasher blockHasher(result);
+	BlockHasher blockHasher(&result);
 	blockHasher(_block);
 	return result;
 }
 
+uint64_t BlockHasher::hash(Block const& _block)
+{
+	BlockHasher blockHasher(nullptr);
+	for (auto const& statement: _block.statements)
+		blockHasher.visit(statement);
+	return blockHasher.m_hash;
+}
+
 void BlockHasher::operator()(Literal const& _literal)
 {
 	hash64(compileTimeLiteralHash("Literal"));
@@ -186,7 +236,8 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto const& statement: _block.statements)
 		subBlockHasher.visit(statement);
 
-	m_blockHashes[&_block] = subBlockHasher.m_hash;
+	if (m_blockHashes)
+		(*m_blockHashes)[&_block] = subBlockHasher.m_hash;
 
 	hash64(subBlockHasher.m_hash);
 	hash64(subBlockHasher.m_externalReferences.size());
@@ -16,7 +16,7 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 /**
- * Optimiser component that calculates hash values for blocks.
+ * Optimiser components that calculate hash values for blocks and expressions.
  */
 #pragma once
 
@@ -27,6 +27,61 @@
 namespace solidity::yul
 {
 
+/**
+ * Base class for the hashers below, provides the FNV hash primitives.
+ */
+class ASTHasherBase: public ASTWalker
+{
+public:
+	static constexpr uint64_t fnvPrime = 1099511628211u;
+	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
+
+protected:
+	void hash8(uint8_t _value)
+	{
+		m_hash *= fnvPrime;
+		m_hash ^= _value;
+	}
+	void hash16(uint16_t _value)
+	{
+		hash8(static_cast<uint8_t>(_value & 0xFF));
+		hash8(static_cast<uint8_t>(_value >> 8));
+	}
+	void hash32(uint32_t _value)
+	{
+		hash16(static_cast<uint16_t>(_value & 0xFFFF));
+		hash16(static_cast<uint16_t>(_value >> 16));
+	}
+	void hash64(uint64_t _value)
+	{
+		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
+		hash32(static_cast<uint32_t>(_value >> 32));
+	}
+
+	uint64_t m_hash = fnvEmptyHash;
+};
+
+/**
+ * Optimiser component that calculates hash values for expressions.
+ * Expressions that are syntactically equal without renaming any variables
+ * (i.e. SyntacticallyEqual{}(_a, _b) is true) have identical hashes.
+ * Number literals are hashed by their value.
+ */
+class ExpressionHasher: public ASTHasherBase
+{
+public:
+	using ASTWalker::operator();
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionCall const& _funCall) override;
+
+	static uint64_t run(Expression const& _expression);
+
+private:
+	ExpressionHasher() = default;
+};
+
 /**
  * Optimiser component that calculates hash values for blocks.
  * Syntactically equal blocks will have identical hashes and
@@ -41,7 +96,7 @@ namespace solidity::yul
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter
  */
-class BlockHasher: public ASTWalker
+class BlockHasher: public ASTHasherBase
 {
 public:
 
@@ -62,38 +117,18 @@ public:
 	void operator()(Leave const&) override;
 	void operator()(Block const& _block) override;
 
+	/// @returns the hashes of @a _block and all non-empty blocks inside it.
 	static std::map<Block const*, uint64_t> run(Block const& _block);
-
-	static constexpr uint64_t fnvPrime = 1099511628211u;
-	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
+	/// @returns the hash @a run would assign to the non-empty block @a _block, without
+	/// storing the hashes of the blocks inside it.
+	static uint64_t hash(Block const& _block);
 
 private:
-	BlockHasher(std::map<Block const*, uint64_t>& _blockHashes): m_blockHashes(_blockHashes) {}
+	explicit BlockHasher(std::map<Block const*, uint64_t>* _blockHashes): m_blockHashes(_blockHashes) {}
 
-	void hash8(uint8_t _value)
-	{
-		m_hash *= fnvPrime;
-		m_hash ^= _value;
-	}
-	void hash16(uint16_t _value)
-	{
-		hash8(static_cast<uint8_t>(_value & 0xFF));
-		hash8(static_cast<uint8_t>(_value >> 8));
-	}
-	void hash32(uint32_t _value)
-	{
-		hash16(static_cast<uint16_t>(_value & 0xFFFF));
-		hash16(static_cast<uint16_t>(_value >> 16));
-	}
-	void hash64(uint64_t _value)
-	{
-		hash32(static_cast<uint32_t>(_value & 0xFFFFFFFF));
-		hash32(static_cast<uint32_t>(_value >> 32));
-	}
+	/// Hashes of the blocks visited so far or nullptr if they should not be stored.
+	std::map<Block const*, uint64_t>* m_blockHashes = nullptr;
 
-	std::map<Block const*, uint64_t>& m_blockHashes;
-
-	uint64_t m_hash = fnvEmptyHash;
 	struct VariableReference
 	{
 		size_t id = 0;
@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
@@ -30,6 +31,8 @@
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
 
+#include <libsolutil/CommonData.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -39,7 +42,9 @@ void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _
 {
 	CommonSubexpressionEliminator cse{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		_context.functionSideEffects ?
+			*_context.functionSideEffects :
+			SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
 	};
 	cse(_ast);
 }
@@ -94,17 +99,36 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 					_e = Identifier{locationOf(_e), value->name};
 		}
 	}
-	else
-	{
-		// TODO this search is rather inefficient.
-		for (auto const& [variable, value]: m_value)
+	else if (
+		set<YulString> const* candidates = valueOrNullptr(m_variablesByValueHash, ExpressionHasher::run(_e))
+	)
+		// The candidates are ordered like m_value, so this finds the same variable
+		// as checking all known values in order.
+		for (YulString variable: *candidates)
 		{
-			assertThrow(value.value, OptimizerException, "");
-			if (SyntacticallyEqual{}(_e, *value.value) && inScope(variable))
+			AssignedValue const* value = valueOrNullptr(m_value, variable);
+			if (!value || value->value != m_hashedValue.at(variable).first)
+				continue;
+			if (SyntacticallyEqual{}(_e, *value->value) && inScope(variable))
 			{
 				_e = Identifier{locationOf(_e), variable};
 				break;
 			}
 		}
+}
+
+void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
+{
+	DataFlowAnalyzer::assignValue(_variable, _value);
+
+	assertThrow(_value, OptimizerException, "");
+	uint64_t hash = ExpressionHasher::run(*_value);
+	auto [it, inserted] = m_hashedValue.try_emplace(_variable, _value, hash);
+	if (!inserted)
+	{
+		if (it->second.second != hash)
+			m_variablesByValueHash[it->second.second].erase(_variable);
+		it->second = {_value, hash};
 	}
+	m_variablesByValueHash[hash].insert(_variable);
 }
@@ -25,6 +25,10 @@
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <map>
+#include <set>
+#include <unordered_map>
+
 namespace solidity::yul
 {
 
@@ -52,6 +56,16 @@ private:
 protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
+
+	void assignValue(YulString _variable, Expression const* _value) override;
+
+private:
+	/// Variables whose value had the given hash when it was assigned, to find candidates
+	/// for replacement without comparing against all known values.
+	/// Entries are not removed when a value is cleared, they are validated against m_value instead.
+	std::unordered_map<uint64_t, std::set<YulString>> m_variablesByValueHash;
+	/// Value and its hash for each variable in m_variablesByValueHash.
+	std::map<YulString, std::pair<Expression const*, uint64_t>> m_hashedValue;
 };
 
 }
@@ -0,0 +1,242 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Control-flow graph of Yul code for use by optimiser analyses.
+ */
+
+#include <libyul/optimiser/ControlFlowGraph.h>
+
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/Visitor.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace solidity::yul
+{
+
+/**
+ * Builds the basic blocks of a ControlFlowGraph in one walk over the code.
+ */
+class ControlFlowGraphBuilder
+{
+public:
+	ControlFlowGraphBuilder(Dialect const& _dialect, ControlFlowGraph& _graph):
+		m_dialect(_dialect),
+		m_graph(_graph)
+	{
+		m_current = newBlock();
+	}
+
+	void build(Block const& _code)
+	{
+		handleBlock(_code);
+		m_graph.m_blocks[m_current].exit = ControlFlowGraph::BasicBlock::Exit::Return;
+	}
+
+private:
+	using BlockId = ControlFlowGraph::BlockId;
+	using Exit = ControlFlowGraph::BasicBlock::Exit;
+
+	struct Loop
+	{
+		BlockId post;
+		BlockId after;
+	};
+
+	void handleBlock(Block const& _block)
+	{
+		for (Statement const& statement: _block.statements)
+			handleStatement(statement);
+	}
+
+	void handleStatement(Statement const& _statement)
+	{
+		std::visit(util::GenericVisitor{
+			[&](ExpressionStatement const& _expressionStatement) {
+				appendStatement(_statement);
+				if (FunctionCall const* call = get_if<FunctionCall>(&_expressionStatement.expression))
+					if (BuiltinFunction const* builtin = m_dialect.builtin(call->functionName.name))
+						if (builtin->controlFlowSideEffects.terminates)
+							exitBlock(Exit::Terminate);
+			},
+			[&](Assignment const&) { appendStatement(_statement); },
+			[&](VariableDeclaration const&) { appendStatement(_statement); },
+			[&](FunctionDefinition const&) {},
+			[&](If const& _if) {
+				BlockId body = newBlock();
+				BlockId after = newBlock();
+				conditionalJump(*_if.condition, body, after);
+				m_current = body;
+				handleBlock(_if.body);
+				jump(after);
+				m_current = after;
+			},
+			[&](Switch const& _switch) {
+				BlockId switchBlock = m_current;
+				BlockId after = newBlock();
+				m_graph.m_blocks[switchBlock].exit = Exit::Switch;
+				m_graph.m_blocks[switchBlock].condition = _switch.expression.get();
+				bool hasDefault = false;
+				for (auto const& _case: _switch.cases)
+				{
+					hasDefault = hasDefault || !_case.value;
+					BlockId caseBlock = newBlock();
+					addEdge(switchBlock, caseBlock);
+					m_current = caseBlock;
+					handleBlock(_case.body);
+					jump(after);
+				}
+				if (!hasDefault)
+					addEdge(switchBlock, after);
+				m_current = after;
+			},
+			[&](ForLoop const& _for) {
+				handleBlock(_for.pre);
+				BlockId condition = newBlock();
+				BlockId body = newBlock();
+				BlockId post = newBlock();
+				BlockId after = newBlock();
+				jump(condition);
+				m_current = condition;
+				conditionalJump(*_for.condition, body, after);
+
+				m_loops.emplace_back(Loop{post, after});
+				m_current = body;
+				handleBlock(_for.body);
+				jump(post);
+				m_loops.pop_back();
+
+				m_current = post;
+				handleBlock(_for.post);
+				jump(condition);
+				m_current = after;
+			},
+			[&](Break const&) {
+				yulAssert(!m_loops.empty(), "");
+				jump(m_loops.back().after);
+				m_current = newBlock();
+			},
+			[&](Continue const&) {
+				yulAssert(!m_loops.empty(), "");
+				jump(m_loops.back().post);
+				m_current = newBlock();
+			},
+			[&](Leave const&) {
+				exitBlock(Exit::Return);
+			},
+			[&](Block const& _block) { handleBlock(_block); }
+		}, _statement);
+	}
+
+	BlockId newBlock()
+	{
+		m_graph.m_blocks.emplace_back();
+		return static_cast<BlockId>(m_graph.m_blocks.size() - 1);
+	}
+
+	void appendStatement(Statement const& _statement)
+	{
+		m_graph.m_blocks[m_current].statements.emplace_back(&_statement);
+	}
+
+	void addEdge(BlockId _from, BlockId _to)
+	{
+		m_graph.m_blocks[_from].successors.emplace_back(_to);
+		m_graph.m_blocks[_to].predecessors.emplace_back(_from);
+	}
+
+	void jump(BlockId _target)
+	{
+		m_graph.m_blocks[m_current].exit = Exit::Jump;
+		addEdge(m_current, _target);
+	}
+
+	void conditionalJump(Expression const& _condition, BlockId _nonZero, BlockId _zero)
+	{
+		m_graph.m_blocks[m_current].exit = Exit::ConditionalJump;
+		m_graph.m_blocks[m_current].condition = &_condition;
+		addEdge(m_current, _nonZero);
+		addEdge(m_current, _zero);
+	}
+
+	/// Ends the current block without successors and continues in a new, unreachable block.
+	void exitBlock(Exit _exit)
+	{
+		m_graph.m_blocks[m_current].exit = _exit;
+		m_current = newBlock();
+	}
+
+	Dialect const& m_dialect;
+	ControlFlowGraph& m_graph;
+	BlockId m_current = 0;
+	std::vector<Loop> m_loops;
+};
+
+}
+
+ControlFlowGraph ControlFlowGraph::build(Dialect const& _dialect, FunctionDefinition const& _function)
+{
+	ControlFlowGraph graph;
+	graph.m_variables = VariableNumbering::forFunction(_function);
+	ControlFlowGraphBuilder{_dialect, graph}.build(_function.body);
+	return graph;
+}
+
+ControlFlowGraph ControlFlowGraph::build(Dialect const& _dialect, Block const& _code)
+{
+	ControlFlowGraph graph;
+	graph.m_variables = VariableNumbering::forBlock(_code);
+	ControlFlowGraphBuilder{_dialect, graph}.build(_code);
+	return graph;
+}
+
+vector<ControlFlowGraph::BlockId> ControlFlowGraph::reversePostOrder() const
+{
+	vector<BlockId> postOrder;
+	vector<bool> visited(m_blocks.size(), false);
+	// Pairs of block and index of the next successor to visit.
+	vector<pair<BlockId, size_t>> stack{{entry(), 0}};
+	visited[entry()] = true;
+	while (!stack.empty())
+	{
+		auto& [block, nextSuccessor] = stack.back();
+		if (nextSuccessor < m_blocks[block].successors.size())
+		{
+			BlockId successor = m_blocks[block].successors[nextSuccessor++];
+			if (!visited[successor])
+			{
+				visited[successor] = true;
+				stack.emplace_back(successor, 0);
+			}
+		}
+		else
+		{
+			postOrder.emplace_back(block);
+			stack.pop_back();
+		}
+	}
+	reverse(postOrder.begin(), postOrder.end());
+	return postOrder;
+}
@@ -0,0 +1,112 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Control-flow graph of Yul code for use by optimiser analyses.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/VariableNumbering.h>
+#include <libyul/ASTForward.h>
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+struct Dialect;
+
+/**
+ * Control-flow graph of the body of a Yul function or of code outside of functions.
+ *
+ * Basic blocks are stored in a single vector and refer to each other by index.
+ * The statements of a basic block do not affect control flow; how control flow
+ * continues after them is described by the exit of the block and its successors.
+ * Variables are identified by dense integer ids, so that analyses on the graph can use
+ * vectors instead of maps keyed by name.
+ *
+ * Code following ``break``, ``continue``, ``leave`` or a call to a terminating builtin
+ * is placed in a block without predecessors, so not all blocks are reachable from the entry.
+ * Function definitions nested in the code are not part of the graph.
+ *
+ * The graph points into the AST it was built from and has to be rebuilt whenever that AST
+ * is modified.
+ *
+ * Prerequisite: Disambiguator
+ */
+class ControlFlowGraph
+{
+public:
+	using BlockId = uint32_t;
+	using VariableId = VariableNumbering::VariableId;
+
+	struct BasicBlock
+	{
+		enum class Exit
+		{
+			/// Continue with the only successor.
+			Jump,
+			/// Continue with the first successor if ``condition`` is nonzero, with the second otherwise.
+			ConditionalJump,
+			/// Continue with the successor of the case matching ``condition``. There is one
+			/// successor per case in the order of the cases, followed by the block after the
+			/// switch if there is no default case.
+			Switch,
+			/// Return from the function, or stop if outside of a function.
+			Return,
+			/// Terminate through a builtin like ``revert`` or ``return``.
+			Terminate
+		};
+
+		/// The statements in execution order. They are never control-flow statements.
+		std::vector<Statement const*> statements;
+		Exit exit = Exit::Jump;
+		/// The condition of a conditional jump or the expression of a switch.
+		Expression const* condition = nullptr;
+		std::vector<BlockId> successors;
+		std::vector<BlockId> predecessors;
+	};
+
+	static ControlFlowGraph build(Dialect const& _dialect, FunctionDefinition const& _function);
+	static ControlFlowGraph build(Dialect const& _dialect, Block const& _code);
+
+	std::vector<BasicBlock> const& blocks() const { return m_blocks; }
+	BasicBlock const& block(BlockId _id) const { return m_blocks.at(_id); }
+	static constexpr BlockId entry() { return 0; }
+
+	/// @returns the blocks reachable from the entry in reverse post-order, i.e. each block
+	/// is listed before its successors unless the edge to the successor closes a loop.
+	std::vector<BlockId> reversePostOrder() const;
+
+	/// @returns the numbering of the variables declared (including function parameters and
+	/// return variables) or referenced in the code.
+	VariableNumbering const& variables() const { return m_variables; }
+	size_t variableCount() const { return m_variables.size(); }
+	YulString variableName(VariableId _id) const { return m_variables.name(_id); }
+	std::optional<VariableId> variableId(YulString _name) const { return m_variables.id(_name); }
+
+private:
+	friend class ControlFlowGraphBuilder;
+
+	std::vector<BasicBlock> m_blocks;
+	VariableNumbering m_variables;
+};
+
+}
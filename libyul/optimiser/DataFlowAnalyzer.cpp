@@ -29,7 +29,6 @@
 #include <libyul/Exceptions.h>
 
 #include <libsolutil/CommonData.h>
-#include <libsolutil/cxx20.h>
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
@@ -40,6 +39,21 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::yul;
 
+CopyOnWriteKnowledge::Map const& CopyOnWriteKnowledge::get() const
+{
+	static Map const empty;
+	return m_data ? *m_data : empty;
+}
+
+CopyOnWriteKnowledge::Map& CopyOnWriteKnowledge::modify()
+{
+	if (!m_data)
+		m_data = make_shared<Map>();
+	else if (m_data.use_count() > 1)
+		m_data = make_shared<Map>(*m_data);
+	return *m_data;
+}
+
 DataFlowAnalyzer::DataFlowAnalyzer(
 	Dialect const& _dialect,
 	map<YulString, SideEffects> _functionSideEffects
@@ -63,20 +77,20 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 	if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_storage, mapTuple([&](auto&& key, auto&& value) {
+		m_storage.eraseIf([&](YulString _key, YulString _value) {
 			return
-				!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
-				!m_knowledgeBase.knownToBeEqual(vars->second, value);
-		}));
-		m_storage[vars->first] = vars->second;
+				!m_knowledgeBase.knownToBeDifferent(vars->first, _key) &&
+				!m_knowledgeBase.knownToBeEqual(vars->second, _value);
+		});
+		m_storage.modify()[vars->first] = vars->second;
 	}
 	else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_memory, mapTuple([&](auto&& key, auto&& /* value */) {
-			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
-		}));
-		m_memory[vars->first] = vars->second;
+		m_memory.eraseIf([&](YulString _key, YulString /* _value */) {
+			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, _key);
+		});
+		m_memory.modify()[vars->first] = vars->second;
 	}
 	else
 	{
@@ -115,8 +129,8 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	unordered_map<YulString, YulString> storage = m_storage;
-	unordered_map<YulString, YulString> memory = m_memory;
+	CopyOnWriteKnowledge storage = m_storage;
+	CopyOnWriteKnowledge memory = m_memory;
 
 	ASTModifier::operator()(_if);
 
@@ -134,8 +148,8 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		unordered_map<YulString, YulString> storage = m_storage;
-		unordered_map<YulString, YulString> memory = m_memory;
+		CopyOnWriteKnowledge storage = m_storage;
+		CopyOnWriteKnowledge memory = m_memory;
 		(*this)(_case.body);
 		joinKnowledge(storage, memory);
 
@@ -158,13 +172,16 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	map<YulString, AssignedValue> value;
 	size_t loopDepth{0};
 	unordered_map<YulString, set<YulString>> references;
-	unordered_map<YulString, YulString> storage;
-	unordered_map<YulString, YulString> memory;
+	unordered_map<YulString, set<YulString>> referencedBy;
+	CopyOnWriteKnowledge storage;
+	CopyOnWriteKnowledge memory;
 	swap(m_value, value);
 	swap(m_loopDepth, loopDepth);
 	swap(m_references, references);
+	swap(m_referencedBy, referencedBy);
 	swap(m_storage, storage);
 	swap(m_memory, memory);
+	m_knowledgeBase.clearCache();
 	pushScope(true);
 
 	for (auto const& parameter: _fun.parameters)
@@ -184,8 +201,10 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	swap(m_value, value);
 	swap(m_loopDepth, loopDepth);
 	swap(m_references, references);
+	swap(m_referencedBy, referencedBy);
 	swap(m_storage, storage);
 	swap(m_memory, memory);
+	m_knowledgeBase.clearCache();
 }
 
 void DataFlowAnalyzer::operator()(ForLoop& _for)
@@ -254,19 +273,15 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 
 	auto const& referencedVariables = movableChecker.referencedVariables();
 	for (auto const& name: _variables)
+		setReferences(name, referencedVariables);
+	if (!_isDeclaration)
 	{
-		m_references[name] = referencedVariables;
-		if (!_isDeclaration)
-		{
-			// assignment to slot denoted by "name"
-			m_storage.erase(name);
-			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
-			// assignment to slot denoted by "name"
-			m_memory.erase(name);
-			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
-		}
+		// assignment to slots denoted by the variables or to slot contents denoted by the variables
+		auto isAssigned = [&_variables](YulString _key, YulString _value) {
+			return _variables.count(_key) || _variables.count(_value);
+		};
+		m_storage.eraseIf(isAssigned);
+		m_memory.eraseIf(isAssigned);
 	}
 
 	if (_value && _variables.size() == 1)
@@ -278,9 +293,9 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_memory[*key] = variable;
+				m_memory.modify()[*key] = variable;
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_storage[*key] = variable;
+				m_storage.modify()[*key] = variable;
 		}
 	}
 }
@@ -295,7 +310,8 @@ void DataFlowAnalyzer::popScope()
 	for (auto const& name: m_variableScopes.back().variables)
 	{
 		m_value.erase(name);
-		m_references.erase(name);
+		m_knowledgeBase.valueChanged(name);
+		eraseReferences(name);
 	}
 	m_variableScopes.pop_back();
 }
@@ -318,29 +334,55 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	// First clear storage knowledge, because we do not have to clear
 	// storage knowledge of variables whose expression has changed,
 	// since the value is still unchanged.
-	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
-		return _variables.count(key) || _variables.count(value);
-	});
-	cxx20::erase_if(m_storage, eraseCondition);
-	cxx20::erase_if(m_memory, eraseCondition);
+	auto eraseCondition = [&_variables](YulString _key, YulString _value) {
+		return _variables.count(_key) || _variables.count(_value);
+	};
+	m_storage.eraseIf(eraseCondition);
+	m_memory.eraseIf(eraseCondition);
 
 	// Also clear variables that reference variables to be cleared.
 	for (auto const& variableToClear: _variables)
-		for (auto const& [ref, names]: m_references)
-			if (names.count(variableToClear))
-				_variables.emplace(ref);
+		if (set<YulString> const* referencingVariables = valueOrNullptr(m_referencedBy, variableToClear))
+			_variables += *referencingVariables;
 
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables)
 	{
 		m_value.erase(name);
-		m_references.erase(name);
+		m_knowledgeBase.valueChanged(name);
+		eraseReferences(name);
 	}
 }
 
 void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value)
 {
 	m_value[_variable] = {_value, m_loopDepth};
+	m_knowledgeBase.valueChanged(_variable);
+}
+
+void DataFlowAnalyzer::setReferences(YulString _variable, set<YulString> const& _referencedVariables)
+{
+	eraseReferences(_variable);
+	for (YulString referencedVariable: _referencedVariables)
+		m_referencedBy[referencedVariable].emplace(_variable);
+	m_references[_variable] = _referencedVariables;
+}
+
+void DataFlowAnalyzer::eraseReferences(YulString _variable)
+{
+	auto it = m_references.find(_variable);
+	if (it == m_references.end())
+		return;
+	for (YulString referencedVariable: it->second)
+	{
+		auto referencedBy = m_referencedBy.find(referencedVariable);
+		if (referencedBy == m_referencedBy.end())
+			continue;
+		referencedBy->second.erase(_variable);
+		if (referencedBy->second.empty())
+			m_referencedBy.erase(referencedBy);
+	}
+	m_references.erase(it);
 }
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
@@ -362,8 +404,8 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 }
 
 void DataFlowAnalyzer::joinKnowledge(
-	unordered_map<YulString, YulString> const& _olderStorage,
-	unordered_map<YulString, YulString> const& _olderMemory
+	CopyOnWriteKnowledge const& _olderStorage,
+	CopyOnWriteKnowledge const& _olderMemory
 )
 {
 	joinKnowledgeHelper(m_storage, _olderStorage);
@@ -371,18 +413,21 @@ void DataFlowAnalyzer::joinKnowledge(
 }
 
 void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulString, YulString>& _this,
-	std::unordered_map<YulString, YulString> const& _older
+	CopyOnWriteKnowledge& _this,
+	CopyOnWriteKnowledge const& _older
 )
 {
+	if (_this.sharesContentsWith(_older))
+		return;
 	// We clear if the key does not exist in the older map or if the value is different.
 	// This also works for memory because _older is an "older version"
 	// of m_memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulString const* oldValue = valueOrNullptr(_older, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	CopyOnWriteKnowledge::Map const& older = _older.get();
+	_this.eraseIf([&older](YulString _key, YulString _currentValue) {
+		YulString const* oldValue = valueOrNullptr(older, _key);
+		return !oldValue || *oldValue != _currentValue;
+	});
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
@@ -30,13 +30,60 @@
 #include <libyul/SideEffects.h>
 
 #include <map>
+#include <memory>
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
 struct Dialect;
 struct SideEffects;
 
+/**
+ * Map from variable names to variable names used for the knowledge about storage and memory.
+ * Copies share their contents until one of them is modified, so that saving the knowledge
+ * at the start of a control-flow branch is cheap and joining it with an unmodified branch
+ * is a pointer comparison.
+ */
+class CopyOnWriteKnowledge
+{
+public:
+	using Map = std::unordered_map<YulString, YulString>;
+
+	Map const& get() const;
+	/// @returns the contents for modification, copying them first if they are shared.
+	Map& modify();
+	/// Removes all entries for which @a _predicate(key, value) is true.
+	/// Does not copy shared contents if no entry is removed.
+	template <class Predicate>
+	void eraseIf(Predicate const& _predicate);
+	void clear() { m_data.reset(); }
+	/// @returns true if the two objects are known to have equal contents
+	/// because neither was modified since one was copied from the other.
+	bool sharesContentsWith(CopyOnWriteKnowledge const& _other) const { return m_data == _other.m_data; }
+
+private:
+	std::shared_ptr<Map> m_data;
+};
+
+template <class Predicate>
+void CopyOnWriteKnowledge::eraseIf(Predicate const& _predicate)
+{
+	if (!m_data)
+		return;
+	for (auto const& [key, value]: *m_data)
+		if (_predicate(key, value))
+		{
+			Map& data = modify();
+			for (auto it = data.begin(); it != data.end();)
+				if (_predicate(it->first, it->second))
+					it = data.erase(it);
+				else
+					++it;
+			return;
+		}
+}
+
 /// Value assigned to a variable.
 struct AssignedValue
 {
@@ -110,7 +157,12 @@ protected:
 	/// for example at points where control flow is merged.
 	void clearValues(std::set<YulString> _names);
 
-	void assignValue(YulString _variable, Expression const* _value);
+	virtual void assignValue(YulString _variable, Expression const* _value);
+
+	/// Sets the variables referenced by the value of @a _variable and updates m_referencedBy.
+	void setReferences(YulString _variable, std::set<YulString> const& _referencedVariables);
+	/// Removes the variables referenced by the value of @a _variable and updates m_referencedBy.
+	void eraseReferences(YulString _variable);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the block.
 	void clearKnowledgeIfInvalidated(Block const& _block);
@@ -122,13 +174,13 @@ protected:
 	/// This only works if the current state is a direct successor of the older point,
 	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
 	void joinKnowledge(
-		std::unordered_map<YulString, YulString> const& _olderStorage,
-		std::unordered_map<YulString, YulString> const& _olderMemory
+		CopyOnWriteKnowledge const& _olderStorage,
+		CopyOnWriteKnowledge const& _olderMemory
 	);
 
 	static void joinKnowledgeHelper(
-		std::unordered_map<YulString, YulString>& _thisData,
-		std::unordered_map<YulString, YulString> const& _olderData
+		CopyOnWriteKnowledge& _thisData,
+		CopyOnWriteKnowledge const& _olderData
 	);
 
 	/// Returns true iff the variable is in scope.
@@ -162,10 +214,13 @@ protected:
 	/// Current values of variables, always movable.
 	std::map<YulString, AssignedValue> m_value;
 	/// m_references[a].contains(b) <=> the current expression assigned to a references b
+	/// Only modify through setReferences() and eraseReferences().
 	std::unordered_map<YulString, std::set<YulString>> m_references;
+	/// Inverse of m_references: m_referencedBy[b].contains(a) <=> m_references[a].contains(b)
+	std::unordered_map<YulString, std::set<YulString>> m_referencedBy;
 
-	std::unordered_map<YulString, YulString> m_storage;
-	std::unordered_map<YulString, YulString> m_memory;
+	CopyOnWriteKnowledge m_storage;
+	CopyOnWriteKnowledge m_memory;
 
 	KnowledgeBase m_knowledgeBase;
 
@@ -29,7 +29,9 @@ using namespace solidity::yul;
 
 void EquivalentFunctionCombiner::run(OptimiserStepContext&, Block& _ast)
 {
-	EquivalentFunctionCombiner{EquivalentFunctionDetector::run(_ast)}(_ast);
+	map<YulString, FunctionDefinition const*> duplicates = EquivalentFunctionDetector::run(_ast);
+	if (!duplicates.empty())
+		EquivalentFunctionCombiner{std::move(duplicates)}(_ast);
 }
 
 void EquivalentFunctionCombiner::operator()(FunctionCall& _funCall)
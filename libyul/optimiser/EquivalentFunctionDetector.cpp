@@ -31,8 +31,9 @@ using namespace solidity::yul;
 
 void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 {
-	uint64_t bodyHash = m_blockHashes[&_fun.body];
-	auto& candidates = m_candidates[bodyHash];
+	// Only the hashes of the function bodies are needed, so the hashes of the
+	// blocks inside them are not stored.
+	auto& candidates = m_candidates[BlockHasher::hash(_fun.body)];
 	for (auto const& candidate: candidates)
 		if (SyntacticallyEqual{}.statementEqual(_fun, *candidate))
 		{
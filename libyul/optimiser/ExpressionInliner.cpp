@@ -38,7 +38,7 @@ void ExpressionInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
 	InlinableExpressionFunctionFinder funFinder;
 	funFinder(_ast);
-	ExpressionInliner inliner{_context.dialect, funFinder.inlinableFunctions()};
+	ExpressionInliner inliner{_context.dialect, funFinder.inlinableFunctions(), _context.gasMeter};
 	inliner(_ast);
 }
 
@@ -67,9 +67,7 @@ void ExpressionInliner::visit(Expression& _expression)
 				return;
 
 			size_t refs = ReferencesCounter::countReferences(fun.body)[paraName];
-			size_t cost = CodeCost::codeCost(m_dialect, arg);
-
-			if (refs > 1 && cost > 1)
+			if (refs > 1 && !DuplicationCost::cheapToDuplicate(m_dialect, m_meter, arg, refs, 1))
 				return;
 
 			substitutions[paraName] = &arg;
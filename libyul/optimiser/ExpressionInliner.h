@@ -30,6 +30,7 @@ namespace solidity::yul
 {
 struct Dialect;
 struct OptimiserStepContext;
+class GasMeter;
 
 /**
  * Optimiser component that modifies an AST in place, inlining functions that can be
@@ -41,7 +42,8 @@ struct OptimiserStepContext;
  * Furthermore, for all parameters, all of the following need to be true
  *  - the argument is movable
  *  - the parameter is either referenced less than twice in the function body, or the argument is rather cheap
- *    ("cost" of at most 1 like a constant up to 0xff)
+ *    ("cost" of at most 1 like a constant up to 0xff), or, if the step context provides
+ *    a gas meter, duplicating it is not more expensive in gas than keeping it on the stack
  *
  * This component can only be used on sources with unique names.
  */
@@ -59,12 +61,14 @@ public:
 private:
 	ExpressionInliner(
 		Dialect const& _dialect,
-		std::map<YulString, FunctionDefinition const*> const& _inlinableFunctions
-	): m_dialect(_dialect), m_inlinableFunctions(_inlinableFunctions)
+		std::map<YulString, FunctionDefinition const*> const& _inlinableFunctions,
+		GasMeter const* _meter
+	): m_dialect(_dialect), m_inlinableFunctions(_inlinableFunctions), m_meter(_meter)
 	{}
 
 	Dialect const& m_dialect;
 	std::map<YulString, FunctionDefinition const*> const& m_inlinableFunctions;
+	GasMeter const* m_meter = nullptr;
 
 	std::map<YulString, YulString> m_varReplacements;
 	/// Set of functions we are currently visiting inside.
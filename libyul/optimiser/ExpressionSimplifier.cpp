@@ -23,6 +23,7 @@
 
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/OptimiserStepProfiler.h>
 #include <libyul/AST.h>
 
 using namespace std;
@@ -39,5 +40,9 @@ void ExpressionSimplifier::visit(Expression& _expression)
 	ASTModifier::visit(_expression);
 
 	while (auto const* match = SimplificationRules::findFirstMatch(_expression, m_dialect, m_value))
+	{
+		if (OptimiserStepProfiler::instance().enabled())
+			OptimiserStepProfiler::instance().recordRuleApplication(match->pattern.toString());
 		_expression = match->action().toExpression(locationOf(_expression));
+	}
 }
@@ -45,6 +45,13 @@ void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
+	if (!inliner.m_movedFunctions.empty())
+		util::iterateReplacing(_ast.statements, [&](Statement& _statement) -> optional<vector<Statement>> {
+			FunctionDefinition const* function = get_if<FunctionDefinition>(&_statement);
+			if (function && inliner.m_movedFunctions.count(function->name))
+				return vector<Statement>{};
+			return nullopt;
+		});
 }
 
 FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
@@ -71,6 +78,7 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 		// Always inline functions that are only called once.
 		if (references[fun.name] == 1)
 			m_singleUse.emplace(fun.name);
+		m_references[fun.name] = references[fun.name];
 		updateCodeSize(fun);
 	}
 }
@@ -204,6 +212,25 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _callSite)
 {
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
+	// Code is about to be inlined into the call site, which could add a call to itself.
+	m_recursive.erase(_callSite);
+}
+
+bool FullInliner::removeInlinedCall(YulString _function)
+{
+	size_t& references = m_references.at(_function);
+	yulAssert(references > 0, "");
+	if (--references > 0)
+		return false;
+	m_movedFunctions.insert(_function);
+	return true;
+}
+
+void FullInliner::addReferences(Block const& _code)
+{
+	for (auto const& [name, count]: ReferencesCounter::countReferences(_code))
+		if (size_t* references = util::valueOrNullptr(m_references, name))
+			*references += count;
 }
 
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
@@ -216,10 +243,12 @@ void FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
 	InlineModifier{*this, m_nameDispenser, _currentFunctionName, m_dialect}(_block);
 }
 
-bool FullInliner::recursive(FunctionDefinition const& _fun) const
+bool FullInliner::recursive(FunctionDefinition const& _fun)
 {
+	if (bool const* cached = util::valueOrNullptr(m_recursive, _fun.name))
+		return *cached;
 	map<YulString, size_t> references = ReferencesCounter::countReferences(_fun);
-	return references[_fun.name] > 0;
+	return m_recursive[_fun.name] = references[_fun.name] > 0;
 }
 
 void InlineModifier::operator()(Block& _block)
@@ -260,6 +289,13 @@ vector<Statement> InlineModifier::performInline(Statement& _statement, FunctionC
 
 	FunctionDefinition* function = m_driver.function(_funCall.functionName.name);
 	assertThrow(!!function, OptimizerException, "Attempt to inline invalid function.");
+	// One declaration per parameter and return variable, the body and at most
+	// one assignment or declaration per return variable.
+	newStatements.reserve(
+		function->parameters.size() +
+		2 * function->returnVariables.size() +
+		function->body.statements.size()
+	);
 
 	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
 
@@ -281,8 +317,20 @@ vector<Statement> InlineModifier::performInline(Statement& _statement, FunctionC
 	for (auto const& var: function->returnVariables)
 		newVariable(var, nullptr);
 
-	Statement newBody = BodyCopier(m_nameDispenser, variableReplacements)(function->body);
-	newStatements += std::move(std::get<Block>(newBody).statements);
+	if (m_driver.removeInlinedCall(function->name))
+	{
+		// No other calls remain, so the function is removed and its body can be taken over.
+		Block body = std::move(function->body);
+		function->body.statements.clear();
+		BodyRenamer(m_nameDispenser, variableReplacements)(body);
+		newStatements += std::move(body.statements);
+	}
+	else
+	{
+		Statement newBody = BodyCopier(m_nameDispenser, variableReplacements)(function->body);
+		m_driver.addReferences(std::get<Block>(newBody));
+		newStatements += std::move(std::get<Block>(newBody).statements);
+	}
 
 	std::visit(util::GenericVisitor{
 		util::VisitorFallback<>{},
@@ -335,3 +383,21 @@ YulString BodyCopier::translateIdentifier(YulString _name)
 	else
 		return _name;
 }
+
+void BodyRenamer::operator()(VariableDeclaration& _varDecl)
+{
+	for (TypedName& var: _varDecl.variables)
+		var.name = m_variableReplacements[var.name] = m_nameDispenser.newName(var.name);
+	ASTModifier::operator()(_varDecl);
+}
+
+void BodyRenamer::operator()(FunctionDefinition&)
+{
+	assertThrow(false, OptimizerException, "Function hoisting has to be done before function inlining.");
+}
+
+void BodyRenamer::operator()(Identifier& _identifier)
+{
+	if (YulString const* replacement = util::valueOrNullptr(m_variableReplacements, _identifier.name))
+		_identifier.name = *replacement;
+}
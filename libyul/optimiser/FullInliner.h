@@ -64,6 +64,10 @@ class NameCollector;
  * code of f, with replacements: a -> f_a, b -> f_b, c -> f_c
  * let z := f_c
  *
+ * The body of a function is copied for every call that is inlined, except for the
+ * last remaining call of the function, to which the body is moved instead. Functions
+ * whose body was moved are removed.
+ *
  * Prerequisites: Disambiguator
  * More efficient if run after: Function Hoister, Expression Splitter
  */
@@ -90,6 +94,14 @@ public:
 	/// should be determined after inlining is completed.
 	void tentativelyUpdateCodeSize(YulString _function, YulString _callSite);
 
+	/// Removes a call to @a _function that is about to be inlined from the reference counts.
+	/// @returns true if it was the last reference to the function, in which case the body of
+	/// the function is moved to the call site and the function is removed at the end.
+	bool removeInlinedCall(YulString _function);
+	/// Adds the function calls in @a _code, a copy of the body of an inlined function,
+	/// to the reference counts.
+	void addReferences(Block const& _code);
+
 private:
 	enum Pass { InlineTiny, InlineRest };
 
@@ -102,7 +114,9 @@ private:
 
 	void updateCodeSize(FunctionDefinition const& _fun);
 	void handleBlock(YulString _currentFunctionName, Block& _block);
-	bool recursive(FunctionDefinition const& _fun) const;
+	/// @returns true if @a _fun calls itself directly. The result is cached until
+	/// code is inlined into the function.
+	bool recursive(FunctionDefinition const& _fun);
 
 	Pass m_pass;
 	/// The AST to be modified. The root block itself will not be modified, because
@@ -116,6 +130,12 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// Cached results of recursive().
+	std::map<YulString, bool> m_recursive;
+	/// Number of references to each function in the whole AST, kept up to date while inlining.
+	std::map<YulString, size_t> m_references;
+	/// Functions whose body was moved to the site of their last call.
+	std::set<YulString> m_movedFunctions;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
@@ -173,5 +193,32 @@ public:
 	std::map<YulString, YulString> m_variableReplacements;
 };
 
+/**
+ * Counterpart of the BodyCopier for a body that is moved to the site of the last call of
+ * its function: Applies the same replacements in place, creating new names for variable
+ * declarations in the same order as the BodyCopier.
+ */
+class BodyRenamer: public ASTModifier
+{
+public:
+	BodyRenamer(
+		NameDispenser& _nameDispenser,
+		std::map<YulString, YulString> _variableReplacements
+	):
+		m_nameDispenser(_nameDispenser),
+		m_variableReplacements(std::move(_variableReplacements))
+	{}
+
+	using ASTModifier::operator();
+
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(FunctionDefinition& _funDef) override;
+	void operator()(Identifier& _identifier) override;
+
+private:
+	NameDispenser& m_nameDispenser;
+	std::map<YulString, YulString> m_variableReplacements;
+};
+
 
 }
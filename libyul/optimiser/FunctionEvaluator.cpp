@@ -0,0 +1,331 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that evaluates calls of functions with literal arguments at compile time.
+ */
+
+#include <libyul/optimiser/FunctionEvaluator.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <optional>
+#include <variant>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Thrown if the code cannot be evaluated at compile time.
+struct NotEvaluable {};
+
+/**
+ * Interpreter for functions that only use builtins which the simplification rules evaluate
+ * to constants. The builtins are evaluated by applying the simplification rules to calls
+ * with literal arguments, so they have the same semantics as in the ExpressionSimplifier.
+ * Any other builtin, e.g. one that reads or writes state, aborts the evaluation, so a call
+ * that is evaluated successfully is free of side effects and does not depend on any state.
+ */
+class Evaluator
+{
+public:
+	Evaluator(
+		Dialect const& _dialect,
+		map<YulString, FunctionDefinition const*> const& _functions
+	):
+		m_dialect(_dialect),
+		m_functions(_functions)
+	{}
+
+	/// @returns the values of the return variables of @a _function called with @a _arguments,
+	/// or nullopt if the call cannot be evaluated or takes more than MaxSteps steps.
+	optional<vector<u256>> call(FunctionDefinition const& _function, vector<u256> const& _arguments)
+	{
+		m_steps = 0;
+		m_callDepth = 0;
+		try
+		{
+			return callFunction(_function, _arguments);
+		}
+		catch (NotEvaluable const&)
+		{
+			return nullopt;
+		}
+	}
+
+private:
+	enum class ControlFlow { Default, Break, Continue, Leave };
+
+	/// Maximum number of statements and calls executed to evaluate a single call.
+	static size_t constexpr MaxSteps = 10000;
+	static size_t constexpr MaxCallDepth = 64;
+
+	void countStep()
+	{
+		if (++m_steps > MaxSteps)
+			throw NotEvaluable{};
+	}
+
+	vector<u256> callFunction(FunctionDefinition const& _function, vector<u256> const& _arguments)
+	{
+		yulAssert(_arguments.size() == _function.parameters.size(), "");
+		if (++m_callDepth > MaxCallDepth)
+			throw NotEvaluable{};
+
+		map<YulString, u256> variables;
+		for (size_t i = 0; i < _arguments.size(); ++i)
+			variables[_function.parameters[i].name] = _arguments[i];
+		for (TypedName const& returnVariable: _function.returnVariables)
+			variables[returnVariable.name] = 0;
+		swap(variables, m_variables);
+		execute(_function.body);
+		swap(variables, m_variables);
+
+		--m_callDepth;
+		return applyMap(_function.returnVariables, [&](TypedName const& _variable) {
+			return variables.at(_variable.name);
+		});
+	}
+
+	ControlFlow execute(Block const& _block)
+	{
+		for (Statement const& statement: _block.statements)
+			if (ControlFlow flow = execute(statement); flow != ControlFlow::Default)
+				return flow;
+		return ControlFlow::Default;
+	}
+
+	ControlFlow execute(Statement const& _statement)
+	{
+		countStep();
+		return std::visit(GenericVisitor{
+			[&](ExpressionStatement const& _expressionStatement) {
+				FunctionCall const* call = get_if<FunctionCall>(&_expressionStatement.expression);
+				if (!call || m_dialect.builtin(call->functionName.name))
+					throw NotEvaluable{};
+				evaluateCall(*call);
+				return ControlFlow::Default;
+			},
+			[&](Assignment const& _assignment) {
+				assign(_assignment.variableNames, *_assignment.value);
+				return ControlFlow::Default;
+			},
+			[&](VariableDeclaration const& _declaration) {
+				if (_declaration.value)
+					assign(_declaration.variables, *_declaration.value);
+				else
+					for (TypedName const& variable: _declaration.variables)
+						m_variables[variable.name] = 0;
+				return ControlFlow::Default;
+			},
+			[&](If const& _if) {
+				if (evaluate(*_if.condition) != 0)
+					return execute(_if.body);
+				return ControlFlow::Default;
+			},
+			[&](Switch const& _switch) {
+				u256 value = evaluate(*_switch.expression);
+				Case const* selected = nullptr;
+				for (Case const& switchCase: _switch.cases)
+					if (!switchCase.value)
+						selected = &switchCase;
+					else if (valueOfLiteral(*switchCase.value) == value)
+					{
+						selected = &switchCase;
+						break;
+					}
+				return selected ? execute(selected->body) : ControlFlow::Default;
+			},
+			[&](ForLoop const& _forLoop) {
+				execute(_forLoop.pre);
+				while (true)
+				{
+					countStep();
+					if (evaluate(*_forLoop.condition) == 0)
+						break;
+					ControlFlow flow = execute(_forLoop.body);
+					if (flow == ControlFlow::Break)
+						break;
+					if (flow == ControlFlow::Leave)
+						return flow;
+					execute(_forLoop.post);
+				}
+				return ControlFlow::Default;
+			},
+			[&](Break const&) { return ControlFlow::Break; },
+			[&](Continue const&) { return ControlFlow::Continue; },
+			[&](Leave const&) { return ControlFlow::Leave; },
+			[&](Block const& _block) { return execute(_block); },
+			[&](FunctionDefinition const&) { return ControlFlow::Default; }
+		}, _statement);
+	}
+
+	template <typename Variable>
+	void assign(vector<Variable> const& _variables, Expression const& _value)
+	{
+		vector<u256> values;
+		if (FunctionCall const* call = get_if<FunctionCall>(&_value))
+			values = evaluateCall(*call);
+		else
+			values = {evaluate(_value)};
+		yulAssert(values.size() == _variables.size(), "");
+		for (size_t i = 0; i < values.size(); ++i)
+			m_variables[_variables[i].name] = values[i];
+	}
+
+	u256 evaluate(Expression const& _expression)
+	{
+		return std::visit(GenericVisitor{
+			[&](Literal const& _literal) { return valueOfLiteral(_literal); },
+			[&](Identifier const& _identifier) { return m_variables.at(_identifier.name); },
+			[&](FunctionCall const& _call) {
+				vector<u256> values = evaluateCall(_call);
+				yulAssert(values.size() == 1, "");
+				return values.front();
+			}
+		}, _expression);
+	}
+
+	vector<u256> evaluateCall(FunctionCall const& _call)
+	{
+		countStep();
+		vector<u256> arguments(_call.arguments.size());
+		// Arguments are evaluated from right to left.
+		for (size_t i = arguments.size(); i > 0; --i)
+			arguments[i - 1] = evaluate(_call.arguments[i - 1]);
+
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_call.functionName.name))
+			return {evaluateBuiltin(_call, *builtin, arguments)};
+
+		auto function = m_functions.find(_call.functionName.name);
+		if (function == m_functions.end())
+			throw NotEvaluable{};
+		return callFunction(*function->second, arguments);
+	}
+
+	u256 evaluateBuiltin(FunctionCall const& _call, BuiltinFunction const& _builtin, vector<u256> const& _arguments)
+	{
+		if (!_builtin.sideEffects.movable || _builtin.returns.size() != 1 || !_builtin.literalArguments.empty())
+			throw NotEvaluable{};
+
+		Expression expression = FunctionCall{
+			_call.location,
+			_call.functionName,
+			applyMap(_arguments, [&](u256 const& _value) -> Expression {
+				return Literal{_call.location, LiteralKind::Number, YulString{formatNumber(_value)}, {}};
+			})
+		};
+		static map<YulString, AssignedValue> const noValues;
+		SimplificationRules::Rule const* match = SimplificationRules::findFirstMatch(expression, m_dialect, noValues);
+		if (!match)
+			throw NotEvaluable{};
+		// The constant folding rules come first, but any other rule also results in an
+		// expression that only consists of literals and builtin calls.
+		return evaluate(match->action().toExpression(_call.location));
+	}
+
+	Dialect const& m_dialect;
+	map<YulString, FunctionDefinition const*> const& m_functions;
+	map<YulString, u256> m_variables;
+	size_t m_steps = 0;
+	size_t m_callDepth = 0;
+};
+
+/// Replaces calls with literal arguments of functions with a single return variable by their result.
+class CallEvaluator: public ASTModifier
+{
+public:
+	CallEvaluator(
+		Dialect const& _dialect,
+		map<YulString, FunctionDefinition const*> const& _functions,
+		set<YulString> const& _candidates
+	):
+		m_functions(_functions),
+		m_candidates(_candidates),
+		m_evaluator(_dialect, _functions)
+	{}
+
+	using ASTModifier::visit;
+	void visit(Expression& _expression) override
+	{
+		ASTModifier::visit(_expression);
+
+		FunctionCall const* call = get_if<FunctionCall>(&_expression);
+		if (!call || !m_candidates.count(call->functionName.name))
+			return;
+		if (!all_of(call->arguments.begin(), call->arguments.end(), [](Expression const& _argument) {
+			return holds_alternative<Literal>(_argument);
+		}))
+			return;
+
+		FunctionDefinition const& function = *m_functions.at(call->functionName.name);
+		vector<u256> arguments = applyMap(call->arguments, [](Expression const& _argument) {
+			return valueOfLiteral(std::get<Literal>(_argument));
+		});
+		auto [result, inserted] = m_results.try_emplace(make_pair(function.name, arguments));
+		if (inserted)
+			if (optional<vector<u256>> returnValues = m_evaluator.call(function, arguments))
+				result->second = returnValues->front();
+		if (result->second)
+			_expression = Literal{
+				call->location,
+				LiteralKind::Number,
+				YulString{formatNumber(*result->second)},
+				function.returnVariables.front().type
+			};
+	}
+
+private:
+	map<YulString, FunctionDefinition const*> const& m_functions;
+	set<YulString> const& m_candidates;
+	Evaluator m_evaluator;
+	/// Results of the calls evaluated so far, nullopt for calls that cannot be evaluated.
+	map<pair<YulString, vector<u256>>, optional<u256>> m_results;
+};
+
+}
+
+void FunctionEvaluator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	map<YulString, FunctionDefinition const*> functions;
+	set<YulString> candidates;
+	for (Statement const& statement: _ast.statements)
+		if (FunctionDefinition const* function = get_if<FunctionDefinition>(&statement))
+		{
+			functions[function->name] = function;
+			if (
+				function->returnVariables.size() == 1 &&
+				function->returnVariables.front().type == _context.dialect.defaultType
+			)
+				candidates.insert(function->name);
+		}
+
+	if (!candidates.empty())
+		CallEvaluator{_context.dialect, functions, candidates}(_ast);
+}
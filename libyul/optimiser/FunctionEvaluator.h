@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that evaluates calls of functions with literal arguments at compile time.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/OptimiserStep.h>
+
+namespace solidity::yul
+{
+
+/**
+ * FunctionEvaluator: Optimiser step that replaces calls of functions with literal arguments
+ * by the value the function returns.
+ *
+ * A call is replaced if all its arguments are literals, the called function has a single
+ * return variable and the evaluation of the call only executes builtins that the
+ * simplification rules evaluate to a constant for literal arguments, i.e. arithmetic,
+ * comparison and bitwise operations, and calls to other functions:
+ *
+ *   function cleanup(value) -> cleaned { cleaned := and(value, 0xff) }
+ *   sstore(0, cleanup(0x1234))
+ *
+ * is turned into
+ *
+ *   function cleanup(value) -> cleaned { cleaned := and(value, 0xff) }
+ *   sstore(0, 52)
+ *
+ * Functions containing loops or recursive calls are evaluated as well, but the evaluation
+ * of a call is abandoned after a fixed number of steps.
+ *
+ * Prerequisites: Disambiguator, FunctionHoister.
+ *
+ * LiteralRematerialiser is recommended as a prerequisite, since only arguments that are
+ * literals are considered. UnusedPruner removes the functions that are not called anymore.
+ */
+struct FunctionEvaluator
+{
+	static constexpr char const* name{"FunctionEvaluator"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+};
+
+}
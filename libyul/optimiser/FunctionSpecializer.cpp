@@ -0,0 +1,144 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that specializes functions for the literal arguments they are called with.
+ */
+
+#include <libyul/optimiser/FunctionSpecializer.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <optional>
+#include <variant>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Collects all calls to functions that are not builtins.
+class CallCollector: public ASTModifier
+{
+public:
+	explicit CallCollector(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	using ASTModifier::operator();
+	void operator()(FunctionCall& _functionCall) override
+	{
+		ASTModifier::operator()(_functionCall);
+		if (!m_dialect.builtin(_functionCall.functionName.name))
+			m_calls[_functionCall.functionName.name].emplace_back(&_functionCall);
+	}
+
+	map<YulString, vector<FunctionCall*>> m_calls;
+
+private:
+	Dialect const& m_dialect;
+};
+
+/// Values of the arguments of a call. An element is nullopt if the argument is not a literal.
+using LiteralArguments = vector<optional<u256>>;
+
+LiteralArguments literalArguments(FunctionCall const& _call)
+{
+	return applyMap(_call.arguments, [](Expression const& _argument) -> optional<u256> {
+		if (Literal const* literal = get_if<Literal>(&_argument))
+			return valueOfLiteral(*literal);
+		return nullopt;
+	});
+}
+
+vector<bool> remainingParameters(vector<optional<Literal>> const& _literals)
+{
+	return applyMap(_literals, [](optional<Literal> const& _literal) { return !_literal; });
+}
+
+/// Removes the parameters of @a _function that have a literal in @a _literals and declares
+/// them at the start of the body instead.
+void declareParameters(FunctionDefinition& _function, vector<optional<Literal>> const& _literals)
+{
+	yulAssert(_literals.size() == _function.parameters.size(), "");
+	vector<Statement> declarations;
+	for (size_t i = 0; i < _literals.size(); ++i)
+		if (_literals[i])
+			declarations.emplace_back(VariableDeclaration{
+				_function.location,
+				{_function.parameters[i]},
+				make_unique<Expression>(*_literals[i])
+			});
+	declarations += move(_function.body.statements);
+	_function.body.statements = move(declarations);
+	_function.parameters = filter(_function.parameters, remainingParameters(_literals));
+}
+
+}
+
+void FunctionSpecializer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	set<YulString> recursiveFunctions = CallGraphGenerator::callGraph(_ast).recursiveFunctions();
+	CallCollector collector{_context.dialect};
+	collector(_ast);
+
+	// Literals of the parameters that have the same literal at all call sites. This is determined
+	// for all functions before changing anything, because changing function bodies invalidates
+	// the pointers to the calls.
+	map<YulString, vector<optional<Literal>>> constantParameters;
+	for (Statement const& statement: _ast.statements)
+	{
+		FunctionDefinition const* function = get_if<FunctionDefinition>(&statement);
+		if (
+			!function ||
+			function->parameters.empty() ||
+			recursiveFunctions.count(function->name) ||
+			!collector.m_calls.count(function->name)
+		)
+			continue;
+
+		vector<FunctionCall*> const& calls = collector.m_calls.at(function->name);
+		vector<LiteralArguments> arguments = applyMap(calls, [](FunctionCall* _call) { return literalArguments(*_call); });
+
+		vector<optional<Literal>> constants(function->parameters.size());
+		for (size_t i = 0; i < constants.size(); ++i)
+			if (all_of(arguments.begin(), arguments.end(), [&](auto const& _a) { return _a[i] && _a[i] == arguments.front()[i]; }))
+				constants[i] = std::get<Literal>(calls.front()->arguments[i]);
+
+		if (any_of(constants.begin(), constants.end(), [](auto const& _c) { return _c.has_value(); }))
+			constantParameters[function->name] = move(constants);
+	}
+
+	for (auto const& [name, constants]: constantParameters)
+	{
+		vector<bool> remaining = remainingParameters(constants);
+		for (FunctionCall* call: collector.m_calls.at(name))
+			call->arguments = filter(call->arguments, remaining);
+	}
+
+	for (Statement& statement: _ast.statements)
+		if (FunctionDefinition* function = get_if<FunctionDefinition>(&statement))
+			if (constantParameters.count(function->name))
+				declareParameters(*function, constantParameters.at(function->name));
+}
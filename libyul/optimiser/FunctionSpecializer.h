@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libyul/optimiser/OptimiserStep.h>
+
+namespace solidity::yul
+{
+
+/**
+ * FunctionSpecializer: Optimiser step that specializes functions for the literal arguments
+ * they are called with.
+ *
+ * If a parameter of a function receives the same literal at all call sites, the parameter is
+ * removed from the function and from the calls, and it is instead declared and initialized with
+ * the literal at the start of the function body:
+ *
+ *   function f(a, b) { sstore(a, b) }
+ *   f(x, 5)
+ *   f(y, 5)
+ *
+ * is turned into
+ *
+ *   function f(a) { let b := 5 sstore(a, b) }
+ *   f(x)
+ *   f(y)
+ *
+ * Since no code is copied, the step never increases the code size. Functions called with
+ * different literals at different call sites and recursive functions are not specialized.
+ *
+ * Other steps can then simplify the function body using the values of the literals, which is
+ * mainly useful for functions that are not inlined.
+ *
+ * Prerequisites: Disambiguator, FunctionHoister.
+ *
+ * LiteralRematerialiser is recommended as a prerequisite, since only arguments that are
+ * literals are considered.
+ */
+struct FunctionSpecializer
+{
+	static constexpr char const* name{"FunctionSpecializer"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+};
+
+}
@@ -25,6 +25,7 @@
 #include <libyul/Utilities.h>
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
 
 #include <libsolutil/CommonData.h>
@@ -37,23 +38,31 @@ using namespace solidity::yul;
 
 bool KnowledgeBase::knownToBeDifferent(YulString _a, YulString _b)
 {
+	Query query{_a, _b};
+	if (bool const* cached = util::valueOrNullptr(m_differentCache, query))
+		return *cached;
+
 	// Try to use the simplification rules together with the
 	// current values to turn `sub(_a, _b)` into a nonzero constant.
 	// If that fails, try `eq(_a, _b)`.
 
 	Expression expr1 = simplify(FunctionCall{{}, {{}, "sub"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, Identifier{{}, _b})});
 	if (holds_alternative<Literal>(expr1))
-		return valueOfLiteral(std::get<Literal>(expr1)) != 0;
+		return storeResult(m_differentCache, query, valueOfLiteral(std::get<Literal>(expr1)) != 0);
 
 	Expression expr2 = simplify(FunctionCall{{}, {{}, "eq"_yulstring}, util::make_vector<Expression>(Identifier{{}, _a}, Identifier{{}, _b})});
 	if (holds_alternative<Literal>(expr2))
-		return valueOfLiteral(std::get<Literal>(expr2)) == 0;
+		return storeResult(m_differentCache, query, valueOfLiteral(std::get<Literal>(expr2)) == 0);
 
-	return false;
+	return storeResult(m_differentCache, query, false);
 }
 
 bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, YulString _b)
 {
+	Query query{_a, _b};
+	if (bool const* cached = util::valueOrNullptr(m_differentByAtLeast32Cache, query))
+		return *cached;
+
 	// Try to use the simplification rules together with the
 	// current values to turn `sub(_a, _b)` into a constant whose absolute value is at least 32.
 
@@ -61,16 +70,68 @@ bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, YulString _b)
 	if (holds_alternative<Literal>(expr1))
 	{
 		u256 val = valueOfLiteral(std::get<Literal>(expr1));
-		return val >= 32 && val <= u256(0) - 32;
+		return storeResult(m_differentByAtLeast32Cache, query, val >= 32 && val <= u256(0) - 32);
+	}
+
+	return storeResult(m_differentByAtLeast32Cache, query, false);
+}
+
+optional<u256> KnowledgeBase::valueIfKnownConstant(YulString _a) const
+{
+	if (AssignedValue const* value = util::valueOrNullptr(m_variableValues, _a))
+		if (value->value)
+			if (Literal const* literal = get_if<Literal>(value->value))
+				return valueOfLiteral(*literal);
+	return nullopt;
+}
+
+void KnowledgeBase::valueChanged(YulString _variable)
+{
+	auto it = m_dependentQueries.find(_variable);
+	if (it == m_dependentQueries.end())
+		return;
+	for (Query const& query: it->second)
+	{
+		m_differentCache.erase(query);
+		m_differentByAtLeast32Cache.erase(query);
+	}
+	m_dependentQueries.erase(it);
+}
+
+void KnowledgeBase::clearCache()
+{
+	m_differentCache.clear();
+	m_differentByAtLeast32Cache.clear();
+	m_dependentQueries.clear();
+}
+
+bool KnowledgeBase::storeResult(map<Query, bool>& _cache, Query const& _query, bool _result)
+{
+	// The simplification rules only look at the values of the variables in the query
+	// and, transitively, of the variables referenced in those values.
+	set<YulString> dependencies{_query.first, _query.second};
+	vector<YulString> toVisit{_query.first, _query.second};
+	while (!toVisit.empty())
+	{
+		YulString variable = toVisit.back();
+		toVisit.pop_back();
+		if (AssignedValue const* value = util::valueOrNullptr(m_variableValues, variable))
+			if (value->value)
+				for (auto const& [reference, count]: ReferencesCounter::countReferences(*value->value, ReferencesCounter::OnlyVariables))
+					if (dependencies.insert(reference).second)
+						toVisit.push_back(reference);
 	}
+	for (YulString dependency: dependencies)
+		m_dependentQueries[dependency].insert(_query);
 
-	return false;
+	_cache[_query] = _result;
+	return _result;
 }
 
 Expression KnowledgeBase::simplify(Expression _expression)
 {
 	bool startedRecursion = (m_recursionCounter == 0);
-	ScopeGuard{[&] { if (startedRecursion) m_recursionCounter = 0; }};
+	ScopeGuard resetRecursionCounter{[&] { if (startedRecursion) m_recursionCounter = 0; }};
 
 	if (startedRecursion)
 		m_recursionCounter = 100;
@@ -24,7 +24,12 @@
 #include <libyul/ASTForward.h>
 #include <libyul/YulString.h>
 
+#include <libsolutil/Common.h>
+
 #include <map>
+#include <optional>
+#include <set>
+#include <utility>
 
 namespace solidity::yul
 {
@@ -36,6 +41,8 @@ struct AssignedValue;
  * Class that can answer questions about values of variables and their relations.
  *
  * The reference to the map of values provided at construction is assumed to be updating.
+ * Answers are cached until the owner reports a change to the value of one of the variables
+ * the answer depends on via ``valueChanged`` or invalidates everything via ``clearCache``.
  */
 class KnowledgeBase
 {
@@ -48,13 +55,29 @@ public:
 	bool knownToBeDifferent(YulString _a, YulString _b);
 	bool knownToBeDifferentByAtLeast32(YulString _a, YulString _b);
 	bool knownToBeEqual(YulString _a, YulString _b) const { return _a == _b; }
+	/// @returns the value of @a _a if it is currently assigned a literal.
+	std::optional<u256> valueIfKnownConstant(YulString _a) const;
+
+	/// Has to be called whenever the value of @a _variable in the map of values changes.
+	void valueChanged(YulString _variable);
+	/// Has to be called whenever the map of values is replaced as a whole.
+	void clearCache();
 
 private:
+	using Query = std::pair<YulString, YulString>;
+
 	Expression simplify(Expression _expression);
+	/// Records @a _result for @a _query in @a _cache together with the variables it depends on.
+	bool storeResult(std::map<Query, bool>& _cache, Query const& _query, bool _result);
 
 	Dialect const& m_dialect;
 	std::map<YulString, AssignedValue> const& m_variableValues;
 	size_t m_recursionCounter = 0;
+
+	std::map<Query, bool> m_differentCache;
+	std::map<Query, bool> m_differentByAtLeast32Cache;
+	/// Queries whose cached answers depend on the value of a variable.
+	std::map<YulString, std::set<Query>> m_dependentQueries;
 };
 
 }
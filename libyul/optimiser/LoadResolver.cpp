@@ -27,6 +27,10 @@
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/SideEffects.h>
 #include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
 
 using namespace std;
 using namespace solidity;
@@ -47,12 +51,19 @@ void LoadResolver::visit(Expression& _e)
 	DataFlowAnalyzer::visit(_e);
 
 	if (FunctionCall const* funCall = std::get_if<FunctionCall>(&_e))
+	{
 		for (auto location: { StoreLoadLocation::Memory, StoreLoadLocation::Storage })
 			if (funCall->functionName.name == m_loadFunctionName[static_cast<unsigned>(location)])
 			{
 				tryResolve(_e, location, funCall->arguments);
-				break;
+				return;
 			}
+
+		if (auto const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+			if (auto const* builtin = dialect->builtin(funCall->functionName.name))
+				if (builtin->instruction == evmasm::Instruction::KECCAK256)
+					tryEvaluateKeccak(_e, funCall->arguments);
+	}
 }
 
 void LoadResolver::tryResolve(
@@ -67,12 +78,57 @@ void LoadResolver::tryResolve(
 	YulString key = std::get<Identifier>(_arguments.at(0)).name;
 	if (_location == StoreLoadLocation::Storage)
 	{
-		if (auto value = util::valueOrNullptr(m_storage, key))
+		if (auto value = util::valueOrNullptr(m_storage.get(), key))
 			if (inScope(*value))
 				_e = Identifier{locationOf(_e), *value};
 	}
 	else if (m_optimizeMLoad && _location == StoreLoadLocation::Memory)
-		if (auto value = util::valueOrNullptr(m_memory, key))
+		if (auto value = util::valueOrNullptr(m_memory.get(), key))
 			if (inScope(*value))
 				_e = Identifier{locationOf(_e), *value};
 }
+
+void LoadResolver::tryEvaluateKeccak(Expression& _e, vector<Expression> const& _arguments)
+{
+	if (!m_optimizeMLoad || _arguments.size() != 2)
+		return;
+
+	auto constantValue = [&](Expression const& _expression) -> optional<u256> {
+		if (Literal const* literal = get_if<Literal>(&_expression))
+			return valueOfLiteral(*literal);
+		if (Identifier const* identifier = get_if<Identifier>(&_expression))
+			return m_knowledgeBase.valueIfKnownConstant(identifier->name);
+		return nullopt;
+	};
+	optional<u256> offset = constantValue(_arguments.at(0));
+	optional<u256> length = constantValue(_arguments.at(1));
+	if (!offset || !length)
+		return;
+
+	// Contents of the memory words at constant offsets. The words do not overlap,
+	// since the knowledge about a word is removed when memory close to it is written.
+	map<u256, u256> memoryWords;
+	for (auto const& [key, value]: m_memory.get())
+		if (optional<u256> keyValue = m_knowledgeBase.valueIfKnownConstant(key))
+			if (optional<u256> contents = m_knowledgeBase.valueIfKnownConstant(value))
+				memoryWords[*keyValue] = *contents;
+
+	if (*length > 32 * memoryWords.size())
+		return;
+	bytes data;
+	for (u256 wordOffset = *offset; wordOffset - *offset < *length; wordOffset += 32)
+	{
+		u256 const* contents = util::valueOrNullptr(memoryWords, wordOffset);
+		if (!contents || wordOffset + 32 < wordOffset)
+			return;
+		data += util::toBigEndian(*contents);
+	}
+	data.resize(static_cast<size_t>(*length));
+
+	_e = Literal{
+		locationOf(_e),
+		LiteralKind::Number,
+		YulString{util::formatNumber(u256(util::keccak256(data)))},
+		{}
+	};
+}
@@ -32,6 +32,11 @@ namespace solidity::yul
  * Optimisation stage that replaces expressions of type ``sload(x)`` and ``mload(x)`` by the value
  * currently stored in storage resp. memory, if known.
  *
+ * Also replaces ``keccak256(x, y)`` by the hash if ``x`` and ``y`` are constants and the
+ * constant contents of all memory words in the range are known, as in
+ * ``mstore(0, 1) mstore(0x20, 2) let h := keccak256(0, 0x40)``.
+ * Like the replacement of ``mload``, this is only done if the code does not use ``msize``.
+ *
  * Works best if the code is in SSA form.
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
@@ -63,6 +68,10 @@ protected:
 		std::vector<Expression> const& _arguments
 	);
 
+	/// Replaces the call @a _e of ``keccak256`` by the hash of the range of memory given by
+	/// @a _arguments if the range and its contents are known constants.
+	void tryEvaluateKeccak(Expression& _e, std::vector<Expression> const& _arguments);
+
 	bool m_optimizeMLoad = false;
 };
 
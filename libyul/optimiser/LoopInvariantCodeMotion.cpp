@@ -23,8 +23,12 @@
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
 #include <libsolutil/CommonData.h>
 
+#include <range/v3/algorithm/all_of.hpp>
+
 #include <utility>
 
 using namespace std;
@@ -36,8 +40,21 @@ void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 	map<YulString, SideEffects> functionSideEffects =
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+	SSAValueTracker ssaValueTracker;
+	ssaValueTracker(_ast);
+	set<YulString> ssaVars;
+	for (auto const& [name, value]: ssaValueTracker.values())
+		ssaVars.insert(name);
+	// A variable that is assigned to can have different values at the declaration of an SSA
+	// variable and inside a loop, so values referring to such variables are not used.
+	map<YulString, AssignedValue> ssaValues;
+	for (auto const& [name, value]: ssaValueTracker.values())
+		if (ranges::all_of(
+			ReferencesCounter::countReferences(*value, ReferencesCounter::OnlyVariables),
+			[&](auto const& _reference) { return ssaVars.count(_reference.first); }
+		))
+			ssaValues[name] = AssignedValue{value, 0};
+	LoopInvariantCodeMotion{_context.dialect, ssaVars, ssaValues, functionSideEffects, containsMSize}(_ast);
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
@@ -58,8 +75,9 @@ void LoopInvariantCodeMotion::operator()(Block& _block)
 bool LoopInvariantCodeMotion::canBePromoted(
 	VariableDeclaration const& _varDecl,
 	set<YulString> const& _varsDefinedInCurrentScope,
-	SideEffects const& _forLoopSideEffects
-) const
+	SideEffects const& _forLoopSideEffects,
+	StorageWrites const& _forLoopStorageWrites
+)
 {
 	// A declaration can be promoted iff
 	// 1. Its LHS is a SSA variable
@@ -75,18 +93,99 @@ bool LoopInvariantCodeMotion::canBePromoted(
 			if (_varsDefinedInCurrentScope.count(ref.first) || !m_ssaVariables.count(ref.first))
 				return false;
 		SideEffectsCollector sideEffects{m_dialect, *_varDecl.value, &m_functionSideEffects};
-		if (!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize))
+		if (
+			!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize) &&
+			!isLoadOfUnwrittenSlot(*_varDecl.value, _forLoopStorageWrites)
+		)
 			return false;
 	}
 	return true;
 }
 
+bool LoopInvariantCodeMotion::isLoadOfUnwrittenSlot(Expression const& _value, StorageWrites const& _writes)
+{
+	BuiltinFunction const* load = m_dialect.storageLoadFunction({});
+	FunctionCall const* call = get_if<FunctionCall>(&_value);
+	if (!load || !call || call->functionName.name != load->name || !_writes.slots)
+		return false;
+	Expression const& slot = call->arguments.front();
+	if (!holds_alternative<Identifier>(slot) && !holds_alternative<Literal>(slot))
+		return false;
+	for (Expression const& writtenSlot: *_writes.slots)
+		if (!knownToBeDifferent(slot, writtenSlot))
+			return false;
+	return SideEffectsCollector{m_dialect, _value, &m_functionSideEffects}.movableRelativeTo(
+		_writes.otherSideEffects,
+		m_containsMSize
+	);
+}
+
+bool LoopInvariantCodeMotion::knownToBeDifferent(Expression const& _a, Expression const& _b)
+{
+	auto constantValue = [&](Expression const& _expression) -> optional<u256> {
+		Expression const* expression = &_expression;
+		if (Identifier const* identifier = get_if<Identifier>(expression))
+			if (AssignedValue const* value = util::valueOrNullptr(m_ssaValues, identifier->name))
+				expression = value->value;
+		if (Literal const* literal = get_if<Literal>(expression))
+			return valueOfLiteral(*literal);
+		return nullopt;
+	};
+	if (holds_alternative<Identifier>(_a) && holds_alternative<Identifier>(_b))
+		return m_knowledgeBase.knownToBeDifferent(get<Identifier>(_a).name, get<Identifier>(_b).name);
+	optional<u256> a = constantValue(_a);
+	optional<u256> b = constantValue(_b);
+	return a && b && *a != *b;
+}
+
+LoopInvariantCodeMotion::StorageWrites LoopInvariantCodeMotion::storageWrites(ForLoop const& _for) const
+{
+	struct Collector: ASTWalker
+	{
+		Collector(Dialect const& _dialect, map<YulString, SideEffects> const& _functionSideEffects):
+			dialect(_dialect), functionSideEffects(_functionSideEffects), store(_dialect.storageStoreFunction({}))
+		{}
+		using ASTWalker::operator();
+		void operator()(FunctionCall const& _call) override
+		{
+			ASTWalker::operator()(_call);
+			if (store && _call.functionName.name == store->name)
+			{
+				Expression const& slot = _call.arguments.front();
+				if (result.slots && (holds_alternative<Identifier>(slot) || holds_alternative<Literal>(slot)))
+					result.slots->emplace_back(slot);
+				else
+					result.slots.reset();
+			}
+			else if (BuiltinFunction const* builtin = dialect.builtin(_call.functionName.name))
+				result.otherSideEffects += builtin->sideEffects;
+			else if (SideEffects const* sideEffects = util::valueOrNullptr(functionSideEffects, _call.functionName.name))
+				result.otherSideEffects += *sideEffects;
+			else
+				result.otherSideEffects += SideEffects::worst();
+		}
+
+		Dialect const& dialect;
+		map<YulString, SideEffects> const& functionSideEffects;
+		BuiltinFunction const* store = nullptr;
+		StorageWrites result;
+	};
+	Collector collector{m_dialect, m_functionSideEffects};
+	collector(_for);
+	return std::move(collector.result);
+}
+
 optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 {
 	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
 
 	auto forLoopSideEffects =
 		SideEffectsCollector{m_dialect, _for, &m_functionSideEffects}.sideEffects();
+	StorageWrites forLoopStorageWrites;
+	if (forLoopSideEffects.storage == SideEffects::Write)
+		forLoopStorageWrites = storageWrites(_for);
+	else
+		forLoopStorageWrites.otherSideEffects = forLoopSideEffects;
 
 	vector<Statement> replacement;
 	for (Block* block: {&_for.post, &_for.body})
@@ -99,7 +198,7 @@ optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 				if (holds_alternative<VariableDeclaration>(_s))
 				{
 					VariableDeclaration const& varDecl = std::get<VariableDeclaration>(_s);
-					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects))
+					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects, forLoopStorageWrites))
 					{
 						replacement.emplace_back(std::move(_s));
 						// Do not add the variables declared here to varsDefinedInScope because we are moving them.
@@ -18,6 +18,8 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/KnowledgeBase.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
@@ -32,6 +34,9 @@ namespace solidity::yul
  * Only statements at the top level in a loop's body or post block are considered, i.e variable
  * declarations inside conditional branches will not be moved out of the loop.
  *
+ * Storage loads are also moved if the loop writes to storage, as long as all writes are direct
+ * calls to the storage store function whose slots are known to be different from the loaded slot.
+ *
  * Requirements:
  * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
  * - Expression splitter and SSA transform should be run upfront to obtain better result.
@@ -46,30 +51,54 @@ public:
 	void operator()(Block& _block) override;
 
 private:
+	/// Storage writes of a loop.
+	struct StorageWrites
+	{
+		/// Slot arguments of the direct calls to the storage store function or nullopt
+		/// if one of them is neither a variable nor a literal.
+		std::optional<std::vector<Expression>> slots = std::vector<Expression>{};
+		/// Side effects of the loop apart from these calls.
+		SideEffects otherSideEffects;
+	};
+
 	explicit LoopInvariantCodeMotion(
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables,
+		std::map<YulString, AssignedValue> const& _ssaValues,
 		std::map<YulString, SideEffects> const& _functionSideEffects,
 		bool _containsMSize
 	):
 		m_containsMSize(_containsMSize),
 		m_dialect(_dialect),
 		m_ssaVariables(_ssaVariables),
-		m_functionSideEffects(_functionSideEffects)
+		m_ssaValues(_ssaValues),
+		m_functionSideEffects(_functionSideEffects),
+		m_knowledgeBase(_dialect, _ssaValues)
 	{ }
 
 	/// @returns true if the given variable declaration can be moved to in front of the loop.
 	bool canBePromoted(
 		VariableDeclaration const& _varDecl,
 		std::set<YulString> const& _varsDefinedInCurrentScope,
-		SideEffects const& _forLoopSideEffects
-	) const;
+		SideEffects const& _forLoopSideEffects,
+		StorageWrites const& _forLoopStorageWrites
+	);
+	/// @returns true if @a _value is a storage load that can be moved in front of a loop
+	/// with the storage writes @a _writes.
+	bool isLoadOfUnwrittenSlot(Expression const& _value, StorageWrites const& _writes);
+	/// @returns true if the values of the variables or literals @a _a and @a _b are known
+	/// to be different.
+	bool knownToBeDifferent(Expression const& _a, Expression const& _b);
+	StorageWrites storageWrites(ForLoop const& _for) const;
 	std::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
 
 	bool m_containsMSize = true;
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
+	/// Values of the SSA variables whose values only refer to SSA variables.
+	std::map<YulString, AssignedValue> const& m_ssaValues;
 	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	KnowledgeBase m_knowledgeBase;
 };
 
 }
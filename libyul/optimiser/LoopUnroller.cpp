@@ -0,0 +1,242 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that unrolls for-loops with a number of iterations known at compile time.
+ */
+
+#include <libyul/optimiser/LoopUnroller.h>
+
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Loops with more iterations are not unrolled, independently of the costs.
+size_t constexpr maxIterations = 32;
+
+/// @returns weights for CodeSize that approximate the number of bytes of the generated bytecode.
+CodeWeights byteWeights()
+{
+	CodeWeights weights;
+	weights.assignmentCost = 2;
+	weights.forLoopCost = 10;
+	weights.identifierCost = 1;
+	weights.literalCost = 2;
+	return weights;
+}
+
+/// Finds the statements that prevent copying the body of a for-loop once per iteration,
+/// i.e. ``break`` and ``continue`` statements that belong to the loop and function definitions.
+class UnrollBlockerFinder: public ASTWalker
+{
+public:
+	static bool containsBlocker(Block const& _body)
+	{
+		UnrollBlockerFinder finder;
+		finder(_body);
+		return finder.m_found;
+	}
+
+	using ASTWalker::operator();
+	void operator()(Break const&) override { m_found = true; }
+	void operator()(Continue const&) override { m_found = true; }
+	void operator()(FunctionDefinition const&) override { m_found = true; }
+	/// ``break`` and ``continue`` in nested loops belong to these loops.
+	void operator()(ForLoop const&) override {}
+
+private:
+	bool m_found = false;
+};
+
+/// Copies the body of a for-loop for one iteration, replacing the loop variable by its value.
+class IterationCopier: public BodyCopier
+{
+public:
+	IterationCopier(NameDispenser& _nameDispenser, YulString _loopVariable, Literal _value):
+		BodyCopier(_nameDispenser, {}),
+		m_loopVariable(_loopVariable),
+		m_value(move(_value))
+	{}
+
+	using BodyCopier::operator();
+	Expression operator()(Identifier const& _identifier) override
+	{
+		if (_identifier.name == m_loopVariable)
+			return Literal{_identifier.location, m_value.kind, m_value.value, m_value.type};
+		return BodyCopier::operator()(_identifier);
+	}
+
+private:
+	YulString m_loopVariable;
+	Literal m_value;
+};
+
+}
+
+void LoopUnroller::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_context.dialect))
+		LoopUnroller{*dialect, _context.dispenser, _context.gasMeter}(_ast);
+}
+
+void LoopUnroller::operator()(Block& _block)
+{
+	ASTModifier::operator()(_block);
+
+	for (size_t i = 1; i < _block.statements.size(); ++i)
+		if (ForLoop const* loop = get_if<ForLoop>(&_block.statements[i]))
+			if (optional<Statement> unrolled = tryUnroll(_block.statements[i - 1], *loop))
+				_block.statements[i] = move(*unrolled);
+}
+
+optional<Statement> LoopUnroller::tryUnroll(Statement const& _previous, ForLoop const& _loop)
+{
+	auto const* varDecl = get_if<VariableDeclaration>(&_previous);
+	if (
+		!varDecl ||
+		varDecl->variables.size() != 1 ||
+		!varDecl->value ||
+		!holds_alternative<Literal>(*varDecl->value) ||
+		!_loop.pre.statements.empty()
+	)
+		return nullopt;
+	YulString loopVariable = varDecl->variables.front().name;
+
+	auto isLoopVariable = [&](Expression const& _expression) {
+		return holds_alternative<Identifier>(_expression) && get<Identifier>(_expression).name == loopVariable;
+	};
+	auto instructionOf = [&](Expression const& _expression) -> optional<evmasm::Instruction> {
+		if (FunctionCall const* call = get_if<FunctionCall>(&_expression))
+			if (BuiltinFunctionForEVM const* builtin = m_dialect.builtin(call->functionName.name))
+				if (builtin->instruction && call->arguments.size() == 2)
+					return builtin->instruction;
+		return nullopt;
+	};
+	// @returns the literal operand of a binary call of @a _instruction whose other operand is the loop variable.
+	// If @a _commutative is false, the loop variable has to be the operand at @a _variableIndex.
+	auto literalOperand = [&](
+		Expression const& _expression,
+		evmasm::Instruction _instruction,
+		size_t _variableIndex,
+		bool _commutative
+	) -> Literal const* {
+		if (instructionOf(_expression) != _instruction)
+			return nullptr;
+		vector<Expression> const& arguments = get<FunctionCall>(_expression).arguments;
+		for (size_t index: {_variableIndex, 1 - _variableIndex})
+		{
+			if (isLoopVariable(arguments[index]) && holds_alternative<Literal>(arguments[1 - index]))
+				return &get<Literal>(arguments[1 - index]);
+			if (!_commutative)
+				break;
+		}
+		return nullptr;
+	};
+
+	Literal const* end = literalOperand(*_loop.condition, evmasm::Instruction::LT, 0, false);
+	if (!end)
+		end = literalOperand(*_loop.condition, evmasm::Instruction::GT, 1, false);
+	if (!end || _loop.post.statements.size() != 1)
+		return nullopt;
+	auto const* increment = get_if<Assignment>(&_loop.post.statements.front());
+	if (!increment || increment->variableNames.size() != 1 || increment->variableNames.front().name != loopVariable)
+		return nullopt;
+	Literal const* step = literalOperand(*increment->value, evmasm::Instruction::ADD, 0, true);
+	if (!step)
+		return nullopt;
+
+	Assignments assignments;
+	assignments(_loop.body);
+	if (UnrollBlockerFinder::containsBlocker(_loop.body) || assignments.names().count(loopVariable))
+		return nullopt;
+
+	bigint const start = valueOfLiteral(get<Literal>(*varDecl->value));
+	bigint const stepValue = valueOfLiteral(*step);
+	bigint const endValue = valueOfLiteral(*end);
+	if (stepValue == 0)
+		return nullopt;
+	bigint const iterations = start < endValue ? bigint((endValue - start + stepValue - 1) / stepValue) : bigint(0);
+	bigint const finalValue = start + iterations * stepValue;
+	// Otherwise the loop variable overflows and the loop does not terminate after these iterations.
+	if (iterations > maxIterations || finalValue >= (bigint(1) << 256))
+		return nullopt;
+	if (!beneficial(_loop, static_cast<size_t>(iterations)))
+		return nullopt;
+
+	Type const type = varDecl->variables.front().type;
+	auto makeLiteral = [&](bigint const& _value) {
+		return Literal{_loop.location, LiteralKind::Number, YulString{formatNumber(_value)}, type};
+	};
+	Block unrolled{_loop.location, {}};
+	for (bigint value = start; value < finalValue; value += stepValue)
+		unrolled.statements.emplace_back(
+			IterationCopier{m_dispenser, loopVariable, makeLiteral(value)}.translate(_loop.body)
+		);
+	unrolled.statements.emplace_back(Assignment{
+		_loop.location,
+		{Identifier{_loop.location, loopVariable}},
+		make_unique<Expression>(makeLiteral(finalValue))
+	});
+	return {move(unrolled)};
+}
+
+bool LoopUnroller::beneficial(ForLoop const& _loop, size_t _iterations) const
+{
+	CodeWeights const weights = byteWeights();
+	size_t const bodySize = CodeSize::codeSize(_loop.body, weights);
+	size_t const loopSize = bodySize + CodeSize::codeSize(*_loop.condition, weights) +
+		CodeSize::codeSize(_loop.post, weights) + weights.forLoopCost;
+	size_t const unrolledSize = _iterations * bodySize + weights.literalCost + weights.assignmentCost;
+	if (unrolledSize <= loopSize)
+		return true;
+	if (!m_gasMeter)
+		return false;
+
+	// Gas spent in each iteration for evaluating the condition, incrementing the loop variable and jumping.
+	size_t overhead =
+		GasMeterVisitor::costs(*_loop.condition, m_dialect, false).first +
+		GasMeterVisitor::costs(*get<Assignment>(_loop.post.statements.front()).value, m_dialect, false).first;
+	for (evmasm::Instruction instruction: {
+		evmasm::Instruction::ISZERO,
+		evmasm::Instruction::PUSH1,
+		evmasm::Instruction::JUMPI,
+		evmasm::Instruction::SWAP1,
+		evmasm::Instruction::POP,
+		evmasm::Instruction::PUSH1,
+		evmasm::Instruction::JUMP,
+		evmasm::Instruction::JUMPDEST,
+		evmasm::Instruction::JUMPDEST
+	})
+		overhead += GasMeterVisitor::instructionCosts(instruction, m_dialect).first;
+
+	return m_gasMeter->costs(_iterations * overhead, 0) >= m_gasMeter->costs(0, unrolledSize - loopSize);
+}
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that unrolls for-loops with a number of iterations known at compile time.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <optional>
+
+namespace solidity::yul
+{
+
+struct EVMDialect;
+class GasMeter;
+class NameDispenser;
+
+/**
+ * Optimiser step that replaces for-loops with a number of iterations known at compile time
+ * by one copy of the body per iteration, in which the loop variable is replaced by its value:
+ *
+ *   let i := 0
+ *   for {} lt(i, 3) { i := add(i, 1) } { mstore(mul(i, 0x20), i) }
+ *
+ * is turned into
+ *
+ *   let i := 0
+ *   {
+ *     { mstore(mul(0, 0x20), 0) }
+ *     { mstore(mul(1, 0x20), 1) }
+ *     { mstore(mul(2, 0x20), 2) }
+ *     i := 3
+ *   }
+ *
+ * Only loops with an empty pre block that directly follow the declaration of their loop variable
+ * with a literal value, whose condition is ``lt(i, c)`` or ``gt(c, i)`` and whose post block
+ * is ``i := add(i, s)`` or ``i := add(s, i)`` for literals ``c`` and ``s`` are unrolled.
+ * The body must not assign to the loop variable and must not contain ``break`` or ``continue``
+ * statements that belong to the loop.
+ *
+ * If a gas meter is available, a loop is unrolled if the costs of the comparisons and jumps
+ * saved in each iteration, weighted by the number of runs, outweigh the costs of deploying the
+ * copies of the body. Otherwise, it is only unrolled if this does not increase the code size.
+ * Loops with more than 32 iterations are never unrolled.
+ *
+ * Works best after the LiteralRematerialiser and before the ExpressionSimplifier, which
+ * folds the expressions involving the value of the loop variable.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter, FunctionHoister.
+ */
+class LoopUnroller: public ASTModifier
+{
+public:
+	static constexpr char const* name{"LoopUnroller"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	LoopUnroller(
+		EVMDialect const& _dialect,
+		NameDispenser& _dispenser,
+		GasMeter const* _gasMeter
+	):
+		m_dialect(_dialect),
+		m_dispenser(_dispenser),
+		m_gasMeter(_gasMeter)
+	{}
+
+	/// Tries to unroll the for-loop @a _loop that follows the statement @a _previous.
+	/// @returns the statement replacing the loop on success.
+	std::optional<Statement> tryUnroll(Statement const& _previous, ForLoop const& _loop);
+	/// @returns true if unrolling a loop with @a _iterations iterations is beneficial.
+	bool beneficial(ForLoop const& _loop, size_t _iterations) const;
+
+	EVMDialect const& m_dialect;
+	NameDispenser& m_dispenser;
+	GasMeter const* m_gasMeter = nullptr;
+};
+
+}
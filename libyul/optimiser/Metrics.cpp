@@ -24,6 +24,7 @@
 #include <libyul/Exceptions.h>
 #include <libyul/Utilities.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/GasMeter.h>
@@ -187,6 +188,39 @@ void CodeCost::addInstructionCost(evmasm::Instruction _instruction)
 		m_cost += 49;
 }
 
+bool DuplicationCost::cheapToDuplicate(
+	Dialect const& _dialect,
+	GasMeter const* _meter,
+	Expression const& _expression,
+	size_t _uses,
+	size_t _maxCodeCost
+)
+{
+	if (_meter)
+		if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_dialect))
+			if (onlyInstructions(*dialect, _expression))
+			{
+				size_t cost = _meter->costs(_expression);
+				size_t dupCost = _meter->instructionCosts(evmasm::Instruction::DUP1);
+				return _uses * cost <= cost + _uses * dupCost;
+			}
+	return CodeCost::codeCost(_dialect, _expression) <= _maxCodeCost;
+}
+
+bool DuplicationCost::onlyInstructions(EVMDialect const& _dialect, Expression const& _expression)
+{
+	if (FunctionCall const* funCall = get_if<FunctionCall>(&_expression))
+	{
+		BuiltinFunctionForEVM const* f = _dialect.builtin(funCall->functionName.name);
+		if (!f || !f->instruction)
+			return false;
+		for (Expression const& arg: funCall->arguments)
+			if (!onlyInstructions(_dialect, arg))
+				return false;
+	}
+	return true;
+}
+
 void AssignmentCounter::operator()(Assignment const& _assignment)
 {
 	for (auto const& variable: _assignment.variableNames)
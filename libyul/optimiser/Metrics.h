@@ -29,6 +29,7 @@ namespace solidity::yul
 
 struct Dialect;
 struct EVMDialect;
+class GasMeter;
 
 /**
  * Weights to be assigned to specific yul statements and expressions by a metric.
@@ -128,6 +129,33 @@ private:
 	size_t m_cost = 0;
 };
 
+/**
+ * Decides whether it is cheaper to evaluate an expression at each of its uses
+ * than to evaluate it once and keep its value on the stack.
+ *
+ * If a gas meter is provided and the expression only consists of literals, identifiers
+ * and EVM instructions, the decision is based on the combined deploy and run costs
+ * reported by the gas meter, otherwise it falls back to comparing the CodeCost
+ * of the expression against a fixed limit.
+ */
+class DuplicationCost
+{
+public:
+	/// @returns true if evaluating @a _expression @a _uses times is not more expensive
+	/// than evaluating it once and duplicating it @a _uses times or, if no gas costs
+	/// are available, if its CodeCost is at most @a _maxCodeCost.
+	static bool cheapToDuplicate(
+		Dialect const& _dialect,
+		GasMeter const* _meter,
+		Expression const& _expression,
+		size_t _uses,
+		size_t _maxCodeCost
+	);
+
+private:
+	static bool onlyInstructions(EVMDialect const& _dialect, Expression const& _expression);
+};
+
 /**
  * Counts the number of assignments to every variable.
  * Only works after running the Disambiguator.
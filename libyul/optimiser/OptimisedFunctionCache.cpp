@@ -0,0 +1,201 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/OptimisedFunctionCache.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/AsmPrinter.h>
+
+#include <functional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::langutil;
+
+namespace
+{
+
+/// Calls a function on the source location of every node of an AST.
+class LocationVisitor: public ASTModifier
+{
+public:
+	explicit LocationVisitor(function<void(SourceLocation&)> _callback): m_callback(move(_callback)) {}
+
+	using ASTModifier::operator();
+	void operator()(Literal& _literal) override { m_callback(_literal.location); }
+	void operator()(Identifier& _identifier) override { m_callback(_identifier.location); }
+	void operator()(FunctionCall& _call) override
+	{
+		m_callback(_call.location);
+		(*this)(_call.functionName);
+		ASTModifier::operator()(_call);
+	}
+	void operator()(ExpressionStatement& _statement) override
+	{
+		m_callback(_statement.location);
+		ASTModifier::operator()(_statement);
+	}
+	void operator()(Assignment& _assignment) override
+	{
+		m_callback(_assignment.location);
+		ASTModifier::operator()(_assignment);
+	}
+	void operator()(VariableDeclaration& _declaration) override
+	{
+		m_callback(_declaration.location);
+		for (TypedName& variable: _declaration.variables)
+			m_callback(variable.location);
+		ASTModifier::operator()(_declaration);
+	}
+	void operator()(If& _if) override
+	{
+		m_callback(_if.location);
+		ASTModifier::operator()(_if);
+	}
+	void operator()(Switch& _switch) override
+	{
+		m_callback(_switch.location);
+		for (Case& c: _switch.cases)
+			m_callback(c.location);
+		ASTModifier::operator()(_switch);
+	}
+	void operator()(FunctionDefinition& _function) override
+	{
+		m_callback(_function.location);
+		for (TypedName& parameter: _function.parameters)
+			m_callback(parameter.location);
+		for (TypedName& returnVariable: _function.returnVariables)
+			m_callback(returnVariable.location);
+		ASTModifier::operator()(_function);
+	}
+	void operator()(ForLoop& _loop) override
+	{
+		m_callback(_loop.location);
+		ASTModifier::operator()(_loop);
+	}
+	void operator()(Break& _break) override { m_callback(_break.location); }
+	void operator()(Continue& _continue) override { m_callback(_continue.location); }
+	void operator()(Leave& _leave) override { m_callback(_leave.location); }
+	void operator()(Block& _block) override
+	{
+		m_callback(_block.location);
+		ASTModifier::operator()(_block);
+	}
+
+private:
+	function<void(SourceLocation&)> m_callback;
+};
+
+}
+
+OptimisedFunctionCache& OptimisedFunctionCache::instance()
+{
+	static OptimisedFunctionCache cache;
+	return cache;
+}
+
+optional<string> OptimisedFunctionCache::key(
+	string const& _step,
+	Dialect const& _dialect,
+	Block& _block,
+	map<YulString, SideEffects> const* _functionSideEffects
+)
+{
+	if (_block.statements.size() != 1)
+		return nullopt;
+	SourceLocation const base = locationOf(_block.statements.front());
+	if (!base.source || base.start < 0)
+		return nullopt;
+
+	string result = _step + "\n" + to_string(reinterpret_cast<uintptr_t>(&_dialect)) + "\n";
+	result += std::visit(AsmPrinter{}, _block.statements.front()) + "\n";
+
+	bool cacheable = true;
+	LocationVisitor{[&](SourceLocation& _location) {
+		if (!_location.isValid())
+			result += "-;";
+		else if (_location.source.get() != base.source.get() || _location.start < 0 || _location.end < 0)
+			cacheable = false;
+		else
+			result += to_string(_location.start - base.start) + "," + to_string(_location.end - base.start) + ";";
+	}}(_block);
+	if (!cacheable)
+		return nullopt;
+
+	if (_functionSideEffects)
+		for (auto const& [name, count]: ReferencesCounter::countReferences(_block))
+			if (_functionSideEffects->count(name))
+			{
+				SideEffects const& sideEffects = _functionSideEffects->at(name);
+				result +=
+					"\n" + name.str() + ":" +
+					to_string(sideEffects.movable) +
+					to_string(sideEffects.movableApartFromEffects) +
+					to_string(sideEffects.canBeRemoved) +
+					to_string(sideEffects.canBeRemovedIfNoMSize) +
+					to_string(sideEffects.cannotLoop) +
+					to_string(sideEffects.otherState) +
+					to_string(sideEffects.storage) +
+					to_string(sideEffects.memory);
+			}
+	return result;
+}
+
+bool OptimisedFunctionCache::lookup(string const& _key, Block& _block)
+{
+	SourceLocation const base = locationOf(_block.statements.front());
+	Block result;
+	SourceLocation cachedBase;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it == m_entries.end())
+			return false;
+		result = std::get<Block>(ASTCopier{}(it->second.result));
+		cachedBase = it->second.location;
+	}
+
+	LocationVisitor{[&](SourceLocation& _location) {
+		if (_location.isValid() && _location.source.get() == cachedBase.source.get())
+		{
+			_location.source = base.source;
+			_location.start += base.start - cachedBase.start;
+			_location.end += base.start - cachedBase.start;
+		}
+	}}(result);
+	_block.statements = move(result.statements);
+	return true;
+}
+
+void OptimisedFunctionCache::store(string _key, SourceLocation const& _location, Block const& _result)
+{
+	Block copy = std::get<Block>(ASTCopier{}(_result));
+	lock_guard<mutex> lock(m_mutex);
+	if (m_entries.size() >= MaxEntries)
+		m_entries.clear();
+	m_entries.emplace(move(_key), Entry{_location, move(copy)});
+}
+
+void OptimisedFunctionCache::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.clear();
+}
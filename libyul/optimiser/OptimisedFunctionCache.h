@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the results of function-local optimiser steps.
+ */
+
+#pragma once
+
+#include <libyul/AST.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Process-wide cache of the results of function-local optimiser steps run on a single
+ * function (or the outermost block) by the OptimiserSuite, keyed by the code of the function.
+ *
+ * The same utility functions are generated for most contracts and for both the creation and
+ * the deployed code of a contract, so their optimisation is only done once.
+ *
+ * Apart from the step and the dialect, the key consists of the printed code, the source
+ * locations relative to the location of the function and the side effects of the called
+ * functions if the step uses them. Cached results are moved to the location of the function
+ * they are used for. Functions whose source locations refer to different sources are not cached.
+ */
+class OptimisedFunctionCache
+{
+public:
+	static OptimisedFunctionCache& instance();
+
+	/// @returns the key of running the step @a _step on the single statement of @a _block, or
+	/// nullopt if the result cannot be cached.
+	/// @param _functionSideEffects side effects of all functions if the step depends on them.
+	static std::optional<std::string> key(
+		std::string const& _step,
+		Dialect const& _dialect,
+		Block& _block,
+		std::map<YulString, SideEffects> const* _functionSideEffects
+	);
+
+	/// Replaces the statement of @a _block by the result stored for @a _key, if there is one.
+	/// @returns true if a result was found.
+	bool lookup(std::string const& _key, Block& _block);
+	/// Stores @a _result as the result for @a _key, which was computed for a statement at
+	/// @a _location.
+	void store(std::string _key, langutil::SourceLocation const& _location, Block const& _result);
+
+	void clear();
+
+private:
+	struct Entry
+	{
+		langutil::SourceLocation location;
+		Block result;
+	};
+
+	/// The cache is cleared whenever it reaches this number of entries.
+	static size_t constexpr MaxEntries = 1 << 16;
+
+	std::mutex m_mutex;
+	std::map<std::string, Entry> m_entries;
+};
+
+}
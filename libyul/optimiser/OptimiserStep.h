@@ -20,6 +20,7 @@
 
 #include <libyul/Exceptions.h>
 
+#include <map>
 #include <optional>
 #include <string>
 #include <set>
@@ -31,12 +32,24 @@ struct Dialect;
 struct Block;
 class YulString;
 class NameDispenser;
+struct SideEffects;
+class GasMeter;
+struct ReasoningBasedSimplifierState;
 
 struct OptimiserStepContext
 {
 	Dialect const& dialect;
 	NameDispenser& dispenser;
 	std::set<YulString> const& reservedIdentifiers;
+	/// Side effects of all functions of the whole program, if the step is only run on a part of it.
+	/// Steps that need them compute them from the AST they are run on if this is not set.
+	std::map<YulString, SideEffects> const* functionSideEffects = nullptr;
+	/// Gas meter used to decide whether duplicating expressions or code is worth it.
+	/// Steps fall back to their code size heuristics if this is not set.
+	GasMeter const* gasMeter = nullptr;
+	/// Query cache and budget of the ReasoningBasedSimplifier, shared by all its runs on the
+	/// same program. Every run uses a fresh cache without budget if this is not set.
+	ReasoningBasedSimplifierState* reasoningState = nullptr;
 };
 
 
@@ -0,0 +1,156 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/OptimiserStepProfiler.h>
+
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/AST.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+double toMilliseconds(OptimiserStepProfiler::Clock::duration _duration)
+{
+	return chrono::duration<double, milli>(_duration).count();
+}
+
+vector<pair<string, OptimiserStepProfiler::StepStatistics>> sortedByDuration(
+	map<string, OptimiserStepProfiler::StepStatistics> const& _statistics
+)
+{
+	vector<pair<string, OptimiserStepProfiler::StepStatistics>> sorted(_statistics.begin(), _statistics.end());
+	stable_sort(sorted.begin(), sorted.end(), [](auto const& _a, auto const& _b) {
+		return _a.second.duration > _b.second.duration;
+	});
+	return sorted;
+}
+
+}
+
+OptimiserStepProfiler& OptimiserStepProfiler::instance()
+{
+	static OptimiserStepProfiler profiler;
+	return profiler;
+}
+
+void OptimiserStepProfiler::reset()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_statistics.clear();
+	m_ruleApplications.clear();
+}
+
+void OptimiserStepProfiler::measure(string const& _step, Block const& _ast, function<void()> const& _run)
+{
+	if (!enabled())
+	{
+		_run();
+		return;
+	}
+
+	size_t sizeBefore = CodeSize::codeSizeIncludingFunctions(_ast);
+	Clock::time_point start = Clock::now();
+	_run();
+	Clock::duration duration = Clock::now() - start;
+	size_t sizeAfter = CodeSize::codeSizeIncludingFunctions(_ast);
+
+	lock_guard<mutex> lock(m_mutex);
+	StepStatistics& statistics = m_statistics[_step];
+	++statistics.invocations;
+	if (sizeBefore == sizeAfter)
+		++statistics.invocationsWithoutSizeChange;
+	statistics.duration += duration;
+	statistics.codeSizeDelta += static_cast<long long>(sizeAfter) - static_cast<long long>(sizeBefore);
+}
+
+map<string, OptimiserStepProfiler::StepStatistics> OptimiserStepProfiler::statistics() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_statistics;
+}
+
+void OptimiserStepProfiler::recordRuleApplication(string const& _rule)
+{
+	if (!enabled())
+		return;
+	lock_guard<mutex> lock(m_mutex);
+	++m_ruleApplications[_rule];
+}
+
+map<string, size_t> OptimiserStepProfiler::ruleApplications() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_ruleApplications;
+}
+
+Json::Value OptimiserStepProfiler::toJson() const
+{
+	Json::Value steps(Json::arrayValue);
+	for (auto const& [name, statistics]: sortedByDuration(this->statistics()))
+	{
+		Json::Value step(Json::objectValue);
+		step["step"] = name;
+		step["invocations"] = Json::UInt64(statistics.invocations);
+		step["invocationsWithoutSizeChange"] = Json::UInt64(statistics.invocationsWithoutSizeChange);
+		step["wallTimeMs"] = toMilliseconds(statistics.duration);
+		step["codeSizeDelta"] = Json::Int64(statistics.codeSizeDelta);
+		steps.append(step);
+	}
+	return steps;
+}
+
+string OptimiserStepProfiler::toString() const
+{
+	size_t constexpr nameWidth = 32;
+	ostringstream out;
+	out << left << setw(nameWidth) << "Step" << right <<
+		setw(14) << "Wall time" <<
+		setw(10) << "Calls" <<
+		setw(12) << "Unchanged" <<
+		setw(14) << "Size delta" << endl;
+	for (auto const& [name, statistics]: sortedByDuration(this->statistics()))
+		out << left << setw(nameWidth) << name << right <<
+			setw(11) << fixed << setprecision(3) << toMilliseconds(statistics.duration) << " ms" <<
+			setw(10) << statistics.invocations <<
+			setw(12) << statistics.invocationsWithoutSizeChange <<
+			setw(14) << statistics.codeSizeDelta << endl;
+	return out.str();
+}
+
+string OptimiserStepProfiler::rulesToString() const
+{
+	auto applications = ruleApplications();
+	vector<pair<string, size_t>> sorted(applications.begin(), applications.end());
+	stable_sort(sorted.begin(), sorted.end(), [](auto const& _a, auto const& _b) {
+		return _a.second > _b.second;
+	});
+	ostringstream out;
+	out << right << setw(12) << "Applications" << "  " << left << "Rule" << endl;
+	for (auto const& [rule, count]: sorted)
+		out << right << setw(12) << count << "  " << left << rule << endl;
+	return out.str();
+}
@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collection of per-step statistics of the Yul optimiser.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+
+#include <json/json.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace solidity::yul
+{
+
+/**
+ * Process-wide collector of the number of invocations, the wall-clock time and the change
+ * in code size (as measured by CodeSize) of each optimiser step run by the OptimiserSuite,
+ * and of the number of times each simplification rule was applied by the ExpressionSimplifier.
+ *
+ * Collection is disabled by default. Measuring the code size requires a walk over the whole
+ * AST before and after each step, so this should only be enabled for diagnostic purposes.
+ */
+class OptimiserStepProfiler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct StepStatistics
+	{
+		size_t invocations = 0;
+		/// Number of invocations that did not change the code size.
+		size_t invocationsWithoutSizeChange = 0;
+		Clock::duration duration = Clock::duration::zero();
+		/// Sum of the code size after each invocation minus the code size before it.
+		long long codeSizeDelta = 0;
+	};
+
+	static OptimiserStepProfiler& instance();
+
+	void setEnabled(bool _enabled) { m_enabled = _enabled; }
+	bool enabled() const { return m_enabled; }
+
+	/// Discards all statistics.
+	void reset();
+
+	/// Calls @a _run, which has to run the step @a _step on @a _ast, and records its statistics
+	/// if collection is enabled.
+	void measure(std::string const& _step, Block const& _ast, std::function<void()> const& _run);
+
+	std::map<std::string, StepStatistics> statistics() const;
+
+	/// Counts an application of the simplification rule with the pattern @a _rule.
+	/// Callers should check enabled() first to avoid formatting the pattern.
+	void recordRuleApplication(std::string const& _rule);
+	/// @returns the number of applications of each simplification rule, indexed by its pattern.
+	std::map<std::string, size_t> ruleApplications() const;
+
+	/// @returns a JSON array of objects with the keys "step", "invocations", "invocationsWithoutSizeChange",
+	/// "wallTimeMs" and "codeSizeDelta", ordered by decreasing wall-clock time.
+	Json::Value toJson() const;
+	/// @returns a human-readable table of the statistics, ordered by decreasing wall-clock time.
+	std::string toString() const;
+	/// @returns a human-readable table of the simplification rules that were applied,
+	/// ordered by decreasing number of applications.
+	std::string rulesToString() const;
+
+private:
+	OptimiserStepProfiler() = default;
+
+	std::atomic<bool> m_enabled{false};
+	mutable std::mutex m_mutex;
+	std::map<std::string, StepStatistics> m_statistics;
+	std::map<std::string, size_t> m_ruleApplications;
+};
+
+}
@@ -0,0 +1,458 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that decides conditions using ranges of the values of expressions.
+ */
+
+#include <libyul/optimiser/RangeBasedSimplifier.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <variant>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximum depth of the values of variables and of nested calls followed to compute a range.
+size_t constexpr MaxDepth = 16;
+
+u256 const maxValue = ~u256(0);
+
+/// @returns the smallest value of the form 2**n - 1 that is not less than @a _value.
+u256 fillBits(u256 const& _value)
+{
+	if (_value == 0)
+		return 0;
+	unsigned bits = boost::multiprecision::msb(_value) + 1;
+	return bits >= 256 ? maxValue : (u256(1) << bits) - 1;
+}
+
+}
+
+void RangeBasedSimplifier::run(OptimiserStepContext& _context, Block& _ast)
+{
+	RangeBasedSimplifier{
+		_context.dialect,
+		_context.functionSideEffects ?
+			*_context.functionSideEffects :
+			SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		terminatingFunctions(_context.dialect, _ast)
+	}(_ast);
+}
+
+RangeBasedSimplifier::RangeBasedSimplifier(
+	Dialect const& _dialect,
+	map<YulString, SideEffects> _functionSideEffects,
+	set<YulString> _terminatingFunctions
+):
+	DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
+	m_terminatingFunctions(std::move(_terminatingFunctions))
+{
+}
+
+void RangeBasedSimplifier::operator()(Assignment& _assignment)
+{
+	for (Identifier const& variable: _assignment.variableNames)
+		m_ranges.erase(variable.name);
+	DataFlowAnalyzer::operator()(_assignment);
+}
+
+void RangeBasedSimplifier::operator()(VariableDeclaration& _varDecl)
+{
+	// Variables declared inside of loops are declared again in every iteration.
+	for (TypedName const& variable: _varDecl.variables)
+		m_ranges.erase(variable.name);
+	DataFlowAnalyzer::operator()(_varDecl);
+}
+
+void RangeBasedSimplifier::operator()(If& _if)
+{
+	map<YulString, Range> ranges = m_ranges;
+	// The facts are derived from the original condition,
+	// but must not be used to decide the condition itself.
+	addFacts(*_if.condition, true);
+	map<YulString, Range> bodyRanges = m_ranges;
+	m_ranges = ranges;
+
+	if (SideEffectsCollector{m_dialect, *_if.condition, &m_functionSideEffects}.movable())
+	{
+		Range condition = range(*_if.condition);
+		if (condition.max == 0)
+		{
+			Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
+			falseCondition.location = locationOf(*_if.condition);
+			_if.condition = make_unique<Expression>(move(falseCondition));
+			_if.body = Block{};
+		}
+		else if (condition.min > 0)
+		{
+			Literal trueCondition = m_dialect.trueLiteral();
+			trueCondition.location = locationOf(*_if.condition);
+			_if.condition = make_unique<Expression>(move(trueCondition));
+		}
+	}
+
+	m_ranges = move(bodyRanges);
+	DataFlowAnalyzer::operator()(_if);
+	restoreRanges(move(ranges), _if.body);
+
+	// The code after the if statement is only reached if the condition is false,
+	// unless the body flows out.
+	if (controlFlow(m_dialect, m_terminatingFunctions, _if.body) != TerminationFinder::ControlFlow::FlowOut)
+		addFacts(*_if.condition, false);
+}
+
+void RangeBasedSimplifier::operator()(ForLoop& _for)
+{
+	map<YulString, Range> ranges = m_ranges;
+	Assignments assignments;
+	assignments(_for.body);
+	assignments(_for.post);
+	// The values and ranges of the variables before the loop do not hold in later iterations.
+	clearValues(assignments.names());
+	for (YulString name: assignments.names())
+		m_ranges.erase(name);
+
+	// The condition holds at the start of the body. For the variables that are not assigned
+	// in the body, it also holds in the post block.
+	addFacts(*_for.condition, true);
+	DataFlowAnalyzer::operator()(_for);
+
+	m_ranges = move(ranges);
+	for (YulString name: assignments.names())
+		m_ranges.erase(name);
+}
+
+void RangeBasedSimplifier::operator()(FunctionDefinition& _function)
+{
+	map<YulString, Range> ranges;
+	swap(m_ranges, ranges);
+	DataFlowAnalyzer::operator()(_function);
+	swap(m_ranges, ranges);
+}
+
+void RangeBasedSimplifier::operator()(Block& _block)
+{
+	map<YulString, Range> ranges = m_ranges;
+	DataFlowAnalyzer::operator()(_block);
+	restoreRanges(move(ranges), _block);
+}
+
+set<YulString> RangeBasedSimplifier::terminatingFunctions(Dialect const& _dialect, Block const& _ast)
+{
+	set<YulString> result;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (Statement const& statement: _ast.statements)
+			if (FunctionDefinition const* function = get_if<FunctionDefinition>(&statement))
+				// ``leave`` can be nested in statements that controlFlow considers to flow out,
+				// so functions containing it are never considered terminating.
+				if (
+					!result.count(function->name) &&
+					!LeaveFinder::containsLeave(*function) &&
+					controlFlow(_dialect, result, function->body) == TerminationFinder::ControlFlow::Terminate
+				)
+				{
+					result.insert(function->name);
+					changed = true;
+				}
+	}
+	return result;
+}
+
+TerminationFinder::ControlFlow RangeBasedSimplifier::controlFlow(
+	Dialect const& _dialect,
+	set<YulString> const& _terminatingFunctions,
+	Block const& _block
+)
+{
+	TerminationFinder terminationFinder{_dialect};
+	for (Statement const& statement: _block.statements)
+	{
+		TerminationFinder::ControlFlow controlFlow = terminationFinder.controlFlowKind(statement);
+		if (controlFlow != TerminationFinder::ControlFlow::FlowOut)
+			return controlFlow;
+		if (ExpressionStatement const* expressionStatement = get_if<ExpressionStatement>(&statement))
+			if (FunctionCall const* call = get_if<FunctionCall>(&expressionStatement->expression))
+				if (_terminatingFunctions.count(call->functionName.name))
+					return TerminationFinder::ControlFlow::Terminate;
+	}
+	return TerminationFinder::ControlFlow::FlowOut;
+}
+
+RangeBasedSimplifier::Range RangeBasedSimplifier::range(Expression const& _expression, size_t _depth)
+{
+	if (_depth > MaxDepth)
+		return Range{};
+	return std::visit(GenericVisitor{
+		[&](Literal const& _literal) {
+			u256 value = valueOfLiteral(_literal);
+			return Range{value, value};
+		},
+		[&](Identifier const& _identifier) {
+			Range result;
+			if (Range const* fact = valueOrNullptr(m_ranges, _identifier.name))
+				result = *fact;
+			if (AssignedValue const* value = valueOrNullptr(m_value, _identifier.name))
+				if (value->value)
+				{
+					Range valueRange = range(*value->value, _depth + 1);
+					// The intersection is empty only in unreachable code.
+					if (valueRange.min <= result.max && result.min <= valueRange.max)
+						result = {max(result.min, valueRange.min), min(result.max, valueRange.max)};
+				}
+			return result;
+		},
+		[&](FunctionCall const& _call) {
+			return builtinRange(_call, _depth);
+		}
+	}, _expression);
+}
+
+RangeBasedSimplifier::Range RangeBasedSimplifier::builtinRange(FunctionCall const& _call, size_t _depth)
+{
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	BuiltinFunctionForEVM const* builtin = dialect ? dialect->builtin(_call.functionName.name) : nullptr;
+	if (!builtin || !builtin->instruction)
+		return Range{};
+
+	auto argument = [&](size_t _index) { return range(_call.arguments.at(_index), _depth + 1); };
+	auto lessThan = [](Range const& _a, Range const& _b) {
+		if (_a.max < _b.min)
+			return Range{1, 1};
+		else if (_a.min >= _b.max)
+			return Range{0, 0};
+		else
+			return Range{0, 1};
+	};
+	auto isNonNegative = [](Range const& _a) { return _a.max < (u256(1) << 255); };
+
+	switch (*builtin->instruction)
+	{
+	case evmasm::Instruction::ADD:
+	{
+		Range a = argument(0);
+		Range b = argument(1);
+		if (a.max <= maxValue - b.max)
+			return Range{a.min + b.min, a.max + b.max};
+		break;
+	}
+	case evmasm::Instruction::SUB:
+	{
+		Range a = argument(0);
+		Range b = argument(1);
+		if (a.min >= b.max)
+			return Range{a.min - b.max, a.max - b.min};
+		break;
+	}
+	case evmasm::Instruction::MUL:
+	{
+		Range a = argument(0);
+		Range b = argument(1);
+		if (b.max == 0 || a.max <= maxValue / b.max)
+			return Range{a.min * b.min, a.max * b.max};
+		break;
+	}
+	case evmasm::Instruction::DIV:
+	{
+		// Division by zero results in zero.
+		Range a = argument(0);
+		Range b = argument(1);
+		return Range{b.min == 0 ? 0 : a.min / b.max, b.min == 0 ? a.max : a.max / b.min};
+	}
+	case evmasm::Instruction::MOD:
+	{
+		Range a = argument(0);
+		Range b = argument(1);
+		return Range{0, b.max == 0 ? 0 : min(a.max, b.max - 1)};
+	}
+	case evmasm::Instruction::NOT:
+	{
+		Range a = argument(0);
+		return Range{maxValue - a.max, maxValue - a.min};
+	}
+	case evmasm::Instruction::AND:
+		return Range{0, min(argument(0).max, argument(1).max)};
+	case evmasm::Instruction::OR:
+	{
+		Range a = argument(0);
+		Range b = argument(1);
+		return Range{max(a.min, b.min), fillBits(max(a.max, b.max))};
+	}
+	case evmasm::Instruction::XOR:
+		return Range{0, fillBits(max(argument(0).max, argument(1).max))};
+	case evmasm::Instruction::SHR:
+	{
+		Range shift = argument(0);
+		Range value = argument(1);
+		if (shift.min >= 256)
+			return Range{0, 0};
+		else if (shift.max >= 256)
+			return Range{0, value.max};
+		return Range{value.min >> unsigned(shift.max), value.max >> unsigned(shift.min)};
+	}
+	case evmasm::Instruction::BYTE:
+		return Range{0, 0xff};
+	case evmasm::Instruction::LT:
+		return lessThan(argument(0), argument(1));
+	case evmasm::Instruction::GT:
+		return lessThan(argument(1), argument(0));
+	case evmasm::Instruction::SLT:
+	case evmasm::Instruction::SGT:
+	{
+		Range a = argument(0);
+		Range b = argument(1);
+		if (!isNonNegative(a) || !isNonNegative(b))
+			return Range{0, 1};
+		return *builtin->instruction == evmasm::Instruction::SLT ? lessThan(a, b) : lessThan(b, a);
+	}
+	case evmasm::Instruction::EQ:
+	{
+		Range a = argument(0);
+		Range b = argument(1);
+		if (a.max < b.min || b.max < a.min)
+			return Range{0, 0};
+		else if (a.min == a.max && b.min == b.max)
+			return Range{1, 1};
+		else
+			return Range{0, 1};
+	}
+	case evmasm::Instruction::ISZERO:
+	{
+		Range a = argument(0);
+		if (a.max == 0)
+			return Range{1, 1};
+		else if (a.min > 0)
+			return Range{0, 0};
+		else
+			return Range{0, 1};
+	}
+	case evmasm::Instruction::ADDRESS:
+	case evmasm::Instruction::CALLER:
+	case evmasm::Instruction::ORIGIN:
+	case evmasm::Instruction::COINBASE:
+		return Range{0, (u256(1) << 160) - 1};
+	default:
+		break;
+	}
+	return Range{};
+}
+
+void RangeBasedSimplifier::addFacts(Expression const& _condition, bool _value, size_t _depth)
+{
+	if (_depth > MaxDepth)
+		return;
+
+	if (Identifier const* identifier = get_if<Identifier>(&_condition))
+	{
+		restrict(_condition, _value ? Range{1, maxValue} : Range{0, 0}, _depth);
+		if (AssignedValue const* value = valueOrNullptr(m_value, identifier->name))
+			if (value->value)
+				addFacts(*value->value, _value, _depth + 1);
+		return;
+	}
+
+	FunctionCall const* call = get_if<FunctionCall>(&_condition);
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	BuiltinFunctionForEVM const* builtin = call && dialect ? dialect->builtin(call->functionName.name) : nullptr;
+	if (!builtin || !builtin->instruction)
+		return;
+
+	switch (*builtin->instruction)
+	{
+	case evmasm::Instruction::ISZERO:
+		addFacts(call->arguments.at(0), !_value, _depth + 1);
+		break;
+	case evmasm::Instruction::LT:
+	case evmasm::Instruction::GT:
+	{
+		bool lessThan = *builtin->instruction == evmasm::Instruction::LT;
+		Expression const& smaller = call->arguments.at(lessThan ? 0 : 1);
+		Expression const& larger = call->arguments.at(lessThan ? 1 : 0);
+		Range smallerRange = range(smaller, _depth + 1);
+		Range largerRange = range(larger, _depth + 1);
+		if (_value)
+		{
+			if (largerRange.max > 0)
+				restrict(smaller, Range{0, largerRange.max - 1}, _depth);
+			if (smallerRange.min < maxValue)
+				restrict(larger, Range{smallerRange.min + 1, maxValue}, _depth);
+		}
+		else
+		{
+			restrict(smaller, Range{largerRange.min, maxValue}, _depth);
+			restrict(larger, Range{0, smallerRange.max}, _depth);
+		}
+		break;
+	}
+	case evmasm::Instruction::EQ:
+		if (_value)
+		{
+			Range a = range(call->arguments.at(0), _depth + 1);
+			Range b = range(call->arguments.at(1), _depth + 1);
+			restrict(call->arguments.at(0), b, _depth);
+			restrict(call->arguments.at(1), a, _depth);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void RangeBasedSimplifier::restrict(Expression const& _expression, Range _range, size_t _depth)
+{
+	Identifier const* identifier = get_if<Identifier>(&_expression);
+	if (!identifier || _depth > MaxDepth)
+		return;
+
+	Range current = range(_expression, _depth + 1);
+	// The intersection is empty only in unreachable code.
+	if (_range.max < current.min || current.max < _range.min)
+		return;
+	m_ranges[identifier->name] = {max(current.min, _range.min), min(current.max, _range.max)};
+
+	// A variable that is a copy of another variable has the same value.
+	if (AssignedValue const* value = valueOrNullptr(m_value, identifier->name))
+		if (value->value && holds_alternative<Identifier>(*value->value))
+			restrict(*value->value, _range, _depth + 1);
+}
+
+void RangeBasedSimplifier::restoreRanges(map<YulString, Range> _ranges, Block const& _block)
+{
+	m_ranges = move(_ranges);
+	if (m_ranges.empty())
+		return;
+	Assignments assignments;
+	assignments(_block);
+	for (YulString name: assignments.names())
+		m_ranges.erase(name);
+}
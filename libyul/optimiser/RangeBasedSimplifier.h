@@ -0,0 +1,120 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that decides conditions using ranges of the values of expressions.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Semantics.h>
+
+#include <libsolutil/Common.h>
+
+#include <map>
+#include <set>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimisation stage that computes a range of the possible values of the conditions of
+ * ``if`` statements and replaces the conditions that are known to be false or true
+ * by constants. The bodies of ``if`` statements whose condition is never true are removed.
+ *
+ * The range of an expression is an interval of unsigned values. It is derived from literals,
+ * from the values of variables known to the DataFlowAnalyzer and from arithmetic, comparison
+ * and bitwise builtins whose result range follows from the ranges of their arguments.
+ * Conditions narrow the ranges of the variables they compare: The condition of an ``if`` statement
+ * holds in its body, the condition of a ``for`` loop holds in its body and post block and the
+ * negation of the condition holds after an ``if`` statement whose body never flows out, e.g.
+ * because it ends in a call to a function that reverts.
+ *
+ * This removes the overflow checks of checked arithmetic whose operands are known to be small,
+ * like values of short types or loop counters compared to a bound:
+ *
+ *   for { let i := 0 } lt(i, n) { if eq(i, not(0)) { panic() } i := add(i, 1) } { ... }
+ *
+ * is turned into
+ *
+ *   for { let i := 0 } lt(i, n) { if 0 { } i := add(i, 1) } { ... }
+ *
+ * It is only effective on the EVM dialect, but safe to use on other dialects.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ *
+ * StructuralSimplifier is recommended afterwards to remove the constant ``if`` statements.
+ */
+class RangeBasedSimplifier: public DataFlowAnalyzer
+{
+public:
+	static constexpr char const* name{"RangeBasedSimplifier"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using DataFlowAnalyzer::operator();
+	void operator()(Assignment& _assignment) override;
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(If& _if) override;
+	void operator()(ForLoop& _for) override;
+	void operator()(FunctionDefinition& _function) override;
+	void operator()(Block& _block) override;
+
+private:
+	/// Range of unsigned values, including both ends.
+	struct Range
+	{
+		u256 min = 0;
+		u256 max = ~u256(0);
+	};
+
+	RangeBasedSimplifier(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		std::set<YulString> _terminatingFunctions
+	);
+
+	/// @returns the set of functions that do not contain ``leave`` and whose body always ends
+	/// in a terminating builtin or a call to another such function.
+	static std::set<YulString> terminatingFunctions(Dialect const& _dialect, Block const& _ast);
+	/// @returns the first unconditional change of control flow in @a _block,
+	/// treating calls to terminating functions like terminating builtins.
+	static TerminationFinder::ControlFlow controlFlow(
+		Dialect const& _dialect,
+		std::set<YulString> const& _terminatingFunctions,
+		Block const& _block
+	);
+
+	Range range(Expression const& _expression, size_t _depth = 0);
+	Range builtinRange(FunctionCall const& _call, size_t _depth);
+
+	/// Narrows the ranges of the variables in @a _condition using that its value is
+	/// non-zero if @a _value is true and zero otherwise.
+	void addFacts(Expression const& _condition, bool _value, size_t _depth = 0);
+	/// Narrows the range of @a _expression to @a _range if it is a variable.
+	void restrict(Expression const& _expression, Range _range, size_t _depth);
+
+	/// Resets the ranges to @a _ranges, except for the variables assigned in @a _block.
+	void restoreRanges(std::map<YulString, Range> _ranges, Block const& _block);
+
+	std::set<YulString> m_terminatingFunctions;
+	/// Ranges of the variables narrowed by conditions, valid until the variables are assigned to.
+	std::map<YulString, Range> m_ranges;
+};
+
+}
@@ -30,7 +30,9 @@
 
 #include <libsolutil/Visitor.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
 
+#include <functional>
 #include <utility>
 #include <memory>
 
@@ -43,7 +45,12 @@ using namespace solidity::smtutil;
 void ReasoningBasedSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
 	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	ReasoningBasedSimplifier{_context.dialect, ssaVars}(_ast);
+	ReasoningBasedSimplifierState localState;
+	ReasoningBasedSimplifier{
+		_context.dialect,
+		ssaVars,
+		_context.reasoningState ? *_context.reasoningState : localState
+	}(_ast);
 }
 
 std::optional<string> ReasoningBasedSimplifier::invalidInCurrentEnvironment()
@@ -64,7 +71,8 @@ void ReasoningBasedSimplifier::operator()(VariableDeclaration& _varDecl)
 		return;
 	bool const inserted = m_variables.insert({varName, m_solver->newVariable("yul_" + varName.str(), defaultSort())}).second;
 	yulAssert(inserted, "");
-	m_solver->addAssertion(m_variables.at(varName) == encodeExpression(*_varDecl.value));
+	m_variableNames.insert("yul_" + varName.str());
+	addFact(m_variables.at(varName) == encodeExpression(*_varDecl.value));
 }
 
 void ReasoningBasedSimplifier::operator()(If& _if)
@@ -73,10 +81,7 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 		return;
 
 	smtutil::Expression condition = encodeExpression(*_if.condition);
-	m_solver->push();
-	m_solver->addAssertion(condition == constantValue(0));
-	CheckResult result = m_solver->check({}).first;
-	m_solver->pop();
+	CheckResult result = check(condition == constantValue(0));
 	if (result == CheckResult::UNSATISFIABLE)
 	{
 		Literal trueCondition = m_dialect.trueLiteral();
@@ -85,10 +90,7 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 	}
 	else
 	{
-		m_solver->push();
-		m_solver->addAssertion(condition != constantValue(0));
-		CheckResult result2 = m_solver->check({}).first;
-		m_solver->pop();
+		CheckResult result2 = check(condition != constantValue(0));
 		if (result2 == CheckResult::UNSATISFIABLE)
 		{
 			Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
@@ -100,24 +102,142 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 		}
 	}
 
-	m_solver->push();
-	m_solver->addAssertion(condition != constantValue(0));
+	size_t const outerFacts = m_facts.size();
+	addFact(condition != constantValue(0));
 
 	ASTModifier::operator()(_if.body);
 
-	m_solver->pop();
+	m_facts.erase(m_facts.begin() + static_cast<ptrdiff_t>(outerFacts), m_facts.end());
 }
 
 ReasoningBasedSimplifier::ReasoningBasedSimplifier(
 	Dialect const& _dialect,
-	set<YulString> const& _ssaVariables
+	set<YulString> const& _ssaVariables,
+	ReasoningBasedSimplifierState& _state
 ):
 	m_dialect(_dialect),
 	m_ssaVariables(_ssaVariables),
+	m_state(_state),
 	m_solver(make_unique<smtutil::SMTPortfolio>())
 {
 }
 
+void ReasoningBasedSimplifier::addFact(smtutil::Expression _fact)
+{
+	set<string> variables;
+	set<void const*> visited;
+	vector<smtutil::Expression const*> toVisit{&_fact};
+	while (!toVisit.empty())
+	{
+		smtutil::Expression const* expression = toVisit.back();
+		toVisit.pop_back();
+		if (expression->arguments.empty())
+		{
+			if (m_variableNames.count(expression->name))
+				variables.insert(expression->name);
+		}
+		else if (visited.insert(expression->arguments.shared().get()).second)
+			for (auto const& argument: expression->arguments)
+				toVisit.push_back(&argument);
+	}
+	m_facts.emplace_back(move(_fact), move(variables));
+}
+
+CheckResult ReasoningBasedSimplifier::check(smtutil::Expression const& _query)
+{
+	// The query is the last fact while the relevant facts are collected.
+	addFact(_query);
+	map<string, vector<size_t>> factsByVariable;
+	for (size_t i = 0; i < m_facts.size(); ++i)
+		for (string const& variable: m_facts[i].second)
+			factsByVariable[variable].push_back(i);
+
+	vector<bool> relevant(m_facts.size(), false);
+	relevant.back() = true;
+	set<string> visitedVariables;
+	vector<string> toVisit(m_facts.back().second.begin(), m_facts.back().second.end());
+	while (!toVisit.empty())
+	{
+		string variable = move(toVisit.back());
+		toVisit.pop_back();
+		if (!visitedVariables.insert(variable).second)
+			continue;
+		for (size_t index: factsByVariable[variable])
+			if (!relevant[index])
+			{
+				relevant[index] = true;
+				toVisit += m_facts[index].second;
+			}
+	}
+	m_facts.pop_back();
+
+	vector<smtutil::Expression const*> facts;
+	for (size_t i = 0; i < m_facts.size(); ++i)
+		if (relevant[i])
+			facts.push_back(&m_facts[i].first);
+
+	util::h256 hash = normalisedQueryHash(_query, facts);
+	if (auto cached = m_state.results.find(hash); cached != m_state.results.end())
+		return cached->second;
+	if (m_state.exhausted())
+		return CheckResult::UNKNOWN;
+
+	m_solver->push();
+	for (smtutil::Expression const* fact: facts)
+		m_solver->addAssertion(*fact);
+	m_solver->addAssertion(_query);
+	CheckResult result = m_solver->check({}).first;
+	m_solver->pop();
+	++m_state.queries;
+
+	m_state.results[hash] = result;
+	return result;
+}
+
+util::h256 ReasoningBasedSimplifier::normalisedQueryHash(
+	smtutil::Expression const& _query,
+	vector<smtutil::Expression const*> const& _facts
+) const
+{
+	map<string, size_t> renaming;
+	// Subexpressions shared in the encoding are only written once and referred to by number afterwards.
+	map<pair<void const*, string>, size_t> sharedNodes;
+	string normalised;
+	function<void(smtutil::Expression const&)> write = [&](smtutil::Expression const& _expression) {
+		if (_expression.arguments.empty())
+		{
+			if (m_variableNames.count(_expression.name))
+				normalised += "v" + to_string(renaming.emplace(_expression.name, renaming.size()).first->second);
+			else
+				normalised += _expression.name;
+			return;
+		}
+		auto [node, inserted] = sharedNodes.emplace(
+			make_pair(_expression.arguments.shared().get(), _expression.name),
+			sharedNodes.size()
+		);
+		if (!inserted)
+		{
+			normalised += "@" + to_string(node->second);
+			return;
+		}
+		normalised += "(" + _expression.name;
+		for (auto const& argument: _expression.arguments)
+		{
+			normalised += " ";
+			write(argument);
+		}
+		normalised += ")";
+	};
+	for (smtutil::Expression const* fact: _facts)
+	{
+		write(*fact);
+		normalised += "\n";
+	}
+	write(_query);
+	return util::keccak256(normalised);
+}
+
 smtutil::Expression ReasoningBasedSimplifier::encodeExpression(yul::Expression const& _expression)
 {
 	return std::visit(GenericVisitor{
@@ -275,13 +395,15 @@ smtutil::Expression ReasoningBasedSimplifier::bv2int(smtutil::Expression _arg) c
 
 smtutil::Expression ReasoningBasedSimplifier::newVariable()
 {
-	return m_solver->newVariable(uniqueName(), defaultSort());
+	string name = uniqueName();
+	m_variableNames.insert(name);
+	return m_solver->newVariable(move(name), defaultSort());
 }
 
 smtutil::Expression ReasoningBasedSimplifier::newRestrictedVariable()
 {
 	smtutil::Expression var = newVariable();
-	m_solver->addAssertion(0 <= var && var < smtutil::Expression(bigint(1) << 256));
+	addFact(0 <= var && var < smtutil::Expression(bigint(1) << 256));
 	return var;
 }
 
@@ -332,6 +454,6 @@ smtutil::Expression ReasoningBasedSimplifier::wrap(smtutil::Expression _value)
 {
 	smtutil::Expression rest = newRestrictedVariable();
 	smtutil::Expression multiplier = newVariable();
-	m_solver->addAssertion(_value == multiplier * smtutil::Expression(bigint(1) << 256) + rest);
+	addFact(_value == multiplier * smtutil::Expression(bigint(1) << 256) + rest);
 	return rest;
 }
@@ -23,17 +23,32 @@
 // because of instruction
 #include <libyul/backends/evm/EVMDialect.h>
 
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/FixedHash.h>
+
 #include <map>
+#include <optional>
 
-namespace solidity::smtutil
+namespace solidity::yul
 {
-class SolverInterface;
-class Expression;
-struct Sort;
-}
 
-namespace solidity::yul
+/**
+ * Results of the solver queries of the ReasoningBasedSimplifier and the budget left for
+ * further queries, shared by all runs of the step on a Yul object.
+ */
+struct ReasoningBasedSimplifierState
 {
+	/// Maximum number of queries sent to the solvers, unlimited if not set.
+	std::optional<size_t> maxQueries;
+
+	size_t queries = 0;
+	/// Results indexed by the hash of the normalised query.
+	std::map<util::h256, smtutil::CheckResult> results;
+
+	/// @returns true if no further queries may be sent to the solvers.
+	bool exhausted() const { return maxQueries && queries >= *maxQueries; }
+};
 
 /**
  * Reasoning-based simplifier.
@@ -42,6 +57,12 @@ namespace solidity::yul
  * - If `constraints AND NOT condition` is UNSAT, the condition is always true and can be replaced by `1`.
  * The simplifications above can only be applied if the condition is movable.
  *
+ * The constraints of a query are only the facts (variable definitions and conditions of enclosing
+ * `if` statements) that share variables with the condition, directly or through other such facts.
+ * With the variables renamed in the order of their occurrence, these form the normalised query,
+ * whose result is stored in the ReasoningBasedSimplifierState and reused by later runs of the step.
+ * If the query budget of the state is used up, no further conditions are simplified.
+ *
  * It is only effective on the EVM dialect, but safe to use on other dialects.
  *
  * Prerequisite: Disambiguator, SSATransform.
@@ -60,13 +81,26 @@ public:
 private:
 	explicit ReasoningBasedSimplifier(
 		Dialect const& _dialect,
-		std::set<YulString> const& _ssaVariables
+		std::set<YulString> const& _ssaVariables,
+		ReasoningBasedSimplifierState& _state
 	);
 
 	smtutil::Expression encodeExpression(
 		Expression const& _expression
 	);
 
+	/// Adds @a _fact to the facts known at the current point of the code.
+	void addFact(smtutil::Expression _fact);
+	/// @returns the result of checking the satisfiability of @a _query under the facts that
+	/// share variables with it, from the state if the same normalised query was already answered.
+	smtutil::CheckResult check(smtutil::Expression const& _query);
+	/// @returns the hash of @a _query and @a _facts after renaming the variables
+	/// in the order of their first occurrence.
+	util::h256 normalisedQueryHash(
+		smtutil::Expression const& _query,
+		std::vector<smtutil::Expression const*> const& _facts
+	) const;
+
 	virtual smtutil::Expression encodeEVMBuiltin(
 		evmasm::Instruction _instruction,
 		std::vector<Expression> const& _arguments
@@ -89,8 +123,13 @@ private:
 
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
+	ReasoningBasedSimplifierState& m_state;
 	std::unique_ptr<smtutil::SolverInterface> m_solver;
 	std::map<YulString, smtutil::Expression> m_variables;
+	/// Names of all variables declared to the solver.
+	std::set<std::string> m_variableNames;
+	/// Facts known at the current point of the code together with the variables they contain.
+	std::vector<std::pair<smtutil::Expression, std::set<std::string>>> m_facts;
 
 	size_t m_varCounter = 0;
 };
@@ -62,8 +62,13 @@ void RedundantAssignEliminator::operator()(Assignment const& _assignment)
 		changeUndecidedTo(var.name, State::Unused);
 
 	if (_assignment.variableNames.size() == 1)
+	{
+		VariableNumbering::VariableId id = m_variables.add(_assignment.variableNames.front().name);
+		if (m_assignments.size() <= id)
+			m_assignments.resize(id + 1);
 		// Default-construct it in "Undecided" state if it does not yet exist.
-		m_assignments[_assignment.variableNames.front().name][&_assignment];
+		m_assignments[id][&_assignment];
+	}
 }
 
 void RedundantAssignEliminator::operator()(If const& _if)
@@ -104,10 +109,12 @@ void RedundantAssignEliminator::operator()(Switch const& _switch)
 
 void RedundantAssignEliminator::operator()(FunctionDefinition const& _functionDefinition)
 {
+	VariableNumbering outerVariables;
 	std::set<YulString> outerDeclaredVariables;
 	std::set<YulString> outerReturnVariables;
 	TrackedAssignments outerAssignments;
 	ForLoopInfo forLoopInfo;
+	swap(m_variables, outerVariables);
 	swap(m_declaredVariables, outerDeclaredVariables);
 	swap(m_returnVariables, outerReturnVariables);
 	swap(m_assignments, outerAssignments);
@@ -123,6 +130,7 @@ void RedundantAssignEliminator::operator()(FunctionDefinition const& _functionDe
 	for (auto const& retParam: _functionDefinition.returnVariables)
 		finalize(retParam.name, State::Used);
 
+	swap(m_variables, outerVariables);
 	swap(m_declaredVariables, outerDeclaredVariables);
 	swap(m_returnVariables, outerReturnVariables);
 	swap(m_assignments, outerAssignments);
@@ -175,11 +183,10 @@ void RedundantAssignEliminator::operator()(ForLoop const& _forLoop)
 		// We do not have to do that with the "break" or "continue" paths, because
 		// they will be joined later anyway.
 		// TODO parallel traversal might be more efficient here.
-		for (auto& var: m_assignments)
-			for (auto& assignment: var.second)
+		for (size_t id = 0; id < m_assignments.size(); ++id)
+			for (auto& assignment: m_assignments[id])
 			{
-				auto zeroIt = zeroRuns.find(var.first);
-				if (zeroIt != zeroRuns.end() && zeroIt->second.count(assignment.first))
+				if (id < zeroRuns.size() && zeroRuns[id].count(assignment.first))
 					continue;
 				assignment.second = State::Value::Used;
 			}
@@ -256,13 +263,11 @@ void joinMap(std::map<K, V>& _a, std::map<K, V>&& _b, F _conflictSolver)
 
 void RedundantAssignEliminator::merge(TrackedAssignments& _target, TrackedAssignments&& _other)
 {
-	joinMap(_target, move(_other), [](
-		map<Assignment const*, State>& _assignmentHere,
-		map<Assignment const*, State>&& _assignmentThere
-	)
-	{
-		return joinMap(_assignmentHere, move(_assignmentThere), State::join);
-	});
+	if (_target.size() < _other.size())
+		_target.resize(_other.size());
+	for (size_t id = 0; id < _other.size(); ++id)
+		joinMap(_target[id], move(_other[id]), State::join);
+	_other.clear();
 }
 
 void RedundantAssignEliminator::merge(TrackedAssignments& _target, vector<TrackedAssignments>&& _source)
@@ -274,27 +279,34 @@ void RedundantAssignEliminator::merge(TrackedAssignments& _target, vector<Tracke
 
 void RedundantAssignEliminator::changeUndecidedTo(YulString _variable, RedundantAssignEliminator::State _newState)
 {
-	for (auto& assignment: m_assignments[_variable])
+	optional<VariableNumbering::VariableId> id = m_variables.id(_variable);
+	if (!id || *id >= m_assignments.size())
+		return;
+	for (auto& assignment: m_assignments[*id])
 		if (assignment.second == State::Undecided)
 			assignment.second = _newState;
 }
 
 void RedundantAssignEliminator::finalize(YulString _variable, RedundantAssignEliminator::State _finalState)
 {
-	std::map<Assignment const*, State> assignments;
-	joinMap(assignments, std::move(m_assignments[_variable]), State::join);
-	m_assignments.erase(_variable);
+	optional<VariableNumbering::VariableId> id = m_variables.id(_variable);
+	if (!id)
+		// The variable was never assigned to.
+		return;
 
+	std::map<Assignment const*, State> assignments;
+	auto take = [&](TrackedAssignments& _tracked) {
+		if (*id < _tracked.size())
+		{
+			joinMap(assignments, std::move(_tracked[*id]), State::join);
+			_tracked[*id].clear();
+		}
+	};
+	take(m_assignments);
 	for (auto& breakAssignments: m_forLoopInfo.pendingBreakStmts)
-	{
-		joinMap(assignments, std::move(breakAssignments[_variable]), State::join);
-		breakAssignments.erase(_variable);
-	}
+		take(breakAssignments);
 	for (auto& continueAssignments: m_forLoopInfo.pendingContinueStmts)
-	{
-		joinMap(assignments, std::move(continueAssignments[_variable]), State::join);
-		continueAssignments.erase(_variable);
-	}
+		take(continueAssignments);
 
 	for (auto const& assignment: assignments)
 	{
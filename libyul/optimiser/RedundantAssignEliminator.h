@@ -25,6 +25,7 @@
 #include <libyul/ASTForward.h>
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/VariableNumbering.h>
 
 #include <map>
 #include <vector>
@@ -148,9 +149,9 @@ private:
 		Value m_value = Undecided;
 	};
 
-	// TODO check that this does not cause nondeterminism!
-	// This could also be a pseudo-map from state to assignment.
-	using TrackedAssignments = std::map<YulString, std::map<Assignment const*, State>>;
+	/// Assignment states per variable, indexed by the id of the variable in ``m_variables``.
+	/// The vector can be shorter than the number of variables, missing entries are empty.
+	using TrackedAssignments = std::vector<std::map<Assignment const*, State>>;
 
 	/// Joins the assignment mapping of @a _source into @a _target according to the rules laid out
 	/// above.
@@ -164,6 +165,8 @@ private:
 	void finalize(YulString _variable, State _finalState);
 
 	Dialect const* m_dialect;
+	/// Ids of the variables of the current function, assigned when they are first assigned to.
+	VariableNumbering m_variables;
 	std::set<YulString> m_declaredVariables;
 	std::set<YulString> m_returnVariables;
 	std::set<Assignment const*> m_pendingRemovals;
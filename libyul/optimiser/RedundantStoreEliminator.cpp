@@ -0,0 +1,455 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that removes stores to storage and memory that are overwritten before they are read.
+ */
+
+#include <libyul/optimiser/RedundantStoreEliminator.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/ControlFlowGraph.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <boost/range/adaptor/reversed.hpp>
+
+#include <variant>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Location in storage or memory: The value of a variable, or zero for the empty name,
+/// plus a constant offset.
+using Location = pair<YulString, u256>;
+
+/**
+ * Set of the locations that are written to on every path before they may be read,
+ * i.e. locations whose current contents are never read.
+ */
+struct DeadLocations
+{
+	/// If set, the contents of all locations are never read.
+	bool all = true;
+	set<Location> locations;
+
+	bool contains(Location const& _location) const { return all || locations.count(_location); }
+	void clear()
+	{
+		all = false;
+		locations.clear();
+	}
+	void intersect(DeadLocations const& _other)
+	{
+		if (_other.all)
+			return;
+		if (all)
+			*this = _other;
+		else
+			locations = locations - (locations - _other.locations);
+	}
+	bool operator==(DeadLocations const& _other) const
+	{
+		return all == _other.all && locations == _other.locations;
+	}
+};
+
+struct State
+{
+	DeadLocations storage;
+	DeadLocations memory;
+
+	bool operator==(State const& _other) const
+	{
+		return storage == _other.storage && memory == _other.memory;
+	}
+};
+
+/**
+ * Finds the redundant stores in the control-flow graph of a function
+ * or of the code outside of functions by a backwards data-flow analysis.
+ */
+class RedundantStoreFinder
+{
+public:
+	RedundantStoreFinder(
+		EVMDialect const& _dialect,
+		map<YulString, SideEffects> const& _functionSideEffects,
+		set<YulString> const& _haltingFunctions,
+		map<YulString, Expression const*> const& _ssaValues,
+		bool _analyseMemory,
+		set<Statement const*>& _redundantStores
+	):
+		m_dialect(_dialect),
+		m_functionSideEffects(_functionSideEffects),
+		m_haltingFunctions(_haltingFunctions),
+		m_ssaValues(_ssaValues),
+		m_analyseMemory(_analyseMemory),
+		m_redundantStores(_redundantStores)
+	{}
+
+	void run(ControlFlowGraph const& _graph, bool _isFunction)
+	{
+		vector<State> stateAtStart(_graph.blocks().size());
+		vector<ControlFlowGraph::BlockId> order = _graph.reversePostOrder();
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+			for (ControlFlowGraph::BlockId id: order | boost::adaptors::reversed)
+			{
+				State state = transfer(_graph.block(id), stateAtEnd(_graph.block(id), stateAtStart, _isFunction), false);
+				if (!(state == stateAtStart[id]))
+				{
+					stateAtStart[id] = move(state);
+					changed = true;
+				}
+			}
+		}
+		for (ControlFlowGraph::BlockId id: order)
+			transfer(_graph.block(id), stateAtEnd(_graph.block(id), stateAtStart, _isFunction), true);
+	}
+
+private:
+	using BasicBlock = ControlFlowGraph::BasicBlock;
+
+	State stateAtEnd(BasicBlock const& _block, vector<State> const& _stateAtStart, bool _isFunction) const
+	{
+		State state;
+		if (_block.exit == BasicBlock::Exit::Return)
+		{
+			// The caller may read everything. The contents of storage persist after the end
+			// of the code outside of functions, while memory is discarded.
+			state.storage.clear();
+			if (_isFunction)
+				state.memory.clear();
+		}
+		else if (_block.exit != BasicBlock::Exit::Terminate)
+			for (ControlFlowGraph::BlockId successor: _block.successors)
+			{
+				state.storage.intersect(_stateAtStart[successor].storage);
+				state.memory.intersect(_stateAtStart[successor].memory);
+			}
+		if (_block.condition)
+			transfer(*_block.condition, state);
+		return state;
+	}
+
+	State transfer(BasicBlock const& _block, State _state, bool _recordRedundantStores)
+	{
+		for (Statement const* statement: _block.statements | boost::adaptors::reversed)
+		{
+			if (_recordRedundantStores && isRedundantStore(*statement, _state))
+				m_redundantStores.insert(statement);
+			std::visit(GenericVisitor{
+				[&](ExpressionStatement const& _statement) { transfer(_statement.expression, _state); },
+				[&](Assignment const& _assignment) {
+					for (Identifier const& variable: _assignment.variableNames)
+						forget(variable.name, _state);
+					transfer(*_assignment.value, _state);
+				},
+				[&](VariableDeclaration const& _varDecl) {
+					for (TypedName const& variable: _varDecl.variables)
+						forget(variable.name, _state);
+					if (_varDecl.value)
+						transfer(*_varDecl.value, _state);
+				},
+				[&](auto const&) { yulAssert(false, "Unexpected statement in basic block."); }
+			}, *statement);
+		}
+		return _state;
+	}
+
+	/// Updates @a _state from after the evaluation of @a _expression to before it.
+	void transfer(Expression const& _expression, State& _state) const
+	{
+		FunctionCall const* call = get_if<FunctionCall>(&_expression);
+		if (!call)
+			return;
+		transferCall(*call, _state);
+		// Arguments are evaluated from right to left.
+		for (Expression const& argument: call->arguments)
+			transfer(argument, _state);
+	}
+
+	void transferCall(FunctionCall const& _call, State& _state) const
+	{
+		BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_call.functionName.name);
+		if (!builtin)
+		{
+			SideEffects const* sideEffects = valueOrNullptr(m_functionSideEffects, _call.functionName.name);
+			bool halts = m_haltingFunctions.count(_call.functionName.name);
+			if (!sideEffects || halts || sideEffects->storage != SideEffects::None)
+				_state.storage.clear();
+			if (!sideEffects || halts || sideEffects->memory != SideEffects::None)
+				_state.memory.clear();
+			return;
+		}
+
+		optional<evmasm::Instruction> instruction = builtin->instruction;
+		if (instruction == evmasm::Instruction::SSTORE)
+		{
+			if (optional<Location> location = this->location(_call.arguments.at(0)))
+				if (!_state.storage.all)
+					_state.storage.locations.insert(*location);
+		}
+		else if (instruction == evmasm::Instruction::MSTORE)
+		{
+			if (optional<Location> location = this->location(_call.arguments.at(0)))
+				if (!_state.memory.all)
+					_state.memory.locations.insert(*location);
+		}
+		else if (instruction == evmasm::Instruction::SLOAD)
+			read(_state.storage, location(_call.arguments.at(0)), 1);
+		else if (instruction == evmasm::Instruction::MLOAD)
+			read(_state.memory, location(_call.arguments.at(0)), 32);
+		else
+		{
+			if (
+				instruction == evmasm::Instruction::RETURN ||
+				instruction == evmasm::Instruction::STOP ||
+				instruction == evmasm::Instruction::SELFDESTRUCT ||
+				builtin->sideEffects.storage != SideEffects::None
+			)
+				_state.storage.clear();
+			bool writesOnlyToMemory =
+				instruction == evmasm::Instruction::MSTORE8 ||
+				instruction == evmasm::Instruction::CALLDATACOPY ||
+				instruction == evmasm::Instruction::CODECOPY ||
+				instruction == evmasm::Instruction::EXTCODECOPY ||
+				instruction == evmasm::Instruction::RETURNDATACOPY;
+			if (builtin->sideEffects.memory != SideEffects::None && !writesOnlyToMemory)
+				_state.memory.clear();
+		}
+	}
+
+	/// Removes the locations that may overlap with the @a _size bytes or slots at @a _location.
+	static void read(DeadLocations& _dead, optional<Location> const& _location, unsigned _size)
+	{
+		if (!_location || _dead.all)
+		{
+			_dead.clear();
+			return;
+		}
+		for (auto it = _dead.locations.begin(); it != _dead.locations.end();)
+		{
+			u256 distance = it->second - _location->second;
+			if (it->first != _location->first || distance < _size || u256(0) - distance < _size)
+				it = _dead.locations.erase(it);
+			else
+				++it;
+		}
+	}
+
+	/// Removes the locations based on @a _variable, which is assigned to.
+	static void forget(YulString _variable, State& _state)
+	{
+		for (DeadLocations* dead: {&_state.storage, &_state.memory})
+			for (auto it = dead->locations.begin(); it != dead->locations.end();)
+				if (it->first == _variable)
+					it = dead->locations.erase(it);
+				else
+					++it;
+	}
+
+	bool isRedundantStore(Statement const& _statement, State const& _state) const
+	{
+		ExpressionStatement const* expressionStatement = get_if<ExpressionStatement>(&_statement);
+		FunctionCall const* call = expressionStatement ? get_if<FunctionCall>(&expressionStatement->expression) : nullptr;
+		BuiltinFunctionForEVM const* builtin = call ? m_dialect.builtin(call->functionName.name) : nullptr;
+		if (!builtin)
+			return false;
+		DeadLocations const* dead = nullptr;
+		if (builtin->instruction == evmasm::Instruction::SSTORE)
+			dead = &_state.storage;
+		else if (builtin->instruction == evmasm::Instruction::MSTORE && m_analyseMemory)
+			dead = &_state.memory;
+		else
+			return false;
+		for (Expression const& argument: call->arguments)
+			if (!holds_alternative<Identifier>(argument) && !holds_alternative<Literal>(argument))
+				return false;
+		optional<Location> location = this->location(call->arguments.at(0));
+		return location && dead->contains(*location);
+	}
+
+	/// @returns the location denoted by @a _expression at the point where it is evaluated.
+	/// If @a _nested is set, the location has to stay valid while the variables are in scope.
+	optional<Location> location(Expression const& _expression, bool _nested = false, size_t _depth = 0) const
+	{
+		if (Literal const* literal = get_if<Literal>(&_expression))
+			return Location{YulString{}, valueOfLiteral(*literal)};
+		Identifier const* identifier = get_if<Identifier>(&_expression);
+		if (!identifier)
+			return nullopt;
+
+		Expression const* const* value = valueOrNullptr(m_ssaValues, identifier->name);
+		if (value && *value && _depth < 16)
+		{
+			if (holds_alternative<Literal>(**value) || holds_alternative<Identifier>(**value))
+			{
+				if (optional<Location> result = location(**value, true, _depth + 1))
+					return result;
+			}
+			else if (FunctionCall const* call = get_if<FunctionCall>(*value))
+			{
+				optional<evmasm::Instruction> instruction;
+				if (BuiltinFunctionForEVM const* builtin = m_dialect.builtin(call->functionName.name))
+					instruction = builtin->instruction;
+				if (
+					(instruction == evmasm::Instruction::ADD || instruction == evmasm::Instruction::SUB) &&
+					holds_alternative<Literal>(call->arguments.at(1))
+				)
+				{
+					u256 offset = valueOfLiteral(std::get<Literal>(call->arguments.at(1)));
+					if (optional<Location> result = location(call->arguments.at(0), true, _depth + 1))
+						return Location{
+							result->first,
+							instruction == evmasm::Instruction::ADD ? result->second + offset : result->second - offset
+						};
+				}
+				else if (instruction == evmasm::Instruction::ADD && holds_alternative<Literal>(call->arguments.at(0)))
+				{
+					u256 offset = valueOfLiteral(std::get<Literal>(call->arguments.at(0)));
+					if (optional<Location> result = location(call->arguments.at(1), true, _depth + 1))
+						return Location{result->first, result->second + offset};
+				}
+			}
+		}
+		// Variables that are assigned to are only valid as a base until the next assignment,
+		// which the analysis tracks, but not as part of the value of other variables.
+		if (_nested && !value)
+			return nullopt;
+		return Location{identifier->name, 0};
+	}
+
+	EVMDialect const& m_dialect;
+	map<YulString, SideEffects> const& m_functionSideEffects;
+	/// Functions that may end the execution without reverting.
+	set<YulString> const& m_haltingFunctions;
+	map<YulString, Expression const*> const& m_ssaValues;
+	bool m_analyseMemory = false;
+	set<Statement const*>& m_redundantStores;
+};
+
+/// Collects all function definitions, including nested ones.
+class FunctionCollector: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _function) override
+	{
+		functions.emplace_back(&_function);
+		ASTWalker::operator()(_function);
+	}
+
+	vector<FunctionDefinition const*> functions;
+};
+
+/// Removes the given statements.
+class StatementRemover: public ASTModifier
+{
+public:
+	explicit StatementRemover(set<Statement const*> const& _statements): m_statements(_statements) {}
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override
+	{
+		iterateReplacing(_block.statements, [&](Statement& _statement) -> optional<vector<Statement>> {
+			if (m_statements.count(&_statement))
+				return vector<Statement>{};
+			return nullopt;
+		});
+		ASTModifier::operator()(_block);
+	}
+
+private:
+	set<Statement const*> const& m_statements;
+};
+
+/// @returns the functions that may end the execution without reverting.
+set<YulString> haltingFunctions(EVMDialect const& _dialect, CallGraph const& _callGraph)
+{
+	set<YulString> result;
+	for (auto const& [function, callees]: _callGraph.functionCalls)
+		for (YulString callee: callees)
+			if (BuiltinFunctionForEVM const* builtin = _dialect.builtin(callee))
+				if (
+					builtin->instruction == evmasm::Instruction::RETURN ||
+					builtin->instruction == evmasm::Instruction::STOP ||
+					builtin->instruction == evmasm::Instruction::SELFDESTRUCT
+				)
+					result.insert(function);
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto const& [function, callees]: _callGraph.functionCalls)
+			if (!result.count(function) && !(callees - (callees - result)).empty())
+			{
+				result.insert(function);
+				changed = true;
+			}
+	}
+	return result;
+}
+
+}
+
+void RedundantStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	auto const* dialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
+	if (!dialect)
+		return;
+
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
+	map<YulString, SideEffects> functionSideEffects =
+		_context.functionSideEffects ?
+		*_context.functionSideEffects :
+		SideEffectsPropagator::sideEffects(*dialect, callGraph);
+	set<YulString> halting = haltingFunctions(*dialect, callGraph);
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+
+	set<Statement const*> redundantStores;
+	RedundantStoreFinder finder{
+		*dialect,
+		functionSideEffects,
+		halting,
+		ssaValues.values(),
+		!MSizeFinder::containsMSize(*dialect, _ast),
+		redundantStores
+	};
+	finder.run(ControlFlowGraph::build(*dialect, _ast), false);
+	FunctionCollector functions;
+	functions(_ast);
+	for (FunctionDefinition const* function: functions.functions)
+		finder.run(ControlFlowGraph::build(*dialect, *function), true);
+
+	if (!redundantStores.empty())
+		StatementRemover{redundantStores}(_ast);
+}
@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that removes stores to storage and memory that are overwritten before they are read.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/OptimiserStep.h>
+
+namespace solidity::yul
+{
+
+/**
+ * RedundantStoreEliminator: Optimiser step that removes ``sstore`` and ``mstore`` statements
+ * whose stored value is never read because, on every path through the control-flow graph,
+ * the same location is written to again or the store is discarded before anything may read it:
+ *
+ *   sstore(0, x)
+ *   mstore(0x40, a)
+ *   mstore(0x40, b)
+ *   sstore(0, y)
+ *
+ * is turned into
+ *
+ *   mstore(0x40, b)
+ *   sstore(0, y)
+ *
+ * Locations are compared as a variable (or zero) plus a constant offset, following the values of
+ * variables that are never reassigned, so that two locations are only known to be equal or
+ * different if they are based on the same variable. Any read of an unknown location, any call
+ * of a function that may read storage or memory and any call that may end the execution without
+ * reverting keeps the stores before it.
+ *
+ * The analysis runs backwards over the control-flow graph of each function and of the code
+ * outside of functions. At the end of a function both storage and memory may be read by the
+ * caller. Storage written before a ``revert`` is discarded, and so is memory that is not returned
+ * at the end of the code outside of functions.
+ *
+ * Only stores whose arguments are variables or literals are removed, so the ExpressionSplitter
+ * and the CommonSubexpressionEliminator are recommended to run first. Memory stores are kept
+ * if the code uses ``msize``.
+ *
+ * It only has an effect on the EVM dialect.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+struct RedundantStoreEliminator
+{
+	static constexpr char const* name{"RedundantStoreEliminator"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+};
+
+}
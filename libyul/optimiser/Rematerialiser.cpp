@@ -32,9 +32,14 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
-void Rematerialiser::run(Dialect const& _dialect, Block& _ast, set<YulString> _varsToAlwaysRematerialize)
+void Rematerialiser::run(
+	Dialect const& _dialect,
+	Block& _ast,
+	set<YulString> _varsToAlwaysRematerialize,
+	GasMeter const* _meter
+)
 {
-	Rematerialiser{_dialect, _ast, std::move(_varsToAlwaysRematerialize)}(_ast);
+	Rematerialiser{_dialect, _ast, std::move(_varsToAlwaysRematerialize), _meter}(_ast);
 }
 
 void Rematerialiser::run(
@@ -49,11 +54,13 @@ void Rematerialiser::run(
 Rematerialiser::Rematerialiser(
 	Dialect const& _dialect,
 	Block& _ast,
-	set<YulString> _varsToAlwaysRematerialize
+	set<YulString> _varsToAlwaysRematerialize,
+	GasMeter const* _meter
 ):
 	DataFlowAnalyzer(_dialect),
 	m_referenceCounts(ReferencesCounter::countReferences(_ast)),
-	m_varsToAlwaysRematerialize(std::move(_varsToAlwaysRematerialize))
+	m_varsToAlwaysRematerialize(std::move(_varsToAlwaysRematerialize)),
+	m_meter(_meter)
 {
 }
 
@@ -83,7 +90,11 @@ void Rematerialiser::visit(Expression& _e)
 			if (
 				(refs <= 1 && value.loopDepth == m_loopDepth) ||
 				cost == 0 ||
-				(refs <= 5 && cost <= 1 && m_loopDepth == 0) ||
+				(
+					refs <= 5 &&
+					m_loopDepth == 0 &&
+					DuplicationCost::cheapToDuplicate(m_dialect, m_meter, *value.value, refs, 1)
+				) ||
 				m_varsToAlwaysRematerialize.count(name)
 			)
 			{
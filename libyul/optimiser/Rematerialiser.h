@@ -36,6 +36,10 @@ namespace solidity::yul
  *  - the variable is referenced at most 5 times and the value is rather cheap
  *    ("cost" of at most 1 like a constant up to 0xff) and we are not in a loop
  *
+ * If the step context provides a gas meter, "rather cheap" is instead decided by
+ * comparing the gas costs of re-evaluating the value at every reference against
+ * the costs of keeping it on the stack (see DuplicationCost).
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class Rematerialiser: public DataFlowAnalyzer
@@ -45,12 +49,13 @@ public:
 	static void run(
 		OptimiserStepContext& _context,
 		Block& _ast
-	) { run(_context.dialect, _ast); }
+	) { run(_context.dialect, _ast, {}, _context.gasMeter); }
 
 	static void run(
 		Dialect const& _dialect,
 		Block& _ast,
-		std::set<YulString> _varsToAlwaysRematerialize = {}
+		std::set<YulString> _varsToAlwaysRematerialize = {},
+		GasMeter const* _meter = nullptr
 	);
 	static void run(
 		Dialect const& _dialect,
@@ -62,7 +67,8 @@ protected:
 	Rematerialiser(
 		Dialect const& _dialect,
 		Block& _ast,
-		std::set<YulString> _varsToAlwaysRematerialize = {}
+		std::set<YulString> _varsToAlwaysRematerialize = {},
+		GasMeter const* _meter = nullptr
 	);
 	Rematerialiser(
 		Dialect const& _dialect,
@@ -77,6 +83,7 @@ protected:
 
 	std::map<YulString, size_t> m_referenceCounts;
 	std::set<YulString> m_varsToAlwaysRematerialize;
+	GasMeter const* m_meter = nullptr;
 };
 
 /**
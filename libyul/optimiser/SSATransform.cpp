@@ -38,6 +38,49 @@ using namespace solidity::langutil;
 namespace
 {
 
+/// Variables assigned to in the body and post block of each for loop, identified by the
+/// loop condition. Unlike the loop itself, the condition is not moved when the statements
+/// of the surrounding block are replaced.
+using ForLoopAssignments = map<Expression const*, set<YulString>>;
+
+/**
+ * Determines the variables assigned to inside each for loop in a single walk,
+ * so that the bodies of nested loops do not have to be walked once per loop.
+ */
+class ForLoopAssignmentCollector: public ASTWalker
+{
+public:
+	static ForLoopAssignments run(Block const& _ast)
+	{
+		ForLoopAssignmentCollector collector;
+		collector(_ast);
+		return std::move(collector.m_assignments);
+	}
+
+	using ASTWalker::operator();
+	void operator()(ForLoop const& _for) override
+	{
+		yulAssert(_for.pre.statements.empty(), "For loop init rewriter not run.");
+		m_assignments[_for.condition.get()];
+		m_currentLoops.emplace_back(_for.condition.get());
+		(*this)(_for.body);
+		(*this)(_for.post);
+		m_currentLoops.pop_back();
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		for (Expression const* loop: m_currentLoops)
+			for (auto const& variable: _assignment.variableNames)
+				m_assignments[loop].insert(variable.name);
+	}
+
+private:
+	ForLoopAssignmentCollector() = default;
+
+	ForLoopAssignments m_assignments;
+	vector<Expression const*> m_currentLoops;
+};
+
 /**
  * First step of SSA transform: Introduces new SSA variables for each assignment or
  * declaration of a variable to be replaced.
@@ -151,10 +194,12 @@ public:
 	explicit IntroduceControlFlowSSA(
 		NameDispenser& _nameDispenser,
 		set<YulString> const& _variablesToReplace,
+		ForLoopAssignments const& _forLoopAssignments,
 		TypeInfo const& _typeInfo
 	):
 		m_nameDispenser(_nameDispenser),
 		m_variablesToReplace(_variablesToReplace),
+		m_forLoopAssignments(_forLoopAssignments),
 		m_typeInfo(_typeInfo)
 	{ }
 
@@ -166,6 +211,7 @@ public:
 private:
 	NameDispenser& m_nameDispenser;
 	set<YulString> const& m_variablesToReplace;
+	ForLoopAssignments const& m_forLoopAssignments;
 	/// Variables (that are to be replaced) currently in scope.
 	set<YulString> m_variablesInScope;
 	/// Set of variables that do not have a specific value.
@@ -197,12 +243,7 @@ void IntroduceControlFlowSSA::operator()(ForLoop& _for)
 {
 	yulAssert(_for.pre.statements.empty(), "For loop init rewriter not run.");
 
-	Assignments assignments;
-	assignments(_for.body);
-	assignments(_for.post);
-
-
-	for (auto const& var: assignments.names())
+	for (auto const& var: m_forLoopAssignments.at(_for.condition.get()))
 		if (m_variablesInScope.count(var))
 			m_variablesToReassign.insert(var);
 
@@ -287,8 +328,9 @@ void IntroduceControlFlowSSA::operator()(Block& _block)
 class PropagateValues: public ASTModifier
 {
 public:
-	explicit PropagateValues(set<YulString> const& _variablesToReplace):
-		m_variablesToReplace(_variablesToReplace)
+	PropagateValues(set<YulString> const& _variablesToReplace, ForLoopAssignments const& _forLoopAssignments):
+		m_variablesToReplace(_variablesToReplace),
+		m_forLoopAssignments(_forLoopAssignments)
 	{ }
 
 	void operator()(Identifier& _identifier) override;
@@ -301,6 +343,7 @@ private:
 	/// This is a set of all variables that are assigned to anywhere in the code.
 	/// Variables that are only declared but never re-assigned are not touched.
 	set<YulString> const& m_variablesToReplace;
+	ForLoopAssignments const& m_forLoopAssignments;
 	map<YulString, YulString> m_currentVariableValues;
 	set<YulString> m_clearAtEndOfBlock;
 };
@@ -360,11 +403,7 @@ void PropagateValues::operator()(ForLoop& _for)
 {
 	yulAssert(_for.pre.statements.empty(), "For loop init rewriter not run.");
 
-	Assignments assignments;
-	assignments(_for.body);
-	assignments(_for.post);
-
-	for (auto const& var: assignments.names())
+	for (auto const& var: m_forLoopAssignments.at(_for.condition.get()))
 		m_currentVariableValues.erase(var);
 
 	visit(*_for.condition);
@@ -392,9 +431,11 @@ void SSATransform::run(OptimiserStepContext& _context, Block& _ast)
 	TypeInfo typeInfo(_context.dialect, _ast);
 	Assignments assignments;
 	assignments(_ast);
+	// The first two steps do not change which variables are assigned to inside loops.
+	ForLoopAssignments forLoopAssignments = ForLoopAssignmentCollector::run(_ast);
 	IntroduceSSA{_context.dispenser, assignments.names(), typeInfo}(_ast);
-	IntroduceControlFlowSSA{_context.dispenser, assignments.names(), typeInfo}(_ast);
-	PropagateValues{assignments.names()}(_ast);
+	IntroduceControlFlowSSA{_context.dispenser, assignments.names(), forLoopAssignments, typeInfo}(_ast);
+	PropagateValues{assignments.names(), forLoopAssignments}(_ast);
 }
 
 
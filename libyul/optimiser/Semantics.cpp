@@ -121,29 +121,64 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 		ret[function].cannotLoop = false;
 	}
 
-	for (auto const& call: _directCallGraph.functionCalls)
-	{
-		YulString funName = call.first;
-		SideEffects sideEffects;
-		auto _visit = [&, visited = std::set<YulString>{}](YulString _function, auto&& _recurse) mutable {
-			if (!visited.insert(_function).second)
-				return;
-			if (sideEffects == SideEffects::worst())
-				return;
-			if (BuiltinFunction const* f = _dialect.builtin(_function))
+	// The side effects of a function are the combined side effects of everything reachable
+	// from it in the call graph. Strongly connected components are completed in reverse
+	// topological order (Tarjan's algorithm), so the side effects of all callees outside
+	// the component are known when it is completed and every call is only considered once.
+	map<YulString, size_t> index;
+	map<YulString, size_t> lowLink;
+	map<YulString, SideEffects> componentSideEffects;
+	vector<YulString> stack;
+	set<YulString> onStack;
+	set<YulString> completed;
+	auto visit = [&](YulString _function, auto&& _recurse) -> void {
+		size_t functionIndex = index.size();
+		index[_function] = functionIndex;
+		lowLink[_function] = functionIndex;
+		stack.emplace_back(_function);
+		onStack.insert(_function);
+
+		SideEffects& sideEffects = componentSideEffects[_function];
+		if (SideEffects const* ownSideEffects = util::valueOrNullptr(ret, _function))
+			sideEffects += *ownSideEffects;
+		for (YulString callee: _directCallGraph.functionCalls.at(_function))
+			if (BuiltinFunction const* f = _dialect.builtin(callee))
 				sideEffects += f->sideEffects;
-			else
+			else if (!index.count(callee))
 			{
-				if (ret.count(_function))
-					sideEffects += ret[_function];
-				for (YulString callee: _directCallGraph.functionCalls.at(_function))
-					_recurse(callee, _recurse);
+				_recurse(callee, _recurse);
+				if (completed.count(callee))
+					sideEffects += componentSideEffects.at(callee);
+				else
+					lowLink[_function] = min(lowLink[_function], lowLink[callee]);
 			}
-		};
-		for (auto const& _v: call.second)
-			_visit(_v, _visit);
-		ret[funName] += sideEffects;
-	}
+			else if (onStack.count(callee))
+				lowLink[_function] = min(lowLink[_function], index[callee]);
+			else
+				sideEffects += componentSideEffects.at(callee);
+
+		if (lowLink[_function] != functionIndex)
+			return;
+
+		// _function is the root of a component, combine the side effects of its members.
+		auto rootPosition = find(stack.rbegin(), stack.rend(), _function).base() - 1;
+		SideEffects combined;
+		for (auto it = rootPosition; it != stack.end(); ++it)
+			combined += componentSideEffects.at(*it);
+		for (auto it = rootPosition; it != stack.end(); ++it)
+		{
+			componentSideEffects[*it] = combined;
+			onStack.erase(*it);
+			completed.insert(*it);
+		}
+		stack.erase(rootPosition, stack.end());
+	};
+	for (auto const& call: _directCallGraph.functionCalls)
+		if (!index.count(call.first))
+			visit(call.first, visit);
+
+	for (auto const& call: _directCallGraph.functionCalls)
+		ret[call.first] += componentSideEffects.at(call.first);
 	return ret;
 }
 
@@ -31,12 +31,22 @@
 
 #include <libevmasm/RuleList.h>
 
+#include <libsolutil/StringUtils.h>
+
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 using namespace solidity::langutil;
 using namespace solidity::yul;
 
+namespace
+{
+/// Match groups of the rule currently matched by this thread.
+thread_local map<unsigned, Expression const*> t_matchGroups;
+}
+
 SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	Expression const& _expr,
 	Dialect const& _dialect,
@@ -47,21 +57,47 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
-
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
 		version = evmDialect->evmVersion();
 
-	if (!evmRules[version])
-		evmRules[version] = std::make_unique<SimplificationRules>(version);
-
-	SimplificationRules& rules = *evmRules[version];
+	SimplificationRules const& rules = forVersion(version);
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	auto const& candidates = rules.m_rules[uint8_t(instruction->first)];
+	if (candidates.empty())
+		return nullptr;
+
+	// Resolve the arguments once, so that rules can be discarded by looking at the
+	// top-level argument patterns before the full recursive match is attempted.
+	vector<ArgumentShape> shapes;
+	shapes.reserve(instruction->second->size());
+	for (Expression const& argument: *instruction->second)
+	{
+		// Pattern::matches rejects direct function calls as arguments.
+		if (holds_alternative<FunctionCall>(argument))
+			return nullptr;
+		Expression const* resolved = &argument;
+		if (holds_alternative<Identifier>(argument))
+			if (AssignedValue const* value = util::valueOrNullptr(_ssaValues, std::get<Identifier>(argument).name))
+				if (value->value)
+					resolved = value->value;
+		ArgumentShape& shape = shapes.emplace_back();
+		if (holds_alternative<Literal>(*resolved))
+		{
+			Literal const& literal = std::get<Literal>(*resolved);
+			if (literal.kind == LiteralKind::Number)
+				shape.constant = u256(literal.value.str());
+		}
+		else if (auto argumentInstruction = instructionAndArguments(_dialect, *resolved))
+			shape.instruction = argumentInstruction->first;
+	}
+
+	for (auto const& rule: candidates)
 	{
-		rules.resetMatchGroups();
+		if (!argumentsCanMatch(rule.pattern, shapes))
+			continue;
+		resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
 				return &rule;
@@ -69,6 +105,53 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	return nullptr;
 }
 
+bool SimplificationRules::argumentsCanMatch(Pattern const& _pattern, vector<ArgumentShape> const& _shapes)
+{
+	vector<Pattern> const& arguments = _pattern.argumentPatterns();
+	assertThrow(arguments.size() == _shapes.size(), OptimizerException, "");
+	for (size_t i = 0; i < arguments.size(); ++i)
+		switch (arguments[i].kind())
+		{
+		case PatternKind::Operation:
+			if (_shapes[i].instruction != arguments[i].instruction())
+				return false;
+			break;
+		case PatternKind::Constant:
+			if (!_shapes[i].constant)
+				return false;
+			if (u256 const* value = arguments[i].constantValue())
+				if (*value != *_shapes[i].constant)
+					return false;
+			break;
+		case PatternKind::Any:
+			break;
+		}
+	return true;
+}
+
+SimplificationRules const& SimplificationRules::forVersion(std::optional<EVMVersion> _evmVersion)
+{
+	// Look up the rules in a per-thread cache first, so that the lock is only taken
+	// the first time a thread needs the rules for a version.
+	static thread_local std::map<std::optional<EVMVersion>, SimplificationRules const*> t_rules;
+	if (SimplificationRules const* const* rules = util::valueOrNullptr(t_rules, _evmVersion))
+		return **rules;
+
+	static std::mutex mutex;
+	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules const>> evmRules;
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& rules = evmRules[_evmVersion];
+	if (!rules)
+		rules = std::make_unique<SimplificationRules const>(_evmVersion);
+	t_rules[_evmVersion] = rules.get();
+	return *rules;
+}
+
+void SimplificationRules::resetMatchGroups()
+{
+	t_matchGroups.clear();
+}
+
 bool SimplificationRules::isInitialized() const
 {
 	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
@@ -109,13 +192,13 @@ SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _ev
 	Pattern X;
 	Pattern Y;
 	Pattern Z;
-	A.setMatchGroup(1, m_matchGroups);
-	B.setMatchGroup(2, m_matchGroups);
-	C.setMatchGroup(3, m_matchGroups);
-	W.setMatchGroup(4, m_matchGroups);
-	X.setMatchGroup(5, m_matchGroups);
-	Y.setMatchGroup(6, m_matchGroups);
-	Z.setMatchGroup(7, m_matchGroups);
+	A.setMatchGroup(1);
+	B.setMatchGroup(2);
+	C.setMatchGroup(3);
+	W.setMatchGroup(4);
+	X.setMatchGroup(5);
+	Y.setMatchGroup(6);
+	Z.setMatchGroup(7);
 
 	addRules(simplificationRuleList(_evmVersion, A, B, C, W, X, Y, Z));
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
@@ -134,6 +217,12 @@ void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _
 	m_matchGroups = &_matchGroups;
 }
 
+void Pattern::setMatchGroup(unsigned _group)
+{
+	m_matchGroup = _group;
+	m_matchGroups = nullptr;
+}
+
 bool Pattern::matches(
 	Expression const& _expr,
 	Dialect const& _dialect,
@@ -202,10 +291,10 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		if (matchGroups().count(m_matchGroup))
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
-			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
+			Expression const* firstMatch = matchGroups()[m_matchGroup];
 			assertThrow(firstMatch, OptimizerException, "Match set but to null.");
 			assertThrow(
 				!holds_alternative<FunctionCall>(_expr) &&
@@ -217,12 +306,12 @@ bool Pattern::matches(
 			return SyntacticallyEqual{}(*firstMatch, _expr);
 		}
 		else if (m_kind == PatternKind::Any)
-			(*m_matchGroups)[m_matchGroup] = &_expr;
+			matchGroups()[m_matchGroup] = &_expr;
 		else
 		{
 			assertThrow(m_kind == PatternKind::Constant, OptimizerException, "Match group set for operation.");
 			// We do not use _expr here, because we want the actual number.
-			(*m_matchGroups)[m_matchGroup] = expr;
+			matchGroups()[m_matchGroup] = expr;
 		}
 	}
 	return true;
@@ -234,6 +323,41 @@ evmasm::Instruction Pattern::instruction() const
 	return m_instruction;
 }
 
+string Pattern::toString() const
+{
+	// Match groups are named in the order of their first occurrence: constants A, B, C and
+	// other expressions X, Y, Z, which mostly agrees with the way the rule list names them.
+	map<unsigned, string> groupNames;
+	size_t constants = 0;
+	size_t expressions = 0;
+	function<string(Pattern const&)> format = [&](Pattern const& _pattern) -> string
+	{
+		if (_pattern.m_kind == PatternKind::Operation)
+		{
+			string name = instructionInfo(_pattern.m_instruction).name;
+			transform(begin(name), end(name), begin(name), [](auto _c) { return tolower(_c); });
+			vector<string> arguments;
+			for (auto const& argument: _pattern.m_arguments)
+				arguments.emplace_back(format(argument));
+			return name + "(" + util::joinHumanReadable(arguments) + ")";
+		}
+		if (_pattern.m_kind == PatternKind::Constant && _pattern.m_data)
+			return util::formatNumber(*_pattern.m_data);
+		if (!_pattern.m_matchGroup)
+			return "_";
+		string& groupName = groupNames[_pattern.m_matchGroup];
+		if (groupName.empty())
+		{
+			size_t& index = _pattern.m_kind == PatternKind::Constant ? constants : expressions;
+			char first = _pattern.m_kind == PatternKind::Constant ? 'A' : 'X';
+			groupName = index < 3 ? string(1, char(first + index)) : string(1, first) + to_string(index);
+			++index;
+		}
+		return groupName;
+	};
+	return format(*this);
+}
+
 Expression Pattern::toExpression(SourceLocation const& _location) const
 {
 	if (matchGroup())
@@ -269,7 +393,11 @@ u256 Pattern::d() const
 Expression const& Pattern::matchGroupValue() const
 {
 	assertThrow(m_matchGroup > 0, OptimizerException, "");
-	assertThrow(!!m_matchGroups, OptimizerException, "");
-	assertThrow((*m_matchGroups)[m_matchGroup], OptimizerException, "");
-	return *(*m_matchGroups)[m_matchGroup];
+	assertThrow(matchGroups()[m_matchGroup], OptimizerException, "");
+	return *matchGroups()[m_matchGroup];
+}
+
+map<unsigned, Expression const*>& Pattern::matchGroups() const
+{
+	return m_matchGroups ? *m_matchGroups : t_matchGroups;
 }
@@ -43,8 +43,17 @@ struct Dialect;
 struct AssignedValue;
 class Pattern;
 
+enum class PatternKind
+{
+	Operation,
+	Constant,
+	Any
+};
+
 /**
  * Container for all simplification rules.
+ * The rules are immutable after construction, the state of the current match is
+ * stored per thread, so one instance per EVM version is shared between threads.
  */
 class SimplificationRules: public boost::noncopyable
 {
@@ -70,20 +79,27 @@ public:
 	instructionAndArguments(Dialect const& _dialect, Expression const& _expr);
 
 private:
+	/// Properties of an argument of the expression to be matched, after resolving
+	/// a variable to its value. Computed once per expression instead of once per rule.
+	struct ArgumentShape
+	{
+		std::optional<evmasm::Instruction> instruction;
+		std::optional<u256> constant;
+	};
+
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	/// @returns false if the top-level arguments of @a _pattern cannot match arguments
+	/// of the given shapes.
+	static bool argumentsCanMatch(Pattern const& _pattern, std::vector<ArgumentShape> const& _shapes);
 
-	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
-};
+	/// @returns the rules for the given EVM version, creating them on first use.
+	static SimplificationRules const& forVersion(std::optional<langutil::EVMVersion> _evmVersion);
 
-enum class PatternKind
-{
-	Operation,
-	Constant,
-	Any
+	static void resetMatchGroups();
+
+	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
 };
 
 /**
@@ -112,6 +128,9 @@ public:
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
 	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	/// Sets this pattern to be part of the match group with the identifier @a _group
+	/// of the rule currently matched by this thread in SimplificationRules::findFirstMatch.
+	void setMatchGroup(unsigned _group);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(
 		Expression const& _expr,
@@ -120,24 +139,33 @@ public:
 	) const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
+	std::vector<Pattern> const& argumentPatterns() const { return m_arguments; }
+	PatternKind kind() const { return m_kind; }
+	/// @returns the required value of a constant pattern or nullptr if any constant matches.
+	u256 const* constantValue() const { return m_data.get(); }
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	u256 d() const;
 
 	evmasm::Instruction instruction() const;
 
+	/// @returns a human-readable representation of the pattern like ``add(X, 0)``.
+	std::string toString() const;
+
 	/// Turns this pattern into an actual expression. Should only be called
 	/// for patterns resulting from an action, i.e. with match groups assigned.
 	Expression toExpression(langutil::SourceLocation const& _location) const;
 
 private:
 	Expression const& matchGroupValue() const;
+	std::map<unsigned, Expression const*>& matchGroups() const;
 
 	PatternKind m_kind = PatternKind::Any;
 	evmasm::Instruction m_instruction; ///< Only valid if m_kind is Operation
 	std::shared_ptr<u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
+	/// Match groups to use, or nullptr for those of the rule currently matched by this thread.
 	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
 };
 
@@ -32,6 +32,8 @@
 
 #include <libyul/AST.h>
 
+#include <libsolutil/Profiler.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -166,12 +168,25 @@ bool StackCompressor::run(
 		"Need to run the function grouper before the stack compressor."
 	);
 	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
+	// Functions are compiled independently, so only the functions changed in the
+	// previous iteration have to be checked again.
+	optional<set<YulString>> changedFunctions;
 	for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 	{
-		map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
+		util::TraceScope iterationScope{"StackCompressor iteration", to_string(iterations)};
+		map<YulString, int> stackSurplus = CompilabilityChecker(
+			_dialect,
+			_object,
+			_optimizeStackAllocation,
+			changedFunctions
+		).stackDeficit;
 		if (stackSurplus.empty())
 			return true;
 
+		changedFunctions = set<YulString>{};
+		for (auto const& surplus: stackSurplus)
+			changedFunctions->insert(surplus.first);
+
 		if (stackSurplus.count(YulString{}))
 		{
 			yulAssert(stackSurplus.at({}) > 0, "Invalid surplus value.");
@@ -16,8 +16,11 @@
 */
 
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/ControlFlowGraph.h>
 #include <libyul/optimiser/FunctionCallFinder.h>
+#include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <libyul/optimiser/StackToMemoryMover.h>
 #include <libyul/backends/evm/EVMDialect.h>
@@ -28,6 +31,9 @@
 #include <libyul/Utilities.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <boost/range/adaptor/reversed.hpp>
 
 using namespace std;
 using namespace solidity;
@@ -35,6 +41,121 @@ using namespace solidity::yul;
 
 namespace
 {
+/**
+ * Assigns slots, counted from the first slot of the code, to the given variables of the
+ * code represented by @a _graph. Two variables share a slot if neither of them is assigned
+ * to while the other one is live, so that their values are never needed at the same time.
+ * Slots are assigned greedily in the order of the variables.
+ * @returns the slots of the variables and the number of slots used.
+ */
+pair<map<YulString, uint64_t>, uint64_t> assignSlotsByLiveness(
+	ControlFlowGraph const& _graph,
+	set<YulString> const& _variables
+)
+{
+	using BasicBlock = ControlFlowGraph::BasicBlock;
+
+	auto addUses = [&](Expression const& _expression, set<YulString>& _live)
+	{
+		for (auto const& reference: ReferencesCounter::countReferences(_expression, ReferencesCounter::OnlyVariables))
+			if (_variables.count(reference.first))
+				_live.insert(reference.first);
+	};
+
+	map<YulString, set<YulString>> interference;
+	// Walks the block backwards from the variables live at its end and returns the
+	// variables live at its start. If @a _recordInterference is set, every assigned
+	// variable is recorded to interfere with the variables live after the assignment
+	// and with the variables assigned together with it.
+	auto liveAtStart = [&](BasicBlock const& _block, set<YulString> _live, bool _recordInterference)
+	{
+		if (_block.condition)
+			addUses(*_block.condition, _live);
+		for (Statement const* statement: _block.statements | boost::adaptors::reversed)
+		{
+			vector<YulString> assigned;
+			Expression const* value = nullptr;
+			std::visit(util::GenericVisitor{
+				[&](ExpressionStatement const& _statement) { value = &_statement.expression; },
+				[&](Assignment const& _assignment) {
+					for (auto const& variable: _assignment.variableNames)
+						if (_variables.count(variable.name))
+							assigned.emplace_back(variable.name);
+					value = _assignment.value.get();
+				},
+				[&](VariableDeclaration const& _varDecl) {
+					for (auto const& variable: _varDecl.variables)
+						if (_variables.count(variable.name))
+							assigned.emplace_back(variable.name);
+					value = _varDecl.value.get();
+				},
+				[&](auto const&) { yulAssert(false, "Unexpected statement in basic block."); }
+			}, *statement);
+
+			if (_recordInterference)
+				for (YulString variable: assigned)
+				{
+					for (YulString other: _live)
+						if (other != variable)
+						{
+							interference[variable].insert(other);
+							interference[other].insert(variable);
+						}
+					for (YulString other: assigned)
+						if (other != variable)
+							interference[variable].insert(other);
+				}
+			for (YulString variable: assigned)
+				_live.erase(variable);
+			if (value)
+				addUses(*value, _live);
+		}
+		return _live;
+	};
+
+	vector<BasicBlock> const& blocks = _graph.blocks();
+	vector<set<YulString>> liveIn(blocks.size());
+	auto liveAtEnd = [&](BasicBlock const& _block)
+	{
+		set<YulString> live;
+		for (ControlFlowGraph::BlockId successor: _block.successors)
+			live += liveIn[successor];
+		return live;
+	};
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		// Blocks are mostly created before their successors, so visit them backwards.
+		for (size_t i = blocks.size(); i-- > 0;)
+		{
+			set<YulString> live = liveAtStart(blocks[i], liveAtEnd(blocks[i]), false);
+			if (live != liveIn[i])
+			{
+				liveIn[i] = std::move(live);
+				changed = true;
+			}
+		}
+	}
+	for (BasicBlock const& block: blocks)
+		liveAtStart(block, liveAtEnd(block), true);
+
+	map<YulString, uint64_t> slots;
+	uint64_t numSlots = 0;
+	for (YulString variable: _variables)
+	{
+		set<uint64_t> usedSlots;
+		for (YulString other: interference[variable])
+			if (slots.count(other))
+				usedSlots.insert(slots.at(other));
+		uint64_t slot = 0;
+		while (usedSlots.count(slot))
+			++slot;
+		slots[variable] = slot;
+		numSlots = std::max(numSlots, slot + 1);
+	}
+	return {std::move(slots), numSlots};
+}
+
 /**
  * Walks the call graph using a Depth-First-Search assigning memory slots to variables.
  * - The leaves of the call graph will get the lowest slot, increasing towards the root.
@@ -45,7 +166,8 @@ namespace
  * - Determine the maximum value ``n`` of the values of ``slotsRequiredForFunction`` among the children.
  * - If the function itself contains variables that need memory slots, but is contained in a cycle,
  *   abort the process as failure.
- * - If not, assign each variable its slot starting from ``n`` (incrementing it).
+ * - If not, assign the variables slots starting from ``n``, such that variables whose values
+ *   are never needed at the same time share a slot, and increase ``n`` by the number of slots used.
  * - Assign ``n`` to ``slotsRequiredForFunction`` of the function.
  */
 struct MemoryOffsetAllocator
@@ -66,18 +188,32 @@ struct MemoryOffsetAllocator
 		if (unreachableVariables.count(_function))
 		{
 			yulAssert(!slotAllocations.count(_function), "");
+			set<YulString> variables;
 			for (YulString variable: unreachableVariables.at(_function))
 				if (variable.empty())
 				{
 					// TODO: Too many function arguments or return parameters.
 				}
 				else
-					slotAllocations[variable] = requiredSlots++;
+					variables.insert(variable);
+
+			auto [slots, numSlots] = assignSlotsByLiveness(
+				_function.empty() ?
+				ControlFlowGraph::build(dialect, code) :
+				ControlFlowGraph::build(dialect, *functions.at(_function)),
+				variables
+			);
+			for (auto const& [variable, slot]: slots)
+				slotAllocations[variable] = requiredSlots + slot;
+			requiredSlots += numSlots;
 		}
 
 		return slotsRequiredForFunction[_function] = requiredSlots;
 	}
 
+	Dialect const& dialect;
+	Block const& code;
+	map<YulString, FunctionDefinition const*> const& functions;
 	map<YulString, set<YulString>> const& unreachableVariables;
 	map<YulString, set<YulString>> const& callGraph;
 
@@ -85,6 +221,17 @@ struct MemoryOffsetAllocator
 	map<YulString, uint64_t> slotsRequiredForFunction{};
 };
 
+struct FunctionDefinitionCollector: ASTWalker
+{
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _function) override
+	{
+		functions[_function.name] = &_function;
+		ASTWalker::operator()(_function);
+	}
+	map<YulString, FunctionDefinition const*> functions;
+};
+
 u256 literalArgumentValue(FunctionCall const& _call)
 {
 	yulAssert(_call.arguments.size() == 1, "");
@@ -128,7 +275,16 @@ void StackLimitEvader::run(
 		if (_unreachableVariables.count(function))
 			return;
 
-	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls};
+	FunctionDefinitionCollector functionDefinitions;
+	functionDefinitions(*_object.code);
+
+	MemoryOffsetAllocator memoryOffsetAllocator{
+		_context.dialect,
+		*_object.code,
+		functionDefinitions.functions,
+		_unreachableVariables,
+		callGraph.functionCalls
+	};
 	uint64_t requiredSlots = memoryOffsetAllocator.run();
 
 	StackToMemoryMover::run(_context, reservedMemory, memoryOffsetAllocator.slotAllocations, requiredSlots, *_object.code);
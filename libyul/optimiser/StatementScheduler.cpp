@@ -0,0 +1,294 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that reorders the statements of blocks to reduce the number of live variables.
+ */
+
+#include <libyul/optimiser/StatementScheduler.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AST.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <range/v3/view/enumerate.hpp>
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Blocks with more statements are not reordered, since the scheduling is quadratic in their number.
+size_t constexpr maxStatements = 500;
+
+/// Properties of a statement of a block that determine where it can be moved.
+struct StatementInfo
+{
+	/// Variables declared by the statement.
+	set<YulString> declared;
+	/// Variables declared by the statement or assigned to by the statement or by code nested in it.
+	set<YulString> written;
+	/// Variables declared, assigned to or referenced by the statement or by code nested in it.
+	set<YulString> touched;
+	SideEffects sideEffects;
+	/// If true, the statement is a variable declaration that may be moved across other statements,
+	/// as far as their side effects allow.
+	bool movable = false;
+	/// If true, no statement may be moved across this one.
+	bool barrier = false;
+};
+
+bool intersects(set<YulString> const& _a, set<YulString> const& _b)
+{
+	for (YulString name: _a)
+		if (_b.count(name))
+			return true;
+	return false;
+}
+
+/// Reorders the statements of a block, see StatementScheduler.
+class BlockScheduler
+{
+public:
+	BlockScheduler(vector<StatementInfo> _statements, bool _containsMSize):
+		m_statements(move(_statements)),
+		m_containsMSize(_containsMSize)
+	{
+		set<YulString> declared;
+		for (StatementInfo const& statement: m_statements)
+			declared += statement.declared;
+		for (auto&& [index, statement]: m_statements | ranges::views::enumerate)
+			for (YulString name: statement.touched)
+				if (declared.count(name) && !statement.declared.count(name))
+					m_users[name].insert(index);
+	}
+
+	/// @returns the new order of the statements or nullopt if the statements should keep their order.
+	optional<vector<size_t>> schedule() const
+	{
+		size_t const count = m_statements.size();
+		vector<vector<size_t>> successors(count);
+		vector<size_t> pendingPredecessors(count, 0);
+		for (size_t i = 0; i < count; ++i)
+			for (size_t j = i + 1; j < count; ++j)
+				if (mustPrecede(m_statements[i], m_statements[j]))
+				{
+					successors[i].push_back(j);
+					++pendingPredecessors[j];
+				}
+
+		// Index of the first statement that is not movable and has to wait for the statement.
+		vector<size_t> deadline(count, count);
+		for (size_t i = count; i-- > 0;)
+		{
+			if (!m_statements[i].movable)
+				deadline[i] = i;
+			for (size_t successor: successors[i])
+				deadline[i] = min(deadline[i], deadline[successor]);
+		}
+
+		map<YulString, size_t> remainingUsers = initialRemainingUsers();
+		set<size_t> ready;
+		for (size_t i = 0; i < count; ++i)
+			if (pendingPredecessors[i] == 0)
+				ready.insert(i);
+
+		vector<size_t> order;
+		while (!ready.empty())
+		{
+			// Statements that end more live ranges than they start are scheduled as early as possible,
+			// all other statements in the order in which the statements that cannot be moved need them.
+			auto priority = [&](size_t _index) {
+				int indexScore = score(_index, remainingUsers);
+				return make_tuple(indexScore > 0 ? -indexScore : 0, deadline[_index], -indexScore, _index);
+			};
+			size_t best = *min_element(ready.begin(), ready.end(), [&](size_t _a, size_t _b) {
+				return priority(_a) < priority(_b);
+			});
+
+			ready.erase(best);
+			order.push_back(best);
+			markScheduled(best, remainingUsers);
+			for (size_t successor: successors[best])
+				if (--pendingPredecessors[successor] == 0)
+					ready.insert(successor);
+		}
+		yulAssert(order.size() == count, "");
+
+		vector<size_t> originalOrder(count);
+		for (size_t i = 0; i < count; ++i)
+			originalOrder[i] = i;
+		if (maxLiveVariables(order) < maxLiveVariables(originalOrder))
+			return order;
+		return nullopt;
+	}
+
+private:
+	bool mustPrecede(StatementInfo const& _first, StatementInfo const& _second) const
+	{
+		if (_first.barrier || _second.barrier)
+			return true;
+		if (intersects(_first.written, _second.touched) || intersects(_first.touched, _second.written))
+			return true;
+		if (_first.movable && _second.movable)
+			return false;
+		if (_first.movable)
+			return !movableAcross(_first, _second);
+		if (_second.movable)
+			return !movableAcross(_second, _first);
+		return true;
+	}
+
+	bool movableAcross(StatementInfo const& _moved, StatementInfo const& _other) const
+	{
+		SideEffects const& effects = _moved.sideEffects;
+		if (effects.movable)
+			return true;
+		if (effects.otherState == SideEffects::Read && _other.sideEffects.otherState == SideEffects::Write)
+			return false;
+		if (effects.storage == SideEffects::Read && _other.sideEffects.storage == SideEffects::Write)
+			return false;
+		if (effects.memory == SideEffects::Read && (m_containsMSize || _other.sideEffects.memory == SideEffects::Write))
+			return false;
+		return true;
+	}
+
+	map<YulString, size_t> initialRemainingUsers() const
+	{
+		map<YulString, size_t> remainingUsers;
+		for (auto const& [name, users]: m_users)
+			remainingUsers[name] = users.size();
+		return remainingUsers;
+	}
+
+	/// @returns the number of live ranges the statement @a _index ends minus the number
+	/// of live ranges it starts.
+	int score(size_t _index, map<YulString, size_t> const& _remainingUsers) const
+	{
+		int score = 0;
+		for (YulString name: m_statements[_index].declared)
+			if (m_users.count(name))
+				--score;
+		for (YulString name: m_statements[_index].touched)
+			if (m_users.count(name) && m_users.at(name).count(_index) && _remainingUsers.at(name) == 1)
+				++score;
+		return score;
+	}
+
+	void markScheduled(size_t _index, map<YulString, size_t>& _remainingUsers) const
+	{
+		for (YulString name: m_statements[_index].touched)
+			if (m_users.count(name) && m_users.at(name).count(_index))
+				--_remainingUsers.at(name);
+	}
+
+	/// @returns the maximum number of variables declared in the block that are live during
+	/// a statement if the statements are executed in the order @a _order.
+	size_t maxLiveVariables(vector<size_t> const& _order) const
+	{
+		map<YulString, size_t> remainingUsers = initialRemainingUsers();
+		size_t live = 0;
+		size_t maxLive = 0;
+		for (size_t index: _order)
+		{
+			for (YulString name: m_statements[index].declared)
+				if (m_users.count(name))
+					++live;
+			maxLive = max(maxLive, live);
+			for (YulString name: m_statements[index].touched)
+				if (m_users.count(name) && m_users.at(name).count(index) && --remainingUsers.at(name) == 0)
+				{
+					yulAssert(live > 0, "");
+					--live;
+				}
+		}
+		return maxLive;
+	}
+
+	vector<StatementInfo> m_statements;
+	bool m_containsMSize = true;
+	/// Indices of the statements referencing each variable declared in the block, apart from its declaration.
+	map<YulString, set<size_t>> m_users;
+};
+
+}
+
+void StatementScheduler::run(OptimiserStepContext& _context, Block& _ast)
+{
+	StatementScheduler{
+		_context.dialect,
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		MSizeFinder::containsMSize(_context.dialect, _ast)
+	}(_ast);
+}
+
+void StatementScheduler::operator()(Block& _block)
+{
+	ASTModifier::operator()(_block);
+
+	if (_block.statements.size() < 3 || _block.statements.size() > maxStatements)
+		return;
+
+	vector<StatementInfo> statements;
+	for (Statement const& statement: _block.statements)
+	{
+		StatementInfo& info = statements.emplace_back();
+		Assignments assignments;
+		assignments.visit(statement);
+		info.written = assignments.names();
+		ReferencesCounter references{ReferencesCounter::OnlyVariables};
+		references.visit(statement);
+		for (auto const& [name, count]: references.references())
+			info.touched.insert(name);
+		SideEffectsCollector sideEffects{m_dialect, &m_functionSideEffects};
+		sideEffects.visit(statement);
+		info.sideEffects = sideEffects.sideEffects();
+
+		if (auto const* varDecl = get_if<VariableDeclaration>(&statement))
+		{
+			for (TypedName const& variable: varDecl->variables)
+				info.declared.insert(variable.name);
+			info.written += info.declared;
+			info.touched += info.declared;
+			info.movable = varDecl->value && sideEffects.movableRelativeTo(SideEffects{}, m_containsMSize);
+		}
+		else
+			info.barrier =
+				holds_alternative<Break>(statement) ||
+				holds_alternative<Continue>(statement) ||
+				holds_alternative<Leave>(statement);
+	}
+
+	if (optional<vector<size_t>> order = BlockScheduler{move(statements), m_containsMSize}.schedule())
+	{
+		vector<Statement> reordered;
+		reordered.reserve(order->size());
+		for (size_t index: *order)
+			reordered.emplace_back(move(_block.statements[index]));
+		_block.statements = move(reordered);
+	}
+}
@@ -0,0 +1,94 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that reorders the statements of blocks to reduce the number of live variables.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/SideEffects.h>
+
+#include <map>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Optimiser step that reorders the statements of each block so that fewer variables declared
+ * in the block are live at the same time, which reduces the number of stack slots needed
+ * and the number of ``dup`` and ``swap`` instructions:
+ *
+ *   let a := calldataload(0)
+ *   let b := calldataload(0x20)
+ *   sstore(0, a)
+ *   sstore(1, b)
+ *
+ * is turned into
+ *
+ *   let a := calldataload(0)
+ *   sstore(0, a)
+ *   let b := calldataload(0x20)
+ *   sstore(1, b)
+ *
+ * Only variable declarations whose value does not write to any state, cannot loop and, if it
+ * reads state, can be moved across the statements in between are moved. All other statements
+ * keep their relative order, and no statement is moved across a ``break``, ``continue`` or
+ * ``leave`` or across a statement that assigns to or references a variable it references or
+ * declares.
+ *
+ * The statements are scheduled greedily: A statement that ends more live ranges than it starts
+ * is scheduled as soon as possible. Otherwise, the declarations are scheduled just before the first
+ * statement that cannot be moved and depends on them. The new order is only used if it reduces
+ * the maximum number of live variables of the block.
+ *
+ * Works best after the ExpressionSplitter, which creates the variable declarations to move.
+ * Runs best before the code generation, after all steps that may join or rematerialise
+ * expressions.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class StatementScheduler: public ASTModifier
+{
+public:
+	static constexpr char const* name{"StatementScheduler"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	StatementScheduler(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		bool _containsMSize
+	):
+		m_dialect(_dialect),
+		m_functionSideEffects(std::move(_functionSideEffects)),
+		m_containsMSize(_containsMSize)
+	{}
+
+	Dialect const& m_dialect;
+	std::map<YulString, SideEffects> m_functionSideEffects;
+	bool m_containsMSize = true;
+};
+
+}
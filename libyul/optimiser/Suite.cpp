@@ -22,6 +22,7 @@
 #include <libyul/optimiser/Suite.h>
 
 #include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/AllocationEliminator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
@@ -30,8 +31,10 @@
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
+#include <libyul/optimiser/FunctionEvaluator.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/FunctionSpecializer.h>
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/ExpressionJoiner.h>
@@ -41,6 +44,7 @@
 #include <libyul/optimiser/ForLoopConditionOutOfBody.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
+#include <libyul/optimiser/RangeBasedSimplifier.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedFunctionParameterPruner.h>
@@ -52,14 +56,19 @@
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/StatementScheduler.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
+#include <libyul/optimiser/RedundantStoreEliminator.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
+#include <libyul/optimiser/OptimisedFunctionCache.h>
+#include <libyul/optimiser/OptimiserStepProfiler.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -71,24 +80,32 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
 #include <libyul/CompilabilityChecker.h>
 
+#include <numeric>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
-void OptimiserSuite::run(
+bool OptimiserSuite::run(
 	Dialect const& _dialect,
 	GasMeter const* _meter,
 	Object& _object,
 	bool _optimizeStackAllocation,
 	string const& _optimisationSequence,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	size_t _parallelism,
+	bool _useGasCosts,
+	optional<size_t> _reasoningMaxQueries,
+	optional<size_t> _workBudget
 )
 {
+	util::ProfilerScope profilerScope{"Yul optimiser"};
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 	reservedIdentifiers += _dialect.fixedFunctionNames();
 
@@ -99,7 +116,10 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast);
+	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast, _parallelism);
+	if (_useGasCosts)
+		suite.m_context.gasMeter = _meter;
+	suite.m_reasoningState.maxQueries = _reasoningMaxQueries;
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -107,26 +127,37 @@ void OptimiserSuite::run(
 
 	NameSimplifier::run(suite.m_context, ast);
 	// Now the user-supplied part
+	suite.m_remainingBudget = _workBudget;
 	suite.runSequence(_optimisationSequence, ast);
+	// The remaining steps are required or cheap, so they run regardless of the budget.
+	suite.m_remainingBudget.reset();
+	if (suite.m_budgetExhausted)
+		suite.runSequence(BudgetFallbackSequence, ast);
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
 	suite.runSequence("g", ast);
 
-	// We ignore the return value because we will get a much better error
-	// message once we perform code generation.
-	StackCompressor::run(
-		_dialect,
-		_object,
-		_optimizeStackAllocation,
-		stackCompressorMaxIterations
-	);
+	{
+		util::ProfilerScope stepScope{"StackCompressor"};
+		// We ignore the return value because we will get a much better error
+		// message once we perform code generation.
+		StackCompressor::run(
+			_dialect,
+			_object,
+			_optimizeStackAllocation,
+			stackCompressorMaxIterations
+		);
+	}
 	suite.runSequence("fDnTOc g", ast);
 
 	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_dialect))
 	{
 		yulAssert(_meter, "");
-		ConstantOptimiser{*dialect, *_meter}(ast);
+		{
+			util::ProfilerScope stepScope{"ConstantOptimiser"};
+			ConstantOptimiser{*dialect, *_meter}(ast);
+		}
 		if (dialect->providesObjectAccess() && _optimizeStackAllocation)
 			StackLimitEvader::run(suite.m_context, _object, CompilabilityChecker{
 				_dialect,
@@ -147,6 +178,7 @@ void OptimiserSuite::run(
 	VarNameCleaner::run(suite.m_context, ast);
 
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+	return !suite.m_budgetExhausted;
 }
 
 namespace
@@ -171,48 +203,75 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			RedundantAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		AllocationEliminator,
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionEvaluator,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		LoopUnroller,
+		RangeBasedSimplifier,
+		RedundantAssignEliminator,
+		RedundantStoreEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StatementScheduler,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
 }
 
+set<string> const& OptimiserSuite::functionLocalSteps()
+{
+	// Steps that create new names (for example ExpressionSplitter or SSATransform) are not
+	// included, since the names would depend on the order in which the functions are processed.
+	static set<string> const instance{
+		CommonSubexpressionEliminator::name,
+		ConditionalSimplifier::name,
+		ConditionalUnsimplifier::name,
+		DeadCodeEliminator::name,
+		ExpressionSimplifier::name,
+		ForLoopConditionIntoBody::name,
+		ForLoopConditionOutOfBody::name,
+		LiteralRematerialiser::name,
+		RedundantAssignEliminator::name,
+		Rematerialiser::name,
+		SSAReverser::name,
+		StructuralSimplifier::name
+	};
+	return instance;
+}
+
 map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 {
 	static map<string, char> lookupTable{
+		{AllocationEliminator::name,          'A'},
 		{BlockFlattener::name,                'f'},
 		{CircularReferencesPruner::name,      'l'},
 		{CommonSubexpressionEliminator::name, 'c'},
@@ -229,16 +288,22 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{ForLoopConditionOutOfBody::name,     'O'},
 		{ForLoopInitRewriter::name,           'o'},
 		{FullInliner::name,                   'i'},
+		{FunctionEvaluator::name,             'E'},
 		{FunctionGrouper::name,               'g'},
 		{FunctionHoister::name,               'h'},
+		{FunctionSpecializer::name,           'F'},
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{LoopUnroller::name,                  'N'},
+		{RangeBasedSimplifier::name,          'b'},
 		{ReasoningBasedSimplifier::name,      'R'},
 		{RedundantAssignEliminator::name,     'r'},
+		{RedundantStoreEliminator::name,      'S'},
 		{Rematerialiser::name,                'm'},
 		{SSAReverser::name,                   'V'},
 		{SSATransform::name,                  'a'},
+		{StatementScheduler::name,            'P'},
 		{StructuralSimplifier::name,          't'},
 		{UnusedFunctionParameterPruner::name, 'p'},
 		{UnusedPruner::name,                  'u'},
@@ -343,9 +408,14 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
 	for (string const& step: _steps)
 	{
+		if (m_remainingBudget && !spendBudget(CodeSize::codeSizeIncludingFunctions(_ast)))
+			return;
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		{
+			util::ProfilerScope stepScope{step};
+			OptimiserStepProfiler::instance().measure(step, _ast, [&] { runStep(step, _ast); });
+		}
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -361,6 +431,109 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	}
 }
 
+namespace
+{
+
+/// @returns true if @a _ast consists of a block followed by function definitions only,
+/// which is ensured by the FunctionGrouper.
+bool isGrouped(Block const& _ast)
+{
+	return
+		!_ast.statements.empty() &&
+		holds_alternative<Block>(_ast.statements.front()) &&
+		all_of(next(_ast.statements.begin()), _ast.statements.end(), [](Statement const& _statement) {
+			return holds_alternative<FunctionDefinition>(_statement);
+		});
+}
+
+size_t statementCodeSize(Statement const& _statement)
+{
+	if (FunctionDefinition const* function = get_if<FunctionDefinition>(&_statement))
+		return CodeSize::codeSize(function->body);
+	return CodeSize::codeSize(_statement);
+}
+
+}
+
+void OptimiserSuite::runStep(string const& _step, Block& _ast)
+{
+	OptimiserStep const& step = *allSteps().at(_step);
+	if (!m_threadPool || _ast.statements.size() < 2 || !functionLocalSteps().count(_step) || !isGrouped(_ast))
+	{
+		step.run(m_context, _ast);
+		return;
+	}
+
+	vector<size_t> parts(_ast.statements.size());
+	iota(parts.begin(), parts.end(), 0);
+	runStepOnParts(_step, _ast, parts);
+}
+
+void OptimiserSuite::runStepOnParts(string const& _step, Block& _ast, vector<size_t> const& _parts)
+{
+	OptimiserStep const& step = *allSteps().at(_step);
+
+	// The side effects have to be determined from the whole program before it is split up.
+	optional<map<YulString, SideEffects>> functionSideEffects;
+	if (_step == CommonSubexpressionEliminator::name)
+		functionSideEffects = SideEffectsPropagator::sideEffects(m_context.dialect, CallGraphGenerator::callGraph(_ast));
+	OptimiserStepContext context{
+		m_context.dialect,
+		m_context.dispenser,
+		m_context.reservedIdentifiers,
+		functionSideEffects ? &*functionSideEffects : nullptr,
+		m_context.gasMeter
+	};
+
+	// Move the selected statements into blocks of their own and process them
+	// independently. Exceptions are rethrown in the order of the statements.
+	// Since the result only depends on the statement itself, it is looked up in and stored
+	// to the cache of results for identical code.
+	vector<Block> blocks(_parts.size());
+	vector<exception_ptr> failures(_parts.size());
+	for (size_t i = 0; i < _parts.size(); ++i)
+	{
+		blocks[i].location = _ast.location;
+		blocks[i].statements.emplace_back(std::move(_ast.statements.at(_parts[i])));
+		auto task = [&, i] {
+			try
+			{
+				OptimisedFunctionCache& cache = OptimisedFunctionCache::instance();
+				optional<string> key = OptimisedFunctionCache::key(
+					_step,
+					m_context.dialect,
+					blocks[i],
+					context.functionSideEffects
+				);
+				if (key && cache.lookup(*key, blocks[i]))
+					return;
+				langutil::SourceLocation location = locationOf(blocks[i].statements.front());
+				step.run(context, blocks[i]);
+				if (key)
+					cache.store(std::move(*key), location, blocks[i]);
+			}
+			catch (...)
+			{
+				failures[i] = current_exception();
+			}
+		};
+		if (m_threadPool)
+			m_threadPool->post(task);
+		else
+			task();
+	}
+	if (m_threadPool)
+		m_threadPool->wait();
+	for (size_t i = 0; i < _parts.size(); ++i)
+	{
+		yulAssert(blocks[i].statements.size() == 1, "Function-local step " + _step + " changed the code structure.");
+		_ast.statements[_parts[i]] = std::move(blocks[i].statements.front());
+	}
+	for (exception_ptr const& failure: failures)
+		if (failure)
+			rethrow_exception(failure);
+}
+
 void OptimiserSuite::runSequenceUntilStable(
 	std::vector<string> const& _steps,
 	Block& _ast,
@@ -370,14 +543,79 @@ void OptimiserSuite::runSequenceUntilStable(
 	if (_steps.empty())
 		return;
 
+	bool functionLocal = all_of(_steps.begin(), _steps.end(), [](string const& _step) {
+		return functionLocalSteps().count(_step);
+	});
+	if (functionLocal && m_debug != Debug::PrintChanges && isGrouped(_ast))
+	{
+		runFunctionLocalSequenceUntilStable(_steps, _ast, maxRounds);
+		return;
+	}
+
 	size_t codeSize = 0;
-	for (size_t rounds = 0; rounds < maxRounds; ++rounds)
+	for (size_t rounds = 0; rounds < maxRounds && !(m_remainingBudget && m_budgetExhausted); ++rounds)
 	{
 		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
 		if (newSize == codeSize)
 			break;
 		codeSize = newSize;
 
+		util::TraceScope roundScope{"Round", to_string(rounds)};
 		runSequence(_steps, _ast);
 	}
 }
+
+void OptimiserSuite::runFunctionLocalSequenceUntilStable(
+	vector<string> const& _steps,
+	Block& _ast,
+	size_t _maxRounds
+)
+{
+	// Indices into the statements of _ast of the outermost block and the functions that
+	// changed in the previous round. Only those are visited again.
+	vector<size_t> dirty(_ast.statements.size());
+	iota(dirty.begin(), dirty.end(), 0);
+	vector<size_t> codeSizes;
+	for (Statement const& statement: _ast.statements)
+		codeSizes.emplace_back(statementCodeSize(statement));
+
+	for (size_t rounds = 0; rounds < _maxRounds && !dirty.empty(); ++rounds)
+	{
+		util::TraceScope roundScope{"Round", to_string(rounds) + ", " + to_string(dirty.size()) + " parts"};
+		size_t dirtyCodeSize = 0;
+		for (size_t index: dirty)
+			dirtyCodeSize += codeSizes[index];
+		for (string const& step: _steps)
+		{
+			if (!spendBudget(dirtyCodeSize))
+				return;
+			if (m_debug == Debug::PrintStep)
+				cout << "Running " << step << endl;
+			util::ProfilerScope stepScope{step};
+			OptimiserStepProfiler::instance().measure(step, _ast, [&] { runStepOnParts(step, _ast, dirty); });
+		}
+
+		vector<size_t> changed;
+		for (size_t index: dirty)
+		{
+			size_t newSize = statementCodeSize(_ast.statements[index]);
+			if (newSize != codeSizes[index])
+				changed.emplace_back(index);
+			codeSizes[index] = newSize;
+		}
+		dirty = std::move(changed);
+	}
+}
+
+bool OptimiserSuite::spendBudget(size_t _units)
+{
+	if (!m_remainingBudget)
+		return true;
+	if (m_budgetExhausted || _units > *m_remainingBudget)
+	{
+		m_budgetExhausted = true;
+		return false;
+	}
+	*m_remainingBudget -= _units;
+	return true;
+}
@@ -25,8 +25,12 @@
 #include <libyul/YulString.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/ReasoningBasedSimplifier.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/ThreadPool.h>
+
+#include <optional>
 #include <set>
 #include <string>
 #include <memory>
@@ -52,19 +56,32 @@ public:
 	/// Some of them (like whitespace) are ignored, others (like brackets) are a part of the syntax.
 	static constexpr char NonStepAbbreviations[] = " \n[]";
 
+	/// Sequence run instead of the rest of the user-supplied sequence once the work budget is
+	/// exhausted. It only consists of cheap steps that reverse the SSA form and remove leftovers.
+	static constexpr char BudgetFallbackSequence[] = "VcTOcul jmul";
+
 	enum class Debug
 	{
 		None,
 		PrintStep,
 		PrintChanges
 	};
-	static void run(
+	/// Optimises the code of @a _object. If @a _workBudget is set, each step of the user-supplied
+	/// sequence costs as many work units as the code it is applied to is large. Once the budget
+	/// does not cover the next step, the BudgetFallbackSequence is run instead of the remaining
+	/// steps and the stack compressor only gets a single iteration.
+	/// @returns false if the optimisation was cut short because the work budget was exhausted.
+	static bool run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
 		std::string const& _optimisationSequence,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		size_t _parallelism = 1,
+		bool _useGasCosts = false,
+		std::optional<size_t> _reasoningMaxQueries = {},
+		std::optional<size_t> _workBudget = {}
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -80,6 +97,10 @@ public:
 	);
 
 	static std::map<std::string, std::unique_ptr<OptimiserStep>> const& allSteps();
+	/// @returns the names of the steps that only modify and only look at the function they are run on
+	/// (or at the outermost block), apart from the side effects of called functions.
+	/// If the code is grouped, such steps are run on all functions in parallel (see run()).
+	static std::set<std::string> const& functionLocalSteps();
 	static std::map<std::string, char> const& stepNameToAbbreviationMap();
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
@@ -88,16 +109,46 @@ private:
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
-		Block& _ast
+		Block& _ast,
+		size_t _parallelism = 1
 	):
 		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
 		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
 		m_debug(_debug)
-	{}
+	{
+		m_context.reasoningState = &m_reasoningState;
+		if (_parallelism > 1)
+			m_threadPool = std::make_unique<util::ThreadPool>(_parallelism);
+	}
+
+	/// Runs the step @a _step, on each function in parallel if the step is function-local,
+	/// the code is grouped and a thread pool is available.
+	void runStep(std::string const& _step, Block& _ast);
+	/// Runs the function-local step @a _step on the statements of the grouped code @a _ast
+	/// at the indices @a _parts, in parallel if a thread pool is available.
+	void runStepOnParts(std::string const& _step, Block& _ast, std::vector<size_t> const& _parts);
+	/// Variant of runSequenceUntilStable for sequences of function-local steps only.
+	/// Stops revisiting the outermost block or a function once its code size
+	/// did not change in a round.
+	void runFunctionLocalSequenceUntilStable(
+		std::vector<std::string> const& _steps,
+		Block& _ast,
+		size_t _maxRounds
+	);
+	/// Spends @a _units of the work budget. @returns false and records that the budget
+	/// was exhausted if the remaining budget does not cover them.
+	bool spendBudget(size_t _units);
 
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	/// Query cache and budget of the ReasoningBasedSimplifier for all its runs on the object.
+	ReasoningBasedSimplifierState m_reasoningState;
+	/// Worker threads used to run function-local steps, null if steps are run sequentially.
+	std::unique_ptr<util::ThreadPool> m_threadPool;
+	/// Work units left for the steps of the user-supplied sequence. Unlimited if not set.
+	std::optional<size_t> m_remainingBudget;
+	bool m_budgetExhausted = false;
 };
 
 }
@@ -133,15 +133,15 @@ void UnusedPruner::runUntilStabilised(
 	set<YulString> const& _externallyUsedFunctions
 )
 {
-	while (true)
+	UnusedPruner pruner(_dialect, _ast, _allowMSizeOptimization, _functionSideEffects, _externallyUsedFunctions);
+	// The reference counts are kept up to date while code is removed,
+	// so they do not have to be recomputed for the next run.
+	do
 	{
-		UnusedPruner pruner(
-			_dialect, _ast, _allowMSizeOptimization, _functionSideEffects,
-							_externallyUsedFunctions);
+		pruner.m_shouldRunAgain = false;
 		pruner(_ast);
-		if (!pruner.shouldRunAgain())
-			return;
 	}
+	while (pruner.shouldRunAgain());
 }
 
 void UnusedPruner::runUntilStabilisedOnFullAST(
@@ -163,13 +163,13 @@ void UnusedPruner::runUntilStabilised(
 	set<YulString> const& _externallyUsedFunctions
 )
 {
-	while (true)
+	UnusedPruner pruner(_dialect, _function, _allowMSizeOptimization, _externallyUsedFunctions);
+	do
 	{
-		UnusedPruner pruner(_dialect, _function, _allowMSizeOptimization, _externallyUsedFunctions);
+		pruner.m_shouldRunAgain = false;
 		pruner(_function);
-		if (!pruner.shouldRunAgain())
-			return;
 	}
+	while (pruner.shouldRunAgain());
 }
 
 bool UnusedPruner::used(YulString _name) const
@@ -183,7 +183,10 @@ void UnusedPruner::subtractReferences(map<YulString, size_t> const& _subtrahend)
 	{
 		assertThrow(m_references.count(ref.first), OptimizerException, "");
 		assertThrow(m_references.at(ref.first) >= ref.second, OptimizerException, "");
-		m_references[ref.first] -= ref.second;
-		m_shouldRunAgain = true;
+		size_t& references = m_references[ref.first];
+		references -= ref.second;
+		// Only declarations whose names are not referenced anymore can be removed in the next run.
+		if (references == 0)
+			m_shouldRunAgain = true;
 	}
 }
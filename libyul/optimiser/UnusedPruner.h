@@ -58,7 +58,7 @@ public:
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
 
-	// @returns true iff the code changed in the previous run.
+	// @returns true iff the previous run removed the last reference to a name.
 	bool shouldRunAgain() const { return m_shouldRunAgain; }
 
 	// Run the pruner until the code does not change anymore.
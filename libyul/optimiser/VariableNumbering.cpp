@@ -0,0 +1,88 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Dense integer ids for the variables of a Yul function.
+ */
+
+#include <libyul/optimiser/VariableNumbering.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AST.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+class VariableNumberingCollector: public ASTWalker
+{
+public:
+	explicit VariableNumberingCollector(VariableNumbering& _numbering): m_numbering(_numbering) {}
+
+	using ASTWalker::operator();
+	void operator()(Identifier const& _identifier) override { m_numbering.add(_identifier.name); }
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (auto const& var: _varDecl.variables)
+			m_numbering.add(var.name);
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(FunctionDefinition const&) override {}
+
+private:
+	VariableNumbering& m_numbering;
+};
+
+}
+
+VariableNumbering VariableNumbering::forFunction(FunctionDefinition const& _function)
+{
+	VariableNumbering numbering;
+	for (auto const& parameter: _function.parameters)
+		numbering.add(parameter.name);
+	for (auto const& returnVariable: _function.returnVariables)
+		numbering.add(returnVariable.name);
+	VariableNumberingCollector{numbering}(_function.body);
+	return numbering;
+}
+
+VariableNumbering VariableNumbering::forBlock(Block const& _code)
+{
+	VariableNumbering numbering;
+	VariableNumberingCollector{numbering}(_code);
+	return numbering;
+}
+
+VariableNumbering::VariableId VariableNumbering::add(YulString _name)
+{
+	auto [it, inserted] = m_ids.emplace(_name, static_cast<VariableId>(m_names.size()));
+	if (inserted)
+		m_names.emplace_back(_name);
+	return it->second;
+}
+
+optional<VariableNumbering::VariableId> VariableNumbering::id(YulString _name) const
+{
+	if (VariableId const* id = util::valueOrNullptr(m_ids, _name))
+		return *id;
+	return nullopt;
+}
@@ -0,0 +1,67 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Dense integer ids for the variables of a Yul function.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Numbers the variables of a function (or of code outside of functions) densely,
+ * starting at zero, so that analyses can store per-variable information in vectors
+ * indexed by these ids instead of maps keyed by name.
+ *
+ * Parameters are numbered first, then return variables, then all variables declared
+ * or referenced in the body in the order of their first occurrence. Function definitions
+ * nested in the code are not part of the numbering.
+ *
+ * Prerequisite: Disambiguator
+ */
+class VariableNumbering
+{
+public:
+	using VariableId = uint32_t;
+
+	static VariableNumbering forFunction(FunctionDefinition const& _function);
+	static VariableNumbering forBlock(Block const& _code);
+
+	/// Assigns the next id to @a _name unless it already has one.
+	/// @returns the id of @a _name.
+	VariableId add(YulString _name);
+
+	size_t size() const { return m_names.size(); }
+	YulString name(VariableId _id) const { return m_names.at(_id); }
+	std::optional<VariableId> id(YulString _name) const;
+
+private:
+	std::vector<YulString> m_names;
+	std::unordered_map<YulString, VariableId> m_ids;
+};
+
+}
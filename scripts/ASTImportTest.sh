@@ -68,8 +68,17 @@ function testImportExportEquivalence {
             FAILED=$((FAILED + 1))
             return 2
         fi
+        # export the ASTs in the binary format, import them and compare with the JSON export
+        $SOLC --ast-binary --output-dir binary "$1" $2 > /dev/null 2>&1
+        $SOLC --import-ast-binary --combined-json ast,compact-format --pretty-json binary/combined.astb > obtained.json 2> /dev/null
+        if [ $? -ne 0 ] || [ "$(diff expected.json obtained.json)" != "" ]
+        then
+            echo -e "ERROR: Binary AST import differs for $1"
+            FAILED=$((FAILED + 1))
+            return 3
+        fi
         TESTED=$((TESTED + 1))
-        rm expected.json obtained.json
+        rm -r expected.json obtained.json binary
     else
         # echo "contract $solfile could not be compiled "
         UNCOMPILABLE=$((UNCOMPILABLE + 1))
@@ -31,6 +31,8 @@
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/interface/ArtifactBundle.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
@@ -39,6 +41,7 @@
 
 #include <libyul/AssemblyStack.h>
 #include <libyul/optimiser/Suite.h>
+#include <libyul/optimiser/OptimiserStepProfiler.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/GasMeter.h>
@@ -53,6 +56,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 
 #include <algorithm>
 #include <memory>
@@ -74,6 +78,10 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <thread>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
 #if !defined(STDERR_FILENO)
 	#define STDERR_FILENO 2
@@ -115,6 +123,7 @@ std::ostream& serr(bool _used = true)
 static string const g_stdinFileNameStr = "<stdin>";
 static string const g_strAbi = "abi";
 static string const g_strAllowPaths = "allow-paths";
+static string const g_strArtifactBundle = "artifact-bundle";
 static string const g_strBasePath = "base-path";
 static string const g_strAsm = "asm";
 static string const g_strAsmJson = "asm-json";
@@ -122,8 +131,10 @@ static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
+static string const g_strAstBinary = "ast-binary";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -138,6 +149,7 @@ static string const g_strGeneratedSourcesRuntime = "generated-sources-runtime";
 static string const g_strGas = "gas";
 static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
+static string const g_strImportAstBinary = "import-ast-binary";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
 static string const g_strYul = "yul";
@@ -145,6 +157,7 @@ static string const g_strYulDialect = "yul-dialect";
 static string const g_strIR = "ir";
 static string const g_strIROptimized = "ir-optimized";
 static string const g_strIPFS = "ipfs";
+static string const g_strJobs = "jobs";
 static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
 static string const g_strLink = "link";
@@ -152,9 +165,17 @@ static string const g_strMachine = "machine";
 static string const g_strMetadata = "metadata";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerCache = "model-checker-cache";
 static string const g_strModelCheckerEngine = "model-checker-engine";
 static string const g_strModelCheckerTargets = "model-checker-targets";
+static string const g_strModelCheckerJobs = "model-checker-jobs";
+static string const g_strModelCheckerModular = "model-checker-modular";
+static string const g_strModelCheckerNoCHCCounterexamples = "model-checker-no-chc-counterexamples";
+static string const g_strModelCheckerReuseInvariants = "model-checker-reuse-invariants";
+static string const g_strModelCheckerShowStats = "model-checker-show-stats";
+static string const g_strModelCheckerSlicing = "model-checker-slicing";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
+static string const g_strModelCheckerTotalTimeout = "model-checker-total-timeout";
 static string const g_strNatspecDev = "devdoc";
 static string const g_strNatspecUser = "userdoc";
 static string const g_strNone = "none";
@@ -163,7 +184,9 @@ static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
+static string const g_strOptimizerProfile = "optimizer-profile";
 static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulAlternativeOptimizations = "yul-alternative-optimizations";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
@@ -180,16 +203,23 @@ static set<string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static string const g_strServer = "server";
 static string const g_strSignatureHashes = "hashes";
+static string const g_strSizeReport = "size-report";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
 static string const g_strSrcMap = "srcmap";
 static string const g_strSrcMapRuntime = "srcmap-runtime";
 static string const g_strStandardJSON = "standard-json";
+static string const g_strStandardJSONBatch = "standard-json-batch";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
+static string const g_strTarget = "target";
+static string const g_strTimePasses = "time-passes";
+static string const g_strTraceOut = "trace-out";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strVersion = "version";
+static string const g_strWatch = "watch";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
 static string const g_strColor = "color";
 static string const g_strNoColor = "no-color";
@@ -198,21 +228,26 @@ static string const g_strErrorIds = "error-codes";
 static string const g_argAbi = g_strAbi;
 static string const g_argPrettyJson = g_strPrettyJson;
 static string const g_argAllowPaths = g_strAllowPaths;
+static string const g_argArtifactBundle = g_strArtifactBundle;
 static string const g_argBasePath = g_strBasePath;
 static string const g_argAsm = g_strAsm;
 static string const g_argAsmJson = g_strAsmJson;
 static string const g_argAssemble = g_strAssemble;
 static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
+static string const g_argAstBinary = g_strAstBinary;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argErrorRecovery = g_strErrorRecovery;
 static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argImportAst = g_strImportAst;
+static string const g_argImportAstBinary = g_strImportAstBinary;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argJobs = g_strJobs;
 static string const g_argYul = g_strYul;
 static string const g_argIR = g_strIR;
 static string const g_argIROptimized = g_strIROptimized;
@@ -224,26 +259,48 @@ static string const g_argMachine = g_strMachine;
 static string const g_argMetadata = g_strMetadata;
 static string const g_argMetadataHash = g_strMetadataHash;
 static string const g_argMetadataLiteral = g_strMetadataLiteral;
+static string const g_argModelCheckerCache = g_strModelCheckerCache;
 static string const g_argModelCheckerEngine = g_strModelCheckerEngine;
 static string const g_argModelCheckerTargets = g_strModelCheckerTargets;
+static string const g_argModelCheckerJobs = g_strModelCheckerJobs;
+static string const g_argModelCheckerModular = g_strModelCheckerModular;
+static string const g_argModelCheckerNoCHCCounterexamples = g_strModelCheckerNoCHCCounterexamples;
+static string const g_argModelCheckerReuseInvariants = g_strModelCheckerReuseInvariants;
+static string const g_argModelCheckerShowStats = g_strModelCheckerShowStats;
+static string const g_argModelCheckerSlicing = g_strModelCheckerSlicing;
 static string const g_argModelCheckerTimeout = g_strModelCheckerTimeout;
+static string const g_argModelCheckerTotalTimeout = g_strModelCheckerTotalTimeout;
 static string const g_argNatspecDev = g_strNatspecDev;
 static string const g_argNatspecUser = g_strNatspecUser;
 static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
+static string const g_argServer = g_strServer;
 static string const g_argSignatureHashes = g_strSignatureHashes;
+static string const g_argSizeReport = g_strSizeReport;
 static string const g_argStandardJSON = g_strStandardJSON;
+static string const g_argStandardJSONBatch = g_strStandardJSONBatch;
 static string const g_argStorageLayout = g_strStorageLayout;
 static string const g_argStrictAssembly = g_strStrictAssembly;
+static string const g_argTarget = g_strTarget;
+static string const g_argTimePasses = g_strTimePasses;
+static string const g_argTraceOut = g_strTraceOut;
 static string const g_argVersion = g_strVersion;
+static string const g_argWatch = g_strWatch;
 static string const g_stdinFileName = g_stdinFileNameStr;
 static string const g_argIgnoreMissingFiles = g_strIgnoreMissingFiles;
 static string const g_argColor = g_strColor;
 static string const g_argNoColor = g_strNoColor;
 static string const g_argErrorIds = g_strErrorIds;
 
+/// Time between two checks for changed files in watch mode.
+static chrono::milliseconds const g_watchInterval{250};
+/// Maximum number of contracts kept in the compilation cache in watch mode.
+static size_t const g_watchCacheCapacity = 1024;
+/// Maximum number of contracts kept in the compilation cache shared by the jobs of --standard-json-batch.
+static size_t const g_batchCacheCapacity = 4096;
+
 /// Possible arguments to for --combined-json
 static set<string> const g_combinedJsonArgs
 {
@@ -310,7 +367,7 @@ static void license()
 
 static bool needsHumanTargetedStdout(po::variables_map const& _args)
 {
-	if (_args.count(g_argGas))
+	if (_args.count(g_argGas) || _args.count(g_argSizeReport))
 		return true;
 	if (_args.count(g_argOutputDir))
 		return false;
@@ -574,6 +631,12 @@ void CommandLineInterface::handleGasEstimation(string const& _contract)
 	}
 }
 
+void CommandLineInterface::handleSizeReport(string const& _contract)
+{
+	if (BytecodeSizeReport const* report = m_compiler->sizeReport(_contract))
+		sout() << "Bytecode size report:" << endl << report->toString();
+}
+
 bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 {
 	bool ignoreMissing = m_args.count(g_argIgnoreMissingFiles);
@@ -628,6 +691,7 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 
 				// NOTE: we ignore the FileNotFound exception as we manually check above
 				m_sourceCodes[infile.generic_string()] = readFileAsString(infile.string());
+				m_inputFileNames.insert(infile.generic_string());
 				path = boost::filesystem::canonical(infile).string();
 			}
 			m_allowedDirectories.push_back(boost::filesystem::path(path).remove_filename());
@@ -643,6 +707,32 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 	return true;
 }
 
+bool CommandLineInterface::compileStandardJsonBatch(StandardCompiler& _compiler, string const& _input)
+{
+	Json::Value jobs;
+	string errors;
+	if (!jsonParseStrict(_input, jobs, &errors) || !jobs.isArray())
+	{
+		serr() << "The input of --" << g_argStandardJSONBatch << " has to be a JSON array of Standard JSON inputs";
+		serr() << (errors.empty() ? "." : ": " + errors) << endl;
+		return false;
+	}
+
+	// The jobs run one after the other, since the compiler keeps global state, but they share
+	// the code generated for contracts that are compiled with the same settings in several jobs.
+	_compiler.setCompilationCache(make_shared<CompilationCache>(g_batchCacheCapacity));
+	sout() << "[";
+	for (Json::ArrayIndex i = 0; i < jobs.size(); ++i)
+	{
+		if (i > 0)
+			sout() << ",";
+		_compiler.compile(jsonCompactPrint(jobs[i]), sout());
+		m_sourceCodes.clear();
+	}
+	sout() << "]";
+	return true;
+}
+
 bool CommandLineInterface::parseLibraryOption(string const& _input)
 {
 	namespace fs = boost::filesystem;
@@ -738,7 +828,7 @@ bool CommandLineInterface::parseLibraryOption(string const& _input)
 	return true;
 }
 
-map<string, Json::Value> CommandLineInterface::parseAstFromInput()
+map<string, Json::Value> CommandLineInterface::parseAstFromInput(bool _binary)
 {
 	map<string, Json::Value> sourceJsons;
 	map<string, string> tmpSources;
@@ -746,18 +836,28 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 	for (auto const& srcPair: m_sourceCodes)
 	{
 		Json::Value ast;
-		astAssert(jsonParseStrict(srcPair.second, ast), "Input file could not be parsed to JSON");
+		if (_binary)
+		{
+			// The standard input is read line by line, which does not preserve binary data.
+			astAssert(srcPair.first != g_stdinFileName, "Binary ASTs cannot be read from standard input");
+			astAssert(jsonParseBinary(srcPair.second, ast), "Input file could not be parsed as binary AST");
+		}
+		else
+			astAssert(jsonParseStrict(srcPair.second, ast), "Input file could not be parsed to JSON");
 		astAssert(ast.isMember("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
 
 		for (auto& src: ast["sources"].getMemberNames())
 		{
-			std::string astKey = ast["sources"][src].isMember("ast") ? "ast" : "AST";
+			Json::Value& source = ast["sources"][src];
+			std::string astKey = source.isMember("ast") ? "ast" : "AST";
 
-			astAssert(ast["sources"][src].isMember(astKey), "astkey is not member");
-			astAssert(ast["sources"][src][astKey]["nodeType"].asString() == "SourceUnit",  "Top-level node should be a 'SourceUnit'");
+			astAssert(source.isMember(astKey), "astkey is not member");
+			astAssert(source[astKey]["nodeType"].asString() == "SourceUnit",  "Top-level node should be a 'SourceUnit'");
 			astAssert(sourceJsons.count(src) == 0, "All sources must have unique names");
-			sourceJsons.emplace(src, move(ast["sources"][src][astKey]));
-			tmpSources[src] = util::jsonCompactPrint(ast);
+			// Only the AST of this source is serialised, so that the time needed does not grow
+			// quadratically with the number of sources in the input.
+			tmpSources[src] = util::jsonCompactPrint(source[astKey]);
+			sourceJsons.emplace(src, move(source[astKey]));
 		}
 	}
 
@@ -765,11 +865,13 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 	return sourceJsons;
 }
 
-void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+void CommandLineInterface::createFile(string const& _fileName, string const& _data, bool _binary)
 {
 	namespace fs = boost::filesystem;
 
 	fs::path outputDir(m_args.at(g_argOutputDir).as<string>());
+	if (!m_outputSubdirectory.empty())
+		outputDir /= m_outputSubdirectory;
 
 	// NOTE: create_directories() raises an exception if the path consists solely of '.' or '..'
 	// (or equivalent such as './././.'). Paths like 'a/b/.' and 'a/b/..' are fine though.
@@ -777,13 +879,14 @@ void CommandLineInterface::createFile(string const& _fileName, string const& _da
 	fs::create_directories(fs::absolute(outputDir));
 
 	string pathName = (outputDir / _fileName).string();
-	if (fs::exists(pathName) && !m_args.count(g_strOverwrite))
+	// In watch mode, the files written by earlier compilations are replaced.
+	if (fs::exists(pathName) && !m_args.count(g_strOverwrite) && !m_createdFiles.count(pathName))
 	{
 		serr() << "Refusing to overwrite existing file \"" << pathName << "\" (use --" << g_strOverwrite << " to force)." << endl;
 		m_error = true;
 		return;
 	}
-	ofstream outFile(pathName);
+	ofstream outFile(pathName, _binary ? ios::out | ios::binary : ios::out);
 	outFile << _data;
 	if (!outFile)
 	{
@@ -791,6 +894,8 @@ void CommandLineInterface::createFile(string const& _fileName, string const& _da
 		m_error = true;
 		return;
 	}
+	if (m_args.count(g_argWatch))
+		m_createdFiles.insert(pathName);
 }
 
 void CommandLineInterface::createJson(string const& _fileName, string const& _json)
@@ -872,6 +977,36 @@ General Information)").c_str(),
 			g_strExperimentalViaIR.c_str(),
 			"Turn on experimental compilation mode via the IR (EXPERIMENTAL)."
 		)
+		(
+			g_argJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Generate the code of up to n independent contracts and optimise up to n Yul objects in parallel. "
+			"0 uses one job per hardware thread. The default is 1."
+		)
+		(
+			g_argTarget.c_str(),
+			po::value<vector<string>>()->value_name("settings"),
+			("Compile the analysed sources again with different backend settings and write the output to "
+			"a subdirectory of the directory given by --" + g_argOutputDir + ", which is named after the "
+			"settings. The settings are a comma-separated list of " + g_strEVMVersion + "=<version>, " +
+			g_strOptimize + ", no-" + g_strOptimize + ", " + g_strOptimizeRuns + "=<n>, via-ir and no-via-ir. "
+			"Settings that are not given are taken from the other options. The EVM version must not be "
+			"older than the one given by --" + g_strEVMVersion + ". Can be given multiple times.").c_str()
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the code generated for each contract in the given directory and reuse it "
+			"if the contract and its settings are unchanged. Ignored if assembly or gas "
+			"estimates are requested."
+		)
+		(
+			g_argWatch.c_str(),
+			("Keep running after the compilation and compile again whenever one of the input files or "
+			"the files they import changes, writing the output to the directory given by --" + g_argOutputDir + ". "
+			"Only the sources affected by a change are analysed again and contracts that did not change "
+			"are not compiled again unless assembly or gas estimates are requested.").c_str()
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<string>()->value_name(boost::join(g_revertStringsArgs, ",")),
@@ -892,6 +1027,19 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_argStandardJSONBatch.c_str(),
+			("Switch to Standard JSON batch mode, ignoring all options. "
+			"It reads a JSON array of Standard JSON inputs in the same way as --" + g_argStandardJSON + " and "
+			"writes the array of their outputs to standard output. The jobs are compiled in a single process "
+			"and contracts that are identical in several jobs, including their settings, are only compiled once.").c_str()
+		)
+		(
+			g_argServer.c_str(),
+			"Switch to compile server mode, ignoring all options. "
+			"It reads Standard JSON inputs from standard input, one per line, and writes the output "
+			"for each of them as a single line to standard output until the end of the input."
+		)
 		(
 			g_argLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_argLibraries + " "
@@ -921,6 +1069,11 @@ General Information)").c_str(),
 			"Supported Inputs is the output of the --" + g_argStandardJSON + " or the one produced by "
 			"--" + g_argCombinedJson + " " + g_strAst + "," + g_strCompactJSON).c_str()
 		)
+		(
+			g_argImportAstBinary.c_str(),
+			("Import ASTs to be compiled, assumes input holds the ASTs in the binary format "
+			"produced by --" + g_argAstBinary + ".").c_str()
+		)
 	;
 	desc.add(alternativeInputModes);
 
@@ -976,6 +1129,17 @@ General Information)").c_str(),
 	outputComponents.add_options()
 		(g_argAstJson.c_str(), "AST of all source files in JSON format.")
 		(g_argAstCompactJson.c_str(), "AST of all source files in a compact JSON format.")
+		(
+			g_argAstBinary.c_str(),
+			("AST of all source files in a compact binary format that can be imported with --" +
+			g_argImportAstBinary + ". Requires --" + g_argOutputDir + ".").c_str()
+		)
+		(
+			g_argArtifactBundle.c_str(),
+			("Bytecode, deployed bytecode, ABI, source mappings and metadata of all contracts in a "
+			"single indexed binary file that can be memory-mapped and read selectively. "
+			"Requires --" + g_argOutputDir + ".").c_str()
+		)
 		(g_argAsm.c_str(), "EVM assembly of the contracts.")
 		(g_argAsmJson.c_str(), "EVM assembly of the contracts in JSON format.")
 		(g_argOpcodes.c_str(), "Opcodes of the contracts.")
@@ -999,11 +1163,27 @@ General Information)").c_str(),
 			g_argGas.c_str(),
 			"Print an estimate of the maximal gas usage for each function."
 		)
+		(
+			g_argSizeReport.c_str(),
+			"Print the number of bytes of the deployed code per function, modifier and, "
+			"when compiling via the IR, per generated Yul function."
+		)
 		(
 			g_argCombinedJson.c_str(),
 			po::value<string>()->value_name(boost::join(g_combinedJsonArgs, ",")),
 			"Output a single json document containing the specified information."
 		)
+		(
+			g_argTimePasses.c_str(),
+			"Print the wall-clock time and peak memory usage of the individual compiler phases "
+			"and optimiser steps to stderr."
+		)
+		(
+			g_argTraceOut.c_str(),
+			po::value<string>()->value_name("path"),
+			"Write a timeline of the compiler phases, contracts, optimiser rounds and steps "
+			"to the given file in the Chrome trace event format."
+		)
 	;
 	desc.add(extraOutput);
 
@@ -1046,6 +1226,18 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulAlternativeOptimizations.c_str(),
+			po::value<vector<string>>()->value_name("steps"),
+			"Further sequence of Yul optimization steps, can be given multiple times. Every Yul object is optimized "
+			"with the main sequence and with each of these sequences, in parallel if --jobs is set, and the result "
+			"with the lowest estimated gas costs for the given number of runs is kept."
+		)
+		(
+			g_strOptimizerProfile.c_str(),
+			"Print the number of invocations, the wall-clock time and the change in code size "
+			"of each Yul optimizer step and the number of applications of each simplification rule to stderr."
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -1070,6 +1262,55 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerTotalTimeout.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Limit the time the CHC engine spends checking verification targets to the given "
+			"number of milliseconds. All targets are first checked with a short timeout and the "
+			"unresolved ones are checked again with doubling timeouts, up to the timeout per query. "
+			"Only has an effect if z3 is used. A value of 0 means no limit."
+		)
+		(
+			g_strModelCheckerJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Check up to n verification targets in parallel. "
+			"0 uses one job per hardware thread. The default is 1. "
+			"Only has an effect if z3 or cvc4 is used. "
+			"If both are used and n is not 1, BMC runs them concurrently and uses the first answer."
+		)
+		(
+			g_strModelCheckerCache.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the results of the solver queries in the given directory and reuse them "
+			"for identical queries with the same solver and timeout."
+		)
+		(
+			g_strModelCheckerModular.c_str(),
+			"Check each public function of a contract in isolation with the CHC engine, "
+			"assuming only that the state variables hold values of their types "
+			"instead of computing the states reachable through the other functions."
+		)
+		(
+			g_strModelCheckerNoCHCCounterexamples.c_str(),
+			"Report the violations found by the CHC engine without counterexamples. "
+			"This saves a second solver query per violation, which is otherwise needed "
+			"to obtain a complete counterexample."
+		)
+		(
+			g_strModelCheckerReuseInvariants.c_str(),
+			("Store the invariants found by the CHC engine in the directory given by --" + g_strModelCheckerCache + " "
+			"and start later checks from the stored invariants that still hold.").c_str()
+		)
+		(
+			g_strModelCheckerShowStats.c_str(),
+			"Print statistics on the solver queries of the verification targets "
+			"(engine, size, solvers, time and result) and the encoding time of the contracts to stderr."
+		)
+		(
+			g_strModelCheckerSlicing.c_str(),
+			"Leave the state and local variables that cannot influence the verification targets, "
+			"because they are only written to, out of the predicates of the CHC engine."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -1098,11 +1339,13 @@ General Information)").c_str(),
 		return false;
 
 	static vector<string> const conflictingWithStopAfter{
+		g_argArtifactBundle,
 		g_argBinary,
 		g_argIR,
 		g_argIROptimized,
 		g_argEwasm,
 		g_argGas,
+		g_argSizeReport,
 		g_argAsm,
 		g_argAsmJson,
 		g_argOpcodes
@@ -1166,8 +1409,126 @@ General Information)").c_str(),
 	return true;
 }
 
+optional<OptimiserSettings> CommandLineInterface::optimiserSettings(bool _optimize, unsigned _runs)
+{
+	OptimiserSettings settings = _optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal();
+	settings.expectedExecutionsPerDeployment = _runs;
+	if (m_args.count(g_strNoOptimizeYul))
+		settings.runYulOptimiser = false;
+	if (m_args.count(g_strYulOptimizations))
+	{
+		if (!settings.runYulOptimiser)
+		{
+			serr() << "--" << g_strYulOptimizations << " is invalid if Yul optimizer is disabled" << endl;
+			return nullopt;
+		}
+
+		try
+		{
+			yul::OptimiserSuite::validateSequence(m_args[g_strYulOptimizations].as<string>());
+		}
+		catch (yul::OptimizerException const& _exception)
+		{
+			serr() << "Invalid optimizer step sequence in --" << g_strYulOptimizations << ": " << _exception.what() << endl;
+			return nullopt;
+		}
+
+		settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
+	}
+	if (m_args.count(g_strYulAlternativeOptimizations))
+	{
+		if (!settings.runYulOptimiser)
+		{
+			serr() << "--" << g_strYulAlternativeOptimizations << " is invalid if Yul optimizer is disabled" << endl;
+			return nullopt;
+		}
+
+		for (string const& sequence: m_args[g_strYulAlternativeOptimizations].as<vector<string>>())
+		{
+			try
+			{
+				yul::OptimiserSuite::validateSequence(sequence);
+			}
+			catch (yul::OptimizerException const& _exception)
+			{
+				serr() << "Invalid optimizer step sequence in --" << g_strYulAlternativeOptimizations << ": " << _exception.what() << endl;
+				return nullopt;
+			}
+			settings.yulOptimiserAlternativeSteps.push_back(sequence);
+		}
+	}
+	settings.optimizeStackAllocation = settings.runYulOptimiser;
+	return settings;
+}
+
+bool CommandLineInterface::parseTargets()
+{
+	for (string const& target: m_args[g_argTarget].as<vector<string>>())
+	{
+		CompilerStack::BackendSettings backendSettings{m_evmVersion, {}, m_args.count(g_argExperimentalViaIR) > 0};
+		bool optimize = m_args.count(g_argOptimize);
+		unsigned runs = m_args[g_argOptimizeRuns].as<unsigned>();
+		vector<string> targetSettings;
+		boost::split(targetSettings, target, boost::is_any_of(","));
+		for (string const& setting: targetSettings)
+		{
+			size_t const separator = setting.find('=');
+			string const name = setting.substr(0, separator);
+			string const value = separator == string::npos ? "" : setting.substr(separator + 1);
+			if (name == g_strEVMVersion && separator != string::npos)
+			{
+				optional<langutil::EVMVersion> version = langutil::EVMVersion::fromString(value);
+				if (!version)
+				{
+					serr() << "Invalid EVM version in --" << g_argTarget << ": " << value << endl;
+					return false;
+				}
+				if (*version < m_evmVersion)
+				{
+					serr() << "The EVM version of --" << g_argTarget << " must not be older than the one of --";
+					serr() << g_strEVMVersion << ", which is used for the analysis." << endl;
+					return false;
+				}
+				backendSettings.evmVersion = *version;
+			}
+			else if (setting == g_strOptimize || setting == "no-" + g_strOptimize)
+				optimize = setting == g_strOptimize;
+			else if (name == g_strOptimizeRuns && separator != string::npos)
+			{
+				// At most nine digits always fit into an unsigned integer.
+				if (value.empty() || value.size() > 9 || !all_of(value.begin(), value.end(), [](char _c) { return isdigit(_c); }))
+				{
+					serr() << "Invalid number of runs in --" << g_argTarget << ": " << value << endl;
+					return false;
+				}
+				runs = static_cast<unsigned>(stoul(value));
+			}
+			else if (setting == "via-ir" || setting == "no-via-ir")
+				backendSettings.viaIR = setting == "via-ir";
+			else
+			{
+				serr() << "Invalid setting in --" << g_argTarget << ": \"" << setting << "\"" << endl;
+				return false;
+			}
+		}
+		optional<OptimiserSettings> settings = optimiserSettings(optimize, runs);
+		if (!settings)
+			return false;
+		backendSettings.optimiserSettings = std::move(*settings);
+		m_targets.emplace_back(boost::replace_all_copy(boost::replace_all_copy(target, ",", "_"), "=", "_"), std::move(backendSettings));
+	}
+	return true;
+}
+
 bool CommandLineInterface::processInput()
 {
+	if (m_args.count(g_argTimePasses))
+		Profiler::instance().setEnabled(true);
+	if (m_args.count(g_argTraceOut))
+		Profiler::instance().setTracingEnabled(true);
+	if (m_args.count(g_strOptimizerProfile))
+		yul::OptimiserStepProfiler::instance().setEnabled(true);
+
 	ReadCallback::Callback fileReader = [this](string const& _kind, string const& _path)
 	{
 		try
@@ -1262,11 +1623,14 @@ bool CommandLineInterface::processInput()
 
 	vector<string> const exclusiveModes = {
 		g_argStandardJSON,
+		g_argStandardJSONBatch,
+		g_argServer,
 		g_argLink,
 		g_argAssemble,
 		g_argStrictAssembly,
 		g_argYul,
 		g_argImportAst,
+		g_argImportAstBinary,
 	};
 	if (countEnabledOptions(exclusiveModes) > 1)
 	{
@@ -1275,8 +1639,55 @@ bool CommandLineInterface::processInput()
 		return false;
 	}
 
-	if (m_args.count(g_argStandardJSON))
+	if (m_args.count(g_argAstBinary) && !m_args.count(g_argOutputDir))
+	{
+		serr() << "--" << g_argAstBinary << " requires --" << g_argOutputDir << "." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_argArtifactBundle) && !m_args.count(g_argOutputDir))
+	{
+		serr() << "--" << g_argArtifactBundle << " requires --" << g_argOutputDir << "." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_argTarget))
+	{
+		if (!m_args.count(g_argOutputDir))
+		{
+			serr() << "--" << g_argTarget << " requires --" << g_argOutputDir << "." << endl;
+			return false;
+		}
+		if (m_args.count(g_argWatch) || countEnabledOptions(exclusiveModes) > 0)
+		{
+			serr() << "--" << g_argTarget << " cannot be used together with --" << g_argWatch << ", ";
+			serr() << joinOptionNames(exclusiveModes) << "." << endl;
+			return false;
+		}
+	}
+
+	if (m_args.count(g_argWatch))
 	{
+		if (!m_args.count(g_argOutputDir))
+		{
+			serr() << "--" << g_argWatch << " requires --" << g_argOutputDir << "." << endl;
+			return false;
+		}
+		if (countEnabledOptions(exclusiveModes) > 0)
+		{
+			serr() << "--" << g_argWatch << " cannot be used together with " << joinOptionNames(exclusiveModes) << "." << endl;
+			return false;
+		}
+		if (m_args.count(g_argInputFile) && contains(m_args[g_argInputFile].as<vector<string>>(), "-"))
+		{
+			serr() << "The standard input cannot be watched." << endl;
+			return false;
+		}
+	}
+
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argStandardJSONBatch))
+	{
+		string const& mode = m_args.count(g_argStandardJSON) ? g_argStandardJSON : g_argStandardJSONBatch;
 		vector<string> inputFiles;
 		string jsonFile;
 		if (m_args.count(g_argInputFile))
@@ -1285,7 +1696,7 @@ bool CommandLineInterface::processInput()
 			jsonFile = inputFiles[0];
 		else if (inputFiles.size() > 1)
 		{
-			serr() << "If --" << g_argStandardJSON << " is used, only zero or one input files are supported." << endl;
+			serr() << "If --" << mode << " is used, only zero or one input files are supported." << endl;
 			return false;
 		}
 		string input;
@@ -1304,7 +1715,32 @@ bool CommandLineInterface::processInput()
 			}
 		}
 		StandardCompiler compiler(fileReader);
-		sout() << compiler.compile(std::move(input)) << endl;
+		if (m_args.count(g_argStandardJSON))
+			compiler.compile(input, sout());
+		else if (!compileStandardJsonBatch(compiler, input))
+			return false;
+		sout() << endl;
+		return true;
+	}
+
+	if (m_args.count(g_argServer))
+	{
+		if (m_args.count(g_argInputFile))
+		{
+			serr() << "No input files are supported if --" << g_argServer << " is used." << endl;
+			return false;
+		}
+		// All compilations share the process, so the dialects, simplification rules and other
+		// caches are only initialised once.
+		StandardCompiler compiler(fileReader);
+		string input;
+		while (getline(std::cin, input))
+			if (!boost::algorithm::trim_copy(input).empty())
+			{
+				compiler.compile(input, sout());
+				sout() << endl;
+				m_sourceCodes.clear();
+			}
 		return true;
 	}
 
@@ -1333,7 +1769,9 @@ bool CommandLineInterface::processInput()
 		vector<string> const nonAssemblyModeOptions = {
 			// TODO: The list is not complete. Add more.
 			g_argOutputDir,
+			g_argArtifactBundle,
 			g_argGas,
+			g_argSizeReport,
 			g_argCombinedJson,
 			g_strOptimizeYul,
 			g_strNoOptimizeYul,
@@ -1497,6 +1935,21 @@ bool CommandLineInterface::processInput()
 	if (m_args.count(g_argModelCheckerTimeout))
 		m_modelCheckerSettings.timeout = m_args[g_argModelCheckerTimeout].as<unsigned>();
 
+	if (m_args.count(g_argModelCheckerTotalTimeout))
+		m_modelCheckerSettings.totalTimeout = m_args[g_argModelCheckerTotalTimeout].as<unsigned>();
+
+	if (m_args.count(g_argModelCheckerJobs))
+		m_modelCheckerSettings.jobs = m_args[g_argModelCheckerJobs].as<unsigned>();
+
+	if (m_args.count(g_argModelCheckerCache))
+		m_modelCheckerSettings.cacheDirectory = m_args[g_argModelCheckerCache].as<string>();
+
+	m_modelCheckerSettings.modular = m_args.count(g_argModelCheckerModular);
+	m_modelCheckerSettings.chcCounterexamples = !m_args.count(g_argModelCheckerNoCHCCounterexamples);
+	m_modelCheckerSettings.slicing = m_args.count(g_argModelCheckerSlicing);
+	m_modelCheckerSettings.reuseInvariants = m_args.count(g_argModelCheckerReuseInvariants);
+	m_modelCheckerSettings.showStats = m_args.count(g_argModelCheckerShowStats);
+
 	m_compiler = make_unique<CompilerStack>(fileReader);
 
 	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
@@ -1507,7 +1960,18 @@ bool CommandLineInterface::processInput()
 			m_compiler->useMetadataLiteralSources(true);
 		if (m_args.count(g_argMetadataHash))
 			m_compiler->setMetadataHash(m_metadataHash);
-		if (m_args.count(g_argModelCheckerEngine) || m_args.count(g_argModelCheckerTimeout))
+		if (
+			m_args.count(g_argModelCheckerCache) ||
+			m_args.count(g_argModelCheckerEngine) ||
+			m_args.count(g_argModelCheckerJobs) ||
+			m_args.count(g_argModelCheckerModular) ||
+			m_args.count(g_argModelCheckerNoCHCCounterexamples) ||
+			m_args.count(g_argModelCheckerReuseInvariants) ||
+			m_args.count(g_argModelCheckerShowStats) ||
+			m_args.count(g_argModelCheckerSlicing) ||
+			m_args.count(g_argModelCheckerTimeout) ||
+			m_args.count(g_argModelCheckerTotalTimeout)
+		)
 			m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
 		if (m_args.count(g_argInputFile))
 			m_compiler->setRemappings(m_remappings);
@@ -1516,45 +1980,53 @@ bool CommandLineInterface::processInput()
 			m_compiler->setLibraries(m_libraries);
 		if (m_args.count(g_argExperimentalViaIR))
 			m_compiler->setViaIR(true);
+		if (m_args.count(g_argJobs))
+			m_compiler->setParallelism(m_args[g_argJobs].as<unsigned>());
+		if (m_args.count(g_argCacheDir) || m_args.count(g_argWatch))
+		{
+			// Contracts restored from the cache do not have an assembly and, when compiled via the IR,
+			// no size report.
+			bool assemblyRequested =
+				m_args.count(g_argAsm) ||
+				m_args.count(g_argAsmJson) ||
+				m_args.count(g_argGas) ||
+				m_args.count(g_argSizeReport);
+			if (m_args.count(g_argCombinedJson))
+			{
+				vector<string> requests;
+				boost::split(requests, m_args[g_argCombinedJson].as<string>(), boost::is_any_of(","));
+				assemblyRequested = assemblyRequested || util::contains(requests, g_strAsm);
+			}
+			if (!assemblyRequested)
+				m_compiler->setCompilationCache(
+					m_args.count(g_argCacheDir) ?
+					make_shared<CompilationCache>(m_args[g_argCacheDir].as<string>()) :
+					make_shared<CompilationCache>(g_watchCacheCapacity)
+				);
+		}
 		m_compiler->setEVMVersion(m_evmVersion);
 		m_compiler->setRevertStringBehaviour(m_revertStrings);
 		// TODO: Perhaps we should not compile unless requested
 
 		m_compiler->enableIRGeneration(m_args.count(g_argIR) || m_args.count(g_argIROptimized));
 		m_compiler->enableEwasmGeneration(m_args.count(g_argEwasm));
+		m_compiler->enableSizeReport(m_args.count(g_argSizeReport));
 
-		OptimiserSettings settings = m_args.count(g_argOptimize) ? OptimiserSettings::standard() : OptimiserSettings::minimal();
-		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
-		if (m_args.count(g_strNoOptimizeYul))
-			settings.runYulOptimiser = false;
-		if (m_args.count(g_strYulOptimizations))
-		{
-			if (!settings.runYulOptimiser)
-			{
-				serr() << "--" << g_strYulOptimizations << " is invalid if Yul optimizer is disabled" << endl;
-				return false;
-			}
-
-			try
-			{
-				yul::OptimiserSuite::validateSequence(m_args[g_strYulOptimizations].as<string>());
-			}
-			catch (yul::OptimizerException const& _exception)
-			{
-				serr() << "Invalid optimizer step sequence in --" << g_strYulOptimizations << ": " << _exception.what() << endl;
-				return false;
-			}
-
-			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
-		}
-		settings.optimizeStackAllocation = settings.runYulOptimiser;
-		m_compiler->setOptimiserSettings(settings);
+		optional<OptimiserSettings> settings = optimiserSettings(
+			m_args.count(g_argOptimize),
+			m_args[g_argOptimizeRuns].as<unsigned>()
+		);
+		if (!settings)
+			return false;
+		m_compiler->setOptimiserSettings(*settings);
+		if (m_args.count(g_argTarget) && !parseTargets())
+			return false;
 
-		if (m_args.count(g_argImportAst))
+		if (m_args.count(g_argImportAst) || m_args.count(g_argImportAstBinary))
 		{
 			try
 			{
-				m_compiler->importASTs(parseAstFromInput());
+				m_compiler->importASTs(parseAstFromInput(m_args.count(g_argImportAstBinary)));
 
 				if (!m_compiler->analyze())
 				{
@@ -1586,7 +2058,8 @@ bool CommandLineInterface::processInput()
 
 		if (!successful)
 		{
-			if (m_args.count(g_argErrorRecovery))
+			// In watch mode, the next change is awaited even if the first compilation fails.
+			if (m_args.count(g_argErrorRecovery) || m_args.count(g_argWatch))
 				return true;
 			else
 				return false;
@@ -1770,46 +2243,247 @@ void CommandLineInterface::handleAst()
 	}
 }
 
+void CommandLineInterface::handleAstBinary()
+{
+	if (!m_args.count(g_argAstBinary))
+		return;
+
+	Json::Value output(Json::objectValue);
+	output[g_strSources] = Json::Value(Json::objectValue);
+	for (auto const& sourceCode: m_sourceCodes)
+	{
+		ASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
+		output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
+		output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+	}
+	createFile("combined.astb", jsonBinaryPrint(removeNullMembers(std::move(output))), true);
+}
+
+void CommandLineInterface::handleArtifactBundle()
+{
+	if (!m_args.count(g_argArtifactBundle))
+		return;
+
+	bytes bundle = ArtifactBundle::fromCompilerStack(*m_compiler).serialise();
+	createFile("combined.bundle", string(bundle.begin(), bundle.end()), true);
+}
+
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
-		// Already done in "processInput" phase.
-		return true;
-	else if (m_onlyLink)
+	if (m_onlyLink)
 		writeLinkedFiles();
-	else
+	else if (
+		!m_args.count(g_argStandardJSON) &&
+		!m_args.count(g_argStandardJSONBatch) &&
+		!m_args.count(g_argServer) &&
+		!m_onlyAssemble
+	)
+	{
+		// Standard JSON, server and assembly mode are already done in "processInput" phase.
 		outputCompilationResults();
+		if (!m_targets.empty() && m_compiler->compilationSuccessful())
+			compileTargets();
+	}
+
+	if (m_args.count(g_argTimePasses))
+		serr() << endl << "Compiler phase timings:" << endl << Profiler::instance().toString();
+	if (m_args.count(g_argTraceOut))
+	{
+		string const& traceFile = m_args[g_argTraceOut].as<string>();
+		ofstream outFile(traceFile);
+		outFile << jsonCompactPrint(Profiler::instance().traceToJson());
+		if (!outFile)
+		{
+			serr() << "Could not write to file " << traceFile << "." << endl;
+			m_error = true;
+		}
+	}
+	if (m_args.count(g_strOptimizerProfile))
+	{
+		serr() << endl << "Yul optimizer steps:" << endl << yul::OptimiserStepProfiler::instance().toString();
+		serr() << endl << "Simplification rules:" << endl << yul::OptimiserStepProfiler::instance().rulesToString();
+	}
+	if (m_args.count(g_argModelCheckerShowStats) && m_compiler)
+		serr() << endl << "SMTChecker statistics:" << endl << m_compiler->modelCheckerStatistics().toString();
+
+	if (m_args.count(g_argWatch))
+		watch();
+
 	return !m_error;
 }
 
+void CommandLineInterface::compileTargets()
+{
+	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
+	for (auto& [name, settings]: m_targets)
+	{
+		m_outputSubdirectory = name;
+		try
+		{
+			m_compiler->setBackendSettings(move(settings));
+			// The errors and warnings of the analysis were already printed.
+			size_t const analysisErrorCount = m_compiler->errors().size();
+			bool successful = m_compiler->compile();
+			for (size_t i = analysisErrorCount; i < m_compiler->errors().size(); ++i)
+			{
+				g_hasOutput = true;
+				formatter.printErrorInformation(*m_compiler->errors()[i]);
+			}
+			if (successful)
+				outputCompilationResults();
+			else
+			{
+				serr() << "Compilation for --" << g_argTarget << " " << name << " failed." << endl;
+				m_error = true;
+			}
+		}
+		catch (CompilerError const& _exception)
+		{
+			formatter.printExceptionInformation(_exception, "Compiler error");
+			m_error = true;
+		}
+		catch (Error const& _error)
+		{
+			formatter.printExceptionInformation(_error, _error.typeName());
+			m_error = true;
+		}
+		catch (Exception const& _exception)
+		{
+			serr() << "Exception during compilation: " << boost::diagnostic_information(_exception) << endl;
+			m_error = true;
+		}
+		catch (std::exception const& _e)
+		{
+			serr() << "Unknown exception during compilation" << (
+				_e.what() ? ": " + string(_e.what()) : "."
+			) << endl;
+			m_error = true;
+		}
+	}
+	m_outputSubdirectory.clear();
+}
+
+map<string, pair<time_t, uintmax_t>> CommandLineInterface::sourceFileStates() const
+{
+	map<string, pair<time_t, uintmax_t>> states;
+	for (auto const& [path, content]: m_sourceCodes)
+	{
+		boost::system::error_code error;
+		time_t modificationTime = boost::filesystem::last_write_time(path, error);
+		uintmax_t size = error ? 0 : boost::filesystem::file_size(path, error);
+		// Missing files are recorded as well, so that their creation is noticed.
+		states[path] = error ? make_pair(time_t(0), uintmax_t(0)) : make_pair(modificationTime, size);
+	}
+	return states;
+}
+
+void CommandLineInterface::watch()
+{
+	// Files are polled instead of being watched using the notification mechanism of the
+	// operating system, which is different on each platform.
+	map<string, pair<time_t, uintmax_t>> states = sourceFileStates();
+	serr() << endl << "Watching " << states.size() << " files for changes." << endl;
+	while (true)
+	{
+		this_thread::sleep_for(g_watchInterval);
+		map<string, pair<time_t, uintmax_t>> newStates = sourceFileStates();
+		if (newStates == states)
+			continue;
+		states = move(newStates);
+		recompile();
+		// Files imported for the first time are only watched from now on.
+		for (auto&& [path, state]: sourceFileStates())
+			states.emplace(path, state);
+		serr() << endl << "Watching " << states.size() << " files for changes." << endl;
+	}
+}
+
+void CommandLineInterface::recompile()
+{
+	StringMap inputSources;
+	for (string const& path: m_inputFileNames)
+		if (boost::filesystem::is_regular_file(path))
+			inputSources[path] = m_sourceCodes[path] = readFileAsString(path);
+		else
+			m_sourceCodes.erase(path);
+
+	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
+	g_hasOutput = false;
+	m_error = false;
+	try
+	{
+		// The sources read through the file reader are read again by the compiler stack.
+		if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
+			m_compiler->updateSources(move(inputSources));
+		else
+		{
+			m_compiler->reset(true);
+			m_compiler->setSources(move(inputSources));
+		}
+		m_compiler->compile(m_stopAfter);
+
+		for (auto const& error: m_compiler->errors())
+		{
+			g_hasOutput = true;
+			formatter.printErrorInformation(*error);
+		}
+		outputCompilationResults();
+	}
+	catch (CompilerError const& _exception)
+	{
+		formatter.printExceptionInformation(_exception, "Compiler error");
+	}
+	catch (Error const& _error)
+	{
+		formatter.printExceptionInformation(_error, _error.typeName());
+	}
+	catch (Exception const& _exception)
+	{
+		serr() << "Exception during compilation: " << boost::diagnostic_information(_exception) << endl;
+	}
+	catch (std::exception const& _e)
+	{
+		serr() << "Unknown exception during compilation" << (
+			_e.what() ? ": " + string(_e.what()) : "."
+		) << endl;
+	}
+}
+
 bool CommandLineInterface::link()
 {
-	// Map from how the libraries will be named inside the bytecode to their addresses.
-	map<string, h160> librariesReplacements;
+	// Map from how the libraries will be named inside the bytecode to the hex representation
+	// of their addresses. The addresses are converted only once per library.
+	unordered_map<string, string> librariesReplacements;
+	// Hints for the resolved libraries, which are removed from the files.
+	vector<string> resolvedHints;
 	int const placeholderSize = 40; // 20 bytes or 40 hex characters
 	for (auto const& library: m_libraries)
 	{
 		string const& name = library.first;
+		string address = toHex(library.second.asBytes());
 		// Library placeholders are 40 hex digits (20 bytes) that start and end with '__'.
 		// This leaves 36 characters for the library identifier. The identifier used to
 		// be just the cropped or '_'-padded library name, but this changed to
 		// the cropped hex representation of the hash of the library name.
 		// We support both ways of linking here.
-		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = library.second;
+		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = address;
 
 		string replacement = "__";
 		for (size_t i = 0; i < placeholderSize - 4; ++i)
 			replacement.push_back(i < name.size() ? name[i] : '_');
 		replacement += "__";
-		librariesReplacements[replacement] = library.second;
+		librariesReplacements[replacement] = move(address);
+		resolvedHints.emplace_back(libraryPlaceholderHint(name));
 	}
+	unordered_set<string_view> resolvedHintLines(resolvedHints.begin(), resolvedHints.end());
+
+	string foundPlaceholder;
 	for (auto& src: m_sourceCodes)
 	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		string& code = src.second;
+		auto end = code.end();
+		for (auto it = find(code.begin(), end, '_'); it != end; it = find(it, end, '_'))
 		{
-			while (it != end && *it != '_') ++it;
-			if (it == end) break;
 			if (
 				end - it < placeholderSize ||
 				*(it + 1) != '_' ||
@@ -1817,26 +2491,42 @@ bool CommandLineInterface::link()
 				*(it + placeholderSize - 1) != '_'
 			)
 			{
-				serr() << "Error in binary object file " << src.first << " at position " << (it - src.second.begin()) << endl;
+				serr() << "Error in binary object file " << src.first << " at position " << (it - code.begin()) << endl;
 				serr() << '"' << string(it, it + min(placeholderSize, static_cast<int>(end - it))) << "\" is not a valid link reference." << endl;
 				return false;
 			}
 
-			string foundPlaceholder(it, it + placeholderSize);
-			if (librariesReplacements.count(foundPlaceholder))
-			{
-				string hexStr(toHex(librariesReplacements.at(foundPlaceholder).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
-			}
+			// The placeholder is patched in place in the loaded file.
+			foundPlaceholder.assign(it, it + placeholderSize);
+			if (auto replacement = librariesReplacements.find(foundPlaceholder); replacement != librariesReplacements.end())
+				copy(replacement->second.begin(), replacement->second.end(), it);
 			else
 				serr() << "Reference \"" << foundPlaceholder << "\" in file \"" << src.first << "\" still unresolved." << endl;
 			it += placeholderSize;
 		}
-		// Remove hints for resolved libraries.
-		for (auto const& library: m_libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+
+		// Remove hints for resolved libraries. They are on lines of their own after the bytecode,
+		// so the file is compacted in a single pass over its lines.
+		if (!resolvedHintLines.empty())
+		{
+			size_t lineBreak = code.find('\n');
+			size_t kept = lineBreak == string::npos ? code.size() : lineBreak;
+			while (lineBreak != string::npos)
+			{
+				size_t nextLineBreak = code.find('\n', lineBreak + 1);
+				size_t lineEnd = nextLineBreak == string::npos ? code.size() : nextLineBreak;
+				string_view line(code.data() + lineBreak + 1, lineEnd - lineBreak - 1);
+				if (!resolvedHintLines.count(line))
+				{
+					copy(code.begin() + ptrdiff_t(lineBreak), code.begin() + ptrdiff_t(lineEnd), code.begin() + ptrdiff_t(kept));
+					kept += lineEnd - lineBreak;
+				}
+				lineBreak = nextLineBreak;
+			}
+			code.resize(kept);
+		}
+		while (!code.empty() && code.back() == '\n')
+			code.pop_back();
 	}
 	return true;
 }
@@ -1894,6 +2584,8 @@ bool CommandLineInterface::assemble(
 			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
 
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
+		if (m_args.count(g_argJobs))
+			stack.setParallelism(m_args[g_argJobs].as<unsigned>());
 		try
 		{
 			if (!stack.parseAndAnalyze(src.first, src.second))
@@ -2028,6 +2720,7 @@ void CommandLineInterface::outputCompilationResults()
 
 	// do we need AST output?
 	handleAst();
+	handleAstBinary();
 
 	if (
 		!m_compiler->compilationSuccessful() &&
@@ -2047,24 +2740,31 @@ void CommandLineInterface::outputCompilationResults()
 		// do we need EVM assembly?
 		if (m_args.count(g_argAsm) || m_args.count(g_argAsmJson))
 		{
-			string ret;
-			if (m_args.count(g_argAsmJson))
-				ret = jsonPrettyPrint(removeNullMembers(m_compiler->assemblyJSON(contract)));
-			else
-				ret = m_compiler->assemblyString(contract, m_sourceCodes);
-
 			if (m_args.count(g_argOutputDir))
 			{
+				string ret;
+				if (m_args.count(g_argAsmJson))
+					ret = jsonPrettyPrint(removeNullMembers(m_compiler->assemblyJSON(contract)));
+				else
+					ret = m_compiler->assemblyString(contract, m_sourceCodes);
 				createFile(m_compiler->filesystemFriendlyName(contract) + (m_args.count(g_argAsmJson) ? "_evm.json" : ".evm"), ret);
 			}
 			else
 			{
-				sout() << "EVM assembly:" << endl << ret << endl;
+				sout() << "EVM assembly:" << endl;
+				if (m_args.count(g_argAsmJson))
+					sout() << jsonPrettyPrint(removeNullMembers(m_compiler->assemblyJSON(contract)));
+				else
+					// Large assemblies are written directly instead of being rendered into a string first.
+					m_compiler->assemblyStream(sout(), contract, m_sourceCodes);
+				sout() << endl;
 			}
 		}
 
 		if (m_args.count(g_argGas))
 			handleGasEstimation(contract);
+		if (m_args.count(g_argSizeReport))
+			handleSizeReport(contract);
 
 		handleBytecode(contract);
 		handleIR(contract);
@@ -2078,6 +2778,8 @@ void CommandLineInterface::outputCompilationResults()
 		handleNatspec(false, contract);
 	} // end of contracts iteration
 
+	handleArtifactBundle();
+
 	if (!g_hasOutput)
 	{
 		if (m_args.count(g_argOutputDir))
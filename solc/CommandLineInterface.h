@@ -30,13 +30,16 @@
 #include <boost/program_options.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include <ctime>
 #include <memory>
+#include <set>
 
 namespace solidity::frontend
 {
 
 //forward declaration
 enum class DocumentationType: uint8_t;
+class StandardCompiler;
 
 class CommandLineInterface
 {
@@ -66,8 +69,32 @@ private:
 
 	void outputCompilationResults();
 
+	/// @returns the optimiser settings selected by the optimiser options, with the optimiser
+	/// enabled if @a _optimize is set, or nullopt after printing an error if they are invalid.
+	std::optional<OptimiserSettings> optimiserSettings(bool _optimize, unsigned _runs);
+	/// Parses the backend settings given by --target into @a m_targets.
+	/// @returns false after printing an error if they are invalid.
+	bool parseTargets();
+	/// Compiles the analysed sources again with the backend settings of each entry of @a m_targets
+	/// and writes the output to the subdirectory of the output directory named by the entry.
+	void compileTargets();
+
+	/// @returns the modification time and size of each file in @a m_sourceCodes, or zero for both
+	/// if the file does not exist.
+	std::map<std::string, std::pair<std::time_t, std::uintmax_t>> sourceFileStates() const;
+	/// Compiles again and writes the output whenever one of the files in @a m_sourceCodes changes.
+	/// Does not return.
+	void watch();
+	/// Reads the input files again and compiles them using the existing compiler stack, which only
+	/// analyses the changed sources and the sources importing them again.
+	void recompile();
+
 	void handleCombinedJSON();
 	void handleAst();
+	/// Writes the ASTs of all sources to a single file in the format read by --import-ast-binary.
+	void handleAstBinary();
+	/// Writes the artifacts of all contracts to a single file in the format of ArtifactBundle.
+	void handleArtifactBundle();
 	void handleBinary(std::string const& _contract);
 	void handleOpcode(std::string const& _contract);
 	void handleIR(std::string const& _contract);
@@ -79,10 +106,15 @@ private:
 	void handleABI(std::string const& _contract);
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
+	void handleSizeReport(std::string const& _contract);
 	void handleStorageLayout(std::string const& _contract);
 
 	/// Fills @a m_sourceCodes initially and @a m_redirects.
 	bool readInputFilesAndConfigureRemappings();
+	/// Compiles each of the Standard JSON inputs in the JSON array @a _input and writes the array of
+	/// their outputs to standard output.
+	/// @returns false if @a _input is not a JSON array.
+	bool compileStandardJsonBatch(StandardCompiler& _compiler, std::string const& _input);
 	/// Tries to read from the file @a _input or interprets _input literally if that fails.
 	/// It then tries to parse the contents and appends to m_libraries.
 	bool parseLibraryOption(std::string const& _input);
@@ -90,13 +122,14 @@ private:
 	/// Tries to read @ m_sourceCodes as a JSONs holding ASTs
 	/// such that they can be imported into the compiler  (importASTs())
 	/// (produced by --combined-json ast,compact-format <file.sol>
-	/// or standard-json output
-	std::map<std::string, Json::Value> parseAstFromInput();
+	/// or standard-json output, or in the binary format produced by --ast-binary if @a _binary is set.
+	std::map<std::string, Json::Value> parseAstFromInput(bool _binary = false);
 
 	/// Create a file in the given directory
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
-	void createFile(std::string const& _fileName, std::string const& _data);
+	/// @arg _binary whether to write @a _data without newline conversion
+	void createFile(std::string const& _fileName, std::string const& _data, bool _binary = false);
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
@@ -116,6 +149,14 @@ private:
 	boost::program_options::variables_map m_args;
 	/// map of input files to source code strings
 	std::map<std::string, std::string> m_sourceCodes;
+	/// names of the files given on the command line, a subset of the keys of @a m_sourceCodes
+	std::set<std::string> m_inputFileNames;
+	/// files written to the output directory in watch mode, which later compilations may overwrite
+	std::set<std::string> m_createdFiles;
+	/// backend settings given by --target with the names of the subdirectories their output is written to
+	std::vector<std::pair<std::string, frontend::CompilerStack::BackendSettings>> m_targets;
+	/// subdirectory of the output directory the files are currently written to
+	std::string m_outputSubdirectory;
 	/// list of remappings
 	std::vector<frontend::CompilerStack::Remapping> m_remappings;
 	/// list of allowed directories to read files from
@@ -105,7 +105,8 @@ CommonOptions::CommonOptions(std::string _caption):
 		("enforce-via-yul", po::bool_switch(&enforceViaYul), "Enforce compiling all tests via yul to see if additional tests can be activated.")
 		("abiencoderv1", po::bool_switch(&useABIEncoderV1), "enables abi encoder v1")
 		("show-messages", po::bool_switch(&showMessages), "enables message output")
-		("show-metadata", po::bool_switch(&showMetadata), "enables metadata output");
+		("show-metadata", po::bool_switch(&showMetadata), "enables metadata output")
+		("gas-profile", po::value<fs::path>(&gasProfile), "appends the gas used by the executed contracts per source location and internal call stack to the given file, as folded stacks for flame graphs. Requires a VM that supports instruction tracing.");
 }
 
 void CommonOptions::validate() const
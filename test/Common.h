@@ -60,6 +60,8 @@ struct CommonOptions: boost::noncopyable
 	bool useABIEncoderV1 = false;
 	bool showMessages = false;
 	bool showMetadata = false;
+	/// File the gas profile of the executed contracts is appended to, if not empty.
+	boost::filesystem::path gasProfile;
 
 	langutil::EVMVersion evmVersion() const;
 
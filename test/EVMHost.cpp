@@ -30,6 +30,7 @@
 #include <libsolutil/Assertions.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/picosha2.h>
+#include <libsolutil/Visitor.h>
 
 using namespace std;
 using namespace solidity;
@@ -138,6 +139,8 @@ void EVMHost::reset()
 {
 	accounts.clear();
 	m_currentAddress = {};
+	m_journal.clear();
+	m_snapshots.clear();
 
 	// Mark all precompiled contracts as existing. Existing here means to have a balance (as per EIP-161).
 	// NOTE: keep this in sync with `EVMHost::call` below.
@@ -156,12 +159,92 @@ void EVMHost::reset()
 	}
 }
 
+size_t EVMHost::snapshot()
+{
+	m_snapshots.push_back({m_journal.size(), recorded_logs, tx_context});
+	return m_snapshots.size() - 1;
+}
+
+void EVMHost::revertToSnapshot(size_t _snapshot)
+{
+	assertThrow(_snapshot < m_snapshots.size(), Exception, "Invalid snapshot.");
+	m_snapshots.resize(_snapshot + 1);
+	Snapshot const& snapshot = m_snapshots.back();
+	revertJournal(snapshot.journalSize);
+	recorded_logs = snapshot.logs;
+	tx_context = snapshot.txContext;
+}
+
+evmc_storage_status EVMHost::set_storage(
+	evmc::address const& _addr,
+	evmc::bytes32 const& _key,
+	evmc::bytes32 const& _value
+) noexcept
+{
+	if (auto account = accounts.find(_addr); account != accounts.end())
+	{
+		auto const& storage = account->second.storage;
+		auto slot = storage.find(_key);
+		m_journal.emplace_back(StorageModified{
+			_addr,
+			_key,
+			slot == storage.end() ? nullopt : make_optional(slot->second)
+		});
+	}
+	return MockedHost::set_storage(_addr, _key, _value);
+}
+
 void EVMHost::selfdestruct(const evmc::address& _addr, const evmc::address& _beneficiary) noexcept
 {
 	// TODO actual selfdestruct is even more complicated.
-	evmc::uint256be balance = accounts[_addr].balance;
+	evmc::uint256be balance = account(_addr).balance;
+	m_journal.emplace_back(AccountDeleted{_addr, move(accounts[_addr])});
 	accounts.erase(_addr);
-	accounts[_beneficiary].balance = balance;
+	modifyAccount(_beneficiary).balance = balance;
+}
+
+evmc::MockedAccount& EVMHost::account(evmc::address const& _address)
+{
+	auto [account, inserted] = accounts.try_emplace(_address);
+	if (inserted)
+		m_journal.emplace_back(AccountCreated{_address});
+	return account->second;
+}
+
+evmc::MockedAccount& EVMHost::modifyAccount(evmc::address const& _address)
+{
+	evmc::MockedAccount& modified = account(_address);
+	m_journal.emplace_back(AccountModified{
+		_address,
+		modified.nonce,
+		modified.code,
+		modified.codehash,
+		modified.balance
+	});
+	return modified;
+}
+
+void EVMHost::revertJournal(size_t _journalSize)
+{
+	for (; m_journal.size() > _journalSize; m_journal.pop_back())
+		std::visit(GenericVisitor{
+			[&](AccountCreated const& _entry) { accounts.erase(_entry.address); },
+			[&](AccountModified& _entry) {
+				evmc::MockedAccount& account = accounts[_entry.address];
+				account.nonce = _entry.nonce;
+				account.code = move(_entry.code);
+				account.codehash = _entry.codehash;
+				account.balance = _entry.balance;
+			},
+			[&](AccountDeleted& _entry) { accounts[_entry.address] = move(_entry.account); },
+			[&](StorageModified const& _entry) {
+				auto& storage = accounts[_entry.address].storage;
+				if (_entry.value)
+					storage[_entry.key] = *_entry.value;
+				else
+					storage.erase(_entry.key);
+			}
+		}, m_journal.back());
 }
 
 evmc::result EVMHost::call(evmc_message const& _message) noexcept
@@ -183,10 +266,11 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	else if (_message.destination == 0x0000000000000000000000000000000000000008_address && m_evmVersion >= langutil::EVMVersion::byzantium())
 		return precompileALTBN128PairingProduct(_message);
 
-	auto const stateBackup = accounts;
+	// Modifications are journaled, so that they can be undone if the call fails.
+	size_t const journalSize = m_journal.size();
 
 	u256 value{convertFromEVMC(_message.value)};
-	auto& sender = accounts[_message.sender];
+	auto& sender = account(_message.sender);
 
 	evmc::bytes code;
 
@@ -200,7 +284,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertJournal(journalSize);
 			return result;
 		}
 	}
@@ -209,6 +293,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	{
 		// TODO this is not the right formula
 		// TODO is the nonce incremented on failure, too?
+		modifyAccount(_message.sender);
 		h160 createAddress(keccak256(
 			bytes(begin(message.sender.bytes), end(message.sender.bytes)) +
 			asBytes(to_string(sender.nonce++))
@@ -232,7 +317,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertJournal(journalSize);
 			return result;
 		}
 
@@ -240,21 +325,23 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 	else if (message.kind == EVMC_DELEGATECALL)
 	{
-		code = accounts[message.destination].code;
+		code = account(message.destination).code;
 		message.destination = m_currentAddress;
 	}
 	else if (message.kind == EVMC_CALLCODE)
 	{
-		code = accounts[message.destination].code;
+		code = account(message.destination).code;
 		message.destination = m_currentAddress;
 	}
 	else
-		code = accounts[message.destination].code;
+		code = account(message.destination).code;
 
-	auto& destination = accounts[message.destination];
+	auto& destination = account(message.destination);
 
 	if (value != 0 && message.kind != EVMC_DELEGATECALL && message.kind != EVMC_CALLCODE)
 	{
+		modifyAccount(_message.sender);
+		modifyAccount(message.destination);
 		sender.balance = convertToEVMC(u256(convertFromEVMC(sender.balance)) - value);
 		destination.balance = convertToEVMC(u256(convertFromEVMC(destination.balance)) + value);
 	}
@@ -276,13 +363,17 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		else
 		{
 			result.create_address = message.destination;
-			destination.code = evmc::bytes(result.output_data, result.output_data + result.output_size);
-			destination.codehash = convertToEVMC(keccak256({result.output_data, result.output_size}));
+			auto& created = modifyAccount(message.destination);
+			created.code = evmc::bytes(result.output_data, result.output_data + result.output_size);
+			created.codehash = convertToEVMC(keccak256({result.output_data, result.output_size}));
 		}
 	}
 
 	if (result.status_code != EVMC_SUCCESS)
-		accounts = stateBackup;
+		revertJournal(journalSize);
+	else if (message.depth == 0 && m_snapshots.empty())
+		// Nothing can be reverted any more.
+		m_journal.clear();
 
 	return result;
 }
@@ -32,6 +32,9 @@
 
 #include <boost/filesystem.hpp>
 
+#include <optional>
+#include <variant>
+
 namespace solidity::test
 {
 using Address = util::h160;
@@ -55,6 +58,15 @@ public:
 	explicit EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm);
 
 	void reset();
+	/// Records the current state of the accounts, the recorded logs and the block context.
+	/// Modifications done through the host interface afterwards are journaled, so that
+	/// reverting to the snapshot does not need to copy the whole state.
+	/// Direct modifications of @a accounts are not journaled.
+	/// @returns an identifier of the snapshot to be passed to @a revertToSnapshot.
+	size_t snapshot();
+	/// Restores the state recorded by @a _snapshot, which remains valid, and discards
+	/// all snapshots taken after it.
+	void revertToSnapshot(size_t _snapshot);
 	void newBlock()
 	{
 		tx_context.block_number++;
@@ -67,6 +79,12 @@ public:
 		return evmc::MockedHost::account_exists(_addr);
 	}
 
+	evmc_storage_status set_storage(
+		evmc::address const& _addr,
+		evmc::bytes32 const& _key,
+		evmc::bytes32 const& _value
+	) noexcept final;
+
 	void selfdestruct(evmc::address const& _addr, evmc::address const& _beneficiary) noexcept final;
 
 	evmc::result call(evmc_message const& _message) noexcept final;
@@ -84,8 +102,53 @@ public:
 		return m_vm.has_capability(capability);
 	}
 
+	/// Lets the VM write a trace of the executed instructions in the format of EIP-3155 to
+	/// std::clog, which newer versions of evmone support. Tracing cannot be disabled again
+	/// and affects all hosts using the same VM.
+	/// @returns false if the VM does not support tracing.
+	bool enableTracing() noexcept
+	{
+		return m_vm.set_option("trace", "1") == EVMC_SET_OPTION_SUCCESS;
+	}
+
 private:
+	/// Journal entries, each undoing a single modification of @a accounts.
+	struct AccountCreated { evmc::address address; };
+	struct AccountModified
+	{
+		evmc::address address;
+		int nonce;
+		evmc::bytes code;
+		evmc::bytes32 codehash;
+		evmc::uint256be balance;
+	};
+	struct AccountDeleted { evmc::address address; evmc::MockedAccount account; };
+	struct StorageModified
+	{
+		evmc::address address;
+		evmc::bytes32 key;
+		std::optional<evmc::storage_value> value;
+	};
+	using JournalEntry = std::variant<AccountCreated, AccountModified, AccountDeleted, StorageModified>;
+
+	struct Snapshot
+	{
+		size_t journalSize;
+		std::vector<log_record> logs;
+		evmc_tx_context txContext;
+	};
+
+	/// @returns the account at @a _address, creating (and journaling the creation of) it if needed.
+	evmc::MockedAccount& account(evmc::address const& _address);
+	/// Journals all fields of the account at @a _address apart from its storage.
+	/// @returns the account, see @a account.
+	evmc::MockedAccount& modifyAccount(evmc::address const& _address);
+	/// Undoes all journaled modifications after the first @a _journalSize ones.
+	void revertJournal(size_t _journalSize);
+
 	evmc::address m_currentAddress = {};
+	std::vector<JournalEntry> m_journal;
+	std::vector<Snapshot> m_snapshots;
 
 	static evmc::result precompileECRecover(evmc_message const& _message) noexcept;
 	static evmc::result precompileSha256(evmc_message const& _message) noexcept;
@@ -36,6 +36,8 @@
 #include <boost/algorithm/string/replace.hpp>
 
 #include <cstdlib>
+#include <fstream>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -63,6 +65,12 @@ ExecutionFramework::ExecutionFramework(langutil::EVMVersion _evmVersion, vector<
 	selectVM(evmc_capabilities::EVMC_CAPABILITY_EVM1);
 }
 
+ExecutionFramework::~ExecutionFramework()
+{
+	if (m_gasProfiler)
+		ofstream(solidity::test::CommonOptions::get().gasProfile.string(), ios::app) << m_gasProfiler->folded();
+}
+
 void ExecutionFramework::selectVM(evmc_capabilities _cap)
 {
 	m_evmcHost.reset();
@@ -76,6 +84,18 @@ void ExecutionFramework::selectVM(evmc_capabilities _cap)
 		}
 	}
 	solAssert(m_evmcHost != nullptr, "");
+	if (!solidity::test::CommonOptions::get().gasProfile.empty() && !m_gasProfiler)
+	{
+		if (m_evmcHost->enableTracing())
+			m_gasProfiler = make_unique<GasProfiler>();
+		else
+		{
+			static bool warned = false;
+			if (!warned)
+				cerr << "The VM does not support instruction tracing. No gas profile is generated." << endl;
+			warned = true;
+		}
+	}
 	reset();
 }
 
@@ -85,6 +105,22 @@ void ExecutionFramework::reset()
 	for (size_t i = 0; i < 10; i++)
 		m_evmcHost->accounts[EVMHost::convertToEVMC(account(i))].balance =
 			EVMHost::convertToEVMC(u256(1) << 100);
+	m_snapshotContractAddresses.clear();
+}
+
+size_t ExecutionFramework::snapshot()
+{
+	size_t snapshot = m_evmcHost->snapshot();
+	m_snapshotContractAddresses.resize(snapshot);
+	m_snapshotContractAddresses.push_back(m_contractAddress);
+	return snapshot;
+}
+
+void ExecutionFramework::revertToSnapshot(size_t _snapshot)
+{
+	m_evmcHost->revertToSnapshot(_snapshot);
+	m_snapshotContractAddresses.resize(_snapshot + 1);
+	m_contractAddress = m_snapshotContractAddresses.back();
 }
 
 std::pair<bool, string> ExecutionFramework::compareAndCreateMessage(
@@ -178,7 +214,19 @@ void ExecutionFramework::sendMessage(bytes const& _data, bool _isCreation, u256
 	}
 	message.gas = m_gas.convert_to<int64_t>();
 
+	// The VM writes the trace to std::clog once tracing is enabled.
+	ostringstream trace;
+	streambuf* clogBuffer = m_gasProfiler ? clog.rdbuf(trace.rdbuf()) : nullptr;
 	evmc::result result = m_evmcHost->call(message);
+	if (m_gasProfiler)
+	{
+		clog.rdbuf(clogBuffer);
+		if (!_isCreation)
+		{
+			evmc::bytes const& code = m_evmcHost->accounts[message.destination].code;
+			m_gasProfiler->addTrace(bytes(code.begin(), code.end()), GasProfiler::parseTrace(trace.str()));
+		}
+	}
 
 	m_output = bytes(result.output_data, result.output_data + result.output_size);
 	if (_isCreation)
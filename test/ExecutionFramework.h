@@ -25,6 +25,7 @@
 
 #include <test/Common.h>
 #include <test/EVMHost.h>
+#include <test/GasProfiler.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/DebugSettings.h>
@@ -53,7 +54,7 @@ class ExecutionFramework
 public:
 	ExecutionFramework();
 	ExecutionFramework(langutil::EVMVersion _evmVersion, std::vector<boost::filesystem::path> const& _vmPaths);
-	virtual ~ExecutionFramework() = default;
+	virtual ~ExecutionFramework();
 
 	virtual bytes const& compileAndRunWithoutCheck(
 		std::map<std::string, std::string> const& _sourceCode,
@@ -258,6 +259,11 @@ private:
 protected:
 	void selectVM(evmc_capabilities _cap = evmc_capabilities::EVMC_CAPABILITY_EVM1);
 	void reset();
+	/// Records the state of the blockchain, e.g. to reuse deployed contracts across calls.
+	/// @returns an identifier of the snapshot to be passed to @a revertToSnapshot.
+	size_t snapshot();
+	/// Restores the state of the blockchain and the current contract recorded by @a _snapshot.
+	void revertToSnapshot(size_t _snapshot);
 
 	void sendMessage(bytes const& _data, bool _isCreation, u256 const& _value = 0);
 	void sendEther(util::h160 const& _to, u256 const& _value);
@@ -283,6 +289,9 @@ protected:
 	bool m_showMessages = false;
 	bool m_supportsEwasm = false;
 	std::unique_ptr<EVMHost> m_evmcHost;
+	/// Gas profile of the calls to contracts, if requested by CommonOptions::gasProfile
+	/// and supported by the VM.
+	std::unique_ptr<GasProfiler> m_gasProfiler;
 
 	std::vector<boost::filesystem::path> m_vmPaths;
 
@@ -293,6 +302,8 @@ protected:
 	u256 const m_gas = 100000000;
 	bytes m_output;
 	u256 m_gasUsed;
+	/// Contract addresses at the time of each snapshot of the host.
+	std::vector<util::h160> m_snapshotContractAddresses;
 };
 
 #define ABI_CHECK(result, expectation) do { \
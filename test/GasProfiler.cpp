@@ -0,0 +1,201 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <test/GasProfiler.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/split.hpp>
+
+#include <optional>
+#include <sstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::test;
+
+namespace
+{
+
+/// @returns the value of a numeric field of an EIP-3155 trace, which is either a number
+/// or a hex string.
+int64_t traceNumber(Json::Value const& _value)
+{
+	if (_value.isString())
+		return static_cast<int64_t>(stoull(_value.asString(), nullptr, 16));
+	return _value.asInt64();
+}
+
+/// @returns the frame name of the source range starting at @a _start in @a _source.
+string locationName(shared_ptr<CharStream const> const& _source, int _start)
+{
+	if (!_source)
+		return "<generated>";
+	auto [line, column] = _source->translatePositionToLineColumn(_start);
+	// Semicolons separate the frames of folded stacks.
+	return boost::replace_all_copy(_source->name(), ";", ",") + ":" + to_string(line + 1) + ":" + to_string(column + 1);
+}
+
+}
+
+vector<TraceStep> GasProfiler::parseTrace(string const& _trace)
+{
+	vector<TraceStep> steps;
+	istringstream lines(_trace);
+	string line;
+	while (getline(lines, line))
+	{
+		Json::Value step;
+		if (!jsonParseStrict(line, step) || !step.isObject() || !step.isMember("pc") || !step.isMember("gas"))
+			continue;
+		steps.push_back({
+			static_cast<size_t>(traceNumber(step["pc"])),
+			static_cast<uint8_t>(traceNumber(step["op"])),
+			traceNumber(step["gas"]),
+			step.isMember("gasCost") ? traceNumber(step["gasCost"]) : 0,
+			step.isMember("depth") ? static_cast<unsigned>(traceNumber(step["depth"])) : 1u
+		});
+	}
+	return steps;
+}
+
+void GasProfiler::addCode(
+	string _name,
+	bytes _code,
+	string const& _sourceMapping,
+	vector<shared_ptr<CharStream const>> _sources,
+	vector<size_t> _immutableOffsets
+)
+{
+	for (Code const& code: m_codes)
+		if (code.name == _name && code.code == _code)
+			return;
+	Code code{move(_name), move(_code), move(_immutableOffsets), {}};
+
+	// Fields of the current entry of the compressed source mapping, which are inherited
+	// from the previous entry if they are empty.
+	int start = -1;
+	int sourceIndex = -1;
+	char jump = '-';
+	size_t pc = 0;
+	vector<string> entries;
+	boost::split(entries, _sourceMapping, boost::is_any_of(";"));
+	for (string const& entry: entries)
+	{
+		if (pc >= code.code.size())
+			break;
+		vector<string> fields;
+		boost::split(fields, entry, boost::is_any_of(":"));
+		if (fields.size() > 0 && !fields[0].empty())
+			start = stoi(fields[0]);
+		if (fields.size() > 2 && !fields[2].empty())
+			sourceIndex = stoi(fields[2]);
+		if (fields.size() > 3 && !fields[3].empty())
+			jump = fields[3][0];
+
+		shared_ptr<CharStream const> source;
+		if (sourceIndex >= 0 && static_cast<size_t>(sourceIndex) < _sources.size())
+			source = _sources[static_cast<size_t>(sourceIndex)];
+		code.instructions[pc] = {start >= 0 ? locationName(source, start) : "<generated>", jump};
+
+		uint8_t op = code.code[pc];
+		// PUSH1 to PUSH32 are followed by their data.
+		pc += 1 + (op >= 0x60 && op <= 0x7f ? size_t(op - 0x5f) : 0);
+	}
+	m_codes.emplace_back(move(code));
+}
+
+bool GasProfiler::addTrace(bytes const& _code, vector<TraceStep> const& _trace)
+{
+	Code const* code = findCode(_code);
+	if (!code)
+		return false;
+
+	vector<string> frames{code->name};
+	auto instruction = [&](TraceStep const& _step) -> Instruction const& {
+		static Instruction const unknown{"<unknown>", '-'};
+		auto it = code->instructions.find(_step.pc);
+		return it != code->instructions.end() ? it->second : unknown;
+	};
+	auto record = [&](TraceStep const& _step, int64_t _gas) {
+		string stack;
+		for (string const& frame: frames)
+			stack += frame + ";";
+		m_stacks[stack + instruction(_step).location] += static_cast<uint64_t>(max<int64_t>(_gas, 0));
+	};
+
+	optional<size_t> previous;
+	for (size_t i = 0; i < _trace.size(); ++i)
+	{
+		TraceStep const& step = _trace[i];
+		if (step.depth != 1)
+			continue;
+		if (previous)
+		{
+			TraceStep const& previousStep = _trace[*previous];
+			record(previousStep, previousStep.gas - step.gas);
+			// The frame of a function is named after the source range of its entry.
+			char jump = instruction(previousStep).jump;
+			if (jump == 'i')
+				frames.push_back(instruction(step).location);
+			else if (jump == 'o' && frames.size() > 1)
+				frames.pop_back();
+		}
+		previous = i;
+	}
+	// The last instruction ends the transaction and has no successor to compare the gas with.
+	if (previous)
+		record(_trace[*previous], _trace[*previous].gasCost);
+	return true;
+}
+
+map<string, uint64_t> GasProfiler::gasBySourceRange() const
+{
+	map<string, uint64_t> gas;
+	for (auto const& [stack, stackGas]: m_stacks)
+		gas[stack.substr(stack.rfind(';') + 1)] += stackGas;
+	return gas;
+}
+
+string GasProfiler::folded() const
+{
+	string result;
+	for (auto const& [stack, gas]: m_stacks)
+		result += stack + " " + to_string(gas) + "\n";
+	return result;
+}
+
+GasProfiler::Code const* GasProfiler::findCode(bytes const& _code) const
+{
+	for (Code const& code: m_codes)
+	{
+		if (code.code.size() != _code.size())
+			continue;
+		bytes masked = _code;
+		for (size_t offset: code.immutableOffsets)
+			for (size_t i = offset; i < offset + 32 && i < masked.size(); ++i)
+				masked[i] = code.code[i];
+		if (masked == code.code)
+			return &code;
+	}
+	return nullptr;
+}
@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Source-level gas profile of contract executions, computed from instruction traces
+ * and the source mappings of the deployed code.
+ */
+
+#pragma once
+
+#include <liblangutil/CharStream.h>
+
+#include <libsolutil/Common.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace solidity::test
+{
+
+/// A single executed instruction of an instruction trace in the format of EIP-3155.
+struct TraceStep
+{
+	size_t pc = 0;
+	uint8_t op = 0;
+	/// Gas left before executing the instruction.
+	int64_t gas = 0;
+	/// Gas cost of the instruction as reported by the VM.
+	int64_t gasCost = 0;
+	/// Call depth, starting at 1 for the code called by the transaction.
+	unsigned depth = 1;
+};
+
+/**
+ * Aggregates the gas used by the instructions of traced transactions per source range
+ * and call stack of internal functions.
+ *
+ * The gas of an instruction is the difference of the gas left before it and before the next
+ * instruction of the same call frame, so that it includes the dynamic costs and, for calls
+ * and creations, the gas used by the callee. Only the outermost call frame of a transaction
+ * is profiled. Internal function calls are recognised by the jump types of the source mapping,
+ * i.e. only for code generated by the legacy code generator.
+ *
+ * The results can be written as folded stacks ("frame;frame;leaf gas" per line), which are
+ * accepted by flamegraph.pl, inferno and speedscope.
+ */
+class GasProfiler
+{
+public:
+	/// Parses an EIP-3155 trace, i.e. one JSON object per line. Lines that do not describe an
+	/// executed instruction, like the summary at the end, are ignored.
+	static std::vector<TraceStep> parseTrace(std::string const& _trace);
+
+	/// Registers the deployed code @a _code under the name @a _name together with its source
+	/// mapping and the sources it refers to, indexed by source ID.
+	/// The 32 bytes at each of @a _immutableOffsets are not compared when looking up code,
+	/// since they are only filled in at deployment.
+	void addCode(
+		std::string _name,
+		bytes _code,
+		std::string const& _sourceMapping,
+		std::vector<std::shared_ptr<langutil::CharStream const>> _sources,
+		std::vector<size_t> _immutableOffsets = {}
+	);
+
+	/// Adds the gas of the instructions of @a _trace, which is the trace of a transaction that
+	/// called @a _code, to the profile.
+	/// @returns false and ignores the trace if the code was not registered.
+	bool addTrace(bytes const& _code, std::vector<TraceStep> const& _trace);
+
+	/// @returns the gas per call stack, whose frames are separated by semicolons.
+	std::map<std::string, uint64_t> const& stacks() const { return m_stacks; }
+	/// @returns the gas per source range ("source:line:column" of its start), summed over all call stacks.
+	std::map<std::string, uint64_t> gasBySourceRange() const;
+	/// @returns the profile as folded stacks, one line per call stack.
+	std::string folded() const;
+
+private:
+	struct Instruction
+	{
+		/// Frame name of the source range of the instruction.
+		std::string location;
+		/// Jump type of the source mapping, 'i' into a function, 'o' out of it or '-'.
+		char jump = '-';
+	};
+
+	struct Code
+	{
+		std::string name;
+		bytes code;
+		std::vector<size_t> immutableOffsets;
+		/// Instructions by their program counter.
+		std::map<size_t, Instruction> instructions;
+	};
+
+	Code const* findCode(bytes const& _code) const;
+
+	std::vector<Code> m_codes;
+	std::map<std::string, uint64_t> m_stacks;
+};
+
+}
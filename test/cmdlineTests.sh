@@ -474,6 +474,27 @@ SOLTMPDIR=$(mktemp -d)
     fi
 )
 
+printTask "Testing server mode..."
+(
+    request='{"language": "Solidity", "sources": {"A.sol": {"content": "contract C {}"}}, "settings": {"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}}'
+    set +e
+    output=$(printf '%s\n\n%s\n{\n' "$request" "$request" | "$SOLC" --server 2>/dev/null)
+    result=$?
+    set -e
+
+    # Each non-empty line is answered by exactly one line.
+    if [[ $result != 0 || $(echo "$output" | wc -l) != 3 || $(echo "$output" | grep -c '"object":"') != 2 ]]
+    then
+        printError "Incorrect response in server mode: $output"
+        exit 1
+    fi
+    if ! echo "$output" | tail -n 1 | grep -q '"type":"JSONError"'
+    then
+        printError "Invalid input not reported in server mode: $output"
+        exit 1
+    fi
+)
+
 printTask "Testing AST import..."
 SOLTMPDIR=$(mktemp -d)
 (
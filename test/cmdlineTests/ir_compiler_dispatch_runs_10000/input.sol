@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+
+contract C {
+    uint x;
+    function i0() internal { x = 0; }
+    function i1() internal { x = 1; }
+    function i2() internal { x = 2; }
+    function i3() internal { x = 3; }
+    function i4() internal { x = 4; }
+    function f0() external {}
+    function f1() external {}
+    function f2() external {}
+    function f3() external {}
+    function g(uint i) external {
+        function() internal p = i0;
+        if (i == 1) p = i1;
+        if (i == 2) p = i2;
+        if (i == 3) p = i3;
+        if (i == 4) p = i4;
+        p();
+    }
+}
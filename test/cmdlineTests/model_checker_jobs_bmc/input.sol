@@ -0,0 +1,16 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+pragma experimental SMTChecker;
+contract test {
+	uint[] a;
+	function f(uint x, uint y) public pure returns (uint) {
+		x / y;
+		return x - y;
+	}
+	function g(uint x) public {
+		a.push(x);
+		a.pop();
+		a.pop();
+		assert(x > 0);
+	}
+}
@@ -0,0 +1,10 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+pragma experimental SMTChecker;
+contract test {
+	bool b;
+	function f(uint8 x) public view {
+		require(x == 7);
+		assert(!b);
+	}
+}
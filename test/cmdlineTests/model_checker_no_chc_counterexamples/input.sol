@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+pragma experimental SMTChecker;
+contract test {
+	uint x;
+	function inc() public {
+		if (x < 5)
+			++x;
+	}
+	function f() public view {
+		assert(x < 3);
+	}
+}
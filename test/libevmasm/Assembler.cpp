@@ -280,6 +280,196 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(assembled_sub_not_optimised_again)
+{
+	shared_ptr<Assembly> subAsmPtr = make_shared<Assembly>();
+	subAsmPtr->append(u256(1));
+	subAsmPtr->append(Instruction::POP);
+	bytes subBytecode = subAsmPtr->assemble().bytecode;
+	AssemblyItems subItems = subAsmPtr->items();
+
+	Assembly assembly;
+	assembly.appendSubroutine(subAsmPtr);
+	assembly.optimise(true, EVMVersion{}, true, 200);
+	checkCompilation(assembly);
+
+	BOOST_CHECK(subAsmPtr->items() == subItems);
+	BOOST_CHECK(subAsmPtr->assemble().bytecode == subBytecode);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_sub_optimisation)
+{
+	auto createAssembly = []()
+	{
+		shared_ptr<Assembly> assembly = make_shared<Assembly>();
+		shared_ptr<Assembly> sharedSub;
+		for (size_t subIndex = 0; subIndex < 4; ++subIndex)
+		{
+			shared_ptr<Assembly> sub = sharedSub;
+			if (!sub)
+			{
+				sub = make_shared<Assembly>();
+				AssemblyItem first = sub->newTag();
+				AssemblyItem second = sub->newTag();
+				sub->append(u256(subIndex));
+				sub->append(u256(2));
+				sub->append(Instruction::ADD);
+				sub->appendJumpI(first);
+				sub->appendJump(second);
+				// Identical blocks that can be deduplicated.
+				sub->append(first);
+				sub->append(u256(7));
+				sub->append(Instruction::POP);
+				sub->append(Instruction::STOP);
+				sub->append(second);
+				sub->append(u256(7));
+				sub->append(Instruction::POP);
+				sub->append(Instruction::STOP);
+			}
+			if (subIndex == 1)
+				sharedSub = sub;
+			AssemblyItem subItem = assembly->appendSubroutine(sub);
+			assembly->pushSubroutineSize(static_cast<size_t>(subItem.data()));
+			assembly->append(Instruction::POP);
+		}
+		return assembly;
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.isCreation = true;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.runConstantOptimiser = true;
+
+	shared_ptr<Assembly> sequential = createAssembly();
+	sequential->optimise(settings);
+	settings.parallelism = 4;
+	shared_ptr<Assembly> parallel = createAssembly();
+	parallel->optimise(settings);
+
+	BOOST_CHECK_EQUAL(parallel->assemblyString(), sequential->assemblyString());
+	BOOST_CHECK(parallel->assemble().bytecode == sequential->assemble().bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_blocks)
+{
+	auto calldataLoads = [](bool _acrossBlocks)
+	{
+		Assembly assembly;
+		AssemblyItem target = assembly.newTag();
+		assembly.append(u256(0));
+		assembly.append(Instruction::CALLDATALOAD);
+		assembly.append(Instruction::DUP1);
+		assembly.appendJumpI(target);
+		// Only reachable if the jump is not taken, the value is still on the stack.
+		assembly.append(u256(0));
+		assembly.append(Instruction::CALLDATALOAD);
+		assembly.append(Instruction::ADD);
+		assembly.append(u256(0));
+		assembly.append(Instruction::SSTORE);
+		assembly.append(Instruction::STOP);
+		assembly.append(target);
+		assembly.setDeposit(1);
+		// Reachable through the jump, so nothing is known here.
+		assembly.append(u256(0));
+		assembly.append(Instruction::CALLDATALOAD);
+		assembly.append(Instruction::ADD);
+		assembly.append(u256(1));
+		assembly.append(Instruction::SSTORE);
+		assembly.append(Instruction::STOP);
+
+		Assembly::OptimiserSettings settings;
+		settings.runCSE = true;
+		settings.runCSEAcrossBlocks = _acrossBlocks;
+		assembly.optimise(settings);
+		checkCompilation(assembly);
+		return count(assembly.items().begin(), assembly.items().end(), AssemblyItem(Instruction::CALLDATALOAD));
+	};
+
+	BOOST_CHECK_EQUAL(calldataLoads(false), 3);
+	BOOST_CHECK_EQUAL(calldataLoads(true), 2);
+}
+
+BOOST_AUTO_TEST_CASE(assembly_stream_source_excerpt)
+{
+	auto source = make_shared<CharStream>("first line\nsecond line", "a.sol");
+	Assembly _assembly;
+	_assembly.setSourceLocation({0, 15, source});
+	_assembly.append(Instruction::CALLVALUE);
+	_assembly.setSourceLocation({11, 22, source});
+	_assembly.append(Instruction::POP);
+
+	string const expectation =
+		"    /* \"a.sol\":0:15  first line... */\n"
+		"  callvalue\n"
+		"    /* \"a.sol\":11:22  second line */\n"
+		"  pop\n";
+	StringMap const sources{{"a.sol", source->source()}};
+	BOOST_CHECK_EQUAL(_assembly.assemblyString(sources), expectation);
+	ostringstream stream;
+	_assembly.assemblyStream(stream, "", sources);
+	BOOST_CHECK_EQUAL(stream.str(), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(source_mapping)
+{
+	auto source = make_shared<CharStream>("lorem ipsum dolor", "a.sol");
+	map<string, unsigned> indices = {{"a.sol", 0}};
+	AssemblyItem jump{Instruction::JUMP, {6, 11, source}};
+	jump.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItems items{
+		{u256(1), {0, 5, source}},
+		{Instruction::POP, {0, 5, source}},
+		{Instruction::CALLVALUE, {6, 11, source}},
+		jump,
+		{Instruction::POP, {6, 8, nullptr}}
+	};
+
+	SourceMapping entries = AssemblyItem::computeSourceMappingEntries(items, indices);
+	BOOST_REQUIRE_EQUAL(entries.size(), 5);
+	BOOST_CHECK(entries[3] == (SourceMappingEntry{6, 5, 0, 'i', 0}));
+	BOOST_CHECK(entries[4] == (SourceMappingEntry{6, 2, -1, '-', 0}));
+
+	string const compressed = "0:5:0:-:0;;6;:::i;:2:-1:-";
+	BOOST_CHECK_EQUAL(AssemblyItem::computeSourceMapping(items, indices), compressed);
+	BOOST_CHECK_EQUAL(AssemblyItem::compressSourceMapping(entries), compressed);
+	optional<SourceMapping> decompressed = AssemblyItem::decompressSourceMapping(compressed);
+	BOOST_REQUIRE(decompressed);
+	BOOST_CHECK(*decompressed == entries);
+
+	BOOST_CHECK_EQUAL(
+		util::toHex(AssemblyItem::encodeSourceMapping(entries)),
+		"0106012d00" "0000002d00" "0600002d00" "0000006900" "007d7f2d00"
+	);
+
+	BOOST_CHECK(AssemblyItem::decompressSourceMapping("")->empty());
+	BOOST_CHECK(!AssemblyItem::decompressSourceMapping("1:2:0:x"));
+	BOOST_CHECK(!AssemblyItem::decompressSourceMapping("1:2:0:-:0:1"));
+	BOOST_CHECK(!AssemblyItem::decompressSourceMapping("1:a"));
+}
+
+BOOST_AUTO_TEST_CASE(link_many_references)
+{
+	LinkerObject object;
+	object.bytecode = bytes(60, 0);
+	object.linkReferences = {{0, "a.sol:L"}, {20, "a.sol:L"}, {40, "M"}};
+
+	util::h160 address("0x1234567890123456789012345678901234567890");
+	// The fully qualified name matches the library given by its simple name.
+	object.link(map<string, util::h160>{{"L", address}});
+
+	BOOST_CHECK(bytes(object.bytecode.begin(), object.bytecode.begin() + 20) == address.asBytes());
+	BOOST_CHECK(bytes(object.bytecode.begin() + 20, object.bytecode.begin() + 40) == address.asBytes());
+	BOOST_CHECK((object.linkReferences == map<size_t, string>{{40, "M"}}));
+	BOOST_CHECK_EQUAL(
+		object.toHex(),
+		util::toHex(address.asBytes()) + util::toHex(address.asBytes()) +
+		"__" + LinkerObject::libraryPlaceholder("M") + "__"
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
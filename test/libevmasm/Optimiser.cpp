@@ -28,6 +28,9 @@
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/BlockReorderer.h>
+#include <libevmasm/CodeOutliner.h>
+#include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
@@ -931,6 +934,149 @@ BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
 	BOOST_CHECK_EQUAL(pushTags.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(block_reorderer)
+{
+	AssemblyItems input{
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+	};
+	AssemblyItems expectation{
+		AssemblyItem(Tag, 2),
+		u256(2),
+		AssemblyItem(Tag, 1),
+		u256(1),
+		Instruction::STOP,
+	};
+	BlockReorderer reorderer(input);
+	BOOST_CHECK(reorderer.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), expectation.begin(), expectation.end());
+	BOOST_CHECK(!BlockReorderer(input).optimise());
+}
+
+BOOST_AUTO_TEST_CASE(block_reorderer_prefers_loops)
+{
+	AssemblyItems input{
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		Instruction::STOP,
+		AssemblyItem(Tag, 3),
+		u256(3),
+		Instruction::STOP,
+	};
+	// Only the jump out of the loop is removed.
+	AssemblyItems expectation{
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		Instruction::CALLVALUE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 3),
+		u256(3),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		Instruction::STOP,
+	};
+	BlockReorderer reorderer(input);
+	BOOST_CHECK(reorderer.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), expectation.begin(), expectation.end());
+}
+
+BOOST_AUTO_TEST_CASE(block_reorderer_keeps_fall_through_to_end)
+{
+	AssemblyItems input{
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+	};
+	AssemblyItems expectation = input;
+	BlockReorderer reorderer(input);
+	BOOST_CHECK(!reorderer.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), expectation.begin(), expectation.end());
+}
+
+BOOST_AUTO_TEST_CASE(block_reorderer_keeps_subroutine_entries)
+{
+	AssemblyItem subroutine(Tag, 2);
+	subroutine.markAsSubroutineEntry();
+	AssemblyItems input{
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		Instruction::STOP,
+		subroutine,
+		u256(2),
+		Instruction::RETURNSUB,
+	};
+	AssemblyItems expectation = input;
+	BlockReorderer reorderer(input);
+	BOOST_CHECK(!reorderer.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), expectation.begin(), expectation.end());
+}
+
+BOOST_AUTO_TEST_CASE(code_outliner)
+{
+	auto reverts = [](size_t _runs) {
+		Assembly assembly;
+		AssemblyItem overflow = assembly.newTag();
+		AssemblyItem nonEmpty = assembly.newTag();
+		auto appendPanic = [&]() {
+			assembly.append(u256(0x4e487b71) << 224);
+			assembly.append(u256(0));
+			assembly.append(Instruction::MSTORE);
+			assembly.append(u256(0x11));
+			assembly.append(u256(4));
+			assembly.append(Instruction::MSTORE);
+			assembly.append(u256(0x24));
+			assembly.append(u256(0));
+			assembly.append(Instruction::REVERT);
+		};
+		assembly.append(Instruction::CALLVALUE);
+		assembly.appendJumpI(overflow);
+		assembly.append(Instruction::CALLDATASIZE);
+		assembly.appendJumpI(nonEmpty);
+		assembly.append(Instruction::STOP);
+		assembly.append(overflow);
+		appendPanic();
+		assembly.append(nonEmpty);
+		assembly.append(u256(0));
+		assembly.append(Instruction::SLOAD);
+		assembly.append(Instruction::POP);
+		appendPanic();
+
+		Assembly::OptimiserSettings settings;
+		settings.runOutliner = true;
+		settings.expectedExecutionsPerDeployment = _runs;
+		assembly.optimise(settings);
+		BOOST_CHECK_NO_THROW(assembly.assemble());
+		return count(assembly.items().begin(), assembly.items().end(), AssemblyItem(Instruction::REVERT));
+	};
+
+	BOOST_CHECK_EQUAL(reverts(200), 1);
+	// The jump is too expensive if the code is executed often.
+	BOOST_CHECK_EQUAL(reverts(1000), 2);
+}
+
 BOOST_AUTO_TEST_CASE(clear_unreachable_code)
 {
 	AssemblyItems items{
@@ -1467,6 +1613,32 @@ BOOST_AUTO_TEST_CASE(cse_replace_too_large_shift)
 	});
 }
 
+BOOST_AUTO_TEST_CASE(constant_optimiser_repeated_runs)
+{
+	// The second run uses the routines found in the first one and has to arrive at the same code.
+	u256 value = (u256(1) << 255) + 1;
+	auto optimise = [&]() {
+		Assembly assembly;
+		for (size_t i = 0; i < 3; ++i)
+		{
+			assembly.append(value);
+			assembly.append(Instruction::POP);
+		}
+		unsigned replacements = ConstantOptimisationMethod::optimiseConstants(
+			false,
+			1,
+			solidity::test::CommonOptions::get().evmVersion(),
+			assembly
+		);
+		BOOST_CHECK(replacements > 0);
+		return assembly.items();
+	};
+	AssemblyItems first = optimise();
+	AssemblyItems second = optimise();
+	BOOST_CHECK_EQUAL_COLLECTIONS(first.begin(), first.end(), second.begin(), second.end());
+	BOOST_CHECK(find(first.begin(), first.end(), AssemblyItem(value)) == first.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
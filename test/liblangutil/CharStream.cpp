@@ -48,6 +48,40 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(shared_source)
+{
+	auto const text = std::make_shared<std::string const>("contract C {}");
+	CharStream stream(text, "source");
+	CharStream copy = stream;
+
+	BOOST_CHECK(&stream.source() == text.get());
+	BOOST_CHECK(&copy.source() == text.get());
+	BOOST_CHECK(stream.sharedSource() == text);
+	BOOST_CHECK('o' == copy.advanceAndGet());
+	BOOST_CHECK('c' == stream.get());
+}
+
+BOOST_AUTO_TEST_CASE(line_column)
+{
+	CharStream stream("ab\ncd\r\n\nef", "source");
+	CharStream copy = stream;
+
+	BOOST_CHECK(stream.translatePositionToLineColumn(0) == std::make_tuple(0, 0));
+	BOOST_CHECK(stream.translatePositionToLineColumn(2) == std::make_tuple(0, 2));
+	BOOST_CHECK(stream.translatePositionToLineColumn(3) == std::make_tuple(1, 0));
+	BOOST_CHECK(stream.translatePositionToLineColumn(7) == std::make_tuple(2, 0));
+	BOOST_CHECK(copy.translatePositionToLineColumn(9) == std::make_tuple(3, 1));
+	BOOST_CHECK(stream.translatePositionToLineColumn(100) == std::make_tuple(3, 2));
+
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(0), "ab");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(2), "ab");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(4), "cd");
+	BOOST_CHECK_EQUAL(copy.lineAtPosition(6), "cd");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(7), "");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(9), "ef");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(100), "ef");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -990,6 +990,27 @@ BOOST_AUTO_TEST_CASE(yul_function_with_whitespace)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
 }
 
+BOOST_AUTO_TEST_CASE(long_tokens)
+{
+	string const identifier(1000, 'x');
+	string const text(1000, 'a');
+	Scanner scanner(CharStream(
+		"/**\n * " + text + "\n * " + text + "*\n */ " +
+		identifier + "2  \t\n\"" + text + "\\n" + text + "\" /* " + text + " */ unicode\"" + text + "\" /// " + text + "\n;",
+		""
+	));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), identifier + "2");
+	BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), " " + text + "\n " + text + "*");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), text + "\n" + text);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UnicodeStringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), text);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Semicolon);
+	BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), text);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the artifact bundle output.
+ */
+
+#include <test/Common.h>
+#include <libsolidity/interface/ArtifactBundle.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(ArtifactBundleTest)
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	ArtifactBundle bundle;
+	bundle.add("b", bytes{1, 2, 3});
+	bundle.add("a", string("abc"));
+	bundle.add("c", bytes{});
+	bundle.add("b", bytes{4, 5});
+	bytes data = bundle.serialise();
+
+	ArtifactBundleReader reader(data.data(), data.size());
+	BOOST_REQUIRE_EQUAL(reader.size(), 3);
+	BOOST_CHECK(reader.name(0) == "a");
+	BOOST_CHECK(reader.name(1) == "b");
+	BOOST_CHECK(reader.name(2) == "c");
+	BOOST_CHECK(reader.data(0) == "abc");
+	BOOST_REQUIRE(reader.find("b"));
+	BOOST_CHECK(*reader.find("b") == string("\x04\x05"));
+	BOOST_REQUIRE(reader.find("c"));
+	BOOST_CHECK(reader.find("c")->empty());
+	BOOST_CHECK(!reader.find("d"));
+	for (size_t i = 0; i < reader.size(); ++i)
+		BOOST_CHECK_EQUAL((reader.data(i).data() - reinterpret_cast<char const*>(data.data())) % 8, 0);
+}
+
+BOOST_AUTO_TEST_CASE(invalid)
+{
+	bytes data = ArtifactBundle{}.serialise();
+	BOOST_CHECK_NO_THROW(ArtifactBundleReader(data.data(), data.size()));
+	BOOST_CHECK_THROW(ArtifactBundleReader(data.data(), 8), InvalidArtifactBundle);
+
+	data[0] = 'X';
+	BOOST_CHECK_THROW(ArtifactBundleReader(data.data(), data.size()), InvalidArtifactBundle);
+
+	ArtifactBundle bundle;
+	bundle.add("a", string("abc"));
+	data = bundle.serialise();
+	// Length of the data of the only entry.
+	data[16 + 24] = 0xff;
+	BOOST_CHECK_THROW(ArtifactBundleReader(data.data(), data.size()), InvalidArtifactBundle);
+}
+
+BOOST_AUTO_TEST_CASE(contracts)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources({{"A.sol", "pragma solidity >=0.0; contract C { function f() public {} }"}});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(compilerStack.compile());
+
+	bytes data = ArtifactBundle::fromCompilerStack(compilerStack).serialise();
+	ArtifactBundleReader reader(data.data(), data.size());
+	BOOST_REQUIRE(reader.find("A.sol:C#bin-runtime"));
+	bytes const& runtime = compilerStack.runtimeObject("A.sol:C").bytecode;
+	BOOST_CHECK(*reader.find("A.sol:C#bin-runtime") == string(runtime.begin(), runtime.end()));
+	BOOST_REQUIRE(reader.find("A.sol:C#abi"));
+	BOOST_CHECK(*reader.find("A.sol:C#abi") == util::jsonCompactPrint(compilerStack.contractABI("A.sol:C")));
+	BOOST_REQUIRE(reader.find("A.sol:C#metadata"));
+	BOOST_CHECK(*reader.find("A.sol:C#metadata") == compilerStack.metadata("A.sol:C"));
+	BOOST_CHECK(reader.find("A.sol:C#bin"));
+	BOOST_CHECK(reader.find("A.sol:C#srcmap-runtime"));
+	BOOST_CHECK(!reader.find("A.sol:C#link-references"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -321,6 +321,40 @@ BOOST_AUTO_TEST_CASE(complex_control_flow)
 	testRunTimeGas("ln(int128)", vector<bytes>{encodeArgs(0), encodeArgs(10), encodeArgs(105), encodeArgs(30000)});
 }
 
+BOOST_AUTO_TEST_CASE(bounded_loop)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint public x;
+			function f(uint n) public {
+				for (uint i = 0; i < n; i++)
+					x += i;
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	auto evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	AssemblyItems const& items = *m_compiler.runtimeAssemblyItems(m_compiler.lastContractName());
+	BOOST_CHECK(GasEstimator(evmVersion).functionalEstimation(items, "f(uint256)").isInfinite);
+
+	u256 gasUsed = 0;
+	util::FixedHash<4> hash(util::keccak256("f(uint256)"));
+	for (u256 n: {0, 1, 3, 5})
+	{
+		sendMessage(hash.asBytes() + encodeArgs(n), false, 0);
+		BOOST_CHECK(m_transactionSuccessful);
+		gasUsed = max(gasUsed, m_gasUsed - gasForTransaction(hash.asBytes() + encodeArgs(n), false).value);
+	}
+	// Helper functions are entered twice per iteration, so allow twice as many visits.
+	GasMeter::GasConsumption gas = GasEstimator(evmVersion, 10).functionalEstimation(items, "f(uint256)");
+	// Skip the tests when we use ABIEncoderV2, as for the other tests.
+	if (solidity::test::CommonOptions::get().useABIEncoderV1)
+	{
+		BOOST_REQUIRE(!gas.isInfinite);
+		BOOST_CHECK_LE(gasUsed, gas.value);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
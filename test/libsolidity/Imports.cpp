@@ -25,17 +25,43 @@
 #include <test/Common.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolidity/ast/AST.h>
 #include <libsolidity/interface/CompilerStack.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <string>
 
 using namespace std;
+using namespace solidity::langutil;
 
 namespace solidity::frontend::test
 {
 
+namespace
+{
+
+/// @returns the sorted descriptions of @a _errors including their locations.
+vector<string> describeErrors(ErrorList const& _errors)
+{
+	vector<string> descriptions;
+	for (auto const& error: _errors)
+	{
+		string description = error->typeName() + ": " + (error->comment() ? *error->comment() : "");
+		if (SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error))
+			if (location->source)
+				description +=
+					" at " + location->source->name() + ":" +
+					to_string(location->start) + "-" + to_string(location->end);
+		descriptions.push_back(description);
+	}
+	sort(descriptions.begin(), descriptions.end());
+	return descriptions;
+}
+
+}
+
 BOOST_AUTO_TEST_SUITE(SolidityImports)
 
 BOOST_AUTO_TEST_CASE(remappings)
@@ -112,6 +138,69 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(update_sources)
+{
+	string const lib = R"(
+		pragma solidity >=0.0;
+		library L { function f(uint x) internal pure returns (uint) { return x + 1; } }
+		contract Base { function g() public virtual returns (uint) { uint unused; return 1; } }
+	)";
+	string const a = R"(
+		pragma solidity >=0.0;
+		import "lib.sol";
+		contract A is Base { function h(uint x) public pure returns (uint) { return L.f(x); } }
+	)";
+	auto b = [](string const& _body) {
+		return "pragma solidity >=0.0; import \"lib.sol\"; contract B { " + _body + " }";
+	};
+	string const independent = "pragma solidity >=0.0; contract C {}";
+	string const changedB = b("uint unused; function k(uint x) public returns (uint) { unused = x; return x; }");
+
+	vector<string> expectedErrors;
+	string expectedA;
+	string expectedB;
+	{
+		CompilerStack c;
+		c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		c.setSources({{"lib.sol", lib}, {"a.sol", a}, {"b.sol", changedB}, {"c.sol", independent}});
+		BOOST_REQUIRE(c.compile());
+		expectedErrors = describeErrors(c.errors());
+		expectedA = c.object("A").toHex();
+		expectedB = c.object("B").toHex();
+	}
+
+	CompilerStack c;
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	c.setSources({{"lib.sol", lib}, {"a.sol", a}, {"b.sol", b("function k() public {}")}, {"c.sol", independent}});
+	BOOST_REQUIRE(c.compile());
+	SourceUnit const* libAST = &c.ast("lib.sol");
+	SourceUnit const* aAST = &c.ast("a.sol");
+	int64_t const aID = aAST->id();
+
+	c.updateSources({{"lib.sol", lib}, {"a.sol", a}, {"b.sol", changedB}, {"c.sol", independent}});
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK_EQUAL(&c.ast("lib.sol"), libAST);
+	BOOST_CHECK_EQUAL(&c.ast("a.sol"), aAST);
+	BOOST_CHECK(c.ast("b.sol").id() > max(libAST->id(), aID));
+	BOOST_CHECK(describeErrors(c.errors()) == expectedErrors);
+	BOOST_CHECK_EQUAL(c.object("A").toHex(), expectedA);
+	BOOST_CHECK_EQUAL(c.object("B").toHex(), expectedB);
+
+	// Changing an imported source invalidates all sources importing it, while
+	// independent sources are kept.
+	SourceUnit const* cAST = &c.ast("c.sol");
+	c.updateSources({{"lib.sol", lib + "contract D {}"}, {"a.sol", a}, {"b.sol", changedB}, {"c.sol", independent}});
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK_EQUAL(&c.ast("c.sol"), cAST);
+	BOOST_CHECK(c.ast("a.sol").id() > cAST->id());
+	BOOST_CHECK(c.ast("b.sol").id() > cAST->id());
+
+	// Errors in an updated source are reported.
+	c.updateSources({{"lib.sol", lib}, {"a.sol", a}, {"b.sol", b("function k() public { x = 1; }")}, {"c.sol", independent}});
+	BOOST_CHECK(!c.compile());
+	BOOST_CHECK(!Error::containsOnlyWarnings(c.errors()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
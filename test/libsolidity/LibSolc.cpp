@@ -20,7 +20,10 @@
  * Unit tests for libsolc/libsolc.cpp.
  */
 
+#include <map>
 #include <string>
+#include <thread>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
@@ -65,6 +68,16 @@ Json::Value compile(string const& _input, CStyleReadFileCallback _callback = nul
 	return ret;
 }
 
+Json::Value compileWith(SolidityInstance* _instance, string const& _input)
+{
+	char* output_ptr = solidity_compile_with(_instance, _input.c_str(), nullptr, nullptr);
+	string output(output_ptr);
+	solidity_free(output_ptr);
+	Json::Value ret;
+	BOOST_REQUIRE(util::jsonParseStrict(output, ret));
+	return ret;
+}
+
 char* stringToSolidity(string const& _input)
 {
 	char* ptr = solidity_alloc(_input.length());
@@ -179,6 +192,166 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(with_batch_callback)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "import \"b.sol\"; import \"c.sol\"; contract A { }"
+			}
+		}
+	}
+	)";
+
+	CStyleReadFilesCallback callback{
+		[](void* _context, char const* _kind, size_t _count, char const* const* _paths, char** o_contents, char** o_errors)
+		{
+			BOOST_REQUIRE(string(_kind) == ReadCallback::kindString(ReadCallback::Kind::ReadFile));
+			vector<string> paths(_paths, _paths + _count);
+			static_cast<vector<vector<string>>*>(_context)->push_back(paths);
+			map<string, string> files{
+				{"b.sol", "import \"d.sol\"; contract B {}"},
+				{"c.sol", "import \"d.sol\"; import \"missing.sol\"; contract C {}"},
+				{"d.sol", "contract D {}"}
+			};
+			for (size_t i = 0; i < _count; ++i)
+				if (files.count(paths[i]))
+					o_contents[i] = stringToSolidity(files.at(paths[i]));
+				else
+					o_errors[i] = stringToSolidity("Missing file.");
+		}
+	};
+
+	vector<vector<string>> requests;
+	char* output_ptr = solidity_compile_batched(input, callback, &requests);
+	string output(output_ptr);
+	solidity_free(output_ptr);
+	solidity_reset();
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(output, result));
+
+	// The imports of all sources parsed so far are requested together, each path only once.
+	BOOST_REQUIRE_EQUAL(requests.size(), 2);
+	BOOST_CHECK((requests[0] == vector<string>{"b.sol", "c.sol"}));
+	BOOST_CHECK((requests[1] == vector<string>{"d.sol", "missing.sol"}));
+	BOOST_CHECK(containsError(result, "ParserError", "Source \"missing.sol\" not found: Missing file."));
+}
+
+BOOST_AUTO_TEST_CASE(instance_compilation)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public pure returns (uint) { return 42; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": { "fileA": { "A": [ "evm.bytecode.object" ] } }
+		}
+	}
+	)";
+	SolidityInstance* instance = solidity_create();
+	BOOST_REQUIRE(instance != nullptr);
+	Json::Value first = compileWith(instance, input);
+	// The second compilation restores the contract from the cache of the instance.
+	Json::Value second = compileWith(instance, input);
+	solidity_destroy(instance);
+
+	BOOST_REQUIRE(first.isObject());
+	string bytecode = first["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString();
+	BOOST_CHECK(!bytecode.empty());
+	BOOST_CHECK_EQUAL(bytecode, second["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString());
+	BOOST_CHECK_EQUAL(bytecode, compile(input)["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_instances)
+{
+	auto input = [](size_t _index) {
+		return
+			R"({"language": "Solidity", "sources": {"fileA": {"content": "contract A { function f() public pure returns (uint) { return )" +
+			to_string(_index) +
+			R"(; } }"}}, "settings": {"outputSelection": {"fileA": {"A": ["evm.bytecode.object"]}}}})";
+	};
+	size_t const threadCount = 4;
+	vector<string> expectations;
+	for (size_t i = 0; i < threadCount; ++i)
+		expectations.emplace_back(compile(input(i))["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString());
+
+	vector<string> results(threadCount);
+	vector<thread> threads;
+	SolidityInstance* sharedInstance = solidity_create();
+	for (size_t i = 0; i < threadCount; ++i)
+		threads.emplace_back([&, i]() {
+			SolidityInstance* instance = (i % 2 == 0) ? solidity_create() : sharedInstance;
+			for (size_t repetition = 0; repetition < 3; ++repetition)
+			{
+				char* output = solidity_compile_with(instance, input(i).c_str(), nullptr, nullptr);
+				results[i] = output;
+				solidity_free(output);
+			}
+			if (instance != sharedInstance)
+				solidity_destroy(instance);
+		});
+	for (thread& t: threads)
+		t.join();
+	solidity_destroy(sharedInstance);
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(results[i], result));
+		BOOST_CHECK_EQUAL(result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString(), expectations[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(separate_sources)
+{
+	string const sourceA = "import \"fileB\"; contract A is B { function f() public pure returns (uint) { return 42; } }";
+	string const sourceB = "contract B {}";
+	vector<SoliditySource> sources{
+		{"fileA", 5, sourceA.data(), sourceA.size()},
+		{"fileB", 5, sourceB.data(), sourceB.size()}
+	};
+	string input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": { "fileA": { "A": [ "evm.bytecode.object" ] } }
+		}
+	}
+	)";
+	auto appendOutput = [](void* _context, char const* _data, size_t _length) {
+		static_cast<string*>(_context)->append(_data, _length);
+	};
+	string output;
+	solidity_compile_sources(input.c_str(), sources.data(), sources.size(), nullptr, nullptr, appendOutput, &output);
+	solidity_reset();
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(output, result));
+	BOOST_CHECK(!result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString().empty());
+
+	output.clear();
+	solidity_compile_sources(input.c_str(), nullptr, 0, nullptr, nullptr, appendOutput, &output);
+	solidity_reset();
+	BOOST_REQUIRE(util::jsonParseStrict(output, result));
+	BOOST_CHECK(containsError(result, "JSONError", "No input sources specified."));
+
+	output.clear();
+	string inputWithSources = R"({"language": "Solidity", "sources": {"fileC": {"content": "contract C {}"}}})";
+	solidity_compile_sources(inputWithSources.c_str(), sources.data(), sources.size(), nullptr, nullptr, appendOutput, &output);
+	solidity_reset();
+	BOOST_REQUIRE(util::jsonParseStrict(output, result));
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"sources\" must not be given if the sources are passed separately."
+	));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for sharing Yul functions between function collectors.
+ */
+
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Creates the shared function "f", which calls the shared function "g" and,
+/// if @a _unshared is true, the unshared function "h".
+string createF(MultiUseYulFunctionCollector& _collector, size_t& _creatorCalls, bool _unshared = false)
+{
+	return _collector.createSharedFunction("f", [&]() {
+		++_creatorCalls;
+		string g = _collector.createSharedFunction("g", [&]() {
+			++_creatorCalls;
+			return string("function g() {}");
+		});
+		if (_unshared)
+			_collector.createFunction("h", [&]() {
+				++_creatorCalls;
+				return string("function h() {}");
+			});
+		return "function f() { " + g + "() }";
+	});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(MultiUseYulFunctionCollectorTest)
+
+BOOST_AUTO_TEST_CASE(reuse_with_dependencies)
+{
+	auto cache = make_shared<MultiUseYulFunctionCache>();
+	size_t creatorCalls = 0;
+
+	MultiUseYulFunctionCollector first{cache};
+	BOOST_CHECK_EQUAL(createF(first, creatorCalls), "f");
+	BOOST_CHECK_EQUAL(creatorCalls, 2);
+	string expectation = first.requestedFunctions();
+	BOOST_CHECK_EQUAL(expectation, "function f() { g() }function g() {}");
+
+	MultiUseYulFunctionCollector second{cache};
+	BOOST_CHECK_EQUAL(createF(second, creatorCalls), "f");
+	BOOST_CHECK_EQUAL(creatorCalls, 2);
+	BOOST_CHECK(second.contains("g"));
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(unshared_dependency)
+{
+	auto cache = make_shared<MultiUseYulFunctionCache>();
+	size_t creatorCalls = 0;
+
+	MultiUseYulFunctionCollector first{cache};
+	createF(first, creatorCalls, true);
+	BOOST_CHECK_EQUAL(creatorCalls, 3);
+	BOOST_CHECK(!cache->find("f"));
+	BOOST_CHECK(cache->find("g"));
+
+	// "f" is regenerated, "g" is taken from the cache.
+	MultiUseYulFunctionCollector second{cache};
+	createF(second, creatorCalls, true);
+	BOOST_CHECK_EQUAL(creatorCalls, 5);
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), first.requestedFunctions());
+}
+
+BOOST_AUTO_TEST_CASE(without_cache)
+{
+	size_t creatorCalls = 0;
+	MultiUseYulFunctionCollector collector;
+	createF(collector, creatorCalls);
+	createF(collector, creatorCalls);
+	BOOST_CHECK_EQUAL(creatorCalls, 2);
+	BOOST_CHECK_EQUAL(collector.requestedFunctions(), "function f() { g() }function g() {}");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
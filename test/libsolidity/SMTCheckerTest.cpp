@@ -54,6 +54,22 @@ SMTCheckerTest::SMTCheckerTest(string const& _filename): SyntaxTest(_filename, E
 	if (m_enabledSolvers.none() || m_modelCheckerSettings.engine.none())
 		m_shouldRun = false;
 
+	auto const& modular = m_reader.stringSetting("SMTModular", "no");
+	if (modular == "no")
+		m_modelCheckerSettings.modular = false;
+	else if (modular == "yes")
+		m_modelCheckerSettings.modular = true;
+	else
+		BOOST_THROW_EXCEPTION(runtime_error("Invalid SMT modular choice."));
+
+	auto const& slicing = m_reader.stringSetting("SMTSlicing", "no");
+	if (slicing == "no")
+		m_modelCheckerSettings.slicing = false;
+	else if (slicing == "yes")
+		m_modelCheckerSettings.slicing = true;
+	else
+		BOOST_THROW_EXCEPTION(runtime_error("Invalid SMT slicing choice."));
+
 	auto const& ignoreCex = m_reader.stringSetting("SMTIgnoreCex", "no");
 	if (ignoreCex == "no")
 		m_ignoreCex = false;
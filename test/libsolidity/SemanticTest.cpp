@@ -106,6 +106,7 @@ TestCase::TestResult SemanticTest::run(ostream& _stream, string const& _linePref
 {
 	TestResult result = TestResult::Success;
 	bool compileViaYul = m_runWithYul || m_enforceViaYul;
+	m_gasMeasurements.clear();
 
 	if (m_runWithoutYul)
 		result = runTest(_stream, _linePrefix, _formatted, false, false);
@@ -148,6 +149,7 @@ TestCase::TestResult SemanticTest::runTest(ostream& _stream, string const& _line
 	map<string, solidity::test::Address> libraries;
 
 	bool constructed = false;
+	GasMeasurement gasMeasurement;
 
 	for (auto& test: m_tests)
 	{
@@ -163,6 +165,7 @@ TestCase::TestResult SemanticTest::runTest(ostream& _stream, string const& _line
 			soltestAssert(
 				deploy(test.call().signature, 0, {}, libraries) && m_transactionSuccessful,
 				"Failed to deploy library " + test.call().signature);
+			gasMeasurement.gasUsed += m_gasUsed;
 			libraries[test.call().signature] = m_contractAddress;
 			continue;
 		}
@@ -173,6 +176,8 @@ TestCase::TestResult SemanticTest::runTest(ostream& _stream, string const& _line
 			else
 				soltestAssert(deploy("", 0, bytes(), libraries), "Failed to deploy contract.");
 			constructed = true;
+			gasMeasurement.gasUsed += m_gasUsed;
+			gasMeasurement.codeSize = m_evmcHost->get_code_size(solidity::test::EVMHost::convertToEVMC(m_contractAddress));
 		}
 
 		if (test.call().kind == FunctionCall::Kind::Storage)
@@ -211,6 +216,7 @@ TestCase::TestResult SemanticTest::runTest(ostream& _stream, string const& _line
 					test.call().arguments.rawBytes()
 				);
 			}
+			gasMeasurement.gasUsed += m_gasUsed;
 
 			bool outputMismatch = (output != test.call().expectations.rawBytes());
 			// Pre byzantium, it was not possible to return failure data, so we disregard
@@ -226,6 +232,9 @@ TestCase::TestResult SemanticTest::runTest(ostream& _stream, string const& _line
 		}
 	}
 
+	if (success)
+		m_gasMeasurements[_compileToEwasm ? "ewasm" : _compileViaYul ? "viaYul" : "legacy"] = gasMeasurement;
+
 	if (!m_runWithYul && _compileViaYul)
 	{
 		m_compileViaYulCanBeSet = success;
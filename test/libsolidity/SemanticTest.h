@@ -58,6 +58,17 @@ public:
 	/// Compiles and deploys currently held source.
 	/// Returns true if deployment was successful, false otherwise.
 	bool deploy(std::string const& _contractName, u256 const& _value, bytes const& _arguments, std::map<std::string, solidity::test::Address> const& _libraries = {});
+
+	/// Gas used by all transactions of a run of the test and the size of the deployed code
+	/// of the tested contract.
+	struct GasMeasurement
+	{
+		u256 gasUsed;
+		size_t codeSize = 0;
+	};
+	/// @returns the measurements of the successful runs of the last call to @a run, keyed by
+	/// the code generator ("legacy", "viaYul" or "ewasm").
+	std::map<std::string, GasMeasurement> const& gasMeasurements() const { return m_gasMeasurements; }
 private:
 	TestResult runTest(std::ostream& _stream, std::string const& _linePrefix, bool _formatted, bool _compileViaYul, bool _compileToEwasm);
 	SourceMap m_sources;
@@ -70,6 +81,7 @@ private:
 	bool m_runWithABIEncoderV1Only = false;
 	bool m_allowNonExistingFunctions = false;
 	bool m_compileViaYulCanBeSet = false;
+	std::map<std::string, GasMeasurement> m_gasMeasurements;
 };
 
 }
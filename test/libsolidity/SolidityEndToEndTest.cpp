@@ -5531,6 +5531,41 @@ BOOST_AUTO_TEST_CASE(strip_reason_strings)
 	)
 }
 
+BOOST_AUTO_TEST_CASE(revert_to_snapshot)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint public x;
+			event Set(uint);
+			function set(uint _x) public { x = _x; emit Set(_x); }
+			function destroy() public { selfdestruct(payable(msg.sender)); }
+		}
+	)";
+	ALSO_VIA_YUL(
+		DISABLE_EWASM_TESTRUN()
+		compileAndRun(sourceCode);
+		size_t deployed = snapshot();
+		ABI_CHECK(callContractFunction("set(uint256)", 7), encodeArgs());
+		BOOST_CHECK_EQUAL(numLogs(), 1);
+		ABI_CHECK(callContractFunction("x()"), encodeArgs(7));
+
+		revertToSnapshot(deployed);
+		BOOST_CHECK_EQUAL(numLogs(), 0);
+		ABI_CHECK(callContractFunction("x()"), encodeArgs(0));
+		ABI_CHECK(callContractFunction("destroy()"), encodeArgs());
+		BOOST_CHECK(!addressHasCode(m_contractAddress));
+
+		revertToSnapshot(deployed);
+		BOOST_CHECK(addressHasCode(m_contractAddress));
+		ABI_CHECK(callContractFunction("set(uint256)", 8), encodeArgs());
+		ABI_CHECK(callContractFunction("x()"), encodeArgs(8));
+
+		compileAndRun(sourceCode);
+		revertToSnapshot(deployed);
+		ABI_CHECK(callContractFunction("x()"), encodeArgs(0));
+	)
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
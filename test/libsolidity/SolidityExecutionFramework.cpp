@@ -25,8 +25,11 @@
 #include <iostream>
 #include <boost/test/framework.hpp>
 #include <test/libsolidity/SolidityExecutionFramework.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <liblangutil/Exceptions.h>
+#include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
+#include <libsolutil/Keccak256.h>
 
 using namespace solidity;
 using namespace solidity::test;
@@ -34,6 +37,34 @@ using namespace solidity::frontend;
 using namespace solidity::frontend::test;
 using namespace std;
 
+namespace
+{
+
+/// Results of code generation shared by all tests, which often compile the same sources
+/// with the same settings again, e.g. for every deployment or when run with different settings.
+shared_ptr<CompilationCache const> compilationCache()
+{
+	static auto const cache = make_shared<CompilationCache const>(size_t(256));
+	return cache;
+}
+
+/// Unlinked object assembled from the optimized IR of a contract.
+struct AssembledIR
+{
+	OptimiserSettings optimiserSettings;
+	langutil::EVMVersion evmVersion;
+	evmasm::LinkerObject object;
+};
+
+/// Objects assembled from optimized IR, by the hash of the IR.
+map<util::h256, vector<AssembledIR>>& assembledIRCache()
+{
+	static map<util::h256, vector<AssembledIR>> cache;
+	return cache;
+}
+
+}
+
 bytes SolidityExecutionFramework::multiSourceCompileContract(
 	map<string, string> const& _sourceCode,
 	string const& _contractName,
@@ -54,6 +85,9 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 	m_compiler.enableEvmBytecodeGeneration(!m_compileViaYul);
 	m_compiler.enableIRGeneration(m_compileViaYul);
 	m_compiler.setRevertStringBehaviour(m_revertStrings);
+	// Storing and restoring the results costs more than unoptimised legacy code generation.
+	if (m_compileViaYul || !(m_optimiserSettings == OptimiserSettings::minimal()))
+		m_compiler.setCompilationCache(compilationCache());
 	if (!m_compiler.compile())
 	{
 		// The testing framework expects an exception for
@@ -76,42 +110,72 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 			obj = m_compiler.ewasmObject(contractName);
 		else
 		{
-			// Try compiling twice: If the first run fails due to stack errors, forcefully enable
-			// the optimizer.
-			for (bool forceEnableOptimizer: {false, true})
+			string const& ir = m_compiler.yulIROptimized(contractName);
+			vector<AssembledIR>& assembled = assembledIRCache()[util::keccak256(ir)];
+			auto cached = find_if(assembled.begin(), assembled.end(), [&](AssembledIR const& _assembled) {
+				return _assembled.optimiserSettings == m_optimiserSettings && _assembled.evmVersion == m_evmVersion;
+			});
+			if (cached != assembled.end())
+				obj = cached->object;
+			else
 			{
-				OptimiserSettings optimiserSettings = m_optimiserSettings;
-				if (!forceEnableOptimizer && !optimiserSettings.runYulOptimiser)
+				// Try compiling twice: If the first run fails due to stack errors, forcefully enable
+				// the optimizer.
+				for (bool forceEnableOptimizer: {false, true})
 				{
-					// Enable some optimizations on the first run
-					optimiserSettings.runYulOptimiser = true;
-					optimiserSettings.yulOptimiserSteps = "uljmul jmul";
-				}
-				else if (forceEnableOptimizer)
-					optimiserSettings = OptimiserSettings::full();
+					OptimiserSettings optimiserSettings = m_optimiserSettings;
+					if (!forceEnableOptimizer && !optimiserSettings.runYulOptimiser)
+					{
+						// Enable some optimizations on the first run
+						optimiserSettings.runYulOptimiser = true;
+						optimiserSettings.yulOptimiserSteps = "uljmul jmul";
+					}
+					else if (forceEnableOptimizer)
+						optimiserSettings = OptimiserSettings::full();
 
-				yul::AssemblyStack
-					asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, optimiserSettings);
-				bool analysisSuccessful = asmStack.parseAndAnalyze("", m_compiler.yulIROptimized(contractName));
-				solAssert(analysisSuccessful, "Code that passed analysis in CompilerStack can't have errors");
+					yul::AssemblyStack
+						asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, optimiserSettings);
+					bool analysisSuccessful = asmStack.parseAndAnalyze("", ir);
+					solAssert(analysisSuccessful, "Code that passed analysis in CompilerStack can't have errors");
 
-				try
-				{
-					asmStack.optimize();
-					obj = std::move(*asmStack.assemble(yul::AssemblyStack::Machine::EVM).bytecode);
-					obj.link(_libraryAddresses);
-					break;
-				}
-				catch (...)
-				{
-					if (forceEnableOptimizer || optimiserSettings == OptimiserSettings::full())
-						throw;
+					try
+					{
+						asmStack.optimize();
+						obj = std::move(*asmStack.assemble(yul::AssemblyStack::Machine::EVM).bytecode);
+						assembled.push_back({m_optimiserSettings, m_evmVersion, obj});
+						break;
+					}
+					catch (...)
+					{
+						if (forceEnableOptimizer || optimiserSettings == OptimiserSettings::full())
+							throw;
+					}
 				}
 			}
+			obj.link(_libraryAddresses);
 		}
 	}
 	else
+	{
 		obj = m_compiler.object(contractName);
+		if (m_gasProfiler)
+		{
+			evmasm::LinkerObject const& runtimeObject = m_compiler.runtimeObject(contractName);
+			vector<shared_ptr<langutil::CharStream const>> sources;
+			for (string const& sourceName: m_compiler.sourceNames())
+				sources.emplace_back(m_compiler.scanner(sourceName).charStream());
+			vector<size_t> immutableOffsets;
+			for (auto const& reference: runtimeObject.immutableReferences)
+				immutableOffsets.insert(immutableOffsets.end(), reference.second.second.begin(), reference.second.second.end());
+			m_gasProfiler->addCode(
+				contractName,
+				runtimeObject.bytecode,
+				*m_compiler.runtimeSourceMapping(contractName),
+				move(sources),
+				move(immutableOffsets)
+			);
+		}
+	}
 	BOOST_REQUIRE(obj.linkReferences.empty());
 	if (m_showMetadata)
 		cout << "metadata: " << m_compiler.metadata(contractName) << endl;
@@ -84,6 +84,28 @@ public:
 		m_optimizedContract = m_contractAddress;
 	}
 
+	/// Compiles the source code without optimizing and with the full optimizer including the
+	/// modifier outliner for a single run, and checks that the outliner changed the code.
+	void compileWithModifierOutliner(std::string const& _sourceCode, std::string const& _contractName = "")
+	{
+		std::string const sourceCode = "pragma solidity >=0.0;\n" + _sourceCode;
+		OptimiserSettings previousSettings = std::move(m_optimiserSettings);
+		m_optimiserSettings = OptimiserSettings::none();
+		m_nonOptimizedBytecode = compileAndRun(sourceCode, 0, _contractName);
+		m_nonOptimizedContract = m_contractAddress;
+		m_optimiserSettings = OptimiserSettings::full();
+		m_optimiserSettings.expectedExecutionsPerDeployment = 1;
+		bytes withoutOutliner = bytecodeSansMetadata(compileAndRun(sourceCode, 0, _contractName));
+		m_optimiserSettings.runModifierOutliner = true;
+		m_optimizedBytecode = compileAndRun(sourceCode, 0, _contractName);
+		m_optimizedContract = m_contractAddress;
+		BOOST_CHECK_MESSAGE(
+			bytecodeSansMetadata(m_optimizedBytecode) != withoutOutliner,
+			"The modifier outliner did not change the code."
+		);
+		m_optimiserSettings = std::move(previousSettings);
+	}
+
 	template <class... Args>
 	void compareVersions(std::string _sig, Args const&... _arguments)
 	{
@@ -723,6 +745,141 @@ BOOST_AUTO_TEST_CASE(avoid_double_cleanup)
 	BOOST_CHECK_EQUAL(numInstructions(m_nonOptimizedBytecode, Instruction::AND), 1);
 }
 
+BOOST_AUTO_TEST_CASE(subroutines_with_code_moving_steps)
+{
+	if (!solidity::test::CommonOptions::get().evmVersion().hasSubroutines())
+		return;
+	char const* sourceCode = R"(
+		contract C {
+			uint[] x;
+			modifier nonZero(uint a) { require(a != 0); _; }
+			function g(uint a) internal pure returns (uint) { return a * 2 + 1; }
+			function f(uint a) public nonZero(a) returns (uint) {
+				for (uint i = 0; i < a; i++)
+					x.push(g(i));
+				require(x.length < 100);
+				return g(x.length);
+			}
+			function h(uint a) public nonZero(a) returns (uint) { return g(g(a)); }
+		}
+	)";
+	m_optimiserSettings = OptimiserSettings::none();
+	m_optimiserSettings.useSubroutines = true;
+	BOOST_CHECK(numInstructions(compileAndRun(sourceCode), Instruction::JUMPSUB) > 0);
+	m_nonOptimizedContract = m_contractAddress;
+	// The steps that move, share or look across blocks have to keep the subroutine entries intact.
+	m_optimiserSettings = OptimiserSettings::full();
+	m_optimiserSettings.useSubroutines = true;
+	m_optimiserSettings.runBlockReorderer = true;
+	m_optimiserSettings.runOutliner = true;
+	m_optimiserSettings.runCSEAcrossBlocks = true;
+	BOOST_CHECK(numInstructions(compileAndRun(sourceCode), Instruction::JUMPSUB) > 0);
+	m_optimizedContract = m_contractAddress;
+	compareVersions("f(uint256)", 3);
+	compareVersions("f(uint256)", 10);
+	compareVersions("h(uint256)", 5);
+}
+
+BOOST_AUTO_TEST_CASE(modifier_outliner_parameters_changed_before_placeholder)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint public x;
+			modifier m(uint a, uint b) { a = a * 2; b += a; x = b; _; }
+			function f(uint a) public m(a, 1) returns (uint) { return x; }
+			function g(uint a) public m(a + 1, a) returns (uint r) { uint y = x; r = y + 1; }
+			function h() public m(3, 4) m(5, 6) returns (uint) { return x; }
+		}
+	)";
+	compileWithModifierOutliner(sourceCode);
+	compareVersions("f(uint256)", 7);
+	compareVersions("x()");
+	compareVersions("g(uint256)", 7);
+	compareVersions("x()");
+	compareVersions("h()");
+	compareVersions("x()");
+}
+
+BOOST_AUTO_TEST_CASE(modifier_outliner_parameters_read_after_placeholder)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint public x;
+			uint public y;
+			modifier m(uint a) { a += 1; x = a; _; y = y * 10 + a; a += 10; x = a; }
+			function f(uint a) public m(a) returns (uint) { y = a; return y; }
+			function g(uint a) public m(a) m(a * 2) returns (uint) { uint b = a + 3; y = b; return b; }
+			function h() public m(4) returns (uint r) { r = x; }
+		}
+	)";
+	compileWithModifierOutliner(sourceCode);
+	compareVersions("f(uint256)", 7);
+	compareVersions("x()");
+	compareVersions("y()");
+	compareVersions("g(uint256)", 2);
+	compareVersions("x()");
+	compareVersions("y()");
+	compareVersions("h()");
+	compareVersions("x()");
+	compareVersions("y()");
+}
+
+BOOST_AUTO_TEST_CASE(modifier_outliner_early_return)
+{
+	// r is not outlined because of its return statement, m still runs the code after the
+	// placeholder if the function returns early.
+	char const* sourceCode = R"(
+		contract C {
+			uint public x;
+			modifier m(uint a) { x = a; _; x += 1; }
+			modifier r(uint a) { if (a == 0) return; _; x *= 2; }
+			function f(uint a) public m(a) returns (uint) { if (a > 5) return 1; x += 10; return 2; }
+			function g(uint a) public m(a) r(a) returns (uint) { if (a == 1) return x; x += 100; }
+			function h(uint a) public r(a) m(a) returns (uint) { return a; }
+			function i(uint a) public m(a + 1) returns (uint) { return x; }
+		}
+	)";
+	compileWithModifierOutliner(sourceCode);
+	for (u256 a: {0, 1, 2, 7})
+	{
+		compareVersions("f(uint256)", a);
+		compareVersions("x()");
+		compareVersions("g(uint256)", a);
+		compareVersions("x()");
+		compareVersions("h(uint256)", a);
+		compareVersions("x()");
+		compareVersions("i(uint256)", a);
+		compareVersions("x()");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(modifier_outliner_overridden_modifier)
+{
+	// The functions of B use the overriding modifier of C.
+	char const* sourceCode = R"(
+		contract B {
+			uint public x;
+			modifier m(uint a) virtual { x = a; _; }
+			function f(uint a) public m(a) returns (uint) { return x; }
+			function g(uint a) public m(a + 1) returns (uint) { return x; }
+		}
+		contract C is B {
+			modifier m(uint a) override { x = a + 100; _; x += 1; }
+			function h(uint a) public m(a * 2) returns (uint) { return x; }
+			function i() public m(5) returns (uint) { return x; }
+		}
+	)";
+	compileWithModifierOutliner(sourceCode, "C");
+	compareVersions("f(uint256)", 7);
+	compareVersions("x()");
+	compareVersions("g(uint256)", 7);
+	compareVersions("x()");
+	compareVersions("h(uint256)", 7);
+	compareVersions("x()");
+	compareVersions("i()");
+	compareVersions("x()");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -218,6 +218,26 @@ BOOST_AUTO_TEST_CASE(type_identifiers)
 	BOOST_CHECK_EQUAL(InaccessibleDynamicType().identifier(), "t_inaccessible");
 }
 
+BOOST_AUTO_TEST_CASE(unique_types)
+{
+	TypePointer uint256 = TypeProvider::uint256();
+	ArrayType const* array = TypeProvider::array(DataLocation::Memory, uint256);
+	BOOST_CHECK_EQUAL(TypeProvider::array(DataLocation::Memory, uint256), array);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint256, 3) != array);
+	BOOST_CHECK_EQUAL(TypeProvider::array(DataLocation::Memory, uint256, 3), TypeProvider::array(DataLocation::Memory, uint256, 3));
+	BOOST_CHECK_EQUAL(TypeProvider::withLocation(array, DataLocation::Storage, true), TypeProvider::withLocation(array, DataLocation::Storage, true));
+	BOOST_CHECK_EQUAL(TypeProvider::tuple({uint256, array}), TypeProvider::tuple({uint256, array}));
+	BOOST_CHECK(TypeProvider::tuple({uint256, array}) != TypeProvider::tuple({array, uint256}));
+	BOOST_CHECK_EQUAL(
+		TypeProvider::function(strings{"uint256"}, strings{}, FunctionType::Kind::Internal),
+		TypeProvider::function(strings{"uint256"}, strings{}, FunctionType::Kind::Internal)
+	);
+	BOOST_CHECK(
+		TypeProvider::function(strings{"uint256"}, strings{}, FunctionType::Kind::Internal) !=
+		TypeProvider::function(strings{"uint256"}, strings{}, FunctionType::Kind::External)
+	);
+}
+
 BOOST_AUTO_TEST_CASE(encoded_sizes)
 {
 	BOOST_CHECK_EQUAL(IntegerType(16).calldataEncodedSize(true), 32);
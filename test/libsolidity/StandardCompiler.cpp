@@ -27,10 +27,16 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
 #include <test/Metadata.h>
 
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+
 #include <algorithm>
+#include <fstream>
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace solidity::evmasm;
@@ -634,6 +640,108 @@ BOOST_AUTO_TEST_CASE(output_selection_all_files_all_contracts)
 	BOOST_CHECK_EQUAL(util::jsonCompactPrint(contract["abi"]), "[]");
 }
 
+BOOST_AUTO_TEST_CASE(streamed_output_matches_serialised_output)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": ["abi", "evm.bytecode.object"],
+					"": ["ast"]
+				}
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { } contract B { function f() public {} }"
+			},
+			"fileB": {
+				"content": "contract C { uint x; }"
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	frontend::StandardCompiler compiler;
+	ostringstream streamed;
+	compiler.compile(input, streamed);
+	BOOST_CHECK_EQUAL(streamed.str(), util::jsonCompactPrint(compiler.compile(parsedInput)));
+
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(streamed.str(), result));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(getContractResult(result, "fileA", "B")["evm"]["bytecode"]["object"].isString());
+	BOOST_CHECK(getContractResult(result, "fileB", "C")["abi"].isArray());
+	BOOST_CHECK(result["sources"]["fileB"]["ast"].isObject());
+}
+
+BOOST_AUTO_TEST_CASE(output_selection_bytecode_for_single_contract)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": ["abi"]
+				},
+				"fileA": {
+					"B": ["evm.deployedBytecode.object"]
+				}
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public {} } contract C { } contract B { function g() public { new C(); } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	for (char const* name: {"A", "B", "C"})
+		BOOST_CHECK(getContractResult(result, "fileA", name)["abi"].isArray());
+	BOOST_CHECK(!getContractResult(result, "fileA", "A").isMember("evm"));
+	BOOST_CHECK(!getContractResult(result, "fileA", "C").isMember("evm"));
+	Json::Value contract = getContractResult(result, "fileA", "B");
+	BOOST_REQUIRE(contract["evm"]["deployedBytecode"]["object"].isString());
+	BOOST_CHECK(!contract["evm"]["deployedBytecode"]["object"].asString().empty());
+}
+
+BOOST_AUTO_TEST_CASE(output_selection_source_map_binary)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": {
+					"A": ["evm.bytecode", "evm.deployedBytecode.sourceMapBinary"],
+					"B": ["*"]
+				}
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public {} } contract B { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract["evm"]["bytecode"]["sourceMap"].isString());
+	BOOST_CHECK(!contract["evm"]["bytecode"].isMember("sourceMapBinary"));
+	BOOST_REQUIRE(contract["evm"]["deployedBytecode"]["sourceMapBinary"].isString());
+	BOOST_CHECK(!contract["evm"]["deployedBytecode"]["sourceMapBinary"].asString().empty());
+	BOOST_CHECK(!getContractResult(result, "fileA", "B")["evm"]["bytecode"].isMember("sourceMapBinary"));
+}
+
 BOOST_AUTO_TEST_CASE(output_selection_dependent_contract)
 {
 	char const* input = R"(
@@ -1234,6 +1342,71 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_details_cse_across_blocks)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata" ] }
+			},
+			"optimizer": { "details": {
+				"cse" : true,
+				"cseAcrossBlocks" : true
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public returns (uint) { require(x > 1); return x + 1; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& details = metadata["settings"]["optimizer"]["details"];
+	BOOST_CHECK(details["cse"].asBool() == true);
+	BOOST_CHECK(details["cseAcrossBlocks"].asBool() == true);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_details_yul_gas_costs)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata" ] }
+			},
+			"optimizer": { "details": {
+				"yul" : true,
+				"yulDetails": { "gasCosts": true }
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public returns (uint) { return x + 1; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails["gasCosts"].asBool() == true);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1755,6 +1928,718 @@ BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract_yul)
 	BOOST_REQUIRE(result["sources"].size() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(debug_timing_invalid_type)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"debug": { "timing": "yes" }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "settings.debug.timing must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(debug_timing)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "A.sol": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"debug": { "timing": true },
+			"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["timing"].isArray());
+
+	set<string> phases;
+	for (Json::Value const& phase: result["timing"])
+	{
+		BOOST_REQUIRE(phase["name"].isString());
+		BOOST_CHECK(phase["invocations"].asUInt() >= 1);
+		BOOST_CHECK(phase["wallTimeMs"].isDouble());
+		phases.insert(phase["name"].asString());
+	}
+	BOOST_CHECK(phases.count("Parsing"));
+	BOOST_CHECK(phases.count("Analysis"));
+	BOOST_CHECK(phases.count("Code generation"));
+
+	char const* inputWithoutTiming = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "A.sol": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } }
+	}
+	)";
+	BOOST_CHECK(!compile(inputWithoutTiming).isMember("timing"));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_invalid_type)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"parallelism": -1
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be an unsigned integer."));
+}
+
+BOOST_AUTO_TEST_CASE(lazy_analysis)
+{
+	string const sources = R"(
+		"A.sol": { "content": "pragma solidity >=0.0; contract A { function f() public pure returns (uint) { return 1; } }" },
+		"B.sol": { "content": "pragma solidity >=0.0; import \"A.sol\"; import \"V.sol\"; contract B is A { function g() public view returns (uint) { return 2; } }" },
+		"V.sol": { "content": "pragma solidity >=0.0; contract V { function h() public view returns (uint) { return 3; } }" }
+	)";
+	auto compileLazily = [&](bool _lazyAnalysis)
+	{
+		return compile(
+			"{\"language\": \"Solidity\", \"sources\": {" + sources + "}, \"settings\": {"
+			"\"lazyAnalysis\": " + (_lazyAnalysis ? "true" : "false") + ", "
+			"\"outputSelection\": {\"B.sol\": {\"B\": [\"evm.bytecode.object\"]}}"
+			"}}"
+		);
+	};
+	auto mutabilityWarnings = [](Json::Value const& _result)
+	{
+		set<string> files;
+		for (auto const& error: _result["errors"])
+			if (error["message"].asString().find("can be restricted to pure") != string::npos)
+				files.insert(error["sourceLocation"]["file"].asString());
+		return files;
+	};
+	Json::Value full = compileLazily(false);
+	Json::Value lazy = compileLazily(true);
+	BOOST_REQUIRE(containsAtMostWarnings(full));
+	BOOST_REQUIRE(containsAtMostWarnings(lazy));
+	BOOST_CHECK(mutabilityWarnings(full) == (set<string>{"B.sol", "V.sol"}));
+	BOOST_CHECK(mutabilityWarnings(lazy) == (set<string>{"B.sol"}));
+	BOOST_CHECK_EQUAL(
+		util::jsonCompactPrint(lazy["contracts"]),
+		util::jsonCompactPrint(full["contracts"])
+	);
+}
+
+BOOST_AUTO_TEST_CASE(deferred_parsing)
+{
+	auto compileDeferred = [&](bool _deferredParsing, string const& _unusedBody)
+	{
+		string const sources = R"(
+			"A.sol": { "content": "pragma solidity >=0.0; library L { function g() internal pure returns (uint) { return 1; } function h() internal pure returns (uint) { )" + _unusedBody + R"( } } contract A { function f() public pure returns (uint) { return L.g(); } }" },
+			"B.sol": { "content": "pragma solidity >=0.0; import \"A.sol\"; import \"U.sol\"; contract B is A { function k() public pure returns (uint) { return f() + 2; } }" },
+			"U.sol": { "content": "pragma solidity >=0.0; contract U { function u() public pure returns (uint) { )" + _unusedBody + R"( } }" }
+		)";
+		return compile(
+			"{\"language\": \"Solidity\", \"sources\": {" + sources + "}, \"settings\": {"
+			"\"deferredParsing\": " + (_deferredParsing ? "true" : "false") + ", "
+			"\"metadata\": {\"bytecodeHash\": \"none\"}, "
+			"\"outputSelection\": {\"B.sol\": {\"B\": [\"evm.bytecode.object\"]}}"
+			"}}"
+		);
+	};
+	Json::Value valid = compileDeferred(false, "return 2;");
+	BOOST_REQUIRE(containsAtMostWarnings(valid));
+	BOOST_CHECK(!containsAtMostWarnings(compileDeferred(false, "return 2 +;")));
+	Json::Value deferred = compileDeferred(true, "return 2 +;");
+	BOOST_REQUIRE(containsAtMostWarnings(deferred));
+	BOOST_CHECK_EQUAL(
+		util::jsonCompactPrint(deferred["contracts"]),
+		util::jsonCompactPrint(valid["contracts"])
+	);
+}
+
+BOOST_AUTO_TEST_CASE(low_memory)
+{
+	string const sources = R"(
+		"A.sol": { "content": "pragma solidity >=0.0; contract A { uint x; function f() public { x = 1; } }" },
+		"B.sol": { "content": "pragma solidity >=0.0; import \"A.sol\"; contract B { function f() public returns (A) { return new A(); } }" },
+		"C.sol": { "content": "pragma solidity >=0.0; import \"B.sol\"; abstract contract Base { function g() public returns (A) { return new A(); } } contract C is Base { function h() public returns (B) { return new B(); } }" }
+	)";
+	for (bool viaIR: {false, true})
+		for (unsigned parallelism: {1, 2})
+		{
+			auto compileWithLowMemory = [&](bool _lowMemory)
+			{
+				return compile(
+					"{\"language\": \"Solidity\", \"sources\": {" + sources + "}, \"settings\": {"
+					"\"lowMemory\": " + (_lowMemory ? "true" : "false") + ", "
+					"\"parallelism\": " + to_string(parallelism) + ", "
+					"\"viaIR\": " + (viaIR ? "true" : "false") + ", "
+					"\"outputSelection\": {\"*\": {\"*\": [\"abi\", \"metadata\", \"evm.bytecode.object\", \"evm.bytecode.sourceMap\", "
+					"\"evm.deployedBytecode.object\", \"evm.deployedBytecode.sourceMap\"]}}"
+					"}}"
+				);
+			};
+			Json::Value full = compileWithLowMemory(false);
+			Json::Value lowMemory = compileWithLowMemory(true);
+			BOOST_REQUIRE(containsAtMostWarnings(full));
+			BOOST_REQUIRE(containsAtMostWarnings(lowMemory));
+			BOOST_CHECK_EQUAL(
+				util::jsonCompactPrint(lowMemory["contracts"]),
+				util::jsonCompactPrint(full["contracts"])
+			);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_work_budget)
+{
+	namespace fs = boost::filesystem;
+	fs::path const cacheDirectory = fs::temp_directory_path() / fs::unique_path("solc-cache-test-%%%%-%%%%-%%%%");
+	string const source = R"("A.sol": { "content": "pragma solidity >=0.0; contract A { uint[] x; function f(uint a) public returns (uint) { for (uint i = 0; i < a; i++) x.push(i * a); return x.length; } }" })";
+	auto compileWithBudget = [&](bool _viaIR, string const& _workBudget, bool _useCache = false)
+	{
+		return compile(
+			"{\"language\": \"Solidity\", \"sources\": {" + source + "}, \"settings\": {"
+			"\"optimizer\": {\"enabled\": true, \"details\": {\"yul\": true, \"workBudget\": " + _workBudget + "}}, "
+			"\"viaIR\": " + (_viaIR ? "true" : "false") + ", " +
+			(_useCache ? "\"cache\": {\"directory\": \"" + cacheDirectory.generic_string() + "\"}, " : "") +
+			"\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\"]}}"
+			"}}"
+		);
+	};
+	auto budgetExhausted = [](Json::Value const& _result)
+	{
+		for (auto const& error: _result["errors"])
+			if (error["errorCode"].asString() == "6429")
+				return true;
+		return false;
+	};
+	for (bool viaIR: {false, true})
+	{
+		Json::Value exhausted = compileWithBudget(viaIR, "0");
+		BOOST_REQUIRE(containsAtMostWarnings(exhausted));
+		BOOST_CHECK(budgetExhausted(exhausted));
+		BOOST_CHECK(!getContractResult(exhausted, "A.sol", "A")["evm"]["bytecode"]["object"].asString().empty());
+
+		Json::Value unlimited = compileWithBudget(viaIR, "1000000000");
+		BOOST_REQUIRE(containsAtMostWarnings(unlimited));
+		BOOST_CHECK(!budgetExhausted(unlimited));
+
+		// The warning is also reported if the code is taken from the cache.
+		Json::Value cold = compileWithBudget(viaIR, "0", true);
+		Json::Value warm = compileWithBudget(viaIR, "0", true);
+		BOOST_REQUIRE(containsAtMostWarnings(warm));
+		BOOST_CHECK(budgetExhausted(cold));
+		BOOST_CHECK(budgetExhausted(warm));
+		BOOST_CHECK_EQUAL(
+			util::jsonCompactPrint(warm["contracts"]),
+			util::jsonCompactPrint(exhausted["contracts"])
+		);
+		fs::remove_all(cacheDirectory);
+	}
+	BOOST_CHECK(containsError(
+		compileWithBudget(false, "-1"),
+		"JSONError",
+		"\"settings.optimizer.details.workBudget\" must be an unsigned integer."
+	));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_subroutines)
+{
+	string const source = R"("A.sol": { "content": "pragma solidity >=0.0; contract A { uint[] x; modifier nonZero(uint a) { require(a != 0); _; } function g(uint a) internal pure returns (uint) { return a * 2 + 1; } function f(uint a) public nonZero(a) returns (uint) { for (uint i = 0; i < a; i++) x.push(g(i)); require(x.length < 100); return g(x.length); } function h(uint a) public nonZero(a) returns (uint) { return g(g(a)); } }" })";
+	auto compileWithSettings = [&](string const& _evmVersion, string const& _details)
+	{
+		return compile(
+			"{\"language\": \"Solidity\", \"sources\": {" + source + "}, \"settings\": {"
+			"\"evmVersion\": \"" + _evmVersion + "\", "
+			"\"optimizer\": {\"enabled\": true, \"details\": {" + _details + "}}, "
+			"\"outputSelection\": {\"*\": {\"*\": [\"evm.assembly\"]}}"
+			"}}"
+		);
+	};
+	auto usesSubroutines = [](Json::Value const& _result)
+	{
+		string const assembly = getContractResult(_result, "A.sol", "A")["evm"]["assembly"].asString();
+		return assembly.find("beginsub") != string::npos && assembly.find("jumpsub") != string::npos;
+	};
+
+	// Subroutines are only used if requested.
+	Json::Value berlin = compileWithSettings("berlin", "");
+	BOOST_REQUIRE(containsAtMostWarnings(berlin));
+	BOOST_CHECK(!usesSubroutines(berlin));
+	Json::Value istanbul = compileWithSettings("istanbul", "\"subroutines\": true");
+	BOOST_REQUIRE(containsAtMostWarnings(istanbul));
+	BOOST_CHECK(!usesSubroutines(istanbul));
+
+	// The opcode-based optimiser steps that move or share code have to keep the subroutine entries intact.
+	for (char const* details: {
+		"\"subroutines\": true",
+		"\"subroutines\": true, \"blockReorderer\": true",
+		"\"subroutines\": true, \"outliner\": true",
+		"\"subroutines\": true, \"cseAcrossBlocks\": true",
+		"\"subroutines\": true, \"blockReorderer\": true, \"outliner\": true, \"cseAcrossBlocks\": true, \"modifierOutliner\": true"
+	})
+	{
+		Json::Value result = compileWithSettings("berlin", details);
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+		BOOST_CHECK(usesSubroutines(result));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(targets)
+{
+	string const sources = R"(
+		"A.sol": { "content": "pragma solidity >=0.0; contract A { uint x; function f() public { x = 1; } }" },
+		"B.sol": { "content": "pragma solidity >=0.0; import \"A.sol\"; contract B { function f() public returns (A) { return new A(); } }" }
+	)";
+	auto compileWithSettings = [&](string const& _settings)
+	{
+		return compile(
+			"{\"language\": \"Solidity\", \"sources\": {" + sources + "}, \"settings\": {" + _settings +
+			"\"outputSelection\": {\"*\": {\"*\": [\"metadata\", \"evm.bytecode.object\", \"evm.deployedBytecode.object\"]}}"
+			"}}"
+		);
+	};
+	Json::Value result = compileWithSettings(
+		"\"evmVersion\": \"byzantium\", "
+		"\"targets\": [{\"evmVersion\": \"istanbul\", \"optimizer\": {\"enabled\": true, \"runs\": 1000}}, {\"viaIR\": true}], "
+	);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["targets"].isArray());
+	BOOST_REQUIRE_EQUAL(result["targets"].size(), 2);
+
+	Json::Value const expectations[] = {
+		compileWithSettings("\"evmVersion\": \"byzantium\", "),
+		compileWithSettings("\"evmVersion\": \"istanbul\", \"optimizer\": {\"enabled\": true, \"runs\": 1000}, "),
+		compileWithSettings("\"evmVersion\": \"byzantium\", \"viaIR\": true, ")
+	};
+	Json::Value const* outputs[] = {&result, &result["targets"][0], &result["targets"][1]};
+	for (size_t i = 0; i < 3; ++i)
+	{
+		BOOST_REQUIRE(containsAtMostWarnings(expectations[i]));
+		for (string contract: {"A", "B"})
+		{
+			string const file = contract + ".sol";
+			Json::Value const& expected = getContractResult(expectations[i], file, contract);
+			Json::Value const& actual = getContractResult(*outputs[i], file, contract);
+			BOOST_CHECK(actual["metadata"] == expected["metadata"]);
+			BOOST_CHECK(actual["evm"]["bytecode"]["object"] == expected["evm"]["bytecode"]["object"]);
+			BOOST_CHECK(actual["evm"]["deployedBytecode"]["object"] == expected["evm"]["deployedBytecode"]["object"]);
+		}
+	}
+	BOOST_CHECK(result["targets"][0]["contracts"]["A.sol"]["A"]["metadata"].asString().find("\"istanbul\"") != string::npos);
+
+	BOOST_CHECK(containsError(
+		compileWithSettings("\"evmVersion\": \"istanbul\", \"targets\": [{\"evmVersion\": \"byzantium\"}], "),
+		"JSONError",
+		"The EVM version of a target must not be older than \"settings.evmVersion\", which is used for the analysis."
+	));
+	BOOST_CHECK(containsError(
+		compileWithSettings("\"targets\": [{\"runs\": 1}], "),
+		"JSONError",
+		"Unknown key \"runs\""
+	));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_code_generation)
+{
+	string const sources = R"(
+		"A.sol": { "content": "pragma solidity >=0.0; contract A { uint x; function f() public { x = 1; } }" },
+		"B.sol": { "content": "pragma solidity >=0.0; import \"A.sol\"; contract B { function f() public returns (A) { return new A(); } }" },
+		"C.sol": { "content": "pragma solidity >=0.0; import \"B.sol\"; abstract contract Base { function g() public returns (A) { return new A(); } } contract C is Base { function h() public returns (B) { return new B(); } }" },
+		"D.sol": { "content": "pragma solidity >=0.0; contract D { function f(uint a) public pure returns (uint) { return a * 2; } }" }
+	)";
+	for (bool viaIR: {false, true})
+	{
+		auto compileWithParallelism = [&](unsigned _parallelism)
+		{
+			return compile(
+				"{\"language\": \"Solidity\", \"sources\": {" + sources + "}, \"settings\": {"
+				"\"parallelism\": " + to_string(_parallelism) + ", "
+				"\"viaIR\": " + (viaIR ? "true" : "false") + ", "
+				"\"optimizer\": {\"enabled\": true}, "
+				"\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\", \"evm.deployedBytecode.object\"]}}"
+				"}}"
+			);
+		};
+		Json::Value sequential = compileWithParallelism(1);
+		BOOST_REQUIRE(containsAtMostWarnings(sequential));
+		for (unsigned parallelism: {2u, 4u, 0u})
+		{
+			Json::Value parallel = compileWithParallelism(parallelism);
+			BOOST_REQUIRE(containsAtMostWarnings(parallel));
+			BOOST_CHECK_EQUAL(
+				util::jsonCompactPrint(parallel["contracts"]),
+				util::jsonCompactPrint(sequential["contracts"])
+			);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing)
+{
+	string const sources = R"(
+		"A.sol": { "content": "pragma solidity >=0.0; import \"B.sol\"; contract A is B { function f() public { x = 1; } }" },
+		"B.sol": { "content": "pragma solidity >=0.0; import \"C.sol\"; contract B is C { uint x; }" },
+		"C.sol": { "content": "pragma solidity >=0.0; contract C { function g(uint a) public pure returns (uint) { return a * 2; } }" }
+	)";
+	string const invalidSource = R"(,
+		"D.sol": { "content": "pragma solidity >=0.0; contract D { event E(uint); function f() public { emit E(1) } }" }
+	)";
+	auto compileWithParallelism = [&](string const& _sources, unsigned _parallelism)
+	{
+		return compile(
+			"{\"language\": \"Solidity\", \"sources\": {" + _sources + "}, \"settings\": {"
+			"\"parallelism\": " + to_string(_parallelism) + ", "
+			"\"outputSelection\": {\"*\": {\"\": [\"ast\"]}}"
+			"}}"
+		);
+	};
+	Json::Value sequential = compileWithParallelism(sources, 1);
+	BOOST_REQUIRE(containsAtMostWarnings(sequential));
+	Json::Value sequentialInvalid = compileWithParallelism(sources + invalidSource, 1);
+	BOOST_REQUIRE(containsError(sequentialInvalid, "ParserError", "Expected ';' but got '}'"));
+	for (unsigned parallelism: {2u, 4u, 0u})
+	{
+		BOOST_CHECK_EQUAL(
+			util::jsonCompactPrint(compileWithParallelism(sources, parallelism)),
+			util::jsonCompactPrint(sequential)
+		);
+		BOOST_CHECK_EQUAL(
+			util::jsonCompactPrint(compileWithParallelism(sources + invalidSource, parallelism)),
+			util::jsonCompactPrint(sequentialInvalid)
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_analysis)
+{
+	string const sources = R"(
+		"A.sol": { "content": "pragma solidity >=0.0; contract A { function f() public pure { uint x; } }" },
+		"B.sol": { "content": "pragma solidity >=0.0; import \"A.sol\"; contract B is A { function g() public pure returns (uint) { revert(); return 1; } }" },
+		"C.sol": { "content": "pragma solidity >=0.0; contract C { function h(uint a) public pure { a; } function i() public view returns (bytes32) { return blockhash(0); } }" }
+	)";
+	auto compileWithParallelism = [&](unsigned _parallelism)
+	{
+		return compile(
+			"{\"language\": \"Solidity\", \"sources\": {" + sources + "}, \"settings\": {"
+			"\"parallelism\": " + to_string(_parallelism) + ", "
+			"\"outputSelection\": {\"*\": {\"\": [\"ast\"]}}"
+			"}}"
+		);
+	};
+	Json::Value sequential = compileWithParallelism(1);
+	BOOST_REQUIRE(containsAtMostWarnings(sequential));
+	BOOST_REQUIRE(sequential["errors"].size() >= 3);
+	for (unsigned parallelism: {2u, 4u, 0u})
+		BOOST_CHECK_EQUAL(
+			util::jsonCompactPrint(compileWithParallelism(parallelism)["errors"]),
+			util::jsonCompactPrint(sequential["errors"])
+		);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_contract_outputs)
+{
+	string const sources = R"(
+		"A.sol": { "content": "pragma solidity >=0.0; /// @title A\n contract A { uint x; /// @notice Sets x.\n function f(uint a) public { x = a; } }" },
+		"B.sol": { "content": "pragma solidity >=0.0; import \"A.sol\"; /// @author B\n contract B is A { event E(uint); function g() public { emit E(1); } }" },
+		"C.sol": { "content": "pragma solidity >=0.0; contract C { struct S { uint8 a; uint b; } S s; /// @dev Returns twice a.\n function h(uint a) public pure returns (uint) { return a * 2; } }" }
+	)";
+	for (bool compileContracts: {false, true})
+	{
+		auto compileWithParallelism = [&](unsigned _parallelism)
+		{
+			return compile(
+				"{\"language\": \"Solidity\", \"sources\": {" + sources + "}, \"settings\": {"
+				"\"parallelism\": " + to_string(_parallelism) + ", "
+				"\"outputSelection\": {\"*\": {\"*\": [\"abi\", \"storageLayout\", \"metadata\", \"userdoc\", \"devdoc\"" +
+				(compileContracts ? ", \"evm.bytecode\", \"evm.deployedBytecode\"" : "") +
+				"]}}}}"
+			);
+		};
+		Json::Value sequential = compileWithParallelism(1);
+		BOOST_REQUIRE(containsAtMostWarnings(sequential));
+		BOOST_REQUIRE(sequential["contracts"]["B.sol"]["B"]["metadata"].isString());
+		for (unsigned parallelism: {2u, 4u, 0u})
+		{
+			Json::Value parallel = compileWithParallelism(parallelism);
+			BOOST_REQUIRE(containsAtMostWarnings(parallel));
+			BOOST_CHECK_EQUAL(
+				util::jsonCompactPrint(parallel["contracts"]),
+				util::jsonCompactPrint(sequential["contracts"])
+			);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_yul_optimisation)
+{
+	string const object =
+		"object \\\"a\\\" { "
+			"code { let x := calldataload(0) sstore(add(x, 1), mul(x, 2)) "
+				"datacopy(0, dataoffset(\\\"b\\\"), datasize(\\\"b\\\")) return(0, datasize(\\\"b\\\")) } "
+			"object \\\"b\\\" { "
+				"code { let y := calldataload(4) if lt(y, 10) { sstore(y, add(y, y)) } } "
+				"object \\\"c\\\" { code { sstore(0, add(calldataload(0), 0)) } } "
+			"} "
+			"object \\\"d\\\" { code { mstore(0, sub(calldataload(0), 0)) return(0, 32) } } "
+		"}";
+	auto compileWithParallelism = [&](unsigned _parallelism)
+	{
+		return compile(
+			"{\"language\": \"Yul\", \"sources\": {\"A\": {\"content\": \"" + object + "\"}}, \"settings\": {"
+			"\"parallelism\": " + to_string(_parallelism) + ", "
+			"\"optimizer\": {\"enabled\": true}, "
+			"\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\", \"irOptimized\"]}}"
+			"}}"
+		);
+	};
+	Json::Value sequential = compileWithParallelism(1);
+	BOOST_REQUIRE(containsAtMostWarnings(sequential));
+	BOOST_REQUIRE(sequential["contracts"]["A"]["a"]["evm"]["bytecode"]["object"].isString());
+	for (unsigned parallelism: {2u, 4u, 0u})
+	{
+		Json::Value parallel = compileWithParallelism(parallelism);
+		BOOST_REQUIRE(containsAtMostWarnings(parallel));
+		BOOST_CHECK_EQUAL(
+			util::jsonCompactPrint(parallel["contracts"]),
+			util::jsonCompactPrint(sequential["contracts"])
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_yul_function_optimisation)
+{
+	string const code =
+		"{ "
+			"sstore(0, f(calldataload(0))) sstore(1, g(calldataload(32), 7)) sstore(2, h(calldataload(64))) "
+			"function f(a) -> r { let b := add(a, 0) r := mul(b, 1) if gt(r, 3) { r := add(r, mload(0)) } } "
+			"function g(a, b) -> r { for { let i := 0 } lt(i, b) { i := add(i, 1) } { r := add(r, mul(a, i)) } } "
+			"function h(a) -> r { switch a case 0 { r := f(1) } default { r := g(a, sub(a, 0)) } } "
+		"}";
+	// The second sequence only contains function-local steps inside the brackets.
+	for (string const steps: {"dhfoDgvulfnTUtnIf[xarrscLMcCTU]jmul", "dhfoDgvulfnTUtnIf[sCTUcrtDIO]jmul"})
+	{
+		auto compileWithParallelism = [&](unsigned _parallelism)
+		{
+			return compile(
+				"{\"language\": \"Yul\", \"sources\": {\"A\": {\"content\": \"" + code + "\"}}, \"settings\": {"
+				"\"parallelism\": " + to_string(_parallelism) + ", "
+				"\"optimizer\": {\"enabled\": true, \"details\": {\"yul\": true, "
+				"\"yulDetails\": {\"optimizerSteps\": \"" + steps + "\"}}}, "
+				"\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\", \"irOptimized\"]}}"
+				"}}"
+			);
+		};
+		Json::Value sequential = compileWithParallelism(1);
+		BOOST_REQUIRE(containsAtMostWarnings(sequential));
+		BOOST_REQUIRE(sequential["contracts"]["A"]["object"]["irOptimized"].isString());
+		for (unsigned parallelism: {2u, 8u})
+		{
+			Json::Value parallel = compileWithParallelism(parallelism);
+			BOOST_REQUIRE(containsAtMostWarnings(parallel));
+			BOOST_CHECK_EQUAL(
+				util::jsonCompactPrint(parallel["contracts"]),
+				util::jsonCompactPrint(sequential["contracts"])
+			);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(alternative_yul_optimizer_steps)
+{
+	string const code =
+		"{ "
+			"sstore(0, f(calldataload(0))) sstore(1, f(calldataload(32))) "
+			"function f(a) -> r { for { let i := 0 } lt(i, a) { i := add(i, 1) } { r := add(r, mul(a, i)) } } "
+		"}";
+	auto compileWithSteps = [&](string const& _alternatives, unsigned _parallelism)
+	{
+		return compile(
+			"{\"language\": \"Yul\", \"sources\": {\"A\": {\"content\": \"" + code + "\"}}, \"settings\": {"
+			"\"parallelism\": " + to_string(_parallelism) + ", "
+			"\"optimizer\": {\"enabled\": true, \"details\": {\"yul\": true, "
+			"\"yulDetails\": {\"optimizerSteps\": \"dhfoDgvulfnTUtnIf[xarrscLMcCTU]jmul\", "
+			"\"alternativeOptimizerSteps\": " + _alternatives + "}}}, "
+			"\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\", \"irOptimized\"]}}"
+			"}}"
+		);
+	};
+
+	BOOST_CHECK(containsError(
+		compileWithSteps("\"dhfoD\"", 1),
+		"JSONError",
+		"\"settings.optimizer.details.yulDetails.alternativeOptimizerSteps\" must be an array of strings."
+	));
+	BOOST_CHECK(containsError(
+		compileWithSteps("[\"dhfo[D\"]", 1),
+		"JSONError",
+		"Invalid optimizer step sequence in \"settings.optimizer.details.yulDetails.alternativeOptimizerSteps\": Unbalanced brackets"
+	));
+
+	Json::Value sequential = compileWithSteps("[\"dhfoD\", \"dhfoDgvulfnTUtnIf[xarrscLMcCTU]uljmul\"]", 1);
+	BOOST_REQUIRE(containsAtMostWarnings(sequential));
+	BOOST_REQUIRE(sequential["contracts"]["A"]["object"]["irOptimized"].isString());
+	for (unsigned parallelism: {2u, 8u})
+	{
+		Json::Value parallel = compileWithSteps("[\"dhfoD\", \"dhfoDgvulfnTUtnIf[xarrscLMcCTU]uljmul\"]", parallelism);
+		BOOST_REQUIRE(containsAtMostWarnings(parallel));
+		BOOST_CHECK_EQUAL(
+			util::jsonCompactPrint(parallel["contracts"]),
+			util::jsonCompactPrint(sequential["contracts"])
+		);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cache_invalid_settings)
+{
+	auto compileWithCacheSettings = [](string const& _cacheSettings)
+	{
+		return compile(R"({
+			"language": "Solidity",
+			"sources": { "": { "content": "pragma solidity >=0.0; contract C {}" } },
+			"settings": { "cache": )" + _cacheSettings + R"( }
+		})");
+	};
+	BOOST_CHECK(containsError(compileWithCacheSettings("\"dir\""), "JSONError", "\"settings.cache\" must be an object."));
+	BOOST_CHECK(containsError(compileWithCacheSettings("{\"dir\": \"x\"}"), "JSONError", "Unknown key \"dir\""));
+	BOOST_CHECK(containsError(compileWithCacheSettings("{}"), "JSONError", "\"settings.cache.directory\" must be a non-empty string."));
+	BOOST_CHECK(containsError(compileWithCacheSettings("{\"directory\": 7}"), "JSONError", "\"settings.cache.directory\" must be a non-empty string."));
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	namespace fs = boost::filesystem;
+	fs::path const cacheDirectory = fs::temp_directory_path() / fs::unique_path("solc-cache-test-%%%%-%%%%-%%%%");
+	auto cacheEntries = [&]()
+	{
+		vector<fs::path> entries;
+		if (fs::exists(cacheDirectory))
+			for (fs::directory_entry const& entry: fs::directory_iterator(cacheDirectory))
+				entries.push_back(entry.path());
+		return entries;
+	};
+
+	for (bool viaIR: {false, true})
+	{
+		auto compileWithCache = [&](string const& _outputs, bool _useCache)
+		{
+			return compile(
+				R"({
+					"language": "Solidity",
+					"sources": {
+						"A.sol": { "content": "pragma solidity >=0.0; contract A { uint immutable x = 1; function f() public view returns (uint) { return x; } }" },
+						"B.sol": { "content": "pragma solidity >=0.0; import \"A.sol\"; contract B { function f() public returns (A) { return new A(); } }" }
+					},
+					"settings": {
+						"viaIR": )" + string(viaIR ? "true" : "false") + R"(,
+						)" + (_useCache ? "\"cache\": {\"directory\": \"" + cacheDirectory.generic_string() + "\"}," : "") + R"(
+						"outputSelection": { "*": { "*": [)" + _outputs + R"(] } }
+					}
+				})"
+			);
+		};
+		string const outputs = R"("metadata", "evm.bytecode", "evm.deployedBytecode")";
+
+		// Outputs generated from the assembly are not available from the cache.
+		BOOST_REQUIRE(containsAtMostWarnings(compileWithCache(R"("evm.gasEstimates")", true)));
+		BOOST_CHECK(cacheEntries().empty());
+
+		Json::Value uncached = compileWithCache(outputs, false);
+		BOOST_REQUIRE(containsAtMostWarnings(uncached));
+		Json::Value cold = compileWithCache(outputs, true);
+		BOOST_REQUIRE(containsAtMostWarnings(cold));
+		BOOST_CHECK_EQUAL(util::jsonCompactPrint(cold["contracts"]), util::jsonCompactPrint(uncached["contracts"]));
+		BOOST_REQUIRE_EQUAL(cacheEntries().size(), 2);
+
+		Json::Value warm = compileWithCache(outputs, true);
+		BOOST_REQUIRE(containsAtMostWarnings(warm));
+		BOOST_CHECK_EQUAL(util::jsonCompactPrint(warm["contracts"]), util::jsonCompactPrint(uncached["contracts"]));
+
+		// Modify the entries to check that the code is really taken from the cache.
+		for (fs::path const& path: cacheEntries())
+		{
+			Json::Value entry;
+			BOOST_REQUIRE(util::jsonParseStrict(util::readFileAsString(path.string()), entry));
+			entry["runtimeObject"]["bytecode"] = "fe";
+			ofstream(path.string(), ios::trunc) << util::jsonCompactPrint(entry);
+		}
+		Json::Value modified = compileWithCache(outputs, true);
+		BOOST_REQUIRE(containsAtMostWarnings(modified));
+		BOOST_CHECK_EQUAL(modified["contracts"]["A.sol"]["A"]["evm"]["deployedBytecode"]["object"], "fe");
+		BOOST_CHECK_EQUAL(modified["contracts"]["B.sol"]["B"]["evm"]["deployedBytecode"]["object"], "fe");
+		BOOST_CHECK_EQUAL(modified["contracts"]["B.sol"]["B"]["metadata"], uncached["contracts"]["B.sol"]["B"]["metadata"]);
+
+		fs::remove_all(cacheDirectory);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_cache)
+{
+	namespace fs = boost::filesystem;
+	fs::path const cacheDirectory = fs::temp_directory_path() / fs::unique_path("solc-smt-cache-test-%%%%-%%%%-%%%%");
+	auto cacheEntries = [&]()
+	{
+		vector<fs::path> entries;
+		if (fs::exists(cacheDirectory))
+			for (fs::directory_entry const& entry: fs::directory_iterator(cacheDirectory))
+				entries.push_back(entry.path());
+		return entries;
+	};
+	auto compileWithCache = [&](string const& _cache)
+	{
+		return compile(R"({
+			"language": "Solidity",
+			"sources": { "": { "content": "pragma solidity >=0.0; pragma experimental SMTChecker; contract C { function f(uint x) public pure { assert(x > 0); } }" } },
+			"settings": { "modelChecker": { "cache": )" + _cache + R"( } }
+		})");
+	};
+	auto formalWarnings = [](Json::Value const& _result)
+	{
+		vector<string> warnings;
+		for (auto const& error: _result["errors"])
+			if (boost::starts_with(error["message"].asString(), "CHC:") || boost::starts_with(error["message"].asString(), "BMC:"))
+				warnings.push_back(error["message"].asString());
+		return warnings;
+	};
+
+	BOOST_CHECK(containsError(compileWithCache("7"), "JSONError", "settings.modelChecker.cache must be a non-empty string."));
+	BOOST_CHECK(containsError(compileWithCache("\"\""), "JSONError", "settings.modelChecker.cache must be a non-empty string."));
+
+	string const cache = "\"" + cacheDirectory.generic_string() + "\"";
+	Json::Value cold = compileWithCache(cache);
+	BOOST_REQUIRE(containsAtMostWarnings(cold));
+	// Nothing is stored if no solver is available.
+	if (cacheEntries().empty())
+		return;
+	Json::Value warm = compileWithCache(cache);
+	BOOST_REQUIRE(containsAtMostWarnings(warm));
+	BOOST_CHECK(formalWarnings(warm) == formalWarnings(cold));
+	BOOST_CHECK(!formalWarnings(warm).empty());
+
+	// Turn the stored counterexamples into proofs to check that the results are taken from the cache.
+	for (fs::path const& path: cacheEntries())
+	{
+		Json::Value entry;
+		BOOST_REQUIRE(util::jsonParseStrict(util::readFileAsString(path.string()), entry));
+		entry["result"] = "unsat";
+		ofstream(path.string(), ios::trunc) << util::jsonCompactPrint(entry);
+	}
+	Json::Value modified = compileWithCache(cache);
+	BOOST_REQUIRE(containsAtMostWarnings(modified));
+	BOOST_CHECK(formalWarnings(modified).empty());
+
+	fs::remove_all(cacheDirectory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -14,9 +14,9 @@ contract C {
 }
 // ----
 // creation:
-//   codeDepositCost: 1181400
-//   executionCost: 1227
-//   totalCost: 1182627
+//   codeDepositCost: 1147800
+//   executionCost: 1194
+//   totalCost: 1148994
 // external:
 //   a(): 1130
 //   b(uint256): infinite
@@ -17,9 +17,9 @@ contract C {
 // optimize-yul: true
 // ----
 // creation:
-//   codeDepositCost: 588800
+//   codeDepositCost: 583000
 //   executionCost: 619
-//   totalCost: 589419
+//   totalCost: 583619
 // external:
 //   a(): 1029
 //   b(uint256): 2084
@@ -0,0 +1,21 @@
+pragma abicoder v2;
+
+contract C {
+    function sum(uint[] memory a) public pure returns (uint s) {
+        for (uint i = 0; i < a.length; i++)
+            s += a[i];
+    }
+    function last(bytes32[3] memory a) public pure returns (bytes32) {
+        return a[2];
+    }
+    function nested(int[][] memory a) public pure returns (int) {
+        return a[1][0];
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// sum(uint256[]): 0x20, 3, 3, 4, 5 -> 12
+// sum(uint256[]): 0x20, 3, 3, 4 -> FAILURE
+// last(bytes32[3]): 1, 2, 0x33 -> 0x33
+// nested(int256[][]): 0x20, 2, 0x40, 0x80, 1, 7, 1, -9 -> -9
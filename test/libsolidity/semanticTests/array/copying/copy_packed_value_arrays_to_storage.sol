@@ -0,0 +1,34 @@
+pragma abicoder v2;
+
+contract C {
+    uint8[] a;
+    int64[] c;
+    uint16[5] b;
+
+    function setA(uint8[] calldata x) public returns (uint8[] memory) {
+        a = x;
+        return a;
+    }
+    function setC(int64[] memory x) public returns (int64[] memory) {
+        c = x;
+        return c;
+    }
+    function setB(uint16[3] memory x) public returns (uint16[5] memory) {
+        b[3] = 8;
+        b[4] = 9;
+        uint16[5] memory y;
+        y[0] = x[0];
+        y[1] = x[1];
+        y[2] = x[2];
+        b = y;
+        return b;
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// setA(uint8[]): 0x20, 3, 1, 2, 3 -> 0x20, 3, 1, 2, 3
+// setA(uint8[]): 0x20, 1, 7 -> 0x20, 1, 7
+// setC(int64[]): 0x20, 5, 1, -2, 3, -4, 5 -> 0x20, 5, 1, -2, 3, -4, 5
+// setC(int64[]): 0x20, 2, -1, 2 -> 0x20, 2, -1, 2
+// setB(uint16[3]): 1, 2, 3 -> 1, 2, 3, 0, 0
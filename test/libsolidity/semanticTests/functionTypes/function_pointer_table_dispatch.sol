@@ -0,0 +1,30 @@
+contract C {
+    function f0(uint x) internal pure returns (uint) { return x + 0; }
+    function f1(uint x) internal pure returns (uint) { return x + 1; }
+    function f2(uint x) internal pure returns (uint) { return x * 2; }
+    function f3(uint x) internal pure returns (uint) { return x * 3; }
+    function f4(uint x) internal pure returns (uint) { return x + 4; }
+    function f5(uint x) internal pure returns (uint) { return x * 5; }
+    function f6(uint x) internal pure returns (uint) { return x + 6; }
+    function f7(uint x) internal pure returns (uint) { return x * 7; }
+    function f8(uint x) internal pure returns (uint) { return x + 8; }
+    function f9(uint x) internal pure returns (uint) { return x * 9; }
+    function run(uint i, uint x) public pure returns (uint) {
+        function (uint) internal pure returns (uint)[10] memory table = [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9];
+        return table[i](x);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// run(uint256,uint256): 0, 10 -> 10
+// run(uint256,uint256): 1, 10 -> 11
+// run(uint256,uint256): 2, 10 -> 20
+// run(uint256,uint256): 3, 10 -> 30
+// run(uint256,uint256): 4, 10 -> 14
+// run(uint256,uint256): 5, 10 -> 50
+// run(uint256,uint256): 6, 10 -> 16
+// run(uint256,uint256): 7, 10 -> 70
+// run(uint256,uint256): 8, 10 -> 18
+// run(uint256,uint256): 9, 10 -> 90
+// run(uint256,uint256): 10, 10 -> FAILURE, hex"4e487b71", 0x32
@@ -0,0 +1,62 @@
+contract C {
+    function f(uint256 a) public returns (uint256 b) {
+        assembly {
+            switch a
+                case 1 { b := 100 }
+                case 3 { b := 101 }
+                case 5 { b := 102 }
+                case 7 { b := 103 }
+                case 9 { b := 104 }
+                case 11 { b := 105 }
+                case 13 { b := 106 }
+                case 15 { b := 107 }
+                case 17 { b := 108 }
+                case 19 { b := 109 }
+                case 21 { b := 110 }
+                case 23 { b := 111 }
+                case 25 { b := 112 }
+                case 27 { b := 113 }
+                case 29 { b := 114 }
+                case 31 { b := 115 }
+                default { b := 1 }
+        }
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(uint256): 0 -> 1
+// f(uint256): 1 -> 100
+// f(uint256): 2 -> 1
+// f(uint256): 3 -> 101
+// f(uint256): 4 -> 1
+// f(uint256): 5 -> 102
+// f(uint256): 6 -> 1
+// f(uint256): 7 -> 103
+// f(uint256): 8 -> 1
+// f(uint256): 9 -> 104
+// f(uint256): 10 -> 1
+// f(uint256): 11 -> 105
+// f(uint256): 12 -> 1
+// f(uint256): 13 -> 106
+// f(uint256): 14 -> 1
+// f(uint256): 15 -> 107
+// f(uint256): 16 -> 1
+// f(uint256): 17 -> 108
+// f(uint256): 18 -> 1
+// f(uint256): 19 -> 109
+// f(uint256): 20 -> 1
+// f(uint256): 21 -> 110
+// f(uint256): 22 -> 1
+// f(uint256): 23 -> 111
+// f(uint256): 24 -> 1
+// f(uint256): 25 -> 112
+// f(uint256): 26 -> 1
+// f(uint256): 27 -> 113
+// f(uint256): 28 -> 1
+// f(uint256): 29 -> 114
+// f(uint256): 30 -> 1
+// f(uint256): 31 -> 115
+// f(uint256): 32 -> 1
+// f(uint256): 33 -> 1
+// f(uint256): 0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff -> 1
@@ -0,0 +1,43 @@
+contract C {
+    struct Inner {
+        uint256 a;
+        uint256[2] b;
+        bytes c;
+    }
+    struct Outer {
+        uint256 x;
+        Inner inner;
+        Inner[2] inners;
+        uint256[] d;
+    }
+
+    function f() public pure returns (uint256, uint256, uint256, uint256, uint256, uint256) {
+        Outer memory o;
+        o.inner.b[1] = 7;
+        o.inners[1].b[0] = 8;
+        o.inners[0].a = 9;
+        return (o.x, o.inner.b[1], o.inners[1].b[0], o.inners[0].a, o.inners[0].c.length, o.d.length);
+    }
+
+    function g() public pure returns (uint256, uint256, uint256, uint256) {
+        Outer memory o1;
+        Outer memory o2;
+        o1.inners[1].b[1] = 3;
+        o2.inner.c = "abc";
+        return (o2.inners[1].b[1], o1.inners[1].b[1], o1.inner.c.length, o2.inner.c.length);
+    }
+
+    function h() public pure returns (uint256, uint256) {
+        uint256[3][2] memory a;
+        a[1][2] = 5;
+        bytes[2][2] memory b;
+        b[1][0] = "x";
+        return (a[1][2] + a[0][2], b[0][0].length + b[1][0].length + b[1][1].length);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f() -> 0, 7, 8, 9, 0, 0
+// g() -> 0, 3, 0, 3
+// h() -> 5, 1
@@ -0,0 +1,30 @@
+contract C {
+    struct S { uint8 a; uint16 b; address c; uint256 d; bool e; bytes4 f; }
+    S s;
+    S t;
+    function fromMemory(uint8 a, uint16 b, address c, uint256 d) public {
+        s = S(a, b, c, d, true, 0x12345678);
+    }
+    function fromCalldata(S calldata x) public {
+        s = x;
+    }
+    function fromStorage() public {
+        t = s;
+    }
+    function getS() public view returns (uint8, uint16, address, uint256, bool, bytes4) {
+        return (s.a, s.b, s.c, s.d, s.e, s.f);
+    }
+    function getT() public view returns (uint8, uint16, address, uint256, bool, bytes4) {
+        return (t.a, t.b, t.c, t.d, t.e, t.f);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// fromMemory(uint8,uint16,address,uint256): 0xab, 0x1234, 0xbeef, 77 ->
+// getS() -> 0xab, 0x1234, 0xbeef, 77, true, left(0x12345678)
+// fromStorage() ->
+// getT() -> 0xab, 0x1234, 0xbeef, 77, true, left(0x12345678)
+// fromCalldata((uint8,uint16,address,uint256,bool,bytes4)): 0x12, 0x3456, 0xcafe, 99, false, left(0x87654321) ->
+// getS() -> 0x12, 0x3456, 0xcafe, 99, false, left(0x87654321)
+// getT() -> 0xab, 0x1234, 0xbeef, 77, true, left(0x12345678)
@@ -5,7 +5,3 @@ contract C {
 	}
 }
 // ----
-// Warning 8364: (148-157): Assertion checker does not yet implement type type(uint256[] memory)
-// Warning 8364: (147-158): Assertion checker does not yet implement type type(uint256[] memory)
-// Warning 8364: (148-157): Assertion checker does not yet implement type type(uint256[] memory)
-// Warning 8364: (147-158): Assertion checker does not yet implement type type(uint256[] memory)
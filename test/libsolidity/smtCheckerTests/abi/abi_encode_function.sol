@@ -5,5 +5,3 @@ contract C {
 	}
 }
 // ----
-// Warning 6031: (86-92): Internal error: Expression undefined for SMT solver.
-// Warning 6031: (86-92): Internal error: Expression undefined for SMT solver.
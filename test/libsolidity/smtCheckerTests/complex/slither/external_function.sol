@@ -83,10 +83,3 @@ contract InternalCall {
 // Warning 2018: (1144-1206): Function state mutability can be restricted to pure
 // Warning 2018: (1212-1274): Function state mutability can be restricted to pure
 // Warning 2018: (1280-1342): Function state mutability can be restricted to pure
-// Warning 4588: (714-749): Assertion checker does not yet implement this type of function call.
-// Warning 4588: (760-815): Assertion checker does not yet implement this type of function call.
-// Warning 4588: (887-919): Assertion checker does not yet implement this type of function call.
-// Warning 4588: (714-749): Assertion checker does not yet implement this type of function call.
-// Warning 4588: (760-815): Assertion checker does not yet implement this type of function call.
-// Warning 4588: (887-919): Assertion checker does not yet implement this type of function call.
-// Warning 5729: (1403-1408): BMC does not yet implement this type of function call.
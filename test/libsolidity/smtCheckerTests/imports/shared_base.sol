@@ -0,0 +1,29 @@
+==== Source: base ====
+pragma experimental SMTChecker;
+contract Base {
+	uint x;
+	function inc() public {
+		require(x < 10);
+		++x;
+	}
+}
+==== Source: der1 ====
+pragma experimental SMTChecker;
+import "base";
+contract Der1 is Base {
+	function g() public view {
+		assert(x < 10);
+	}
+}
+==== Source: der2 ====
+pragma experimental SMTChecker;
+import "base";
+contract Der2 is Base {
+	function h() public view {
+		assert(x <= 10);
+	}
+}
+// ====
+// SMTIgnoreCex: yes
+// ----
+// Warning 6328: (der1:101-115): CHC: Assertion violation happens here.
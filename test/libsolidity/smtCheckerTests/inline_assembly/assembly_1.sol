@@ -21,4 +21,3 @@ contract C {
 // Warning 7737: (103-122): Inline assembly may cause SMTChecker to produce spurious warnings (false positives).
 // Warning 7737: (103-122): Inline assembly may cause SMTChecker to produce spurious warnings (false positives).
 // Warning 7737: (103-122): Inline assembly may cause SMTChecker to produce spurious warnings (false positives).
-// Warning 7737: (103-122): Inline assembly may cause SMTChecker to produce spurious warnings (false positives).
@@ -8,5 +8,3 @@ contract C
 	}
 }
 // ----
-// Warning 7737: (76-90): Inline assembly may cause SMTChecker to produce spurious warnings (false positives).
-// Warning 7737: (76-90): Inline assembly may cause SMTChecker to produce spurious warnings (false positives).
@@ -0,0 +1,15 @@
+pragma experimental SMTChecker;
+contract C {
+	bool b;
+	function f(uint8 a) public view {
+		require(a == 7);
+		// Holds since `b` is never written, but the function is checked
+		// in an arbitrary state.
+		assert(!b);
+	}
+}
+// ====
+// SMTEngine: chc
+// SMTModular: yes
+// ----
+// Warning 6328: (205-215): CHC: Assertion violation happens here.\nCounterexample:\nb = true\na = 7\n\nTransaction trace:\nState: b = true\nC.f(7)
@@ -0,0 +1,20 @@
+pragma experimental SMTChecker;
+contract C {
+	uint[] a;
+	function double(uint n) internal pure returns (uint) {
+		return n * 2;
+	}
+	function f(uint8 n) public view {
+		uint s;
+		for (uint i = 0; i < 3; ++i)
+			s += n;
+		assert(double(n) < s || n == 0);
+		assert(s <= 765);
+		assert(a.length >= 0);
+	}
+}
+// ====
+// SMTEngine: chc
+// SMTModular: yes
+// ----
+// Warning 4984: (210-216): CHC: Overflow (resulting value larger than 2**256 - 1) might happen here.
@@ -0,0 +1,22 @@
+pragma experimental SMTChecker;
+contract C {
+	uint x;
+	uint y;
+	uint z;
+	function f(uint _x) public {
+		x = _x;
+		// `x` is only copied into `y`, which is never read,
+		// so both are left out of the predicates.
+		y = x;
+		z = 1;
+	}
+	function g() public view {
+		assert(z == 0);
+	}
+}
+// ====
+// SMTEngine: chc
+// SMTIgnoreCex: yes
+// SMTSlicing: yes
+// ----
+// Warning 6328: (263-277): CHC: Assertion violation happens here.
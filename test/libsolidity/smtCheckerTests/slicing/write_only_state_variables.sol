@@ -0,0 +1,18 @@
+pragma experimental SMTChecker;
+contract C {
+	uint x;
+	mapping (uint => uint) m;
+	uint y;
+	function f(uint _x) public {
+		x = _x;
+		m[_x] = 2;
+	}
+	function g() public view {
+		// `x` and `m` are left out of the predicates.
+		assert(y == 0);
+	}
+}
+// ====
+// SMTEngine: chc
+// SMTSlicing: yes
+// ----
@@ -8,9 +8,3 @@ contract C {
 	}
 }
 // ----
-// Warning 8364: (215-221): Assertion checker does not yet implement type type(uint256[] memory)
-// Warning 8364: (215-224): Assertion checker does not yet implement type type(uint256[] memory[2] memory)
-// Warning 8364: (205-206): Assertion checker does not yet implement type type(struct C.S storage pointer)
-// Warning 8364: (215-221): Assertion checker does not yet implement type type(uint256[] memory)
-// Warning 8364: (215-224): Assertion checker does not yet implement type type(uint256[] memory[2] memory)
-// Warning 8364: (205-206): Assertion checker does not yet implement type type(struct C.S storage pointer)
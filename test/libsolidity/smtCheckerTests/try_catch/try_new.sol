@@ -28,7 +28,3 @@ contract C {
     }
 }
 // ----
-// Warning 4588: (264-278): Assertion checker does not yet implement this type of function call.
-// Warning 4588: (525-540): Assertion checker does not yet implement this type of function call.
-// Warning 4588: (264-278): Assertion checker does not yet implement this type of function call.
-// Warning 4588: (525-540): Assertion checker does not yet implement this type of function call.
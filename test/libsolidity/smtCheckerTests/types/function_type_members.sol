@@ -6,5 +6,3 @@ contract C {
     }
 }
 // ----
-// Warning 7650: (108-118): Assertion checker does not yet support this expression.
-// Warning 7650: (108-118): Assertion checker does not yet support this expression.
@@ -16,7 +16,3 @@ contract test {
 // Warning 6133: (145-149): Statement has no effect.
 // Warning 6133: (153-157): Statement has no effect.
 // Warning 6133: (161-168): Statement has no effect.
-// Warning 8364: (145-149): Assertion checker does not yet implement type type(struct test.s memory[7] memory)
-// Warning 8364: (161-168): Assertion checker does not yet implement type type(uint256[7] memory)
-// Warning 8364: (145-149): Assertion checker does not yet implement type type(struct test.s memory[7] memory)
-// Warning 8364: (161-168): Assertion checker does not yet implement type type(uint256[7] memory)
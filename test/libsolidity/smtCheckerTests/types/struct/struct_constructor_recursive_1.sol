@@ -9,5 +9,3 @@ contract Test {
 }
 // ----
 // Warning 2072: (136-165): Unused local variable.
-// Warning 8364: (170-212): Assertion checker does not yet implement type struct Test.RecursiveStruct memory
-// Warning 8364: (170-212): Assertion checker does not yet implement type struct Test.RecursiveStruct memory
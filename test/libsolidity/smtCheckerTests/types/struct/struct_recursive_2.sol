@@ -85,27 +85,3 @@ contract C {
 // Warning 7650: (206-210): Assertion checker does not yet support this expression.
 // Warning 8364: (206-208): Assertion checker does not yet implement type struct C.S storage ref
 // Warning 8364: (206-213): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 7650: (246-250): Assertion checker does not yet support this expression.
-// Warning 8364: (246-248): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (246-250): Assertion checker does not support recursive structs.
-// Warning 7650: (259-263): Assertion checker does not yet support this expression.
-// Warning 8364: (259-261): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (259-263): Assertion checker does not support recursive structs.
-// Warning 7650: (272-276): Assertion checker does not yet support this expression.
-// Warning 8364: (272-274): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (272-283): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (272-276): Assertion checker does not support recursive structs.
-// Warning 7650: (287-291): Assertion checker does not yet support this expression.
-// Warning 8364: (287-289): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (287-298): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (287-291): Assertion checker does not support recursive structs.
-// Warning 7650: (302-311): Assertion checker does not yet support this expression.
-// Warning 7650: (302-306): Assertion checker does not yet support this expression.
-// Warning 8364: (302-304): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (302-309): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (302-311): Assertion checker does not support recursive structs.
-// Warning 7650: (320-329): Assertion checker does not yet support this expression.
-// Warning 7650: (320-324): Assertion checker does not yet support this expression.
-// Warning 8364: (320-322): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (320-327): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (320-329): Assertion checker does not support recursive structs.
@@ -159,53 +159,3 @@ contract C {
 // Warning 8364: (293-295): Assertion checker does not yet implement type struct C.S storage ref
 // Warning 8364: (293-300): Assertion checker does not yet implement type struct C.S storage ref
 // Warning 8364: (293-305): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 7650: (338-342): Assertion checker does not yet support this expression.
-// Warning 8364: (338-340): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (338-342): Assertion checker does not support recursive structs.
-// Warning 7650: (351-355): Assertion checker does not yet support this expression.
-// Warning 8364: (351-353): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (351-355): Assertion checker does not support recursive structs.
-// Warning 7650: (364-368): Assertion checker does not yet support this expression.
-// Warning 8364: (364-366): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (364-375): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (364-368): Assertion checker does not support recursive structs.
-// Warning 7650: (379-383): Assertion checker does not yet support this expression.
-// Warning 8364: (379-381): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (379-390): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (379-383): Assertion checker does not support recursive structs.
-// Warning 7650: (394-403): Assertion checker does not yet support this expression.
-// Warning 7650: (394-398): Assertion checker does not yet support this expression.
-// Warning 8364: (394-396): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (394-401): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (394-403): Assertion checker does not support recursive structs.
-// Warning 7650: (412-421): Assertion checker does not yet support this expression.
-// Warning 7650: (412-416): Assertion checker does not yet support this expression.
-// Warning 8364: (412-414): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (412-419): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (412-421): Assertion checker does not support recursive structs.
-// Warning 7650: (430-439): Assertion checker does not yet support this expression.
-// Warning 7650: (430-434): Assertion checker does not yet support this expression.
-// Warning 8364: (430-432): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (430-437): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (430-446): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (430-439): Assertion checker does not support recursive structs.
-// Warning 7650: (450-459): Assertion checker does not yet support this expression.
-// Warning 7650: (450-454): Assertion checker does not yet support this expression.
-// Warning 8364: (450-452): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (450-457): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (450-466): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (450-459): Assertion checker does not support recursive structs.
-// Warning 7650: (470-484): Assertion checker does not yet support this expression.
-// Warning 7650: (470-479): Assertion checker does not yet support this expression.
-// Warning 7650: (470-474): Assertion checker does not yet support this expression.
-// Warning 8364: (470-472): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (470-477): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (470-482): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (470-484): Assertion checker does not support recursive structs.
-// Warning 7650: (493-507): Assertion checker does not yet support this expression.
-// Warning 7650: (493-502): Assertion checker does not yet support this expression.
-// Warning 7650: (493-497): Assertion checker does not yet support this expression.
-// Warning 8364: (493-495): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (493-500): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 8364: (493-505): Assertion checker does not yet implement type struct C.S storage ref
-// Warning 4375: (493-507): Assertion checker does not support recursive structs.
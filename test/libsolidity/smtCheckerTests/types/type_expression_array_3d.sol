@@ -6,9 +6,3 @@ function f() public pure { int[][][]; }
 }
 // ----
 // Warning 6133: (73-82): Statement has no effect.
-// Warning 8364: (73-78): Assertion checker does not yet implement type type(int256[] memory)
-// Warning 8364: (73-80): Assertion checker does not yet implement type type(int256[] memory[] memory)
-// Warning 8364: (73-82): Assertion checker does not yet implement type type(int256[] memory[] memory[] memory)
-// Warning 8364: (73-78): Assertion checker does not yet implement type type(int256[] memory)
-// Warning 8364: (73-80): Assertion checker does not yet implement type type(int256[] memory[] memory)
-// Warning 8364: (73-82): Assertion checker does not yet implement type type(int256[] memory[] memory[] memory)
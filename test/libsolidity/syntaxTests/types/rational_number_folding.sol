@@ -0,0 +1,21 @@
+contract C {
+    bool a = -7 >> 1;
+    bool b = -9 >> 3;
+    bool c = 5 << 3;
+    bool d = (6 / 3) * 7;
+    bool e = (7 / 2) * 2;
+    bool f = 7 / 2;
+    bool g = 2 ** 10 * 3;
+    bool h = (10 ** 18) * (10 ** 18);
+    bool i = (10 ** 18) * (10 ** 18);
+}
+// ----
+// TypeError 7407: (26-33): Type int_const -4 is not implicitly convertible to expected type bool.
+// TypeError 7407: (48-55): Type int_const -2 is not implicitly convertible to expected type bool.
+// TypeError 7407: (70-76): Type int_const 40 is not implicitly convertible to expected type bool.
+// TypeError 7407: (91-102): Type int_const 14 is not implicitly convertible to expected type bool.
+// TypeError 7407: (117-128): Type int_const 7 is not implicitly convertible to expected type bool.
+// TypeError 7407: (143-148): Type rational_const 7 / 2 is not implicitly convertible to expected type bool.
+// TypeError 7407: (163-174): Type int_const 3072 is not implicitly convertible to expected type bool.
+// TypeError 7407: (189-212): Type int_const 1000...(29 digits omitted)...0000 is not implicitly convertible to expected type bool.
+// TypeError 7407: (227-250): Type int_const 1000...(29 digits omitted)...0000 is not implicitly convertible to expected type bool.
@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the memory arena.
+ */
+
+#include <libsolutil/Arena.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ArenaTest)
+
+BOOST_AUTO_TEST_CASE(alignment)
+{
+	Arena arena{256};
+	for (size_t i = 0; i < 100; ++i)
+	{
+		BOOST_CHECK(arena.allocate(1, 1) != nullptr);
+		void* aligned = arena.allocate(8, 8);
+		BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(aligned) % 8, 0);
+	}
+	BOOST_CHECK_EQUAL(arena.allocatedBytes() % 256, 0);
+}
+
+BOOST_AUTO_TEST_CASE(large_allocations)
+{
+	Arena arena{256};
+	char* small = static_cast<char*>(arena.allocate(16, 1));
+	char* large = static_cast<char*>(arena.allocate(1000, 1));
+	BOOST_CHECK_EQUAL(arena.allocatedBytes(), 256 + 1000);
+	// The rest of the first chunk is still used.
+	BOOST_CHECK(static_cast<char*>(arena.allocate(16, 1)) == small + 16);
+	BOOST_CHECK(large != small + 16);
+}
+
+BOOST_AUTO_TEST_CASE(shared_objects_keep_arena_alive)
+{
+	auto arena = make_shared<Arena>();
+	weak_ptr<Arena> weakArena = arena;
+	auto text = allocate_shared<string>(ArenaAllocator<string>(arena), 100, 'x');
+	arena.reset();
+	BOOST_CHECK(!weakArena.expired());
+	BOOST_CHECK_EQUAL(*text, string(100, 'x'));
+	text.reset();
+	BOOST_CHECK(weakArena.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -138,6 +138,28 @@ BOOST_AUTO_TEST_CASE(test_format_number)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(test_word_arithmetic)
+{
+	u256 max = ~u256(0);
+	BOOST_CHECK_EQUAL(u2s(max), s256(-1));
+	BOOST_CHECK_EQUAL(u2s(u256(1) << 255), -(s256(1) << 255));
+	BOOST_CHECK_EQUAL(u2s(7), s256(7));
+	BOOST_CHECK_EQUAL(s2u(s256(-1)), max);
+	BOOST_CHECK_EQUAL(s2u(-(s256(1) << 255)), u256(1) << 255);
+	BOOST_CHECK_EQUAL(s2u(s256(7)), u256(7));
+
+	BOOST_CHECK_EQUAL(exp256(2, 255), u256(1) << 255);
+	BOOST_CHECK_EQUAL(exp256(2, 256), u256(0));
+	BOOST_CHECK_EQUAL(exp256(max, 3), max);
+
+	BOOST_CHECK_EQUAL(addmod256(max, max, 7), u256((bigint(max) * 2) % 7));
+	BOOST_CHECK_EQUAL(addmod256(max, 1, max), u256(1));
+	BOOST_CHECK_EQUAL(addmod256(3, 4, 0), u256(0));
+	BOOST_CHECK_EQUAL(mulmod256(max, max, 12345), u256((bigint(max) * bigint(max)) % 12345));
+	BOOST_CHECK_EQUAL(mulmod256(max, max, max - 1), u256(1));
+	BOOST_CHECK_EQUAL(mulmod256(3, 4, 0), u256(0));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -105,6 +105,50 @@ BOOST_AUTO_TEST_CASE(parse_json_strict)
 	BOOST_CHECK(json[0] == "\x80\xec\x80");
 }
 
+BOOST_AUTO_TEST_CASE(json_binary_print_roundtrip)
+{
+	Json::Value json;
+	BOOST_REQUIRE(jsonParseStrict(
+		"{\"a\":[1,-5,18446744073709551615,-9223372036854775808,2.5,true,false,null,\"a\"],\"b\":{\"a\":\"\",\"c\":{}},\"d\":[]}",
+		json
+	));
+	json["e"] = string("x\0y", 3);
+
+	string binary = jsonBinaryPrint(json);
+	Json::Value decoded;
+	string errors;
+	BOOST_REQUIRE(jsonParseBinary(binary, decoded, &errors));
+	BOOST_CHECK(decoded == json);
+	BOOST_CHECK_EQUAL(jsonCompactPrint(decoded), jsonCompactPrint(json));
+	BOOST_CHECK(decoded["a"][0].type() == Json::intValue);
+	BOOST_CHECK(decoded["a"][2].type() == Json::uintValue);
+
+	// Repeated strings and keys are only stored once.
+	Json::Value repeated(Json::arrayValue);
+	for (size_t i = 0; i < 100; ++i)
+		repeated.append(Json::Value(Json::objectValue))[string(100, 'k')] = string(100, 'v');
+	BOOST_CHECK(jsonBinaryPrint(repeated).size() < 1000);
+}
+
+BOOST_AUTO_TEST_CASE(parse_json_binary_invalid)
+{
+	Json::Value json;
+	string errors;
+	string binary = jsonBinaryPrint(Json::Value(Json::objectValue));
+	BOOST_CHECK(jsonParseBinary(binary, json, &errors));
+
+	BOOST_CHECK(!jsonParseBinary("{}", json, &errors));
+	BOOST_CHECK_EQUAL(errors, "Invalid header.");
+	BOOST_CHECK(!jsonParseBinary(binary + "x", json, &errors));
+	BOOST_CHECK_EQUAL(errors, "Trailing data after the value.");
+
+	Json::Value value;
+	value["key"] = "value";
+	binary = jsonBinaryPrint(value);
+	for (size_t length = 0; length < binary.size(); ++length)
+		BOOST_CHECK(!jsonParseBinary(binary.substr(0, length), json, &errors));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -69,6 +69,37 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(batch)
+{
+	vector<bytes> inputs;
+	// Inputs of up to four blocks, including the block boundaries at 135 and 136 bytes.
+	for (size_t size = 0; size < 4 * 136; size += 7)
+		inputs.emplace_back(size, uint8_t(size));
+	inputs.emplace_back(135, 'x');
+	inputs.emplace_back(136, 'x');
+	vector<bytesConstRef> refs;
+	for (bytes const& input: inputs)
+		refs.emplace_back(&input);
+
+	BOOST_CHECK(keccak256Batch({}).empty());
+	vector<h256> hashes = keccak256Batch(refs);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+
+	string const test = "test";
+	string const longer = "longer test string";
+	hashes = keccak256Batch({bytesConstRef(test), bytesConstRef(longer)});
+	BOOST_CHECK_EQUAL(
+		hashes[0],
+		FixedHash<32>("0x9c22ff5f21f0b81b113e63f7db6da94fedef11b2119b4088b89664fb9a3cb658")
+	);
+	BOOST_CHECK_EQUAL(
+		hashes[1],
+		FixedHash<32>("0x47bed17bfbbc08d6b5a0f603eff1b3e932c37c10b865847a7bc73d55b260f32a")
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -20,7 +20,10 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace solidity::util::test
 {
@@ -114,6 +117,29 @@ BOOST_AUTO_TEST_CASE(move_constructed_has_same_value_as_original)
 	BOOST_CHECK_EQUAL(valueOf(std::move(moveConstructed)), 12);
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_init_stores_one_value)
+{
+	LazyInit<int const> lazyInit;
+	std::atomic<int> calls = 0;
+	std::vector<int const*> results(8, nullptr);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < results.size(); ++i)
+		threads.emplace_back([&, i]{
+			results[i] = &lazyInit.init([&]{ return ++calls; });
+		});
+	for (auto& thread: threads)
+		thread.join();
+
+	BOOST_CHECK(calls >= 1);
+	for (int const* result: results)
+	{
+		BOOST_CHECK_EQUAL(result, results.front());
+		BOOST_CHECK(*result >= 1 && *result <= calls);
+	}
+	// Later calls do not initialize the value again.
+	BOOST_CHECK_EQUAL(&lazyInit.init([&]{ return ++calls; }), results.front());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,134 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the compiler phase profiler.
+ */
+
+#include <libsolutil/Profiler.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// Enables a freshly reset profiler for the lifetime of the object.
+struct ProfilerFixture
+{
+	ProfilerFixture()
+	{
+		Profiler::instance().reset();
+		Profiler::instance().setEnabled(true);
+	}
+	~ProfilerFixture()
+	{
+		Profiler::instance().setEnabled(false);
+		Profiler::instance().reset();
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(ProfilerTest)
+
+BOOST_AUTO_TEST_CASE(disabled)
+{
+	Profiler::instance().reset();
+	BOOST_REQUIRE(!Profiler::instance().enabled());
+	{
+		ProfilerScope scope{"phase"};
+	}
+	BOOST_CHECK_EQUAL(Profiler::instance().toJson().size(), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(nesting_and_aggregation, ProfilerFixture)
+{
+	{
+		ProfilerScope outer{"outer"};
+		for (size_t i = 0; i < 3; ++i)
+		{
+			ProfilerScope inner{"inner"};
+		}
+		ProfilerScope other{"other"};
+	}
+	{
+		ProfilerScope second{"second"};
+	}
+
+	Json::Value phases = Profiler::instance().toJson();
+	BOOST_REQUIRE_EQUAL(phases.size(), 2);
+	BOOST_CHECK_EQUAL(phases[0]["name"], "outer");
+	BOOST_CHECK_EQUAL(phases[0]["invocations"].asUInt(), 1);
+	BOOST_CHECK_EQUAL(phases[1]["name"], "second");
+	BOOST_CHECK(!phases[1].isMember("children"));
+
+	Json::Value const& children = phases[0]["children"];
+	BOOST_REQUIRE_EQUAL(children.size(), 2);
+	BOOST_CHECK_EQUAL(children[0]["name"], "inner");
+	BOOST_CHECK_EQUAL(children[0]["invocations"].asUInt(), 3);
+	BOOST_CHECK_EQUAL(children[1]["name"], "other");
+	BOOST_CHECK(phases[0]["wallTimeMs"].asDouble() >= children[0]["wallTimeMs"].asDouble());
+}
+
+BOOST_FIXTURE_TEST_CASE(text_report, ProfilerFixture)
+{
+	{
+		ProfilerScope outer{"outer"};
+		ProfilerScope inner{"inner"};
+	}
+	string report = Profiler::instance().toString();
+	BOOST_CHECK(report.find("\nouter ") != string::npos);
+	BOOST_CHECK(report.find("\n  inner ") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(trace_events)
+{
+	Profiler::instance().reset();
+	Profiler::instance().setTracingEnabled(true);
+	{
+		ProfilerScope outer{"outer", "C"};
+		TraceScope round{"Round", "0"};
+	}
+	Profiler::instance().setTracingEnabled(false);
+	{
+		TraceScope ignored{"ignored"};
+	}
+
+	// Tracing alone does not aggregate timings.
+	BOOST_CHECK_EQUAL(Profiler::instance().toJson().size(), 0);
+	Json::Value const& events = Profiler::instance().traceToJson()["traceEvents"];
+	BOOST_REQUIRE_EQUAL(events.size(), 2);
+	// Events are recorded when they end.
+	BOOST_CHECK_EQUAL(events[0]["name"], "Round");
+	BOOST_CHECK_EQUAL(events[0]["args"]["detail"], "0");
+	BOOST_CHECK_EQUAL(events[1]["name"], "outer");
+	BOOST_CHECK_EQUAL(events[1]["args"]["detail"], "C");
+	BOOST_CHECK_EQUAL(events[1]["ph"], "X");
+	BOOST_CHECK_EQUAL(events[0]["tid"], events[1]["tid"]);
+	BOOST_CHECK(events[1]["ts"].asDouble() <= events[0]["ts"].asDouble());
+	BOOST_CHECK(events[1]["dur"].asDouble() >= events[0]["dur"].asDouble());
+	Profiler::instance().reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
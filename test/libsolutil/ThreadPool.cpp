@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the thread pool.
+ */
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(runs_all_tasks)
+{
+	atomic<size_t> counter{0};
+	ThreadPool pool{4};
+	BOOST_CHECK_EQUAL(pool.threadCount(), 4);
+	for (size_t i = 0; i < 100; ++i)
+		pool.post([&] { ++counter; });
+	pool.wait();
+	BOOST_CHECK_EQUAL(counter, 100);
+}
+
+BOOST_AUTO_TEST_CASE(tasks_posting_tasks)
+{
+	atomic<size_t> counter{0};
+	ThreadPool pool{3};
+	for (size_t i = 0; i < 10; ++i)
+		pool.post([&] {
+			for (size_t j = 0; j < 10; ++j)
+				pool.post([&] { ++counter; });
+		});
+	pool.wait();
+	BOOST_CHECK_EQUAL(counter, 100);
+}
+
+BOOST_AUTO_TEST_CASE(exception_is_rethrown)
+{
+	atomic<size_t> counter{0};
+	ThreadPool pool{2};
+	pool.post([] { throw runtime_error("failure"); });
+	for (size_t i = 0; i < 10; ++i)
+		pool.post([&] { ++counter; });
+	BOOST_CHECK_THROW(pool.wait(), runtime_error);
+	BOOST_CHECK_EQUAL(counter, 10);
+	// The exception is only reported once.
+	pool.wait();
+}
+
+BOOST_AUTO_TEST_CASE(zero_threads)
+{
+	bool executed = false;
+	ThreadPool pool{0};
+	BOOST_CHECK_EQUAL(pool.threadCount(), 1);
+	pool.post([&] { executed = true; });
+	pool.wait();
+	BOOST_CHECK(executed);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -208,6 +208,27 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(incomplete_tags)
+{
+	string templ = "<a <#b>x <?c>y<!c>z </d> <?+e>";
+	BOOST_CHECK_EQUAL(Whiskers(templ).render(), templ);
+}
+
+BOOST_AUTO_TEST_CASE(first_closing_tag)
+{
+	string templ = "<?a>1<?a>2</a>3</a>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", true).render(), "1<?a>23</a>");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", false).render(), "3</a>");
+}
+
+BOOST_AUTO_TEST_CASE(reused_template)
+{
+	string templ = "<?c><a><!c>-</c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "X")("c", true).render(), "X");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "Y")("c", true).render(), "Y");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "Z")("c", false).render(), "-");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -34,12 +34,17 @@ namespace solidity::yul::test
 
 namespace
 {
-string check(string const& _input)
+string check(string const& _input, optional<set<YulString>> const& _functionsToCheck = nullopt)
 {
 	Object obj;
 	std::tie(obj.code, obj.analysisInfo) = yul::test::parse(_input, false);
 	BOOST_REQUIRE(obj.code);
-	auto functions = CompilabilityChecker(EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()), obj, true).stackDeficit;
+	auto functions = CompilabilityChecker(
+		EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()),
+		obj,
+		true,
+		_functionsToCheck
+	).stackDeficit;
 	string out;
 	for (auto const& function: functions)
 		out += function.first.str() + ": " + to_string(function.second) + " ";
@@ -158,6 +163,66 @@ BOOST_AUTO_TEST_CASE(multiple_functions)
 	BOOST_CHECK_EQUAL(out, "h: 9 g: 5 f: 5 ");
 }
 
+BOOST_AUTO_TEST_CASE(selected_functions)
+{
+	string in = R"({
+		{
+			let x := 0
+			let r1 := 0
+			let r2 := 0
+			let r3 := 0
+			let r4 := 0
+			let r5 := 0
+			let r6 := 0
+			let r7 := 0
+			let r8 := 0
+			let r9 := 0
+			let r10 := 0
+			let r11 := 0
+			let r12 := 0
+			let r13 := 0
+			let r14 := 0
+			let r15 := 0
+			let r16 := 0
+			let r17 := 0
+			let r18 := 0
+			x := add(add(add(add(add(add(add(add(add(add(add(add(x, r12), r11), r10), r9), r8), r7), r6), r5), r4), r3), r2), r1)
+		}
+		function f(a, b) -> r1, r2, r3, r4, r5, r6, r7, r8, r9, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19 {
+		}
+		function h(x) {
+			let r1 := 0
+			let r2 := 0
+			let r3 := 0
+			let r4 := 0
+			let r5 := 0
+			let r6 := 0
+			let r7 := 0
+			let r8 := 0
+			let r9 := 0
+			let r10 := 0
+			let r11 := 0
+			let r12 := 0
+			let r13 := 0
+			let r14 := 0
+			let r15 := 0
+			let r16 := 0
+			let r17 := 0
+			let r18 := 0
+			x := add(add(add(add(add(add(add(add(add(add(add(add(x, r12), r11), r10), r9), r8), r7), r6), r5), r4), r3), r2), r1)
+			x := g(x)
+		}
+		function g(a) -> b {
+			b := a
+		}
+	})";
+	BOOST_CHECK_EQUAL(check(in, set<YulString>{YulString{}}), ": 9 ");
+	BOOST_CHECK_EQUAL(check(in, set<YulString>{YulString{"f"}}), "f: 5 ");
+	BOOST_CHECK_EQUAL(check(in, set<YulString>{YulString{"h"}}), "h: 9 ");
+	BOOST_CHECK_EQUAL(check(in, set<YulString>{YulString{"g"}}), "");
+	BOOST_CHECK_EQUAL(check(in, set<YulString>{}), "");
+}
+
 BOOST_AUTO_TEST_CASE(nested)
 {
 	string out = check(R"({
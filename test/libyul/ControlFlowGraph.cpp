@@ -0,0 +1,181 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the control-flow graph of Yul code.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/ControlFlowGraph.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+using BlockId = ControlFlowGraph::BlockId;
+using Exit = ControlFlowGraph::BasicBlock::Exit;
+
+Dialect const& evmDialect()
+{
+	return EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+}
+
+struct ParsedGraph
+{
+	explicit ParsedGraph(string const& _source):
+		ast(parse(_source, false).first),
+		graph(ControlFlowGraph::build(evmDialect(), *ast))
+	{}
+
+	shared_ptr<Block> ast;
+	ControlFlowGraph graph;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulControlFlowGraph)
+
+BOOST_AUTO_TEST_CASE(straight_line)
+{
+	ParsedGraph code("{ let x := 1 sstore(x, 2) }");
+	ControlFlowGraph const& graph = code.graph;
+	BOOST_REQUIRE_EQUAL(graph.blocks().size(), 1);
+	BOOST_CHECK_EQUAL(graph.block(0).statements.size(), 2);
+	BOOST_CHECK(graph.block(0).exit == Exit::Return);
+	BOOST_CHECK(graph.block(0).successors.empty());
+	BOOST_CHECK(graph.reversePostOrder() == vector<BlockId>{0});
+}
+
+BOOST_AUTO_TEST_CASE(if_statement)
+{
+	ParsedGraph code("{ let x := calldataload(0) if x { sstore(0, 1) } sstore(1, 2) }");
+	ControlFlowGraph const& graph = code.graph;
+	BOOST_REQUIRE_EQUAL(graph.blocks().size(), 3);
+	BOOST_CHECK(graph.block(0).exit == Exit::ConditionalJump);
+	BOOST_REQUIRE(graph.block(0).condition);
+	BOOST_CHECK(holds_alternative<Identifier>(*graph.block(0).condition));
+	BOOST_CHECK((graph.block(0).successors == vector<BlockId>{1, 2}));
+	BOOST_CHECK(graph.block(1).exit == Exit::Jump);
+	BOOST_CHECK((graph.block(1).successors == vector<BlockId>{2}));
+	BOOST_CHECK((graph.block(2).predecessors == vector<BlockId>{0, 1}));
+	BOOST_CHECK_EQUAL(graph.block(2).statements.size(), 1);
+	BOOST_CHECK(graph.block(2).exit == Exit::Return);
+	BOOST_CHECK((graph.reversePostOrder() == vector<BlockId>{0, 1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(switch_without_default)
+{
+	ParsedGraph code("{ switch calldataload(0) case 0 { sstore(0, 1) } case 1 { sstore(0, 2) } }");
+	ControlFlowGraph const& graph = code.graph;
+	BOOST_REQUIRE_EQUAL(graph.blocks().size(), 4);
+	BOOST_CHECK(graph.block(0).exit == Exit::Switch);
+	BOOST_CHECK((graph.block(0).successors == vector<BlockId>{2, 3, 1}));
+	BOOST_CHECK((graph.block(1).predecessors == vector<BlockId>{2, 3, 0}));
+	BOOST_CHECK(graph.block(1).exit == Exit::Return);
+}
+
+BOOST_AUTO_TEST_CASE(for_loop)
+{
+	ParsedGraph code(R"({
+		for { let i := 0 } lt(i, 10) { i := add(i, 1) } {
+			if calldataload(i) { break }
+			if calldataload(add(i, 1)) { continue }
+			sstore(i, 1)
+		}
+	})");
+	ControlFlowGraph const& graph = code.graph;
+	BlockId const condition = 1;
+	BlockId const body = 2;
+	BlockId const post = 3;
+	BlockId const after = 4;
+	BOOST_REQUIRE_EQUAL(graph.blocks().size(), 11);
+	BOOST_CHECK_EQUAL(graph.block(0).statements.size(), 1);
+	BOOST_CHECK((graph.block(0).successors == vector<BlockId>{condition}));
+	BOOST_CHECK(graph.block(condition).exit == Exit::ConditionalJump);
+	BOOST_CHECK((graph.block(condition).successors == vector<BlockId>{body, after}));
+	BOOST_CHECK((graph.block(condition).predecessors == vector<BlockId>{0, post}));
+	BOOST_CHECK((graph.block(post).successors == vector<BlockId>{condition}));
+	BOOST_CHECK(graph.block(after).exit == Exit::Return);
+	// The body of the first if statement breaks.
+	BOOST_CHECK((graph.block(5).successors == vector<BlockId>{after}));
+	// The body of the second if statement continues.
+	BOOST_CHECK((graph.block(8).successors == vector<BlockId>{post}));
+	// The (empty) code after break and continue is unreachable.
+	BOOST_CHECK(graph.block(7).predecessors.empty());
+	BOOST_CHECK(graph.block(10).predecessors.empty());
+
+	vector<BlockId> order = graph.reversePostOrder();
+	BOOST_CHECK_EQUAL(order.size(), 9);
+	BOOST_CHECK_EQUAL(order.front(), 0);
+	BOOST_CHECK(find(order.begin(), order.end(), 7) == order.end());
+	BOOST_CHECK(find(order.begin(), order.end(), 10) == order.end());
+}
+
+BOOST_AUTO_TEST_CASE(terminating_builtin)
+{
+	ParsedGraph code("{ sstore(0, 1) revert(0, 0) sstore(0, 2) }");
+	ControlFlowGraph const& graph = code.graph;
+	BOOST_REQUIRE_EQUAL(graph.blocks().size(), 2);
+	BOOST_CHECK_EQUAL(graph.block(0).statements.size(), 2);
+	BOOST_CHECK(graph.block(0).exit == Exit::Terminate);
+	BOOST_CHECK(graph.block(0).successors.empty());
+	BOOST_CHECK(graph.block(1).predecessors.empty());
+	BOOST_CHECK(graph.reversePostOrder() == vector<BlockId>{0});
+}
+
+BOOST_AUTO_TEST_CASE(function_and_variables)
+{
+	shared_ptr<Block> ast = parse("{ function f(a, b) -> r { let c := add(a, b) if c { leave } r := c } }", false).first;
+	BOOST_REQUIRE(ast && ast->statements.size() == 1);
+	ControlFlowGraph graph = ControlFlowGraph::build(evmDialect(), std::get<FunctionDefinition>(ast->statements.front()));
+
+	BOOST_REQUIRE_EQUAL(graph.variableCount(), 4);
+	BOOST_CHECK_EQUAL(graph.variableName(0).str(), "a");
+	BOOST_CHECK_EQUAL(graph.variableName(1).str(), "b");
+	BOOST_CHECK_EQUAL(graph.variableName(2).str(), "r");
+	BOOST_CHECK_EQUAL(graph.variableName(3).str(), "c");
+	BOOST_CHECK(graph.variableId(YulString{"c"}) == 3);
+	BOOST_CHECK(!graph.variableId(YulString{"f"}).has_value());
+	BOOST_CHECK(!graph.variableId(YulString{"add"}).has_value());
+
+	BOOST_CHECK(graph.block(0).exit == Exit::ConditionalJump);
+	BOOST_CHECK(graph.block(1).exit == Exit::Return);
+	BOOST_CHECK(graph.block(1).successors.empty());
+	BOOST_CHECK_EQUAL(graph.block(2).statements.size(), 1);
+	BOOST_CHECK(graph.block(2).exit == Exit::Return);
+
+	// The outermost code does not contain the function.
+	ControlFlowGraph outer = ControlFlowGraph::build(evmDialect(), *ast);
+	BOOST_CHECK_EQUAL(outer.blocks().size(), 1);
+	BOOST_CHECK(outer.block(0).statements.empty());
+	BOOST_CHECK_EQUAL(outer.variableCount(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,134 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the direct bytecode emission of Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libevmasm/LinkerObject.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+/// Assembles @a _input with and without going through an evmasm::Assembly and checks
+/// that the creation and runtime bytecode are the same.
+/// If @a _useSubroutines is set, functions are compiled to subroutines for EVM version berlin.
+void checkSameBytecode(string const& _input, bool _useSubroutines = false)
+{
+	solidity::frontend::OptimiserSettings settings = solidity::frontend::OptimiserSettings::none();
+	settings.useSubroutines = _useSubroutines;
+	AssemblyStack asmStack(
+		_useSubroutines ? langutil::EVMVersion::berlin() : solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		settings
+	);
+	BOOST_REQUIRE_MESSAGE(asmStack.parseAndAnalyze("", _input), "Source did not parse: " + _input);
+	auto [creation, runtime] = asmStack.assembleAndGuessRuntime();
+	auto [directCreation, directRuntime] = asmStack.assembleDirectlyAndGuessRuntime();
+
+	BOOST_REQUIRE(creation.bytecode && directCreation.bytecode);
+	BOOST_CHECK_EQUAL(directCreation.bytecode->toHex(), creation.bytecode->toHex());
+	BOOST_CHECK(directCreation.bytecode->linkReferences == creation.bytecode->linkReferences);
+	BOOST_REQUIRE_EQUAL(!!directRuntime.bytecode, !!runtime.bytecode);
+	if (runtime.bytecode)
+	{
+		BOOST_CHECK_EQUAL(directRuntime.bytecode->toHex(), runtime.bytecode->toHex());
+		BOOST_CHECK(directRuntime.bytecode->immutableReferences == runtime.bytecode->immutableReferences);
+	}
+}
+}
+
+BOOST_AUTO_TEST_SUITE(YulEVMAssembly)
+
+BOOST_AUTO_TEST_CASE(functions_and_loops)
+{
+	checkSameBytecode(R"({
+		function f(a) -> b {
+			for { let i := 0 } lt(i, a) { i := add(i, 1) } { b := add(b, i) }
+		}
+		if calldatasize() { sstore(0, f(calldataload(0))) }
+	})");
+}
+
+BOOST_AUTO_TEST_CASE(long_jumps)
+{
+	// More than 256 bytes of code, so that two byte label references are needed.
+	string body;
+	for (size_t i = 0; i < 50; ++i)
+		body += "sstore(" + to_string(i) + ", f(" + to_string(i) + "))\n";
+	checkSameBytecode("{ function f(a) -> b { b := mul(a, 2) }\n" + body + "}");
+}
+
+BOOST_AUTO_TEST_CASE(subroutines)
+{
+	checkSameBytecode(R"({
+		function f(a) -> b { b := g(a, 2) }
+		function g(a, c) -> d { d := mul(a, c) }
+		sstore(0, f(calldataload(0)))
+	})", true);
+}
+
+BOOST_AUTO_TEST_CASE(sub_objects_and_data)
+{
+	checkSameBytecode(R"(
+		object "a" {
+			code {
+				datacopy(0, dataoffset("r"), datasize("r"))
+				datacopy(datasize("r"), dataoffset("d"), datasize("d"))
+				sstore(0, datasize("a"))
+				return(0, add(datasize("r"), datasize("d")))
+			}
+			data "d" hex"01020304"
+			object "r" {
+				code { sstore(0, linkersymbol("lib.sol:L")) }
+			}
+		}
+	)");
+}
+
+BOOST_AUTO_TEST_CASE(immutables)
+{
+	checkSameBytecode(R"(
+		object "a" {
+			code {
+				datacopy(0, dataoffset("r"), datasize("r"))
+				setimmutable(0, "x", 7)
+				return(0, datasize("r"))
+			}
+			object "r" {
+				code {
+					mstore(0, loadimmutable("x"))
+					mstore(32, loadimmutable("x"))
+					return(0, 64)
+				}
+			}
+		}
+	)");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
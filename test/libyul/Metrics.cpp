@@ -23,6 +23,8 @@
 #include <test/libyul/Common.h>
 
 #include <libyul/optimiser/Metrics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/AST.h>
 
 #include <boost/test/unit_test.hpp>
@@ -43,6 +45,19 @@ size_t codeSize(string const& _source, CodeWeights const _weights = {})
 	return CodeSize::codeSize(*ast, _weights);
 }
 
+/// Parses @a _source, which has to end in a statement of the form ``pop(<expression>)``,
+/// and @returns whether the expression is cheap to duplicate @a _uses times.
+bool cheapToDuplicate(string const& _source, size_t _uses, bool _useGasMeter)
+{
+	shared_ptr<Block> ast = parse(_source, false).first;
+	BOOST_REQUIRE(ast);
+	BOOST_REQUIRE(!ast->statements.empty());
+	FunctionCall const& pop = std::get<FunctionCall>(std::get<ExpressionStatement>(ast->statements.back()).expression);
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	GasMeter meter(dialect, false, 200);
+	return DuplicationCost::cheapToDuplicate(dialect, _useGasMeter ? &meter : nullptr, pop.arguments.front(), _uses, 1);
+}
+
 }
 
 class CustomWeightFixture
@@ -379,4 +394,35 @@ BOOST_FIXTURE_TEST_CASE(switch_statement_large_custom_weights, CustomWeightFixtu
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_SUITE(YulDuplicationCost)
+
+BOOST_AUTO_TEST_CASE(small_literal)
+{
+	BOOST_CHECK(cheapToDuplicate("{ pop(0x40) }", 2, false));
+	BOOST_CHECK(cheapToDuplicate("{ pop(0x40) }", 2, true));
+	BOOST_CHECK(cheapToDuplicate("{ pop(0x40) }", 5, true));
+}
+
+BOOST_AUTO_TEST_CASE(large_literal)
+{
+	string source = "{ pop(0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff) }";
+	BOOST_CHECK(!cheapToDuplicate(source, 2, false));
+	BOOST_CHECK(!cheapToDuplicate(source, 2, true));
+}
+
+BOOST_AUTO_TEST_CASE(cheap_code_but_expensive_gas)
+{
+	// The code cost of mload(0x40) is only one, but evaluating it twice
+	// costs more gas than a DUP.
+	BOOST_CHECK(cheapToDuplicate("{ pop(mload(0x40)) }", 2, false));
+	BOOST_CHECK(!cheapToDuplicate("{ pop(mload(0x40)) }", 2, true));
+}
+
+BOOST_AUTO_TEST_CASE(user_defined_function_falls_back_to_code_cost)
+{
+	BOOST_CHECK(!cheapToDuplicate("{ function f() -> x {} pop(f()) }", 2, true));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 }
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of the results of function-local optimiser steps.
+ */
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/OptimisedFunctionCache.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// @returns a block containing only the last statement of @a _source.
+Block lastStatement(string const& _source)
+{
+	shared_ptr<Block> ast = parse(_source, false).first;
+	BOOST_REQUIRE(ast);
+	Block block;
+	block.statements.emplace_back(move(ast->statements.back()));
+	return block;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimisedFunctionCache)
+
+BOOST_AUTO_TEST_CASE(moved_function)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(EVMVersion{});
+	OptimisedFunctionCache cache;
+	Block first = lastStatement("{ function f(a) -> b { b := add(a, 0) } }");
+	Block second = lastStatement("{ sstore(0, 0) function f(a) -> b { b := add(a, 0) } }");
+	SourceLocation secondLocation = locationOf(second.statements.front());
+
+	optional<string> firstKey = OptimisedFunctionCache::key("step", dialect, first, nullptr);
+	optional<string> secondKey = OptimisedFunctionCache::key("step", dialect, second, nullptr);
+	BOOST_REQUIRE(firstKey && secondKey);
+	BOOST_CHECK_EQUAL(*firstKey, *secondKey);
+	BOOST_CHECK(*OptimisedFunctionCache::key("other", dialect, first, nullptr) != *firstKey);
+
+	BOOST_CHECK(!cache.lookup(*secondKey, second));
+	cache.store(*firstKey, locationOf(first.statements.front()), first);
+	BOOST_REQUIRE(cache.lookup(*secondKey, second));
+	BOOST_REQUIRE_EQUAL(second.statements.size(), 1);
+	BOOST_CHECK_EQUAL(
+		std::visit(AsmPrinter{}, second.statements.front()),
+		std::visit(AsmPrinter{}, first.statements.front())
+	);
+	BOOST_CHECK(locationOf(second.statements.front()) == secondLocation);
+}
+
+BOOST_AUTO_TEST_CASE(different_code)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(EVMVersion{});
+	Block first = lastStatement("{ function f(a) -> b { b := add(a, 0) } }");
+	Block second = lastStatement("{ function f(a) -> b { b := add(a, 1) } }");
+	optional<string> firstKey = OptimisedFunctionCache::key("step", dialect, first, nullptr);
+	optional<string> secondKey = OptimisedFunctionCache::key("step", dialect, second, nullptr);
+	BOOST_REQUIRE(firstKey && secondKey);
+	BOOST_CHECK(*firstKey != *secondKey);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
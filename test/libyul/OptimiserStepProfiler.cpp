@@ -0,0 +1,121 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the optimiser step profiler.
+ */
+
+#include <test/libyul/Common.h>
+#include <test/Common.h>
+
+#include <libyul/optimiser/OptimiserStepProfiler.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// Enables a freshly reset profiler for the lifetime of the object.
+struct OptimiserStepProfilerFixture
+{
+	OptimiserStepProfilerFixture()
+	{
+		OptimiserStepProfiler::instance().reset();
+		OptimiserStepProfiler::instance().setEnabled(true);
+	}
+	~OptimiserStepProfilerFixture()
+	{
+		OptimiserStepProfiler::instance().setEnabled(false);
+		OptimiserStepProfiler::instance().reset();
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserStepProfiler)
+
+BOOST_AUTO_TEST_CASE(disabled)
+{
+	OptimiserStepProfiler::instance().reset();
+	BOOST_REQUIRE(!OptimiserStepProfiler::instance().enabled());
+	shared_ptr<Block> ast = parse("{ let x := add(1, 2) }", false).first;
+	BOOST_REQUIRE(ast);
+	bool run = false;
+	OptimiserStepProfiler::instance().measure("step", *ast, [&] { run = true; });
+	BOOST_CHECK(run);
+	BOOST_CHECK(OptimiserStepProfiler::instance().statistics().empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(invocations_and_size_delta, OptimiserStepProfilerFixture)
+{
+	shared_ptr<Block> ast = parse("{ let x := add(1, 2) sstore(x, 3) }", false).first;
+	BOOST_REQUIRE(ast);
+	size_t initialSize = CodeSize::codeSizeIncludingFunctions(*ast);
+	BOOST_REQUIRE(initialSize > 0);
+
+	OptimiserStepProfiler& profiler = OptimiserStepProfiler::instance();
+	profiler.measure("unchanged", *ast, [] {});
+	profiler.measure("unchanged", *ast, [] {});
+	profiler.measure("remover", *ast, [&] { ast->statements.clear(); });
+
+	auto statistics = profiler.statistics();
+	BOOST_REQUIRE_EQUAL(statistics.size(), 2);
+	BOOST_CHECK_EQUAL(statistics["unchanged"].invocations, 2);
+	BOOST_CHECK_EQUAL(statistics["unchanged"].invocationsWithoutSizeChange, 2);
+	BOOST_CHECK_EQUAL(statistics["unchanged"].codeSizeDelta, 0);
+	BOOST_CHECK_EQUAL(statistics["remover"].invocations, 1);
+	BOOST_CHECK_EQUAL(statistics["remover"].invocationsWithoutSizeChange, 0);
+	BOOST_CHECK_EQUAL(statistics["remover"].codeSizeDelta, -static_cast<long long>(initialSize));
+
+	Json::Value steps = profiler.toJson();
+	BOOST_REQUIRE_EQUAL(steps.size(), 2);
+	BOOST_CHECK(steps[0]["wallTimeMs"].asDouble() >= steps[1]["wallTimeMs"].asDouble());
+	BOOST_CHECK(profiler.toString().find("\nremover ") != string::npos);
+}
+
+BOOST_FIXTURE_TEST_CASE(rule_applications, OptimiserStepProfilerFixture)
+{
+	shared_ptr<Block> ast = parse("{ let c := calldataload(0) let x := add(c, 0) sstore(sub(x, x), mul(2, 3)) }", false).first;
+	BOOST_REQUIRE(ast);
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	NameDispenser dispenser{dialect, *ast};
+	set<YulString> reservedIdentifiers;
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers};
+	ExpressionSimplifier::run(context, *ast);
+
+	auto applications = OptimiserStepProfiler::instance().ruleApplications();
+	BOOST_CHECK_EQUAL(applications.size(), 3);
+	BOOST_CHECK_EQUAL(applications["add(X, 0)"], 1);
+	BOOST_CHECK_EQUAL(applications["sub(X, X)"], 1);
+	BOOST_CHECK_EQUAL(applications["mul(A, B)"], 1);
+	BOOST_CHECK(OptimiserStepProfiler::instance().rulesToString().find("  add(X, 0)\n") != string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
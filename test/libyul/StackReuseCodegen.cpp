@@ -215,12 +215,13 @@ BOOST_AUTO_TEST_CASE(function_params_and_retparams_partly_unused)
 		function f(a, b, c, d) -> x, y { b := 3 let s := 9 y := 2 mstore(s, y) }
 	})";
 	BOOST_CHECK_EQUAL(assemble(in),
-		"PUSH1 0x1F JUMP "
+		"PUSH1 0x20 JUMP "
 		"JUMPDEST PUSH1 0x0 PUSH1 0x0 "
 		"PUSH1 0x3 SWAP4 POP "
-		"PUSH1 0x9 PUSH1 0x2 SWAP2 POP "
-		"DUP2 DUP2 MSTORE "
-		"POP JUMPDEST SWAP5 POP SWAP5 SWAP3 POP POP POP JUMP "
+		"PUSH1 0x9 SWAP6 POP " // s re-uses the slot of the unused parameter d
+		"PUSH1 0x2 SWAP1 POP "
+		"DUP1 DUP7 MSTORE "
+		"JUMPDEST SWAP5 POP SWAP5 SWAP3 POP POP POP JUMP "
 		"JUMPDEST "
 	);
 }
@@ -292,6 +293,22 @@ BOOST_AUTO_TEST_CASE(functions_multi_return)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(function_reuse_parameter_after_last_use)
+{
+	string in = R"({
+		function f(a) -> r { mstore(a, 1) let x := 2 r := x }
+	})";
+	BOOST_CHECK_EQUAL(assemble(in),
+		"PUSH1 0x16 JUMP "
+		"JUMPDEST PUSH1 0x0 "
+		"PUSH1 0x1 DUP3 MSTORE "
+		"PUSH1 0x2 SWAP2 POP " // x re-uses the slot of a
+		"DUP2 SWAP1 POP "
+		"JUMPDEST SWAP2 SWAP1 POP JUMP "
+		"JUMPDEST "
+	);
+}
+
 BOOST_AUTO_TEST_CASE(reuse_slots_function)
 {
 	string in = R"({
@@ -408,6 +425,119 @@ BOOST_AUTO_TEST_CASE(reuse_on_decl_assign_not_same_scope)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(tail_call_multiple_return_variables)
+{
+	string in = R"({
+		function f(a) -> x, y { x, y := g(a, 1) }
+		function g(b, c) -> u, v { u := b v := c }
+		let p, q := f(calldataload(0))
+		sstore(p, q)
+	})";
+	BOOST_CHECK_EQUAL(assemble(in),
+		"PUSH1 0x2E JUMP "
+		"JUMPDEST PUSH1 0x0 PUSH1 0x0 "
+		"PUSH1 0x1 DUP4 "
+		"SWAP3 POP SWAP3 POP POP " // remove a, x and y below the arguments of g
+		"PUSH1 0x1C JUMP " // g returns to the caller of f
+		"SWAP2 POP SWAP2 POP " // unreachable assignment
+		"JUMPDEST SWAP2 POP SWAP2 JUMP "
+		"JUMPDEST PUSH1 0x0 PUSH1 0x0 DUP3 SWAP2 POP DUP4 SWAP1 POP "
+		"JUMPDEST SWAP3 POP SWAP3 SWAP1 POP JUMP "
+		"JUMPDEST PUSH1 0x37 PUSH1 0x0 CALLDATALOAD PUSH1 0x3 JUMP "
+		"JUMPDEST DUP1 DUP3 SSTORE POP POP "
+	);
+}
+
+BOOST_AUTO_TEST_CASE(no_tail_call_return_variables_in_other_order)
+{
+	string in = R"({
+		function f(a) -> x, y { y, x := g(a, 1) }
+		function g(b, c) -> u, v { u := b v := c }
+		let p, q := f(calldataload(0))
+		sstore(p, q)
+	})";
+	BOOST_CHECK_EQUAL(assemble(in),
+		"PUSH1 0x2C JUMP "
+		"JUMPDEST PUSH1 0x0 PUSH1 0x0 "
+		"PUSH1 0x10 PUSH1 0x1 DUP5 PUSH1 0x1A JUMP " // regular call with return label
+		"JUMPDEST SWAP3 POP SWAP1 POP "
+		"JUMPDEST SWAP2 POP SWAP2 JUMP "
+		"JUMPDEST PUSH1 0x0 PUSH1 0x0 DUP3 SWAP2 POP DUP4 SWAP1 POP "
+		"JUMPDEST SWAP3 POP SWAP3 SWAP1 POP JUMP "
+		"JUMPDEST PUSH1 0x35 PUSH1 0x0 CALLDATALOAD PUSH1 0x3 JUMP "
+		"JUMPDEST DUP1 DUP3 SSTORE POP POP "
+	);
+}
+
+BOOST_AUTO_TEST_CASE(tail_call_recursion)
+{
+	string in = R"({
+		function f(n, acc) {
+			if iszero(n) {
+				sstore(0, acc)
+				leave
+			}
+			f(sub(n, 1), add(acc, n))
+		}
+		f(calldataload(0), 0)
+	})";
+	BOOST_CHECK_EQUAL(assemble(in),
+		"PUSH1 0x24 JUMP "
+		"JUMPDEST DUP1 ISZERO ISZERO PUSH1 0x11 JUMPI "
+		"DUP2 PUSH1 0x0 SSTORE PUSH1 0x20 JUMP "
+		"JUMPDEST DUP1 DUP3 ADD PUSH1 0x1 DUP3 SUB "
+		"SWAP2 POP SWAP2 POP PUSH1 0x3 JUMP " // the recursion does not grow the stack
+		"JUMPDEST POP POP JUMP "
+		"JUMPDEST PUSH1 0x2F PUSH1 0x0 PUSH1 0x0 CALLDATALOAD PUSH1 0x3 JUMP "
+		"JUMPDEST "
+	);
+}
+
+BOOST_AUTO_TEST_CASE(tail_call_stack_limit)
+{
+	// The return label, the parameters of f and the argument of g use 17 slots.
+	string in = R"({
+		function f(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14) { g(a0) }
+		function g(b) { sstore(0, b) }
+		f(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14)
+	})";
+	BOOST_CHECK_EQUAL(assemble(in),
+		"PUSH1 0x31 JUMP "
+		"JUMPDEST DUP1 SWAP15 "
+		"POP POP POP POP POP POP POP POP POP POP POP POP POP POP POP " // remove a0 to a14
+		"PUSH1 0x29 JUMP "
+		"JUMPDEST POP POP POP POP POP POP POP POP POP POP POP POP POP POP POP JUMP "
+		"JUMPDEST DUP1 PUSH1 0x0 SSTORE JUMPDEST POP JUMP "
+		"JUMPDEST PUSH1 0x55 "
+		"PUSH1 0xE PUSH1 0xD PUSH1 0xC PUSH1 0xB PUSH1 0xA PUSH1 0x9 PUSH1 0x8 "
+		"PUSH1 0x7 PUSH1 0x6 PUSH1 0x5 PUSH1 0x4 PUSH1 0x3 PUSH1 0x2 PUSH1 0x1 PUSH1 0x0 "
+		"PUSH1 0x3 JUMP "
+		"JUMPDEST "
+	);
+}
+
+BOOST_AUTO_TEST_CASE(no_tail_call_beyond_stack_limit)
+{
+	// The return label, the parameters of f and the argument of g would need 18 slots.
+	string in = R"({
+		function f(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15) { g(a0) }
+		function g(b) { sstore(0, b) }
+		f(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+	})";
+	BOOST_CHECK_EQUAL(assemble(in),
+		"PUSH1 0x25 JUMP "
+		"JUMPDEST PUSH1 0xA DUP2 PUSH1 0x1D JUMP " // regular call with return label
+		"JUMPDEST JUMPDEST "
+		"POP POP POP POP POP POP POP POP POP POP POP POP POP POP POP POP JUMP "
+		"JUMPDEST DUP1 PUSH1 0x0 SSTORE JUMPDEST POP JUMP "
+		"JUMPDEST PUSH1 0x4B "
+		"PUSH1 0xF PUSH1 0xE PUSH1 0xD PUSH1 0xC PUSH1 0xB PUSH1 0xA PUSH1 0x9 PUSH1 0x8 "
+		"PUSH1 0x7 PUSH1 0x6 PUSH1 0x5 PUSH1 0x4 PUSH1 0x3 PUSH1 0x2 PUSH1 0x1 PUSH1 0x0 "
+		"PUSH1 0x3 JUMP "
+		"JUMPDEST "
+	);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
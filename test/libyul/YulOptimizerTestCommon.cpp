@@ -18,6 +18,7 @@
 
 #include <test/libyul/YulOptimizerTestCommon.h>
 
+#include <libyul/optimiser/AllocationEliminator.h>
 #include <libyul/optimiser/BlockFlattener.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/VarNameCleaner.h>
@@ -30,14 +31,17 @@
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
+#include <libyul/optimiser/FunctionEvaluator.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/FunctionSpecializer.h>
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/NameDisplacer.h>
@@ -47,11 +51,14 @@
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/ExpressionJoiner.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/RangeBasedSimplifier.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
+#include <libyul/optimiser/RedundantStoreEliminator.h>
+#include <libyul/optimiser/StatementScheduler.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/Suite.h>
@@ -231,6 +238,15 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			ForLoopInitRewriter::run(*m_context, *m_ast);
 			RedundantAssignEliminator::run(*m_context, *m_ast);
 		}},
+		{"redundantStoreEliminator", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			RedundantStoreEliminator::run(*m_context, *m_ast);
+		}},
+		{"statementScheduler", [&]() {
+			disambiguate();
+			StatementScheduler::run(*m_context, *m_ast);
+		}},
 		{"ssaPlusCleanup", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -257,6 +273,30 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_ast);
 			LoopInvariantCodeMotion::run(*m_context, *m_ast);
 		}},
+		{"loopUnroller", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			FunctionHoister::run(*m_context, *m_ast);
+			GasMeter meter(dynamic_cast<EVMDialect const&>(*m_dialect), false, 200);
+			m_context->gasMeter = &meter;
+			LoopUnroller::run(*m_context, *m_ast);
+			m_context->gasMeter = nullptr;
+		}},
+		{"allocationEliminator", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_ast);
+			AllocationEliminator::run(*m_context, *m_ast);
+		}},
+		{"functionEvaluator", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_ast);
+			FunctionEvaluator::run(*m_context, *m_ast);
+		}},
+		{"functionSpecializer", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_ast);
+			FunctionSpecializer::run(*m_context, *m_ast);
+		}},
 		{"controlFlowSimplifier", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -269,6 +309,11 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			LiteralRematerialiser::run(*m_context, *m_ast);
 			StructuralSimplifier::run(*m_context, *m_ast);
 		}},
+		{"rangeBasedSimplifier", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			RangeBasedSimplifier::run(*m_context, *m_ast);
+		}},
 		{"reasoningBasedSimplifier", [&]() {
 			disambiguate();
 			ReasoningBasedSimplifier::run(*m_context, *m_object->code);
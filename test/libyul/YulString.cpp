@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+#include <libyul/YulStringTable.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(empty_string)
+{
+	BOOST_CHECK(YulString().empty());
+	BOOST_CHECK(YulString("") == YulString());
+	BOOST_CHECK_EQUAL(YulString().str(), "");
+	BOOST_CHECK(!YulString("x").empty());
+}
+
+BOOST_AUTO_TEST_CASE(identity)
+{
+	YulString a("yul_string_test_identity");
+	BOOST_CHECK(a == YulString(string("yul_string_test_") + "identity"));
+	BOOST_CHECK(a != YulString("yul_string_test_identity2"));
+	BOOST_CHECK_EQUAL(a.str(), "yul_string_test_identity");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("yul_string_test_identity"));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_insertion)
+{
+	size_t constexpr threadCount = 4;
+	size_t constexpr stringCount = 5000;
+	vector<vector<YulString>> strings(threadCount);
+	vector<thread> threads;
+	for (size_t i = 0; i < threadCount; ++i)
+		threads.emplace_back([&, i]() {
+			for (size_t j = 0; j < stringCount; ++j)
+				strings[i].emplace_back("yul_string_test_concurrent_" + to_string(j));
+		});
+	for (thread& t: threads)
+		t.join();
+
+	for (size_t i = 1; i < threadCount; ++i)
+		BOOST_CHECK(strings[i] == strings[0]);
+	for (size_t j = 0; j < stringCount; ++j)
+		BOOST_CHECK_EQUAL(strings[0][j].str(), "yul_string_test_concurrent_" + to_string(j));
+}
+
+BOOST_AUTO_TEST_CASE(table)
+{
+	size_t constexpr stringCount = 1000;
+	vector<YulString> strings;
+	for (size_t i = 0; i < stringCount; ++i)
+		strings.emplace_back("yul_string_test_table_" + to_string(i));
+
+	YulStringTable<YulString> table;
+	for (size_t i = 0; i < stringCount; i += 2)
+		table.insert(strings[i], &strings[i]);
+	table.insert(strings[0], &strings[1]);
+	BOOST_CHECK_EQUAL(table.size(), stringCount / 2);
+	BOOST_CHECK(table.find(strings[0]) == &strings[1]);
+	for (size_t i = 1; i < stringCount; ++i)
+	{
+		BOOST_CHECK(table.contains(strings[i]) == (i % 2 == 0));
+		BOOST_CHECK(table.find(strings[i]) == (i % 2 == 0 ? &strings[i] : nullptr));
+	}
+	BOOST_CHECK(!table.contains(YulString{}));
+
+	table.clear();
+	BOOST_CHECK(!table.find(strings[0]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -63,7 +63,11 @@ IsolTestOptions::IsolTestOptions(std::string* _editor):
 		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "Path to editor for opening test files.")
 		("help", po::bool_switch(&showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor), "Don't use colors.")
-		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
+		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.")
+		("jobs,j", po::value<size_t>(&jobs)->default_value(1), "Number of test cases to run concurrently in separate processes. Failing test cases are re-run locally before asking how to proceed.")
+		("worker", po::bool_switch(&worker), "Run the test cases read from standard input for a parallel run. Used internally by --jobs.")
+		("gas-report", po::value<std::string>(&gasReport), "Write the gas used and the deployed code size of every successful semantic test as JSON to the given file.")
+		("gas-baseline", po::value<std::string>(&gasBaseline), "Compare the gas used and the code sizes of the semantic tests to the given earlier gas report.");
 }
 
 bool IsolTestOptions::parse(int _argc, char const* const* _argv)
@@ -89,6 +93,12 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(jobs > 0, ConfigException, "The number of jobs must be at least one.");
+	assertThrow(
+		jobs == 1 || (gasReport.empty() && gasBaseline.empty()),
+		ConfigException,
+		"Gas reports cannot be combined with --jobs."
+	);
 }
 
 }
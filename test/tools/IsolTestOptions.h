@@ -32,6 +32,14 @@ struct IsolTestOptions: CommonOptions
 	bool showHelp = false;
 	bool noColor = false;
 	std::string testFilter = std::string{};
+	/// Number of test cases that are run concurrently in worker processes.
+	size_t jobs = 1;
+	/// Run as a worker process of a parallel run.
+	bool worker = false;
+	/// File to write the gas used and the code size of the successful semantic tests to.
+	std::string gasReport;
+	/// Gas report of an earlier run to compare the gas measurements to.
+	std::string gasBaseline;
 
 	IsolTestOptions(std::string* _editor);
 	bool parse(int _argc, char const* const* _argv) override;
@@ -0,0 +1,259 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark for the Ewasm backend: Compiles Yul objects to Ewasm, reports the
+ * translation and assembly times as well as the module size and optionally
+ * deploys and executes the objects in an evmc-compatible Ewasm VM.
+ */
+
+#include <test/EVMHost.h>
+
+#include <libyul/AssemblyStack.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+using namespace solidity::test;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+using Clock = chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point _start)
+{
+	return chrono::duration<double, milli>(Clock::now() - _start).count();
+}
+
+struct CompilationResult
+{
+	bytes bytecode;
+	double translationTime = 0;
+	double assemblyTime = 0;
+};
+
+/// Compiles the Yul object @a _source to Ewasm @a _repetitions times and
+/// @returns the bytecode together with the average times.
+optional<CompilationResult> compile(string const& _name, string const& _source, bool _optimize, size_t _repetitions)
+{
+	CompilationResult result;
+	for (size_t i = 0; i < _repetitions; ++i)
+	{
+		AssemblyStack stack(
+			EVMVersion{},
+			AssemblyStack::Language::StrictAssembly,
+			_optimize ? frontend::OptimiserSettings::full() : frontend::OptimiserSettings::minimal()
+		);
+		if (!stack.parseAndAnalyze(_name, _source))
+		{
+			for (auto const& error: stack.errors())
+				SourceReferenceFormatter(cerr, true, false).printErrorInformation(*error);
+			return nullopt;
+		}
+
+		auto start = Clock::now();
+		stack.optimize();
+		stack.translate(AssemblyStack::Language::Ewasm);
+		stack.optimize();
+		result.translationTime += millisecondsSince(start);
+
+		start = Clock::now();
+		MachineAssemblyObject object = stack.assemble(AssemblyStack::Machine::Ewasm);
+		result.assemblyTime += millisecondsSince(start);
+		result.bytecode = object.bytecode->bytecode;
+	}
+	result.translationTime /= double(_repetitions);
+	result.assemblyTime /= double(_repetitions);
+	return result;
+}
+
+/// @returns the call data given by lines of the form "// call: <hex>" in @a _source.
+vector<bytes> entryPoints(string const& _source)
+{
+	vector<bytes> calls;
+	vector<string> lines;
+	boost::split(lines, _source, boost::is_any_of("\n"));
+	for (string const& line: lines)
+		if (boost::starts_with(line, "// call:"))
+			calls.emplace_back(fromHex(boost::trim_copy(line.substr(string("// call:").size()))));
+	return calls;
+}
+
+/// Deploys @a _bytecode in a fresh host and executes all entry points, printing
+/// the gas used and the execution time of each of them.
+bool execute(evmc::VM& _vm, bytes const& _bytecode, vector<bytes> const& _calls)
+{
+	EVMHost host(EVMVersion{}, _vm);
+	Address const sender(h256(u256{"0x1212121212121212121212121212120000000012"}), Address::AlignRight);
+	int64_t const gas = 100000000;
+
+	auto sendMessage = [&](evmc_call_kind _kind, evmc::address _destination, bytes const& _data) {
+		host.newBlock();
+		evmc_message message = {};
+		message.kind = _kind;
+		message.sender = EVMHost::convertToEVMC(sender);
+		message.destination = _destination;
+		message.input_data = _data.data();
+		message.input_size = _data.size();
+		message.gas = gas;
+		return host.call(message);
+	};
+
+	evmc::result creation = sendMessage(EVMC_CREATE, EVMHost::convertToEVMC(Address{}), _bytecode);
+	if (creation.status_code != EVMC_SUCCESS)
+	{
+		cout << "  deployment failed with status " << creation.status_code << endl;
+		return false;
+	}
+	cout << "  deployment: " << (gas - creation.gas_left) << " gas" << endl;
+
+	bool success = true;
+	for (bytes const& callData: _calls)
+	{
+		auto start = Clock::now();
+		evmc::result result = sendMessage(EVMC_CALL, creation.create_address, callData);
+		double time = millisecondsSince(start);
+		cout << "  call 0x" << toHex(callData) << ": ";
+		if (result.status_code == EVMC_SUCCESS)
+			cout << (gas - result.gas_left) << " gas, " << fixed << setprecision(3) << time << " ms" << endl;
+		else
+		{
+			cout << "failed with status " << result.status_code << endl;
+			success = false;
+		}
+	}
+	return success;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(ewasmbench, benchmark for the Ewasm backend.
+Usage: ewasmbench [Options] <file>...
+Compiles each Yul object to Ewasm and prints the time taken by the translation
+from EVM dialect to Ewasm including the optimiser, the time taken by the Wasm
+assembly step and the size of the resulting module.
+If an Ewasm VM is given, the object is deployed and every entry point given by
+a line of the form "// call: <hex call data>" in the source is executed.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("optimize", "Run the Yul optimiser before and after the translation.")
+		("repeat", po::value<size_t>()->default_value(1), "Compile every object this many times and report the average times.")
+		("vm", po::value<string>(), "Path to an evmc-compatible Ewasm VM, e.g. hera, used to execute the objects.")
+		("input-file", po::value<vector<string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	size_t repetitions = max<size_t>(arguments["repeat"].as<size_t>(), 1);
+	evmc::VM* vm = nullptr;
+	if (arguments.count("vm"))
+	{
+		vm = &EVMHost::getVM(arguments["vm"].as<string>());
+		if (!*vm || !vm->has_capability(EVMC_CAPABILITY_EWASM))
+		{
+			cerr << "Could not load an Ewasm VM from " << arguments["vm"].as<string>() << endl;
+			return 1;
+		}
+	}
+
+	bool success = true;
+	for (string const& path: arguments["input-file"].as<vector<string>>())
+	{
+		string source;
+		try
+		{
+			source = readFileAsString(path);
+		}
+		catch (FileNotFound const&)
+		{
+			cerr << "File not found: " << path << endl;
+			return 1;
+		}
+
+		string name = boost::filesystem::path(path).filename().string();
+		optional<CompilationResult> result;
+		try
+		{
+			result = compile(name, source, arguments.count("optimize"), repetitions);
+		}
+		catch (Exception const& _exception)
+		{
+			cerr << "Exception while compiling " << path << ": " << boost::diagnostic_information(_exception) << endl;
+		}
+		if (!result)
+		{
+			success = false;
+			continue;
+		}
+
+		cout << name << ": " << result->bytecode.size() << " bytes, translation " <<
+			fixed << setprecision(3) << result->translationTime << " ms, assembly " <<
+			result->assemblyTime << " ms" << endl;
+		if (vm && !execute(*vm, result->bytecode, entryPoints(source)))
+			success = false;
+	}
+
+	return success ? 0 : 1;
+}
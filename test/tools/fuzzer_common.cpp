@@ -22,6 +22,8 @@
 
 #include <libsolutil/JSON.h>
 
+#include <libyul/YulString.h>
+
 #include <libevmasm/Assembly.h>
 #include <libevmasm/ConstantOptimiser.h>
 
@@ -83,6 +85,7 @@ void FuzzerUtil::forceSMT(StringMap& _input)
 
 void FuzzerUtil::testCompiler(StringMap& _input, bool _optimize, unsigned _rand, bool _forceSMT)
 {
+	yul::YulStringRepository::resetIfLargerThan(maxYulStrings);
 	frontend::CompilerStack compiler;
 	EVMVersion evmVersion = s_evmVersions[_rand % s_evmVersions.size()];
 	frontend::OptimiserSettings optimiserSettings;
@@ -46,4 +46,9 @@ struct FuzzerUtil
 	/// Adds the experimental SMTChecker pragma to each source file in the
 	/// source map.
 	static void forceSMT(solidity::StringMap& _input);
+	/// Number of Yul strings after which fuzzers clear the Yul string repository.
+	/// Fuzzers run many inputs in the same process, and clearing the repository
+	/// for every input also drops the cached dialects and polyfills, so it is
+	/// only cleared once it grows beyond this limit.
+	static size_t constexpr maxYulStrings = 100000;
 };
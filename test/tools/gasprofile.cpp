@@ -0,0 +1,152 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Source-level gas profiler: Attributes the gas used by transactions, given as instruction
+ * traces in the format of EIP-3155 (e.g. from `evm --json` or evmone), to the source
+ * locations of a contract compiled with `solc --combined-json bin-runtime,srcmap-runtime`.
+ */
+
+#include <test/GasProfiler.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::test;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// @returns the runtime bytecode of a combined JSON output, with the placeholders of
+/// unlinked libraries replaced by zeros.
+bytes runtimeBytecode(string _hex)
+{
+	replace_if(_hex.begin(), _hex.end(), [](char _c) { return !isxdigit(_c); }, '0');
+	return fromHex(_hex, WhenError::Throw);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(gasprofile, the source-level gas profiler.
+Usage: gasprofile [Options] --combined-json <file> --contract <name> <trace>...
+Prints the gas used by the calls traced in the given EIP-3155 traces per source location
+and internal call stack as folded stacks, the input format of flamegraph.pl.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23
+	);
+	options.add_options()
+		("help", "Show this help screen.")
+		("combined-json", po::value<string>(), "Output of solc --combined-json bin-runtime,srcmap-runtime.")
+		("contract", po::value<string>(), "Name of the called contract as in the combined JSON, i.e. <source>:<name>. Can be omitted if there is only one contract.")
+		("base-path", po::value<string>()->default_value("."), "Directory the names of the sources are relative to.")
+		("by-location", "Print the gas per source location instead of folded stacks.")
+		("trace", po::value<vector<string>>(), "Instruction traces of calls to the contract.");
+	po::positional_options_description positionalOptions;
+	positionalOptions.add("trace", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::command_line_parser(argc, argv).options(options).positional(positionalOptions).run(), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("combined-json") || !arguments.count("trace"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	Json::Value combinedJson;
+	if (!jsonParseStrict(readFileAsString(arguments["combined-json"].as<string>()), combinedJson) || !combinedJson.isObject())
+	{
+		cerr << "Invalid combined JSON." << endl;
+		return 1;
+	}
+	Json::Value const& contracts = combinedJson["contracts"];
+	string contractName;
+	if (arguments.count("contract"))
+		contractName = arguments["contract"].as<string>();
+	else if (contracts.size() == 1)
+		contractName = contracts.getMemberNames().front();
+	if (!contracts.isMember(contractName))
+	{
+		cerr << "Contract not found in the combined JSON. Use --contract with one of:" << endl;
+		for (string const& name: contracts.getMemberNames())
+			cerr << "  " << name << endl;
+		return 1;
+	}
+	Json::Value const& contract = contracts[contractName];
+	if (!contract["bin-runtime"].isString() || !contract["srcmap-runtime"].isString())
+	{
+		cerr << "The combined JSON has to contain bin-runtime and srcmap-runtime." << endl;
+		return 1;
+	}
+
+	fs::path basePath = arguments["base-path"].as<string>();
+	vector<shared_ptr<CharStream const>> sources;
+	for (auto const& sourceName: combinedJson["sourceList"])
+	{
+		fs::path path = basePath / sourceName.asString();
+		if (fs::exists(path))
+			sources.emplace_back(make_shared<CharStream>(readFileAsString(path.string()), sourceName.asString()));
+		else
+		{
+			cerr << "Source " << path.string() << " not found." << endl;
+			sources.emplace_back(nullptr);
+		}
+	}
+
+	bytes code = runtimeBytecode(contract["bin-runtime"].asString());
+	GasProfiler profiler;
+	profiler.addCode(contractName, code, contract["srcmap-runtime"].asString(), move(sources));
+	for (string const& trace: arguments["trace"].as<vector<string>>())
+		profiler.addTrace(code, GasProfiler::parseTrace(readFileAsString(trace)));
+
+	if (arguments.count("by-location"))
+		for (auto const& [location, gas]: profiler.gasBySourceRange())
+			cout << location << " " << gas << endl;
+	else
+		cout << profiler.folded();
+	return 0;
+}
@@ -18,6 +18,8 @@
 
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/AnsiColorized.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
 
 #include <memory>
 #include <test/Common.h>
@@ -25,17 +27,27 @@
 #include <test/InteractiveTests.h>
 #include <test/EVMHost.h>
 
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/split.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/process.hpp>
 
+#include <condition_variable>
 #include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <queue>
 #include <regex>
+#include <thread>
 #include <utility>
 
 #if defined(_WIN32)
 #include <windows.h>
+#include <fcntl.h>
+#include <io.h>
 #endif
 
 using namespace std;
@@ -47,6 +59,7 @@ using namespace solidity::util::formatting;
 
 namespace po = boost::program_options;
 namespace fs = boost::filesystem;
+namespace bp = boost::process;
 
 using TestCreator = TestCase::TestCaseCreator;
 using TestOptions = solidity::test::IsolTestOptions;
@@ -89,6 +102,101 @@ private:
 	regex m_filterExpression;
 };
 
+/// Collects the gas used and the code sizes of successful semantic tests and compares them
+/// to an earlier report.
+class GasReport
+{
+public:
+	void record(string const& _test, SemanticTest const& _semanticTest)
+	{
+		for (auto const& [codeGenerator, measurement]: _semanticTest.gasMeasurements())
+		{
+			Json::Value& entry = m_tests[_test][codeGenerator];
+			entry["gasUsed"] = Json::UInt64(static_cast<uint64_t>(measurement.gasUsed));
+			entry["codeSize"] = Json::UInt64(measurement.codeSize);
+		}
+	}
+
+	Json::Value toJson(TestOptions const& _options) const
+	{
+		Json::Value report(Json::objectValue);
+		report["evmVersion"] = _options.evmVersion().name();
+		report["optimize"] = _options.optimize;
+		report["tests"] = m_tests;
+		return report;
+	}
+
+	/// Prints the measurements that differ from @a _baseline as well as the totals over all
+	/// tests measured in both runs.
+	/// @returns the differences as a JSON array.
+	Json::Value compare(Json::Value const& _baseline, ostream& _out, bool _formatted) const;
+
+private:
+	Json::Value m_tests{Json::objectValue};
+};
+
+Json::Value GasReport::compare(Json::Value const& _baseline, ostream& _out, bool _formatted) const
+{
+	auto printChange = [&](string const& _metric, Json::UInt64 _before, Json::UInt64 _after) {
+		_out << _metric << " " << _before << " -> " << _after;
+		if (_before != _after && _before != 0)
+		{
+			double change = (double(_after) - double(_before)) * 100 / double(_before);
+			_out << " (";
+			AnsiColorized(_out, _formatted, {BOLD, _after < _before ? GREEN : RED}) <<
+				(change > 0 ? "+" : "") << fixed << setprecision(2) << change << "%";
+			_out << ")";
+		}
+	};
+
+	Json::Value differences(Json::arrayValue);
+	map<string, array<Json::UInt64, 5>> totals;
+	for (auto const& test: m_tests.getMemberNames())
+		for (auto const& codeGenerator: m_tests[test].getMemberNames())
+		{
+			Json::Value const& before = _baseline["tests"][test][codeGenerator];
+			Json::Value const& after = m_tests[test][codeGenerator];
+			if (!before.isObject())
+				continue;
+			auto& total = totals[codeGenerator];
+			total[0] += before["gasUsed"].asUInt64();
+			total[1] += after["gasUsed"].asUInt64();
+			total[2] += before["codeSize"].asUInt64();
+			total[3] += after["codeSize"].asUInt64();
+			++total[4];
+			if (
+				before["gasUsed"].asUInt64() == after["gasUsed"].asUInt64() &&
+				before["codeSize"].asUInt64() == after["codeSize"].asUInt64()
+			)
+				continue;
+
+			Json::Value difference(Json::objectValue);
+			difference["test"] = test;
+			difference["codeGenerator"] = codeGenerator;
+			difference["before"] = before;
+			difference["after"] = after;
+			differences.append(difference);
+
+			_out << "  " << test << " (" << codeGenerator << "): ";
+			printChange("gas", before["gasUsed"].asUInt64(), after["gasUsed"].asUInt64());
+			_out << ", ";
+			printChange("code size", before["codeSize"].asUInt64(), after["codeSize"].asUInt64());
+			_out << endl;
+		}
+
+	for (auto const& [codeGenerator, total]: totals)
+	{
+		_out << "Total (" << codeGenerator << ", " << total[4] << " tests): ";
+		printChange("gas", total[0], total[1]);
+		_out << ", ";
+		printChange("code size", total[2], total[3]);
+		_out << endl;
+	}
+	return differences;
+}
+
+class TestWorkerPool;
+
 class TestTool
 {
 public:
@@ -113,16 +221,27 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case if it matches the filter and writes the result to @a _out.
+	Result process(ostream& _out);
 
+	/// @returns the test files in @a _path, relative to @a _basepath, in the order in which they are run.
+	static vector<fs::path> testFiles(fs::path const& _basepath, fs::path const& _path);
+
+	/// Runs the tests @a _tests in @a _basepath and asks how to proceed on failures.
+	/// If @a _pool is given, it has already been assigned the tests as the tasks starting at @a _firstTask
+	/// and failing tests are re-run locally to allow updating their expectations.
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
 		TestOptions const& _options,
 		fs::path const& _basepath,
-		fs::path const& _path
+		vector<fs::path> const& _tests,
+		TestWorkerPool* _pool = nullptr,
+		size_t _firstTask = 0
 	);
 
 	static string editor;
+	/// Report to record the gas measurements of successful semantic tests in, if any.
+	static GasReport* gasReport;
 private:
 	enum class Request
 	{
@@ -145,9 +264,10 @@ private:
 };
 
 string TestTool::editor;
+GasReport* TestTool::gasReport = nullptr;
 bool TestTool::m_exitRequested = false;
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(ostream& _out)
 {
 	bool formatted{!m_options.noColor};
 	std::stringstream outputMessages;
@@ -156,7 +276,7 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_name))
 		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(_out, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{
 				m_path.string(),
@@ -168,21 +288,24 @@ TestTool::Result TestTool::process()
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+						AnsiColorized(_out, formatted, {BOLD, GREEN}) << "OK" << endl;
+						if (gasReport)
+							if (auto const* semanticTest = dynamic_cast<SemanticTest const*>(m_test.get()))
+								gasReport->record(m_name, *semanticTest);
 						return Result::Success;
 					default:
-						AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+						AnsiColorized(_out, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-						AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-						m_test->printSource(cout, "    ", formatted);
-						m_test->printSettings(cout, "    ", formatted);
+						AnsiColorized(_out, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+						m_test->printSource(_out, "    ", formatted);
+						m_test->printSettings(_out, "    ", formatted);
 
-						cout << endl << outputMessages.str() << endl;
+						_out << endl << outputMessages.str() << endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			else
 			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+				AnsiColorized(_out, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 				return Result::Skipped;
 			}
 		}
@@ -191,13 +314,13 @@ TestTool::Result TestTool::process()
 	}
 	catch (boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_out, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_out, formatted, {BOLD, RED}) <<
 			"Exception during test" <<
 			(_e.what() ? ": " + string(_e.what()) : ".") <<
 			endl;
@@ -205,7 +328,7 @@ TestTool::Result TestTool::process()
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_out, formatted, {BOLD, RED}) <<
 			"Unknown exception during test." << endl;
 		return Result::Exception;
 	}
@@ -253,38 +376,243 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
-TestStats TestTool::processPath(
-	TestCreator _testCaseCreator,
-	TestOptions const& _options,
-	fs::path const& _basepath,
-	fs::path const& _path
-)
+/**
+ * Runs test cases in worker processes, which are instances of isoltest started with the same
+ * options and --worker. Every worker is fed by a thread that takes the next task from the shared
+ * list as soon as the worker has finished its previous one. Separate processes are used because
+ * the compiler keeps global state, such as the types, that must not be shared by concurrent
+ * compilations, and every worker sets up its own EVM host.
+ */
+class TestWorkerPool
+{
+public:
+	struct Task
+	{
+		/// Index of the suite in g_interactiveTestsuites.
+		size_t suite;
+		fs::path path;
+		string name;
+	};
+	struct Outcome
+	{
+		TestTool::Result result;
+		/// Output of the test as it would have been printed by an in-process run.
+		string output;
+	};
+
+	TestWorkerPool(fs::path _executable, vector<string> _arguments, vector<Task> _tasks, size_t _jobs):
+		m_executable(std::move(_executable)),
+		m_arguments(std::move(_arguments)),
+		m_tasks(std::move(_tasks)),
+		m_outcomes(m_tasks.size())
+	{
+		for (size_t i = 0; i < min(_jobs, m_tasks.size()); ++i)
+			m_threads.emplace_back([this] { feedWorker(); });
+	}
+	~TestWorkerPool()
+	{
+		stop();
+		for (auto& thread: m_threads)
+			thread.join();
+	}
+
+	/// Waits until the task @a _index has been run and @returns its outcome.
+	Outcome const& outcome(size_t _index)
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_taskDone.wait(lock, [&] { return m_outcomes[_index].has_value(); });
+		return *m_outcomes[_index];
+	}
+
+	/// Stops handing out tasks. Tasks that are already running are finished.
+	void stop()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopped = true;
+	}
+
+	/// Runs the tasks read from standard input in the current process and writes their outcomes
+	/// to standard output. This is the main loop of a worker process.
+	static int runWorker(TestOptions const& _options);
+
+private:
+	static constexpr char const* outcomeHeader = "isoltest-outcome ";
+
+	void feedWorker();
+	/// @returns the next outcome written by a worker to @a _input or nullopt if the worker terminated.
+	static optional<Outcome> readOutcome(istream& _input);
+
+	fs::path const m_executable;
+	vector<string> const m_arguments;
+	vector<Task> const m_tasks;
+	vector<optional<Outcome>> m_outcomes;
+	size_t m_nextTask = 0;
+	bool m_stopped = false;
+	mutex m_mutex;
+	condition_variable m_taskDone;
+	vector<thread> m_threads;
+};
+
+void TestWorkerPool::feedWorker()
+{
+	unique_ptr<bp::opstream> input;
+	unique_ptr<bp::ipstream> output;
+	unique_ptr<bp::child> worker;
+
+	while (true)
+	{
+		size_t index = 0;
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (m_stopped || m_nextTask == m_tasks.size())
+				break;
+			index = m_nextTask++;
+		}
+
+		if (!worker)
+		{
+			input = make_unique<bp::opstream>();
+			output = make_unique<bp::ipstream>();
+			worker = make_unique<bp::child>(m_executable, m_arguments, bp::std_in < *input, bp::std_out > *output);
+		}
+		Task const& task = m_tasks[index];
+		*input << task.suite << '\t' << task.path.string() << '\t' << task.name << endl;
+		optional<Outcome> outcome = readOutcome(*output);
+		if (!outcome)
+		{
+			// The worker crashed. The remaining tasks are run by a new one.
+			worker->wait();
+			worker.reset();
+			outcome = Outcome{
+				TestTool::Result::Exception,
+				task.name + ": Worker process terminated unexpectedly.\n"
+			};
+		}
+
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_outcomes[index] = std::move(outcome);
+		}
+		m_taskDone.notify_all();
+	}
+
+	if (worker)
+	{
+		input->pipe().close();
+		worker->wait();
+	}
+}
+
+optional<TestWorkerPool::Outcome> TestWorkerPool::readOutcome(istream& _input)
+{
+	string line;
+	while (getline(_input, line))
+		// Anything written before the header, e.g. by the option parser, is ignored.
+		if (boost::starts_with(line, outcomeHeader))
+		{
+			int result = 0;
+			size_t size = 0;
+			if (!(istringstream(line.substr(string(outcomeHeader).size())) >> result >> size))
+				return nullopt;
+			string output(size, '\0');
+			if (!_input.read(output.data(), static_cast<streamsize>(size)))
+				return nullopt;
+			return Outcome{static_cast<TestTool::Result>(result), std::move(output)};
+		}
+	return nullopt;
+}
+
+int TestWorkerPool::runWorker(TestOptions const& _options)
+{
+#if defined(_WIN32)
+	// The size of the output is sent along with it, so newlines must not be translated.
+	_setmode(_fileno(stdout), _O_BINARY);
+#endif
+	// Test cases may print to standard output directly, which is captured as part of their output.
+	ostream protocol(cout.rdbuf());
+	stringstream capturedOutput;
+	cout.rdbuf(capturedOutput.rdbuf());
+
+	string line;
+	while (getline(cin, line))
+	{
+		vector<string> fields;
+		boost::split(fields, line, boost::is_any_of("\t"));
+		if (fields.size() != 3)
+			return 1;
+
+		TestTool testTool(
+			g_interactiveTestsuites[stoul(fields[0])].testCaseCreator,
+			_options,
+			fields[1],
+			fields[2]
+		);
+		stringstream output;
+		TestTool::Result result = testTool.process(output);
+		string text = capturedOutput.str() + output.str();
+		capturedOutput.str({});
+
+		protocol << outcomeHeader << static_cast<int>(result) << " " << text.size() << "\n" << text;
+		protocol.flush();
+	}
+	return 0;
+}
+
+vector<fs::path> TestTool::testFiles(fs::path const& _basepath, fs::path const& _path)
 {
+	vector<fs::path> tests;
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
 
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
+			// Sorted, so that the order of the tests does not depend on the file system.
+			vector<fs::path> entries;
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
 			))
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
-					paths.push(currentPath / entry.path().filename());
+					entries.push_back(entry.path().filename());
+			sort(entries.begin(), entries.end());
+			for (auto const& entry: entries)
+				paths.push(currentPath / entry);
 		}
-		else if (m_exitRequested)
+		else
+			tests.push_back(currentPath);
+	}
+	return tests;
+}
+
+TestStats TestTool::processPath(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	vector<fs::path> const& _tests,
+	TestWorkerPool* _pool,
+	size_t _firstTask
+)
+{
+	int successCount = 0;
+	int testCount = 0;
+	int skippedCount = 0;
+	// Index of the test that is re-run locally after it was edited or updated.
+	optional<size_t> rerunTest;
+
+	for (size_t i = 0; i < _tests.size();)
+	{
+		fs::path const& currentPath = _tests[i];
+		fs::path fullpath = _basepath / currentPath;
+		if (m_exitRequested)
 		{
 			++testCount;
-			paths.pop();
+			++i;
 		}
 		else
 		{
@@ -295,7 +623,20 @@ TestStats TestTool::processPath(
 				fullpath,
 				currentPath.generic_path().string()
 			);
-			auto result = testTool.process();
+
+			Result result;
+			if (_pool && rerunTest != i)
+			{
+				TestWorkerPool::Outcome const& outcome = _pool->outcome(_firstTask + i);
+				result = outcome.result;
+				// Expectations can only be updated from a local run.
+				if (result == Result::Failure)
+					result = testTool.process(cout);
+				else
+					cout << outcome.output << flush;
+			}
+			else
+				result = testTool.process(cout);
 
 			switch(result)
 			{
@@ -304,25 +645,28 @@ TestStats TestTool::processPath(
 				switch(testTool.handleResponse(result == Result::Exception))
 				{
 				case Request::Quit:
-					paths.pop();
+					++i;
 					m_exitRequested = true;
+					if (_pool)
+						_pool->stop();
 					break;
 				case Request::Rerun:
 					cout << "Re-running test case..." << endl;
 					--testCount;
+					rerunTest = i;
 					break;
 				case Request::Skip:
-					paths.pop();
+					++i;
 					++skippedCount;
 					break;
 				}
 				break;
 			case Result::Success:
-				paths.pop();
+				++i;
 				++successCount;
 				break;
 			case Result::Skipped:
-				paths.pop();
+				++i;
 				++skippedCount;
 				break;
 			}
@@ -356,28 +700,25 @@ void setupTerminal()
 #endif
 }
 
-std::optional<TestStats> runTestSuite(
+TestStats runTestSuite(
 	TestCreator _testCaseCreator,
 	TestOptions const& _options,
 	fs::path const& _basePath,
-	fs::path const& _subdirectory,
+	vector<fs::path> const& _tests,
+	TestWorkerPool* _pool,
+	size_t _firstTask,
 	string const& _name
 )
 {
-	fs::path testPath{_basePath / _subdirectory};
 	bool formatted{!_options.noColor};
 
-	if (!fs::exists(testPath) || !fs::is_directory(testPath))
-	{
-		cerr << _name << " tests not found. Use the --testpath argument." << endl;
-		return std::nullopt;
-	}
-
 	TestStats stats = TestTool::processPath(
 		_testCaseCreator,
 		_options,
 		_basePath,
-		_subdirectory
+		_tests,
+		_pool,
+		_firstTask
 	);
 
 	if (stats.skippedCount != stats.testCount)
@@ -425,6 +766,9 @@ int main(int argc, char const *argv[])
 
 	auto& options = dynamic_cast<solidity::test::IsolTestOptions const&>(solidity::test::CommonOptions::get());
 
+	if (options.worker)
+		return TestWorkerPool::runWorker(options);
+
 	bool disableSemantics = true;
 	try
 	{
@@ -439,30 +783,81 @@ int main(int argc, char const *argv[])
 	if (disableSemantics)
 		cout << endl << "--- SKIPPING ALL SEMANTICS TESTS ---" << endl << endl;
 
-	TestStats global_stats{0, 0};
-	cout << "Running tests..." << endl << endl;
-
-	// Actually run the tests.
 	// Interactive tests are added in InteractiveTests.h
-	for (auto const& ts: g_interactiveTestsuites)
+	// The tests of all suites are collected first, so that they can be handed out to worker processes.
+	vector<TestWorkerPool::Task> tasks;
+	for (size_t suite = 0; suite < size(g_interactiveTestsuites); ++suite)
 	{
+		auto const& ts = g_interactiveTestsuites[suite];
 		if (ts.needsVM && disableSemantics)
 			continue;
 
 		if (ts.smt && options.disableSMT)
 			continue;
 
-		auto stats = runTestSuite(
+		fs::path testPath{options.testPath / ts.path / ts.subpath};
+		if (!fs::exists(testPath) || !fs::is_directory(testPath))
+		{
+			cerr << ts.title << " tests not found. Use the --testpath argument." << endl;
+			return 1;
+		}
+
+		for (auto const& test: TestTool::testFiles(options.testPath / ts.path, ts.subpath))
+			tasks.push_back({suite, options.testPath / ts.path / test, test.generic_path().string()});
+	}
+
+	unique_ptr<TestWorkerPool> pool;
+	if (options.jobs > 1)
+	{
+		fs::path executable{argv[0]};
+		if (!executable.has_parent_path())
+			executable = bp::search_path(executable);
+		vector<string> arguments(argv + 1, argv + argc);
+		arguments.emplace_back("--worker");
+		pool = make_unique<TestWorkerPool>(executable, std::move(arguments), tasks, options.jobs);
+	}
+
+	Json::Value gasBaseline;
+	if (!options.gasBaseline.empty())
+		try
+		{
+			if (!jsonParseStrict(readFileAsString(options.gasBaseline), gasBaseline) || !gasBaseline.isObject())
+			{
+				cerr << "Invalid gas baseline: " << options.gasBaseline << endl;
+				return 1;
+			}
+		}
+		catch (FileNotFound const&)
+		{
+			cerr << "Gas baseline not found: " << options.gasBaseline << endl;
+			return 1;
+		}
+
+	GasReport gasReport;
+	if (!options.gasReport.empty() || !options.gasBaseline.empty())
+		TestTool::gasReport = &gasReport;
+
+	TestStats global_stats{0, 0};
+	cout << "Running tests..." << endl << endl;
+
+	// Actually run the tests.
+	for (size_t task = 0; task < tasks.size();)
+	{
+		auto const& ts = g_interactiveTestsuites[tasks[task].suite];
+		vector<fs::path> tests;
+		size_t firstTask = task;
+		for (; task < tasks.size() && tasks[task].suite == tasks[firstTask].suite; ++task)
+			tests.emplace_back(tasks[task].name);
+
+		global_stats += runTestSuite(
 			ts.testCaseCreator,
 			options,
 			options.testPath / ts.path,
-			ts.subpath,
+			tests,
+			pool.get(),
+			firstTask,
 			ts.title
 		);
-		if (stats)
-			global_stats += *stats;
-		else
-			return 1;
 	}
 
 	cout << endl << "Summary: ";
@@ -480,5 +875,22 @@ int main(int argc, char const *argv[])
 	if (disableSemantics)
 		cout << "\nNOTE: Skipped semantics tests because no evmc vm could be found.\n" << endl;
 
+	Json::Value report = gasReport.toJson(options);
+	if (!options.gasBaseline.empty())
+	{
+		cout << endl << "Gas differences to " << options.gasBaseline << ":" << endl;
+		report["differences"] = gasReport.compare(gasBaseline, cout, !options.noColor);
+	}
+	if (!options.gasReport.empty())
+	{
+		ofstream reportFile(options.gasReport);
+		reportFile << jsonPrettyPrint(report) << endl;
+		if (!reportFile)
+		{
+			cerr << "Could not write the gas report to " << options.gasReport << endl;
+			return 1;
+		}
+	}
+
 	return global_stats ? 0 : 1;
 }
@@ -16,6 +16,8 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 
+#include <test/tools/fuzzer_common.h>
+
 #include <libyul/AssemblyStack.h>
 #include <liblangutil/EVMVersion.h>
 #include <libyul/backends/evm/EVMCodeTransform.h>
@@ -32,7 +34,7 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	if (_size > 600)
 		return 0;
 
-	YulStringRepository::reset();
+	YulStringRepository::resetIfLargerThan(FuzzerUtil::maxYulStrings);
 
 	string input(reinterpret_cast<char const*>(_data), _size);
 	AssemblyStack stack(
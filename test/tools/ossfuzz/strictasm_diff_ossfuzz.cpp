@@ -30,6 +30,7 @@
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/CommonData.h>
 
+#include <test/tools/fuzzer_common.h>
 #include <test/tools/ossfuzz/yulFuzzerCommon.h>
 
 #include <string>
@@ -58,7 +59,7 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	}))
 		return 0;
 
-	YulStringRepository::reset();
+	YulStringRepository::resetIfLargerThan(FuzzerUtil::maxYulStrings);
 
 	AssemblyStack stack(
 		langutil::EVMVersion(),
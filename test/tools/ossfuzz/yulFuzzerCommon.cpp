@@ -28,7 +28,8 @@ yulFuzzerUtil::TerminationReason yulFuzzerUtil::interpret(
 	Dialect const& _dialect,
 	size_t _maxSteps,
 	size_t _maxTraceSize,
-	size_t _maxExprNesting
+	size_t _maxExprNesting,
+	size_t* _estimatedGas
 )
 {
 	InterpreterState state;
@@ -70,6 +71,8 @@ yulFuzzerUtil::TerminationReason yulFuzzerUtil::interpret(
 		reason = TerminationReason::ExplicitlyTerminated;
 	}
 
+	if (_estimatedGas)
+		*_estimatedGas = state.estimatedGas;
 	state.dumpTraceAndState(_os);
 	return reason;
 }
@@ -32,13 +32,16 @@ struct yulFuzzerUtil
 		None
 	};
 
+	/// Interprets @a _ast and writes its trace and final state to @a _os.
+	/// If @a _estimatedGas is not null, the estimated gas of the execution is stored there.
 	static TerminationReason interpret(
 		std::ostream& _os,
 		std::shared_ptr<yul::Block> _ast,
 		Dialect const& _dialect,
 		size_t _maxSteps = maxSteps,
 		size_t _maxTraceSize = maxTraceSize,
-		size_t _maxExprNesting = maxExprNesting
+		size_t _maxExprNesting = maxExprNesting,
+		size_t* _estimatedGas = nullptr
 	);
 	static size_t constexpr maxSteps = 100;
 	static size_t constexpr maxTraceSize = 75;
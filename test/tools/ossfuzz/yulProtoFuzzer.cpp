@@ -58,7 +58,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	if (yul_source.size() > 1200)
 		return;
 
-	YulStringRepository::reset();
+	YulStringRepository::resetIfLargerThan(FuzzerUtil::maxYulStrings);
 
 	// AssemblyStack entry point
 	AssemblyStack stack(
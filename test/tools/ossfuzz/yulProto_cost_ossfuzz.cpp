@@ -0,0 +1,181 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/**
+ * Fuzzer that checks that the default optimiser sequence does not make Yul code more
+ * expensive to execute and that the optimiser run time does not grow super-linearly
+ * with the size of the input.
+ */
+
+#include <fstream>
+
+#include <test/tools/ossfuzz/yulProto.pb.h>
+#include <test/tools/fuzzer_common.h>
+#include <test/tools/ossfuzz/protoToYul.h>
+
+#include <src/libfuzzer/libfuzzer_macro.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/Exceptions.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <test/tools/ossfuzz/yulFuzzerCommon.h>
+
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+using namespace solidity::yul::test::yul_fuzzer;
+
+namespace
+{
+
+/// Estimated gas the optimised code may use on top of the gas used by the unoptimised code.
+/// Some steps, like the rematerialiser, trade a few more executed instructions for fewer
+/// stack slots, so small increases are expected.
+size_t constexpr gasTolerance = 30;
+/// Number of copies of the input that are optimised together to measure how the
+/// optimiser run time grows with the size of the input.
+size_t constexpr scalingFactor = 8;
+/// Largest accepted exponent k in "time = c * size^k" for the optimiser run time.
+double constexpr maxGrowthExponent = 1.6;
+/// Optimiser run time of the scaled input below which the growth is not checked,
+/// because measurements that short are dominated by noise.
+chrono::milliseconds constexpr minScaledTime{10};
+
+/// @returns the assembly stack for @a _source or nullptr if it is not valid Yul.
+unique_ptr<AssemblyStack> parse(string const& _source, EVMVersion _version)
+{
+	auto stack = make_unique<AssemblyStack>(
+		_version,
+		AssemblyStack::Language::StrictAssembly,
+		solidity::frontend::OptimiserSettings::full()
+	);
+	if (
+		!stack->parseAndAnalyze("source", _source) ||
+		!stack->parserResult()->code ||
+		!stack->parserResult()->analysisInfo ||
+		!Error::containsOnlyWarnings(stack->errors())
+	)
+		return nullptr;
+	return stack;
+}
+
+/// @returns the time it takes to optimise the code in @a _stack.
+chrono::steady_clock::duration timeOptimisation(AssemblyStack& _stack)
+{
+	auto start = chrono::steady_clock::now();
+	_stack.optimize();
+	return chrono::steady_clock::now() - start;
+}
+
+bool interruptedByLimit(yulFuzzerUtil::TerminationReason _reason)
+{
+	return
+		_reason == yulFuzzerUtil::TerminationReason::StepLimitReached ||
+		_reason == yulFuzzerUtil::TerminationReason::TraceLimitReached ||
+		_reason == yulFuzzerUtil::TerminationReason::ExpresionNestingLimitReached;
+}
+
+}
+
+DEFINE_PROTO_FUZZER(Program const& _input)
+{
+	ProtoConverter converter;
+	string yul_source = converter.programToString(_input);
+	EVMVersion version = converter.version();
+
+	if (const char* dump_path = getenv("PROTO_FUZZER_DUMP_PATH"))
+	{
+		// With libFuzzer binary run this to generate a YUL source file x.yul:
+		// PROTO_FUZZER_DUMP_PATH=x.yul ./a.out proto-input
+		ofstream of(dump_path);
+		of.write(yul_source.data(), static_cast<streamsize>(yul_source.size()));
+	}
+
+	YulStringRepository::resetIfLargerThan(FuzzerUtil::maxYulStrings);
+
+	unique_ptr<AssemblyStack> stack = parse(yul_source, version);
+	yulAssert(stack, "Proto fuzzer generated malformed program");
+
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(version);
+	ostringstream os1;
+	ostringstream os2;
+	size_t unoptimisedGas = 0;
+	size_t optimisedGas = 0;
+	yulFuzzerUtil::TerminationReason termReason = yulFuzzerUtil::interpret(
+		os1,
+		stack->parserResult()->code,
+		dialect,
+		yulFuzzerUtil::maxSteps,
+		yulFuzzerUtil::maxTraceSize,
+		yulFuzzerUtil::maxExprNesting,
+		&unoptimisedGas
+	);
+	if (interruptedByLimit(termReason))
+		return;
+
+	chrono::steady_clock::duration time = timeOptimisation(*stack);
+	// The optimised code may need more interpreter steps, but not more gas.
+	termReason = yulFuzzerUtil::interpret(
+		os2,
+		stack->parserResult()->code,
+		dialect,
+		yulFuzzerUtil::maxSteps * 4,
+		yulFuzzerUtil::maxTraceSize,
+		yulFuzzerUtil::maxExprNesting,
+		&optimisedGas
+	);
+	if (interruptedByLimit(termReason))
+		return;
+	// Only compare the costs of equivalent executions, yulProto_diff_ossfuzz checks equivalence.
+	if (os1.str() != os2.str())
+		return;
+	yulAssert(
+		optimisedGas <= unoptimisedGas + gasTolerance,
+		"Optimised code uses more gas than unoptimised code: " +
+		to_string(optimisedGas) + " vs. " + to_string(unoptimisedGas) + "."
+	);
+
+	// Objects cannot be concatenated, so the growth of the run time is only checked for blocks.
+	if (yul_source.empty() || yul_source.front() != '{')
+		return;
+	string scaledSource = "{\n";
+	for (size_t i = 0; i < scalingFactor; ++i)
+		scaledSource += yul_source;
+	scaledSource += "}\n";
+	unique_ptr<AssemblyStack> scaledStack = parse(scaledSource, version);
+	yulAssert(scaledStack, "Scaled program is malformed");
+	chrono::steady_clock::duration scaledTime = timeOptimisation(*scaledStack);
+	if (scaledTime < minScaledTime)
+		return;
+	double maxScaledTime = static_cast<double>(time.count()) * pow(static_cast<double>(scalingFactor), maxGrowthExponent);
+	yulAssert(
+		static_cast<double>(scaledTime.count()) <= maxScaledTime,
+		"Optimiser run time grows super-linearly with the size of the input: " +
+		to_string(chrono::duration_cast<chrono::microseconds>(time).count()) + "us for one copy, " +
+		to_string(chrono::duration_cast<chrono::microseconds>(scaledTime).count()) + "us for " +
+		to_string(scalingFactor) + " copies."
+	);
+}
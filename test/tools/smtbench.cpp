@@ -0,0 +1,430 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * SMTChecker performance benchmark: Runs the model checker on a corpus of SMTChecker tests
+ * with each engine and solver, reports the time spent encoding the contracts and querying the
+ * solvers and the size of the queries and compares the results to a stored baseline.
+ */
+
+#include <test/TestCaseReader.h>
+
+#include <libsolidity/formal/ModelChecker.h>
+#include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/ModelCheckerStatistics.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+using namespace solidity::frontend::test;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct Configuration
+{
+	string name;
+	ModelCheckerEngine engine;
+	smtutil::SMTSolverChoice solvers;
+};
+
+/// CHC is only implemented for Z3, so there is no configuration running it with CVC4.
+vector<Configuration> const configurations{
+	{"bmc-z3", ModelCheckerEngine::BMC(), smtutil::SMTSolverChoice::Z3()},
+	{"bmc-cvc4", ModelCheckerEngine::BMC(), smtutil::SMTSolverChoice::CVC4()},
+	{"chc-z3", ModelCheckerEngine::CHC(), smtutil::SMTSolverChoice::Z3()}
+};
+
+/// Tests in test/libsolidity/smtCheckerTests that are run if no tests are given.
+/// They are chosen to cover the main features of the encoding with contracts of moderate size
+/// whose queries are answered within a few seconds.
+vector<string> const defaultCorpus{
+	"abi/abi_decode_array.sol",
+	"complex/MerkleProof.sol",
+	"crypto/crypto_functions_same_input_over_state_same_output_fail.sol",
+	"external_calls/external_reentrancy_3.sol",
+	"functions/recursive_multi_return_2.sol",
+	"inheritance/functions_3.sol",
+	"invariants/aon_blog_post.sol",
+	"invariants/state_machine_1.sol",
+	"loops/while_nested_break_fail.sol",
+	"operators/delete_multid_array.sol",
+	"special/range_check.sol",
+	"try_catch/try_multiple_returned_values.sol",
+	"typecast/same_size.sol",
+	"types/type_minmax.sol"
+};
+
+/// Differences of time measurements below this threshold are not considered regressions.
+double constexpr minimumTimeDifferenceMs = 1.0;
+
+double milliseconds(ModelCheckerStatistics::Clock::duration _duration)
+{
+	return chrono::duration<double, milli>(_duration).count();
+}
+
+/// Runs the model checker on the test at @a _path in the configuration @a _configuration.
+/// @returns the total time, the encoding and query times, the number and total size of the
+/// queries and the number of queries the solvers could not answer.
+Json::Value measure(fs::path const& _path, Configuration const& _configuration, optional<unsigned> _timeout)
+{
+	Json::Value result(Json::objectValue);
+	try
+	{
+		ModelCheckerSettings settings;
+		settings.engine = _configuration.engine;
+		settings.timeout = _timeout;
+		settings.showStats = true;
+
+		CompilerStack compiler;
+		compiler.setSources(TestCaseReader(_path.string()).sources().sources);
+		compiler.setModelCheckerSettings(settings);
+		compiler.setSMTSolverChoice(_configuration.solvers);
+		auto start = ModelCheckerStatistics::Clock::now();
+		bool success = compiler.parseAndAnalyze();
+		double total = milliseconds(ModelCheckerStatistics::Clock::now() - start);
+		if (!success)
+		{
+			result["status"] = "error";
+			for (auto const& error: compiler.errors())
+				if (error->type() != Error::Type::Warning)
+				{
+					result["message"] = error->typeName() + ": " + (error->comment() ? *error->comment() : "");
+					break;
+				}
+			return result;
+		}
+
+		ModelCheckerStatistics const& statistics = compiler.modelCheckerStatistics();
+		double encoding = 0;
+		double querying = 0;
+		for (auto const& contract: statistics.contracts())
+		{
+			encoding += milliseconds(contract.encodingDuration);
+			querying += milliseconds(contract.queryDuration);
+		}
+		size_t size = 0;
+		size_t unknown = 0;
+		for (auto const& query: statistics.queries())
+		{
+			size += query.size;
+			if (query.result != smtutil::CheckResult::SATISFIABLE && query.result != smtutil::CheckResult::UNSATISFIABLE)
+				++unknown;
+		}
+
+		result["status"] = "ok";
+		result["wallTimeMs"]["total"] = total;
+		result["wallTimeMs"]["encoding"] = encoding;
+		result["wallTimeMs"]["queries"] = querying;
+		result["queries"] = Json::UInt64(statistics.queries().size());
+		result["querySize"] = Json::UInt64(size);
+		result["unknown"] = Json::UInt64(unknown);
+	}
+	catch (Exception const& _exception)
+	{
+		result["status"] = "error";
+		string message = _exception.what();
+		result["message"] = message.empty() ? "Exception in " + _exception.lineInfo() : message;
+	}
+	return result;
+}
+
+/// Combines the results of several runs, keeping the minimum of every time measurement.
+/// The other measurements do not depend on the run.
+Json::Value combineRuns(vector<Json::Value> const& _runs)
+{
+	Json::Value result = _runs.front();
+	for (auto const& run: _runs)
+	{
+		if (run["status"] != "ok")
+			return run;
+		for (auto const& phase: run["wallTimeMs"].getMemberNames())
+			result["wallTimeMs"][phase] = min(result["wallTimeMs"][phase].asDouble(), run["wallTimeMs"][phase].asDouble());
+	}
+	return result;
+}
+
+/// Compares the measurements @a _results to @a _baseline.
+/// @returns a list of regressions, each an object with the keys "test", "configuration",
+/// "metric", "baseline" and "current".
+Json::Value compare(Json::Value const& _results, Json::Value const& _baseline, double _tolerance)
+{
+	Json::Value regressions(Json::arrayValue);
+	auto check = [&](
+		string const& _test,
+		string const& _configuration,
+		string const& _metric,
+		double _base,
+		double _current,
+		double _minimumDifference,
+		double _allowedIncrease
+	)
+	{
+		if (_current > _base * (1 + _allowedIncrease) && _current - _base >= _minimumDifference)
+		{
+			Json::Value regression(Json::objectValue);
+			regression["test"] = _test;
+			regression["configuration"] = _configuration;
+			regression["metric"] = _metric;
+			regression["baseline"] = _base;
+			regression["current"] = _current;
+			regressions.append(regression);
+		}
+	};
+
+	for (auto const& test: _results.getMemberNames())
+		for (auto const& configuration: _results[test].getMemberNames())
+		{
+			Json::Value const& current = _results[test][configuration];
+			Json::Value const& base = _baseline["results"][test][configuration];
+			if (!base.isObject() || base["status"] != "ok" || current["status"] == "skipped")
+				continue;
+			if (current["status"] != "ok")
+			{
+				check(test, configuration, "status", 0, 1, 0, 0);
+				continue;
+			}
+			for (auto const& phase: current["wallTimeMs"].getMemberNames())
+				if (base["wallTimeMs"].isMember(phase))
+					check(
+						test,
+						configuration,
+						"wallTimeMs." + phase,
+						base["wallTimeMs"][phase].asDouble(),
+						current["wallTimeMs"][phase].asDouble(),
+						minimumTimeDifferenceMs,
+						_tolerance
+					);
+			// The queries only depend on the encoding, so every increase is reported.
+			// The number of unanswered queries depends on the timeout, which is expected to be
+			// the same as for the baseline.
+			for (auto const& metric: {"queries", "querySize", "unknown"})
+				check(test, configuration, metric, base[metric].asDouble(), current[metric].asDouble(), 1, 0);
+		}
+	return regressions;
+}
+
+void printResult(string const& _test, string const& _configuration, Json::Value const& _result)
+{
+	cout << left << setw(60) << _test << setw(10) << _configuration << right;
+	if (_result["status"] != "ok")
+	{
+		cout << "  " << _result["status"].asString() << ": " << _result["message"].asString() << endl;
+		return;
+	}
+	cout << fixed << setprecision(1);
+	for (auto const& phase: {"total", "encoding", "queries"})
+		cout << setw(12) << _result["wallTimeMs"][phase].asDouble();
+	for (auto const& metric: {"queries", "querySize", "unknown"})
+		cout << setw(10) << _result[metric].asUInt64();
+	cout << endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(smtbench, SMTChecker performance benchmark.
+Usage: smtbench [Options] [<test>...]
+Runs the SMTChecker on every test, which is a file in the format of the tests in
+test/libsolidity/smtCheckerTests, in the configurations bmc-z3, bmc-cvc4 and
+chc-z3. It reports the total wall time in milliseconds, the time spent encoding
+the contracts and the time spent in solver queries, as well as the number of
+queries, the total size of the queries and the number of queries the solvers
+could not answer. Without tests, a curated subset of the tests in
+test/libsolidity/smtCheckerTests is run.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("config", po::value<vector<string>>()->multitoken(), "Only run the given configurations.")
+		("repeat", po::value<size_t>()->default_value(3), "Run every test this many times and report the minimum of each time measurement.")
+		("timeout", po::value<unsigned>()->default_value(10000), "Timeout of every solver query in milliseconds, 0 meaning no timeout.")
+		("output", po::value<string>(), "Write the results as JSON to the given file, which can be used as a baseline.")
+		("baseline", po::value<string>(), "Compare the results to the JSON results of an earlier run and fail on regressions.")
+		("tolerance", po::value<double>()->default_value(20), "Allowed increase of every time measurement over the baseline in percent.")
+		("test", po::value<vector<string>>(), "test");
+	po::positional_options_description filesPositions;
+	filesPositions.add("test", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<Configuration> selectedConfigurations;
+	if (arguments.count("config"))
+		for (string const& name: arguments["config"].as<vector<string>>())
+		{
+			auto configuration = find_if(configurations.begin(), configurations.end(), [&](auto const& _c) { return _c.name == name; });
+			if (configuration == configurations.end())
+			{
+				cerr << "Unknown configuration: " << name << endl;
+				return 1;
+			}
+			selectedConfigurations.push_back(*configuration);
+		}
+	else
+		selectedConfigurations = configurations;
+
+	fs::path const testDirectory = "test/libsolidity/smtCheckerTests";
+	vector<pair<string, fs::path>> tests;
+	if (arguments.count("test"))
+		for (string const& test: arguments["test"].as<vector<string>>())
+			tests.emplace_back(test, test);
+	else if (fs::is_directory(testDirectory))
+		for (string const& test: defaultCorpus)
+			tests.emplace_back(test, testDirectory / test);
+	else
+	{
+		cerr << "No tests given and " << testDirectory.string() << " not found." << endl;
+		return 1;
+	}
+	for (auto const& [name, path]: tests)
+		if (!fs::is_regular_file(path))
+		{
+			cerr << "Test not found: " << path.string() << endl;
+			return 1;
+		}
+
+	Json::Value baseline;
+	if (arguments.count("baseline"))
+		try
+		{
+			if (!jsonParseStrict(readFileAsString(arguments["baseline"].as<string>()), baseline) || !baseline.isObject())
+			{
+				cerr << "Invalid baseline: " << arguments["baseline"].as<string>() << endl;
+				return 1;
+			}
+		}
+		catch (FileNotFound const&)
+		{
+			cerr << "Baseline not found: " << arguments["baseline"].as<string>() << endl;
+			return 1;
+		}
+
+	size_t repetitions = max<size_t>(arguments["repeat"].as<size_t>(), 1);
+	optional<unsigned> timeout;
+	if (arguments["timeout"].as<unsigned>() > 0)
+		timeout = arguments["timeout"].as<unsigned>();
+	smtutil::SMTSolverChoice const availableSolvers = ModelChecker::availableSolvers();
+
+	Json::Value output(Json::objectValue);
+	output["version"] = frontend::VersionString;
+	output["repetitions"] = Json::UInt64(repetitions);
+	output["timeout"] = arguments["timeout"].as<unsigned>();
+	Json::Value& results = output["results"] = Json::objectValue;
+
+	cout << left << setw(60) << "Test" << setw(10) << "Config" << right;
+	for (auto const& column: {"Total", "Encoding", "Queries"})
+		cout << setw(12) << column;
+	for (auto const& column: {"Queries", "Size", "Unknown"})
+		cout << setw(10) << column;
+	cout << endl;
+
+	for (auto const& [name, path]: tests)
+		for (Configuration const& configuration: selectedConfigurations)
+		{
+			Json::Value& result = results[name][configuration.name];
+			if ((configuration.solvers.z3 && !availableSolvers.z3) || (configuration.solvers.cvc4 && !availableSolvers.cvc4))
+			{
+				result["status"] = "skipped";
+				result["message"] = "Solver not available.";
+			}
+			else
+			{
+				vector<Json::Value> runs;
+				for (size_t i = 0; i < repetitions; ++i)
+					runs.emplace_back(measure(path, configuration, timeout));
+				result = combineRuns(runs);
+			}
+			printResult(name, configuration.name, result);
+		}
+
+	bool success = true;
+	if (arguments.count("baseline"))
+	{
+		if (baseline["timeout"] != output["timeout"])
+			cout << endl << "Warning: The baseline was recorded with a different timeout." << endl;
+		Json::Value regressions = compare(results, baseline, arguments["tolerance"].as<double>() / 100);
+		output["regressions"] = regressions;
+		cout << endl << "Compared to baseline " << baseline["version"].asString() << ": ";
+		if (regressions.empty())
+			cout << "no regressions." << endl;
+		else
+		{
+			success = false;
+			cout << regressions.size() << " regression(s)" << endl;
+			for (auto const& regression: regressions)
+				cout << "  " << regression["test"].asString() << " " << regression["configuration"].asString() <<
+					" " << regression["metric"].asString() << ": " << regression["baseline"].asDouble() <<
+					" -> " << regression["current"].asDouble() << endl;
+		}
+	}
+
+	if (arguments.count("output"))
+	{
+		ofstream outputFile(arguments["output"].as<string>());
+		outputFile << jsonPrettyPrint(output) << endl;
+		if (!outputFile)
+		{
+			cerr << "Could not write " << arguments["output"].as<string>() << endl;
+			return 1;
+		}
+	}
+
+	return success ? 0 : 2;
+}
@@ -0,0 +1,578 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compiler performance benchmark: Compiles a corpus of projects in several
+ * configurations, reports the time spent in the compiler phases, the peak memory
+ * usage and the size of the generated code and compares the results to a stored baseline.
+ * Alternatively measures the time a compiler executable needs for trivial inputs.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/process.hpp>
+#include <boost/program_options.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+namespace bp = boost::process;
+
+namespace
+{
+
+struct Configuration
+{
+	string name;
+	bool viaIR;
+	bool optimize;
+};
+
+vector<Configuration> const configurations{
+	{"legacy", false, false},
+	{"legacy-optimize", false, true},
+	{"via-ir", true, false},
+	{"via-ir-optimize", true, true}
+};
+
+/// Compiler phases reported by the benchmark, each given by the profiler scope measuring it.
+/// The time of a phase excludes the time of the phases nested in it, so that all
+/// phases add up to the total time.
+vector<pair<string, string>> const phases{
+	{"parse", "Parsing"},
+	{"analyze", "Analysis"},
+	{"codegen", "Code generation"},
+	{"yulOptimize", "Yul optimiser"},
+	{"evmasmOptimize", "EVM assembly optimiser"}
+};
+
+/// Differences of time measurements below this threshold are not considered regressions.
+double constexpr minimumTimeDifferenceMs = 1.0;
+
+/// Trivial inputs for measuring the fixed costs of a compiler invocation, given by a name and
+/// the arguments of the invocation. "<dir>" is replaced by the directory containing the input files.
+vector<pair<string, vector<string>>> const startupScenarios{
+	{"version", {"--version"}},
+	{"bin", {"--bin", "<dir>/Trivial.sol"}},
+	{"bin-optimize", {"--bin", "--optimize", "<dir>/Trivial.sol"}},
+	{"standard-json", {"--standard-json", "<dir>/input.json"}}
+};
+
+string const trivialContract = R"(// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+contract C {
+	function f() public pure returns (uint) { return 1; }
+}
+)";
+
+/// @returns the sources of the project at @a _path, which is either a single file or a
+/// directory, keyed by their path relative to the project.
+StringMap projectSources(fs::path const& _path)
+{
+	StringMap sources;
+	if (fs::is_directory(_path))
+	{
+		for (fs::recursive_directory_iterator it(_path), end; it != end; ++it)
+			if (fs::is_regular_file(it->path()) && it->path().extension() == ".sol")
+				sources[it->path().lexically_relative(_path).generic_string()] = readFileAsString(it->path().string());
+	}
+	else
+		sources[_path.filename().generic_string()] = readFileAsString(_path.string());
+	return sources;
+}
+
+/// @returns the total time spent in the phase @a _name in the profiler tree @a _nodes,
+/// not counting invocations nested in another invocation of the same phase.
+double phaseTime(Json::Value const& _nodes, string const& _name)
+{
+	double time = 0;
+	for (auto const& node: _nodes)
+		if (node["name"].asString() == _name)
+			time += node["wallTimeMs"].asDouble();
+		else if (node.isMember("children"))
+			time += phaseTime(node["children"], _name);
+	return time;
+}
+
+/// Compiles the project at @a _path in the configuration @a _configuration in this process.
+/// @returns the phase timings, the peak memory usage of the process and the total size of the
+/// deployed code of all contracts.
+Json::Value measure(fs::path const& _path, Configuration const& _configuration)
+{
+	Json::Value result(Json::objectValue);
+	Profiler::instance().reset();
+	Profiler::instance().setEnabled(true);
+	try
+	{
+		CompilerStack compiler;
+		compiler.setSources(projectSources(_path));
+		compiler.setViaIR(_configuration.viaIR);
+		compiler.setOptimiserSettings(_configuration.optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal());
+		auto start = Profiler::Clock::now();
+		bool success = compiler.compile();
+		double total = chrono::duration<double, milli>(Profiler::Clock::now() - start).count();
+		if (!success)
+		{
+			result["status"] = "error";
+			for (auto const& error: compiler.errors())
+				if (error->type() != Error::Type::Warning)
+				{
+					result["message"] = error->typeName() + ": " + (error->comment() ? *error->comment() : "");
+					break;
+				}
+			return result;
+		}
+
+		Json::Value profile = Profiler::instance().toJson();
+		Json::Value times(Json::objectValue);
+		double nested = 0;
+		for (auto const& [phase, scope]: phases)
+		{
+			times[phase] = phaseTime(profile, scope);
+			if (phase == "yulOptimize" || phase == "evmasmOptimize")
+				nested += times[phase].asDouble();
+		}
+		times["codegen"] = max(0.0, times["codegen"].asDouble() - nested);
+		times["total"] = total;
+		result["status"] = "ok";
+		result["wallTimeMs"] = times;
+		result["peakMemoryKiB"] = Json::UInt64(Profiler::peakMemoryKiB());
+
+		size_t bytecodeSize = 0;
+		for (string const& contract: compiler.contractNames())
+			bytecodeSize += compiler.runtimeObject(contract).bytecode.size();
+		result["bytecodeSize"] = Json::UInt64(bytecodeSize);
+	}
+	catch (Exception const& _exception)
+	{
+		result["status"] = "error";
+		string message = _exception.what();
+		result["message"] = message.empty() ? "Exception in " + _exception.lineInfo() : message;
+	}
+	return result;
+}
+
+/// Runs @a _executable in measurement mode for the given project and configuration in
+/// a separate process, so that the peak memory usage is not influenced by earlier runs.
+Json::Value measureInChildProcess(string const& _executable, fs::path const& _path, Configuration const& _configuration)
+{
+	bp::ipstream output;
+	bp::child child(
+		_executable,
+		vector<string>{"--measure", _configuration.name, _path.string()},
+		bp::std_out > output,
+		bp::std_err > bp::null
+	);
+	string json{istreambuf_iterator<char>(output), istreambuf_iterator<char>()};
+	child.wait();
+
+	Json::Value result;
+	if (child.exit_code() != 0 || !jsonParseStrict(json, result) || !result.isObject())
+	{
+		result = Json::objectValue;
+		result["status"] = "error";
+		result["message"] = "Compiler process failed with exit code " + to_string(child.exit_code()) + ".";
+	}
+	return result;
+}
+
+/// Runs the compiler executable @a _solc on each startup scenario @a _repetitions times.
+/// @returns the minimum wall time of each scenario in the same format as the results of
+/// the compilation of a project.
+Json::Value measureStartup(string const& _solc, size_t _repetitions)
+{
+	fs::path const directory = fs::temp_directory_path() / fs::unique_path("solbench-%%%%-%%%%");
+	fs::create_directories(directory);
+	ofstream((directory / "Trivial.sol").string()) << trivialContract;
+	Json::Value input(Json::objectValue);
+	input["language"] = "Solidity";
+	input["sources"]["Trivial.sol"]["content"] = trivialContract;
+	input["settings"]["outputSelection"]["*"]["*"][0] = "evm.bytecode.object";
+	ofstream((directory / "input.json").string()) << jsonCompactPrint(input);
+
+	Json::Value results(Json::objectValue);
+	for (auto const& [name, scenarioArguments]: startupScenarios)
+	{
+		vector<string> arguments = scenarioArguments;
+		for (string& argument: arguments)
+			if (argument.rfind("<dir>", 0) == 0)
+				argument = directory.string() + argument.substr(5);
+
+		Json::Value& result = results[name] = Json::objectValue;
+		result["status"] = "ok";
+		double best = numeric_limits<double>::max();
+		for (size_t i = 0; i < _repetitions; ++i)
+		{
+			auto start = Profiler::Clock::now();
+			bp::child child(_solc, arguments, bp::std_out > bp::null, bp::std_err > bp::null);
+			child.wait();
+			if (child.exit_code() != 0)
+			{
+				result["status"] = "error";
+				result["message"] = "Compiler process failed with exit code " + to_string(child.exit_code()) + ".";
+				break;
+			}
+			best = min(best, chrono::duration<double, milli>(Profiler::Clock::now() - start).count());
+		}
+		if (result["status"] == "ok")
+			result["wallTimeMs"]["total"] = best;
+	}
+	fs::remove_all(directory);
+	return results;
+}
+
+/// Combines the results of several runs, keeping the minimum of every measurement.
+Json::Value combineRuns(vector<Json::Value> const& _runs)
+{
+	Json::Value result = _runs.front();
+	for (auto const& run: _runs)
+	{
+		if (run["status"] != "ok")
+			return run;
+		for (auto const& phase: run["wallTimeMs"].getMemberNames())
+			result["wallTimeMs"][phase] = min(result["wallTimeMs"][phase].asDouble(), run["wallTimeMs"][phase].asDouble());
+		result["peakMemoryKiB"] = min(result["peakMemoryKiB"].asUInt64(), run["peakMemoryKiB"].asUInt64());
+	}
+	return result;
+}
+
+/// Compares the measurements @a _results to @a _baseline.
+/// @returns a list of regressions, each an object with the keys "project", "configuration",
+/// "metric", "baseline" and "current".
+Json::Value compare(Json::Value const& _results, Json::Value const& _baseline, double _tolerance)
+{
+	Json::Value regressions(Json::arrayValue);
+	auto check = [&](
+		string const& _project,
+		string const& _configuration,
+		string const& _metric,
+		double _base,
+		double _current,
+		double _minimumDifference,
+		double _allowedIncrease
+	)
+	{
+		if (_current > _base * (1 + _allowedIncrease) && _current - _base >= _minimumDifference)
+		{
+			Json::Value regression(Json::objectValue);
+			regression["project"] = _project;
+			regression["configuration"] = _configuration;
+			regression["metric"] = _metric;
+			regression["baseline"] = _base;
+			regression["current"] = _current;
+			regressions.append(regression);
+		}
+	};
+
+	for (auto const& project: _results.getMemberNames())
+		for (auto const& configuration: _results[project].getMemberNames())
+		{
+			Json::Value const& current = _results[project][configuration];
+			Json::Value const& base = _baseline["results"][project][configuration];
+			if (!base.isObject() || base["status"] != "ok")
+				continue;
+			if (current["status"] != "ok")
+			{
+				check(project, configuration, "status", 0, 1, 0, 0);
+				continue;
+			}
+			for (auto const& phase: current["wallTimeMs"].getMemberNames())
+				if (base["wallTimeMs"].isMember(phase))
+					check(
+						project,
+						configuration,
+						"wallTimeMs." + phase,
+						base["wallTimeMs"][phase].asDouble(),
+						current["wallTimeMs"][phase].asDouble(),
+						minimumTimeDifferenceMs,
+						_tolerance
+					);
+			check(
+				project,
+				configuration,
+				"peakMemoryKiB",
+				base["peakMemoryKiB"].asDouble(),
+				current["peakMemoryKiB"].asDouble(),
+				0,
+				_tolerance
+			);
+			// The code size is deterministic, so every increase is reported.
+			if (base.isMember("bytecodeSize"))
+				check(
+					project,
+					configuration,
+					"bytecodeSize",
+					base["bytecodeSize"].asDouble(),
+					current["bytecodeSize"].asDouble(),
+					1,
+					0
+				);
+		}
+	return regressions;
+}
+
+void printResult(string const& _project, string const& _configuration, Json::Value const& _result)
+{
+	cout << left << setw(24) << _project << setw(18) << _configuration << right;
+	if (_result["status"] != "ok")
+	{
+		cout << "  error: " << _result["message"].asString() << endl;
+		return;
+	}
+	cout << fixed << setprecision(1);
+	for (auto const& phase: {"total", "parse", "analyze", "codegen", "yulOptimize", "evmasmOptimize"})
+		cout << setw(12) << _result["wallTimeMs"][phase].asDouble();
+	cout << setw(12) << _result["peakMemoryKiB"].asUInt64() << setw(12) << _result["bytecodeSize"].asUInt64() << endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solbench, compiler performance benchmark.
+Usage: solbench [Options] [<project>...]
+       solbench [Options] --startup <solc>
+Compiles every project, which is either a Solidity file or a directory of
+Solidity files, in the configurations legacy, legacy-optimize, via-ir and
+via-ir-optimize. Every compilation runs in a separate process and reports the
+wall time in milliseconds of parsing, analysis, code generation, the Yul
+optimiser and the EVM assembly optimiser, the peak memory usage in KiB and the
+total size of the deployed code of all contracts. Without projects, all
+projects in test/compilationTests are compiled.
+With --startup, the given compiler executable is instead run on trivial inputs
+and the wall time in milliseconds until it exits is reported.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("config", po::value<vector<string>>()->multitoken(), "Only run the given configurations.")
+		("repeat", po::value<size_t>()->default_value(3), "Compile every project this many times and report the minimum of each measurement.")
+		("output", po::value<string>(), "Write the results as JSON to the given file, which can be used as a baseline.")
+		("baseline", po::value<string>(), "Compare the results to the JSON results of an earlier run and fail on regressions.")
+		("tolerance", po::value<double>()->default_value(10), "Allowed increase of every measurement over the baseline in percent.")
+		("startup", po::value<string>(), "Measure the time the given compiler executable needs for trivial inputs instead of compiling projects.")
+		("measure", po::value<string>(), "Internal: Compile the project in the given configuration in this process and print the result.")
+		("project", po::value<vector<string>>(), "project");
+	po::positional_options_description filesPositions;
+	filesPositions.add("project", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<Configuration> selectedConfigurations;
+	if (arguments.count("config"))
+		for (string const& name: arguments["config"].as<vector<string>>())
+		{
+			auto configuration = find_if(configurations.begin(), configurations.end(), [&](auto const& _c) { return _c.name == name; });
+			if (configuration == configurations.end())
+			{
+				cerr << "Unknown configuration: " << name << endl;
+				return 1;
+			}
+			selectedConfigurations.push_back(*configuration);
+		}
+	else
+		selectedConfigurations = configurations;
+
+	bool const startup = arguments.count("startup");
+	if (startup && (arguments.count("project") || arguments.count("measure") || arguments.count("config")))
+	{
+		cerr << "--startup cannot be combined with projects, --config or --measure." << endl;
+		return 1;
+	}
+	if (startup && !fs::exists(arguments["startup"].as<string>()))
+	{
+		cerr << "Compiler executable not found: " << arguments["startup"].as<string>() << endl;
+		return 1;
+	}
+
+	vector<fs::path> projects;
+	if (arguments.count("project"))
+		for (string const& project: arguments["project"].as<vector<string>>())
+			projects.emplace_back(project);
+	else if (!startup && fs::is_directory("test/compilationTests"))
+	{
+		for (fs::directory_iterator it("test/compilationTests"), end; it != end; ++it)
+			if (fs::is_directory(it->path()))
+				projects.push_back(it->path());
+		sort(projects.begin(), projects.end());
+	}
+	for (fs::path const& project: projects)
+		if (!fs::exists(project))
+		{
+			cerr << "Project not found: " << project.string() << endl;
+			return 1;
+		}
+	if (projects.empty() && !startup)
+	{
+		cerr << "No projects given and test/compilationTests not found." << endl;
+		return 1;
+	}
+
+	if (arguments.count("measure"))
+	{
+		if (selectedConfigurations.size() != configurations.size() || projects.size() != 1)
+		{
+			cerr << "--measure requires exactly one project." << endl;
+			return 1;
+		}
+		auto configuration = find_if(configurations.begin(), configurations.end(), [&](auto const& _c) {
+			return _c.name == arguments["measure"].as<string>();
+		});
+		if (configuration == configurations.end())
+		{
+			cerr << "Unknown configuration: " << arguments["measure"].as<string>() << endl;
+			return 1;
+		}
+		cout << jsonCompactPrint(measure(projects.front(), *configuration)) << endl;
+		return 0;
+	}
+
+	Json::Value baseline;
+	if (arguments.count("baseline"))
+		try
+		{
+			if (!jsonParseStrict(readFileAsString(arguments["baseline"].as<string>()), baseline) || !baseline.isObject())
+			{
+				cerr << "Invalid baseline: " << arguments["baseline"].as<string>() << endl;
+				return 1;
+			}
+		}
+		catch (FileNotFound const&)
+		{
+			cerr << "Baseline not found: " << arguments["baseline"].as<string>() << endl;
+			return 1;
+		}
+
+	string executable = argv[0];
+	if (!fs::path(executable).has_parent_path())
+		executable = bp::search_path(executable).string();
+	size_t repetitions = max<size_t>(arguments["repeat"].as<size_t>(), 1);
+
+	Json::Value output(Json::objectValue);
+	output["version"] = frontend::VersionString;
+	output["repetitions"] = Json::UInt64(repetitions);
+	Json::Value& results = output["results"] = Json::objectValue;
+
+	if (startup)
+	{
+		cout << left << setw(24) << "Startup" << right << setw(12) << "Total" << endl;
+		results["startup"] = measureStartup(arguments["startup"].as<string>(), repetitions);
+		for (auto const& scenario: startupScenarios)
+		{
+			Json::Value const& result = results["startup"][scenario.first];
+			cout << left << setw(24) << scenario.first << right;
+			if (result["status"] == "ok")
+				cout << fixed << setprecision(1) << setw(12) << result["wallTimeMs"]["total"].asDouble() << endl;
+			else
+				cout << "  error: " << result["message"].asString() << endl;
+		}
+	}
+	else
+	{
+		cout << left << setw(24) << "Project" << setw(18) << "Configuration" << right;
+		for (auto const& column: {"Total", "Parse", "Analyze", "Codegen", "Yul opt", "Evmasm opt", "Peak KiB", "Code bytes"})
+			cout << setw(12) << column;
+		cout << endl;
+	}
+
+	for (fs::path const& project: projects)
+	{
+		string name = project.filename().string();
+		for (Configuration const& configuration: selectedConfigurations)
+		{
+			vector<Json::Value> runs;
+			for (size_t i = 0; i < repetitions; ++i)
+				runs.emplace_back(measureInChildProcess(executable, project, configuration));
+			results[name][configuration.name] = combineRuns(runs);
+			printResult(name, configuration.name, results[name][configuration.name]);
+		}
+	}
+
+	bool success = true;
+	if (arguments.count("baseline"))
+	{
+		Json::Value regressions = compare(results, baseline, arguments["tolerance"].as<double>() / 100);
+		output["regressions"] = regressions;
+		cout << endl << "Compared to baseline " << baseline["version"].asString() << ": ";
+		if (regressions.empty())
+			cout << "no regressions." << endl;
+		else
+		{
+			success = false;
+			cout << regressions.size() << " regression(s)" << endl;
+			for (auto const& regression: regressions)
+				cout << "  " << regression["project"].asString() << " " << regression["configuration"].asString() <<
+					" " << regression["metric"].asString() << ": " << regression["baseline"].asDouble() <<
+					" -> " << regression["current"].asDouble() << endl;
+		}
+	}
+
+	if (arguments.count("output"))
+	{
+		ofstream outputFile(arguments["output"].as<string>());
+		outputFile << jsonPrettyPrint(output) << endl;
+		if (!outputFile)
+		{
+			cerr << "Could not write " << arguments["output"].as<string>() << endl;
+			return 1;
+		}
+	}
+
+	return success ? 0 : 2;
+}
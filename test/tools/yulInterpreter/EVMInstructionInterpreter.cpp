@@ -26,6 +26,7 @@
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AST.h>
 
+#include <libevmasm/GasMeter.h>
 #include <libevmasm/Instruction.h>
 
 #include <libsolutil/Keccak256.h>
@@ -41,6 +42,16 @@ using solidity::util::keccak256;
 namespace
 {
 
+/// @returns a rough estimate of the gas needed to execute @a _instruction.
+/// Instructions in the special tier depend on state the estimate does not model,
+/// like storage or memory size, and are counted with a fixed cost.
+size_t estimatedGas(evmasm::Instruction _instruction)
+{
+	if (evmasm::instructionInfo(_instruction).gasPriceTier == evmasm::Tier::Special)
+		return 100;
+	return evmasm::GasMeter::runGas(_instruction);
+}
+
 /// Reads 32 bytes from @a _data at position @a _offset bytes while
 /// interpreting @a _data to be padded with an infinite number of zero
 /// bytes beyond its end.
@@ -68,18 +79,24 @@ u256 readZeroExtended(bytes const& _data, u256 const& _offset)
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	Memory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
+	bytes data(_size, 0);
 	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+		if (_sourceOffset + i < _source.size())
+			data[i] = _source[_sourceOffset + i];
+	if (_targetOffset + _size >= _targetOffset)
+		_target.write(_targetOffset, &data);
+	else
+		// The target offset wraps around.
+		for (size_t i = 0; i < _size; ++i)
+			_target[_targetOffset + i] = data[i];
 }
 
 }
 
-using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
-
 u256 EVMInstructionInterpreter::eval(
 	evmasm::Instruction _instruction,
 	vector<u256> const& _arguments
@@ -90,6 +107,7 @@ u256 EVMInstructionInterpreter::eval(
 
 	auto info = instructionInfo(_instruction);
 	yulAssert(static_cast<size_t>(info.args) == _arguments.size(), "");
+	m_state.estimatedGas += estimatedGas(_instruction);
 
 	auto const& arg = _arguments;
 	switch (_instruction)
@@ -154,9 +172,9 @@ u256 EVMInstructionInterpreter::eval(
 		}
 	}
 	case Instruction::ADDMOD:
-		return arg[2] == 0 ? 0 : u256((u512(arg[0]) + u512(arg[1])) % arg[2]);
+		return addmod256(arg[0], arg[1], arg[2]);
 	case Instruction::MULMOD:
-		return arg[2] == 0 ? 0 : u256((u512(arg[0]) * u512(arg[1])) % arg[2]);
+		return mulmod256(arg[0], arg[1], arg[2]);
 	case Instruction::SIGNEXTEND:
 		if (arg[0] >= 31)
 			return arg[1];
@@ -346,6 +364,9 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::JUMP:
 	case Instruction::JUMPI:
 	case Instruction::JUMPDEST:
+	case Instruction::BEGINSUB:
+	case Instruction::RETURNSUB:
+	case Instruction::JUMPSUB:
 	case Instruction::PUSH1:
 	case Instruction::PUSH2:
 	case Instruction::PUSH3:
@@ -493,8 +514,7 @@ bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _si
 {
 	yulAssert(_size <= 0xffff, "Too large read.");
 	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
+	m_state.memory.read(_offset, data.data(), data.size());
 	return data;
 }
 
@@ -505,8 +525,8 @@ u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	h256 word(_value);
+	m_state.memory.write(_offset, word.ref());
 }
 
 
@@ -45,12 +45,20 @@ namespace
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	Memory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
+	bytes data(_size, 0);
 	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+		if (_sourceOffset + i < _source.size())
+			data[i] = _source[_sourceOffset + i];
+	if (_targetOffset + _size >= _targetOffset)
+		_target.write(_targetOffset, &data);
+	else
+		// The target offset wraps around.
+		for (size_t i = 0; i < _size; ++i)
+			_target[_targetOffset + i] = data[i];
 }
 
 /// Count leading zeros for uint64. Following WebAssembly rules, it returns 64 for @a _v being zero.
@@ -523,8 +531,11 @@ bytes EwasmBuiltinInterpreter::readMemory(uint64_t _offset, uint64_t _size)
 {
 	yulAssert(_size <= 0xffff, "Too large read.");
 	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
+	if (_offset + _size >= _offset)
+		m_state.memory.read(_offset, data.data(), data.size());
+	else
+		for (size_t i = 0; i < data.size(); ++i)
+			data[i] = m_state.memory[_offset + i];
 	return data;
 }
 
@@ -546,8 +557,11 @@ uint32_t EwasmBuiltinInterpreter::readMemoryHalfWord(uint64_t _offset)
 
 void EwasmBuiltinInterpreter::writeMemory(uint64_t _offset, bytes const& _value)
 {
-	for (size_t i = 0; i < _value.size(); i++)
-		m_state.memory[_offset + i] = _value[i];
+	if (_offset + _value.size() >= _offset)
+		m_state.memory.write(_offset, &_value);
+	else
+		for (size_t i = 0; i < _value.size(); i++)
+			m_state.memory[_offset + i] = _value[i];
 }
 
 void EwasmBuiltinInterpreter::writeMemoryWord(uint64_t _offset, uint64_t _value)
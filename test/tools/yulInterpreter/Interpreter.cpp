@@ -30,13 +30,15 @@
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/wasm/WasmDialect.h>
 
+#include <libevmasm/GasMeter.h>
+
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/Visitor.h>
 
-#include <boost/range/adaptor/reversed.hpp>
-#include <boost/algorithm/cxx11/all_of.hpp>
-
+#include <deque>
+#include <iomanip>
 #include <ostream>
 #include <variant>
 
@@ -45,310 +47,479 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::yul::test;
 
+using solidity::util::GenericVisitor;
 using solidity::util::h256;
 
+void Memory::read(u256 const& _offset, uint8_t* _target, size_t _size)
+{
+	u256 offset = _offset;
+	while (_size > 0)
+	{
+		size_t pageOffset = static_cast<size_t>(offset % pageSize);
+		size_t count = min(_size, pageSize - pageOffset);
+		Page const& source = page(offset);
+		copy(source.begin() + static_cast<ptrdiff_t>(pageOffset), source.begin() + static_cast<ptrdiff_t>(pageOffset + count), _target);
+		_target += count;
+		_size -= count;
+		offset += count;
+	}
+}
+
+void Memory::write(u256 const& _offset, bytesConstRef _data)
+{
+	u256 offset = _offset;
+	uint8_t const* data = _data.data();
+	size_t size = _data.size();
+	while (size > 0)
+	{
+		size_t pageOffset = static_cast<size_t>(offset % pageSize);
+		size_t count = min(size, pageSize - pageOffset);
+		copy(data, data + count, page(offset).begin() + static_cast<ptrdiff_t>(pageOffset));
+		data += count;
+		size -= count;
+		offset += count;
+	}
+}
+
 void InterpreterState::dumpTraceAndState(ostream& _out) const
 {
 	_out << "Trace:" << endl;
 	for (auto const& line: trace)
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
-	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-	for (auto const& [offset, value]: words)
-		if (value != 0)
-			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	for (auto const& [index, page]: memory.pages())
+		for (size_t offset = 0; offset < Memory::pageSize; offset += 0x20)
+		{
+			h256 value(bytesConstRef(page.data() + offset, 0x20));
+			if (value != h256{})
+				_out << "  " << std::uppercase << std::hex << std::setw(4) << index * Memory::pageSize + offset << ": " << value.hex() << endl;
+		}
 	_out << "Storage dump:" << endl;
 	for (auto const& slot: storage)
 		if (slot.second != h256{})
 			_out << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
 }
 
-void Interpreter::run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast)
+namespace
 {
-	Scope scope;
-	Interpreter{_state, _dialect, scope}(_ast);
-}
 
-void Interpreter::operator()(ExpressionStatement const& _expressionStatement)
-{
-	evaluateMulti(_expressionStatement.expression);
-}
-
-void Interpreter::operator()(Assignment const& _assignment)
+/**
+ * Translates the AST into compiled statements and expressions. Variables are assigned
+ * consecutive slots within the function they are declared in and calls are resolved to
+ * builtins or to the function definition visible from the call.
+ */
+class Compiler
 {
-	solAssert(_assignment.value, "");
-	vector<u256> values = evaluateMulti(*_assignment.value);
-	solAssert(values.size() == _assignment.variableNames.size(), "");
-	for (size_t i = 0; i < values.size(); ++i)
+public:
+	Compiler(Dialect const& _dialect, deque<CompiledFunction>& _functions):
+		m_dialect(_dialect),
+		m_functions(_functions)
+	{}
+
+	/// Compiles the top-level block as the body of a function without parameters.
+	CompiledFunction compileMain(Block const& _block)
 	{
-		YulString varName = _assignment.variableNames.at(i).name;
-		solAssert(m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
+		CompiledFunction main;
+		m_slotCount = &main.slotCount;
+		m_scopes.push_back({{}, {}, true});
+		main.body = compileBlock(_block);
+		m_scopes.pop_back();
+		return main;
 	}
-}
 
-void Interpreter::operator()(VariableDeclaration const& _declaration)
-{
-	vector<u256> values(_declaration.variables.size(), 0);
-	if (_declaration.value)
-		values = evaluateMulti(*_declaration.value);
+private:
+	struct Scope
+	{
+		map<YulString, size_t> variables;
+		map<YulString, CompiledFunction*> functions;
+		/// Variables of enclosing scopes are not visible in a function body.
+		bool functionBoundary = false;
+	};
 
-	solAssert(values.size() == _declaration.variables.size(), "");
-	for (size_t i = 0; i < values.size(); ++i)
+	vector<CompiledStatement> compileBlock(Block const& _block)
 	{
-		YulString varName = _declaration.variables.at(i).name;
-		solAssert(!m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
-		m_scope->names.emplace(varName, nullptr);
+		m_scopes.emplace_back();
+		for (auto const& statement: _block.statements)
+			if (auto const* function = get_if<FunctionDefinition>(&statement))
+			{
+				CompiledFunction& compiled = m_functions.emplace_back();
+				compiled.parameterCount = function->parameters.size();
+				compiled.returnVariableCount = function->returnVariables.size();
+				m_scopes.back().functions[function->name] = &compiled;
+			}
+		for (auto const& statement: _block.statements)
+			if (auto const* function = get_if<FunctionDefinition>(&statement))
+				compileFunction(*function, *m_scopes.back().functions.at(function->name));
+
+		vector<CompiledStatement> statements;
+		statements.reserve(_block.statements.size());
+		for (auto const& statement: _block.statements)
+			statements.emplace_back(compile(statement));
+		m_scopes.pop_back();
+		return statements;
 	}
-}
 
-void Interpreter::operator()(If const& _if)
-{
-	solAssert(_if.condition, "");
-	if (evaluate(*_if.condition) != 0)
-		(*this)(_if.body);
-}
-
-void Interpreter::operator()(Switch const& _switch)
-{
-	solAssert(_switch.expression, "");
-	u256 val = evaluate(*_switch.expression);
-	solAssert(!_switch.cases.empty(), "");
-	for (auto const& c: _switch.cases)
-		// Default case has to be last.
-		if (!c.value || evaluate(*c.value) == val)
-		{
-			(*this)(c.body);
-			break;
-		}
-}
-
-void Interpreter::operator()(FunctionDefinition const&)
-{
-}
+	void compileFunction(FunctionDefinition const& _function, CompiledFunction& _compiled)
+	{
+		size_t* outerSlotCount = m_slotCount;
+		m_slotCount = &_compiled.slotCount;
+		m_scopes.push_back({{}, {}, true});
+		for (auto const& parameter: _function.parameters)
+			declare(parameter.name);
+		for (auto const& returnVariable: _function.returnVariables)
+			declare(returnVariable.name);
+		_compiled.body = compileBlock(_function.body);
+		m_scopes.pop_back();
+		m_slotCount = outerSlotCount;
+	}
 
-void Interpreter::operator()(ForLoop const& _forLoop)
-{
-	solAssert(_forLoop.condition, "");
+	CompiledStatement compile(Statement const& _statement)
+	{
+		using Kind = CompiledStatement::Kind;
+		return std::visit(GenericVisitor{
+			[&](ExpressionStatement const& _expressionStatement) {
+				return CompiledStatement{Kind::Expression, {}, compile(_expressionStatement.expression), {}, {}, {}, {}};
+			},
+			[&](Assignment const& _assignment) {
+				solAssert(_assignment.value, "");
+				vector<size_t> slots;
+				for (auto const& variable: _assignment.variableNames)
+					slots.emplace_back(slot(variable.name));
+				return CompiledStatement{Kind::Assignment, move(slots), compile(*_assignment.value), {}, {}, {}, {}};
+			},
+			[&](VariableDeclaration const& _declaration) {
+				// The value is compiled before the variables are declared.
+				optional<CompiledExpression> value;
+				if (_declaration.value)
+					value = compile(*_declaration.value);
+				vector<size_t> slots;
+				for (auto const& variable: _declaration.variables)
+					slots.emplace_back(declare(variable.name));
+				return CompiledStatement{Kind::VariableDeclaration, move(slots), move(value), {}, {}, {}, {}};
+			},
+			[&](If const& _if) {
+				solAssert(_if.condition, "");
+				return CompiledStatement{Kind::If, {}, compile(*_if.condition), compileBlock(_if.body), {}, {}, {}};
+			},
+			[&](Switch const& _switch) {
+				solAssert(_switch.expression, "");
+				solAssert(!_switch.cases.empty(), "");
+				CompiledStatement compiled{Kind::Switch, {}, compile(*_switch.expression), {}, {}, {}, {}};
+				for (auto const& switchCase: _switch.cases)
+					compiled.cases.emplace_back(
+						switchCase.value ? optional<u256>(valueOfLiteral(*switchCase.value)) : nullopt,
+						compileBlock(switchCase.body)
+					);
+				return compiled;
+			},
+			[&](ForLoop const& _loop) {
+				solAssert(_loop.condition, "");
+				// The scope of the pre block extends over the whole loop.
+				m_scopes.emplace_back();
+				CompiledStatement compiled{Kind::ForLoop, {}, {}, {}, {}, {}, {}};
+				for (auto const& statement: _loop.pre.statements)
+					compiled.pre.emplace_back(compile(statement));
+				compiled.expression = compile(*_loop.condition);
+				compiled.body = compileBlock(_loop.body);
+				compiled.post = compileBlock(_loop.post);
+				m_scopes.pop_back();
+				return compiled;
+			},
+			[&](FunctionDefinition const&) {
+				return CompiledStatement{Kind::FunctionDefinition, {}, {}, {}, {}, {}, {}};
+			},
+			[&](Break const&) {
+				return CompiledStatement{Kind::Break, {}, {}, {}, {}, {}, {}};
+			},
+			[&](Continue const&) {
+				return CompiledStatement{Kind::Continue, {}, {}, {}, {}, {}, {}};
+			},
+			[&](Leave const&) {
+				return CompiledStatement{Kind::Leave, {}, {}, {}, {}, {}, {}};
+			},
+			[&](Block const& _block) {
+				return CompiledStatement{Kind::Block, {}, {}, compileBlock(_block), {}, {}, {}};
+			}
+		}, _statement);
+	}
 
-	enterScope(_forLoop.pre);
-	ScopeGuard g([this]{ leaveScope(); });
+	CompiledExpression compile(Expression const& _expression)
+	{
+		using Kind = CompiledExpression::Kind;
+		return std::visit(GenericVisitor{
+			[&](Literal const& _literal) {
+				return CompiledExpression{Kind::Literal, valueOfLiteral(_literal), 0, nullptr, nullptr, nullptr, {}};
+			},
+			[&](Identifier const& _identifier) {
+				return CompiledExpression{Kind::Variable, 0, slot(_identifier.name), nullptr, nullptr, nullptr, {}};
+			},
+			[&](FunctionCall const& _call) {
+				CompiledExpression compiled{Kind::FunctionCall, 0, 0, &_call, nullptr, nullptr, {}};
+				vector<optional<LiteralKind>> const* literalArguments = nullptr;
+				if (BuiltinFunction const* builtin = m_dialect.builtin(_call.functionName.name))
+					if (!builtin->literalArguments.empty())
+						literalArguments = &builtin->literalArguments;
+				for (size_t i = 0; i < _call.arguments.size(); ++i)
+					if (literalArguments && literalArguments->at(i))
+						compiled.arguments.push_back(CompiledExpression{Kind::LiteralArgument, 0, 0, nullptr, nullptr, nullptr, {}});
+					else
+						compiled.arguments.emplace_back(compile(_call.arguments[i]));
+
+				if (auto const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+				{
+					if (BuiltinFunctionForEVM const* builtin = dialect->builtin(_call.functionName.name))
+					{
+						compiled.kind = Kind::EVMBuiltin;
+						compiled.evmBuiltin = builtin;
+						return compiled;
+					}
+				}
+				else if (auto const* dialect = dynamic_cast<WasmDialect const*>(&m_dialect))
+					if (dialect->builtin(_call.functionName.name))
+					{
+						compiled.kind = Kind::WasmBuiltin;
+						return compiled;
+					}
+
+				compiled.function = &function(_call.functionName.name);
+				yulAssert(compiled.arguments.size() == compiled.function->parameterCount, "");
+				return compiled;
+			}
+		}, _expression);
+	}
 
-	for (auto const& statement: _forLoop.pre.statements)
+	size_t declare(YulString _name)
 	{
-		visit(statement);
-		if (m_state.controlFlowState == ControlFlowState::Leave)
-			return;
+		solAssert(!m_scopes.back().variables.count(_name), "");
+		return m_scopes.back().variables[_name] = (*m_slotCount)++;
 	}
-	while (evaluate(*_forLoop.condition) != 0)
+
+	size_t slot(YulString _name) const
 	{
-		// Increment step for each loop iteration for loops with
-		// an empty body and post blocks to prevent a deadlock.
-		if (_forLoop.body.statements.size() == 0 && _forLoop.post.statements.size() == 0)
-			incrementStep();
-
-		m_state.controlFlowState = ControlFlowState::Default;
-		(*this)(_forLoop.body);
-		if (m_state.controlFlowState == ControlFlowState::Break || m_state.controlFlowState == ControlFlowState::Leave)
-			break;
+		for (auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope)
+		{
+			if (scope->variables.count(_name))
+				return scope->variables.at(_name);
+			if (scope->functionBoundary)
+				break;
+		}
+		solAssert(false, "");
+	}
 
-		m_state.controlFlowState = ControlFlowState::Default;
-		(*this)(_forLoop.post);
-		if (m_state.controlFlowState == ControlFlowState::Leave)
-			break;
+	CompiledFunction const& function(YulString _name) const
+	{
+		for (auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope)
+			if (scope->functions.count(_name))
+				return *scope->functions.at(_name);
+		yulAssert(false, "Function not found.");
 	}
-	if (m_state.controlFlowState != ControlFlowState::Leave)
-		m_state.controlFlowState = ControlFlowState::Default;
-}
 
-void Interpreter::operator()(Break const&)
-{
-	m_state.controlFlowState = ControlFlowState::Break;
-}
+	Dialect const& m_dialect;
+	/// Storage of all compiled functions, whose addresses must not change.
+	deque<CompiledFunction>& m_functions;
+	vector<Scope> m_scopes;
+	/// Number of slots of the function that is currently compiled.
+	size_t* m_slotCount = nullptr;
+};
 
-void Interpreter::operator()(Continue const&)
-{
-	m_state.controlFlowState = ControlFlowState::Continue;
 }
 
-void Interpreter::operator()(Leave const&)
+void Interpreter::run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast)
 {
-	m_state.controlFlowState = ControlFlowState::Leave;
+	deque<CompiledFunction> functions;
+	CompiledFunction main = Compiler(_dialect, functions).compileMain(_ast);
+	vector<u256> frame(main.slotCount);
+	Interpreter{_state, _dialect}.execute(main.body, frame);
 }
 
-void Interpreter::operator()(Block const& _block)
+void Interpreter::execute(vector<CompiledStatement> const& _block, vector<u256>& _frame)
 {
-	enterScope(_block);
-	// Register functions.
-	for (auto const& statement: _block.statements)
-		if (holds_alternative<FunctionDefinition>(statement))
-		{
-			FunctionDefinition const& funDef = std::get<FunctionDefinition>(statement);
-			m_scope->names.emplace(funDef.name, &funDef);
-		}
-
-	for (auto const& statement: _block.statements)
+	for (auto const& statement: _block)
 	{
 		incrementStep();
-		visit(statement);
+		execute(statement, _frame);
 		if (m_state.controlFlowState != ControlFlowState::Default)
 			break;
 	}
-
-	leaveScope();
 }
 
-u256 Interpreter::evaluate(Expression const& _expression)
+void Interpreter::execute(CompiledStatement const& _statement, vector<u256>& _frame)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables);
-	ev.visit(_expression);
-	return ev.value();
-}
-
-vector<u256> Interpreter::evaluateMulti(Expression const& _expression)
-{
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables);
-	ev.visit(_expression);
-	return ev.values();
+	switch (_statement.kind)
+	{
+	case CompiledStatement::Kind::Expression:
+		evaluateMulti(*_statement.expression, _frame);
+		break;
+	case CompiledStatement::Kind::Assignment:
+	case CompiledStatement::Kind::VariableDeclaration:
+		if (!_statement.expression)
+			for (size_t slot: _statement.slots)
+				_frame[slot] = 0;
+		else if (_statement.slots.size() == 1)
+			_frame[_statement.slots.front()] = evaluate(*_statement.expression, _frame);
+		else
+		{
+			vector<u256> values = evaluateMulti(*_statement.expression, _frame);
+			solAssert(values.size() == _statement.slots.size(), "");
+			for (size_t i = 0; i < values.size(); ++i)
+				_frame[_statement.slots[i]] = move(values[i]);
+		}
+		break;
+	case CompiledStatement::Kind::If:
+		if (evaluate(*_statement.expression, _frame) != 0)
+			execute(_statement.body, _frame);
+		break;
+	case CompiledStatement::Kind::Switch:
+	{
+		u256 value = evaluate(*_statement.expression, _frame);
+		for (auto const& [caseValue, body]: _statement.cases)
+			// Default case has to be last.
+			if (!caseValue || *caseValue == value)
+			{
+				execute(body, _frame);
+				break;
+			}
+		break;
+	}
+	case CompiledStatement::Kind::ForLoop:
+		for (auto const& statement: _statement.pre)
+		{
+			execute(statement, _frame);
+			if (m_state.controlFlowState == ControlFlowState::Leave)
+				return;
+		}
+		while (evaluate(*_statement.expression, _frame) != 0)
+		{
+			// Increment step for each loop iteration for loops with
+			// an empty body and post blocks to prevent a deadlock.
+			if (_statement.body.empty() && _statement.post.empty())
+				incrementStep();
+
+			m_state.controlFlowState = ControlFlowState::Default;
+			execute(_statement.body, _frame);
+			if (m_state.controlFlowState == ControlFlowState::Break || m_state.controlFlowState == ControlFlowState::Leave)
+				break;
+
+			m_state.controlFlowState = ControlFlowState::Default;
+			execute(_statement.post, _frame);
+			if (m_state.controlFlowState == ControlFlowState::Leave)
+				break;
+		}
+		if (m_state.controlFlowState != ControlFlowState::Leave)
+			m_state.controlFlowState = ControlFlowState::Default;
+		break;
+	case CompiledStatement::Kind::Break:
+		m_state.controlFlowState = ControlFlowState::Break;
+		break;
+	case CompiledStatement::Kind::Continue:
+		m_state.controlFlowState = ControlFlowState::Continue;
+		break;
+	case CompiledStatement::Kind::Leave:
+		m_state.controlFlowState = ControlFlowState::Leave;
+		break;
+	case CompiledStatement::Kind::Block:
+		execute(_statement.body, _frame);
+		break;
+	case CompiledStatement::Kind::FunctionDefinition:
+		break;
+	}
 }
 
-void Interpreter::enterScope(Block const& _block)
+u256 Interpreter::evaluate(CompiledExpression const& _expression, vector<u256>& _frame)
 {
-	if (!m_scope->subScopes.count(&_block))
-		m_scope->subScopes[&_block] = make_unique<Scope>(Scope{
-			{},
-			{},
-			m_scope
-		});
-	m_scope = m_scope->subScopes[&_block].get();
+	size_t nestingLevel = 0;
+	return evaluateValue(_expression, _frame, nestingLevel);
 }
 
-void Interpreter::leaveScope()
+vector<u256> Interpreter::evaluateMulti(CompiledExpression const& _expression, vector<u256>& _frame)
 {
-	for (auto const& [var, funDeclaration]: m_scope->names)
-		if (!funDeclaration)
-			m_variables.erase(var);
-	m_scope = m_scope->parent;
-	yulAssert(m_scope, "");
+	size_t nestingLevel = 0;
+	return evaluateValues(_expression, _frame, nestingLevel);
 }
 
-void Interpreter::incrementStep()
+u256 Interpreter::evaluateValue(CompiledExpression const& _expression, vector<u256>& _frame, size_t& _nestingLevel)
 {
-	m_state.numSteps++;
-	if (m_state.maxSteps > 0 && m_state.numSteps >= m_state.maxSteps)
+	switch (_expression.kind)
 	{
-		m_state.trace.emplace_back("Interpreter execution step limit reached.");
-		throw StepLimitReached();
+	case CompiledExpression::Kind::Literal:
+		incrementNestingLevel(_nestingLevel);
+		return _expression.value;
+	case CompiledExpression::Kind::LiteralArgument:
+		return 0;
+	case CompiledExpression::Kind::Variable:
+		incrementNestingLevel(_nestingLevel);
+		return _frame[_expression.slot];
+	case CompiledExpression::Kind::EVMBuiltin:
+	case CompiledExpression::Kind::WasmBuiltin:
+		return callBuiltin(_expression, evaluateArguments(_expression, _frame, _nestingLevel));
+	case CompiledExpression::Kind::FunctionCall:
+	{
+		vector<u256> values = callFunction(*_expression.function, evaluateArguments(_expression, _frame, _nestingLevel));
+		solAssert(values.size() == 1, "");
+		return values.front();
 	}
+	}
+	solAssert(false, "");
 }
 
-void ExpressionEvaluator::operator()(Literal const& _literal)
+vector<u256> Interpreter::evaluateValues(CompiledExpression const& _expression, vector<u256>& _frame, size_t& _nestingLevel)
 {
-	incrementStep();
-	static YulString const trueString("true");
-	static YulString const falseString("false");
-
-	setValue(valueOfLiteral(_literal));
+	if (_expression.kind == CompiledExpression::Kind::FunctionCall)
+		return callFunction(*_expression.function, evaluateArguments(_expression, _frame, _nestingLevel));
+	else
+		return {evaluateValue(_expression, _frame, _nestingLevel)};
 }
 
-void ExpressionEvaluator::operator()(Identifier const& _identifier)
+vector<u256> Interpreter::evaluateArguments(CompiledExpression const& _call, vector<u256>& _frame, size_t& _nestingLevel)
 {
-	solAssert(m_variables.count(_identifier.name), "");
-	incrementStep();
-	setValue(m_variables.at(_identifier.name));
+	incrementNestingLevel(_nestingLevel);
+	vector<u256> values(_call.arguments.size());
+	/// Function arguments are evaluated in reverse.
+	for (size_t i = values.size(); i > 0; --i)
+		values[i - 1] = evaluateValue(_call.arguments[i - 1], _frame, _nestingLevel);
+	return values;
 }
 
-void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
+u256 Interpreter::callBuiltin(CompiledExpression const& _call, vector<u256> const& _arguments)
 {
-	vector<optional<LiteralKind>> const* literalArguments = nullptr;
-	if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
-		if (!builtin->literalArguments.empty())
-			literalArguments = &builtin->literalArguments;
-	evaluateArgs(_funCall.arguments, literalArguments);
-
-	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
-	{
-		if (BuiltinFunctionForEVM const* fun = dialect->builtin(_funCall.functionName.name))
-		{
-			EVMInstructionInterpreter interpreter(m_state);
-			setValue(interpreter.evalBuiltin(*fun, _funCall.arguments, values()));
-			return;
-		}
-	}
-	else if (WasmDialect const* dialect = dynamic_cast<WasmDialect const*>(&m_dialect))
-		if (dialect->builtin(_funCall.functionName.name))
-		{
-			EwasmBuiltinInterpreter interpreter(m_state);
-			setValue(interpreter.evalBuiltin(_funCall.functionName.name, _funCall.arguments, values()));
-			return;
-		}
+	if (_call.kind == CompiledExpression::Kind::EVMBuiltin)
+		return EVMInstructionInterpreter(m_state).evalBuiltin(*_call.evmBuiltin, _call.call->arguments, _arguments);
+	else
+		return EwasmBuiltinInterpreter(m_state).evalBuiltin(_call.call->functionName.name, _call.call->arguments, _arguments);
+}
 
-	Scope* scope = &m_scope;
-	for (; scope; scope = scope->parent)
-		if (scope->names.count(_funCall.functionName.name))
-			break;
-	yulAssert(scope, "");
+vector<u256> Interpreter::callFunction(CompiledFunction const& _function, vector<u256> const& _arguments)
+{
+	// Jumping into and out of the function and pushing the return label.
+	m_state.estimatedGas += 2 * evmasm::GasMeter::runGas(evmasm::Instruction::JUMP) +
+		evmasm::GasMeter::runGas(evmasm::Instruction::JUMPDEST) +
+		evmasm::GasMeter::runGas(evmasm::Instruction::PUSH1);
 
-	FunctionDefinition const* fun = scope->names.at(_funCall.functionName.name);
-	yulAssert(fun, "Function not found.");
-	yulAssert(m_values.size() == fun->parameters.size(), "");
-	map<YulString, u256> variables;
-	for (size_t i = 0; i < fun->parameters.size(); ++i)
-		variables[fun->parameters.at(i).name] = m_values.at(i);
-	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
-		variables[fun->returnVariables.at(i).name] = 0;
+	vector<u256> frame(_function.slotCount);
+	copy(_arguments.begin(), _arguments.end(), frame.begin());
 
 	m_state.controlFlowState = ControlFlowState::Default;
-	Interpreter interpreter(m_state, m_dialect, *scope, std::move(variables));
-	interpreter(fun->body);
+	execute(_function.body, frame);
 	m_state.controlFlowState = ControlFlowState::Default;
 
-	m_values.clear();
-	for (auto const& retVar: fun->returnVariables)
-		m_values.emplace_back(interpreter.valueOfVariable(retVar.name));
+	auto returnVariables = frame.begin() + static_cast<ptrdiff_t>(_function.parameterCount);
+	return vector<u256>(returnVariables, returnVariables + static_cast<ptrdiff_t>(_function.returnVariableCount));
 }
 
-u256 ExpressionEvaluator::value() const
-{
-	solAssert(m_values.size() == 1, "");
-	return m_values.front();
-}
-
-void ExpressionEvaluator::setValue(u256 _value)
-{
-	m_values.clear();
-	m_values.emplace_back(std::move(_value));
-}
-
-void ExpressionEvaluator::evaluateArgs(
-	vector<Expression> const& _expr,
-	vector<optional<LiteralKind>> const* _literalArguments
-)
+void Interpreter::incrementStep()
 {
-	incrementStep();
-	vector<u256> values;
-	size_t i = 0;
-	/// Function arguments are evaluated in reverse.
-	for (auto const& expr: _expr | boost::adaptors::reversed)
+	m_state.numSteps++;
+	if (m_state.maxSteps > 0 && m_state.numSteps >= m_state.maxSteps)
 	{
-		if (!_literalArguments || !_literalArguments->at(_expr.size() - i - 1))
-			visit(expr);
-		else
-			m_values = {0};
-		values.push_back(value());
-		++i;
+		m_state.trace.emplace_back("Interpreter execution step limit reached.");
+		throw StepLimitReached();
 	}
-	m_values = std::move(values);
-	std::reverse(m_values.begin(), m_values.end());
 }
 
-void ExpressionEvaluator::incrementStep()
+void Interpreter::incrementNestingLevel(size_t& _nestingLevel)
 {
-	m_nestingLevel++;
-	if (m_state.maxExprNesting > 0 && m_nestingLevel > m_state.maxExprNesting)
+	_nestingLevel++;
+	if (m_state.maxExprNesting > 0 && _nestingLevel > m_state.maxExprNesting)
 	{
 		m_state.trace.emplace_back("Maximum expression nesting level reached.");
 		throw ExpressionNestingLimitReached();
@@ -22,18 +22,20 @@
 #pragma once
 
 #include <libyul/ASTForward.h>
-#include <libyul/optimiser/ASTWalker.h>
 
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/CommonData.h>
 
 #include <libsolutil/Exceptions.h>
 
+#include <array>
 #include <map>
+#include <optional>
 
 namespace solidity::yul
 {
 struct Dialect;
+struct BuiltinFunctionForEVM;
 }
 
 namespace solidity::yul::test
@@ -67,11 +69,37 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Sparse memory of the interpreter. Memory is allocated in zero-initialised pages
+ * on first access and addresses wrap around at 2**256.
+ */
+class Memory
+{
+public:
+	static size_t constexpr pageSize = 0x100;
+	using Page = std::array<uint8_t, pageSize>;
+
+	uint8_t& operator[](u256 const& _offset) { return page(_offset)[static_cast<size_t>(_offset % pageSize)]; }
+
+	/// Copies @a _size bytes starting at @a _offset to @a _target.
+	void read(u256 const& _offset, uint8_t* _target, size_t _size);
+	/// Copies @a _data to memory starting at @a _offset.
+	void write(u256 const& _offset, bytesConstRef _data);
+
+	/// @returns the allocated pages by the address of their first byte divided by the page size.
+	std::map<u256, Page> const& pages() const { return m_pages; }
+
+private:
+	Page& page(u256 const& _offset) { return m_pages[_offset / pageSize]; }
+
+	std::map<u256, Page> m_pages;
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
+	Memory memory;
 	/// This is different than memory.size() because we ignore gas.
 	u256 msize;
 	std::map<util::h256, util::h256> storage;
@@ -96,132 +124,137 @@ struct InterpreterState
 	size_t maxTraceSize = 0;
 	size_t maxSteps = 0;
 	size_t numSteps = 0;
+	/// Rough estimate of the gas used by the executed code: the base costs of all
+	/// executed EVM instructions plus a constant for every call to a Yul function.
+	/// Ignores memory expansion, storage state and stack manipulation.
+	size_t estimatedGas = 0;
 	size_t maxExprNesting = 0;
 	ControlFlowState controlFlowState = ControlFlowState::Default;
 
 	void dumpTraceAndState(std::ostream& _out) const;
 };
 
+struct CompiledFunction;
+
 /**
- * Scope structure built and maintained during execution.
+ * Expression in which variables are resolved to slots in the frame of the
+ * enclosing function and function calls to their builtin or definition.
  */
-struct Scope
+struct CompiledExpression
 {
-	/// Used for variables and functions. Value is nullptr for variables.
-	std::map<YulString, FunctionDefinition const*> names;
-	std::map<Block const*, std::unique_ptr<Scope>> subScopes;
-	Scope* parent = nullptr;
+	enum class Kind
+	{
+		Literal,
+		/// Literal argument of a builtin, which is not evaluated and passed as zero.
+		LiteralArgument,
+		Variable,
+		EVMBuiltin,
+		WasmBuiltin,
+		FunctionCall
+	};
+
+	Kind kind;
+	/// Value of a literal.
+	u256 value;
+	/// Slot of a variable.
+	size_t slot = 0;
+	/// The call of a builtin or function.
+	FunctionCall const* call = nullptr;
+	BuiltinFunctionForEVM const* evmBuiltin = nullptr;
+	CompiledFunction const* function = nullptr;
+	std::vector<CompiledExpression> arguments;
 };
 
 /**
- * Yul interpreter.
+ * Statement with resolved variables and functions. Blocks and the bodies of
+ * control flow statements are lists of statements.
  */
-class Interpreter: public ASTWalker
+struct CompiledStatement
 {
-public:
-	static void run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast);
-
-	Interpreter(
-		InterpreterState& _state,
-		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> _variables = {}
-	):
-		m_dialect(_dialect),
-		m_state(_state),
-		m_variables(std::move(_variables)),
-		m_scope(&_scope)
+	enum class Kind
 	{
-	}
-
-	void operator()(ExpressionStatement const& _statement) override;
-	void operator()(Assignment const& _assignment) override;
-	void operator()(VariableDeclaration const& _varDecl) override;
-	void operator()(If const& _if) override;
-	void operator()(Switch const& _switch) override;
-	void operator()(FunctionDefinition const&) override;
-	void operator()(ForLoop const&) override;
-	void operator()(Break const&) override;
-	void operator()(Continue const&) override;
-	void operator()(Leave const&) override;
-	void operator()(Block const& _block) override;
-
-	std::vector<std::string> const& trace() const { return m_state.trace; }
-
-	u256 valueOfVariable(YulString _name) const { return m_variables.at(_name); }
-
-private:
-	/// Asserts that the expression evaluates to exactly one value and returns it.
-	u256 evaluate(Expression const& _expression);
-	/// Evaluates the expression and returns its value.
-	std::vector<u256> evaluateMulti(Expression const& _expression);
-
-	void enterScope(Block const& _block);
-	void leaveScope();
-
-	/// Increment interpreter step count, throwing exception if step limit
-	/// is reached.
-	void incrementStep();
+		Expression,
+		Assignment,
+		VariableDeclaration,
+		If,
+		Switch,
+		ForLoop,
+		Break,
+		Continue,
+		Leave,
+		Block,
+		FunctionDefinition
+	};
+
+	Kind kind;
+	/// Assigned or declared variables.
+	std::vector<size_t> slots;
+	/// Expression of an expression statement, value of an assignment or declaration,
+	/// condition of an if statement or loop and expression of a switch.
+	std::optional<CompiledExpression> expression;
+	/// Body of an if statement, loop or block.
+	std::vector<CompiledStatement> body;
+	/// Cases of a switch statement; the default case has no value.
+	std::vector<std::pair<std::optional<u256>, std::vector<CompiledStatement>>> cases;
+	/// Pre and post statements of a loop.
+	std::vector<CompiledStatement> pre;
+	std::vector<CompiledStatement> post;
+};
 
-	Dialect const& m_dialect;
-	InterpreterState& m_state;
-	/// Values of variables.
-	std::map<YulString, u256> m_variables;
-	Scope* m_scope;
+struct CompiledFunction
+{
+	std::vector<CompiledStatement> body;
+	/// Number of slots of a frame, the first of which hold the parameters,
+	/// followed by the return variables.
+	size_t slotCount = 0;
+	size_t parameterCount = 0;
+	size_t returnVariableCount = 0;
 };
 
 /**
- * Yul expression evaluator.
+ * Yul interpreter. The AST is first compiled into a tree of statements and expressions
+ * in which all names are resolved, so that variables live in a flat frame per function
+ * call and builtins are dispatched directly.
  */
-class ExpressionEvaluator: public ASTWalker
+class Interpreter
 {
 public:
-	ExpressionEvaluator(
-		InterpreterState& _state,
-		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> const& _variables
-	):
+	static void run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast);
+
+private:
+	Interpreter(InterpreterState& _state, Dialect const& _dialect):
 		m_state(_state),
-		m_dialect(_dialect),
-		m_variables(_variables),
-		m_scope(_scope)
+		m_dialect(_dialect)
 	{}
 
-	void operator()(Literal const&) override;
-	void operator()(Identifier const&) override;
-	void operator()(FunctionCall const& _funCall) override;
-
-	/// Asserts that the expression has exactly one value and returns it.
-	u256 value() const;
-	/// Returns the list of values of the expression.
-	std::vector<u256> values() const { return m_values; }
+	/// Executes the statements of @a _block until the control flow changes.
+	void execute(std::vector<CompiledStatement> const& _block, std::vector<u256>& _frame);
+	void execute(CompiledStatement const& _statement, std::vector<u256>& _frame);
 
-private:
-	void setValue(u256 _value);
-
-	/// Evaluates the given expression from right to left and
-	/// stores it in m_value.
-	void evaluateArgs(
-		std::vector<Expression> const& _expr,
-		std::vector<std::optional<LiteralKind>> const* _literalArguments
-	);
+	/// Asserts that the expression evaluates to exactly one value and returns it.
+	u256 evaluate(CompiledExpression const& _expression, std::vector<u256>& _frame);
+	/// Evaluates the expression and returns its values.
+	std::vector<u256> evaluateMulti(CompiledExpression const& _expression, std::vector<u256>& _frame);
+
+	/// Evaluates a single-valued (sub)expression, counting the evaluated nodes in @a _nestingLevel.
+	u256 evaluateValue(CompiledExpression const& _expression, std::vector<u256>& _frame, size_t& _nestingLevel);
+	/// Evaluates a (sub)expression, counting the evaluated nodes in @a _nestingLevel.
+	std::vector<u256> evaluateValues(CompiledExpression const& _expression, std::vector<u256>& _frame, size_t& _nestingLevel);
+	/// Evaluates the arguments of a function call from right to left.
+	std::vector<u256> evaluateArguments(CompiledExpression const& _call, std::vector<u256>& _frame, size_t& _nestingLevel);
+	u256 callBuiltin(CompiledExpression const& _call, std::vector<u256> const& _arguments);
+	std::vector<u256> callFunction(CompiledFunction const& _function, std::vector<u256> const& _arguments);
 
+	/// Increment interpreter step count, throwing exception if step limit
+	/// is reached.
+	void incrementStep();
 	/// Increment evaluation count, throwing exception if the
 	/// nesting level is beyond the upper bound configured in
 	/// the interpreter state.
-	void incrementStep();
+	void incrementNestingLevel(size_t& _nestingLevel);
 
 	InterpreterState& m_state;
 	Dialect const& m_dialect;
-	/// Values of variables.
-	std::map<YulString, u256> const& m_variables;
-	Scope& m_scope;
-	/// Current value of the expression
-	std::vector<u256> m_values;
-	/// Current expression nesting level
-	unsigned m_nestingLevel = 0;
 };
 
 }
-
@@ -34,12 +34,14 @@
 
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/OptimiserStepProfiler.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 
 #include <libsolutil/JSON.h>
 
@@ -197,7 +199,7 @@ public:
 			if (abbreviationAndName != abbreviationMap.end())
 			{
 				OptimiserStep const& step = *OptimiserSuite::allSteps().at(abbreviationAndName->second);
-				step.run(context, *m_ast);
+				OptimiserStepProfiler::instance().measure(step.name, *m_ast, [&] { step.run(context, *m_ast); });
 			}
 			else switch (option)
 			{
@@ -222,10 +224,33 @@ public:
 		}
 	}
 
+	/// Runs the full optimiser suite with the step sequence @a _steps on @a _source
+	/// and prints the result.
+	void runSteps(string const& _source, string const& _steps)
+	{
+		if (!parse(_source))
+			return;
+		try
+		{
+			OptimiserSuite::validateSequence(_steps);
+		}
+		catch (OptimizerException const& _exception)
+		{
+			cerr << "Invalid optimizer step sequence: " << _exception.what() << endl;
+			return;
+		}
+		Object object;
+		object.code = m_ast;
+		object.analysisInfo = m_analysisInfo;
+		GasMeter meter{m_dialect, false, 200};
+		OptimiserSuite::run(m_dialect, &meter, object, true, _steps);
+		cout << AsmPrinter{m_dialect}(*object.code) << endl;
+	}
+
 private:
 	ErrorList m_errors;
 	shared_ptr<yul::Block> m_ast;
-	Dialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
+	EVMDialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
 	shared_ptr<AsmAnalysisInfo> m_analysisInfo;
 	shared_ptr<NameDispenser> m_nameDispenser;
 };
@@ -236,7 +261,7 @@ int main(int argc, char** argv)
 		R"(yulopti, yul optimizer exploration tool.
 Usage: yulopti [Options] <file>
 Reads <file> as yul code and applies optimizer steps to it,
-interactively read from stdin.
+interactively read from stdin or given by --steps.
 
 Allowed options)",
 		po::options_description::m_default_line_length,
@@ -247,6 +272,15 @@ Allowed options)",
 			po::value<string>(),
 			"input file"
 		)
+		(
+			"steps",
+			po::value<string>()->value_name("steps"),
+			"Run the optimizer suite with the given step sequence non-interactively and print the result."
+		)
+		(
+			"profile",
+			"Print the number of invocations, the wall-clock time and the change in code size of each step at the end."
+		)
 		("help", "Show this help screen.");
 
 	// All positional options should be interpreted as input files
@@ -277,10 +311,19 @@ Allowed options)",
 		return 1;
 	}
 
-	if (arguments.count("input-file"))
-		YulOpti{}.runInteractive(input);
-	else
+	if (arguments.count("profile"))
+		OptimiserStepProfiler::instance().setEnabled(true);
+
+	if (!arguments.count("input-file"))
 		cout << options;
+	else if (arguments.count("steps"))
+		YulOpti{}.runSteps(input, arguments["steps"].as<string>());
+	else
+		YulOpti{}.runInteractive(input);
+
+	if (arguments.count("profile"))
+		cout << endl << OptimiserStepProfiler::instance().toString() <<
+			endl << OptimiserStepProfiler::instance().rulesToString();
 
 	return 0;
 }
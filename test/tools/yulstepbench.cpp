@@ -0,0 +1,452 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Microbenchmark for the Yul optimiser steps: Runs every step on generated inputs of
+ * increasing size and estimates how the run time of each step grows with the input size.
+ */
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/Exceptions.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+using Clock = chrono::steady_clock;
+
+/// Run times below this threshold (in milliseconds) are too noisy to estimate the growth of a step.
+double constexpr minimumTimeForGrowthMs = 0.05;
+
+/**
+ * Generator of deterministic pseudo-random Yul code consisting of a number of functions
+ * with nested control flow, calls to other functions and storage and memory accesses.
+ */
+class YulGenerator
+{
+public:
+	/// @param _functions number of functions
+	/// @param _statements number of statements per block
+	/// @param _depth maximum nesting depth of blocks inside the functions
+	YulGenerator(size_t _functions, size_t _statements, size_t _depth, unsigned _seed):
+		m_functions(_functions),
+		m_statements(_statements),
+		m_depth(_depth),
+		m_random(_seed)
+	{}
+
+	string run()
+	{
+		m_out << "{" << endl;
+		for (size_t i = 0; i < m_functions; ++i)
+			m_out << "  sstore(" << i << ", f_" << i << "(calldataload(0), calldataload(32)))" << endl;
+		for (m_currentFunction = 0; m_currentFunction < m_functions; ++m_currentFunction)
+		{
+			m_out << "  function f_" << m_currentFunction << "(a_" << m_currentFunction << ", b_" <<
+				m_currentFunction << ") -> r_" << m_currentFunction << endl;
+			m_scope = {
+				"a_" + to_string(m_currentFunction),
+				"b_" + to_string(m_currentFunction),
+				"r_" + to_string(m_currentFunction)
+			};
+			block(1);
+		}
+		m_out << "}" << endl;
+		return m_out.str();
+	}
+
+private:
+	size_t random(size_t _bound) { return uniform_int_distribution<size_t>(0, _bound - 1)(m_random); }
+
+	string indentation(size_t _depth) const { return string(2 * (_depth + 1), ' '); }
+
+	void block(size_t _depth)
+	{
+		size_t scopeSize = m_scope.size();
+		m_out << indentation(_depth - 1) << "{" << endl;
+		for (size_t i = 0; i < m_statements; ++i)
+			statement(_depth);
+		m_out << indentation(_depth - 1) << "}" << endl;
+		m_scope.resize(scopeSize);
+	}
+
+	void statement(size_t _depth)
+	{
+		string const indent = indentation(_depth);
+		// Nest about one in four statements.
+		if (_depth < m_depth && random(4) == 0)
+			switch (random(3))
+			{
+			case 0:
+				m_out << indent << "if " << expression() << endl;
+				block(_depth + 1);
+				return;
+			case 1:
+			{
+				string counter = newVariable();
+				m_out << indent << "for { let " << counter << " := 0 } lt(" << counter << ", " <<
+					expression() << ") { " << counter << " := add(" << counter << ", 1) }" << endl;
+				m_scope.push_back(counter);
+				block(_depth + 1);
+				m_scope.pop_back();
+				return;
+			}
+			default:
+				m_out << indent << "switch " << expression() << endl;
+				m_out << indent << "case 0" << endl;
+				block(_depth + 1);
+				m_out << indent << "default" << endl;
+				block(_depth + 1);
+				return;
+			}
+
+		switch (random(5))
+		{
+		case 0:
+		case 1:
+		{
+			string variable = newVariable();
+			m_out << indent << "let " << variable << " := " << expression() << endl;
+			m_scope.push_back(variable);
+			break;
+		}
+		case 2:
+			m_out << indent << m_scope[random(m_scope.size())] << " := " << expression() << endl;
+			break;
+		case 3:
+			m_out << indent << "sstore(" << expression() << ", " << expression() << ")" << endl;
+			break;
+		default:
+			m_out << indent << "mstore(" << expression() << ", " << expression() << ")" << endl;
+			break;
+		}
+	}
+
+	string expression(size_t _depth = 0)
+	{
+		size_t choice = random(_depth < 2 ? 8 : 3);
+		switch (choice)
+		{
+		case 0:
+		case 1:
+			return m_scope[random(m_scope.size())];
+		case 2:
+			return to_string(random(64));
+		case 3:
+			return "calldataload(" + to_string(32 * random(4)) + ")";
+		case 4:
+			return "mload(" + expression(_depth + 1) + ")";
+		case 5:
+			// Only call earlier functions to avoid recursion.
+			if (m_currentFunction > 0)
+				return
+					"f_" + to_string(random(m_currentFunction)) +
+					"(" + expression(_depth + 1) + ", " + expression(_depth + 1) + ")";
+			return "sload(" + expression(_depth + 1) + ")";
+		default:
+		{
+			static vector<string> const operations{"add", "mul", "sub", "and", "lt", "eq", "shl"};
+			return
+				operations[random(operations.size())] +
+				"(" + expression(_depth + 1) + ", " + expression(_depth + 1) + ")";
+		}
+		}
+	}
+
+	string newVariable() { return "v_" + to_string(m_nextVariable++); }
+
+	size_t const m_functions;
+	size_t const m_statements;
+	size_t const m_depth;
+	mt19937 m_random;
+	ostringstream m_out;
+	vector<string> m_scope;
+	size_t m_currentFunction = 0;
+	size_t m_nextVariable = 0;
+};
+
+/// Input of the benchmark: Disambiguated code that has been brought into the form the
+/// optimiser suite establishes before running any other step.
+struct Input
+{
+	string name;
+	Block code;
+	size_t codeSize = 0;
+};
+
+Input prepareInput(string const& _name, string const& _source, Dialect const& _dialect, set<YulString> const& _reservedIdentifiers)
+{
+	AssemblyStack stack(EVMVersion{}, AssemblyStack::Language::StrictAssembly, frontend::OptimiserSettings::none());
+	if (!stack.parseAndAnalyze(_name, _source))
+	{
+		for (auto const& error: stack.errors())
+			SourceReferenceFormatter(cerr, true, false).printErrorInformation(*error);
+		BOOST_THROW_EXCEPTION(Exception() << errinfo_comment("Invalid generated code."));
+	}
+	shared_ptr<Object> object = stack.parserResult();
+
+	Input input{_name, std::get<Block>(Disambiguator(_dialect, *object->analysisInfo, _reservedIdentifiers)(*object->code)), 0};
+	NameDispenser dispenser{_dialect, input.code, _reservedIdentifiers};
+	OptimiserStepContext context{_dialect, dispenser, _reservedIdentifiers};
+	for (string step: {"FunctionHoister", "BlockFlattener", "FunctionGrouper", "ForLoopInitRewriter"})
+		OptimiserSuite::allSteps().at(step)->run(context, input.code);
+	input.codeSize = CodeSize::codeSizeIncludingFunctions(input.code);
+	return input;
+}
+
+/// Runs the step @a _step on fresh copies of @a _input @a _repetitions times.
+/// @returns the minimum run time in milliseconds.
+double measure(OptimiserStep const& _step, Input const& _input, Dialect const& _dialect, set<YulString> const& _reservedIdentifiers, size_t _repetitions)
+{
+	double best = numeric_limits<double>::infinity();
+	for (size_t i = 0; i < _repetitions; ++i)
+	{
+		Block code = std::get<Block>(ASTCopier{}(_input.code));
+		NameDispenser dispenser{_dialect, code, _reservedIdentifiers};
+		OptimiserStepContext context{_dialect, dispenser, _reservedIdentifiers};
+		auto start = Clock::now();
+		_step.run(context, code);
+		best = min(best, chrono::duration<double, milli>(Clock::now() - start).count());
+	}
+	return best;
+}
+
+/// @returns the exponent k of the best fit of t = c * n^k for the run times @a _times of the
+/// inputs of the sizes @a _sizes, ignoring measurements that are too short to be reliable.
+optional<double> growthExponent(vector<Input> const& _inputs, vector<double> const& _times)
+{
+	vector<pair<double, double>> points;
+	for (size_t i = 0; i < _inputs.size(); ++i)
+		if (_times[i] >= minimumTimeForGrowthMs)
+			points.emplace_back(log(double(_inputs[i].codeSize)), log(_times[i]));
+	if (points.size() < 2)
+		return nullopt;
+
+	double meanX = 0;
+	double meanY = 0;
+	for (auto const& [x, y]: points)
+	{
+		meanX += x / double(points.size());
+		meanY += y / double(points.size());
+	}
+	double covariance = 0;
+	double variance = 0;
+	for (auto const& [x, y]: points)
+	{
+		covariance += (x - meanX) * (y - meanY);
+		variance += (x - meanX) * (x - meanX);
+	}
+	if (variance == 0)
+		return nullopt;
+	return covariance / variance;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulstepbench, microbenchmark for the Yul optimiser steps.
+Usage: yulstepbench [Options]
+Generates Yul code of increasing size, runs every optimiser step on it and
+prints the run time of the step for each input size together with the
+exponent k of the best fit of time = c * size^k. Steps with an exponent well
+above one scale super-linearly with the size of the code.
+The inputs are scaled in two series: By doubling the number of functions and
+by doubling the number of statements per block (which makes the functions
+longer). The ReasoningBasedSimplifier is only run if it is selected explicitly.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("steps", po::value<string>(), "Only run the steps with the given abbreviations (e.g. \"xaL\").")
+		("functions", po::value<size_t>()->default_value(8), "Number of functions of the smallest input.")
+		("statements", po::value<size_t>()->default_value(6), "Number of statements per block of the smallest input.")
+		("depth", po::value<size_t>()->default_value(3), "Maximum nesting depth of blocks inside functions.")
+		("scales", po::value<size_t>()->default_value(4), "Number of inputs of each series, each twice as large as the previous one.")
+		("repeat", po::value<size_t>()->default_value(3), "Run every step this many times on every input and report the minimum time.")
+		("seed", po::value<unsigned>()->default_value(1), "Seed of the code generator.")
+		("max-exponent", po::value<double>(), "Fail if the growth exponent of any step exceeds this value.")
+		("print-input", "Print the smallest input of each series and exit.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::command_line_parser(argc, argv).options(options).run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{});
+	set<YulString> reservedIdentifiers = dialect.fixedFunctionNames();
+
+	vector<string> steps;
+	if (arguments.count("steps"))
+	{
+		for (char abbreviation: arguments["steps"].as<string>())
+			if (OptimiserSuite::stepAbbreviationToNameMap().count(abbreviation))
+				steps.push_back(OptimiserSuite::stepAbbreviationToNameMap().at(abbreviation));
+			else
+			{
+				cerr << "Unknown step abbreviation: " << abbreviation << endl;
+				return 1;
+			}
+	}
+	else
+		for (auto const& [name, step]: OptimiserSuite::allSteps())
+			// This step queries an SMT solver and is orders of magnitude slower than all others.
+			if (name != "ReasoningBasedSimplifier")
+				steps.push_back(name);
+
+	size_t const functions = max<size_t>(arguments["functions"].as<size_t>(), 1);
+	size_t const statements = max<size_t>(arguments["statements"].as<size_t>(), 1);
+	size_t const depth = max<size_t>(arguments["depth"].as<size_t>(), 1);
+	size_t const scales = max<size_t>(arguments["scales"].as<size_t>(), 2);
+	size_t const repetitions = max<size_t>(arguments["repeat"].as<size_t>(), 1);
+	unsigned const seed = arguments["seed"].as<unsigned>();
+
+	if (arguments.count("print-input"))
+	{
+		cout << YulGenerator(functions, statements, depth, seed).run();
+		return 0;
+	}
+
+	vector<pair<string, vector<Input>>> series(2);
+	series[0].first = "functions";
+	series[1].first = "statements";
+	try
+	{
+		for (size_t scale = 0; scale < scales; ++scale)
+		{
+			size_t factor = size_t(1) << scale;
+			string name = to_string(functions * factor) + "x" + to_string(statements);
+			series[0].second.emplace_back(prepareInput(
+				name,
+				YulGenerator(functions * factor, statements, depth, seed).run(),
+				dialect,
+				reservedIdentifiers
+			));
+			name = to_string(functions) + "x" + to_string(statements * factor);
+			series[1].second.emplace_back(prepareInput(
+				name,
+				YulGenerator(functions, statements * factor, depth, seed).run(),
+				dialect,
+				reservedIdentifiers
+			));
+		}
+	}
+	catch (Exception const& _exception)
+	{
+		cerr << "Could not generate the inputs: " << boost::diagnostic_information(_exception) << endl;
+		return 1;
+	}
+
+	bool success = true;
+	for (auto const& [seriesName, inputs]: series)
+	{
+		cout << "Scaling the number of " << seriesName << " (code size";
+		for (Input const& input: inputs)
+			cout << " " << input.codeSize;
+		cout << "):" << endl;
+		cout << left << setw(32) << "Step" << right;
+		for (Input const& input: inputs)
+			cout << setw(12) << input.name;
+		cout << setw(10) << "Exponent" << endl;
+
+		for (string const& stepName: steps)
+		{
+			OptimiserStep const& step = *OptimiserSuite::allSteps().at(stepName);
+			cout << left << setw(32) << stepName << right << fixed << setprecision(3);
+			vector<double> times;
+			try
+			{
+				for (Input const& input: inputs)
+				{
+					times.push_back(measure(step, input, dialect, reservedIdentifiers, repetitions));
+					cout << setw(12) << times.back();
+					cout.flush();
+				}
+			}
+			catch (Exception const& _exception)
+			{
+				cout << "  exception: " << _exception.what() << endl;
+				continue;
+			}
+
+			optional<double> exponent = growthExponent(inputs, times);
+			if (!exponent)
+			{
+				cout << setw(10) << "-" << endl;
+				continue;
+			}
+			cout << setw(10) << setprecision(2) << *exponent;
+			if (arguments.count("max-exponent") && *exponent > arguments["max-exponent"].as<double>())
+			{
+				cout << "  (too high)";
+				success = false;
+			}
+			cout << endl;
+		}
+		cout << endl;
+	}
+
+	return success ? 0 : 2;
+}
@@ -238,6 +238,35 @@ BOOST_FIXTURE_TEST_CASE(evaluate_should_multiply_the_result_by_scaling_factor, P
 	BOOST_TEST(RelativeProgramSize(m_program, nullptr, 4, m_weights).evaluate(m_chromosome) == round(10000.0 * sizeRatio));
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(ProgramGasCostTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_compute_gas_cost_of_the_optimised_program, ProgramBasedMetricFixture)
+{
+	size_t fitness = ProgramGasCost(m_program, nullptr, 200, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(fitness != m_program.gasCost(200));
+	BOOST_TEST(fitness == m_optimisedProgram.gasCost(200));
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_be_able_to_use_program_cache_if_available, ProgramBasedMetricFixture)
+{
+	size_t fitness = ProgramGasCost(nullopt, m_programCache, 200, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(fitness == m_optimisedProgram.gasCost(200));
+	BOOST_TEST(m_programCache->size() == m_chromosome.length());
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_weigh_execution_cost_by_number_of_runs, ProgramBasedMetricFixture)
+{
+	size_t fitnessOneRun = ProgramGasCost(m_program, nullptr, 1, m_weights).evaluate(m_chromosome);
+	size_t fitnessTwoRuns = ProgramGasCost(m_program, nullptr, 2, m_weights).evaluate(m_chromosome);
+	size_t fitnessThreeRuns = ProgramGasCost(m_program, nullptr, 3, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(fitnessTwoRuns > fitnessOneRun);
+	BOOST_TEST(fitnessThreeRuns - fitnessTwoRuns == fitnessTwoRuns - fitnessOneRun);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(FitnessMetricCombinationTest)
 
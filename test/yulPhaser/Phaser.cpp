@@ -87,6 +87,7 @@ protected:
 		/* metricAggregator = */ MetricAggregatorChoice::Average,
 		/* relativeMetricScale = */ 5,
 		/* chromosomeRepetitions = */ 1,
+		/* optimizeRuns = */ 200,
 	};
 	CodeWeights const m_weights{};
 };
@@ -235,6 +236,24 @@ BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFac
 	BOOST_TEST(relativeProgramSizeMetric->fixedPointPrecision() == m_options.relativeMetricScale);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_set_optimize_runs_of_gas_cost_metric, FitnessMetricFactoryFixture)
+{
+	m_options.metric = MetricChoice::GasCost;
+	m_options.metricAggregator = MetricAggregatorChoice::Average;
+	m_options.optimizeRuns = 1000;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+
+	auto averageMetric = dynamic_cast<FitnessMetricAverage*>(metric.get());
+	BOOST_REQUIRE(averageMetric != nullptr);
+	BOOST_REQUIRE(averageMetric->metrics().size() == 1);
+	BOOST_REQUIRE(averageMetric->metrics()[0] != nullptr);
+
+	auto gasCostMetric = dynamic_cast<ProgramGasCost*>(averageMetric->metrics()[0].get());
+	BOOST_REQUIRE(gasCostMetric != nullptr);
+	BOOST_TEST(gasCostMetric->runs() == m_options.optimizeRuns);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_for_each_input_program, FitnessMetricFactoryFixture)
 {
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
@@ -385,7 +404,7 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheFactoryTest)
 
 BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cache_enabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* programCacheSizeLimit = */ 1000};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -394,12 +413,13 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cach
 	{
 		BOOST_REQUIRE(caches[i] != nullptr);
 		BOOST_TEST(toString(caches[i]->program()) == toString(m_programs[i]));
+		BOOST_TEST((caches[i]->sizeLimit() == optional<size_t>(1000)));
 	}
 }
 
 BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_cache_disabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false, /* programCacheSizeLimit = */ nullopt};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
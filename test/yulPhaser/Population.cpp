@@ -210,6 +210,23 @@ BOOST_FIXTURE_TEST_CASE(makeRandom_should_compute_fitness, PopulationFixture)
 	BOOST_TEST(population.individuals()[2].fitness == m_fitnessMetric->evaluate(population.individuals()[2].chromosome));
 }
 
+BOOST_FIXTURE_TEST_CASE(fitness_should_not_depend_on_the_number_of_evaluation_threads, PopulationFixture)
+{
+	SimulationRNG::reset(1);
+	Population sequentialPopulation = Population::makeRandom(m_fitnessMetric, 50, 0, 30);
+	Population sequentialMutants = sequentialPopulation.mutate(RangeSelection(0.0, 1.0), geneRandomisation(0.5));
+
+	Population::setEvaluationThreadCount(4);
+	BOOST_TEST(Population::evaluationThreadCount() == 4);
+	SimulationRNG::reset(1);
+	Population parallelPopulation = Population::makeRandom(m_fitnessMetric, 50, 0, 30);
+	Population parallelMutants = parallelPopulation.mutate(RangeSelection(0.0, 1.0), geneRandomisation(0.5));
+	Population::setEvaluationThreadCount(1);
+
+	BOOST_TEST(parallelPopulation == sequentialPopulation);
+	BOOST_TEST(parallelMutants == sequentialMutants);
+}
+
 BOOST_FIXTURE_TEST_CASE(plus_operator_should_add_two_populations, PopulationFixture)
 {
 	BOOST_CHECK_EQUAL(
@@ -22,8 +22,10 @@
 #include <tools/yulPhaser/Program.h>
 
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
+#include <libyul/optimiser/UnusedPruner.h>
 
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
@@ -401,6 +403,26 @@ BOOST_AUTO_TEST_CASE(codeSize)
 	BOOST_TEST(program.codeSize(CodeWeights{}) == CodeSize::codeSizeIncludingFunctions(program.ast()));
 }
 
+BOOST_AUTO_TEST_CASE(gasCost)
+{
+	string sourceCode(
+		"{\n"
+		"    function foo() -> result\n"
+		"    {\n"
+		"        result := 15\n"
+		"    }\n"
+		"    sstore(0, foo())\n"
+		"}\n"
+	);
+	CharStream sourceStream(sourceCode, current_test_case().p_name);
+	Program program = get<Program>(Program::load(sourceStream));
+	Program shorterProgram = program;
+	shorterProgram.optimise({FullInliner::name, UnusedPruner::name});
+
+	BOOST_TEST(program.gasCost(1) < program.gasCost(2));
+	BOOST_TEST(shorterProgram.gasCost(200) < program.gasCost(200));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -213,6 +213,54 @@ BOOST_FIXTURE_TEST_CASE(startRound_should_remove_entries_older_than_two_rounds,
 	BOOST_TEST(m_programCache.size() == 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(startRound_should_not_remove_entries_if_size_limit_is_set, ProgramCacheFixture)
+{
+	ProgramCache cache(m_program, 1000000);
+
+	cache.optimiseProgram("Iu");
+	cache.startRound(1);
+	cache.startRound(2);
+	cache.startRound(3);
+
+	BOOST_TEST(cache.currentRound() == 3);
+	BOOST_TEST((cachedKeys(cache) == set<string>{"I", "Iu"}));
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_evict_least_recently_used_entries_when_size_limit_is_exceeded, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+	ProgramCache cache(m_program, sizeI + sizeIu + sizeL);
+
+	cache.optimiseProgram("Iu");
+	cache.optimiseProgram("L");
+	BOOST_REQUIRE((cachedKeys(cache) == set<string>{"I", "Iu", "L"}));
+
+	// Extending "Iu" also counts as using "I" and "Iu", which leaves "L" as the least recently used entry.
+	cache.optimiseProgram("IuO");
+	BOOST_TEST(!cache.contains("L"));
+	BOOST_TEST(cache.contains("IuO"));
+	BOOST_TEST(cache.gatherStats().totalCodeSize <= sizeI + sizeIu + sizeL);
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_reuse_longest_cached_prefix_even_if_shorter_ones_were_evicted, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	ProgramCache cache(m_program, sizeIu);
+	assert(sizeI + sizeIu > sizeIu);
+
+	Program expectedProgram = optimisedProgram(m_program, "IuO");
+
+	cache.optimiseProgram("Iu");
+	BOOST_REQUIRE((cachedKeys(cache) == set<string>{"Iu"}));
+	size_t missesBefore = cache.gatherStats().misses;
+
+	BOOST_TEST(toString(cache.optimiseProgram("IuO")) == toString(expectedProgram));
+	BOOST_TEST(cache.gatherStats().misses == missesBefore + 1);
+}
+
 BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCacheFixture)
 {
 	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
@@ -25,6 +25,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/range/adaptor/reversed.hpp>
 
 #ifdef _WIN32 // windows
 	#include <io.h>
@@ -276,11 +277,10 @@ void SourceUpgrade::tryCompile() const
 
 	try
 	{
+		// The upgrades only need the analysed ASTs, so no code is generated.
 		if (m_compiler->parse())
 		{
-			if (m_compiler->analyze())
-				m_compiler->compile();
-			else
+			if (!m_compiler->analyze())
 				if (verbose)
 				{
 					error() <<
@@ -322,17 +322,15 @@ void SourceUpgrade::runUpgrade()
 
 	while (recompile && !m_compiler->errors().empty())
 	{
+		recompile = false;
 		for (auto& sourceCode: m_sourceCodes)
-		{
-			recompile = analyzeAndUpgrade(sourceCode);
-			if (recompile)
-				break;
-		}
+			if (analyzeAndUpgrade(sourceCode))
+				recompile = true;
 
 		if (recompile)
 		{
 			m_suite.reset();
-			resetCompiler();
+			updateCompiler();
 			tryCompile();
 		}
 	}
@@ -346,53 +344,66 @@ bool SourceUpgrade::analyzeAndUpgrade(pair<string, string> const& _sourceCode)
 	if (verbose)
 		log() << "Analyzing and upgrading " << _sourceCode.first << "." << endl;
 
+	size_t const firstChange = m_suite.changes().size();
 	if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
 		m_suite.analyze(m_compiler->ast(_sourceCode.first));
 
-	if (!m_suite.changes().empty())
+	// Changes that overlap a change starting before them are left for the next round, since
+	// their locations refer to the source before that change.
+	vector<UpgradeChange*> changes;
+	for (size_t i = firstChange; i < m_suite.changes().size(); ++i)
+		if (m_suite.changes()[i].level() == UpgradeChange::Level::Safe || applyUnsafe)
+			changes.push_back(&m_suite.changes()[i]);
+	stable_sort(changes.begin(), changes.end(), [](UpgradeChange* _a, UpgradeChange* _b) {
+		return _a->location().start < _b->location().start;
+	});
+	vector<UpgradeChange*> changesToApply;
+	for (UpgradeChange* change: changes)
 	{
-		auto& change = m_suite.changes().front();
-
-		if (verbose)
-			change.log(true);
-
-		if (change.level() == UpgradeChange::Level::Safe)
+		if (!changesToApply.empty())
 		{
-			applyChange(_sourceCode, change);
-			return true;
-		}
-		else if (change.level() == UpgradeChange::Level::Unsafe)
-		{
-			if (applyUnsafe)
-			{
-				applyChange(_sourceCode, change);
-				return true;
-			}
+			SourceLocation const& previous = changesToApply.back()->location();
+			if (change->location().start < previous.end || change->location().start == previous.start)
+				continue;
 		}
+		if (verbose)
+			change->log(true);
+		changesToApply.push_back(change);
 	}
 
-	return false;
+	if (changesToApply.empty())
+		return false;
+	applyChanges(_sourceCode, changesToApply);
+	return true;
 }
 
-void SourceUpgrade::applyChange(
+void SourceUpgrade::applyChanges(
 	pair<string, string> const& _sourceCode,
-	UpgradeChange& _change
+	vector<UpgradeChange*> const& _changes
 )
 {
 	bool dryRun = m_args.count(g_argDryRun);
 	bool verbose = m_args.count(g_argVerbose);
 
-	if (verbose)
+	string source = _sourceCode.second;
+	// Applying the changes from the end keeps the locations of the remaining ones valid.
+	for (UpgradeChange* change: _changes | boost::adaptors::reversed)
 	{
-		log() << "Applying change to " << _sourceCode.first << endl << endl;
-		log() << _change.patch();
+		if (verbose)
+		{
+			log() << "Applying change to " << _sourceCode.first << endl << endl;
+			log() << change->patch();
+		}
+		source.replace(
+			static_cast<size_t>(change->location().start),
+			static_cast<size_t>(change->location().end - change->location().start),
+			change->patch()
+		);
 	}
-
-	_change.apply();
-	m_sourceCodes[_sourceCode.first] = _change.source();
+	m_sourceCodes[_sourceCode.first] = source;
 
 	if (!dryRun)
-		writeInputFile(_sourceCode.first, _change.source());
+		writeInputFile(_sourceCode.first, source);
 }
 
 void SourceUpgrade::printErrors() const
@@ -526,6 +537,14 @@ ReadCallback::Callback SourceUpgrade::fileReader()
 	return fileReader;
 }
 
+void SourceUpgrade::updateCompiler()
+{
+	if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
+		m_compiler->updateSources(m_sourceCodes);
+	else
+		resetCompiler();
+}
+
 void SourceUpgrade::resetCompiler()
 {
 	m_compiler->reset();
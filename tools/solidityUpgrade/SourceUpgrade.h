@@ -116,27 +116,27 @@ private:
 		};
 	};
 
-	/// Parses the current sources and runs analyses as well as compilation on
-	/// them if parsing was successful.
+	/// Parses the current sources and runs the analysis on them if parsing was
+	/// successful. No code is generated.
 	void tryCompile() const;
-	/// Analyses and upgrades the sources given. The upgrade happens in a loop,
-	/// applying one change at a time, which is run until no applicable changes
-	/// are found any more. Only one change is done at a time and all sources
-	/// are being compiled again after each change.
+	/// Analyses and upgrades the sources given. The upgrade happens in rounds,
+	/// which are run until no applicable changes are found any more. Each round
+	/// applies all non-overlapping changes found in all sources, after which the
+	/// sources are analysed again.
 	void runUpgrade();
-	/// Runs upgrade analysis on source and applies upgrades changes to it.
-	/// Returns `true` if there're still changes that can be applied,
-	/// `false` otherwise.
+	/// Runs upgrade analysis on source and applies all applicable upgrade changes
+	/// to it that do not overlap each other.
+	/// Returns `true` if changes were applied, `false` otherwise.
 	bool analyzeAndUpgrade(
 		std::pair<std::string, std::string> const& _sourceCode
 	);
 
-	/// Applies the change given to its source code. If no `--dry-run` was
-	/// passed via the commandline, the upgraded source code is written back
-	/// to its file.
-	void applyChange(
+	/// Applies the non-overlapping changes given, sorted by their location, to
+	/// their source code. If no `--dry-run` was passed via the commandline, the
+	/// upgraded source code is written back to its file.
+	void applyChanges(
 		std::pair<std::string, std::string> const& _sourceCode,
-		UpgradeChange& _change
+		std::vector<UpgradeChange*> const& _changes
 	);
 
 	/// Prints all errors (excluding warnings) the compiler currently reported.
@@ -152,6 +152,10 @@ private:
 	/// Returns a file reader function that fills `m_sources`.
 	frontend::ReadCallback::Callback fileReader();
 
+	/// Passes the upgraded sources to the compiler. If the last analysis did not
+	/// report errors, only the changed sources and the sources importing them are
+	/// parsed and analysed again.
+	void updateCompiler();
 	/// Resets the compiler stack and configures sources to compile.
 	/// Also enables error recovery.
 	void resetCompiler();
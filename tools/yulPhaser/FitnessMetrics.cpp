@@ -75,6 +75,11 @@ size_t RelativeProgramSize::evaluate(Chromosome const& _chromosome)
 	));
 }
 
+size_t ProgramGasCost::evaluate(Chromosome const& _chromosome)
+{
+	return optimisedProgram(_chromosome).gasCost(m_runs);
+}
+
 size_t FitnessMetricAverage::evaluate(Chromosome const& _chromosome)
 {
 	assert(m_metrics.size() > 0);
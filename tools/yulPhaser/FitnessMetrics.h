@@ -132,6 +132,33 @@ private:
 	size_t m_fixedPointPrecision;
 };
 
+/**
+ * Fitness metric based on the estimated gas cost of a specific program after applying the
+ * optimisations from the chromosome to it. The cost of deploying the program is added to the cost
+ * of executing it @a _runs times, like with the optimiser's --optimize-runs option.
+ *
+ * See @a Program::gasCost() for details of the estimate.
+ */
+class ProgramGasCost: public ProgramBasedMetric
+{
+public:
+	explicit ProgramGasCost(
+		std::optional<Program> _program,
+		std::shared_ptr<ProgramCache> _programCache,
+		size_t _runs,
+		yul::CodeWeights const& _weights,
+		size_t _repetitionCount = 1
+	):
+		ProgramBasedMetric(std::move(_program), std::move(_programCache), _weights, _repetitionCount),
+		m_runs(_runs) {}
+
+	size_t runs() const { return m_runs; }
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+private:
+	size_t m_runs;
+};
+
 /**
  * Abstract base class for fitness metrics that compute their value based on values of multiple
  * other, nested metrics.
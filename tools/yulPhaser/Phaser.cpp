@@ -68,6 +68,7 @@ map<MetricChoice, string> MetricChoiceToStringMap =
 {
 	{MetricChoice::CodeSize, "code-size"},
 	{MetricChoice::RelativeCodeSize, "relative-code-size"},
+	{MetricChoice::GasCost, "gas-cost"},
 };
 map<string, MetricChoice> const StringToMetricChoiceMap = invertMap(MetricChoiceToStringMap);
 
@@ -218,6 +219,7 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["optimize-runs"].as<size_t>(),
 	};
 }
 
@@ -258,6 +260,18 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 				));
 			break;
 		}
+		case MetricChoice::GasCost:
+		{
+			for (size_t i = 0; i < _programs.size(); ++i)
+				metrics.push_back(make_unique<ProgramGasCost>(
+					_programCaches[i] != nullptr ? optional<Program>{} : move(_programs[i]),
+					move(_programCaches[i]),
+					_options.optimizeRuns,
+					_weights,
+					_options.chromosomeRepetitions
+				));
+			break;
+		}
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
@@ -357,6 +371,9 @@ ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::v
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments.count("program-cache-size-limit") > 0 ?
+			_arguments["program-cache-size-limit"].as<size_t>() :
+			optional<size_t>{},
 	};
 }
 
@@ -367,7 +384,11 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program)) : nullptr);
+		programCaches.push_back(
+			_options.programCacheEnabled ?
+			make_shared<ProgramCache>(move(program), _options.programCacheSizeLimit) :
+			nullptr
+		);
 
 	return programCaches;
 }
@@ -415,6 +436,7 @@ void Phaser::main(int _argc, char** _argv)
 		return;
 
 	initialiseRNG(arguments.value());
+	Population::setEvaluationThreadCount(arguments.value()["threads"].as<size_t>());
 
 	runPhaser(arguments.value());
 }
@@ -455,6 +477,12 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			"or removed using this option. The value given here is applied after it."
 		)
 		("seed", po::value<uint32_t>()->value_name("<NUM>"), "Seed for the random number generator.")
+		(
+			"threads",
+			po::value<size_t>()->value_name("<NUM>")->default_value(1),
+			"The number of threads used to compute the fitness of chromosomes. "
+			"Does not affect the results, only the cache statistics."
+		)
 		(
 			"rounds",
 			po::value<size_t>()->value_name("<NUM>"),
@@ -642,7 +670,8 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 				"\n"
 				"AVAILABLE METRICS:\n"
 				"* " + toString(MetricChoice::CodeSize) + "\n" +
-				"* " + toString(MetricChoice::RelativeCodeSize)
+				"* " + toString(MetricChoice::RelativeCodeSize) + "\n" +
+				"* " + toString(MetricChoice::GasCost)
 			).c_str()
 		)
 		(
@@ -676,6 +705,13 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
 			"Number of times to repeat the sequence optimisation steps represented by a chromosome."
 		)
+		(
+			"optimize-runs",
+			po::value<size_t>()->value_name("<NUM>")->default_value(200),
+			"Number of times the code is expected to be executed. Used by the gas cost metric to "
+			"weigh the cost of executing the code against the cost of deploying it, like the "
+			"--optimize-runs option of the compiler."
+		)
 	;
 	keywordDescription.add(metricsDescription);
 
@@ -707,9 +743,16 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			"program-cache",
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
-			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
-			"highly recommended if your computer has enough RAM."
+			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long "
+			"and no size limit is set. Disabled by default but highly recommended."
+		)
+		(
+			"program-cache-size-limit",
+			po::value<size_t>()->value_name("<SIZE>"),
+			"Maximum total size of the programs stored in each program cache, counted in AST nodes. "
+			"With a limit, cached programs are kept across rounds and the least recently used ones "
+			"are evicted when the limit is exceeded. Without it, programs not used in the current or "
+			"the previous round are evicted. (default=no limit)"
 		)
 	;
 	keywordDescription.add(cacheDescription);
@@ -74,6 +74,7 @@ enum class MetricChoice
 {
 	CodeSize,
 	RelativeCodeSize,
+	GasCost,
 };
 
 enum class MetricAggregatorChoice
@@ -156,6 +157,7 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		size_t optimizeRuns;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -214,6 +216,7 @@ public:
 	struct Options
 	{
 		bool programCacheEnabled;
+		std::optional<size_t> programCacheSizeLimit;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -23,9 +23,11 @@
 
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <algorithm>
 #include <cassert>
+#include <memory>
 #include <numeric>
 
 using namespace std;
@@ -34,6 +36,14 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::phaser;
 
+namespace
+{
+
+/// Threads computing the fitness of new individuals. Null if it is computed on the calling thread.
+unique_ptr<ThreadPool> s_evaluationThreadPool;
+
+}
+
 namespace solidity::phaser
 {
 
@@ -96,26 +106,23 @@ Population Population::select(Selection const& _selection) const
 
 Population Population::mutate(Selection const& _selection, function<Mutation> _mutation) const
 {
-	vector<Individual> mutatedIndividuals;
+	vector<Chromosome> mutatedChromosomes;
 	for (size_t i: _selection.materialise(m_individuals.size()))
-		mutatedIndividuals.emplace_back(_mutation(m_individuals[i].chromosome), *m_fitnessMetric);
+		mutatedChromosomes.emplace_back(_mutation(m_individuals[i].chromosome));
 
-	return Population(m_fitnessMetric, mutatedIndividuals);
+	return Population(m_fitnessMetric, move(mutatedChromosomes));
 }
 
 Population Population::crossover(PairSelection const& _selection, function<Crossover> _crossover) const
 {
-	vector<Individual> crossedIndividuals;
+	vector<Chromosome> crossedChromosomes;
 	for (auto const& [i, j]: _selection.materialise(m_individuals.size()))
-	{
-		auto childChromosome = _crossover(
+		crossedChromosomes.emplace_back(_crossover(
 			m_individuals[i].chromosome,
 			m_individuals[j].chromosome
-		);
-		crossedIndividuals.emplace_back(move(childChromosome), *m_fitnessMetric);
-	}
+		));
 
-	return Population(m_fitnessMetric, crossedIndividuals);
+	return Population(m_fitnessMetric, move(crossedChromosomes));
 }
 
 tuple<Population, Population> Population::symmetricCrossoverWithRemainder(
@@ -125,15 +132,15 @@ tuple<Population, Population> Population::symmetricCrossoverWithRemainder(
 {
 	vector<int> indexSelected(m_individuals.size(), false);
 
-	vector<Individual> crossedIndividuals;
+	vector<Chromosome> crossedChromosomes;
 	for (auto const& [i, j]: _selection.materialise(m_individuals.size()))
 	{
 		auto children = _symmetricCrossover(
 			m_individuals[i].chromosome,
 			m_individuals[j].chromosome
 		);
-		crossedIndividuals.emplace_back(move(get<0>(children)), *m_fitnessMetric);
-		crossedIndividuals.emplace_back(move(get<1>(children)), *m_fitnessMetric);
+		crossedChromosomes.emplace_back(move(get<0>(children)));
+		crossedChromosomes.emplace_back(move(get<1>(children)));
 		indexSelected[i] = true;
 		indexSelected[j] = true;
 	}
@@ -144,7 +151,7 @@ tuple<Population, Population> Population::symmetricCrossoverWithRemainder(
 			remainder.emplace_back(m_individuals[i]);
 
 	return {
-		Population(m_fitnessMetric, crossedIndividuals),
+		Population(m_fitnessMetric, move(crossedChromosomes)),
 		Population(m_fitnessMetric, remainder),
 	};
 }
@@ -186,14 +193,40 @@ ostream& phaser::operator<<(ostream& _stream, Population const& _population)
 	return _stream;
 }
 
+void Population::setEvaluationThreadCount(size_t _threadCount)
+{
+	if (_threadCount > 1)
+		s_evaluationThreadPool = make_unique<ThreadPool>(_threadCount);
+	else
+		s_evaluationThreadPool.reset();
+}
+
+size_t Population::evaluationThreadCount()
+{
+	return s_evaluationThreadPool ? s_evaluationThreadPool->threadCount() : 1;
+}
+
 vector<Individual> Population::chromosomesToIndividuals(
 	FitnessMetric& _fitnessMetric,
 	vector<Chromosome> _chromosomes
 )
 {
+	vector<size_t> fitness(_chromosomes.size());
+	if (s_evaluationThreadPool && _chromosomes.size() > 1)
+	{
+		for (size_t i = 0; i < _chromosomes.size(); ++i)
+			s_evaluationThreadPool->post([&, i]() {
+				fitness[i] = _fitnessMetric.evaluate(_chromosomes[i]);
+			});
+		s_evaluationThreadPool->wait();
+	}
+	else
+		for (size_t i = 0; i < _chromosomes.size(); ++i)
+			fitness[i] = _fitnessMetric.evaluate(_chromosomes[i]);
+
 	vector<Individual> individuals;
-	for (auto& chromosome: _chromosomes)
-		individuals.emplace_back(move(chromosome), _fitnessMetric);
+	for (size_t i = 0; i < _chromosomes.size(); ++i)
+		individuals.emplace_back(move(_chromosomes[i]), fitness[i]);
 
 	return individuals;
 }
@@ -70,6 +70,11 @@ bool isFitter(Individual const& a, Individual const& b);
  *
  * The population is immutable. Selections, mutations and crossover work by producing a new
  * instance and copying the individuals.
+ *
+ * New chromosomes are always generated sequentially, so that the sequence of random numbers
+ * drawn from @a SimulationRNG does not depend on the number of threads. Only the fitness
+ * evaluation can be spread over multiple threads (see @a setEvaluationThreadCount()). It must
+ * therefore be safe to call @a FitnessMetric::evaluate() concurrently.
  */
 class Population
 {
@@ -112,6 +117,12 @@ public:
 	std::shared_ptr<FitnessMetric> fitnessMetric() { return m_fitnessMetric; }
 	std::vector<Individual> const& individuals() const { return m_individuals; }
 
+	/// Sets the number of threads used to compute the fitness of new individuals.
+	/// Values of zero and one mean that the fitness is computed on the calling thread.
+	/// Must not be called while the fitness of any population is being computed.
+	static void setEvaluationThreadCount(size_t _threadCount);
+	static size_t evaluationThreadCount();
+
 	static size_t uniformChromosomeLength(size_t _min, size_t _max) { return SimulationRNG::uniformInt(_min, _max); }
 	static size_t binomialChromosomeLength(size_t _max) { return SimulationRNG::binomialInt(_max, 0.5); }
 
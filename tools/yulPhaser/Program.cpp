@@ -29,8 +29,11 @@
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/Utilities.h>
 #include <libyul/YulString.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
@@ -39,6 +42,9 @@
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/Suite.h>
 
+#include <libevmasm/GasMeter.h>
+
+#include <libsolutil/CommonData.h>
 #include <libsolutil/JSON.h>
 
 #include <cassert>
@@ -58,6 +64,117 @@ ostream& operator<<(ostream& _stream, Program const& _program);
 
 }
 
+namespace
+{
+
+/**
+ * Estimates the gas cost of Yul code as if every statement was executed exactly once.
+ * Instructions are priced using @a yul::GasMeterVisitor. Control flow, function calls and
+ * stack accesses are priced as the jumps and stack operations the code generator would emit
+ * for them. Run gas and data gas are accumulated separately.
+ */
+class GasCostEstimator: public ASTWalker
+{
+public:
+	explicit GasCostEstimator(EVMDialect const& _dialect): m_dialect(_dialect) {}
+
+	size_t runGas() const { return m_runGas; }
+	size_t dataGas() const { return m_dataGas; }
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _funCall) override
+	{
+		ASTWalker::operator()(_funCall);
+		BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_funCall.functionName.name);
+		if (builtin && builtin->instruction)
+			add(*builtin->instruction);
+		else
+			// Push the return label and the function label, jump and come back.
+			add({evmasm::Instruction::PUSH1, evmasm::Instruction::PUSH1, evmasm::Instruction::JUMP, evmasm::Instruction::JUMPDEST});
+	}
+	void operator()(Literal const& _literal) override
+	{
+		add(evmasm::Instruction::PUSH1);
+		m_dataGas += static_cast<size_t>(evmasm::GasMeter::dataGas(
+			toCompactBigEndian(valueOfLiteral(_literal), 1),
+			false,
+			m_dialect.evmVersion()
+		));
+	}
+	void operator()(Identifier const&) override { add(evmasm::Instruction::DUP1); }
+	void operator()(Assignment const& _assignment) override
+	{
+		ASTWalker::operator()(_assignment);
+		for (size_t i = 0; i < _assignment.variableNames.size(); ++i)
+			add({evmasm::Instruction::SWAP1, evmasm::Instruction::POP});
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		ASTWalker::operator()(_varDecl);
+		if (!_varDecl.value)
+			for (size_t i = 0; i < _varDecl.variables.size(); ++i)
+				add(evmasm::Instruction::PUSH1);
+	}
+	void operator()(If const& _if) override
+	{
+		ASTWalker::operator()(_if);
+		add({evmasm::Instruction::ISZERO, evmasm::Instruction::PUSH1, evmasm::Instruction::JUMPI, evmasm::Instruction::JUMPDEST});
+	}
+	void operator()(Switch const& _switch) override
+	{
+		ASTWalker::operator()(_switch);
+		for (size_t i = 0; i < _switch.cases.size(); ++i)
+			add({
+				evmasm::Instruction::DUP1,
+				evmasm::Instruction::EQ,
+				evmasm::Instruction::PUSH1,
+				evmasm::Instruction::JUMPI,
+				evmasm::Instruction::JUMPDEST
+			});
+		add(evmasm::Instruction::POP);
+	}
+	void operator()(FunctionDefinition const& _function) override
+	{
+		ASTWalker::operator()(_function);
+		add({evmasm::Instruction::JUMPDEST, evmasm::Instruction::JUMP});
+	}
+	void operator()(ForLoop const& _for) override
+	{
+		ASTWalker::operator()(_for);
+		add({
+			evmasm::Instruction::JUMPDEST,
+			evmasm::Instruction::ISZERO,
+			evmasm::Instruction::PUSH1,
+			evmasm::Instruction::JUMPI,
+			evmasm::Instruction::PUSH1,
+			evmasm::Instruction::JUMP,
+			evmasm::Instruction::JUMPDEST
+		});
+	}
+	void operator()(Break const&) override { add({evmasm::Instruction::PUSH1, evmasm::Instruction::JUMP}); }
+	void operator()(Continue const&) override { add({evmasm::Instruction::PUSH1, evmasm::Instruction::JUMP}); }
+	void operator()(Leave const&) override { add({evmasm::Instruction::PUSH1, evmasm::Instruction::JUMP}); }
+
+private:
+	void add(evmasm::Instruction _instruction)
+	{
+		auto [runGas, dataGas] = GasMeterVisitor::instructionCosts(_instruction, m_dialect);
+		m_runGas += runGas;
+		m_dataGas += dataGas;
+	}
+	void add(std::initializer_list<evmasm::Instruction> _instructions)
+	{
+		for (evmasm::Instruction instruction: _instructions)
+			add(instruction);
+	}
+
+	EVMDialect const& m_dialect;
+	size_t m_runGas = 0;
+	size_t m_dataGas = 0;
+};
+
+}
+
 ostream& std::operator<<(ostream& _outputStream, ErrorList const& _errors)
 {
 	SourceReferenceFormatter formatter(_outputStream, true, false);
@@ -213,3 +330,13 @@ size_t Program::computeCodeSize(Block const& _ast, CodeWeights const& _weights)
 {
 	return CodeSize::codeSizeIncludingFunctions(_ast, _weights);
 }
+
+size_t Program::computeGasCost(Block const& _ast, Dialect const& _dialect, size_t _runs)
+{
+	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
+	assert(evmDialect && "Gas costs can only be estimated for EVM programs.");
+
+	GasCostEstimator estimator(*evmDialect);
+	estimator(_ast);
+	return estimator.runGas() * _runs + estimator.dataGas();
+}
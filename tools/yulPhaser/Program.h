@@ -81,6 +81,9 @@ public:
 	void optimise(std::vector<std::string> const& _optimisationSteps);
 
 	size_t codeSize(yul::CodeWeights const& _weights) const { return computeCodeSize(*m_ast, _weights); }
+	/// @returns a static estimate of the gas spent on deploying the program and executing it
+	/// @a _runs times, in the same units as @a yul::GasMeter.
+	size_t gasCost(size_t _runs) const { return computeGasCost(*m_ast, m_dialect, _runs); }
 	yul::Block const& ast() const { return *m_ast; }
 
 	friend std::ostream& operator<<(std::ostream& _stream, Program const& _program);
@@ -116,6 +119,7 @@ private:
 		std::vector<std::string> const& _optimisationSteps
 	);
 	static size_t computeCodeSize(yul::Block const& _ast, yul::CodeWeights const& _weights);
+	static size_t computeGasCost(yul::Block const& _ast, yul::Dialect const& _dialect, size_t _runs);
 
 	std::unique_ptr<yul::Block> m_ast;
 	yul::Dialect const& m_dialect;
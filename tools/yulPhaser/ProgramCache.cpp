@@ -59,18 +59,23 @@ Program ProgramCache::optimiseProgram(
 	for (size_t i = 1; i < _repetitionCount; ++i)
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
-	size_t prefixSize = 0;
-	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
+	unique_lock<mutex> lock(m_mutex);
+
+	// Entries can be evicted one by one so a cached prefix does not imply that all the shorter
+	// ones are cached too. Reuse the longest one.
+	size_t prefixSize = targetOptimisations.size();
+	while (prefixSize > 0 && m_entries.count(targetOptimisations.substr(0, prefixSize)) == 0)
+		--prefixSize;
+
+	for (size_t i = 1; i <= prefixSize; ++i)
 	{
 		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
 		if (pair != m_entries.end())
 		{
 			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			markAsUsed(pair);
 		}
-		else
-			break;
+		++m_hits;
 	}
 
 	Program intermediateProgram = (
@@ -81,13 +86,30 @@ Program ProgramCache::optimiseProgram(
 
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
+		lock.unlock();
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
+		CacheEntry entry{intermediateProgram, m_currentRound};
+		lock.lock();
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		auto [pair, inserted] = m_entries.emplace(targetOptimisations.substr(0, i), move(entry));
+		if (inserted)
+		{
+			pair->second.lruPosition = m_lruOrder.insert(m_lruOrder.end(), &pair->first);
+			m_totalCodeSize += pair->second.size;
+		}
+		else
+		{
+			pair->second.roundNumber = m_currentRound;
+			markAsUsed(pair);
+		}
 		++m_misses;
 	}
 
+	if (m_sizeLimit.has_value())
+		while (m_totalCodeSize > m_sizeLimit.value() && !m_lruOrder.empty())
+			erase(m_entries.find(*m_lruOrder.front()));
+
 	return intermediateProgram;
 }
 
@@ -96,12 +118,16 @@ void ProgramCache::startRound(size_t _roundNumber)
 	assert(_roundNumber > m_currentRound);
 	m_currentRound = _roundNumber;
 
+	if (m_sizeLimit.has_value())
+		// Entries are evicted based on the size limit instead.
+		return;
+
 	for (auto pair = m_entries.begin(); pair != m_entries.end();)
 	{
 		assert(pair->second.roundNumber < m_currentRound);
 
 		if (pair->second.roundNumber < m_currentRound - 1)
-			m_entries.erase(pair++);
+			erase(pair++);
 		else
 			++pair;
 	}
@@ -110,6 +136,8 @@ void ProgramCache::startRound(size_t _roundNumber)
 void ProgramCache::clear()
 {
 	m_entries.clear();
+	m_lruOrder.clear();
+	m_totalCodeSize = 0;
 	m_currentRound = 0;
 }
 
@@ -127,18 +155,21 @@ CacheStats ProgramCache::gatherStats() const
 	return {
 		/* hits = */ m_hits,
 		/* misses = */ m_misses,
-		/* totalCodeSize = */ calculateTotalCachedCodeSize(),
+		/* totalCodeSize = */ m_totalCodeSize,
 		/* roundEntryCounts = */ countRoundEntries(),
 	};
 }
 
-size_t ProgramCache::calculateTotalCachedCodeSize() const
+void ProgramCache::markAsUsed(EntryIterator _entry)
 {
-	size_t size = 0;
-	for (auto const& pair: m_entries)
-		size += pair.second.program.codeSize(CacheStats::StorageWeights);
+	m_lruOrder.splice(m_lruOrder.end(), m_lruOrder, _entry->second.lruPosition);
+}
 
-	return size;
+void ProgramCache::erase(EntryIterator _entry)
+{
+	m_lruOrder.erase(_entry->second.lruPosition);
+	m_totalCodeSize -= _entry->second.size;
+	m_entries.erase(_entry);
 }
 
 map<size_t, size_t> ProgramCache::countRoundEntries() const
@@ -22,26 +22,15 @@
 
 #include <libyul/optimiser/Metrics.h>
 
+#include <list>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
 
 namespace solidity::phaser
 {
 
-/**
- * Structure used by @a ProgramCache to store intermediate programs and metadata associated
- * with them.
- */
-struct CacheEntry
-{
-	Program program;
-	size_t roundNumber;
-
-	CacheEntry(Program _program, size_t _roundNumber):
-		program(std::move(_program)),
-		roundNumber(_roundNumber) {}
-};
-
 /**
  * Stores statistics about current cache usage.
  */
@@ -82,31 +71,57 @@ struct CacheStats
 	bool operator!=(CacheStats const& _other) const { return !(*this == _other); }
 };
 
+/**
+ * Structure used by @a ProgramCache to store intermediate programs and metadata associated
+ * with them.
+ */
+struct CacheEntry
+{
+	Program program;
+	size_t roundNumber;
+	/// Size of the program measured with @a CacheStats::StorageWeights.
+	size_t size;
+	/// Position of the entry in the least-recently-used order of the cache.
+	std::list<std::string const*>::iterator lruPosition;
+
+	CacheEntry(Program _program, size_t _roundNumber):
+		program(std::move(_program)),
+		roundNumber(_roundNumber),
+		size(program.codeSize(CacheStats::StorageWeights)) {}
+};
+
 /**
  * Class that optimises programs one step at a time which allows it to store and later reuse the
  * results of the intermediate steps.
  *
  * The cache keeps track of the current round number and associates newly created entries with it.
  * @a startRound() must be called at the beginning of a round so that entries that are too old
- * can be purged. The current strategy is to store programs corresponding to all possible prefixes
- * encountered in the current and the previous rounds. Entries older than that get removed to
- * conserve memory.
+ * can be purged. Without a size limit the strategy is to store programs corresponding to all
+ * possible prefixes encountered in the current and the previous rounds. Entries older than that
+ * get removed to conserve memory.
+ *
+ * With a size limit entries are kept across rounds instead. Whenever the total size of the cached
+ * programs (measured with @a CacheStats::StorageWeights) exceeds the limit, the least recently
+ * used entries are evicted. Since using an entry also counts as using all its cached prefixes,
+ * the longest prefixes of a chromosome stay in the cache the longest.
  *
  * @a gatherStats() allows getting statistics useful for determining cache effectiveness.
  *
+ * @a optimiseProgram() can be called concurrently from multiple threads. The cache is locked only
+ * while looking up and storing entries, not while the optimiser runs, so two threads can end up
+ * computing the same entry. The result is the same but hit and miss counts then depend on timing.
+ * The other member functions must not be called while @a optimiseProgram() is running.
+ *
  * The current strategy does speed things up (about 4:1 hit:miss ratio observed in my limited
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
- *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, std::optional<size_t> _sizeLimit = std::nullopt):
+		m_program(std::move(_program)),
+		m_sizeLimit(_sizeLimit) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -124,17 +139,27 @@ public:
 	std::map<std::string, CacheEntry> const& entries() const { return m_entries; }
 	Program const& program() const { return m_program; }
 	size_t currentRound() const { return m_currentRound; }
+	std::optional<size_t> sizeLimit() const { return m_sizeLimit; }
 
 private:
-	size_t calculateTotalCachedCodeSize() const;
+	using EntryIterator = std::map<std::string, CacheEntry>::iterator;
+
 	std::map<size_t, size_t> countRoundEntries() const;
+	void markAsUsed(EntryIterator _entry);
+	void erase(EntryIterator _entry);
 
 	// The best matching data structure here would be a trie of chromosome prefixes but since
 	// the programs are orders of magnitude larger than the prefixes, it does not really matter.
 	// A map should be good enough.
 	std::map<std::string, CacheEntry> m_entries;
+	/// Keys of all entries, least recently used first.
+	std::list<std::string const*> m_lruOrder;
+	size_t m_totalCodeSize = 0;
 
+	/// Guards entries and statistics in @a optimiseProgram().
+	std::mutex m_mutex;
 	Program m_program;
+	std::optional<size_t> m_sizeLimit;
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;